@@ -0,0 +1,216 @@
+// -*-c++-*-
+
+/*!
+  \file agent_host_main.cpp
+  \brief sample program that executes all players and the coach of a team in one process.
+
+  Each player kicks the ball to the opponent goal when it is kickable,
+  intercepts the ball when it is the fastest teammate, and otherwise
+  keeps its home position. The KickTable and the server parameters are
+  shared by all players. The startup time and the peak resident memory of
+  the process are reported at the end.
+
+  usage: test_agent_host [-n players] [-c] [options for the agents]
+    -n players  the number of players. the first player is the goalie. (default: 11)
+    -c          add the online coach
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/common/agent_host.h>
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/coach/coach_agent.h>
+#include <rcsc/action/body_go_to_point.h>
+#include <rcsc/action/body_intercept.h>
+#include <rcsc/action/body_smart_kick.h>
+#include <rcsc/action/body_turn_to_ball.h>
+#include <rcsc/action/kick_table.h>
+#include <rcsc/action/neck_scan_field.h>
+#include <rcsc/param/cmd_line_parser.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/resource.h>
+
+namespace {
+
+/*!
+  \brief minimal player
+ */
+class SamplePlayer
+    : public rcsc::PlayerAgent {
+protected:
+
+    void handleServerParam()
+      {
+          // the table is created only once in this process
+          rcsc::KickTable::instance().createTables();
+      }
+
+    void actionImpl()
+      {
+          const rcsc::WorldModel & wm = world();
+
+          const double x = ( wm.self().unum() == 1
+                             ? -50.0
+                             : -40.0 + 8.0 * ( ( wm.self().unum() - 2 ) / 3 ) );
+          const double y = ( wm.self().unum() == 1
+                             ? 0.0
+                             : -20.0 + 20.0 * ( ( wm.self().unum() - 2 ) % 3 ) );
+          const rcsc::Vector2D home( x, y );
+
+          if ( wm.gameMode().type() == rcsc::GameMode::BeforeKickOff )
+          {
+              doMove( home.x, home.y );
+          }
+          else if ( ! wm.ball().posValid() )
+          {
+              rcsc::Body_TurnToBall().execute( this );
+          }
+          else if ( wm.self().isKickable() )
+          {
+              rcsc::Body_SmartKick( rcsc::Vector2D( 52.5, 0.0 ), 2.5, 1.5, 3 ).execute( this );
+          }
+          else if ( wm.interceptTable()->selfReachCycle() <= wm.interceptTable()->teammateReachCycle() )
+          {
+              rcsc::Body_Intercept().execute( this );
+          }
+          else
+          {
+              rcsc::Body_GoToPoint( home, 1.0, 100.0 ).execute( this );
+          }
+
+          setNeckAction( new rcsc::Neck_ScanField() );
+      }
+};
+
+/*!
+  \brief coach that does nothing
+ */
+class SampleCoach
+    : public rcsc::CoachAgent {
+protected:
+
+    void actionImpl()
+      { }
+};
+
+/*!
+  \brief get the peak resident memory of this process
+  \return peak resident memory [KB]
+ */
+long
+peak_rss_kb()
+{
+    struct rusage usage;
+    if ( ::getrusage( RUSAGE_SELF, &usage ) != 0 )
+    {
+        return 0;
+    }
+    return usage.ru_maxrss;
+}
+
+}
+
+int
+main( int argc, char ** argv )
+{
+    int n_players = 11;
+    bool use_coach = false;
+    std::list< std::string > args;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "-n" ) && i + 1 < argc )
+        {
+            n_players = std::max( 0, std::min( 11, std::atoi( argv[++i] ) ) );
+        }
+        else if ( ! std::strcmp( argv[i], "-c" ) )
+        {
+            use_coach = true;
+        }
+        else
+        {
+            args.push_back( argv[i] );
+        }
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    rcsc::AgentHost host;
+    std::vector< std::unique_ptr< rcsc::SoccerAgent > > agents;
+
+    for ( int i = 0; i < n_players; ++i )
+    {
+        std::list< std::string > player_args = args;
+        if ( i == 0 )
+        {
+            player_args.push_back( "--goalie" );
+        }
+
+        rcsc::CmdLineParser cmd_parser( player_args );
+        agents.push_back( std::unique_ptr< rcsc::SoccerAgent >( new SamplePlayer() ) );
+        if ( ! host.addAgent( agents.back().get(), cmd_parser ) )
+        {
+            std::cerr << "failed to initialize the player " << i + 1 << std::endl;
+            return 1;
+        }
+    }
+
+    if ( use_coach )
+    {
+        rcsc::CmdLineParser cmd_parser( args );
+        agents.push_back( std::unique_ptr< rcsc::SoccerAgent >( new SampleCoach() ) );
+        if ( ! host.addAgent( agents.back().get(), cmd_parser ) )
+        {
+            std::cerr << "failed to initialize the coach" << std::endl;
+            return 1;
+        }
+    }
+
+    const double init_msec
+        = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+
+    std::cout << "agents: " << host.agentSize()
+              << ", initialization: " << init_msec << " ms" << std::endl;
+
+    host.run();
+
+    std::cout << "peak resident memory: " << peak_rss_kb() << " KB" << std::endl;
+    return 0;
+}
@@ -0,0 +1,308 @@
+// -*-c++-*-
+
+/*!
+  \file intercept_incremental_test.cpp
+  \brief behavior test of the incremental update of InterceptTable.
+
+  Two WorldModel instances receive the same randomized fullstate messages.
+  One uses the incremental intercept update and the other always predicts
+  all players. The intercept results of both models must be the same in
+  every cycle, whether the ball and the players move by inertia, only some
+  players are observed again, or the ball is kicked to a new velocity.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/player_agent.h>
+#include <rcsc/player/world_model.h>
+#include <rcsc/player/intercept_table.h>
+#include <rcsc/player/fullstate_sensor.h>
+#include <rcsc/player/action_effector.h>
+#include <rcsc/common/server_param.h>
+#include <rcsc/game_mode.h>
+
+#include <iostream>
+#include <random>
+#include <sstream>
+
+namespace {
+
+const int SELF_UNUM = 2;
+
+/*!
+  \brief agent used only to create ActionEffector
+ */
+class NullAgent
+    : public rcsc::PlayerAgent {
+protected:
+    void actionImpl()
+      { }
+};
+
+/*!
+  \brief randomized fullstate message generator
+ */
+class FullstateGenerator {
+private:
+    std::mt19937 M_rng;
+    std::uniform_real_distribution< double > M_x;
+    std::uniform_real_distribution< double > M_y;
+    std::uniform_real_distribution< double > M_dir;
+    std::uniform_real_distribution< double > M_ball_speed;
+    std::uniform_real_distribution< double > M_player_vel;
+    std::uniform_real_distribution< double > M_prob;
+
+public:
+
+    FullstateGenerator()
+        : M_rng( 2021 )
+        , M_x( -50.0, 50.0 )
+        , M_y( -32.0, 32.0 )
+        , M_dir( -180.0, 180.0 )
+        , M_ball_speed( 0.5, 2.7 )
+        , M_player_vel( -0.5, 0.5 )
+        , M_prob( 0.0, 1.0 )
+      { }
+
+    double prob()
+      {
+          return M_prob( M_rng );
+      }
+
+    /*!
+      \brief create the message that contains the ball and the selected players
+      \param cycle game cycle
+      \param ball_pos ball position. the precision is kept in the message.
+      \param ball_vel ball velocity. the precision is kept in the message.
+      \param player_prob probability that each player except self is contained
+     */
+    std::string create( const long cycle,
+                        const rcsc::Vector2D & ball_pos,
+                        const rcsc::Vector2D & ball_vel,
+                        const double player_prob )
+      {
+          std::ostringstream os;
+          os.precision( 17 );
+          os << "(fullstate " << cycle
+             << " (pmode play_on) (vmode high normal) (count 0 0 0 0 0 0 0 0)"
+             << " (arm (movable 0) (expires 0) (target 0 0) (count 0)) (score 0 0)"
+             << " ((b) " << ball_pos.x << ' ' << ball_pos.y
+             << ' ' << ball_vel.x << ' ' << ball_vel.y << ')';
+
+          for ( int side = 0; side < 2; ++side )
+          {
+              for ( int unum = 1; unum <= 11; ++unum )
+              {
+                  const bool self = ( side == 0 && unum == SELF_UNUM );
+                  if ( ! self
+                       && prob() >= player_prob )
+                  {
+                      continue;
+                  }
+
+                  // some players stand still
+                  const double vx = ( prob() < 0.5 ? 0.0 : M_player_vel( M_rng ) );
+                  os << " ((p " << ( side == 0 ? 'l' : 'r' ) << ' ' << unum
+                     << ( unum == 1 ? " g" : "" ) << " 0) "
+                     << M_x( M_rng ) << ' ' << M_y( M_rng ) << ' '
+                     << vx << ' ' << M_player_vel( M_rng ) << ' '
+                     << M_dir( M_rng ) << " 0 (8000 1 1 130600))";
+              }
+          }
+          os << ')';
+          return os.str();
+      }
+
+    rcsc::Vector2D randomBallPos()
+      {
+          return rcsc::Vector2D( M_x( M_rng ), M_y( M_rng ) );
+      }
+
+    rcsc::Vector2D randomBallVel()
+      {
+          return rcsc::Vector2D::polar2vector( M_ball_speed( M_rng ), M_dir( M_rng ) );
+      }
+};
+
+/*!
+  \brief compare the intercept results of two models
+  \return the number of different values
+ */
+int
+compare( const rcsc::InterceptTable & incremental,
+         const rcsc::InterceptTable & full )
+{
+    int diff = 0;
+
+    diff += ( incremental.selfReachStep() != full.selfReachStep() );
+    diff += ( incremental.selfExhaustReachStep() != full.selfExhaustReachStep() );
+    diff += ( incremental.teammateReachStep() != full.teammateReachStep() );
+    diff += ( incremental.secondTeammateReachStep() != full.secondTeammateReachStep() );
+    diff += ( incremental.goalieReachStep() != full.goalieReachStep() );
+    diff += ( incremental.opponentReachStep() != full.opponentReachStep() );
+    diff += ( incremental.secondOpponentReachStep() != full.secondOpponentReachStep() );
+
+    for ( int unum = 1; unum <= 11; ++unum )
+    {
+        diff += ( incremental.playerReachStep( rcsc::LEFT, unum )
+                  != full.playerReachStep( rcsc::LEFT, unum ) );
+        diff += ( incremental.playerReachStep( rcsc::RIGHT, unum )
+                  != full.playerReachStep( rcsc::RIGHT, unum ) );
+    }
+
+    return diff;
+}
+
+}
+
+int
+main()
+{
+    using namespace rcsc;
+
+    NullAgent agent;
+    ActionEffector effector( agent );
+    FullstateGenerator generator;
+
+    int inertia_cycles = 0; // no message
+    int partial_cycles = 0; // the ball moves by inertia, some players are observed
+    int kicked_cycles = 0; // the ball and all players are changed
+    int reused_cycles = 0;
+    int partial_reused_cycles = 0; // some players are reused after the other players are observed
+    int fallback_cycles = 0; // no result is reused although the incremental mode is on
+    int failures = 0;
+
+    for ( int scenario = 0; scenario < 100; ++scenario )
+    {
+        WorldModel incremental_wm;
+        WorldModel full_wm;
+        incremental_wm.init( "L", LEFT, SELF_UNUM, false );
+        full_wm.init( "L", LEFT, SELF_UNUM, false );
+        incremental_wm.setInterceptIncremental( true );
+        full_wm.setInterceptIncremental( false );
+
+        for ( long cycle = 1; cycle <= 40; ++cycle )
+        {
+            const GameTime current( cycle, 0 );
+            if ( cycle == 1 )
+            {
+                const GameMode play_on( GameMode::PlayOn, NEUTRAL, current, 0, 0 );
+                incremental_wm.updateGameMode( play_on, current );
+                full_wm.updateGameMode( play_on, current );
+            }
+
+            std::string msg;
+            bool partial = false;
+            const double r = generator.prob();
+            if ( cycle == 1
+                 || r < 0.1 )
+            {
+                // perturbed ball and players
+                msg = generator.create( cycle,
+                                        generator.randomBallPos(),
+                                        generator.randomBallVel(),
+                                        1.0 );
+                ++kicked_cycles;
+            }
+            else if ( r < 0.3 )
+            {
+                // unperturbed ball, perturbed players
+                const BallObject & ball = full_wm.ball();
+                msg = generator.create( cycle,
+                                        ball.pos() + ball.vel(),
+                                        ball.vel() * ServerParam::i().ballDecay(),
+                                        0.3 );
+                partial = true;
+                ++partial_cycles;
+            }
+            else
+            {
+                ++inertia_cycles;
+            }
+
+            if ( ! msg.empty() )
+            {
+                FullstateSensor fullstate;
+                fullstate.parse( msg.c_str(), LEFT, 14.0, current );
+                incremental_wm.updateAfterFullstate( fullstate, effector, current );
+                full_wm.updateAfterFullstate( fullstate, effector, current );
+            }
+
+            incremental_wm.updateJustBeforeDecision( effector, current );
+            full_wm.updateJustBeforeDecision( effector, current );
+
+            if ( full_wm.interceptTable()->reusedPlayerCount() != 0 )
+            {
+                std::cerr << "failed: the full recomputation reused the results. cycle="
+                          << cycle << std::endl;
+                ++failures;
+            }
+
+            if ( incremental_wm.interceptTable()->reusedPlayerCount() > 0 )
+            {
+                ++reused_cycles;
+                if ( partial ) ++partial_reused_cycles;
+            }
+            else
+            {
+                ++fallback_cycles;
+            }
+
+            const int diff = compare( *incremental_wm.interceptTable(),
+                                      *full_wm.interceptTable() );
+            if ( diff != 0 )
+            {
+                std::cerr << "failed: incremental update differs from full recomputation."
+                          << " scenario=" << scenario << " cycle=" << cycle
+                          << " values=" << diff << std::endl;
+                ++failures;
+            }
+        }
+    }
+
+    std::cout << "inertia " << inertia_cycles
+              << ", partial " << partial_cycles
+              << ", kicked " << kicked_cycles
+              << " cycles. reused " << reused_cycles
+              << " (partial " << partial_reused_cycles << ")"
+              << ", fallback " << fallback_cycles
+              << " cycles. " << failures << " failures" << std::endl;
+
+    // all paths must have been exercised
+    if ( reused_cycles == 0
+         || partial_reused_cycles == 0
+         || fallback_cycles == 0 )
+    {
+        std::cerr << "failed: the incremental and the fallback paths are not covered."
+                  << std::endl;
+        ++failures;
+    }
+
+    return ( failures == 0 ? 0 : 1 );
+}
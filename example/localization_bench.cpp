@@ -0,0 +1,326 @@
+// -*-c++-*-
+
+/*!
+  \file localization_bench.cpp
+  \brief benchmark of the self localization.
+
+  LocalizationDefault and LocalizationPFilter with several resample sizes
+  are run on the same see messages. By default, the see messages are
+  generated from random player states with the rcssserver quantization,
+  so that the localization error can be measured. If a file is given,
+  every line that contains "(see " is used instead, and the face angle is
+  estimated from the message. In that case, the distance from the result
+  of LocalizationDefault is reported as the error.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/localization_default.h>
+#include <rcsc/player/localization_pfilter.h>
+#include <rcsc/player/object_table.h>
+#include <rcsc/player/visual_sensor.h>
+#include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+const double CLIENT_VERSION = 15.0;
+const double VIEW_HALF_WIDTH = 45.0; // normal view width
+
+/*!
+  \brief flag names in the see message
+ */
+const struct {
+    const char * name_;
+    rcsc::MarkerID id_;
+} MARKER_NAMES[] = {
+    { "g l", rcsc::Goal_L }, { "g r", rcsc::Goal_R },
+    { "f c", rcsc::Flag_C }, { "f c t", rcsc::Flag_CT }, { "f c b", rcsc::Flag_CB },
+    { "f l t", rcsc::Flag_LT }, { "f l b", rcsc::Flag_LB },
+    { "f r t", rcsc::Flag_RT }, { "f r b", rcsc::Flag_RB },
+    { "f p l t", rcsc::Flag_PLT }, { "f p l c", rcsc::Flag_PLC }, { "f p l b", rcsc::Flag_PLB },
+    { "f p r t", rcsc::Flag_PRT }, { "f p r c", rcsc::Flag_PRC }, { "f p r b", rcsc::Flag_PRB },
+    { "f g l t", rcsc::Flag_GLT }, { "f g l b", rcsc::Flag_GLB },
+    { "f g r t", rcsc::Flag_GRT }, { "f g r b", rcsc::Flag_GRB },
+    { "f t l 50", rcsc::Flag_TL50 }, { "f t l 40", rcsc::Flag_TL40 }, { "f t l 30", rcsc::Flag_TL30 },
+    { "f t l 20", rcsc::Flag_TL20 }, { "f t l 10", rcsc::Flag_TL10 }, { "f t 0", rcsc::Flag_T0 },
+    { "f t r 10", rcsc::Flag_TR10 }, { "f t r 20", rcsc::Flag_TR20 }, { "f t r 30", rcsc::Flag_TR30 },
+    { "f t r 40", rcsc::Flag_TR40 }, { "f t r 50", rcsc::Flag_TR50 },
+    { "f b l 50", rcsc::Flag_BL50 }, { "f b l 40", rcsc::Flag_BL40 }, { "f b l 30", rcsc::Flag_BL30 },
+    { "f b l 20", rcsc::Flag_BL20 }, { "f b l 10", rcsc::Flag_BL10 }, { "f b 0", rcsc::Flag_B0 },
+    { "f b r 10", rcsc::Flag_BR10 }, { "f b r 20", rcsc::Flag_BR20 }, { "f b r 30", rcsc::Flag_BR30 },
+    { "f b r 40", rcsc::Flag_BR40 }, { "f b r 50", rcsc::Flag_BR50 },
+    { "f l t 30", rcsc::Flag_LT30 }, { "f l t 20", rcsc::Flag_LT20 }, { "f l t 10", rcsc::Flag_LT10 },
+    { "f l 0", rcsc::Flag_L0 },
+    { "f l b 10", rcsc::Flag_LB10 }, { "f l b 20", rcsc::Flag_LB20 }, { "f l b 30", rcsc::Flag_LB30 },
+    { "f r t 30", rcsc::Flag_RT30 }, { "f r t 20", rcsc::Flag_RT20 }, { "f r t 10", rcsc::Flag_RT10 },
+    { "f r 0", rcsc::Flag_R0 },
+    { "f r b 10", rcsc::Flag_RB10 }, { "f r b 20", rcsc::Flag_RB20 }, { "f r b 30", rcsc::Flag_RB30 },
+};
+
+struct Sample {
+    std::string message_;
+    rcsc::Vector2D pos_; //!< true position. invalid if unknown
+    double face_; //!< true face angle. VisualSensor::DIR_ERR if unknown
+};
+
+/*!
+  \brief rcssserver's quantization of the landmark distance
+ */
+double
+quantize_dist( const double dist )
+{
+    const double qstep = 0.01;
+    const double d = std::exp( std::rint( std::log( dist + rcsc::ObjectTable::SERVER_EPS ) / qstep ) * qstep );
+    return std::rint( d / 0.1 ) * 0.1;
+}
+
+/*!
+  \brief generate the see message observed at the given state
+ */
+std::string
+make_see_message( const int cycle,
+                  const rcsc::Vector2D & pos,
+                  const double face,
+                  const rcsc::ObjectTable & table,
+                  int * marker_count )
+{
+    std::ostringstream os;
+    os.setf( std::ios::fixed );
+    os << "(see " << cycle;
+
+    *marker_count = 0;
+    for ( const auto & m : MARKER_NAMES )
+    {
+        const rcsc::Vector2D rel = table.landmarkMap().at( m.id_ ) - pos;
+        const double dir = rcsc::AngleDeg::normalize_angle( rel.th().degree() - face );
+        if ( std::fabs( dir ) > VIEW_HALF_WIDTH )
+        {
+            continue;
+        }
+
+        os << " ((" << m.name_ << ") "
+           << std::setprecision( 1 ) << quantize_dist( rel.r() ) << ' '
+           << std::setprecision( 0 ) << std::rint( dir ) << ')';
+        ++(*marker_count);
+    }
+
+    os << ')';
+    return os.str();
+}
+
+std::vector< Sample >
+generate_samples( const std::size_t size )
+{
+    std::mt19937 rng( 2021 );
+    std::uniform_real_distribution< double > x_dist( -50.0, 50.0 );
+    std::uniform_real_distribution< double > y_dist( -32.0, 32.0 );
+    std::uniform_real_distribution< double > face_dist( -180.0, 180.0 );
+
+    const rcsc::ObjectTable table;
+    std::vector< Sample > samples;
+
+    while ( samples.size() < size )
+    {
+        Sample s;
+        s.pos_.assign( x_dist( rng ), y_dist( rng ) );
+        s.face_ = face_dist( rng );
+
+        int marker_count = 0;
+        s.message_ = make_see_message( static_cast< int >( samples.size() ) + 1,
+                                       s.pos_, s.face_, table, &marker_count );
+        if ( marker_count >= 3 )
+        {
+            samples.push_back( s );
+        }
+    }
+
+    return samples;
+}
+
+std::vector< Sample >
+read_samples( const char * path )
+{
+    std::vector< Sample > samples;
+    std::ifstream fin( path );
+    std::string line;
+    while ( std::getline( fin, line ) )
+    {
+        const std::string::size_type pos = line.find( "(see " );
+        if ( pos == std::string::npos )
+        {
+            continue;
+        }
+
+        Sample s;
+        s.message_ = line.substr( pos );
+        s.pos_.invalidate();
+        s.face_ = rcsc::VisualSensor::DIR_ERR;
+        samples.push_back( s );
+    }
+    return samples;
+}
+
+struct Result {
+    double usec_;
+    double mean_error_;
+    int failed_;
+};
+
+/*!
+  \brief run the localizer on all samples
+  \param reference used as the true positions of the samples whose truth is unknown
+ */
+Result
+run( rcsc::Localization & localizer,
+     const std::vector< rcsc::VisualSensor > & sees,
+     const std::vector< Sample > & samples,
+     const int loop,
+     const std::vector< rcsc::Vector2D > & reference,
+     std::vector< rcsc::Vector2D > * positions )
+{
+    Result result = { 0.0, 0.0, 0 };
+    positions->assign( sees.size(), rcsc::Vector2D::INVALIDATED );
+
+    double error_sum = 0.0;
+    int error_count = 0;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( int l = 0; l < loop; ++l )
+    {
+        for ( std::size_t i = 0; i < sees.size(); ++i )
+        {
+            double face = samples[i].face_;
+            double face_err = 0.5;
+            if ( face == rcsc::VisualSensor::DIR_ERR
+                 && ! localizer.estimateSelfFace( sees[i], &face, &face_err ) )
+            {
+                if ( l == 0 ) ++result.failed_;
+                continue;
+            }
+
+            rcsc::Vector2D pos, pos_err;
+            if ( ! localizer.localizeSelf( sees[i], face, face_err, &pos, &pos_err ) )
+            {
+                if ( l == 0 ) ++result.failed_;
+                continue;
+            }
+
+            if ( l == 0 )
+            {
+                ( *positions )[i] = pos;
+                const rcsc::Vector2D & truth = ( samples[i].pos_.isValid()
+                                                 ? samples[i].pos_
+                                                 : i < reference.size()
+                                                 ? reference[i]
+                                                 : rcsc::Vector2D::INVALIDATED );
+                if ( truth.isValid() )
+                {
+                    error_sum += truth.dist( pos );
+                    ++error_count;
+                }
+            }
+        }
+    }
+    const double elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+    result.usec_ = elapsed * 1.0e6 / ( static_cast< double >( loop ) * sees.size() );
+    result.mean_error_ = ( error_count > 0 ? error_sum / error_count : 0.0 );
+    return result;
+}
+
+void
+print( const char * name,
+       const Result & r )
+{
+    std::cout << name << ": " << r.usec_ << " usec/see, mean error "
+              << r.mean_error_ << ", failed " << r.failed_ << '\n';
+}
+
+}
+
+int
+main( int argc, char ** argv )
+{
+    const std::vector< Sample > samples = ( argc >= 2 && std::string( argv[1] ) != "-"
+                                            ? read_samples( argv[1] )
+                                            : generate_samples( 1000 ) );
+    const int loop = ( argc >= 3 ? std::max( 1, std::atoi( argv[2] ) ) : 10 );
+
+    if ( samples.empty() )
+    {
+        std::cerr << "no see message." << std::endl;
+        return 1;
+    }
+
+    std::vector< rcsc::VisualSensor > sees( samples.size() );
+    for ( std::size_t i = 0; i < samples.size(); ++i )
+    {
+        sees[i].parse( samples[i].message_.c_str(), "bench", CLIENT_VERSION,
+                       rcsc::GameTime( static_cast< long >( i ) + 1, 0 ) );
+    }
+
+    std::cout << "see messages: " << sees.size() << ", loop: " << loop << '\n';
+
+    std::vector< rcsc::Vector2D > reference;
+    std::vector< rcsc::Vector2D > positions;
+
+    {
+        rcsc::LocalizationDefault localizer;
+        print( "default       ", run( localizer, sees, samples, loop,
+                                      std::vector< rcsc::Vector2D >(), &reference ) );
+    }
+
+    const std::size_t sizes[] = { 50, 100, 200, 400 };
+    for ( std::size_t size : sizes )
+    {
+        rcsc::LocalizationPFilter localizer;
+        localizer.setResampleSize( size );
+
+        char name[32];
+        std::snprintf( name, sizeof( name ), "pfilter %5d ", static_cast< int >( size ) );
+        print( name, run( localizer, sees, samples, loop, reference, &positions ) );
+    }
+
+    std::cout << std::flush;
+    return 0;
+}
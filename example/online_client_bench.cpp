@@ -0,0 +1,333 @@
+// -*-c++-*-
+
+/*!
+  \file online_client_bench.cpp
+  \brief benchmark of the OnlineClient event loops.
+
+  A local UDP stand-in server sends a burst of messages every cycle, i.e.
+  sense_body, see and several hear messages, as rcssserver does. The
+  agent replies a command after it receives the whole burst, and the
+  server sends the next burst when the command arrives. The server runs
+  in the agent thread, so the whole burst is already queued when the
+  client waits for the next event. The time per cycle and the number of
+  handleMessage() calls are compared between the select() loop and the
+  epoll loop.
+
+  usage: online_client_bench [cycles [hear_count [port]]]
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/common/online_client.h>
+#include <rcsc/common/soccer_agent.h>
+#include <rcsc/net/udp_socket.h>
+#include <rcsc/net/host_address.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+namespace {
+
+/*!
+  \brief wait a datagram on the server socket
+ */
+int
+wait_datagram( rcsc::UDPSocket & socket,
+               char * buf,
+               const std::size_t len,
+               rcsc::HostAddress * from )
+{
+    while ( true )
+    {
+        struct pollfd pfd;
+        pfd.fd = socket.fd();
+        pfd.events = POLLIN;
+        if ( ::poll( &pfd, 1, 5000 ) <= 0 )
+        {
+            return -1;
+        }
+
+        const int n = socket.readDatagram( buf, len, from );
+        if ( n != 0 )
+        {
+            return n;
+        }
+    }
+}
+
+/*!
+  \brief send the messages so that all of them are queued at once, as rcssserver does
+ */
+void
+send_burst( rcsc::UDPSocket & socket,
+            const char * const * msgs,
+            const int count,
+            const rcsc::HostAddress & to )
+{
+#ifdef HAVE_RECVMMSG
+    struct mmsghdr hdrs[64];
+    struct iovec iovecs[64];
+    const int size = std::min( count, 64 );
+
+    std::memset( hdrs, 0, sizeof( hdrs ) );
+    for ( int i = 0; i < size; ++i )
+    {
+        iovecs[i].iov_base = const_cast< char * >( msgs[i] );
+        iovecs[i].iov_len = std::strlen( msgs[i] ) + 1;
+        hdrs[i].msg_hdr.msg_iov = &iovecs[i];
+        hdrs[i].msg_hdr.msg_iovlen = 1;
+        hdrs[i].msg_hdr.msg_name = const_cast< rcsc::HostAddress::AddrType * >( &to.toAddress() );
+        hdrs[i].msg_hdr.msg_namelen = sizeof( rcsc::HostAddress::AddrType );
+    }
+    ::sendmmsg( socket.fd(), hdrs, size, 0 );
+#else
+    for ( int i = 0; i < count; ++i )
+    {
+        socket.writeDatagram( msgs[i], std::strlen( msgs[i] ) + 1, to );
+    }
+#endif
+}
+
+/*!
+  \brief stand-in of rcssserver.
+  It runs in the same thread as the client, so that the whole burst is
+  queued before the client waits for the next event.
+ */
+class StandInServer {
+private:
+    rcsc::UDPSocket M_socket;
+    rcsc::HostAddress M_client;
+    std::vector< const char * > M_burst;
+    const int M_cycles;
+    int M_cycle;
+
+public:
+    StandInServer( const int port,
+                   const int cycles,
+                   const int hear_count )
+        : M_socket( port ),
+          M_cycles( cycles ),
+          M_cycle( 0 )
+      {
+          static const char see[] = "(see 0 ((f c) 10.0 0) ((f c t) 30.0 -20) ((b) 5.0 10 0.1 0.2)"
+              " ((p \"opp\" 3) 12.2 4 0 0 10 20) ((l t) 40 -80))";
+          static const char sense[] = "(sense_body 0 (view_mode high normal) (stamina 8000 1 130600) (speed 0 0)"
+              " (head_angle 0) (kick 0) (dash 0) (turn 0) (say 0) (turn_neck 0) (catch 0) (move 0))";
+          static const char hear[] = "(hear 0 -30 our 5 \"abcdefghij\")";
+
+          M_burst.push_back( sense );
+          M_burst.push_back( see );
+          for ( int i = 0; i < hear_count; ++i )
+          {
+              M_burst.push_back( hear );
+          }
+      }
+
+    bool isOpen() const
+      {
+          return M_socket.fd() != -1;
+      }
+
+    int burstSize() const
+      {
+          return static_cast< int >( M_burst.size() );
+      }
+
+    /*!
+      \brief receive the message from the client, and send the next burst or (bye)
+     */
+    bool nextCycle()
+      {
+          char buf[rcsc::AbstractClient::MAX_MESG];
+          if ( wait_datagram( M_socket, buf, sizeof( buf ), &M_client ) < 0 )
+          {
+              std::cerr << "server: no message at cycle " << M_cycle << std::endl;
+              return false;
+          }
+
+          if ( M_cycle++ < M_cycles )
+          {
+              send_burst( M_socket, &M_burst[0], burstSize(), M_client );
+          }
+          else
+          {
+              const char bye[] = "(bye)";
+              M_socket.writeDatagram( bye, sizeof( bye ), M_client );
+          }
+          return true;
+      }
+};
+
+/*!
+  \brief agent that only counts the received messages
+ */
+class BenchAgent
+    : public rcsc::SoccerAgent {
+private:
+    const int M_port;
+    StandInServer & M_server;
+    int M_received;
+
+public:
+    long M_message_count;
+    long M_handle_count;
+
+    BenchAgent( const int port,
+                StandInServer & server )
+        : M_port( port ),
+          M_server( server ),
+          M_received( 0 ),
+          M_message_count( 0 ),
+          M_handle_count( 0 )
+      { }
+
+    boost::shared_ptr< rcsc::AbstractClient > createConsoleClient()
+      {
+          return boost::shared_ptr< rcsc::AbstractClient >( new rcsc::OnlineClient() );
+      }
+
+protected:
+
+    bool initImpl( rcsc::CmdLineParser & )
+      {
+          return true;
+      }
+
+    bool handleStart()
+      {
+          if ( ! M_client->connectTo( "localhost", M_port ) )
+          {
+              return false;
+          }
+          M_client->sendMessage( "(init bench)" );
+          return M_server.nextCycle();
+      }
+
+    void handleMessage()
+      {
+          ++M_handle_count;
+          bool next_cycle = false;
+          while ( M_client->receiveMessage() > 0 )
+          {
+              if ( ! std::strncmp( M_client->message(), "(bye)", 5 ) )
+              {
+                  M_client->setServerAlive( false );
+                  return;
+              }
+
+              ++M_message_count;
+              if ( ++M_received == M_server.burstSize() )
+              {
+                  M_received = 0;
+                  M_client->sendMessage( "(turn 0)" );
+                  next_cycle = true;
+              }
+          }
+
+          // the next burst is received by the next wakeup
+          if ( next_cycle
+               && ! M_server.nextCycle() )
+          {
+              M_client->setServerAlive( false );
+          }
+      }
+
+    void handleTimeout( const int,
+                        const int waited_msec )
+      {
+          if ( waited_msec > 5000 )
+          {
+              std::cerr << "agent: server timeout." << std::endl;
+              M_client->setServerAlive( false );
+          }
+      }
+
+    void handleExit()
+      { }
+};
+
+/*!
+  \brief run the benchmark with the event loop
+ */
+void
+run( const char * name,
+     const rcsc::OnlineClient::EventLoopType type,
+     const int cycles,
+     const int hear_count,
+     const int port )
+{
+    StandInServer server( port, cycles, hear_count );
+    if ( ! server.isOpen() )
+    {
+        std::cerr << "failed to open the server port " << port << std::endl;
+        return;
+    }
+
+    BenchAgent agent( port, server );
+    boost::shared_ptr< rcsc::OnlineClient > client( new rcsc::OnlineClient() );
+    client->setEventLoop( type );
+    agent.setClient( client );
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    client->run( &agent );
+    const double elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+    std::cout << name << ": "
+              << elapsed * 1.0e6 / cycles << " usec/cycle, "
+              << static_cast< double >( agent.M_message_count ) / cycles << " messages/cycle, "
+              << static_cast< double >( agent.M_handle_count ) / cycles << " wakeups/cycle"
+              << std::endl;
+}
+
+}
+
+int
+main( int argc, char ** argv )
+{
+    const int cycles = ( argc >= 2 ? std::max( 1, std::atoi( argv[1] ) ) : 10000 );
+    const int hear_count = ( argc >= 3 ? std::min( 62, std::max( 0, std::atoi( argv[2] ) ) ) : 4 );
+    const int port = ( argc >= 4 ? std::atoi( argv[3] ) : 16000 );
+
+    std::cout << "cycles: " << cycles << ", messages/cycle: " << hear_count + 2 << std::endl;
+
+    run( "select", rcsc::OnlineClient::SELECT_LOOP, cycles, hear_count, port );
+    run( "epoll ", rcsc::OnlineClient::EPOLL_LOOP, cycles, hear_count, port + 1 );
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+// -*-c++-*-
+
+/*!
+  \file player_filter_test.cpp
+  \brief behavior test of the statically composed player filters.
+
+  and_player_filter(), or_player_filter() and not_player_filter() are
+  compared with AndPlayerPredicate, OrPlayerPredicate and NotPlayerPredicate,
+  and PlayerObjectBuffer is checked for the truncation.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/player_filter.h>
+#include <rcsc/player/player_predicate.h>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void
+check( const bool result,
+       const char * msg )
+{
+    if ( ! result )
+    {
+        std::cerr << "failed: " << msg << std::endl;
+        ++failures;
+    }
+}
+
+}
+
+int
+main()
+{
+    using namespace rcsc;
+
+    std::mt19937 rng( 2021 );
+    std::uniform_real_distribution< double > x_dist( -52.5, 52.5 );
+    std::uniform_real_distribution< double > y_dist( -34.0, 34.0 );
+    std::uniform_int_distribution< int > side_dist( -1, 1 );
+    std::uniform_int_distribution< int > count_dist( 0, 5 );
+    std::uniform_int_distribution< int > goalie_dist( 0, 10 );
+
+    std::vector< PlayerObject > objects( 200 );
+    for ( PlayerObject & p : objects )
+    {
+        p.updateByHear( static_cast< SideID >( side_dist( rng ) ), Unum_Unknown,
+                        goalie_dist( rng ) == 0,
+                        Vector2D( x_dist( rng ), y_dist( rng ) ) );
+        for ( int i = count_dist( rng ); i > 0; --i ) p.update();
+    }
+
+    //
+    // compare with the virtual predicates
+    //
+    const Vector2D point( 10.0, -5.0 );
+
+    const auto and_filter = and_player_filter( OpponentOrUnknownPlayerPredicate( LEFT ),
+                                               CoordinateAccuratePlayerPredicate( 3 ),
+                                               not_player_filter( GoaliePlayerPredicate() ),
+                                               [&]( const AbstractPlayerObject & p )
+                                               {
+                                                   return p.pos().dist2( point ) <= 30.0 * 30.0;
+                                               } );
+    const AndPlayerPredicate and_predicate( new OpponentOrUnknownPlayerPredicate( LEFT ),
+                                            new CoordinateAccuratePlayerPredicate( 3 ),
+                                            new NotPlayerPredicate( new GoaliePlayerPredicate() ),
+                                            new PointNearPlayerPredicate( point, 30.0 ) );
+
+    const auto or_filter = or_player_filter( GoaliePlayerPredicate(),
+                                             XCoordinateForwardPlayerPredicate( 40.0 ),
+                                             not_player_filter( CoordinateAccuratePlayerPredicate( 4 ) ) );
+    const OrPlayerPredicate or_predicate( new GoaliePlayerPredicate(),
+                                          new XCoordinateForwardPlayerPredicate( 40.0 ),
+                                          new NotPlayerPredicate( new CoordinateAccuratePlayerPredicate( 4 ) ) );
+
+    int and_count = 0;
+    int or_count = 0;
+    for ( const PlayerObject & p : objects )
+    {
+        check( and_filter( p ) == and_predicate( p ), "and_player_filter" );
+        check( or_filter( p ) == or_predicate( p ), "or_player_filter" );
+        and_count += and_filter( p );
+        or_count += or_filter( p );
+    }
+
+    // both branches must have been exercised
+    check( 0 < and_count && and_count < static_cast< int >( objects.size() ), "and_player_filter coverage" );
+    check( 0 < or_count && or_count < static_cast< int >( objects.size() ), "or_player_filter coverage" );
+
+    //
+    // buffer capacity
+    //
+    check( PlayerObjectBuffer<>::capacity() > PlayerObjectPool::CAPACITY,
+           "the default capacity holds self and the pool" );
+
+    PlayerObjectBuffer< 4 > buffer;
+    for ( std::size_t i = 0; i < 4; ++i )
+    {
+        check( buffer.push_back( &objects[i] ), "push_back into the free buffer" );
+    }
+    check( buffer.full() && ! buffer.truncated(), "full buffer is not truncated" );
+    check( ! buffer.push_back( &objects[4] ), "push_back into the full buffer" );
+    check( buffer.size() == 4 && buffer.truncated(), "dropped player is reported" );
+    check( buffer.back() == &objects[3], "dropped player is not stored" );
+
+    buffer.clear();
+    check( buffer.empty() && ! buffer.truncated(), "clear() resets the truncation" );
+
+    std::cout << ( failures == 0 ? "passed" : "FAILED" ) << std::endl;
+    return ( failures == 0 ? 0 : 1 );
+}
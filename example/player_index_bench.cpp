@@ -0,0 +1,441 @@
+// -*-c++-*-
+
+/*!
+  \file player_index_bench.cpp
+  \brief benchmark of the nearest player queries.
+
+  The linear scans used by WorldModel are compared with a uniform grid
+  index over the pitch. With the number of players in a game, the linear
+  scans are faster, so WorldModel does not build any spatial index.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/world_model.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+const double MAX_DIST2 = 40000.0;
+
+/*!
+  \brief the linear scan in WorldModel::getPlayerNearestTo().
+ */
+const rcsc::PlayerObject *
+linear_nearest( const rcsc::PlayerObject::Cont & players,
+                const rcsc::Vector2D & point,
+                const int count_thr )
+{
+    const rcsc::PlayerObject * p = static_cast< rcsc::PlayerObject * >( 0 );
+    double min_dist2 = MAX_DIST2;
+
+    for ( const rcsc::PlayerObject * o : players )
+    {
+        if ( o->posCount() > count_thr ) continue;
+
+        double d2 = o->pos().dist2( point );
+        if ( d2 < min_dist2 )
+        {
+            p = o;
+            min_dist2 = d2;
+        }
+    }
+
+    return p;
+}
+
+/*!
+  \brief the k nearest players by the copy and the stable sort.
+ */
+void
+sort_nearest_k( const rcsc::PlayerObject::Cont & players,
+                const rcsc::Vector2D & point,
+                const std::size_t k,
+                const int count_thr,
+                rcsc::PlayerObject::Cont & result )
+{
+    rcsc::PlayerObject::Cont tmp;
+    for ( const rcsc::PlayerObject * o : players )
+    {
+        if ( o->posCount() <= count_thr
+             && o->pos().dist2( point ) < MAX_DIST2 )
+        {
+            tmp.push_back( o );
+        }
+    }
+
+    std::stable_sort( tmp.begin(), tmp.end(),
+                      [&]( const rcsc::PlayerObject * a, const rcsc::PlayerObject * b )
+                      {
+                          return a->pos().dist2( point ) < b->pos().dist2( point );
+                      } );
+    if ( tmp.size() > k ) tmp.resize( k );
+    result.insert( result.end(), tmp.begin(), tmp.end() );
+}
+
+/*!
+  \brief uniform grid index. the players are sorted by the cell index.
+ */
+class GridIndex {
+public:
+    static const int COLUMNS = 6;
+    static const int ROWS = 4;
+
+private:
+    struct Entry {
+        const rcsc::PlayerObject * player_;
+        rcsc::Vector2D pos_;
+        int count_;
+        int rank_;
+    };
+
+    struct Candidate {
+        double dist2_;
+        int rank_;
+        const rcsc::PlayerObject * player_;
+
+        bool operator<( const Candidate & rhs ) const
+          {
+              return ( dist2_ < rhs.dist2_
+                       || ( dist2_ == rhs.dist2_ && rank_ < rhs.rank_ ) );
+          }
+    };
+
+    static constexpr double CELL_SIZE = 20.0;
+    static constexpr double MIN_X = -60.0;
+    static constexpr double MIN_Y = -40.0;
+
+    int M_cell_start[COLUMNS * ROWS + 1];
+    std::vector< Entry > M_entries;
+
+    static int column( const double x )
+      {
+          int c = static_cast< int >( std::floor( ( x - MIN_X ) / CELL_SIZE ) );
+          return ( c < 0 ? 0 : c >= COLUMNS ? COLUMNS - 1 : c );
+      }
+
+    static int row( const double y )
+      {
+          int r = static_cast< int >( std::floor( ( y - MIN_Y ) / CELL_SIZE ) );
+          return ( r < 0 ? 0 : r >= ROWS ? ROWS - 1 : r );
+      }
+
+public:
+
+    void build( const rcsc::PlayerObject::Cont & players )
+      {
+          std::vector< int > cells( players.size() );
+          int count[COLUMNS * ROWS + 1] = { 0 };
+          for ( std::size_t i = 0; i < players.size(); ++i )
+          {
+              cells[i] = row( players[i]->pos().y ) * COLUMNS + column( players[i]->pos().x );
+              ++count[cells[i] + 1];
+          }
+
+          M_cell_start[0] = 0;
+          for ( int c = 0; c < COLUMNS * ROWS; ++c )
+          {
+              M_cell_start[c + 1] = M_cell_start[c] + count[c + 1];
+              count[c + 1] = M_cell_start[c];
+          }
+
+          M_entries.resize( players.size() );
+          for ( std::size_t i = 0; i < players.size(); ++i )
+          {
+              Entry & e = M_entries[count[cells[i] + 1]++];
+              e.player_ = players[i];
+              e.pos_ = players[i]->pos();
+              e.count_ = players[i]->posCount();
+              e.rank_ = static_cast< int >( i );
+          }
+      }
+
+    /*!
+      \brief visit the cells ring by ring. all cells in the ring r + 1
+      are at least r * CELL_SIZE away from the point.
+     */
+    void nearestK( const rcsc::Vector2D & point,
+                   const std::size_t k,
+                   const int count_thr,
+                   rcsc::PlayerObject::Cont & result ) const
+      {
+          const std::size_t max_size = std::min( k, M_entries.size() );
+          if ( max_size == 0 ) return;
+
+          const int cx = column( point.x );
+          const int cy = row( point.y );
+          const int max_ring = std::max( std::max( cx, COLUMNS - 1 - cx ),
+                                         std::max( cy, ROWS - 1 - cy ) );
+
+          Candidate buf[rcsc::PlayerObjectPool::CAPACITY];
+          std::size_t n = 0;
+
+          for ( int r = 0; r <= max_ring; ++r )
+          {
+              for ( int y = std::max( 0, cy - r ); y <= std::min( ROWS - 1, cy + r ); ++y )
+              {
+                  const int step = ( y == cy - r || y == cy + r ? 1 : 2 * r );
+                  for ( int x = cx - r; x <= cx + r; x += step )
+                  {
+                      if ( x < 0 || COLUMNS <= x ) continue;
+
+                      const int cell = y * COLUMNS + x;
+                      for ( int i = M_cell_start[cell]; i < M_cell_start[cell + 1]; ++i )
+                      {
+                          const Entry & e = M_entries[i];
+                          if ( e.count_ > count_thr ) continue;
+
+                          Candidate c = { e.pos_.dist2( point ), e.rank_, e.player_ };
+                          if ( c.dist2_ >= MAX_DIST2
+                               || ( n == max_size && ! ( c < buf[n - 1] ) ) )
+                          {
+                              continue;
+                          }
+
+                          std::size_t j = ( n < max_size ? n++ : n - 1 );
+                          while ( j > 0 && c < buf[j - 1] )
+                          {
+                              buf[j] = buf[j - 1];
+                              --j;
+                          }
+                          buf[j] = c;
+                      }
+                  }
+              }
+
+              if ( n == max_size
+                   && buf[n - 1].dist2_ < std::pow( r * CELL_SIZE, 2 ) )
+              {
+                  break;
+              }
+          }
+
+          for ( std::size_t i = 0; i < n; ++i ) result.push_back( buf[i].player_ );
+      }
+
+    void within( const rcsc::Vector2D & point,
+                 const double radius,
+                 const int count_thr,
+                 rcsc::PlayerObject::Cont & result ) const
+      {
+          Candidate buf[rcsc::PlayerObjectPool::CAPACITY];
+          std::size_t n = 0;
+
+          for ( int y = row( point.y - radius ); y <= row( point.y + radius ); ++y )
+          {
+              for ( int x = column( point.x - radius ); x <= column( point.x + radius ); ++x )
+              {
+                  const int cell = y * COLUMNS + x;
+                  for ( int i = M_cell_start[cell]; i < M_cell_start[cell + 1]; ++i )
+                  {
+                      const Entry & e = M_entries[i];
+                      if ( e.count_ <= count_thr
+                           && e.pos_.dist2( point ) <= radius * radius )
+                      {
+                          Candidate c = { 0.0, e.rank_, e.player_ };
+                          buf[n++] = c;
+                      }
+                  }
+              }
+          }
+
+          // restore the order of the input container
+          std::sort( buf, buf + n );
+          for ( std::size_t i = 0; i < n; ++i ) result.push_back( buf[i].player_ );
+      }
+};
+
+double
+elapsed_sec( const std::chrono::steady_clock::time_point & start )
+{
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+}
+
+int
+main( int argc, char ** argv )
+{
+    const int players_size = ( argc >= 2 ? std::max( 1, std::min( 64, std::atoi( argv[1] ) ) ) : 11 );
+    const int queries = ( argc >= 3 ? std::max( 1, std::atoi( argv[2] ) ) : 1000000 );
+
+    std::mt19937 rng( 2021 );
+    std::uniform_real_distribution< double > x_dist( -57.5, 57.5 );
+    std::uniform_real_distribution< double > y_dist( -39.0, 39.0 );
+    std::uniform_int_distribution< int > count_dist( 0, 5 );
+
+    // the position count varies as in a real game
+    std::vector< rcsc::PlayerObject > objects( players_size );
+    rcsc::PlayerObject::Cont players;
+    for ( rcsc::PlayerObject & p : objects )
+    {
+        p.updateByHear( rcsc::LEFT, rcsc::Unum_Unknown, false,
+                        rcsc::Vector2D( x_dist( rng ), y_dist( rng ) ) );
+        for ( int i = count_dist( rng ); i > 0; --i ) p.update();
+        players.push_back( &p );
+    }
+
+    std::vector< rcsc::Vector2D > points;
+    for ( int i = 0; i < queries; ++i )
+    {
+        points.push_back( rcsc::Vector2D( x_dist( rng ) * 1.1, y_dist( rng ) * 1.1 ) );
+    }
+
+    const int count_thr = 3;
+    const std::size_t k = 3;
+    const double radius = 10.0;
+
+    GridIndex grid;
+    grid.build( players );
+
+    //
+    // check the results
+    //
+    int mismatch = 0;
+    for ( std::size_t i = 0; i < points.size() && i < 20000; ++i )
+    {
+        rcsc::PlayerObject::Cont r1, r2, r3;
+        rcsc::WorldModel::getPlayersNearestTo( points[i], players, k, count_thr, r1 );
+        sort_nearest_k( players, points[i], k, count_thr, r2 );
+        grid.nearestK( points[i], k, count_thr, r3 );
+        if ( r1 != r2 || r1 != r3 ) ++mismatch;
+
+        r2.clear();
+        rcsc::WorldModel::getPlayersNearestTo( points[i], players, 1, count_thr, r2 );
+        if ( r2.empty() ? linear_nearest( players, points[i], count_thr ) != 0
+             : r2.front() != linear_nearest( players, points[i], count_thr ) )
+        {
+            ++mismatch;
+        }
+
+        r1.clear(); r2.clear();
+        rcsc::WorldModel::getPlayersWithin( points[i], players, radius, count_thr, r1 );
+        grid.within( points[i], radius, count_thr, r2 );
+        if ( r1 != r2 ) ++mismatch;
+    }
+
+    std::size_t checksum[3] = { 0, 0, 0 };
+    rcsc::PlayerObject::Cont result;
+    result.reserve( rcsc::PlayerObjectPool::CAPACITY );
+
+    //
+    // nearest
+    //
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( const rcsc::Vector2D & point : points )
+    {
+        checksum[0] += ( linear_nearest( players, point, count_thr ) != 0 );
+    }
+    const double nearest_linear = elapsed_sec( start );
+
+    start = std::chrono::steady_clock::now();
+    for ( const rcsc::Vector2D & point : points )
+    {
+        result.clear();
+        grid.nearestK( point, 1, count_thr, result );
+        checksum[1] += result.size();
+    }
+    const double nearest_grid = elapsed_sec( start );
+
+    //
+    // k nearest
+    //
+    start = std::chrono::steady_clock::now();
+    for ( const rcsc::Vector2D & point : points )
+    {
+        result.clear();
+        sort_nearest_k( players, point, k, count_thr, result );
+        checksum[2] += result.size();
+    }
+    const double k_sort = elapsed_sec( start );
+
+    start = std::chrono::steady_clock::now();
+    for ( const rcsc::Vector2D & point : points )
+    {
+        result.clear();
+        rcsc::WorldModel::getPlayersNearestTo( point, players, k, count_thr, result );
+        checksum[0] += result.size();
+    }
+    const double k_linear = elapsed_sec( start );
+
+    start = std::chrono::steady_clock::now();
+    for ( const rcsc::Vector2D & point : points )
+    {
+        result.clear();
+        grid.nearestK( point, k, count_thr, result );
+        checksum[1] += result.size();
+    }
+    const double k_grid = elapsed_sec( start );
+
+    //
+    // within the radius
+    //
+    start = std::chrono::steady_clock::now();
+    for ( const rcsc::Vector2D & point : points )
+    {
+        result.clear();
+        rcsc::WorldModel::getPlayersWithin( point, players, radius, count_thr, result );
+        checksum[0] += result.size();
+    }
+    const double within_linear = elapsed_sec( start );
+
+    start = std::chrono::steady_clock::now();
+    for ( const rcsc::Vector2D & point : points )
+    {
+        result.clear();
+        grid.within( point, radius, count_thr, result );
+        checksum[1] += result.size();
+    }
+    const double within_grid = elapsed_sec( start );
+
+    const bool ok = ( mismatch == 0
+                      && checksum[0] == checksum[1]
+                      && checksum[2] <= checksum[0] );
+    const double ns = 1.0e9 / queries;
+
+    std::cout << "players: " << players.size() << ", queries: " << points.size() << '\n'
+              << "nearest   linear: " << nearest_linear * ns << " ns/query\n"
+              << "nearest   grid:   " << nearest_grid * ns << " ns/query\n"
+              << k << "-nearest sort:   " << k_sort * ns << " ns/query\n"
+              << k << "-nearest linear: " << k_linear * ns << " ns/query\n"
+              << k << "-nearest grid:   " << k_grid * ns << " ns/query\n"
+              << "within    linear: " << within_linear * ns << " ns/query\n"
+              << "within    grid:   " << within_grid * ns << " ns/query\n"
+              << "results: " << ( ok ? "identical" : "DIFFERENT" )
+              << std::endl;
+
+    return ( ok ? 0 : 1 );
+}
@@ -0,0 +1,179 @@
+// -*-c++-*-
+
+/*!
+  \file player_query_test.cpp
+  \brief behavior test of the k nearest and the radius player queries.
+
+  WorldModel::getPlayersNearestTo() and WorldModel::getPlayersWithin()
+  are compared with the brute force results made by the stable sort.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/world_model.h>
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const double MAX_DIST2 = 40000.0;
+
+/*!
+  \brief the k nearest players by the copy and the stable sort.
+ */
+rcsc::PlayerObject::Cont
+brute_force_nearest( const rcsc::PlayerObject::Cont & players,
+                     const rcsc::Vector2D & point,
+                     const std::size_t k,
+                     const int count_thr )
+{
+    rcsc::PlayerObject::Cont result;
+    for ( const rcsc::PlayerObject * o : players )
+    {
+        if ( o->posCount() <= count_thr
+             && o->pos().dist2( point ) < MAX_DIST2 )
+        {
+            result.push_back( o );
+        }
+    }
+
+    std::stable_sort( result.begin(), result.end(),
+                      [&]( const rcsc::PlayerObject * a, const rcsc::PlayerObject * b )
+                      {
+                          return a->pos().dist2( point ) < b->pos().dist2( point );
+                      } );
+    if ( result.size() > k ) result.resize( k );
+    return result;
+}
+
+/*!
+  \brief the players within the radius in the order of the input container.
+ */
+rcsc::PlayerObject::Cont
+brute_force_within( const rcsc::PlayerObject::Cont & players,
+                    const rcsc::Vector2D & point,
+                    const double radius,
+                    const int count_thr )
+{
+    rcsc::PlayerObject::Cont result;
+    for ( const rcsc::PlayerObject * o : players )
+    {
+        if ( o->posCount() <= count_thr
+             && o->pos().dist( point ) <= radius )
+        {
+            result.push_back( o );
+        }
+    }
+    return result;
+}
+
+/*!
+  \brief check that the query appends its result after the existing elements.
+ */
+bool
+check_appended( const rcsc::PlayerObject::Cont & result,
+                const std::size_t n,
+                const rcsc::PlayerObject * sentinel,
+                const rcsc::PlayerObject::Cont & expected )
+{
+    return ( n == expected.size()
+             && result.size() == n + 1
+             && result.front() == sentinel
+             && std::equal( expected.begin(), expected.end(), result.begin() + 1 ) );
+}
+
+}
+
+int
+main()
+{
+    std::mt19937 rng( 2021 );
+    // integer coordinates make many players have the same distance
+    std::uniform_int_distribution< int > x_dist( -55, 55 );
+    std::uniform_int_distribution< int > y_dist( -35, 35 );
+    std::uniform_int_distribution< int > count_dist( 0, 5 );
+    std::uniform_int_distribution< int > size_dist( 0, 30 );
+    std::uniform_int_distribution< int > k_dist( 0, 30 );
+    std::uniform_int_distribution< int > radius_dist( 0, 40 );
+
+    rcsc::PlayerObject sentinel;
+
+    int trials = 0;
+    int failures = 0;
+
+    for ( int t = 0; t < 2000; ++t )
+    {
+        std::vector< rcsc::PlayerObject > objects( size_dist( rng ) );
+        rcsc::PlayerObject::Cont players;
+        for ( rcsc::PlayerObject & p : objects )
+        {
+            p.updateByHear( rcsc::LEFT, rcsc::Unum_Unknown, false,
+                            rcsc::Vector2D( x_dist( rng ), y_dist( rng ) ) );
+            for ( int i = count_dist( rng ); i > 0; --i ) p.update();
+            players.push_back( &p );
+        }
+
+        // far away points are also tested for the distance threshold
+        const rcsc::Vector2D point( x_dist( rng ) * ( t % 10 == 0 ? 5 : 1 ),
+                                    y_dist( rng ) );
+        const std::size_t k = k_dist( rng );
+        const double radius = radius_dist( rng );
+        const int count_thr = count_dist( rng );
+
+        rcsc::PlayerObject::Cont result( 1, &sentinel );
+        std::size_t n = rcsc::WorldModel::getPlayersNearestTo( point, players, k, count_thr, result );
+        ++trials;
+        if ( ! check_appended( result, n, &sentinel,
+                               brute_force_nearest( players, point, k, count_thr ) ) )
+        {
+            std::cerr << "getPlayersNearestTo: mismatch. trial=" << t
+                      << " players=" << players.size() << " k=" << k
+                      << " count_thr=" << count_thr << std::endl;
+            ++failures;
+        }
+
+        result.assign( 1, &sentinel );
+        n = rcsc::WorldModel::getPlayersWithin( point, players, radius, count_thr, result );
+        ++trials;
+        if ( ! check_appended( result, n, &sentinel,
+                               brute_force_within( players, point, radius, count_thr ) ) )
+        {
+            std::cerr << "getPlayersWithin: mismatch. trial=" << t
+                      << " players=" << players.size() << " radius=" << radius
+                      << " count_thr=" << count_thr << std::endl;
+            ++failures;
+        }
+    }
+
+    std::cout << trials << " queries, " << failures << " failures" << std::endl;
+    return ( failures == 0 ? 0 : 1 );
+}
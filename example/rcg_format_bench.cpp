@@ -0,0 +1,294 @@
+// -*-c++-*-
+
+/*!
+  \file rcg_format_bench.cpp
+  \brief throughput benchmark of the rcg show line formatting.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/parser_mmap.h>
+#include <rcsc/rcg/serializer_v5.h>
+#include <rcsc/rcg/format_buffer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+namespace {
+
+/*!
+  \brief handler that stores all show data.
+ */
+class ShowCollector
+    : public rcsc::rcg::Handler {
+public:
+    std::vector< rcsc::rcg::ShowInfoT > M_shows;
+
+    bool handleEOF() { return true; }
+    bool handleShow( const rcsc::rcg::ShowInfoT & show )
+      {
+          M_shows.push_back( show );
+          return true;
+      }
+    bool handleMsg( const int, const int, const std::string & ) { return true; }
+    bool handleDraw( const int, const rcsc::rcg::drawinfo_t & ) { return true; }
+    bool handlePlayMode( const int, const rcsc::PlayMode ) { return true; }
+    bool handleTeam( const int, const rcsc::rcg::TeamT &, const rcsc::rcg::TeamT & ) { return true; }
+    bool handleServerParam( const std::string & ) { return true; }
+    bool handlePlayerParam( const std::string & ) { return true; }
+    bool handlePlayerType( const std::string & ) { return true; }
+};
+
+/*!
+  \brief the v5 show line written by iostream. the reference implementation.
+ */
+void
+write_show_iostream( std::ostream & os,
+                     const rcsc::rcg::ShowInfoT & show )
+{
+    os << "(show " << show.time_;
+
+    os << " ((b)"
+       << ' ' << show.ball_.x_ << ' ' << show.ball_.y_;
+    if ( show.ball_.hasVelocity() )
+    {
+        os << ' ' << show.ball_.vx_ << ' ' << show.ball_.vy_;
+    }
+    else
+    {
+        os << " 0 0";
+    }
+    os << ')';
+
+    for ( const rcsc::rcg::PlayerT & p : show.player_ )
+    {
+        os << " ((" << p.side_ << ' ' << p.unum_ << ')';
+        os << ' ' << p.type_;
+        os << ' ' << std::hex << std::showbase
+           << p.state_
+           << std::dec << std::noshowbase;
+
+        os << ' ' << p.x_ << ' ' << p.y_;
+        if ( p.hasVelocity() )
+        {
+            os << ' ' << p.vx_ << ' ' << p.vy_;
+        }
+        else
+        {
+            os << " 0 0";
+        }
+        os << ' ' << p.body_
+           << ' ' << ( p.hasNeck() ? p.neck_ : 0.0f );
+
+        if ( p.isPointing() )
+        {
+            os << ' ' << p.point_x_ << ' ' << p.point_y_;
+        }
+
+        if ( p.hasView() )
+        {
+            os << " (v " << p.view_quality_ << ' ' << p.view_width_ << ')';
+        }
+        else
+        {
+            os << " (v h 90)";
+        }
+
+        if ( p.hasStamina() )
+        {
+            os << " (s " << p.stamina_
+               << ' ' << p.effort_
+               << ' ' << p.recovery_
+               << ' ' << p.stamina_capacity_
+               << ')';
+        }
+        else
+        {
+            os << " (s 4000 1 1 -1)";
+        }
+
+        if ( p.focus_side_ != 'n' )
+        {
+            os << " (f" << p.focus_side_ << ' ' << p.focus_unum_ << ')';
+        }
+
+        os << " (c"
+           << ' ' << p.kick_count_
+           << ' ' << p.dash_count_
+           << ' ' << p.turn_count_
+           << ' ' << p.catch_count_
+           << ' ' << p.move_count_
+           << ' ' << p.turn_neck_count_
+           << ' ' << p.change_view_count_
+           << ' ' << p.say_count_
+           << ' ' << p.tackle_count_
+           << ' ' << p.pointto_count_
+           << ' ' << p.attentionto_count_
+           << ')';
+        os << ')';
+    }
+
+    os << ")\n";
+}
+
+double
+elapsed_sec( const std::chrono::steady_clock::time_point & start )
+{
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+}
+
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <RCGFile> [iterations]" << std::endl;
+        return 1;
+    }
+
+    const std::string filepath = argv[1];
+    const int iterations = ( argc >= 3 ? std::max( 1, std::atoi( argv[2] ) ) : 5 );
+
+    ShowCollector collector;
+    {
+        rcsc::rcg::ParserMMap parser;
+        if ( ! parser.open( filepath )
+             || ! parser.parse( collector ) )
+        {
+            std::cerr << "Failed to parse " << filepath << std::endl;
+            return 1;
+        }
+    }
+
+    const std::vector< rcsc::rcg::ShowInfoT > & shows = collector.M_shows;
+
+    //
+    // show lines: iostream vs SerializerV5
+    //
+    std::string stream_text;
+    std::string serializer_text;
+    double stream_sec = 0.0;
+    double serializer_sec = 0.0;
+    for ( int i = 0; i < iterations; ++i )
+    {
+        std::ostringstream os;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for ( const rcsc::rcg::ShowInfoT & show : shows )
+        {
+            write_show_iostream( os, show );
+        }
+        stream_sec += elapsed_sec( start );
+        stream_text = os.str();
+    }
+
+    for ( int i = 0; i < iterations; ++i )
+    {
+        std::ostringstream os;
+        rcsc::rcg::SerializerV5 serializer;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for ( const rcsc::rcg::ShowInfoT & show : shows )
+        {
+            serializer.serialize( os, show );
+        }
+        serializer_sec += elapsed_sec( start );
+        serializer_text = os.str();
+    }
+
+    //
+    // single values: operator<<(float) vs FormatBuffer
+    //
+    std::vector< float > values;
+    for ( const rcsc::rcg::ShowInfoT & show : shows )
+    {
+        for ( const rcsc::rcg::PlayerT & p : show.player_ )
+        {
+            values.push_back( p.x_ ); values.push_back( p.y_ );
+            values.push_back( p.vx_ ); values.push_back( p.vy_ );
+            values.push_back( p.body_ ); values.push_back( p.neck_ );
+            values.push_back( p.stamina_ ); values.push_back( p.effort_ );
+        }
+    }
+
+    std::string stream_values;
+    std::string buffer_values;
+    double stream_value_sec = 0.0;
+    double buffer_value_sec = 0.0;
+    for ( int i = 0; i < iterations; ++i )
+    {
+        std::ostringstream os;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for ( const float v : values )
+        {
+            os << v << ',';
+        }
+        stream_value_sec += elapsed_sec( start );
+        stream_values = os.str();
+
+        rcsc::rcg::FormatBuffer buf;
+        start = std::chrono::steady_clock::now();
+        for ( const float v : values )
+        {
+            buf << v << ',';
+        }
+        buffer_value_sec += elapsed_sec( start );
+        buffer_values = buf.str();
+    }
+
+    stream_sec /= iterations;
+    serializer_sec /= iterations;
+    stream_value_sec /= iterations;
+    buffer_value_sec /= iterations;
+
+    const double text_mb = stream_text.size() / ( 1024.0 * 1024.0 );
+    const bool lines_ok = ( stream_text == serializer_text );
+    const bool values_ok = ( stream_values == buffer_values );
+
+    std::cout << "file: " << filepath << " (" << shows.size() << " shows, "
+              << text_mb << " MB show text)\n"
+              << "show iostream:   " << stream_sec * 1000.0 << " ms, "
+              << text_mb / stream_sec << " MB/s\n"
+              << "show serializer: " << serializer_sec * 1000.0 << " ms, "
+              << text_mb / serializer_sec << " MB/s\n"
+              << "speedup: " << stream_sec / serializer_sec << '\n'
+              << "show bytes: " << ( lines_ok ? "identical" : "DIFFERENT" ) << '\n'
+              << "float iostream: " << values.size() / stream_value_sec / 1.0e6 << " M values/s\n"
+              << "float buffer:   " << values.size() / buffer_value_sec / 1.0e6 << " M values/s\n"
+              << "speedup: " << stream_value_sec / buffer_value_sec << '\n'
+              << "float bytes: " << ( values_ok ? "identical" : "DIFFERENT" )
+              << std::endl;
+
+    return ( lines_ok && values_ok ? 0 : 1 );
+}
@@ -0,0 +1,252 @@
+// -*-c++-*-
+
+/*!
+  \file rcg_parser_bench.cpp
+  \brief throughput benchmark of the rcg parsers.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/parser.h>
+#include <rcsc/rcg/parser_mmap.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+/*!
+  \brief handler that only computes the digest of the parsed data.
+ */
+class DigestHandler
+    : public rcsc::rcg::Handler {
+public:
+    unsigned long M_digest;
+    int M_show_count;
+
+    DigestHandler()
+        : M_digest( 14695981039346656037ul ),
+          M_show_count( 0 )
+      { }
+
+    void add( const void * data,
+              const std::size_t size )
+      {
+          const unsigned char * p = static_cast< const unsigned char * >( data );
+          for ( std::size_t i = 0; i < size; ++i )
+          {
+              M_digest = ( M_digest ^ p[i] ) * 1099511628211ul;
+          }
+      }
+
+    void add( const float value )
+      {
+          add( &value, sizeof( value ) );
+      }
+
+    bool handleEOF()
+      {
+          return true;
+      }
+
+    bool handleShow( const rcsc::rcg::ShowInfoT & show )
+      {
+          ++M_show_count;
+          add( &show.time_, sizeof( show.time_ ) );
+          add( show.ball_.x_ ); add( show.ball_.y_ );
+          add( show.ball_.vx_ ); add( show.ball_.vy_ );
+          for ( const rcsc::rcg::PlayerT & p : show.player_ )
+          {
+              add( &p.side_, 1 ); add( &p.unum_, 2 ); add( &p.type_, 2 );
+              add( &p.state_, 4 ); add( &p.view_quality_, 1 );
+              add( &p.focus_side_, 1 ); add( &p.focus_unum_, 2 );
+              add( p.x_ ); add( p.y_ ); add( p.vx_ ); add( p.vy_ );
+              add( p.body_ ); add( p.neck_ );
+              add( p.point_x_ ); add( p.point_y_ );
+              add( p.view_width_ );
+              add( p.stamina_ ); add( p.effort_ ); add( p.recovery_ );
+              add( p.stamina_capacity_ );
+              add( &p.kick_count_, 2 ); add( &p.dash_count_, 2 );
+              add( &p.turn_count_, 2 ); add( &p.catch_count_, 2 );
+              add( &p.move_count_, 2 ); add( &p.turn_neck_count_, 2 );
+              add( &p.change_view_count_, 2 ); add( &p.say_count_, 2 );
+              add( &p.tackle_count_, 2 ); add( &p.pointto_count_, 2 );
+              add( &p.attentionto_count_, 2 );
+          }
+          return true;
+      }
+
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg )
+      {
+          add( &time, sizeof( time ) );
+          add( &board, sizeof( board ) );
+          add( msg.data(), msg.size() );
+          return true;
+      }
+
+    bool handleDraw( const int,
+                     const rcsc::rcg::drawinfo_t & )
+      {
+          return true;
+      }
+
+    bool handlePlayMode( const int time,
+                         const rcsc::PlayMode pm )
+      {
+          add( &time, sizeof( time ) );
+          add( &pm, sizeof( pm ) );
+          return true;
+      }
+
+    bool handleTeam( const int time,
+                     const rcsc::rcg::TeamT & team_l,
+                     const rcsc::rcg::TeamT & team_r )
+      {
+          add( &time, sizeof( time ) );
+          add( team_l.name_.data(), team_l.name_.size() );
+          add( team_r.name_.data(), team_r.name_.size() );
+          add( &team_l.score_, 2 ); add( &team_r.score_, 2 );
+          return true;
+      }
+
+    bool handleServerParam( const std::string & msg )
+      {
+          add( msg.data(), msg.size() );
+          return true;
+      }
+
+    bool handlePlayerParam( const std::string & msg )
+      {
+          add( msg.data(), msg.size() );
+          return true;
+      }
+
+    bool handlePlayerType( const std::string & msg )
+      {
+          add( msg.data(), msg.size() );
+          return true;
+      }
+};
+
+double
+elapsed_sec( const std::chrono::steady_clock::time_point & start )
+{
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+}
+
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <RCGFile> [iterations]" << std::endl;
+        return 1;
+    }
+
+    const std::string filepath = argv[1];
+    const int iterations = ( argc >= 3 ? std::max( 1, std::atoi( argv[2] ) ) : 5 );
+
+    //
+    // stream parser (ParserV4/ParserV5)
+    //
+    DigestHandler stream_result;
+    double stream_sec = 0.0;
+    double file_mb = 0.0;
+    for ( int i = 0; i < iterations; ++i )
+    {
+        std::ifstream fin( filepath.c_str(), std::ios_base::in | std::ios_base::binary );
+        if ( ! fin )
+        {
+            std::cerr << "Failed to open " << filepath << std::endl;
+            return 1;
+        }
+        fin.seekg( 0, std::ios_base::end );
+        file_mb = fin.tellg() / ( 1024.0 * 1024.0 );
+        fin.seekg( 0 );
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
+        DigestHandler handler;
+        if ( ! parser
+             || ! parser->parse( fin, handler ) )
+        {
+            std::cerr << "ParserV" << ( parser ? parser->version() : 0 )
+                      << " failed." << std::endl;
+            return 1;
+        }
+        stream_sec += elapsed_sec( start );
+        stream_result = handler;
+    }
+
+    //
+    // mmap parser
+    //
+    DigestHandler mmap_result;
+    double mmap_sec = 0.0;
+    for ( int i = 0; i < iterations; ++i )
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        rcsc::rcg::ParserMMap parser;
+        DigestHandler handler;
+        if ( ! parser.open( filepath )
+             || ! parser.parse( handler ) )
+        {
+            std::cerr << "ParserMMap failed." << std::endl;
+            return 1;
+        }
+        mmap_sec += elapsed_sec( start );
+        mmap_result = handler;
+    }
+
+    stream_sec /= iterations;
+    mmap_sec /= iterations;
+
+    std::cout << "file: " << filepath << " (" << file_mb << " MB, "
+              << stream_result.M_show_count << " shows)\n"
+              << "stream: " << stream_sec * 1000.0 << " ms, "
+              << file_mb / stream_sec << " MB/s\n"
+              << "mmap:   " << mmap_sec * 1000.0 << " ms, "
+              << file_mb / mmap_sec << " MB/s\n"
+              << "speedup: " << stream_sec / mmap_sec << '\n'
+              << "digest: " << ( stream_result.M_digest == mmap_result.M_digest
+                                 && stream_result.M_show_count == mmap_result.M_show_count
+                                 ? "identical" : "DIFFERENT" )
+              << std::endl;
+
+    return ( stream_result.M_digest == mmap_result.M_digest ? 0 : 1 );
+}
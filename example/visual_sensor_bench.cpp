@@ -0,0 +1,312 @@
+// -*-c++-*-
+
+/*!
+  \file visual_sensor_bench.cpp
+  \brief throughput benchmark of the see message parser.
+
+  VisualSensor::parse() is run on a corpus of see messages. If a file is
+  given, every line that contains "(see " is used as the corpus, e.g. the
+  output of the message logger. Otherwise, the messages that contain
+  flags, lines, the ball and players in all formats are generated.
+  The parse time, the number of heap allocations during the measurement
+  and the digest of the parsed values are reported.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/player/visual_sensor.h>
+#include <rcsc/game_time.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+namespace {
+
+std::atomic< long > g_allocation_count( 0 );
+
+const double CLIENT_VERSION = 15.0;
+const char * OUR_TEAM_NAME = "bench";
+
+const char * MARKER_NAMES[] = {
+    "g l", "g r", "f c", "f c t", "f c b", "f l t", "f l b", "f r t", "f r b",
+    "f p l t", "f p l c", "f p l b", "f p r t", "f p r c", "f p r b",
+    "f g l t", "f g l b", "f g r t", "f g r b",
+    "f t l 50", "f t l 40", "f t l 30", "f t l 20", "f t l 10", "f t 0",
+    "f t r 10", "f t r 20", "f t r 30", "f t r 40", "f t r 50",
+    "f b l 50", "f b l 40", "f b l 30", "f b l 20", "f b l 10", "f b 0",
+    "f b r 10", "f b r 20", "f b r 30", "f b r 40", "f b r 50",
+    "f l t 30", "f l t 20", "f l t 10", "f l 0", "f l b 10", "f l b 20", "f l b 30",
+    "f r t 30", "f r t 20", "f r t 10", "f r 0", "f r b 10", "f r b 20", "f r b 30",
+};
+
+/*!
+  \brief generate the see message that contains all kinds of objects
+ */
+std::string
+make_see_message( const int cycle,
+                  std::mt19937 & rng )
+{
+    std::uniform_real_distribution< double > dist( 0.5, 60.0 );
+    std::uniform_int_distribution< int > dir( -45, 45 );
+    std::uniform_real_distribution< double > chng( -1.0, 1.0 );
+    std::uniform_int_distribution< int > angle( -180, 180 );
+    std::uniform_int_distribution< int > percent( 0, 99 );
+
+    std::ostringstream os;
+    os.setf( std::ios::fixed );
+    os << "(see " << cycle;
+
+    for ( const char * name : MARKER_NAMES )
+    {
+        if ( percent( rng ) < 30 )
+        {
+            os << " ((" << name << ") " << std::setprecision( 1 ) << dist( rng )
+               << ' ' << dir( rng ) << ')';
+        }
+    }
+
+    os << " ((b) " << std::setprecision( 1 ) << dist( rng ) << ' ' << dir( rng )
+       << ' ' << std::setprecision( 3 ) << chng( rng ) << ' ' << std::setprecision( 1 ) << chng( rng ) << ')';
+
+    for ( int unum = 1; unum <= 11; ++unum )
+    {
+        const char * team = ( unum % 2 == 0 ? OUR_TEAM_NAME : "opponent" );
+        os << std::setprecision( 1 );
+        switch ( percent( rng ) % 6 ) {
+        case 0:
+            os << " ((p \"" << team << "\" " << unum << ( unum == 1 ? " goalie" : "" ) << ") "
+               << dist( rng ) << ' ' << dir( rng ) << ' ' << chng( rng ) << ' ' << chng( rng )
+               << ' ' << angle( rng ) << ' ' << angle( rng ) << ')';
+            break;
+        case 1:
+            os << " ((p \"" << team << "\" " << unum << ") "
+               << dist( rng ) << ' ' << dir( rng ) << ' ' << chng( rng ) << ' ' << chng( rng )
+               << ' ' << angle( rng ) << ' ' << angle( rng ) << ' ' << angle( rng ) << " k)";
+            break;
+        case 2:
+            os << " ((p \"" << team << "\" " << unum << ") "
+               << dist( rng ) << ' ' << dir( rng ) << ' ' << angle( rng ) << " t)";
+            break;
+        case 3:
+            os << " ((p \"" << team << "\") " << dist( rng ) << ' ' << dir( rng ) << ')';
+            break;
+        case 4:
+            os << " ((p) " << dist( rng ) << ' ' << dir( rng ) << ')';
+            break;
+        default:
+            break;
+        }
+    }
+
+    os << " ((l r) " << std::setprecision( 1 ) << dist( rng ) << ' ' << dir( rng ) << ')';
+    os << " ((F) " << std::setprecision( 1 ) << chng( rng ) + 1.5 << ' ' << angle( rng ) << ')';
+    os << ')';
+    return os.str();
+}
+
+std::vector< std::string >
+generate_messages( const std::size_t size )
+{
+    std::mt19937 rng( 2022 );
+    std::vector< std::string > messages;
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        messages.push_back( make_see_message( static_cast< int >( i ) + 1, rng ) );
+    }
+    return messages;
+}
+
+std::vector< std::string >
+read_messages( const char * path )
+{
+    std::vector< std::string > messages;
+    std::ifstream fin( path );
+    std::string line;
+    while ( std::getline( fin, line ) )
+    {
+        const std::string::size_type pos = line.find( "(see " );
+        if ( pos != std::string::npos )
+        {
+            messages.push_back( line.substr( pos ) );
+        }
+    }
+    return messages;
+}
+
+/*!
+  \brief FNV-1a digest of the parsed values
+ */
+class Digest {
+private:
+    unsigned long M_value;
+public:
+    Digest()
+        : M_value( 14695981039346656037ul )
+      { }
+
+    void add( const double v )
+      {
+          const unsigned char * p = reinterpret_cast< const unsigned char * >( &v );
+          for ( std::size_t i = 0; i < sizeof( v ); ++i )
+          {
+              M_value = ( M_value ^ p[i] ) * 1099511628211ul;
+          }
+      }
+
+    void add( const rcsc::VisualSensor::PlayerCont & players )
+      {
+          for ( const rcsc::VisualSensor::PlayerT & p : players )
+          {
+              add( p.dist_ ); add( p.dir_ ); add( p.dist_chng_ ); add( p.dir_chng_ );
+              add( p.body_ ); add( p.face_ ); add( p.arm_ );
+              add( p.unum_ + ( p.goalie_ ? 100 : 0 ) + ( p.kicking_ ? 1000 : 0 ) + ( p.tackle_ ? 10000 : 0 ) );
+          }
+      }
+
+    void add( const rcsc::VisualSensor & see )
+      {
+          for ( const rcsc::VisualSensor::MarkerT & m : see.markers() )
+          {
+              add( m.dist_ ); add( m.dir_ ); add( m.id_ );
+          }
+          for ( const rcsc::VisualSensor::MarkerT & m : see.behindMarkers() )
+          {
+              add( m.dist_ ); add( m.dir_ );
+          }
+          for ( const rcsc::VisualSensor::LineT & l : see.lines() )
+          {
+              add( l.dist_ ); add( l.dir_ ); add( l.id_ );
+          }
+          for ( const rcsc::VisualSensor::BallT & b : see.balls() )
+          {
+              add( b.dist_ ); add( b.dir_ ); add( b.dist_chng_ ); add( b.dir_chng_ );
+          }
+          add( see.teammates() );
+          add( see.unknownTeammates() );
+          add( see.opponents() );
+          add( see.unknownOpponents() );
+          add( see.unknownPlayers() );
+      }
+
+    unsigned long value() const
+      {
+          return M_value;
+      }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  count all heap allocations in this program
+*/
+void *
+operator new( std::size_t size )
+{
+    g_allocation_count.fetch_add( 1, std::memory_order_relaxed );
+    if ( void * p = std::malloc( size ? size : 1 ) )
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void
+operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+void
+operator delete( void * p,
+                 std::size_t ) noexcept
+{
+    std::free( p );
+}
+
+/*-------------------------------------------------------------------*/
+int
+main( int argc, char ** argv )
+{
+    const std::vector< std::string > messages = ( argc >= 2 && std::string( argv[1] ) != "-"
+                                                  ? read_messages( argv[1] )
+                                                  : generate_messages( 1000 ) );
+    const int loop = ( argc >= 3 ? std::max( 1, std::atoi( argv[2] ) ) : 100 );
+
+    if ( messages.empty() )
+    {
+        std::cerr << "no see message." << std::endl;
+        return 1;
+    }
+
+    const std::string team_name( OUR_TEAM_NAME );
+    rcsc::VisualSensor see;
+    long cycle = 0;
+
+    // warm up, and compute the digest
+    Digest digest;
+    std::size_t object_count = 0;
+    for ( const std::string & msg : messages )
+    {
+        see.parse( msg.c_str(), team_name, CLIENT_VERSION, rcsc::GameTime( ++cycle, 0 ) );
+        digest.add( see );
+        object_count += ( see.markers().size() + see.behindMarkers().size() + see.lines().size()
+                          + see.balls().size() + see.teammates().size() + see.unknownTeammates().size()
+                          + see.opponents().size() + see.unknownOpponents().size() + see.unknownPlayers().size() );
+    }
+
+    const long allocation_start = g_allocation_count.load();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( int l = 0; l < loop; ++l )
+    {
+        for ( const std::string & msg : messages )
+        {
+            see.parse( msg.c_str(), team_name, CLIENT_VERSION, rcsc::GameTime( ++cycle, 0 ) );
+        }
+    }
+    const double elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    const long allocations = g_allocation_count.load() - allocation_start;
+
+    const double parse_count = static_cast< double >( loop ) * messages.size();
+    std::cout << "see messages: " << messages.size() << ", loop: " << loop << '\n'
+              << "objects/see: " << static_cast< double >( object_count ) / messages.size() << '\n'
+              << "usec/see: " << elapsed * 1.0e6 / parse_count << '\n'
+              << "allocations/see: " << allocations / parse_count << '\n'
+              << "digest: " << std::hex << digest.value() << std::dec << std::endl;
+    return 0;
+}
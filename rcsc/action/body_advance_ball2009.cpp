@@ -48,8 +48,9 @@
 
 namespace rcsc {
 
-GameTime Body_AdvanceBall2009::S_last_calc_time( 0, 0 );
-AngleDeg Body_AdvanceBall2009::S_cached_best_angle = 0.0;
+thread_local const WorldModel * Body_AdvanceBall2009::S_last_calc_world = static_cast< const WorldModel * >( 0 );
+thread_local GameTime Body_AdvanceBall2009::S_last_calc_time( 0, 0 );
+thread_local AngleDeg Body_AdvanceBall2009::S_cached_best_angle = 0.0;
 
 
 namespace {
@@ -169,11 +170,13 @@ Body_AdvanceBall2009::execute( PlayerAgent * agent )
         return false;
     }
 
-    if ( S_last_calc_time != wm.time() )
+    if ( S_last_calc_world != &wm
+         || S_last_calc_time != wm.time() )
     {
         dlog.addText( Logger::CLEAR,
                       __FILE__": update" );
         S_cached_best_angle = getBestAngle( agent );
+        S_last_calc_world = &wm;
         S_last_calc_time = wm.time();
     }
 
@@ -38,6 +38,8 @@
 
 namespace rcsc {
 
+class WorldModel;
+
 /*!
   \class Body_AdvanceBall2009
   \brief kick the ball to a forward direction
@@ -45,10 +47,12 @@ namespace rcsc {
 class Body_AdvanceBall2009
     : public BodyAction {
 private:
+    //! world model used by the last calculation. the cache is kept for each thread.
+    static thread_local const WorldModel * S_last_calc_world;
     //! last game time when calcuration is done.
-    static GameTime S_last_calc_time;
+    static thread_local GameTime S_last_calc_time;
     //! last calculated result
-    static AngleDeg S_cached_best_angle;
+    static thread_local AngleDeg S_cached_best_angle;
 
 public:
     /*!
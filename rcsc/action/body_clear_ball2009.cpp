@@ -35,8 +35,6 @@
 
 #include "body_clear_ball2009.h"
 
-#include <rcsc/player/player_evaluator.h>
-
 #include <rcsc/action/body_smart_kick.h>
 #include <rcsc/action/body_kick_one_step.h>
 
@@ -48,7 +46,6 @@
 #include <rcsc/timer.h>
 
 #include <cmath>
-#include <limits>
 
 // #define DEBUG_PROFILE
 // #define DEBUG_PRINT_RECURSIVE
@@ -57,33 +54,6 @@ namespace rcsc {
 
 namespace {
 
-/*-------------------------------------------------------------------*/
-/*!
-
- */
-double
-get_minimum_evaluation( const AbstractPlayerObject::Cont & container,
-                        const PlayerEvaluator * evaluator )
-{
-    double min_value = std::numeric_limits< double >::max();
-
-    for ( AbstractPlayerObject::Cont::const_iterator it = container.begin(),
-              end = container.end();
-          it != end;
-          ++it )
-    {
-        double value = (*evaluator)( **it );
-
-        if ( value < min_value )
-        {
-            min_value = value;
-        }
-    }
-
-    delete evaluator;
-    return min_value;
-}
-
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -92,10 +62,6 @@ double
 get_free_angle( const WorldModel & wm,
                 const AngleDeg & angle )
 {
-    // return std::min( get_minimum_evaluation( wm.getPlayerCont( new OpponentOrUnknownPlayerPredicate( wm ) ),
-    //                                          new AbsAngleDiffPlayerEvaluator( wm.ball().pos(), angle ) ),
-    //                  360.0 );
-
     double min_diff = 360.0;
     for ( AbstractPlayerObject::Cont::const_iterator p = wm.theirPlayers().begin(),
               end = wm.theirPlayers().end();
@@ -305,13 +271,18 @@ get_clear_course_recursive( const WorldModel & wm,
 AngleDeg
 get_clear_course( const WorldModel & wm )
 {
-    static GameTime s_update_time( 0, 0 );
-    static AngleDeg s_last_angle = 0.0;
-
-    if ( s_update_time == wm.time() )
+    // the cache is kept for each thread and each world model,
+    // because several agents may be executed in one process.
+    thread_local const WorldModel * s_last_world = static_cast< const WorldModel * >( 0 );
+    thread_local GameTime s_update_time( 0, 0 );
+    thread_local AngleDeg s_last_angle = 0.0;
+
+    if ( s_last_world == &wm
+         && s_update_time == wm.time() )
     {
         return s_last_angle;
     }
+    s_last_world = &wm;
     s_update_time = wm.time();
 
 #ifdef DEBUG_PROFILE
@@ -370,9 +341,13 @@ Body_ClearBall2009::execute( PlayerAgent * agent )
 
     agent->debugClient().addLine( wm.ball().pos(), kick_target );
 
+    const Vector2D ball_pos = wm.ball().pos();
     if ( wm.gameMode().type() != GameMode::PlayOn
-         || get_minimum_evaluation( wm.getPlayers( new OpponentOrUnknownPlayerPredicate( wm ) ),
-                                    new DistFromPosPlayerEvaluator( wm.ball().pos() ) ) < 1.5 )
+         || wm.countPlayerIf( and_player_filter( OpponentOrUnknownPlayerPredicate( wm ),
+                                                 [&]( const AbstractPlayerObject & p )
+                                                 {
+                                                     return p.pos().dist( ball_pos ) < 1.5;
+                                                 } ) ) > 0 )
     {
         agent->debugClient().addMessage( "Clear1" );
         dlog.addText( Logger::CLEAR,
@@ -706,7 +706,9 @@ Body_Dribble2008::doKickTurnsDashes( PlayerAgent * agent,
                                      const double & dash_power,
                                      const int n_turn )
 {
-    static std::vector< Vector2D > self_cache;
+    // work buffers are kept for each thread, because several agents
+    // may be executed in one process.
+    thread_local std::vector< Vector2D > self_cache;
 
     const int max_dash = 5;
 
@@ -928,7 +930,7 @@ Body_Dribble2008::doKickDashes( PlayerAgent * agent,
                                 const double & dash_power,
                                 const int dash_count )
 {
-    static std::vector< Vector2D > self_cache;
+    thread_local std::vector< Vector2D > self_cache;
 
     // do dribble kick. simulate next action queue.
     // kick -> dash -> dash -> ...
@@ -1172,8 +1174,8 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
                                         const int dash_count,
                                         const bool dodge_mode )
 {
-    static std::vector< Vector2D > my_state;
-    static std::vector< KeepDribbleInfo > dribble_info;
+    thread_local std::vector< Vector2D > my_state;
+    thread_local std::vector< KeepDribbleInfo > dribble_info;
 
     my_state.clear();
     dribble_info.clear();
@@ -1210,10 +1212,12 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
     const double angle_range_forward = 160.0;
     const double arc_dist_step = 0.1;
 
+    const Deadline & deadline = agent->deadline();
+    bool timed_out = false;
     int total_loop_count = 0;
 
     for ( int dist_loop = 0;
-          dist_loop < DIST_DIVS;
+          dist_loop < DIST_DIVS && ! timed_out;
           ++dist_loop, first_ball_dist += dist_step )
     {
         const double angle_step
@@ -1231,6 +1235,19 @@ Body_Dribble2008::doKickDashesWithBall( PlayerAgent * agent,
               angle_loop < ANGLE_DIVS;
               ++angle_loop, first_ball_angle += angle_step )
         {
+            // at least one ball position is always evaluated.
+            if ( total_loop_count > 0
+                 && ( total_loop_count & 0x07 ) == 0
+                 && deadline.isExpired() )
+            {
+                // no more time. select from the solutions found so far.
+                dlog.addText( Logger::DRIBBLE,
+                              __FILE__": doKickDashesWithBall() deadline expired. solution size=%d",
+                              static_cast< int >( dribble_info.size() ) );
+                timed_out = true;
+                break;
+            }
+
             ++total_loop_count;
 
             const Vector2D first_ball_pos
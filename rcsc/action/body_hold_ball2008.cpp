@@ -162,12 +162,18 @@ Body_HoldBall2008::avoidOpponent( PlayerAgent * agent )
 Vector2D
 Body_HoldBall2008::searchKeepPoint( const WorldModel & wm )
 {
-    static GameTime s_last_update_time( 0, 0 );
-    static std::vector< KeepPoint > s_keep_points;
-    static KeepPoint s_best_keep_point;
-
-    if ( s_last_update_time != wm.time() )
+    // the cache is kept for each thread and each world model,
+    // because several agents may be executed in one process.
+    thread_local const WorldModel * s_last_world = static_cast< const WorldModel * >( 0 );
+    thread_local GameTime s_last_update_time( 0, 0 );
+    thread_local std::vector< KeepPoint > s_keep_points;
+    thread_local KeepPoint s_best_keep_point;
+
+    if ( s_last_world != &wm
+         || s_last_update_time != wm.time() )
     {
+        s_last_world = &wm;
+        s_last_update_time = wm.time();
         s_best_keep_point.reset();
 
         createKeepPoints( wm, s_keep_points );
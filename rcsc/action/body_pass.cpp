@@ -49,6 +49,7 @@
 #include <rcsc/player/say_message_builder.h>
 
 #include <rcsc/common/logger.h>
+#include <rcsc/time/timer.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/geom/rect_2d.h>
 #include <rcsc/geom/sector_2d.h>
@@ -59,7 +60,7 @@
 
 namespace rcsc {
 
-std::vector< Body_Pass::PassRoute > Body_Pass::S_cached_pass_route;
+thread_local std::vector< Body_Pass::PassRoute > Body_Pass::S_cached_pass_route;
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -87,7 +88,8 @@ Body_Pass::execute( PlayerAgent * agent )
     double first_speed = 0.0;
     int receiver = 0;
 
-    if ( ! get_best_pass( agent->world(), &target_point, &first_speed, &receiver ) )
+    if ( ! get_best_pass( agent->world(), &target_point, &first_speed, &receiver,
+                          &agent->deadline() ) )
     {
         return false;
     }
@@ -154,15 +156,20 @@ bool
 Body_Pass::get_best_pass( const WorldModel & world,
                           Vector2D * target_point,
                           double * first_speed,
-                          int * receiver )
+                          int * receiver,
+                          const Deadline * deadline )
 {
-    static GameTime S_last_calc_time( 0, 0 );
-    static bool S_last_calc_valid = false;
-    static Vector2D S_last_calc_target;
-    static double S_last_calc_speed = 0.0;
-    static int S_last_calc_receiver = Unum_Unknown;
-
-    if ( S_last_calc_time == world.time() )
+    // the cache is kept for each thread and each world model,
+    // because several agents may be executed in one process.
+    thread_local const WorldModel * S_last_calc_world = static_cast< const WorldModel * >( 0 );
+    thread_local GameTime S_last_calc_time( 0, 0 );
+    thread_local bool S_last_calc_valid = false;
+    thread_local Vector2D S_last_calc_target;
+    thread_local double S_last_calc_speed = 0.0;
+    thread_local int S_last_calc_receiver = Unum_Unknown;
+
+    if ( S_last_calc_world == &world
+         && S_last_calc_time == world.time() )
     {
         if ( S_last_calc_valid )
         {
@@ -183,11 +190,12 @@ Body_Pass::get_best_pass( const WorldModel & world,
         return false;
     }
 
+    S_last_calc_world = &world;
     S_last_calc_time = world.time();
     S_last_calc_valid = false;
 
     // create route
-    create_routes( world );
+    create_routes( world, deadline );
 
     if ( ! S_cached_pass_route.empty() )
     {
@@ -239,17 +247,32 @@ Body_Pass::get_best_pass( const WorldModel & world,
   static method
 */
 void
-Body_Pass::create_routes( const WorldModel & world )
+Body_Pass::create_routes( const WorldModel & world,
+                          const Deadline * deadline )
 {
     // reset old info
     S_cached_pass_route.clear();
 
+    int evaluated = 0;
+
     // loop candidate teammates
     for ( PlayerObject::Cont::const_iterator it = world.teammatesFromSelf().begin(),
               end = world.teammatesFromSelf().end();
           it != end;
           ++it )
     {
+        // at least one receiver is always evaluated.
+        if ( deadline
+             && evaluated > 0
+             && deadline->isExpired() )
+        {
+            // no more time. evaluate the routes created so far.
+            dlog.addText( Logger::PASS,
+                          __FILE__": create_routes() deadline expired. route size=%d",
+                          static_cast< int >( S_cached_pass_route.size() ) );
+            break;
+        }
+
         if ( (*it)->goalie() && (*it)->pos().x < -22.0 )
         {
             // goalie is rejected.
@@ -272,6 +295,7 @@ Body_Pass::create_routes( const WorldModel & world )
         }
 
         // create & verify each route
+        ++evaluated;
         create_direct_pass( world, *it );
         create_lead_pass( world, *it );
         if ( world.self().pos().x > world.offsideLineX() - 20.0 )
@@ -40,6 +40,7 @@
 
 namespace rcsc {
 
+class Deadline;
 class WorldModel;
 class PlayerObject;
 
@@ -117,8 +118,8 @@ public:
 
 private:
 
-    //! cached calculated pass data
-    static std::vector< PassRoute > S_cached_pass_route;
+    //! cached calculated pass data for each thread
+    static thread_local std::vector< PassRoute > S_cached_pass_route;
 
 
 public:
@@ -141,17 +142,21 @@ public:
       \param target_point receive target point is stored to this
       \param first_speed ball first speed is stored to this
       \param receiver receiver number
+      \param deadline if not NULL, the route search is stopped when this is expired
+      and the best route among the routes created so far is returned.
       \return true if pass route is found.
     */
     static
     bool get_best_pass( const WorldModel & world,
                         Vector2D * target_point,
                         double * first_speed,
-                        int * receiver );
+                        int * receiver,
+                        const Deadline * deadline = static_cast< const Deadline * >( 0 ) );
 
 private:
     static
-    void create_routes( const WorldModel & world );
+    void create_routes( const WorldModel & world,
+                        const Deadline * deadline );
 
     static
     void create_direct_pass( const WorldModel & world,
@@ -47,6 +47,7 @@
 #include <rcsc/math_util.h>
 #include <rcsc/soccer_math.h>
 #include <rcsc/timer.h>
+#include <rcsc/time/profiler.h>
 
 #include <algorithm>
 #include <functional>
@@ -78,6 +79,9 @@ const int NUM_STATE = STATE_DIVS_NEAR + STATE_DIVS_MID + STATE_DIVS_FAR;
 
 const size_t MAX_TABLE_SIZE = 1024;
 
+//! the deadline is checked once every ( DEADLINE_CHECK_MASK + 1 ) nodes
+const int DEADLINE_CHECK_MASK = 0x0f;
+
 
 /*!
  \struct TableSorter
@@ -289,6 +293,14 @@ KickTable::calc_max_velocity( const AngleDeg & target_angle,
     return vel1;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::mutex KickTable::S_tables_mutex;
+std::shared_ptr< const KickTable::Tables > KickTable::S_tables;
+std::atomic< int > KickTable::S_tables_version( 0 );
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -296,7 +308,7 @@ KickTable::calc_max_velocity( const AngleDeg & target_angle,
 KickTable &
 KickTable::instance()
 {
-    static KickTable s_instance;
+    thread_local KickTable s_instance;
     return s_instance;
 }
 
@@ -305,9 +317,9 @@ KickTable::instance()
 
  */
 KickTable::KickTable()
-    : M_player_size( 0.0 ),
-      M_kickable_margin( 0.0 ),
-      M_ball_size( 0.0 ),
+    : M_tables_version( -1 ),
+      M_update_world( static_cast< const WorldModel * >( 0 ) ),
+      M_update_time( -1, 0 ),
       M_use_risky_node( false )
 {
     for ( int i = 0; i < MAX_DEPTH; ++ i )
@@ -325,20 +337,28 @@ KickTable::createTables()
 {
     const PlayerType player_type; // default type
 
-    if ( std::fabs( M_player_size - player_type.playerSize() ) < rcsc::EPS
-         && std::fabs( M_kickable_margin - player_type.kickableMargin() ) < rcsc::EPS
-         && std::fabs( M_ball_size - ServerParam::i().ballSize() ) < rcsc::EPS )
+    std::lock_guard< std::mutex > lock( S_tables_mutex );
+
+    // the tables may be already created by another agent in this process
+    if ( S_tables
+         && std::fabs( S_tables->player_size_ - player_type.playerSize() ) < rcsc::EPS
+         && std::fabs( S_tables->kickable_margin_ - player_type.kickableMargin() ) < rcsc::EPS
+         && std::fabs( S_tables->ball_size_ - ServerParam::i().ballSize() ) < rcsc::EPS )
     {
+        M_tables = S_tables;
+        M_tables_version = S_tables_version.load( std::memory_order_relaxed );
         return false;
     }
 
     //std::cerr << "createTables" << std::endl;
 
-    M_player_size = player_type.playerSize();
-    M_kickable_margin = player_type.kickableMargin();
-    M_ball_size = ServerParam::i().ballSize();
+    std::shared_ptr< Tables > tables( new Tables() );
 
-    createStateList( player_type );
+    tables->player_size_ = player_type.playerSize();
+    tables->kickable_margin_ = player_type.kickableMargin();
+    tables->ball_size_ = ServerParam::i().ballSize();
+
+    createStateList( player_type, tables->state_list_ );
 
     MSecTimer timer;
 
@@ -347,17 +367,19 @@ KickTable::createTables()
 
     for ( int i = 0; i < DEST_DIR_DIVS; ++i, angle += angle_step )
     {
-        createTable( angle, M_tables[i] );
+        createTable( angle, tables->state_list_, tables->paths_[i] );
     }
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::createTables) elapsed %f [ms]",
-                  timer.elapsedReal() );
+    publishTables( tables );
+
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::createTables) elapsed %f [ms]",
+               timer.elapsedReal() );
 
 #if 0
     const double kprate = ServerParam::i().kickPowerRate();
-    for ( std::vector< State >::iterator s = M_state_list.begin();
-          s != M_state_list.end();
+    for ( std::vector< State >::const_iterator s = M_tables->state_list_.begin();
+          s != M_tables->state_list_.end();
           ++s )
     {
         std::cout << "  state "
@@ -373,8 +395,8 @@ KickTable::createTables()
     for ( int i = 0; i < DEST_DIR_DIVS; ++i, angle += angle_step )
     {
         std::cout << "create table " << i << " : angle="  << angle << std::endl;
-        for ( std::vector< Path >::iterator p = M_tables[i].begin();
-              p != M_tables[i].end();
+        for ( std::vector< Path >::const_iterator p = M_tables->paths_[i].begin();
+              p != M_tables->paths_[i].end();
               ++p )
         {
             std::cout << "  table "
@@ -389,6 +411,38 @@ KickTable::createTables()
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+KickTable::publishTables( const std::shared_ptr< const Tables > & tables )
+{
+    S_tables = tables;
+    M_tables = tables;
+    M_tables_version = S_tables_version.fetch_add( 1, std::memory_order_release ) + 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::syncTables()
+{
+    if ( M_tables_version != S_tables_version.load( std::memory_order_acquire ) )
+    {
+        std::lock_guard< std::mutex > lock( S_tables_mutex );
+        M_tables = S_tables;
+        M_tables_version = S_tables_version.load( std::memory_order_relaxed );
+        // the state cache has to be rebuilt for the new state list
+        M_update_world = static_cast< const WorldModel * >( 0 );
+    }
+
+    return ( M_tables
+             && ! M_tables->state_list_.empty() );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -404,13 +458,13 @@ KickTable::read( const std::string & file_path )
         return false;
     }
 
-    M_state_list.clear();
-    M_state_list.reserve( NUM_STATE );
+    std::shared_ptr< Tables > tables( new Tables() );
+
+    tables->state_list_.reserve( NUM_STATE );
 
     for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
     {
-        M_tables[dir].clear();
-        M_tables[dir].reserve( NUM_STATE * NUM_STATE );
+        tables->paths_[dir].reserve( NUM_STATE * NUM_STATE );
     }
 
     std::string line_buf;
@@ -485,7 +539,7 @@ KickTable::read( const std::string & file_path )
         }
 
         state.flag_ = SAFETY;
-        M_state_list.push_back( state );
+        tables->state_list_.push_back( state );
 
     }
 
@@ -535,13 +589,18 @@ KickTable::read( const std::string & file_path )
                 return false;
             }
 
-            M_tables[dir].push_back( path );
+            tables->paths_[dir].push_back( path );
         }
     }
 
-    M_player_size = player_size;
-    M_kickable_margin = kickable_margin;
-    M_ball_size = ball_size;
+    tables->player_size_ = player_size;
+    tables->kickable_margin_ = kickable_margin;
+    tables->ball_size_ = ball_size;
+
+    {
+        std::lock_guard< std::mutex > lock( S_tables_mutex );
+        publishTables( tables );
+    }
 
     std::cerr << "read kick table ... ok" << std::endl;
 
@@ -555,6 +614,11 @@ KickTable::read( const std::string & file_path )
 bool
 KickTable::write( const std::string & file_path )
 {
+    if ( ! syncTables() )
+    {
+        return false;
+    }
+
     std::ofstream fout( file_path.c_str() );
     if ( ! fout.is_open() )
     {
@@ -564,20 +628,20 @@ KickTable::write( const std::string & file_path )
     //
     // write server parameters
     //
-    fout << M_player_size << ' '
-         << M_kickable_margin << ' '
-         << M_ball_size << '\n';
+    fout << M_tables->player_size_ << ' '
+         << M_tables->kickable_margin_ << ' '
+         << M_tables->ball_size_ << '\n';
 
     //
     // write state size
     //
-    fout << M_state_list.size() << '\n';
+    fout << M_tables->state_list_.size() << '\n';
 
     //
     // write state list
     //
-    for ( std::vector< State >::const_iterator s = M_state_list.begin();
-          s != M_state_list.end();
+    for ( std::vector< State >::const_iterator s = M_tables->state_list_.begin();
+          s != M_tables->state_list_.end();
           ++s )
     {
         fout << s->index_ << ' '
@@ -588,10 +652,10 @@ KickTable::write( const std::string & file_path )
 
     for ( int dir = 0; dir < DEST_DIR_DIVS; ++dir )
     {
-        fout << M_tables[dir].size() << '\n';
+        fout << M_tables->paths_[dir].size() << '\n';
 
-        for ( std::vector< Path >::const_iterator t = M_tables[dir].begin();
-              t != M_tables[dir].end();
+        for ( std::vector< Path >::const_iterator t = M_tables->paths_[dir].begin();
+              t != M_tables->paths_[dir].end();
               ++t )
         {
             fout << t->origin_ << ' '
@@ -612,7 +676,8 @@ KickTable::write( const std::string & file_path )
 
  */
 void
-KickTable::createStateList( const PlayerType & player_type )
+KickTable::createStateList( const PlayerType & player_type,
+                            std::vector< State > & state_list )
 {
     const double near_dist = calc_near_dist( player_type, PlayerParam::i().kickableMarginDeltaMin() );
     const double mid_dist = calc_mid_dist( player_type, PlayerParam::i().kickableMarginDeltaMin() );
@@ -634,15 +699,15 @@ KickTable::createStateList( const PlayerType & player_type )
 #endif
 
     int index = 0;
-    M_state_list.clear();
-    M_state_list.reserve( NUM_STATE );
+    state_list.clear();
+    state_list.reserve( NUM_STATE );
 
     for ( int near = 0; near < STATE_DIVS_NEAR; ++near )
     {
         AngleDeg angle = -180.0 + ( near_angle_step * near );
         Vector2D pos = Vector2D::polar2vector( near_dist, angle );
         double krate = player_type.kickRate( near_dist, angle.degree() );
-        M_state_list.push_back( State( index, near_dist, pos, krate ) );
+        state_list.push_back( State( index, near_dist, pos, krate ) );
         ++index;
     }
 
@@ -651,7 +716,7 @@ KickTable::createStateList( const PlayerType & player_type )
         AngleDeg angle = -180.0 + ( mid_angle_step * mid );
         Vector2D pos = Vector2D::polar2vector( mid_dist, angle );
         double krate = player_type.kickRate( mid_dist, angle.degree() );
-        M_state_list.push_back( State( index, mid_dist, pos, krate ) );
+        state_list.push_back( State( index, mid_dist, pos, krate ) );
         ++index;
     }
 
@@ -660,13 +725,13 @@ KickTable::createStateList( const PlayerType & player_type )
         AngleDeg angle = -180.0 + ( far_angle_step * far );
         Vector2D pos = Vector2D::polar2vector( far_dist, angle );
         double krate = player_type.kickRate( far_dist, angle.degree() );
-        M_state_list.push_back( State( index, far_dist, pos, krate ) );
+        state_list.push_back( State( index, far_dist, pos, krate ) );
         ++index;
     }
 
 #if 0
-    for ( std::vector< State >::const_iterator s = M_state_list.begin();
-          s != M_state_list.end();
+    for ( std::vector< State >::const_iterator s = state_list.begin();
+          s != state_list.end();
           ++s )
     {
         std::cerr << s->index_ << ' '
@@ -683,10 +748,11 @@ KickTable::createStateList( const PlayerType & player_type )
  */
 void
 KickTable::createTable( const AngleDeg & angle,
+                        const std::vector< State > & state_list,
                         std::vector< Path > & table )
 {
     const int max_combination = NUM_STATE * NUM_STATE;
-    const int max_state = M_state_list.size();
+    const int max_state = state_list.size();
 
     table.clear();
     table.reserve( max_combination );
@@ -695,15 +761,15 @@ KickTable::createTable( const AngleDeg & angle,
     {
         for ( int dest = 0; dest < max_state; ++dest )
         {
-            Vector2D vel = M_state_list[dest].pos_ - M_state_list[origin].pos_;
+            Vector2D vel = state_list[dest].pos_ - state_list[origin].pos_;
             Vector2D max_vel = calc_max_velocity( angle,
-                                                  M_state_list[dest].kick_rate_,
+                                                  state_list[dest].kick_rate_,
                                                   vel );
             Vector2D accel = max_vel - vel;
 
             Path path( origin, dest );
             path.max_speed_ = max_vel.r();
-            path.power_ = accel.r() / M_state_list[dest].kick_rate_;
+            path.power_ = accel.r() / state_list[dest].kick_rate_;
             table.push_back( path );
         }
     }
@@ -724,14 +790,14 @@ KickTable::createTable( const AngleDeg & angle,
 void
 KickTable::updateState( const WorldModel & world )
 {
-    static GameTime s_update_time( -1, 0 );
-
-    if ( s_update_time == world.time() )
+    if ( M_update_world == &world
+         && M_update_time == world.time() )
     {
         return;
     }
 
-    s_update_time = world.time();
+    M_update_world = &world;
+    M_update_time = world.time();
 
     //
     // update current state
@@ -743,9 +809,9 @@ KickTable::updateState( const WorldModel & world )
     createStateCache( world );
 
 #ifdef DEBUG_PROFILE
-    dlog.addText( Logger::KICK,
-                  "(KickTable::updateState) KickTable_elapsed %f [ms]",
-                  timer.elapsedReal() );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::updateState) KickTable_elapsed %f [ms]",
+               timer.elapsedReal() );
 #endif
 }
 
@@ -757,8 +823,8 @@ void
 KickTable::createStateCache( const WorldModel & world )
 {
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "(KickTable::createStateCache)" );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::createStateCache)" );
 #endif
 
     const ServerParam & param = ServerParam::i();
@@ -799,10 +865,10 @@ KickTable::createStateCache( const WorldModel & world )
         M_current_state.pos_ = world.ball().pos();
         M_current_state.kick_rate_ = world.self().kickRate();
 #ifdef DEBUG
-        dlog.addText( Logger::KICK,
-                      "__ current_state pos=(%.2f %.2f) kick_rate=%.3f",
-                      world.ball().pos().x, world.ball().pos().y,
-                      M_current_state.kick_rate_ );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "__ current_state pos=(%.2f %.2f) kick_rate=%.3f",
+                   world.ball().pos().x, world.ball().pos().y,
+                   M_current_state.kick_rate_ );
 #endif
         checkInterfereAt( world, 0, M_current_state );
     }
@@ -824,7 +890,7 @@ KickTable::createStateCache( const WorldModel & world )
         int index = 0;
         for ( int near = 0; near < STATE_DIVS_NEAR; ++near )
         {
-            Vector2D pos = M_state_list[index].pos_;
+            Vector2D pos = M_tables->state_list_[index].pos_;
             double krate = self_type.kickRate( near_dist, pos.th().degree() );
 
             pos.rotate( world.self().body() );
@@ -838,18 +904,18 @@ KickTable::createStateCache( const WorldModel & world )
                 M_state_cache[i].back().flag_ |= OUT_OF_PITCH;
             }
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ cache_near_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
-                          i+1, index,
-                          pos.x, pos.y,
-                          krate, M_state_list[index].kick_rate_ );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "__ cache_near_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
+                       i+1, index,
+                       pos.x, pos.y,
+                       krate, M_tables->state_list_[index].kick_rate_ );
 #endif
             ++index;
         }
 
         for ( int mid = 0; mid < STATE_DIVS_MID; ++mid )
         {
-            Vector2D pos = M_state_list[index].pos_;
+            Vector2D pos = M_tables->state_list_[index].pos_;
             double krate = self_type.kickRate( mid_dist, pos.th().degree() );
 
             pos.rotate( world.self().body() );
@@ -863,18 +929,18 @@ KickTable::createStateCache( const WorldModel & world )
                 M_state_cache[i].back().flag_ |= OUT_OF_PITCH;
             }
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ cache_mid_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
-                          i+1, index,
-                          pos.x, pos.y,
-                          krate,  M_state_list[index].kick_rate_ );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "__ cache_mid_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
+                       i+1, index,
+                       pos.x, pos.y,
+                       krate,  M_tables->state_list_[index].kick_rate_ );
 #endif
             ++index;
         }
 
         for ( int far = 0; far < STATE_DIVS_FAR; ++far )
         {
-            Vector2D pos = M_state_list[index].pos_;
+            Vector2D pos = M_tables->state_list_[index].pos_;
             double krate = self_type.kickRate( far_dist, pos.th().degree() );
 
             pos.rotate( world.self().body() );
@@ -888,11 +954,11 @@ KickTable::createStateCache( const WorldModel & world )
                 M_state_cache[i].back().flag_ |= OUT_OF_PITCH;
             }
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ cache_far_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
-                          i+1, index,
-                          pos.x, pos.y,
-                          krate, M_state_list[index].kick_rate_ );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "__ cache_far_%d index=%d pos=(%.2f %.2f) kick_rate=%f/%f",
+                       i+1, index,
+                       pos.x, pos.y,
+                       krate, M_tables->state_list_[index].kick_rate_ );
 #endif
             ++index;
         }
@@ -910,8 +976,8 @@ KickTable::checkCollisionAfterRelease( const WorldModel & world,
                                        const double first_speed )
 {
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "(KickTable::checkCollisionAfterRelease)" );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::checkCollisionAfterRelease)" );
 #endif
 
     const PlayerType & self_type = world.self().playerType();
@@ -933,19 +999,19 @@ KickTable::checkCollisionAfterRelease( const WorldModel & world,
         if ( self_pos.dist2( release_pos ) < collide_dist2 )
         {
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ collision current_state self_pos=(%.2f %.2f) release_pos=(%.2f %.2f) dist=%.3f",
-                          self_pos.x, self_pos.y,
-                          release_pos.x, release_pos.y,
-                          self_pos.dist( release_pos ) );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "__ collision current_state self_pos=(%.2f %.2f) release_pos=(%.2f %.2f) dist=%.3f",
+                       self_pos.x, self_pos.y,
+                       release_pos.x, release_pos.y,
+                       self_pos.dist( release_pos ) );
 #endif
             M_current_state.flag_ |= SELF_COLLISION;
         }
         else
         {
 #ifdef DEBUG
-            dlog.addText( Logger::KICK,
-                          "__ no collision with current_state" );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "__ no collision with current_state" );
 #endif
             M_current_state.flag_ &= ~SELF_COLLISION;
         }
@@ -969,25 +1035,25 @@ KickTable::checkCollisionAfterRelease( const WorldModel & world,
             if ( self_pos.dist2( release_pos ) < collide_dist2 )
             {
 #ifdef DEBUG
-                dlog.addText( Logger::KICK,
-                              "__ collision cached_state (%d) index=%d state_pos=(%.2f %.2f)"
-                              " release_pos=(%.2f %.2f) dist=%.3f",
-                              i + 1,
-                              it->index_,
-                              it->pos_.x, it->pos_.y,
-                              release_pos.x, release_pos.y,
-                              self_pos.dist( release_pos ) );
+                RCSC_DLOG( Logger::KICK, addText,
+                           "__ collision cached_state (%d) index=%d state_pos=(%.2f %.2f)"
+                           " release_pos=(%.2f %.2f) dist=%.3f",
+                           i + 1,
+                           it->index_,
+                           it->pos_.x, it->pos_.y,
+                           release_pos.x, release_pos.y,
+                           self_pos.dist( release_pos ) );
 #endif
                 it->flag_ |= SELF_COLLISION;
             }
             else
             {
 #ifdef DEBUG
-                dlog.addText( Logger::KICK,
-                              "__ no collision cached_state (%d) index=%d (%.2f %.2f)",
-                              i + 1,
-                              it->index_,
-                              it->pos_.x, it->pos_.y );
+                RCSC_DLOG( Logger::KICK, addText,
+                           "__ no collision cached_state (%d) index=%d (%.2f %.2f)",
+                           i + 1,
+                           it->index_,
+                           it->pos_.x, it->pos_.y );
 #endif
                 it->flag_ &= ~SELF_COLLISION;
             }
@@ -1034,12 +1100,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
             {
                 flag |= KICKABLE;
 #ifdef DEBUG_OPPONENT
-                dlog.addText( Logger::KICK,
-                              "%d: state %d (%.2f %.2f) opp=%d(%.2f %.2f) is tackling but may collide",
-                              step, state.index_,
-                              state.pos_.x, state.pos_.y,
-                              (*o)->unum(),
-                              (*o)->pos().x, (*o)->pos().y );
+                RCSC_DLOG( Logger::KICK, addText,
+                           "%d: state %d (%.2f %.2f) opp=%d(%.2f %.2f) is tackling but may collide",
+                           step, state.index_,
+                           state.pos_.x, state.pos_.y,
+                           (*o)->unum(),
+                           (*o)->pos().x, (*o)->pos().y );
 #endif
                 break;
             }
@@ -1062,12 +1128,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
         {
             flag |= KICKABLE;
 #ifdef DEBUG_OPPONENT
-            dlog.addText( Logger::KICK,
-                          "%d: state %d (%.2f %.2f) kickable opp %d(%.2f %.2f)",
-                          step, state.index_,
-                          state.pos_.x, state.pos_.y,
-                          (*o)->unum(),
-                          (*o)->pos().x, (*o)->pos().y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: state %d (%.2f %.2f) kickable opp %d(%.2f %.2f)",
+                       step, state.index_,
+                       state.pos_.x, state.pos_.y,
+                       (*o)->unum(),
+                       (*o)->pos().x, (*o)->pos().y );
 #endif
             break;
         }
@@ -1099,12 +1165,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
                 {
                     flag |= TACKLABLE;
 #ifdef DEBUG_OPPONENT
-                    dlog.addText( Logger::KICK,
-                                  "%d: state %d (%.2f %.2f) tackle opp %d(%.1f %.1f)",
-                                  step, state.index_,
-                                  state.pos_.x, state.pos_.y,
-                                  (*o)->unum(),
-                                  (*o)->pos().x, (*o)->pos().y );
+                    RCSC_DLOG( Logger::KICK, addText,
+                               "%d: state %d (%.2f %.2f) tackle opp %d(%.1f %.1f)",
+                               step, state.index_,
+                               state.pos_.x, state.pos_.y,
+                               (*o)->unum(),
+                               (*o)->pos().x, (*o)->pos().y );
 #endif
                 }
             }
@@ -1125,12 +1191,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
         {
             flag |= NEXT_KICKABLE;
 #ifdef DEBUG_OPPONENT
-            dlog.addText( Logger::KICK,
-                          "%d: state %d (%.2f %.2f) next kickable opp %d(%.1f %.1f)",
-                          step, state.index_,
-                          state.pos_.x, state.pos_.y,
-                          (*o)->unum(),
-                          (*o)->pos().x, (*o)->pos().y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: state %d (%.2f %.2f) next kickable opp %d(%.1f %.1f)",
+                       step, state.index_,
+                       state.pos_.x, state.pos_.y,
+                       (*o)->unum(),
+                       (*o)->pos().x, (*o)->pos().y );
 #endif
         }
         else if ( player_2_pos.absY() < ServerParam::i().tackleWidth() * 0.7
@@ -1138,12 +1204,12 @@ KickTable::checkInterfereAt( const WorldModel & world,
                   && player_2_pos.x - max_accel < ServerParam::i().tackleDist() - 0.3 )
         {
 #ifdef DEBUG_OPPONENT
-            dlog.addText( Logger::KICK,
-                          "%d: state %d (%.2f %.2f) next tackle opp %d(%.1f %.1f)",
-                          step, state.index_,
-                          state.pos_.x, state.pos_.y,
-                          (*o)->unum(),
-                          (*o)->pos().x, (*o)->pos().y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: state %d (%.2f %.2f) next tackle opp %d(%.1f %.1f)",
+                       step, state.index_,
+                       state.pos_.x, state.pos_.y,
+                       (*o)->unum(),
+                       (*o)->pos().x, (*o)->pos().y );
 #endif
             flag |= NEXT_TACKLABLE;
         }
@@ -1199,12 +1265,12 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
     ball_pos += state.pos_;
 
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "____ state %d-%d (%.2f %.2f) check release interfere. bpos=(%.2f %.2f)",
-                  cycle,
-                  state.index_,
-                  state.pos_.x, state.pos_.y,
-                  ball_pos.x, ball_pos.y );
+    RCSC_DLOG( Logger::KICK, addText,
+               "____ state %d-%d (%.2f %.2f) check release interfere. bpos=(%.2f %.2f)",
+               cycle,
+               state.index_,
+               state.pos_.x, state.pos_.y,
+               ball_pos.x, ball_pos.y );
 #endif
 
     for ( PlayerObject::Cont::const_iterator o = world.opponentsFromBall().begin(),
@@ -1230,14 +1296,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
             {
                 state.flag_ |= RELEASE_INTERFERE;
 #ifdef DEBUG
-                dlog.addText( Logger::KICK,
-                              "____ state %d-%d (%.2f %.2f) opp=%d(%.1f %.1f)"
-                              " is tackling but may be collided",
-                              cycle,
-                              state.index_,
-                              state.pos_.x, state.pos_.y,
-                              (*o)->unum(),
-                              (*o)->pos().x, (*o)->pos().y );
+                RCSC_DLOG( Logger::KICK, addText,
+                           "____ state %d-%d (%.2f %.2f) opp=%d(%.1f %.1f)"
+                           " is tackling but may be collided",
+                           cycle,
+                           state.index_,
+                           state.pos_.x, state.pos_.y,
+                           (*o)->unum(),
+                           (*o)->pos().x, (*o)->pos().y );
 #endif
             }
 
@@ -1265,13 +1331,13 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
             }
 #ifdef DEBUG
             if ( cycle <= 1 )
-            dlog.addText( Logger::KICK,
-                          "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f) maybe interfere after release",
-                          cycle,
-                          state.index_,
-                          state.pos_.x, state.pos_.y,
-                          (*o)->unum(),
-                          (*o)->pos().x, (*o)->pos().y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f) maybe interfere after release",
+                       cycle,
+                       state.index_,
+                       state.pos_.x, state.pos_.y,
+                       (*o)->unum(),
+                       (*o)->pos().x, (*o)->pos().y );
 #endif
         }
 #if 1
@@ -1298,14 +1364,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
                     {
                         state.flag_ |= MAYBE_RELEASE_INTERFERE;
 #ifdef DEBUG
-                        dlog.addText( Logger::KICK,
-                                      "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
-                                      "maybe tackle after release",
-                                      cycle,
-                                      state.index_,
-                                      state.pos_.x, state.pos_.y,
-                                      (*o)->unum(),
-                                      (*o)->pos().x, (*o)->pos().y );
+                        RCSC_DLOG( Logger::KICK, addText,
+                                   "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
+                                   "maybe tackle after release",
+                                   cycle,
+                                   state.index_,
+                                   state.pos_.x, state.pos_.y,
+                                   (*o)->unum(),
+                                   (*o)->pos().x, (*o)->pos().y );
 #endif
                     }
                 }
@@ -1328,14 +1394,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
                 {
                     state.flag_ |= MAYBE_RELEASE_INTERFERE;
 #ifdef DEBUG
-                    dlog.addText( Logger::KICK,
-                                  "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
-                                  "maybe kickable after release, opp dash",
-                                  cycle,
-                                  state.index_,
-                                  state.pos_.x, state.pos_.y,
-                                  (*o)->unum(),
-                                  (*o)->pos().x, (*o)->pos().y );
+                    RCSC_DLOG( Logger::KICK, addText,
+                               "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
+                               "maybe kickable after release, opp dash",
+                               cycle,
+                               state.index_,
+                               state.pos_.x, state.pos_.y,
+                               (*o)->unum(),
+                               (*o)->pos().x, (*o)->pos().y );
 #endif
                 }
                 else if ( player_2_pos.absY() < ServerParam::i().tackleWidth() * 0.7
@@ -1343,14 +1409,14 @@ KickTable::checkInterfereAfterRelease( const WorldModel & world,
                 {
                     state.flag_ |= MAYBE_RELEASE_INTERFERE;
 #ifdef DEBUG
-                    dlog.addText( Logger::KICK,
-                                  "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
-                                  "maybe tackle after release, opp dash",
-                                  cycle,
-                                  state.index_,
-                                  state.pos_.x, state.pos_.y,
-                                  (*o)->unum(),
-                                  (*o)->pos().x, (*o)->pos().y );
+                    RCSC_DLOG( Logger::KICK, addText,
+                               "____ state %d-%d (%.2f %.2f) opp %d(%.1f %.1f)"
+                               "maybe tackle after release, opp dash",
+                               cycle,
+                               state.index_,
+                               state.pos_.x, state.pos_.y,
+                               (*o)->unum(),
+                               (*o)->pos().x, (*o)->pos().y );
 #endif
                 }
             }
@@ -1371,8 +1437,8 @@ KickTable::simulateOneStep( const WorldModel & world,
     if ( M_current_state.flag_ & SELF_COLLISION )
     {
 #ifdef DEBUG_ONE_STEP
-        dlog.addText( Logger::KICK,
-                      "xx__ 1 step: self collision" );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "xx__ 1 step: self collision" );
 #endif
         return false;
     }
@@ -1380,8 +1446,8 @@ KickTable::simulateOneStep( const WorldModel & world,
     if ( M_current_state.flag_ & RELEASE_INTERFERE )
     {
 #ifdef DEBUG_ONE_STEP
-        dlog.addText( Logger::KICK,
-                      "xx__ 1 step: opponent can interfere after release" );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "xx__ 1 step: opponent can interfere after release" );
 #endif
         return false;
     }
@@ -1396,9 +1462,9 @@ KickTable::simulateOneStep( const WorldModel & world,
     if ( accel_r > current_max_accel )
     {
 #ifdef DEBUG_ONE_STEP
-        dlog.addText( Logger::KICK,
-                      "xx__ 1 step: failed. max_vel=required_accel=%f > max_accel=%f",
-                      accel_r, current_max_accel );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "xx__ 1 step: failed. max_vel=required_accel=%f > max_accel=%f",
+                   accel_r, current_max_accel );
 #endif
         Vector2D max_vel = calc_max_velocity( target_vel.th(),
                                               M_current_state.kick_rate_,
@@ -1420,15 +1486,15 @@ KickTable::simulateOneStep( const WorldModel & world,
     M_candidates.back().speed_ = first_speed;
     M_candidates.back().power_ = accel_r / M_current_state.kick_rate_;
 #ifdef DEBUG_ONE_STEP
-    dlog.addText( Logger::KICK,
-                  "ok__ 1 step: target_vel=(%.2f %.2f)%.3f required_accel=%.3f < max_accel=%.3f"
-                  " kick_rate=%f power=%.1f",
-                  target_vel.x, target_vel.y,
-                  first_speed,
-                  accel_r,
-                  current_max_accel,
-                  M_current_state.kick_rate_,
-                  M_candidates.back().power_ );
+    RCSC_DLOG( Logger::KICK, addText,
+               "ok__ 1 step: target_vel=(%.2f %.2f)%.3f required_accel=%.3f < max_accel=%.3f"
+               " kick_rate=%f power=%.1f",
+               target_vel.x, target_vel.y,
+               first_speed,
+               accel_r,
+               current_max_accel,
+               M_current_state.kick_rate_,
+               M_candidates.back().power_ );
 #endif
     return true;
 }
@@ -1440,7 +1506,8 @@ KickTable::simulateOneStep( const WorldModel & world,
 bool
 KickTable::simulateTwoStep( const WorldModel & world,
                             const Vector2D & target_point,
-                            const double first_speed )
+                            const double first_speed,
+                            const Deadline & deadline )
 {
     static const double max_power = ServerParam::i().maxPower();
     static const double accel_max = ServerParam::i().ballAccelMax();
@@ -1471,14 +1538,23 @@ KickTable::simulateTwoStep( const WorldModel & world,
 
     for ( int i = 0; i < NUM_STATE; ++i, ++count )
     {
+        if ( ( count & DEADLINE_CHECK_MASK ) == 0
+             && deadline.isExpired() )
+        {
+            RCSC_DLOG( Logger::KICK, addText,
+                       "(KickTable::simulateTwoStep) deadline expired. checked=%d",
+                       i );
+            break;
+        }
+
         const State & state = M_state_cache[0][i];
 
         if ( state.flag_ & OUT_OF_PITCH )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: skip. out of pitch. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: xx__ 2 step: skip. out of pitch. state_pos=(%.2f %.2f)",
+                       count, state.pos_.x, state.pos_.y );
 #endif
             continue;
         }
@@ -1486,9 +1562,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( state.flag_ & KICKABLE )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: skip. exist kicable opp. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: xx__ 2 step: skip. exist kicable opp. state_pos=(%.2f %.2f)",
+                       count, state.pos_.x, state.pos_.y );
 #endif
             continue;
         }
@@ -1496,9 +1572,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( state.flag_ & SELF_COLLISION )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: skip. self collision. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: xx__ 2 step: skip. self collision. state_pos=(%.2f %.2f)",
+                       count, state.pos_.x, state.pos_.y );
 #endif
             continue;
         }
@@ -1506,9 +1582,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( state.flag_ & RELEASE_INTERFERE )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: interfere after release. state_pos=(%.2f %.2f)",
-                          count, state.pos_.x, state.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: xx__ 2 step: interfere after release. state_pos=(%.2f %.2f)",
+                       count, state.pos_.x, state.pos_.y );
 #endif
             //return false;
             continue;
@@ -1539,9 +1615,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( accel_r > current_max_accel )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2 step: failed(1) required_accel=%.3f > max_accel=%.3f",
-                          count, accel_r, current_max_accel );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: xx__ 2 step: failed(1) required_accel=%.3f > max_accel=%.3f",
+                       count, accel_r, current_max_accel );
 #endif
             continue;
         }
@@ -1556,14 +1632,14 @@ KickTable::simulateTwoStep( const WorldModel & world,
                  > my_kickable_area - state.dist_ - 0.05 ) //0.1 )
             {
 #ifdef DEBUG_TWO_STEP
-                dlog.addText( Logger::KICK,
-                              "%d: xx__ 2 step: failed. buffer is not safety. power=%.3f"
-                              " my_kickable=%.3f state_dist=%.3f,"
-                              " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
-                              count, kick_power,
-                              my_kickable_area, state.dist_,
-                              ( my_noise + ball_noise + max_kick_rand ) * 0.9,
-                              my_noise, ball_noise, max_kick_rand );
+                RCSC_DLOG( Logger::KICK, addText,
+                           "%d: xx__ 2 step: failed. buffer is not safety. power=%.3f"
+                           " my_kickable=%.3f state_dist=%.3f,"
+                           " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
+                           count, kick_power,
+                           my_kickable_area, state.dist_,
+                           ( my_noise + ball_noise + max_kick_rand ) * 0.9,
+                           my_noise, ball_noise, max_kick_rand );
 #endif
                 kick_miss_flag |= KICK_MISS_POSSIBILITY;
                 // if ( ! M_use_risky_node )
@@ -1581,9 +1657,9 @@ KickTable::simulateTwoStep( const WorldModel & world,
         if ( accel_r > std::min( state.kick_rate_ * max_power, accel_max ) )
         {
 #ifdef DEBUG_TWO_STEP
-            dlog.addText( Logger::KICK,
-                          "%d: xx__ 2step: failed(2) required_accel=%.3f > max_accel=%.3f",
-                          count, accel_r, std::min( state.kick_rate_ * max_power, accel_max ) );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: xx__ 2step: failed(2) required_accel=%.3f > max_accel=%.3f",
+                       count, accel_r, std::min( state.kick_rate_ * max_power, accel_max ) );
 #endif
             if ( success_count == 0 )
             {
@@ -1609,10 +1685,10 @@ KickTable::simulateTwoStep( const WorldModel & world,
                     M_candidates.back().speed_ = std::sqrt( max_speed2 );
                     M_candidates.back().power_ = accel.r() / state.kick_rate_;
 #ifdef DEBUG_TWO_STEP
-                    dlog.addText( Logger::KICK,
-                                  "%d: ____ update max vel (%.2f %.2f) %.3f",
-                                  count, max_vel.x, max_vel.y,
-                                  M_candidates.back().speed_ );
+                    RCSC_DLOG( Logger::KICK, addText,
+                               "%d: ____ update max vel (%.2f %.2f) %.3f",
+                               count, max_vel.x, max_vel.y,
+                               M_candidates.back().speed_ );
 #endif
                 }
             }
@@ -1629,10 +1705,10 @@ KickTable::simulateTwoStep( const WorldModel & world,
         M_candidates.back().speed_ = first_speed;
         M_candidates.back().power_ = accel_r / state.kick_rate_;
 #ifdef DEBUG_TWO_STEP
-        dlog.addText( Logger::KICK,
-                      "%d: ok__ 2 step: last_power=%.2f subtarget=(%.2f %.2f)",
-                      count, M_candidates.back().power_,
-                      state.pos_.x, state.pos_.y );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "%d: ok__ 2 step: last_power=%.2f subtarget=(%.2f %.2f)",
+                   count, M_candidates.back().power_,
+                   state.pos_.x, state.pos_.y );
 #endif
     }
 
@@ -1646,7 +1722,8 @@ KickTable::simulateTwoStep( const WorldModel & world,
 bool
 KickTable::simulateThreeStep( const WorldModel & world,
                               const Vector2D & target_point,
-                              const double first_speed )
+                              const double first_speed,
+                              const Deadline & deadline )
 {
     static const double max_power = ServerParam::i().maxPower();
     static const double accel_max = ServerParam::i().ballAccelMax();
@@ -1681,12 +1758,12 @@ KickTable::simulateThreeStep( const WorldModel & world,
     if ( target_angle_index >= DEST_DIR_DIVS ) target_angle_index = 0;
 
 #ifdef DEBUG
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulateThreeStep) target angle index = %d ",
-                  target_angle_index );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::simulateThreeStep) target angle index = %d ",
+               target_angle_index );
 #endif
 
-    const std::vector< Path > & table = M_tables[target_angle_index];
+    const std::vector< Path > & table = M_tables->paths_[target_angle_index];
 
     int success_count = 0;
     double max_speed2 = 0.0;
@@ -1697,15 +1774,24 @@ KickTable::simulateThreeStep( const WorldModel & world,
           it != end && count < MAX_TABLE_SIZE && success_count <= 10;
           ++it, ++count )
     {
+        if ( ( count & DEADLINE_CHECK_MASK ) == 0
+             && deadline.isExpired() )
+        {
+            RCSC_DLOG( Logger::KICK, addText,
+                       "(KickTable::simulateThreeStep) deadline expired. checked=%d",
+                       static_cast< int >( count ) );
+            break;
+        }
+
         const State & state_1st = M_state_cache[0][it->origin_];
         const State & state_2nd = M_state_cache[1][it->dest_];
 
         if ( state_1st.flag_ & OUT_OF_PITCH )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. out of pitch. state_1st pos=(%.2f %.2f)",
-                          count, state_1st.pos_.x, state_1st.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: skip. out of pitch. state_1st pos=(%.2f %.2f)",
+                       count, state_1st.pos_.x, state_1st.pos_.y );
 #endif
             continue;
         }
@@ -1713,9 +1799,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & OUT_OF_PITCH )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. out of pitch. state_2nd pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: skip. out of pitch. state_2nd pos=(%.2f %.2f)",
+                       count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             continue;
         }
@@ -1723,9 +1809,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_1st.flag_ & KICKABLE )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. exist kicable opp. state_1st pos=(%.2f %.2f)",
-                          count, state_1st.pos_.x, state_1st.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: skip. exist kicable opp. state_1st pos=(%.2f %.2f)",
+                       count, state_1st.pos_.x, state_1st.pos_.y );
 #endif
             continue;
         }
@@ -1733,9 +1819,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & KICKABLE )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. exist kicable opp. state_2nd pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: skip. exist kicable opp. state_2nd pos=(%.2f %.2f)",
+                       count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             continue;
         }
@@ -1743,9 +1829,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & SELF_COLLISION )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: skip. self collision. state_2nd_pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: skip. self collision. state_2nd_pos=(%.2f %.2f)",
+                       count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             continue;
         }
@@ -1753,9 +1839,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( state_2nd.flag_ & RELEASE_INTERFERE )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: interfere after release. state_pos=(%.2f %.2f)",
-                          count, state_2nd.pos_.x, state_2nd.pos_.y );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: interfere after release. state_pos=(%.2f %.2f)",
+                       count, state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
             //return false;
             continue;
@@ -1789,9 +1875,9 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( accel_r2 > current_max_accel2 )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: failed(1) required_accel=%.3f > max_accel=%.3f",
-                          count, std::sqrt( accel_r2 ), std::sqrt( current_max_accel2 ) );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: failed(1) required_accel=%.3f > max_accel=%.3f",
+                       count, std::sqrt( accel_r2 ), std::sqrt( current_max_accel2 ) );
 #endif
             continue;
         }
@@ -1808,15 +1894,15 @@ KickTable::simulateThreeStep( const WorldModel & world,
                  > my_kickable_area - state_1st.dist_ - 0.1 )
             {
 #ifdef DEBUG_THREE_STEP
-                dlog.addText( Logger::KICK,
-                              "%zd: xx__ 3 step: 1st kick may cause unkickable. power=%.3f"
-                              " my_kickable=%.3f state_dist=%.3f,"
-                              " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
-                              count,
-                              kick_power,
-                              my_kickable_area, state_1st.dist_,
-                              ( my_noise1 + ball_noise + max_kick_rand ) * 0.9,
-                              my_noise1, ball_noise, max_kick_rand );
+                RCSC_DLOG( Logger::KICK, addText,
+                           "%zd: xx__ 3 step: 1st kick may cause unkickable. power=%.3f"
+                           " my_kickable=%.3f state_dist=%.3f,"
+                           " noise=%f(my_noise=%f ball_noise=%f kick_rand=%f)",
+                           count,
+                           kick_power,
+                           my_kickable_area, state_1st.dist_,
+                           ( my_noise1 + ball_noise + max_kick_rand ) * 0.9,
+                           my_noise1, ball_noise, max_kick_rand );
 #endif
                 kick_miss_flag |= KICK_MISS_POSSIBILITY;
                 // if ( ! M_use_risky_node )
@@ -1836,11 +1922,11 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( accel_r2 > square( std::min( state_1st.kick_rate_ * max_power * 0.9, accel_max ) ) )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "%zd: xx__ 3 step: failed(2) required_accel=%.3f > max_accel=%.3f",
-                          count,
-                          std::sqrt( accel_r2 ),
-                          std::min( state_1st.kick_rate_ * max_power, accel_max ) );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%zd: xx__ 3 step: failed(2) required_accel=%.3f > max_accel=%.3f",
+                       count,
+                       std::sqrt( accel_r2 ),
+                       std::min( state_1st.kick_rate_ * max_power, accel_max ) );
 #endif
             continue;
         }
@@ -1851,10 +1937,10 @@ KickTable::simulateThreeStep( const WorldModel & world,
         if ( accel_r2 > square( std::min( state_2nd.kick_rate_ * max_power, accel_max ) ) )
         {
 #ifdef DEBUG_THREE_STEP_DETAIL
-            dlog.addText( Logger::KICK,
-                          "xx__ 3 step: failed(3) required_accel=%.3f > max_accel=%.3f",
-                          std::sqrt( accel_r2 ),
-                          std::min( state_2nd.kick_rate_ * max_power, accel_max ) );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "xx__ 3 step: failed(3) required_accel=%.3f > max_accel=%.3f",
+                       std::sqrt( accel_r2 ),
+                       std::min( state_2nd.kick_rate_ * max_power, accel_max ) );
 #endif
             if ( success_count == 0 )
             {
@@ -1883,10 +1969,10 @@ KickTable::simulateThreeStep( const WorldModel & world,
                     M_candidates.back().power_ = accel.r() / state_2nd.kick_rate_;
 
 #ifdef DEBUG_THREE_STEP
-                    dlog.addText( Logger::KICK,
-                                  "____ update max vel (%.2f %.2f) %.3f",
-                                  max_vel.x, max_vel.y,
-                                  M_candidates.back().speed_ );
+                    RCSC_DLOG( Logger::KICK, addText,
+                               "____ update max vel (%.2f %.2f) %.3f",
+                               max_vel.x, max_vel.y,
+                               M_candidates.back().speed_ );
 #endif
                 }
             }
@@ -1906,25 +1992,25 @@ KickTable::simulateThreeStep( const WorldModel & world,
         M_candidates.back().power_ = std::sqrt( accel_r2 ) / state_2nd.kick_rate_;
 
 #ifdef DEBUG_THREE_STEP
-        dlog.addText( Logger::KICK,
-                      "%zd: ok__ 3 step: last_power=%.2f sub1=(%.2f %.2f) sub2(%.2f %.2f)",
-                      count,
-                      M_candidates.back().power_,
-                      state_1st.pos_.x, state_1st.pos_.y,
-                      state_2nd.pos_.x, state_2nd.pos_.y );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "%zd: ok__ 3 step: last_power=%.2f sub1=(%.2f %.2f) sub2(%.2f %.2f)",
+                   count,
+                   M_candidates.back().power_,
+                   state_1st.pos_.x, state_1st.pos_.y,
+                   state_2nd.pos_.x, state_2nd.pos_.y );
 #endif
         ++success_count;
     }
 
 #ifdef DEBUG_THREE_STEP
-    dlog.addText( Logger::KICK,
-                  "simulateThreeKick() solution_size=%d",
-                  success_count );
+    RCSC_DLOG( Logger::KICK, addText,
+               "simulateThreeKick() solution_size=%d",
+               success_count );
     if ( success_count == 0 )
     {
-        dlog.addText( Logger::KICK,
-                      "simulateThreeKick() max_speed=%.3f",
-                      std::sqrt( max_speed2 ) );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "simulateThreeKick() max_speed=%.3f",
+                   std::sqrt( max_speed2 ) );
     }
 #endif
 
@@ -1940,9 +2026,9 @@ KickTable::evaluate( const WorldModel & wm,
                      const double first_speed,
                      const double allowable_speed )
 {
-    dlog.addText( Logger::KICK,
-                  "(KickTable::evaluate) candidate size=%zd",
-                  M_candidates.size() );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::evaluate) candidate size=%zd",
+               M_candidates.size() );
 
 #ifndef DEBUG_PRINT_EVALUATE
     (void)wm;
@@ -2020,15 +2106,15 @@ KickTable::evaluate( const WorldModel & wm,
         {
             it->score_ -= 30.0;
 #ifdef DEBUG_EVALUATE
-            dlog.addText( Logger::KICK,
-                          "%d: (eval) %d maybe kick failure flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
-                          count, it->index_, it->flag_, n_kick, it->speed_, it->power_ );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "%d: (eval) %d maybe kick failure flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
+                       count, it->index_, it->flag_, n_kick, it->speed_, it->power_ );
 #endif
         }
 #ifdef DEBUG_EVALUATE
-        dlog.addText( Logger::KICK,
-                      "%d: (eval) %d score %.2f flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
-                      count, it->index_, it->score_, it->flag_, n_kick, it->speed_, it->power_ );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "%d: (eval) %d score %.2f flag=%x n_kick=%d speed=%.3f last_kick_power=%f",
+                   count, it->index_, it->score_, it->flag_, n_kick, it->speed_, it->power_ );
 
         //if ( count == 4 ) debug_print_sequence( wm, *it );
 #endif
@@ -2042,6 +2128,11 @@ KickTable::evaluate( const WorldModel & wm,
 void
 KickTable::debugPrintStateCache()
 {
+    if ( ! RCSC_DLOG_ENABLED( Logger::KICK ) )
+    {
+        return;
+    }
+
     for ( int i = 0; i < MAX_DEPTH; ++i )
     {
         for ( std::vector< State >::const_iterator s = M_state_cache[i].begin();
@@ -2059,12 +2150,12 @@ KickTable::debugPrintStateCache()
             else if ( s->flag_ & RELEASE_INTERFERE ) snprintf( buf, 8, "#0F0" );
             else if ( s->flag_ & MAYBE_RELEASE_INTERFERE ) snprintf( buf, 8, "#080" );
             else if ( s->flag_ & KICK_MISS_POSSIBILITY ) snprintf( buf, 8, "#0FF" );
-            dlog.addRect( Logger::KICK,
-                          s->pos_.x - 0.01, s->pos_.y - 0.01, 0.02, 0.02,
-                          buf, true );
+            RCSC_DLOG( Logger::KICK, addRect,
+                       s->pos_.x - 0.01, s->pos_.y - 0.01, 0.02, 0.02,
+                       buf, true );
 
             snprintf( buf, 8, "%d", i+1 );
-            dlog.addMessage( Logger::KICK, s->pos_, buf );
+            RCSC_DLOG( Logger::KICK, addMessage, s->pos_, buf );
         }
     }
 }
@@ -2077,16 +2168,21 @@ void
 KickTable::debugPrintSequence( const WorldModel & wm,
                                const KickTable::Sequence & seq )
 {
+    if ( ! RCSC_DLOG_ENABLED( Logger::KICK ) )
+    {
+        return;
+    }
+
     if ( ! seq.pos_list_.empty() )
     {
-        dlog.addLine( Logger::KICK,
-                      wm.ball().pos(), seq.pos_list_.front(),
-                      "#F00" );
+        RCSC_DLOG( Logger::KICK, addLine,
+                   wm.ball().pos(), seq.pos_list_.front(),
+                   "#F00" );
         for ( size_t i = 1; i < seq.pos_list_.size(); ++i )
         {
-            dlog.addLine( Logger::KICK,
-                          seq.pos_list_[i-1], seq.pos_list_[i],
-                          std::max( 0, int( 255 - i * 80 ) ), 0, 0 );
+            RCSC_DLOG( Logger::KICK, addLine,
+                       seq.pos_list_[i-1], seq.pos_list_[i],
+                       std::max( 0, int( 255 - i * 80 ) ), 0, 0 );
         }
     }
 }
@@ -2110,8 +2206,8 @@ check_candidates_max_speed( const std::vector< KickTable::Sequence > & candidate
             // dlog.addText( Logger::KICK,
             //               "(KickTable::check_candidate) OK %d speed=%.3f  thr=%.3f",
             //               it->index_, it->speed_, speed_thr );
-            dlog.addText( Logger::KICK,
-                          "(KickTable::check_candidate) OK found" );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "(KickTable::check_candidate) OK found" );
             return true;
         }
         // dlog.addText( Logger::KICK,
@@ -2119,8 +2215,8 @@ check_candidates_max_speed( const std::vector< KickTable::Sequence > & candidate
         //               it->index_, it->speed_, speed_thr );
     }
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::check_candidate) NG not found" );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::check_candidate) NG not found" );
     return false;
 }
 
@@ -2138,10 +2234,29 @@ KickTable::simulate( const WorldModel & world,
                      const int max_step,
                      Sequence & sequence )
 {
-    if ( M_state_list.empty() )
+    return simulate( world, target_point, first_speed, allowable_speed, max_step,
+                     sequence, Deadline() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+KickTable::simulate( const WorldModel & world,
+                     const Vector2D & target_point,
+                     const double first_speed,
+                     const double allowable_speed,
+                     const int max_step,
+                     Sequence & sequence,
+                     const Deadline & deadline )
+{
+    RCSC_PROFILE_ZONE( "KickTable::simulate" );
+
+    if ( ! syncTables() )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) KickTable is not initialized!." );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "(KickTable::simulate) KickTable is not initialized!." );
         std::cerr << "KickTable has not been initialized! "
                   << "KickTable::instance().createTable() has to be called before using KickTable::simulate()."
                   << std::endl;
@@ -2159,10 +2274,10 @@ KickTable::simulate( const WorldModel & world,
                               allowable_speed,
                               target_speed );
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulate) start. target=(%.2f %.2f) speed=%.2f",
-                  target_point.x, target_point.y,
-                  target_speed );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::simulate) start. target=(%.2f %.2f) speed=%.2f",
+               target_point.x, target_point.y,
+               target_speed );
 
     M_candidates.clear();
 
@@ -2184,8 +2299,8 @@ KickTable::simulate( const WorldModel & world,
                              target_point,
                              target_speed ) )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) found 1 step" );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "(KickTable::simulate) found 1 step" );
     }
 
     M_use_risky_node = false;
@@ -2193,25 +2308,33 @@ KickTable::simulate( const WorldModel & world,
     if ( max_step >= 2
          && simulateTwoStep( world,
                              target_point,
-                             target_speed ) )
+                             target_speed,
+                             deadline ) )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) found 2 step" );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "(KickTable::simulate) found 2 step" );
     }
 
     if ( max_step >= 3
          && simulateThreeStep( world,
                                target_point,
-                               target_speed ) )
+                               target_speed,
+                               deadline ) )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) found 3 step" );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "(KickTable::simulate) found 3 step" );
     }
 
     // dlog.addText( Logger::KICK,
     //               "(KickTable::simulate) candidate size = %zd", M_candidates.size() );
 
-    if ( ! check_candidates_max_speed( M_candidates, speed_thr ) )
+    if ( deadline.isExpired() )
+    {
+        RCSC_DLOG( Logger::KICK, addText,
+                   "(KickTable::simulate) deadline expired. candidate size = %d",
+                   static_cast< int >( M_candidates.size() ) );
+    }
+    else if ( ! check_candidates_max_speed( M_candidates, speed_thr ) )
     {
         M_use_risky_node = true;
 
@@ -2221,19 +2344,21 @@ KickTable::simulate( const WorldModel & world,
         if ( max_step >= 2
              && simulateTwoStep( world,
                                  target_point,
-                                 target_speed ) )
+                                 target_speed,
+                                 deadline ) )
         {
-            dlog.addText( Logger::KICK,
-                          "(KickTable::simulate) found 2 step with risky node" );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "(KickTable::simulate) found 2 step with risky node" );
         }
 
         if ( max_step >= 3
              && simulateThreeStep( world,
                                    target_point,
-                                   target_speed ) )
+                                   target_speed,
+                                   deadline ) )
         {
-            dlog.addText( Logger::KICK,
-                          "(KickTable::simulate) found 3 step with risky node" );
+            RCSC_DLOG( Logger::KICK, addText,
+                       "(KickTable::simulate) found 3 step with risky node" );
         }
     }
 
@@ -2242,8 +2367,8 @@ KickTable::simulate( const WorldModel & world,
 
     if ( M_candidates.empty() )
     {
-        dlog.addText( Logger::KICK,
-                      "(KickTable::simulate) No candidate" );
+        RCSC_DLOG( Logger::KICK, addText,
+                   "(KickTable::simulate) No candidate" );
         return false;
     }
 
@@ -2255,23 +2380,23 @@ KickTable::simulate( const WorldModel & world,
                                   M_candidates.end(),
                                   SequenceSorter() );
 
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulate) result next_pos=(%.2f %.2f) flag=%x n_kick=%d speed=%.2f power=%.2f score=%.2f",
-                  sequence.pos_list_.front().x,
-                  sequence.pos_list_.front().y,
-                  sequence.flag_,
-                  (int)sequence.pos_list_.size(),
-                  sequence.speed_,
-                  sequence.power_,
-                  sequence.score_ );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::simulate) result next_pos=(%.2f %.2f) flag=%x n_kick=%d speed=%.2f power=%.2f score=%.2f",
+               sequence.pos_list_.front().x,
+               sequence.pos_list_.front().y,
+               sequence.flag_,
+               (int)sequence.pos_list_.size(),
+               sequence.speed_,
+               sequence.power_,
+               sequence.score_ );
 #ifdef DEBUG_PRINT_SEQUENCE
     debugPrintSequence( world, sequence );
 #endif
 
 #ifdef DEBUG_PROFILE
-    dlog.addText( Logger::KICK,
-                  "(KickTable::simulate) KickTable_elapsed=%f [ms].",
-                  timer.elapsedReal() );
+    RCSC_DLOG( Logger::KICK, addText,
+               "(KickTable::simulate) KickTable_elapsed=%f [ms].",
+               timer.elapsedReal() );
 #endif
     return sequence.speed_ >= target_speed - rcsc::EPS;
 }
@@ -34,13 +34,17 @@
 
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/geom/angle_deg.h>
+#include <rcsc/game_time.h>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <algorithm>
 
 namespace rcsc {
 
-class GameTime;
+class Deadline;
 class PlayerType;
 class WorldModel;
 
@@ -48,6 +52,11 @@ class WorldModel;
 /*!
   \class KickTabke
   \brief kick table to generate smart kick.
+
+  Each thread has its own instance for the search state, and the offline
+  tables are shared by all instances in the process. The tables are
+  immutable after they are created, so several agents in one process can
+  search at the same time.
 */
 class KickTable {
 public:
@@ -179,27 +188,60 @@ public:
 
 private:
 
+    /*!
+      \struct Tables
+      \brief offline data. immutable after creation.
+     */
+    struct Tables {
+        //! default player size
+        double player_size_;
+        //! default kickable margin
+        double kickable_margin_;
+        //! default ball size
+        double ball_size_;
+
+        //! static state list
+        std::vector< State > state_list_;
+
+        //! static heuristic table
+        std::vector< Path > paths_[DEST_DIR_DIVS];
+
+        Tables()
+            : player_size_( 0.0 ),
+              kickable_margin_( 0.0 ),
+              ball_size_( 0.0 )
+          { }
+    };
+
     //
-    // offline data
+    // offline data shared by all instances
     //
 
-    //! default player size
-    double M_player_size;
-    //! default kickable margin
-    double M_kickable_margin;
-    //! default ball size
-    double M_ball_size;
+    //! guard for S_tables
+    static std::mutex S_tables_mutex;
+
+    //! the latest tables
+    static std::shared_ptr< const Tables > S_tables;
 
-    //! static state list
-    std::vector< State > M_state_list;
+    //! incremented when S_tables is replaced
+    static std::atomic< int > S_tables_version;
 
-    //! static heuristic table
-    std::vector< Path > M_tables[DEST_DIR_DIVS];
+    //! tables used by this instance
+    std::shared_ptr< const Tables > M_tables;
+
+    //! version of M_tables
+    int M_tables_version;
 
     //
     // online data
     //
 
+    //! world model used by the last state update
+    const WorldModel * M_update_world;
+
+    //! time of the last state update
+    GameTime M_update_time;
+
     //! current state cache
     State M_current_state;
 
@@ -229,17 +271,36 @@ private:
 
     /*!
       \brief create static state list
+      \param player_type default player type
+      \param state_list reference to the container variable
      */
-    void createStateList( const PlayerType & player_type );
+    static
+    void createStateList( const PlayerType & player_type,
+                          std::vector< State > & state_list );
 
     /*!
       \brief create table for angle
       \param angle target angle relative to body angle
+      \param state_list static state list
       \param table referecne to the container variable
      */
+    static
     void createTable( const AngleDeg & angle,
+                      const std::vector< State > & state_list,
                       std::vector< Path > & table );
 
+    /*!
+      \brief replace the shared tables. S_tables_mutex has to be locked.
+      \param tables new tables
+     */
+    void publishTables( const std::shared_ptr< const Tables > & tables );
+
+    /*!
+      \brief update M_tables if the shared tables have been replaced
+      \return true if the tables are available
+     */
+    bool syncTables();
+
     /*!
       \brief update internal state
       \param world const rererence to the WorldModel
@@ -311,20 +372,24 @@ private:
       \param world const reference to the WorldModel
       \param target_point kick target point
       \param first_speed required first speed
+      \param deadline the search is cut short when this is expired
      */
     bool simulateTwoStep( const WorldModel & world,
                           const Vector2D & target_point,
-                          const double first_speed );
+                          const double first_speed,
+                          const Deadline & deadline );
 
     /*!
       \brief simulate three step kicks
       \param world const reference to the WorldModel
       \param target_point kick target point
       \param first_speed required first speed
+      \param deadline the search is cut short when this is expired
      */
     bool simulateThreeStep( const WorldModel & world,
                             const Vector2D & target_point,
-                            const double first_speed );
+                            const double first_speed,
+                            const Deadline & deadline );
 
     /*!
       \brief evaluate candidate kick sequences
@@ -352,20 +417,20 @@ private:
 public:
 
     /*!
-      \brief singleton interface
-      \return reference to the singleton instance
+      \brief get the instance for the current thread
+      \return reference to the thread local instance
      */
     static
     KickTable & instance();
 
     /*!
-      \brief create heuristic table
-      \return result of table creation
+      \brief create heuristic table, and share it with the instances in other threads.
+      \return false if the current tables are already created for the current parameters.
      */
     bool createTables();
 
     /*!
-      \brief read table data from file
+      \brief read table data from file, and share it with the instances in other threads.
       \param file_path file path to read
       \return read result
      */
@@ -395,6 +460,28 @@ public:
                    const int max_step,
                    Sequence & sequence );
 
+    /*!
+      \brief simulate kick sequence within the time limit.
+      one step kicks are always checked. two and three step searches are
+      stopped when the deadline is expired, and the best sequence among the
+      candidates found so far is returned.
+      \param world const reference to the WorldModel
+      \param target_point kick target point
+      \param first_speed required first speed
+      \param allowable_speed required first speed threshold
+      \param max_step maximum size of kick sequence
+      \param sequence reference to the result variable
+      \param deadline time limit of this search
+      \return if successful kick is found, then true, else false is returned but kick sequence is generated anyway.
+     */
+    bool simulate( const WorldModel & world,
+                   const Vector2D & target_point,
+                   const double first_speed,
+                   const double allowable_speed,
+                   const int max_step,
+                   Sequence & sequence,
+                   const Deadline & deadline );
+
     /*!
       \brief get the candidate kick sequences
       \return const reference to the container of Sequence
@@ -60,13 +60,17 @@ const double Neck_ScanField::INVALID_ANGLE = -360.0;
 bool
 Neck_ScanField::execute( PlayerAgent * agent )
 {
-    static GameTime s_last_calc_time( 0, 0 );
-    static ViewWidth s_last_calc_view_width = ViewWidth::NORMAL;
-    static AngleDeg s_cached_target_angle = 0.0;
+    // the cache is kept for each thread and each world model,
+    // because several agents may be executed in one process.
+    thread_local const WorldModel * s_last_world = static_cast< const WorldModel * >( 0 );
+    thread_local GameTime s_last_calc_time( 0, 0 );
+    thread_local ViewWidth s_last_calc_view_width = ViewWidth::NORMAL;
+    thread_local AngleDeg s_cached_target_angle = 0.0;
 
     const WorldModel & wm = agent->world();
 
-    if ( s_last_calc_time == wm.time()
+    if ( s_last_world == &wm
+         && s_last_calc_time == wm.time()
          && s_last_calc_view_width != agent->effector().queuedNextViewWidth() )
     {
         dlog.addText( Logger::ACTION,
@@ -79,6 +83,7 @@ Neck_ScanField::execute( PlayerAgent * agent )
 
     }
 
+    s_last_world = &wm;
     s_last_calc_time = agent->world().time();
     s_last_calc_view_width = agent->effector().queuedNextViewWidth();
 
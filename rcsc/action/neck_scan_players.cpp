@@ -67,17 +67,22 @@ const double Neck_ScanPlayers::INVALID_ANGLE = -360.0;
 bool
 Neck_ScanPlayers::execute( PlayerAgent * agent )
 {
-    static GameTime s_last_calc_time( 0, 0 );
-    static ViewWidth s_last_calc_view_width = ViewWidth::NORMAL;
-    static double s_last_calc_min_neck_angle = 0.0;
-    static double s_last_calc_max_neck_angle = 0.0;
-    static double s_cached_target_angle = 0.0;
-
-    if ( s_last_calc_time != agent->world().time()
+    // the cache is kept for each thread and each world model,
+    // because several agents may be executed in one process.
+    thread_local const WorldModel * s_last_world = static_cast< const WorldModel * >( 0 );
+    thread_local GameTime s_last_calc_time( 0, 0 );
+    thread_local ViewWidth s_last_calc_view_width = ViewWidth::NORMAL;
+    thread_local double s_last_calc_min_neck_angle = 0.0;
+    thread_local double s_last_calc_max_neck_angle = 0.0;
+    thread_local double s_cached_target_angle = 0.0;
+
+    if ( s_last_world != &agent->world()
+         || s_last_calc_time != agent->world().time()
          || s_last_calc_view_width != agent->effector().queuedNextViewWidth()
          || std::fabs( s_last_calc_min_neck_angle - M_min_neck_angle ) > 1.0e-3
          || std::fabs( s_last_calc_max_neck_angle - M_max_neck_angle ) > 1.0e-3 )
     {
+        s_last_world = &agent->world();
         s_last_calc_time = agent->world().time();
         s_last_calc_view_width = agent->effector().queuedNextViewWidth();
         s_last_calc_min_neck_angle = M_min_neck_angle;
@@ -102,6 +102,17 @@ struct CoachAgent::Impl {
     //! the flags for team_graphic ok message
     std::set< TeamGraphic::Index > team_graphic_ok_set_;
 
+    //! the number of team_graphic messages sent in team_graphic_send_time_
+    int team_graphic_send_count_;
+    //! the last time when team_graphic message is sent
+    GameTime team_graphic_send_time_;
+
+    //! true if server_param message has been received
+    bool server_param_received_;
+    //! true if player_param message has been received
+    bool player_param_received_;
+    //! the number of received player_type messages
+    int player_type_count_;
 
     //! freeform message queue
     std::vector< FreeformMessage::Ptr > freeform_messages_;
@@ -117,7 +128,12 @@ struct CoachAgent::Impl {
           think_received_( false ),
           server_cycle_stopped_( true ),
           last_decision_time_( -1, 0 ),
-          current_time_( 0, 0 )
+          current_time_( 0, 0 ),
+          team_graphic_send_count_( 0 ),
+          team_graphic_send_time_( -1, 0 ),
+          server_param_received_( false ),
+          player_param_received_( false ),
+          player_type_count_( 0 )
       { }
 
     /*!
@@ -739,6 +755,24 @@ CoachAgent::handleTimeout( const int timeout_count,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+CoachAgent::parametersReceived() const
+{
+    if ( config().version() < 7.0 )
+    {
+        // parameter messages are not sent to the old version client.
+        return true;
+    }
+
+    return ( M_impl->server_param_received_
+             && M_impl->player_param_received_
+             && M_impl->player_type_count_ >= PlayerParam::i().playerTypes() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 CoachAgent::handleExit()
@@ -876,7 +910,14 @@ CoachAgent::Impl::openDebugLog()
     filepath += "-coach";
     filepath += agent_.config().debugLogExt();
 
-    dlog.open( filepath );
+    if ( agent_.config().debugLogBinary() )
+    {
+        dlog.openBinary( filepath );
+    }
+    else
+    {
+        dlog.open( filepath );
+    }
 
     if ( ! dlog.isOpen() )
     {
@@ -1370,6 +1411,7 @@ CoachAgent::Impl::analyzePlayerType( const char * msg )
 {
     PlayerType player_type( msg, agent_.config().version() );
     PlayerTypeSet::instance().insert( player_type );
+    ++player_type_count_;
 
     agent_.handlePlayerType();
 }
@@ -1382,6 +1424,7 @@ void
 CoachAgent::Impl::analyzePlayerParam( const char * msg )
 {
     PlayerParam::instance().parse( msg, agent_.config().version() );
+    player_param_received_ = true;
     //PlayerParam::i().print( std::cout );
 
     agent_.M_worldmodel.setPlayerParam();
@@ -1396,6 +1439,7 @@ void
 CoachAgent::Impl::analyzeServerParam( const char * msg )
 {
     ServerParam::instance().parse( msg, agent_.config().version() );
+    server_param_received_ = true;
     PlayerTypeSet::instance().resetDefaultType();
 
     if ( ! ServerParam::i().synchMode()
@@ -2107,18 +2151,15 @@ CoachAgent::doTeamGraphic( const int x,
                            const int y,
                            const TeamGraphic & team_graphic )
 {
-    static int send_count = 0;
-    static GameTime send_time( -1, 0 );
-
-    if ( send_time != M_impl->current_time_ )
+    if ( M_impl->team_graphic_send_time_ != M_impl->current_time_ )
     {
-        send_count = 0;
+        M_impl->team_graphic_send_count_ = 0;
     }
 
-    send_time = M_impl->current_time_;
-    ++send_count;
+    M_impl->team_graphic_send_time_ = M_impl->current_time_;
+    ++M_impl->team_graphic_send_count_;
 
-    if ( send_count > config().maxTeamGraphicPerCycle() ) // XXX Magic Number
+    if ( M_impl->team_graphic_send_count_ > config().maxTeamGraphicPerCycle() ) // XXX Magic Number
     {
         return false;
     }
@@ -314,6 +314,13 @@ protected:
     virtual
     void handleExit();
 
+    /*!
+      \brief check if the parameter messages have been received.
+      \return true if server_param, player_param and all player_type messages have been received.
+    */
+    virtual
+    bool parametersReceived() const;
+
     //
     //
     //
@@ -127,6 +127,7 @@ CoachConfig::setDefaultParam()
     //
 
     M_debug_log_ext = ".log";
+    M_debug_log_binary = false;
 
     M_debug_system = false;
     M_debug_sensor = false;
@@ -201,6 +202,8 @@ CoachConfig::createParamMap()
         ( "offline_client_mode", "", BoolSwitch( &M_offline_client_mode ) )
 
         ( "debug_log_ext", "", &M_debug_log_ext )
+        ( "debug_log_binary", "", BoolSwitch( &M_debug_log_binary ),
+          "record the debug log in the binary format. use rcsclog2txt to convert it." )
 
         ( "debug_system", "", BoolSwitch( &M_debug_system ) )
         ( "debug_sensor", "", BoolSwitch( &M_debug_sensor ) )
@@ -135,6 +135,8 @@ private:
 
     //! the extension string of debug log file
     std::string M_debug_log_ext;
+    //! if true, the debug log is recorded in the binary format
+    bool M_debug_log_binary;
 
     // debug output switches
     bool M_debug_system; //!< debug level flag
@@ -390,6 +392,12 @@ public:
      */
     const std::string & debugLogExt() const { return M_debug_log_ext; }
 
+    /*!
+      \brief check if the debug log is recorded in the binary format.
+      \return true if the binary format is used.
+     */
+    bool debugLogBinary() const { return M_debug_log_binary; }
+
     /*!
       \brief get the debug flag
       \return debug flag
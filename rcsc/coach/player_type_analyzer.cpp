@@ -99,7 +99,8 @@ PlayerTypeAnalyzer::Data::setUnknownType()
 PlayerTypeAnalyzer::PlayerTypeAnalyzer( const CoachWorldModel & world )
     : M_world( world ),
       M_updated_time( -1, 0 ),
-      M_playmode( PM_BeforeKickOff )
+      M_playmode( PM_BeforeKickOff ),
+      M_max_kickable_area2( -1.0 )
 {
 
 }
@@ -722,8 +723,6 @@ PlayerTypeAnalyzer::checkCollisions()
 void
 PlayerTypeAnalyzer::checkKick()
 {
-    static double S_max_kickable_area2 = -1.0;
-
     for ( int i = 0; i < 11; ++i )
     {
         M_opponent_data[i].kicked_ = false;
@@ -734,7 +733,7 @@ PlayerTypeAnalyzer::checkKick()
 
     const int max_types = PlayerParam::i().playerTypes();
 
-    if ( S_max_kickable_area2 < 0.0 )
+    if ( M_max_kickable_area2 < 0.0 )
     {
         for ( int t = 0; t < max_types; ++t )
         {
@@ -742,9 +741,9 @@ PlayerTypeAnalyzer::checkKick()
             if ( ! player_type ) continue;
 
             double k2 = std::pow( player_type->kickableArea(), 2 );
-            if ( k2 > S_max_kickable_area2 )
+            if ( k2 > M_max_kickable_area2 )
             {
-                S_max_kickable_area2 = k2;
+                M_max_kickable_area2 = k2;
             }
         }
     }
@@ -837,7 +836,7 @@ PlayerTypeAnalyzer::checkKick()
                  && M_teammate_data[i].pos_.isValid() )
             {
                 if ( M_prev_ball.pos().dist2( M_teammate_data[i].pos_ )
-                     < S_max_kickable_area2 )
+                     < M_max_kickable_area2 )
                 {
                     M_teammate_data[i].maybe_kick_ = true;
                     ++count;
@@ -849,7 +848,7 @@ PlayerTypeAnalyzer::checkKick()
                  && M_opponent_data[i].pos_.isValid() )
             {
                 if ( M_prev_ball.pos().dist2( M_opponent_data[i].pos_ )
-                     < S_max_kickable_area2 )
+                     < M_max_kickable_area2 )
                 {
                     M_opponent_data[i].maybe_kick_ = true;
                     ++count;
@@ -83,6 +83,8 @@ private:
 
     std::vector< int > M_opponent_type_used_count;
 
+    double M_max_kickable_area2; //!< squared max kickable area of all types. negative if not calculated.
+
     //! not used
     PlayerTypeAnalyzer();
     //! not used
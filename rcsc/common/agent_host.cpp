@@ -0,0 +1,415 @@
+// -*-c++-*-
+
+/*!
+  \file agent_host.cpp
+  \brief runtime that executes several agents in one process Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "agent_host.h"
+
+#include <rcsc/common/logger.h>
+#include <rcsc/common/online_client.h>
+#include <rcsc/common/soccer_agent.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace rcsc {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the elapsed milli seconds
+*/
+inline
+int
+elapsed_msec( const Clock::time_point & from,
+              const Clock::time_point & to )
+{
+    return static_cast< int >( std::chrono::duration_cast< std::chrono::milliseconds >
+                               ( to - from ).count() );
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct AgentHost::Context
+  \brief the state of each agent
+*/
+struct AgentHost::Context {
+
+    SoccerAgent * agent_; //!< agent instance
+    boost::shared_ptr< OnlineClient > client_; //!< connection of the agent
+    Logger logger_; //!< dlog of the agent. swapped while the agent is executed.
+
+    //! true while an event is queued or executed. set by the event thread, reset by the worker.
+    std::atomic< bool > busy_;
+    //! true after handleExit(). written by the thread that executed the last event.
+    bool finished_;
+
+    //
+    // the following members are used only by the event thread
+    //
+    Clock::time_point last_event_time_; //!< the time of the last event
+    int timeout_count_; //!< the number of timeouts without any message
+    int waited_msec_; //!< elapsed milli seconds since the last message
+
+    explicit
+    Context( SoccerAgent * agent )
+        : agent_( agent ),
+          busy_( false ),
+          finished_( false ),
+          timeout_count_( 0 ),
+          waited_msec_( 0 )
+      { }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+AgentHost::AgentHost( const std::size_t n_threads )
+    : M_pool( n_threads )
+{
+    M_wakeup_pipe[0] = M_wakeup_pipe[1] = -1;
+
+    if ( ::pipe( M_wakeup_pipe ) == 0 )
+    {
+        ::fcntl( M_wakeup_pipe[0], F_SETFL, O_NONBLOCK );
+        ::fcntl( M_wakeup_pipe[1], F_SETFL, O_NONBLOCK );
+    }
+    else
+    {
+        std::perror( "(AgentHost) pipe" );
+        M_wakeup_pipe[0] = M_wakeup_pipe[1] = -1;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+AgentHost::~AgentHost()
+{
+    M_pool.wait();
+
+    if ( M_wakeup_pipe[0] != -1 ) ::close( M_wakeup_pipe[0] );
+    if ( M_wakeup_pipe[1] != -1 ) ::close( M_wakeup_pipe[1] );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+AgentHost::addAgent( SoccerAgent * agent,
+                     CmdLineParser & cmd_parser )
+{
+    if ( ! agent )
+    {
+        return false;
+    }
+
+    std::unique_ptr< Context > context( new Context( agent ) );
+
+    dlog.swap( context->logger_ );
+
+    bool result = agent->init( cmd_parser );
+    if ( result )
+    {
+        boost::shared_ptr< AbstractClient > client = agent->createConsoleClient();
+        context->client_ = boost::dynamic_pointer_cast< OnlineClient >( client );
+        if ( context->client_ )
+        {
+            agent->setClient( client );
+        }
+        else
+        {
+            std::cerr << "(AgentHost::addAgent) only the online client is supported."
+                      << std::endl;
+            result = false;
+        }
+    }
+
+    dlog.swap( context->logger_ );
+
+    if ( result )
+    {
+        M_contexts.push_back( std::move( context ) );
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AgentHost::run()
+{
+    if ( M_wakeup_pipe[0] == -1 )
+    {
+        std::cerr << "(AgentHost::run) no wakeup pipe." << std::endl;
+        return;
+    }
+
+    //
+    // start all agents in this thread
+    //
+    for ( std::unique_ptr< Context > & c : M_contexts )
+    {
+        dlog.swap( c->logger_ );
+
+        if ( ! c->agent_->handleStart()
+             || ! c->client_->isServerAlive()
+             || c->client_->socketFD() == -1 )
+        {
+            c->agent_->handleExit();
+            c->finished_ = true;
+        }
+
+        dlog.swap( c->logger_ );
+
+        c->last_event_time_ = Clock::now();
+    }
+
+    // the events are executed serially until all parameters are received.
+    bool serial = true;
+
+    std::vector< struct pollfd > fds;
+    std::vector< Context * > polled;
+    fds.reserve( M_contexts.size() + 1 );
+    polled.reserve( M_contexts.size() );
+
+    while ( true )
+    {
+        //
+        // collect the idle agents, and the time to the next timeout
+        //
+        Clock::time_point now = Clock::now();
+
+        fds.clear();
+        polled.clear();
+
+        struct pollfd wakeup;
+        wakeup.fd = M_wakeup_pipe[0];
+        wakeup.events = POLLIN;
+        wakeup.revents = 0;
+        fds.push_back( wakeup );
+
+        bool running = false;
+        int wait_msec = -1;
+
+        for ( std::unique_ptr< Context > & c : M_contexts )
+        {
+            if ( c->busy_.load( std::memory_order_acquire ) )
+            {
+                running = true;
+                continue;
+            }
+
+            if ( c->finished_ )
+            {
+                continue;
+            }
+
+            struct pollfd pfd;
+            pfd.fd = c->client_->socketFD();
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            fds.push_back( pfd );
+            polled.push_back( c.get() );
+
+            const int remaining = std::max( 0, c->client_->intervalMSec()
+                                            - elapsed_msec( c->last_event_time_, now ) );
+            wait_msec = ( wait_msec < 0
+                          ? remaining
+                          : std::min( wait_msec, remaining ) );
+        }
+
+        if ( polled.empty()
+             && ! running )
+        {
+            break;
+        }
+
+        //
+        // wait the messages, the finished events or the next timeout
+        //
+        const int n = ::poll( &fds[0], fds.size(), wait_msec );
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            std::perror( "(AgentHost::run) poll" );
+            break;
+        }
+
+        if ( fds[0].revents & POLLIN )
+        {
+            char buf[64];
+            while ( ::read( M_wakeup_pipe[0], buf, sizeof( buf ) ) > 0 )
+            {
+            }
+        }
+
+        now = Clock::now();
+        if ( serial )
+        {
+            // no event is executed by the workers in the serial mode
+            serial = ! allParametersReceived();
+        }
+
+        for ( std::size_t i = 0; i < polled.size(); ++i )
+        {
+            Context * c = polled[i];
+
+            if ( fds[i + 1].revents & ( POLLIN | POLLERR ) )
+            {
+                // received message, reset wait time
+                c->last_event_time_ = now;
+                c->waited_msec_ = 0;
+                c->timeout_count_ = 0;
+                dispatch( c, false, serial );
+            }
+            else if ( elapsed_msec( c->last_event_time_, now ) >= c->client_->intervalMSec() )
+            {
+                // no meesage. timeout.
+                c->last_event_time_ = now;
+                c->waited_msec_ += c->client_->intervalMSec();
+                ++c->timeout_count_;
+                dispatch( c, true, serial );
+            }
+        }
+    }
+
+    M_pool.wait();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+AgentHost::allParametersReceived() const
+{
+    for ( const std::unique_ptr< Context > & c : M_contexts )
+    {
+        if ( ! c->finished_
+             && ! c->agent_->parametersReceived() )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AgentHost::dispatch( Context * context,
+                     const bool timeout,
+                     const bool serial )
+{
+    const int timeout_count = context->timeout_count_;
+    const int waited_msec = context->waited_msec_;
+
+    if ( serial )
+    {
+        handle( context, timeout, timeout_count, waited_msec );
+        return;
+    }
+
+    const int wakeup_fd = M_wakeup_pipe[1];
+
+    context->busy_.store( true, std::memory_order_relaxed );
+    M_pool.submit( [context, timeout, timeout_count, waited_msec, wakeup_fd]()
+                   {
+                       handle( context, timeout, timeout_count, waited_msec );
+                       context->busy_.store( false, std::memory_order_release );
+
+                       const char c = 0;
+                       if ( ::write( wakeup_fd, &c, 1 ) < 0 )
+                       {
+                           // the pipe is full. the event thread is already woken up.
+                       }
+                   } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+AgentHost::handle( Context * context,
+                   const bool timeout,
+                   const int timeout_count,
+                   const int waited_msec )
+{
+    dlog.swap( context->logger_ );
+
+    if ( timeout )
+    {
+        context->agent_->handleTimeout( timeout_count, waited_msec );
+    }
+    else
+    {
+        context->agent_->handleMessage();
+    }
+
+    if ( ! context->client_->isServerAlive() )
+    {
+        context->agent_->handleExit();
+        context->finished_ = true;
+    }
+
+    dlog.swap( context->logger_ );
+}
+
+}
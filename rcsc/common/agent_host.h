@@ -0,0 +1,157 @@
+// -*-c++-*-
+
+/*!
+  \file agent_host.h
+  \brief runtime that executes several agents in one process Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_AGENT_HOST_H
+#define RCSC_COMMON_AGENT_HOST_H
+
+#include <rcsc/thread_pool.h>
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+class CmdLineParser;
+class SoccerAgent;
+
+/*!
+  \class AgentHost
+  \brief executes several agents, e.g. all players and the coach of a team, in one process.
+
+  Each agent has its own OnlineClient. One event thread waits all
+  connections by poll(), and the events of each agent are executed by
+  the thread pool. The events of the same agent are never executed at
+  the same time, and they are executed in the received order.
+
+  The process wide tables, i.e. ServerParam, PlayerParam, PlayerTypeSet
+  and the tables of KickTable, are shared by all agents. rcssserver sends
+  the same parameters to all clients just after the connection, so the
+  events are executed serially in the event thread until every agent
+  reports SoccerAgent::parametersReceived(). The debug logger (dlog) is switched to the logger of each agent
+  while its event is executed.
+
+  The agents have to be allocated by the caller, and they have to be alive
+  until run() returns.
+*/
+class AgentHost {
+private:
+
+    struct Context;
+
+    //! registered agents
+    std::vector< std::unique_ptr< Context > > M_contexts;
+
+    //! workers that execute the agent events
+    ThreadPool M_pool;
+
+    //! pipe to wake the event thread up when an event is finished
+    int M_wakeup_pipe[2];
+
+    // noncopyable
+    AgentHost( const AgentHost & );
+    AgentHost & operator=( const AgentHost & );
+
+public:
+
+    /*!
+      \brief create the thread pool
+      \param n_threads the number of workers. if 0, the number of hardware threads is used.
+     */
+    explicit
+    AgentHost( const std::size_t n_threads = 0 );
+
+    /*!
+      \brief close the wakeup pipe
+     */
+    ~AgentHost();
+
+    /*!
+      \brief initialize the agent with the command line options, and register it.
+      The agent's own logger is used during the initialization.
+      \param agent pointer to the agent instance
+      \param cmd_parser command line parser for this agent
+      \return false if the initialization failed or the agent does not use OnlineClient.
+     */
+    bool addAgent( SoccerAgent * agent,
+                   CmdLineParser & cmd_parser );
+
+    /*!
+      \brief get the number of registered agents
+      \return the number of registered agents
+     */
+    std::size_t agentSize() const
+      {
+          return M_contexts.size();
+      }
+
+    /*!
+      \brief start all agents, and handle their events until all servers are dead.
+      handleExit() of each agent is called when its server is not alive.
+     */
+    void run();
+
+private:
+
+    /*!
+      \brief check if all running agents have received the parameter messages
+      \return true if the events can be executed in parallel.
+      This method must be called only while no event is executed by the workers.
+     */
+    bool allParametersReceived() const;
+
+    /*!
+      \brief queue the event of the agent
+      \param context agent context
+      \param timeout if true, the timeout event is handled. otherwise, the message event is handled.
+      \param serial if true, the event is executed in the current thread.
+     */
+    void dispatch( Context * context,
+                   const bool timeout,
+                   const bool serial );
+
+    /*!
+      \brief execute the event of the agent with its logger
+      \param context agent context
+      \param timeout if true, the timeout event is handled. otherwise, the message event is handled.
+      \param timeout_count count of timeout without sensory message
+      \param waited_msec elapsed milli seconds sinc last sensory message
+     */
+    static
+    void handle( Context * context,
+                 const bool timeout,
+                 const int timeout_count,
+                 const int waited_msec );
+};
+
+}
+
+#endif
@@ -0,0 +1,725 @@
+// -*-c++-*-
+
+/*!
+  \file binary_log_buffer.cpp
+  \brief asynchronous binary debug log buffer Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "binary_log_buffer.h"
+
+#include <rcsc/game_time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+
+namespace rcsc {
+
+namespace {
+
+//! wait time of the writer thread [ms]
+const int WRITER_INTERVAL_MSEC = 20;
+
+static_assert( sizeof( BinaryLogBuffer::RecordHeader ) == 24,
+               "unexpected record header size" );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief round up the size to the record alignment
+ */
+inline
+std::size_t
+align_size( const std::size_t size )
+{
+    return ( size + BinaryLogBuffer::RECORD_ALIGN - 1 )
+        & ~static_cast< std::size_t >( BinaryLogBuffer::RECORD_ALIGN - 1 );
+}
+
+}
+
+const char BinaryLogBuffer::MAGIC[8] = { 'R', 'C', 'S', 'C', 'B', 'L', 'O', 'G' };
+const boost::uint32_t BinaryLogBuffer::FILE_VERSION;
+const boost::uint32_t BinaryLogBuffer::BYTE_ORDER_MARK;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BinaryLogBuffer::BinaryLogBuffer( FILE * fout,
+                                  const std::size_t capacity )
+    : M_fout( fout ),
+      M_data( align_size( std::max( capacity, static_cast< std::size_t >( 4096 ) ) ) ),
+      M_head( 0 ),
+      M_tail( 0 ),
+      M_dropped( 0 ),
+      M_format_count( 0 )
+{
+    M_record.reserve( 1024 );
+
+    if ( M_fout )
+    {
+        std::fwrite( MAGIC, 1, sizeof( MAGIC ), M_fout );
+        std::fwrite( &FILE_VERSION, sizeof( FILE_VERSION ), 1, M_fout );
+        std::fwrite( &BYTE_ORDER_MARK, sizeof( BYTE_ORDER_MARK ), 1, M_fout );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::parse_format( const char * format,
+                               std::vector< FormatSpec > * specs )
+{
+    specs->clear();
+
+    FormatSpec spec;
+    const char * p = format;
+
+    while ( *p != '\0' )
+    {
+        if ( *p != '%' )
+        {
+            spec.text_ += *p++;
+            continue;
+        }
+
+        if ( *(p + 1) == '%' )
+        {
+            spec.text_ += "%%";
+            p += 2;
+            continue;
+        }
+
+        //
+        // %[flags][width][.precision][length]conversion
+        //
+        const char * q = p + 1;
+        int stars = 0;
+
+        while ( *q != '\0' && std::strchr( "-+ #0'", *q ) ) ++q;
+
+        if ( *q == '*' ) { ++stars; ++q; }
+        else while ( '0' <= *q && *q <= '9' ) ++q;
+
+        if ( *q == '.' )
+        {
+            ++q;
+            if ( *q == '*' ) { ++stars; ++q; }
+            else while ( '0' <= *q && *q <= '9' ) ++q;
+        }
+
+        const char * length = q;
+        while ( *q != '\0' && std::strchr( "hlLjztq", *q ) ) ++q;
+        const std::string length_str( length, q );
+
+        const char conversion = *q;
+        ArgType type = ARG_NONE;
+
+        if ( conversion != '\0' && std::strchr( "diouxX", conversion ) )
+        {
+            type = ( length_str == "l" ? ARG_LONG
+                     : length_str == "ll" || length_str == "q" ? ARG_LONG_LONG
+                     : length_str == "j" ? ARG_INTMAX
+                     : length_str == "z" ? ARG_SIZE
+                     : length_str == "t" ? ARG_PTRDIFF
+                     : ARG_INT );
+        }
+        else if ( conversion == 'c' )
+        {
+            type = ARG_CHAR;
+        }
+        else if ( conversion != '\0' && std::strchr( "fFeEgGaA", conversion ) )
+        {
+            type = ( length_str == "L" ? ARG_LONG_DOUBLE : ARG_DOUBLE );
+        }
+        else if ( conversion == 's' )
+        {
+            type = ARG_STRING;
+        }
+        else if ( conversion == 'p' )
+        {
+            type = ARG_POINTER;
+        }
+        else if ( conversion == 'n' )
+        {
+            type = ARG_COUNT;
+        }
+        else
+        {
+            // unknown conversion. printed as a literal.
+            spec.text_ += "%%";
+            ++p;
+            continue;
+        }
+
+        if ( type != ARG_COUNT )
+        {
+            // all integers are recorded as 64 bits, and all floating points as double.
+            spec.text_.append( p, length );
+            if ( type != ARG_CHAR
+                 && type != ARG_DOUBLE
+                 && type != ARG_LONG_DOUBLE
+                 && type != ARG_STRING
+                 && type != ARG_POINTER )
+            {
+                spec.text_ += "ll";
+            }
+            spec.text_ += conversion;
+        }
+
+        spec.type_ = type;
+        spec.stars_ = stars;
+        specs->push_back( spec );
+
+        spec = FormatSpec();
+        p = q + 1;
+    }
+
+    if ( ! spec.text_.empty() )
+    {
+        specs->push_back( spec );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const BinaryLogBuffer::Format *
+BinaryLogBuffer::registerFormat( const char * format )
+{
+    std::unordered_map< const char *, Format >::iterator it = M_formats.find( format );
+    if ( it != M_formats.end()
+         && it->second.text_ == format )
+    {
+        return &it->second;
+    }
+
+    // new format, or the content of the address has been changed.
+    Format f;
+    f.id_ = M_format_count;
+    f.text_ = format;
+    parse_format( format, &f.specs_ );
+
+    M_record.clear();
+    RecordHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    header.kind_ = FORMAT;
+    header.format_id_ = f.id_;
+    append( &header, sizeof( header ) );
+    appendString( format );
+
+    // the text records cannot be decoded without the definition.
+    // the format is registered only if the definition is recorded.
+    commitRecord();
+    if ( M_dropped > 0 )
+    {
+        return static_cast< const Format * >( 0 );
+    }
+
+    ++M_format_count;
+    Format & registered = M_formats[format];
+    registered = f;
+    return &registered;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::beginRecord( const char kind,
+                              const boost::int32_t level,
+                              const GameTime & time )
+{
+    RecordHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    header.kind_ = static_cast< boost::uint8_t >( kind );
+    header.level_ = level;
+    header.cycle_ = static_cast< boost::int32_t >( time.cycle() );
+    header.stopped_ = static_cast< boost::int32_t >( time.stopped() );
+
+    M_record.clear();
+    append( &header, sizeof( header ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::append( const void * data,
+                         const std::size_t size )
+{
+    const char * ptr = static_cast< const char * >( data );
+    M_record.insert( M_record.end(), ptr, ptr + size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::appendString( const char * str )
+{
+    if ( ! str )
+    {
+        str = "(null)";
+    }
+
+    const boost::uint16_t len
+        = static_cast< boost::uint16_t >( std::min( std::strlen( str ),
+                                                    static_cast< std::size_t >( MAX_STRING_LENGTH ) ) );
+    appendValue( len );
+    append( str, len );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::appendColor( const char * color )
+{
+    RecordHeader * header = reinterpret_cast< RecordHeader * >( &M_record[0] );
+    if ( color )
+    {
+        header->color_type_ = NAMED_COLOR;
+        appendString( color );
+    }
+    else
+    {
+        header->color_type_ = NO_COLOR;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::appendColor( const int r, const int g, const int b )
+{
+    RecordHeader * header = reinterpret_cast< RecordHeader * >( &M_record[0] );
+    header->color_type_ = RGB_COLOR;
+
+    const boost::uint8_t rgb[3] = { static_cast< boost::uint8_t >( r ),
+                                    static_cast< boost::uint8_t >( g ),
+                                    static_cast< boost::uint8_t >( b ) };
+    append( rgb, sizeof( rgb ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::commitRecord()
+{
+    const std::size_t size = align_size( M_record.size() );
+    M_record.resize( size, 0 );
+
+    RecordHeader * header = reinterpret_cast< RecordHeader * >( &M_record[0] );
+    header->size_ = static_cast< boost::uint32_t >( size );
+
+    if ( M_dropped > 0 )
+    {
+        RecordHeader dropped = *header;
+        dropped.size_ = sizeof( RecordHeader );
+        dropped.kind_ = DROPPED;
+        dropped.color_type_ = 0;
+        dropped.value_count_ = 0;
+        dropped.format_id_ = M_dropped;
+
+        if ( ! push( reinterpret_cast< const char * >( &dropped ), sizeof( dropped ) ) )
+        {
+            ++M_dropped;
+            return;
+        }
+        M_dropped = 0;
+    }
+
+    if ( ! push( &M_record[0], size ) )
+    {
+        ++M_dropped;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+BinaryLogBuffer::push( const char * data,
+                       const std::size_t size )
+{
+    const std::size_t capacity = M_data.size();
+    std::size_t head = M_head.load( std::memory_order_relaxed );
+    const std::size_t tail = M_tail.load( std::memory_order_acquire );
+
+    std::size_t pos = head % capacity;
+    const std::size_t contiguous = capacity - pos;
+    const std::size_t required = ( contiguous < size ? contiguous + size : size );
+
+    if ( size > capacity / 2
+         || capacity - ( head - tail ) < required )
+    {
+        BinaryLogWriter::instance().notify();
+        return false;
+    }
+
+    if ( contiguous < size )
+    {
+        // the record is never split. skip the end of the buffer.
+        RecordHeader padding;
+        std::memset( &padding, 0, sizeof( padding ) );
+        padding.size_ = static_cast< boost::uint32_t >( contiguous );
+        padding.kind_ = PADDING;
+        std::memcpy( &M_data[pos], &padding, std::min( contiguous, sizeof( padding ) ) );
+
+        head += contiguous;
+        pos = 0;
+    }
+
+    std::memcpy( &M_data[pos], data, size );
+    M_head.store( head + size, std::memory_order_release );
+
+    if ( head + size - tail > capacity / 2 )
+    {
+        BinaryLogWriter::instance().notify();
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::addText( const boost::int32_t level,
+                          const GameTime & time,
+                          const char * format,
+                          va_list args )
+{
+    const Format * f = registerFormat( format );
+    if ( ! f )
+    {
+        return;
+    }
+
+    beginRecord( TEXT, level, time );
+    reinterpret_cast< RecordHeader * >( &M_record[0] )->format_id_ = f->id_;
+
+    for ( const FormatSpec & spec : f->specs_ )
+    {
+        for ( int i = 0; i < spec.stars_; ++i )
+        {
+            appendValue( static_cast< boost::int64_t >( va_arg( args, int ) ) );
+        }
+
+        switch ( spec.type_ ) {
+        case ARG_NONE:
+            break;
+        case ARG_INT:
+        case ARG_CHAR:
+            appendValue( static_cast< boost::int64_t >( va_arg( args, int ) ) );
+            break;
+        case ARG_LONG:
+            appendValue( static_cast< boost::int64_t >( va_arg( args, long ) ) );
+            break;
+        case ARG_LONG_LONG:
+            appendValue( static_cast< boost::int64_t >( va_arg( args, long long ) ) );
+            break;
+        case ARG_INTMAX:
+            appendValue( static_cast< boost::int64_t >( va_arg( args, std::intmax_t ) ) );
+            break;
+        case ARG_SIZE:
+            appendValue( static_cast< boost::int64_t >( va_arg( args, std::size_t ) ) );
+            break;
+        case ARG_PTRDIFF:
+            appendValue( static_cast< boost::int64_t >( va_arg( args, std::ptrdiff_t ) ) );
+            break;
+        case ARG_DOUBLE:
+            appendValue( va_arg( args, double ) );
+            break;
+        case ARG_LONG_DOUBLE:
+            appendValue( static_cast< double >( va_arg( args, long double ) ) );
+            break;
+        case ARG_STRING:
+            appendString( va_arg( args, const char * ) );
+            break;
+        case ARG_POINTER:
+            appendValue( static_cast< boost::uint64_t >
+                         ( reinterpret_cast< std::uintptr_t >( va_arg( args, void * ) ) ) );
+            break;
+        case ARG_COUNT:
+            va_arg( args, void * );
+            break;
+        default:
+            break;
+        }
+    }
+
+    commitRecord();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::addShape( const char type,
+                           const boost::int32_t level,
+                           const GameTime & time,
+                           const double * values,
+                           const int count,
+                           const char * color )
+{
+    beginRecord( type, level, time );
+    reinterpret_cast< RecordHeader * >( &M_record[0] )->value_count_ = static_cast< boost::uint8_t >( count );
+    append( values, sizeof( double ) * count );
+    appendColor( color );
+    commitRecord();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::addShape( const char type,
+                           const boost::int32_t level,
+                           const GameTime & time,
+                           const double * values,
+                           const int count,
+                           const int r, const int g, const int b )
+{
+    beginRecord( type, level, time );
+    reinterpret_cast< RecordHeader * >( &M_record[0] )->value_count_ = static_cast< boost::uint8_t >( count );
+    append( values, sizeof( double ) * count );
+    appendColor( r, g, b );
+    commitRecord();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::addMessage( const boost::int32_t level,
+                             const GameTime & time,
+                             const double x,
+                             const double y,
+                             const char * msg,
+                             const char * color )
+{
+    beginRecord( MESSAGE, level, time );
+    reinterpret_cast< RecordHeader * >( &M_record[0] )->value_count_ = 2;
+    appendValue( x );
+    appendValue( y );
+    appendColor( color );
+    appendString( msg );
+    commitRecord();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogBuffer::addMessage( const boost::int32_t level,
+                             const GameTime & time,
+                             const double x,
+                             const double y,
+                             const char * msg,
+                             const int r, const int g, const int b )
+{
+    beginRecord( MESSAGE, level, time );
+    reinterpret_cast< RecordHeader * >( &M_record[0] )->value_count_ = 2;
+    appendValue( x );
+    appendValue( y );
+    appendColor( r, g, b );
+    appendString( msg );
+    commitRecord();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+BinaryLogBuffer::drain()
+{
+    const std::size_t capacity = M_data.size();
+    std::size_t tail = M_tail.load( std::memory_order_relaxed );
+    const std::size_t head = M_head.load( std::memory_order_acquire );
+
+    std::size_t written = 0;
+
+    while ( tail != head )
+    {
+        // write the contiguous records at once
+        const std::size_t begin = tail % capacity;
+        std::size_t end = begin;
+
+        while ( tail != head
+                && end < capacity )
+        {
+            RecordHeader header;
+            std::memcpy( &header, &M_data[end], std::min( capacity - end, sizeof( header ) ) );
+
+            if ( header.kind_ == PADDING )
+            {
+                tail += header.size_;
+                break;
+            }
+
+            end += header.size_;
+            tail += header.size_;
+        }
+
+        if ( end > begin )
+        {
+            if ( M_fout )
+            {
+                std::fwrite( &M_data[begin], 1, end - begin, M_fout );
+            }
+            written += end - begin;
+        }
+    }
+
+    M_tail.store( tail, std::memory_order_release );
+
+    if ( written > 0
+         && M_fout )
+    {
+        std::fflush( M_fout );
+    }
+
+    return written;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BinaryLogWriter::BinaryLogWriter()
+    : M_stop( false ),
+      M_thread( [this]() { run(); } )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BinaryLogWriter::~BinaryLogWriter()
+{
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_stop = true;
+    }
+    M_cond.notify_one();
+    M_thread.join();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BinaryLogWriter &
+BinaryLogWriter::instance()
+{
+    static BinaryLogWriter s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogWriter::add( BinaryLogBuffer * buffer )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+    M_buffers.push_back( buffer );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogWriter::remove( BinaryLogBuffer * buffer )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    std::vector< BinaryLogBuffer * >::iterator it
+        = std::find( M_buffers.begin(), M_buffers.end(), buffer );
+    if ( it != M_buffers.end() )
+    {
+        M_buffers.erase( it );
+    }
+
+    buffer->drain();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+BinaryLogWriter::run()
+{
+    std::unique_lock< std::mutex > lock( M_mutex );
+
+    while ( true )
+    {
+        for ( BinaryLogBuffer * b : M_buffers )
+        {
+            b->drain();
+        }
+
+        if ( M_stop )
+        {
+            break;
+        }
+
+        M_cond.wait_for( lock, std::chrono::milliseconds( WRITER_INTERVAL_MSEC ) );
+    }
+}
+
+}
@@ -0,0 +1,408 @@
+// -*-c++-*-
+
+/*!
+  \file binary_log_buffer.h
+  \brief asynchronous binary debug log buffer Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_BINARY_LOG_BUFFER_H
+#define RCSC_COMMON_BINARY_LOG_BUFFER_H
+
+#include <boost/cstdint.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+
+namespace rcsc {
+
+class GameTime;
+
+/*!
+  \class BinaryLogBuffer
+  \brief lock-free ring buffer of the binary debug log records.
+
+  The logger thread appends a compact record that contains the raw values,
+  i.e. the level, the game time, the coordinates and the arguments of the
+  text format, and a format id instead of the formatted text. The records
+  are written to the file by BinaryLogWriter in the background, and they
+  are converted to the text format by BinaryLogReader.
+
+  Only one thread can append the records at the same time. If the ring
+  buffer is full, the record is dropped and the number of dropped records
+  is recorded instead.
+
+  File Format:
+  File := <Magic:8> <Version:uint32> <ByteOrder:uint32> <Record>*
+  Record := <RecordHeader> <Payload> <Padding to 8 bytes>
+  Text Payload := (<StarArg:int64>* <Arg>)* for each conversion in the format
+  Shape Payload := <Value:double>* <Color>
+  Message Payload := <x:double> <y:double> <Color> <Str>
+  Format Payload := <Str>
+  Color := none | <Str> | <r:uint8> <g:uint8> <b:uint8>
+  Str := <Length:uint16> <Char>*
+*/
+class BinaryLogBuffer {
+public:
+
+    //! record kinds other than the shape types of Logger
+    enum RecordKind {
+        PADDING = 0, //!< skipped space at the end of the ring buffer
+        FORMAT = 'F', //!< definition of the text format
+        TEXT = 'M', //!< text message
+        MESSAGE = 'm', //!< message painted on the field
+        DROPPED = 'X', //!< the number of dropped records
+    };
+
+    //! color types of the shape records
+    enum ColorType {
+        NO_COLOR = 0,
+        NAMED_COLOR = 1,
+        RGB_COLOR = 2,
+    };
+
+    //! argument types of the text format
+    enum ArgType {
+        ARG_NONE, //!< no argument
+        ARG_INT, //!< int or shorter integer
+        ARG_LONG, //!< long
+        ARG_LONG_LONG, //!< long long
+        ARG_INTMAX, //!< intmax_t
+        ARG_SIZE, //!< size_t
+        ARG_PTRDIFF, //!< ptrdiff_t
+        ARG_CHAR, //!< character promoted to int
+        ARG_DOUBLE, //!< double
+        ARG_LONG_DOUBLE, //!< long double
+        ARG_STRING, //!< null terminated string
+        ARG_POINTER, //!< pointer value
+        ARG_COUNT, //!< %n. the argument is consumed but not recorded.
+    };
+
+    /*!
+      \struct FormatSpec
+      \brief a literal string followed by at most one conversion
+     */
+    struct FormatSpec {
+        //! literal and conversion. the length modifier is normalized for the converter.
+        std::string text_;
+        ArgType type_; //!< argument type of the conversion
+        int stars_; //!< the number of '*' width and precision arguments
+
+        FormatSpec()
+            : type_( ARG_NONE ),
+              stars_( 0 )
+          { }
+    };
+
+    /*!
+      \struct RecordHeader
+      \brief fixed size header of each record
+     */
+    struct RecordHeader {
+        boost::uint32_t size_; //!< record size including this header and padding
+        boost::uint8_t kind_; //!< RecordKind or shape type character
+        boost::uint8_t color_type_; //!< ColorType of the shape record
+        boost::uint8_t value_count_; //!< the number of double values of the shape record
+        boost::uint8_t reserved_; //!< not used
+        boost::int32_t level_; //!< log level
+        boost::int32_t cycle_; //!< game cycle
+        boost::int32_t stopped_; //!< stopped cycle
+        boost::uint32_t format_id_; //!< format id, or the number of dropped records
+    };
+
+    static const char MAGIC[8]; //!< file magic "RCSCBLOG"
+    static const boost::uint32_t FILE_VERSION = 1; //!< file format version
+    static const boost::uint32_t BYTE_ORDER_MARK = 0x01020304; //!< byte order mark
+
+    enum {
+        DEFAULT_CAPACITY = 4 * 1024 * 1024, //!< default ring buffer size [byte]
+        RECORD_ALIGN = 8, //!< record alignment [byte]
+        MAX_STRING_LENGTH = 0xffff, //!< max length of the recorded string
+    };
+
+private:
+
+    //! written by BinaryLogWriter
+    FILE * M_fout;
+
+    //! ring buffer
+    std::vector< char > M_data;
+
+    //! total bytes appended by the logger thread
+    std::atomic< std::size_t > M_head;
+    //! total bytes consumed by the writer thread
+    std::atomic< std::size_t > M_tail;
+
+    //
+    // the following members are used only by the logger thread
+    //
+
+    //! the number of records dropped since the last DROPPED record
+    boost::uint32_t M_dropped;
+
+    //! record under construction
+    std::vector< char > M_record;
+
+    /*!
+      \struct Format
+      \brief registered text format
+     */
+    struct Format {
+        boost::uint32_t id_; //!< format id
+        std::string text_; //!< format string
+        std::vector< FormatSpec > specs_; //!< parsed conversions
+    };
+
+    //! format string address -> registered format
+    std::unordered_map< const char *, Format > M_formats;
+
+    //! the next format id
+    boost::uint32_t M_format_count;
+
+    // noncopyable
+    BinaryLogBuffer( const BinaryLogBuffer & );
+    BinaryLogBuffer & operator=( const BinaryLogBuffer & );
+
+public:
+
+    /*!
+      \brief write the file header and allocate the ring buffer
+      \param fout output file. the file is not closed by this class.
+      \param capacity ring buffer size [byte]
+     */
+    BinaryLogBuffer( FILE * fout,
+                     const std::size_t capacity = DEFAULT_CAPACITY );
+
+    /*!
+      \brief get the output file
+      \return file pointer
+     */
+    FILE * file() const
+      {
+          return M_fout;
+      }
+
+    /*!
+      \brief append the text record
+      \param level log level
+      \param time game time
+      \param format printf style format string
+      \param args arguments of the format
+     */
+    void addText( const boost::int32_t level,
+                  const GameTime & time,
+                  const char * format,
+                  va_list args );
+
+    /*!
+      \brief append the shape record with the named color
+      \param type shape type character of Logger
+      \param level log level
+      \param time game time
+      \param values coordinates of the shape
+      \param count the number of values
+      \param color color name string. NULL means no color.
+     */
+    void addShape( const char type,
+                   const boost::int32_t level,
+                   const GameTime & time,
+                   const double * values,
+                   const int count,
+                   const char * color );
+
+    /*!
+      \brief append the shape record with the RGB color
+      \param type shape type character of Logger
+      \param level log level
+      \param time game time
+      \param values coordinates of the shape
+      \param count the number of values
+      \param r red value
+      \param g green value
+      \param b blue value
+     */
+    void addShape( const char type,
+                   const boost::int32_t level,
+                   const GameTime & time,
+                   const double * values,
+                   const int count,
+                   const int r, const int g, const int b );
+
+    /*!
+      \brief append the message record with the named color
+      \param level log level
+      \param time game time
+      \param x message position x
+      \param y message position y
+      \param msg message string
+      \param color color name string. NULL means no color.
+     */
+    void addMessage( const boost::int32_t level,
+                     const GameTime & time,
+                     const double x,
+                     const double y,
+                     const char * msg,
+                     const char * color );
+
+    /*!
+      \brief append the message record with the RGB color
+      \param level log level
+      \param time game time
+      \param x message position x
+      \param y message position y
+      \param msg message string
+      \param r red value
+      \param g green value
+      \param b blue value
+     */
+    void addMessage( const boost::int32_t level,
+                     const GameTime & time,
+                     const double x,
+                     const double y,
+                     const char * msg,
+                     const int r, const int g, const int b );
+
+    /*!
+      \brief write all appended records to the file. called by the writer thread.
+      \return written bytes
+     */
+    std::size_t drain();
+
+    /*!
+      \brief split the printf style format into the conversions
+      \param format format string
+      \param specs result container
+     */
+    static
+    void parse_format( const char * format,
+                       std::vector< FormatSpec > * specs );
+
+private:
+
+    void beginRecord( const char kind,
+                      const boost::int32_t level,
+                      const GameTime & time );
+
+    void append( const void * data,
+                 const std::size_t size );
+
+    template < typename T >
+    void appendValue( const T value )
+      {
+          append( &value, sizeof( T ) );
+      }
+
+    void appendString( const char * str );
+
+    void appendColor( const char * color );
+
+    void appendColor( const int r, const int g, const int b );
+
+    void commitRecord();
+
+    bool push( const char * data,
+               const std::size_t size );
+
+    const Format * registerFormat( const char * format );
+};
+
+/*!
+  \class BinaryLogWriter
+  \brief process wide background thread that writes the binary log buffers.
+
+  The thread wakes up periodically or when it is notified, and writes the
+  records of all registered buffers to their files.
+*/
+class BinaryLogWriter {
+private:
+
+    //! guard for M_buffers and M_stop. held while the buffers are drained.
+    std::mutex M_mutex;
+    //! wakeup signal
+    std::condition_variable M_cond;
+    //! registered buffers
+    std::vector< BinaryLogBuffer * > M_buffers;
+    //! stop request
+    bool M_stop;
+    //! writer thread
+    std::thread M_thread;
+
+    BinaryLogWriter();
+
+    // noncopyable
+    BinaryLogWriter( const BinaryLogWriter & );
+    BinaryLogWriter & operator=( const BinaryLogWriter & );
+
+public:
+
+    /*!
+      \brief write the remaining records and stop the thread
+     */
+    ~BinaryLogWriter();
+
+    /*!
+      \brief get the singleton instance. the thread is started at the first call.
+      \return reference to the singleton instance
+     */
+    static
+    BinaryLogWriter & instance();
+
+    /*!
+      \brief register the buffer
+      \param buffer pointer to the buffer
+     */
+    void add( BinaryLogBuffer * buffer );
+
+    /*!
+      \brief write the remaining records of the buffer and unregister it
+      \param buffer pointer to the buffer
+     */
+    void remove( BinaryLogBuffer * buffer );
+
+    /*!
+      \brief wake the writer thread up
+     */
+    void notify()
+      {
+          M_cond.notify_one();
+      }
+
+private:
+
+    void run();
+};
+
+}
+
+#endif
@@ -0,0 +1,426 @@
+// -*-c++-*-
+
+/*!
+  \file binary_log_reader.cpp
+  \brief binary debug log to text converter Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "binary_log_reader.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace rcsc {
+
+namespace {
+
+//! the max length of the text message. same as the buffer size of Logger.
+const std::size_t MAX_TEXT_LENGTH = 2048 - 1;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the raw value
+ */
+template < typename T >
+bool
+read_value( const char ** ptr,
+            const char * end,
+            T * value )
+{
+    if ( end - *ptr < static_cast< std::ptrdiff_t >( sizeof( T ) ) )
+    {
+        return false;
+    }
+
+    std::memcpy( value, *ptr, sizeof( T ) );
+    *ptr += sizeof( T );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the length prefixed string
+ */
+bool
+read_string( const char ** ptr,
+             const char * end,
+             std::string * str )
+{
+    boost::uint16_t len = 0;
+    if ( ! read_value( ptr, end, &len )
+         || end - *ptr < static_cast< std::ptrdiff_t >( len ) )
+    {
+        return false;
+    }
+
+    str->assign( *ptr, len );
+    *ptr += len;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the formatted string
+ */
+template < typename... Args >
+void
+append_printf( std::string * out,
+               const char * format,
+               Args... args )
+{
+    char buf[512];
+    const int n = std::snprintf( buf, sizeof( buf ), format, args... );
+    if ( n < 0 )
+    {
+        return;
+    }
+
+    if ( static_cast< std::size_t >( n ) < sizeof( buf ) )
+    {
+        out->append( buf, n );
+        return;
+    }
+
+    std::vector< char > large( n + 1 );
+    std::snprintf( &large[0], large.size(), format, args... );
+    out->append( &large[0], n );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the conversion with the '*' arguments
+ */
+template < typename T >
+void
+append_conversion( std::string * out,
+                   const std::string & format,
+                   const int * stars,
+                   const int star_count,
+                   const T value )
+{
+    switch ( star_count ) {
+    case 0:
+        append_printf( out, format.c_str(), value );
+        break;
+    case 1:
+        append_printf( out, format.c_str(), stars[0], value );
+        break;
+    default:
+        append_printf( out, format.c_str(), stars[0], stars[1], value );
+        break;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the literal string. "%%" is printed as '%'.
+ */
+void
+append_literal( std::string * out,
+                const std::string & literal )
+{
+    for ( std::string::size_type i = 0; i < literal.length(); ++i )
+    {
+        out->push_back( literal[i] );
+        if ( literal[i] == '%'
+             && i + 1 < literal.length()
+             && literal[i + 1] == '%' )
+        {
+            ++i;
+        }
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+BinaryLogReader::BinaryLogReader()
+    : M_record_count( 0 ),
+      M_dropped_count( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+BinaryLogReader::convert( std::istream & is,
+                          std::ostream & os )
+{
+    char magic[sizeof( BinaryLogBuffer::MAGIC )];
+    boost::uint32_t version = 0;
+    boost::uint32_t byte_order = 0;
+
+    is.read( magic, sizeof( magic ) );
+    is.read( reinterpret_cast< char * >( &version ), sizeof( version ) );
+    is.read( reinterpret_cast< char * >( &byte_order ), sizeof( byte_order ) );
+
+    if ( ! is
+         || std::memcmp( magic, BinaryLogBuffer::MAGIC, sizeof( magic ) ) != 0 )
+    {
+        std::cerr << "(BinaryLogReader::convert) not a binary debug log." << std::endl;
+        return false;
+    }
+
+    if ( version != BinaryLogBuffer::FILE_VERSION
+         || byte_order != BinaryLogBuffer::BYTE_ORDER_MARK )
+    {
+        std::cerr << "(BinaryLogReader::convert) unsupported version or byte order." << std::endl;
+        return false;
+    }
+
+    BinaryLogBuffer::RecordHeader header;
+
+    while ( true )
+    {
+        is.read( reinterpret_cast< char * >( &header ), sizeof( header ) );
+        if ( is.gcount() == 0 )
+        {
+            break;
+        }
+
+        if ( is.gcount() != sizeof( header )
+             || header.size_ < sizeof( header ) )
+        {
+            std::cerr << "(BinaryLogReader::convert) broken record header." << std::endl;
+            return false;
+        }
+
+        M_record.resize( header.size_ - sizeof( header ) );
+        if ( ! M_record.empty() )
+        {
+            is.read( &M_record[0], M_record.size() );
+            if ( is.gcount() != static_cast< std::streamsize >( M_record.size() ) )
+            {
+                std::cerr << "(BinaryLogReader::convert) broken record." << std::endl;
+                return false;
+            }
+        }
+
+        const char * data = M_record.data();
+        const char * end = data + M_record.size();
+
+        M_line.clear();
+        bool result = true;
+
+        switch ( header.kind_ ) {
+        case BinaryLogBuffer::PADDING:
+            break;
+        case BinaryLogBuffer::FORMAT:
+            {
+                std::string format;
+                result = read_string( &data, end, &format );
+                if ( result )
+                {
+                    BinaryLogBuffer::parse_format( format.c_str(), &M_formats[header.format_id_] );
+                }
+            }
+            break;
+        case BinaryLogBuffer::DROPPED:
+            M_dropped_count += header.format_id_;
+            break;
+        case BinaryLogBuffer::TEXT:
+            result = printText( header, data, end );
+            ++M_record_count;
+            break;
+        default:
+            result = printShape( header, data, end );
+            ++M_record_count;
+            break;
+        }
+
+        if ( ! result )
+        {
+            std::cerr << "(BinaryLogReader::convert) broken record at "
+                      << header.cycle_ << ',' << header.stopped_ << std::endl;
+            return false;
+        }
+
+        os << M_line;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+BinaryLogReader::printText( const BinaryLogBuffer::RecordHeader & header,
+                            const char * data,
+                            const char * end )
+{
+    std::unordered_map< boost::uint32_t, std::vector< BinaryLogBuffer::FormatSpec > >::const_iterator
+        it = M_formats.find( header.format_id_ );
+    if ( it == M_formats.end() )
+    {
+        return false;
+    }
+
+    std::string text;
+
+    for ( const BinaryLogBuffer::FormatSpec & spec : it->second )
+    {
+        int stars[2] = { 0, 0 };
+        for ( int i = 0; i < spec.stars_; ++i )
+        {
+            boost::int64_t v = 0;
+            if ( ! read_value( &data, end, &v ) ) return false;
+            stars[std::min( i, 1 )] = static_cast< int >( v );
+        }
+
+        switch ( spec.type_ ) {
+        case BinaryLogBuffer::ARG_NONE:
+        case BinaryLogBuffer::ARG_COUNT:
+            append_literal( &text, spec.text_ );
+            break;
+        case BinaryLogBuffer::ARG_CHAR:
+            {
+                boost::int64_t v = 0;
+                if ( ! read_value( &data, end, &v ) ) return false;
+                append_conversion( &text, spec.text_, stars, spec.stars_, static_cast< int >( v ) );
+            }
+            break;
+        case BinaryLogBuffer::ARG_DOUBLE:
+        case BinaryLogBuffer::ARG_LONG_DOUBLE:
+            {
+                double v = 0.0;
+                if ( ! read_value( &data, end, &v ) ) return false;
+                append_conversion( &text, spec.text_, stars, spec.stars_, v );
+            }
+            break;
+        case BinaryLogBuffer::ARG_STRING:
+            {
+                std::string v;
+                if ( ! read_string( &data, end, &v ) ) return false;
+                append_conversion( &text, spec.text_, stars, spec.stars_, v.c_str() );
+            }
+            break;
+        case BinaryLogBuffer::ARG_POINTER:
+            {
+                boost::uint64_t v = 0;
+                if ( ! read_value( &data, end, &v ) ) return false;
+                append_conversion( &text, spec.text_, stars, spec.stars_,
+                                   reinterpret_cast< void * >( static_cast< std::uintptr_t >( v ) ) );
+            }
+            break;
+        default:
+            {
+                // all integers are recorded as 64 bits
+                boost::int64_t v = 0;
+                if ( ! read_value( &data, end, &v ) ) return false;
+                append_conversion( &text, spec.text_, stars, spec.stars_, static_cast< long long >( v ) );
+            }
+            break;
+        }
+    }
+
+    if ( text.length() > MAX_TEXT_LENGTH )
+    {
+        text.resize( MAX_TEXT_LENGTH );
+    }
+
+    append_printf( &M_line, "%ld,%ld %d M ",
+                   static_cast< long >( header.cycle_ ),
+                   static_cast< long >( header.stopped_ ),
+                   static_cast< int >( header.level_ ) );
+    M_line += text;
+    M_line += '\n';
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+BinaryLogReader::printShape( const BinaryLogBuffer::RecordHeader & header,
+                             const char * data,
+                             const char * end )
+{
+    append_printf( &M_line, "%ld,%ld %d %c",
+                   static_cast< long >( header.cycle_ ),
+                   static_cast< long >( header.stopped_ ),
+                   static_cast< int >( header.level_ ),
+                   static_cast< char >( header.kind_ ) );
+
+    for ( int i = 0; i < header.value_count_; ++i )
+    {
+        double v = 0.0;
+        if ( ! read_value( &data, end, &v ) ) return false;
+        append_printf( &M_line, " %.4f", v );
+    }
+
+    M_line += ' ';
+
+    std::string color;
+    if ( header.color_type_ == BinaryLogBuffer::NAMED_COLOR )
+    {
+        if ( ! read_string( &data, end, &color ) ) return false;
+    }
+    else if ( header.color_type_ == BinaryLogBuffer::RGB_COLOR )
+    {
+        boost::uint8_t rgb[3];
+        if ( ! read_value( &data, end, &rgb ) ) return false;
+        append_printf( &color, "#%02x%02x%02x", rgb[0], rgb[1], rgb[2] );
+    }
+
+    if ( header.kind_ == BinaryLogBuffer::MESSAGE )
+    {
+        std::string msg;
+        if ( ! read_string( &data, end, &msg ) ) return false;
+
+        if ( header.color_type_ != BinaryLogBuffer::NO_COLOR )
+        {
+            M_line += "(c ";
+            M_line += color;
+            M_line += ") ";
+        }
+        M_line += msg;
+    }
+    else
+    {
+        M_line += color;
+    }
+
+    M_line += '\n';
+    return true;
+}
+
+}
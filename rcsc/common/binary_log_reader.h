@@ -0,0 +1,115 @@
+// -*-c++-*-
+
+/*!
+  \file binary_log_reader.h
+  \brief binary debug log to text converter Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_COMMON_BINARY_LOG_READER_H
+#define RCSC_COMMON_BINARY_LOG_READER_H
+
+#include <rcsc/common/binary_log_buffer.h>
+
+#include <boost/cstdint.hpp>
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rcsc {
+
+/*!
+  \class BinaryLogReader
+  \brief converts the binary debug log written by BinaryLogBuffer to the text format of Logger.
+*/
+class BinaryLogReader {
+private:
+
+    //! format id -> parsed conversions
+    std::unordered_map< boost::uint32_t, std::vector< BinaryLogBuffer::FormatSpec > > M_formats;
+
+    //! the number of records
+    long M_record_count;
+
+    //! the number of dropped records
+    long M_dropped_count;
+
+    //! record data
+    std::vector< char > M_record;
+
+    //! output line
+    std::string M_line;
+
+public:
+
+    /*!
+      \brief initialize the counters
+     */
+    BinaryLogReader();
+
+    /*!
+      \brief read all records from the input stream, and print them in the text format.
+      \param is binary input stream
+      \param os text output stream
+      \return false if the input is not a binary log or it is broken.
+     */
+    bool convert( std::istream & is,
+                  std::ostream & os );
+
+    /*!
+      \brief get the number of converted records
+      \return the number of records
+     */
+    long recordCount() const
+      {
+          return M_record_count;
+      }
+
+    /*!
+      \brief get the number of the records dropped by the logger
+      \return the number of dropped records
+     */
+    long droppedCount() const
+      {
+          return M_dropped_count;
+      }
+
+private:
+
+    bool printText( const BinaryLogBuffer::RecordHeader & header,
+                    const char * data,
+                    const char * end );
+
+    bool printShape( const BinaryLogBuffer::RecordHeader & header,
+                     const char * data,
+                     const char * end );
+};
+
+}
+
+#endif
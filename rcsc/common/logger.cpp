@@ -34,9 +34,12 @@
 #endif
 
 #include "logger.h"
+
+#include <rcsc/common/binary_log_buffer.h>
 #include <rcsc/game_time.h>
 
 #include <string>
+#include <utility>
 #include <iostream>
 #include <cstdio>
 #include <cstdarg>
@@ -50,15 +53,12 @@ namespace  {
 #define G_BUFFER_SIZE 2048
 
 //! temporary buffer
-char g_buffer[G_BUFFER_SIZE];
-
-//! main buffer
-std::string g_str;
+thread_local char g_buffer[G_BUFFER_SIZE];
 
 }
 
 //! global variable
-Logger dlog;
+thread_local Logger dlog;
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -69,8 +69,7 @@ Logger::Logger()
       M_fout( NULL ),
       M_flags( 0 )
 {
-    g_str.reserve( 8192 * 4 );
-    std::strcpy( g_buffer, "" );
+    M_str.reserve( 8192 * 4 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -82,6 +81,20 @@ Logger::~Logger()
     close();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::swap( Logger & other )
+{
+    std::swap( M_time, other.M_time );
+    std::swap( M_fout, other.M_fout );
+    std::swap( M_flags, other.M_flags );
+    M_str.swap( other.M_str );
+    M_binary.swap( other.M_binary );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -110,6 +123,12 @@ Logger::setLogFlag( const GameTime * time,
 void
 Logger::close()
 {
+    if ( M_binary )
+    {
+        BinaryLogWriter::instance().remove( M_binary.get() );
+        M_binary.reset();
+    }
+
     if ( M_fout )
     {
         flush();
@@ -134,6 +153,28 @@ Logger::open( const std::string & filepath )
     M_fout = std::fopen( filepath.c_str(), "w" );
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Logger::openBinary( const std::string & filepath,
+                    const std::size_t buffer_size )
+{
+    close();
+
+    M_fout = std::fopen( filepath.c_str(), "wb" );
+
+    if ( M_fout )
+    {
+        M_binary.reset( new BinaryLogBuffer( M_fout,
+                                             buffer_size > 0
+                                             ? buffer_size
+                                             : static_cast< std::size_t >( BinaryLogBuffer::DEFAULT_CAPACITY ) ) );
+        BinaryLogWriter::instance().add( M_binary.get() );
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -165,13 +206,19 @@ Logger::openStandardError()
 void
 Logger::flush()
 {
-    if ( M_fout && g_str.length() > 0 )
+    if ( M_binary )
     {
-        fputs( g_str.c_str(), M_fout );
-        //fwrite( g_str.c_str(), sizeof( char ), g_str.length(), M_fout );
+        BinaryLogWriter::instance().notify();
+        return;
+    }
+
+    if ( M_fout && M_str.length() > 0 )
+    {
+        fputs( M_str.c_str(), M_fout );
+        //fwrite( M_str.c_str(), sizeof( char ), M_str.length(), M_fout );
         fflush( M_fout );
     }
-    g_str.erase();
+    M_str.erase();
 }
 
 /*-------------------------------------------------------------------*/
@@ -181,7 +228,7 @@ Logger::flush()
 void
 Logger::clear()
 {
-    g_str.erase();
+    M_str.erase();
 }
 
 /*-------------------------------------------------------------------*/
@@ -199,6 +246,14 @@ Logger::addText( const boost::int32_t level,
     {
         va_list argp;
         va_start( argp, msg );
+
+        if ( M_binary )
+        {
+            M_binary->addText( level, *M_time, msg, argp );
+            va_end( argp );
+            return;
+        }
+
         vsnprintf( g_buffer, G_BUFFER_SIZE, msg, argp );
         va_end( argp );
 
@@ -208,10 +263,10 @@ Logger::addText( const boost::int32_t level,
                   M_time->stopped(),
                   level );
 
-        g_str += header;
-        g_str += g_buffer;
-        g_str += '\n';
-        if ( g_str.length() > 8192 * 3 )
+        M_str += header;
+        M_str += g_buffer;
+        M_str += '\n';
+        if ( M_str.length() > 8192 * 3 )
         {
             flush();
         }
@@ -232,18 +287,25 @@ Logger::addPoint( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y };
+            M_binary->addShape( 'p', level, *M_time, values, 2, color );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d p %.4f %.4f ",
                   M_time->cycle(),
                   M_time->stopped(),
                   level,
                   x, y );
-        g_str += msg;
+        M_str += msg;
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -261,6 +323,13 @@ Logger::addPoint( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y };
+            M_binary->addShape( 'p', level, *M_time, values, 2, r, g, b );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d p %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
@@ -268,8 +337,8 @@ Logger::addPoint( const boost::int32_t level,
                   level,
                   x, y,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -289,18 +358,25 @@ Logger::addLine( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x1, y1, x2, y2 };
+            M_binary->addShape( 'l', level, *M_time, values, 4, color );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d l %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   M_time->stopped(),
                   level,
                   x1, y1, x2, y2 );
-        g_str += msg;
+        M_str += msg;
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -320,6 +396,13 @@ Logger::addLine( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x1, y1, x2, y2 };
+            M_binary->addShape( 'l', level, *M_time, values, 4, r, g, b );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d l %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
@@ -327,8 +410,8 @@ Logger::addLine( const boost::int32_t level,
                   level,
                   x1, y1, x2, y2,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -349,20 +432,27 @@ Logger::addArc( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y, radius, start_angle.degree(), span_angle };
+            M_binary->addShape( 'a', level, *M_time, values, 5, color );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d a %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   M_time->stopped(),
                   level,
                   x, y, radius, start_angle.degree(), span_angle );
-        g_str += msg;
+        M_str += msg;
 
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
 
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -384,6 +474,13 @@ Logger::addArc( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y, radius, start_angle.degree(), span_angle };
+            M_binary->addShape( 'a', level, *M_time, values, 5, r, g, b );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d a %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
@@ -391,8 +488,8 @@ Logger::addArc( const boost::int32_t level,
                   level,
                   x, y, radius, start_angle.degree(), span_angle,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -412,6 +509,13 @@ Logger::addCircle( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y, radius };
+            M_binary->addShape( ( fill ? 'C' : 'c' ), level, *M_time, values, 3, color );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f ",
                   M_time->cycle(),
@@ -419,12 +523,12 @@ Logger::addCircle( const boost::int32_t level,
                   level,
                   ( fill ? 'C' : 'c' ),
                   x, y, radius );
-        g_str += msg;
+        M_str += msg;
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -444,6 +548,13 @@ Logger::addCircle( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y, radius };
+            M_binary->addShape( ( fill ? 'C' : 'c' ), level, *M_time, values, 3, r, g, b );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
@@ -452,8 +563,8 @@ Logger::addCircle( const boost::int32_t level,
                   ( fill ? 'C' : 'c' ),
                   x, y, radius,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -476,6 +587,13 @@ Logger::addTriangle( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x1, y1, x2, y2, x3, y3 };
+            M_binary->addShape( ( fill ? 'T' : 't' ), level, *M_time, values, 6, color );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
@@ -483,12 +601,12 @@ Logger::addTriangle( const boost::int32_t level,
                   level,
                   ( fill ? 'T' : 't' ),
                   x1, y1, x2, y2, x3, y3 );
-        g_str += msg;
+        M_str += msg;
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -511,6 +629,13 @@ Logger::addTriangle( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x1, y1, x2, y2, x3, y3 };
+            M_binary->addShape( ( fill ? 'T' : 't' ), level, *M_time, values, 6, r, g, b );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
@@ -519,8 +644,8 @@ Logger::addTriangle( const boost::int32_t level,
                   ( fill ? 'T' : 't' ),
                   x1, y1, x2, y2, x3, y3,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -541,6 +666,13 @@ Logger::addRect( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { left, top, length, width };
+            M_binary->addShape( ( fill ? 'R' : 'r' ), level, *M_time, values, 4, color );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
@@ -548,12 +680,12 @@ Logger::addRect( const boost::int32_t level,
                   level,
                   ( fill ? 'R' : 'r' ),
                   left, top, length, width );
-        g_str += msg;
+        M_str += msg;
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -574,6 +706,13 @@ Logger::addRect( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { left, top, length, width };
+            M_binary->addShape( ( fill ? 'R' : 'r' ), level, *M_time, values, 4, r, g, b );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
@@ -582,8 +721,8 @@ Logger::addRect( const boost::int32_t level,
                   ( fill ? 'R' : 'r' ),
                   left, top, length, width,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -606,6 +745,13 @@ Logger::addSector( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y, min_radius, max_radius, start_angle.degree(), span_angle };
+            M_binary->addShape( ( fill ? 'S' : 's' ), level, *M_time, values, 6, color );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
@@ -614,12 +760,12 @@ Logger::addSector( const boost::int32_t level,
                   ( fill ? 'S' : 's' ),
                   x, y, min_radius, max_radius,
                   start_angle.degree(), span_angle );
-        g_str += msg;
+        M_str += msg;
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -642,6 +788,13 @@ Logger::addSector( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            const double values[] = { x, y, min_radius, max_radius, start_angle.degree(), span_angle };
+            M_binary->addShape( ( fill ? 'S' : 's' ), level, *M_time, values, 6, r, g, b );
+            return;
+        }
+
         char msg[128];
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
@@ -651,8 +804,8 @@ Logger::addSector( const boost::int32_t level,
                   x, y, min_radius, max_radius,
                   start_angle.degree(), span_angle,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -674,6 +827,16 @@ Logger::addSector( const boost::int32_t level,
         double span_angle = ( sector.angleLeftStart().isLeftOf( sector.angleRightEnd() )
                               ? ( sector.angleLeftStart() - sector.angleRightEnd() ).abs()
                               : 360.0 - ( sector.angleLeftStart() - sector.angleRightEnd() ).abs() );
+
+        if ( M_binary )
+        {
+            const double values[] = { sector.center().x, sector.center().y,
+                                      sector.radiusMin(), sector.radiusMax(),
+                                      sector.angleLeftStart().degree(), span_angle };
+            M_binary->addShape( ( fill ? 'S' : 's' ), level, *M_time, values, 6, color );
+            return;
+        }
+
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f ",
                   M_time->cycle(),
                   M_time->stopped(),
@@ -682,12 +845,12 @@ Logger::addSector( const boost::int32_t level,
                   sector.center().x, sector.center().y,
                   sector.radiusMin(), sector.radiusMax(),
                   sector.angleLeftStart().degree(), span_angle );
-        g_str += msg;
+        M_str += msg;
         if ( color )
         {
-            g_str += color;
+            M_str += color;
         }
-        g_str += '\n';
+        M_str += '\n';
     }
 }
 
@@ -709,6 +872,16 @@ Logger::addSector( const boost::int32_t level,
         double span_angle = ( sector.angleLeftStart().isLeftOf( sector.angleRightEnd() )
                               ? ( sector.angleLeftStart() - sector.angleRightEnd() ).abs()
                               : 360.0 - ( sector.angleLeftStart() - sector.angleRightEnd() ).abs() );
+
+        if ( M_binary )
+        {
+            const double values[] = { sector.center().x, sector.center().y,
+                                      sector.radiusMin(), sector.radiusMax(),
+                                      sector.angleLeftStart().degree(), span_angle };
+            M_binary->addShape( ( fill ? 'S' : 's' ), level, *M_time, values, 6, r, g, b );
+            return;
+        }
+
         snprintf( msg, 128, "%ld,%ld %d %c %.4f %.4f %.4f %.4f %.4f %.4f #%02x%02x%02x",
                   M_time->cycle(),
                   M_time->stopped(),
@@ -718,8 +891,8 @@ Logger::addSector( const boost::int32_t level,
                   sector.radiusMin(), sector.radiusMax(),
                   sector.angleLeftStart().degree(), span_angle,
                   r, g, b );
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -738,23 +911,29 @@ Logger::addMessage( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            M_binary->addMessage( level, *M_time, x, y, msg, color );
+            return;
+        }
+
         char header[128];
         snprintf( header, 128, "%ld,%ld %d m %.4f %.4f ",
                   M_time->cycle(),
                   M_time->stopped(),
                   level,
                   x, y );
-        g_str += header;
+        M_str += header;
 
         if ( color )
         {
-            g_str += "(c ";
-            g_str += color;
-            g_str += ") ";
+            M_str += "(c ";
+            M_str += color;
+            M_str += ") ";
         }
 
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
@@ -773,22 +952,28 @@ Logger::addMessage( const boost::int32_t level,
          && M_time
          && ( level & M_flags ) )
     {
+        if ( M_binary )
+        {
+            M_binary->addMessage( level, *M_time, x, y, msg, r, g, b );
+            return;
+        }
+
         char header[128];
         snprintf( header, 128, "%ld,%ld %d m %.4f %.4f ",
                   M_time->cycle(),
                   M_time->stopped(),
                   level,
                   x, y );
-        g_str += header;
+        M_str += header;
 
         char col[8];
         snprintf( col, 8, "#%02x%02x%02x", r, g, b );
-        g_str += "(c ";
-        g_str += col;
-        g_str += ") ";
+        M_str += "(c ";
+        M_str += col;
+        M_str += ") ";
 
-        g_str += msg;
-        g_str += '\n';
+        M_str += msg;
+        M_str += '\n';
     }
 }
 
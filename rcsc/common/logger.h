@@ -40,11 +40,13 @@
 
 #include <boost/cstdint.hpp>
 
+#include <memory>
 #include <string>
 #include <cstdio>
 
 namespace rcsc {
 
+class BinaryLogBuffer;
 class GameTime;
 
 /*!
@@ -156,6 +158,16 @@ private:
     //! log level flag
     boost::int32_t M_flags;
 
+    //! message buffer
+    std::string M_str;
+
+    //! binary record buffer. not null if the binary log is opened.
+    std::unique_ptr< BinaryLogBuffer > M_binary;
+
+    // not used
+    Logger( const Logger & );
+    Logger & operator=( const Logger & );
+
 public:
     /*!
       \brief allocate message buffer memory
@@ -167,6 +179,15 @@ public:
      */
     ~Logger();
 
+    /*!
+      \brief exchange the output file, log level and buffered messages with other logger
+      \param other another logger instance
+
+      This is used to switch the per-thread dlog to the logger of each
+      agent, when several agents are executed in one process.
+     */
+    void swap( Logger & other );
+
     /*!
       \brief set new log level
       \param time const pointer to the game time instance
@@ -193,6 +214,17 @@ public:
      */
     void open( const std::string & filepath );
 
+    /*!
+      \brief open file to record the binary log.
+      The records are appended to the lock-free buffer without formatting,
+      and they are written to the file by the background thread.
+      The file is converted to the text format by BinaryLogReader.
+      \param filepath file path string
+      \param buffer_size size of the ring buffer [byte]. if 0, the default size is used.
+     */
+    void openBinary( const std::string & filepath,
+                     const std::size_t buffer_size = 0 );
+
     /*!
       \brief use standard output to record
      */
@@ -218,12 +250,14 @@ public:
       }
 
     /*!
-      \brief flush stored message
+      \brief flush stored message.
+      In the binary mode, the writer thread is woken up.
     */
     void flush();
 
     /*!
-      \brief clear buffer without flush
+      \brief clear buffer without flush.
+      In the binary mode, the records are not cleared.
     */
     void clear();
 
@@ -951,9 +985,43 @@ public:
 
 };
 
-//! global variable
-extern Logger dlog;
+//! global variable. each thread has its own instance.
+extern thread_local Logger dlog;
 
 }
 
+#ifndef RCSC_DLOG_DISABLED_LEVELS
+/*!
+  \def RCSC_DLOG_DISABLED_LEVELS
+  \brief bit mask of the log levels removed at compile time.
+  e.g. 0x30 removes Logger::INTERCEPT and Logger::KICK.
+ */
+#define RCSC_DLOG_DISABLED_LEVELS 0
+#endif
+
+/*!
+  \def RCSC_DLOG_ENABLED( level )
+  \brief check if the level is compiled in and enabled in dlog.
+  The result is a constant false if the level is in RCSC_DLOG_DISABLED_LEVELS.
+ */
+#define RCSC_DLOG_ENABLED( level )                                      \
+    ( ! ( ( level ) & ( RCSC_DLOG_DISABLED_LEVELS ) )                   \
+      && rcsc::dlog.isEnabled( level ) )
+
+/*!
+  \def RCSC_DLOG( level, method, ... )
+  \brief call dlog.method( level, ... ) only if the level is enabled.
+  Unlike the direct call, the arguments are never evaluated when the
+  level is disabled, and the call is removed by the compiler when the
+  level is in RCSC_DLOG_DISABLED_LEVELS.
+  e.g. RCSC_DLOG( Logger::KICK, addText, "power=%.1f", power );
+ */
+#define RCSC_DLOG( level, method, ... )                                 \
+    do {                                                                \
+        if ( RCSC_DLOG_ENABLED( level ) )                               \
+        {                                                               \
+            rcsc::dlog.method( ( level ), __VA_ARGS__ );                \
+        }                                                               \
+    } while ( 0 )
+
 #endif
@@ -39,22 +39,65 @@
 
 #include <rcsc/net/udp_socket.h>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <cerrno>
+#include <cstdio>
 #include <cstring>
+#include <cstdint>
 
 #include <unistd.h> // select()
 #include <sys/select.h> // select()
 #include <sys/time.h> // select()
 #include <sys/types.h> // select()
 
+#if defined(HAVE_SYS_EPOLL_H) && defined(HAVE_SYS_TIMERFD_H)
+#define RCSC_USE_EPOLL
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+
 namespace rcsc {
 
+#ifdef RCSC_USE_EPOLL
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief start the one shot timer
+  \param fd timerfd
+  \param msec timeout interval [ms]. non-positive value is clamped to 1 ms,
+  because zero disarms the timer and a shorter one only spins the event loop.
+  \return result of timerfd_settime()
+ */
+inline
+int
+start_timer( const int fd,
+             const int msec )
+{
+    const int interval = std::max( 1, msec );
+
+    struct itimerspec spec;
+    std::memset( &spec, 0, sizeof( spec ) );
+    spec.it_value.tv_sec = interval / 1000;
+    spec.it_value.tv_nsec = ( interval % 1000 ) * 1000 * 1000;
+
+    return ::timerfd_settime( fd, 0, &spec, static_cast< struct itimerspec * >( 0 ) );
+}
+
+}
+#endif
+
 /*-------------------------------------------------------------------*/
 /*!
 
  */
 OnlineClient::OnlineClient()
-    : AbstractClient()
+    : AbstractClient(),
+      M_event_loop( SELECT_LOOP ),
+      M_batch_size( 0 ),
+      M_batch_index( 0 )
 {
 
 }
@@ -73,6 +116,26 @@ OnlineClient::~OnlineClient()
     // std::cerr << "delete OnlineClient" << std::endl;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OnlineClient::setEventLoop( const EventLoopType type )
+{
+#ifndef RCSC_USE_EPOLL
+    if ( type == EPOLL_LOOP )
+    {
+        std::cerr << "(OnlineClient::setEventLoop) epoll is not supported."
+                  << " select() is used." << std::endl;
+        M_event_loop = SELECT_LOOP;
+        return;
+    }
+#endif
+
+    M_event_loop = type;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -89,6 +152,25 @@ OnlineClient::run( SoccerAgent * agent )
         return;
     }
 
+    if ( M_event_loop == EPOLL_LOOP )
+    {
+        runEpoll( agent );
+    }
+    else
+    {
+        runSelect( agent );
+    }
+
+    handleExit( agent );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OnlineClient::runSelect( SoccerAgent * agent )
+{
     // set interval timeout
     struct timeval interval;
 
@@ -132,8 +214,142 @@ OnlineClient::run( SoccerAgent * agent )
             handleMessage( agent );
         }
     }
+}
 
-    handleExit( agent );
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+OnlineClient::runEpoll( SoccerAgent * agent )
+{
+#ifdef RCSC_USE_EPOLL
+    const int epoll_fd = ::epoll_create1( EPOLL_CLOEXEC );
+    const int timer_fd = ::timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+
+    struct epoll_event ev;
+    std::memset( &ev, 0, sizeof( ev ) );
+    ev.events = EPOLLIN;
+
+    bool ok = ( epoll_fd != -1 && timer_fd != -1 );
+    if ( ok )
+    {
+        ev.data.fd = M_socket->fd();
+        ok = ( ::epoll_ctl( epoll_fd, EPOLL_CTL_ADD, M_socket->fd(), &ev ) == 0 );
+    }
+    if ( ok )
+    {
+        ev.data.fd = timer_fd;
+        ok = ( ::epoll_ctl( epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev ) == 0 );
+    }
+    if ( ok )
+    {
+        ok = ( start_timer( timer_fd, intervalMSec() ) == 0 );
+    }
+
+    if ( ! ok )
+    {
+        std::perror( "(OnlineClient::runEpoll)" );
+        if ( epoll_fd != -1 ) ::close( epoll_fd );
+        if ( timer_fd != -1 ) ::close( timer_fd );
+
+        std::cerr << "(OnlineClient::runEpoll) select() is used." << std::endl;
+        runSelect( agent );
+        return;
+    }
+
+    struct epoll_event events[2];
+
+    int timeout_count = 0;
+    int waited_msec = 0;
+
+    // the timer is not restarted for each message to save the system call.
+    // instead, the elapsed time since the last event is checked when the timer expires.
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point last_event_time = Clock::now();
+
+    while ( isServerAlive() )
+    {
+        const int n = ::epoll_wait( epoll_fd, events, 2, -1 );
+        if ( n < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            perror( "epoll_wait" );
+            break;
+        }
+
+        bool received = false;
+        bool expired = false;
+        for ( int i = 0; i < n; ++i )
+        {
+            if ( events[i].data.fd == timer_fd )
+            {
+                expired = true;
+            }
+            else
+            {
+                received = true;
+            }
+        }
+
+        if ( received )
+        {
+            // received message, reset wait time
+            waited_msec = 0;
+            timeout_count = 0;
+            last_event_time = Clock::now();
+            handleMessage( agent );
+        }
+
+        if ( expired )
+        {
+            std::uint64_t expirations = 0;
+            if ( ::read( timer_fd, &expirations, sizeof( expirations ) ) != sizeof( expirations ) )
+            {
+                continue;
+            }
+
+            const Clock::time_point now = Clock::now();
+            const int elapsed
+                = static_cast< int >( std::chrono::duration_cast< std::chrono::milliseconds >
+                                      ( now - last_event_time ).count() );
+            if ( received
+                 || elapsed < intervalMSec() )
+            {
+                // some messages were received in the interval
+                start_timer( timer_fd, intervalMSec() - elapsed );
+                continue;
+            }
+
+            // no meesage. timeout.
+            last_event_time = now;
+            waited_msec += intervalMSec();
+            ++timeout_count;
+            handleTimeout( agent, timeout_count, waited_msec );
+            start_timer( timer_fd, intervalMSec() );
+        }
+    }
+
+    ::close( timer_fd );
+    ::close( epoll_fd );
+#else
+    runSelect( agent );
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+OnlineClient::socketFD() const
+{
+    return ( M_socket
+             ? M_socket->fd()
+             : -1 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -194,18 +410,19 @@ OnlineClient::sendMessage( const char * msg )
 int
 OnlineClient::receiveMessage()
 {
-    static char msg[MAX_MESG];
-
     if ( ! M_socket )
     {
         return 0;
     }
 
-    int n = M_socket->readDatagram( msg, MAX_MESG );
+    const char * received = M_receive_buffer;
+    int n = ( M_event_loop == EPOLL_LOOP
+              ? readBatch( &received )
+              : M_socket->readDatagram( M_receive_buffer, MAX_MESG ) );
 
     if ( n > 0 )
     {
-        decompress( msg, n );
+        decompress( received, n );
 
         if ( M_offline_out.is_open() )
         {
@@ -216,6 +433,37 @@ OnlineClient::receiveMessage()
     return n;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+OnlineClient::readBatch( const char ** msg )
+{
+    if ( M_batch_index >= M_batch_size )
+    {
+        M_batch_index = 0;
+        M_batch_size = 0;
+
+        if ( M_batch_buffer.empty() )
+        {
+            M_batch_buffer.resize( MAX_BATCH * MAX_MESG );
+        }
+
+        const int n = M_socket->readDatagrams( &M_batch_buffer[0], MAX_MESG,
+                                               MAX_BATCH, M_batch_lengths );
+        if ( n <= 0 )
+        {
+            return n;
+        }
+
+        M_batch_size = n;
+    }
+
+    *msg = &M_batch_buffer[0] + M_batch_index * MAX_MESG;
+    return M_batch_lengths[M_batch_index++];
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
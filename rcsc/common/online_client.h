@@ -35,6 +35,7 @@
 #include <rcsc/common/abstract_client.h>
 
 #include <fstream>
+#include <vector>
 
 namespace rcsc {
 
@@ -51,6 +52,21 @@ class UDPSocket;
  */
 class OnlineClient
     : public AbstractClient {
+public:
+
+    /*!
+      \enum EventLoopType
+      \brief main loop implementation
+     */
+    enum EventLoopType {
+        SELECT_LOOP, //!< select() and one recvfrom() for each message
+        EPOLL_LOOP, //!< epoll, timerfd and recvmmsg() to receive all pending messages at once
+    };
+
+    enum {
+        MAX_BATCH = 16, //!< the maximal number of messages received by one system call
+    };
+
 private:
 
     //! udp connection
@@ -59,6 +75,21 @@ private:
     //! output file for offline logging
     std::ofstream M_offline_out;
 
+    //! main loop implementation
+    EventLoopType M_event_loop;
+
+    //! received raw message. used only by SELECT_LOOP.
+    char M_receive_buffer[MAX_MESG];
+
+    //! received raw messages. used only by EPOLL_LOOP.
+    std::vector< char > M_batch_buffer;
+    //! the length of each received message
+    int M_batch_lengths[MAX_BATCH];
+    //! the number of messages in the batch buffer
+    int M_batch_size;
+    //! the index of the next message in the batch buffer
+    int M_batch_index;
+
 public:
 
     /*!
@@ -76,8 +107,8 @@ public:
       \param agent pointer to the soccer agent instance.
 
       Thie method keep infinite loop while client can estimate server is alive.
-      To handle server message, select() is used.
-      Timeout interval of select() is specified by M_interval_msec member variable.
+      To handle server message, select() or epoll is used according to the event loop type.
+      Timeout interval is specified by M_interval_msec member variable.
       When server message is received, handleMessage() is called.
       When timeout occurs, handleTimeout() is called.
       When server is not alive, loop is end and handleExit() is called.
@@ -85,6 +116,29 @@ public:
     virtual
     void run( SoccerAgent * agent );
 
+    /*!
+      \brief set the main loop implementation. this has to be called before run().
+      EPOLL_LOOP is replaced by SELECT_LOOP if the system does not support epoll.
+      \param type event loop type
+     */
+    void setEventLoop( const EventLoopType type );
+
+    /*!
+      \brief get the main loop implementation
+      \return event loop type
+     */
+    EventLoopType eventLoop() const
+      {
+          return M_event_loop;
+      }
+
+    /*!
+      \brief get the file descriptor of the connection.
+      This is used by the event loop that handles several clients, e.g. AgentHost.
+      \return file descriptor. -1 if not connected.
+     */
+    int socketFD() const;
+
     /*!
       \brief connect to the soccer server with timeout value for select()
       \param hostname server host name
@@ -126,6 +180,28 @@ public:
     virtual
     void printOfflineThink();
 
+private:
+
+    /*!
+      \brief main loop by select()
+      \param agent pointer to the soccer agent instance.
+     */
+    void runSelect( SoccerAgent * agent );
+
+    /*!
+      \brief main loop by epoll and timerfd
+      \param agent pointer to the soccer agent instance.
+     */
+    void runEpoll( SoccerAgent * agent );
+
+    /*!
+      \brief get the next raw message from the batch buffer.
+      If the buffer is empty, all pending messages are received at once.
+      \param msg pointer to the variable to receive the message pointer
+      \return length of the message. 0 if no message. -1 if error.
+     */
+    int readBatch( const char ** msg );
+
 };
 
 }
@@ -55,6 +55,7 @@ class CmdLineParser;
 class SoccerAgent {
 public:
     friend class AbstractClient;
+    friend class AgentHost;
 
 protected:
     //! interface to the rcssserver or offline log.
@@ -160,6 +161,19 @@ protected:
     void handleMessageOffline()
       { }
 
+    /*!
+      \brief (virtual) check if the parameter messages sent just after the connection have been received.
+      \return true if server_param, player_param and all player_type messages have been received.
+
+      AgentHost executes the events serially until this method returns true for all agents,
+      because the received parameters are written to the process wide tables.
+     */
+    virtual
+    bool parametersReceived() const
+      {
+          return true;
+      }
+
     /*!
       \brief (pure virtual) handle timeout event
       \param timeout_count count of timeout without sensory message.
@@ -310,7 +310,7 @@ Vector2D
 FormationKNN::getPosition( const int unum,
                            const Vector2D & focus_point ) const
 {
-    static std::vector< const SampleData * > ptr_vector;
+    thread_local std::vector< const SampleData * > ptr_vector;
 
     if ( unum < 1 || 11 < unum )
     {
@@ -325,6 +325,7 @@ FormationKNN::getPosition( const int unum,
         return Vector2D( 0.0, 0.0 );
     }
 
+    ptr_vector.clear();
     ptr_vector.reserve( M_samples->dataCont().size() );
 
     const SampleDataSet::DataCont::const_iterator d_end = M_samples->dataCont().end();
@@ -394,10 +395,11 @@ void
 FormationKNN::getPositions( const Vector2D & focus_point,
                             std::vector< Vector2D > & positions ) const
 {
-    static std::vector< const SampleData * > ptr_vector;
+    thread_local std::vector< const SampleData * > ptr_vector;
 
     positions.clear();
 
+    ptr_vector.clear();
     ptr_vector.reserve( M_samples->dataCont().size() );
 
     const SampleDataSet::DataCont::const_iterator d_end = M_samples->dataCont().end();
@@ -329,7 +329,8 @@ public:
 
     /*!
       \brief get playmode string
-      \return const char pointer
+      \return const char pointer to the buffer of the calling thread.
+      it is overwritten by the next call in the same thread.
      */
     const char * toCString() const;
 
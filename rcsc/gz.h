@@ -32,6 +32,7 @@
 #ifndef RCSC_GZ_H
 #define RCSC_GZ_H
 
+#include <rcsc/gz/gzaccessindex.h>
 #include <rcsc/gz/gzcompressor.h>
 #include <rcsc/gz/gzfilterstream.h>
 #include <rcsc/gz/gzfstream.h>
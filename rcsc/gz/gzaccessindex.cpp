@@ -0,0 +1,687 @@
+// -*-c++-*-
+
+/*!
+  \file gzaccessindex.cpp
+  \brief random access index for gzipped files Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "gzaccessindex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+namespace rcsc {
+
+namespace {
+
+//! the size of the compressed input buffer
+const std::size_t CHUNK_SIZE = 16384;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the unsigned integer in little endian
+ */
+void
+write_uint( std::ostream & os,
+            unsigned long long value,
+            const int bytes )
+{
+    char buf[8];
+    for ( int i = 0; i < bytes; ++i )
+    {
+        buf[i] = static_cast< char >( value & 0xff );
+        value >>= 8;
+    }
+    os.write( buf, bytes );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the unsigned integer written by write_uint()
+ */
+bool
+read_uint( std::istream & is,
+           unsigned long long & value,
+           const int bytes )
+{
+    unsigned char buf[8];
+    if ( ! is.read( reinterpret_cast< char * >( buf ), bytes ) )
+    {
+        return false;
+    }
+
+    value = 0;
+    for ( int i = bytes - 1; i >= 0; --i )
+    {
+        value = ( value << 8 ) | buf[i];
+    }
+    return true;
+}
+
+#ifdef HAVE_LIBZ
+/*-------------------------------------------------------------------*/
+/*!
+  \brief seek the file. large files are supported if possible.
+ */
+bool
+seek_file( std::FILE * fp,
+           const unsigned long long offset )
+{
+#if defined(_WIN32)
+    return _fseeki64( fp, static_cast< __int64 >( offset ), SEEK_SET ) == 0;
+#else
+    return fseeko( fp, static_cast< off_t >( offset ), SEEK_SET ) == 0;
+#endif
+}
+#endif
+
+}
+
+const std::size_t GZAccessIndex::WINDOW_SIZE;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+GZAccessIndex::GZAccessIndex()
+    : M_uncompressed_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZAccessIndex::clear()
+{
+    M_points.clear();
+    M_uncompressed_size = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessIndex::build( const char * path,
+                      const std::size_t span,
+                      const Consumer & consumer )
+{
+    clear();
+
+#ifdef HAVE_LIBZ
+    std::FILE * fp = std::fopen( path, "rb" );
+    if ( ! fp )
+    {
+        return false;
+    }
+
+    z_stream strm;
+    std::memset( &strm, 0, sizeof( strm ) );
+
+    // 47 = 32 + 15: automatic gzip/zlib header detection, 32K window
+    if ( inflateInit2( &strm, 47 ) != Z_OK )
+    {
+        std::fclose( fp );
+        return false;
+    }
+
+    unsigned char input[CHUNK_SIZE];
+    std::vector< unsigned char > window( WINDOW_SIZE );
+
+    unsigned long long total_in = 0;
+    unsigned long long total_out = 0;
+    unsigned long long last = 0;
+    int ret = Z_OK;
+
+    strm.avail_out = 0;
+    do
+    {
+        strm.avail_in = static_cast< uInt >( std::fread( input, 1, CHUNK_SIZE, fp ) );
+        if ( std::ferror( fp )
+             || strm.avail_in == 0 )
+        {
+            // read error or premature end of the file
+            ret = Z_DATA_ERROR;
+            break;
+        }
+        strm.next_in = input;
+
+        do
+        {
+            if ( strm.avail_out == 0 )
+            {
+                // the window is used as a ring buffer of the output
+                strm.avail_out = WINDOW_SIZE;
+                strm.next_out = window.data();
+            }
+
+            unsigned char * out_first = strm.next_out;
+
+            total_in += strm.avail_in;
+            total_out += strm.avail_out;
+            // stop at the end of each deflate block
+            ret = inflate( &strm, Z_BLOCK );
+            total_in -= strm.avail_in;
+            total_out -= strm.avail_out;
+
+            if ( consumer
+                 && strm.next_out != out_first )
+            {
+                consumer( reinterpret_cast< const char * >( out_first ),
+                          static_cast< std::size_t >( strm.next_out - out_first ) );
+            }
+
+            if ( ret == Z_NEED_DICT )
+            {
+                ret = Z_DATA_ERROR;
+            }
+            if ( ret == Z_MEM_ERROR
+                 || ret == Z_DATA_ERROR )
+            {
+                break;
+            }
+            if ( ret == Z_STREAM_END )
+            {
+                break;
+            }
+
+            // data_type bit 7: at the end of a block, bit 6: at the end of the last block
+            if ( ( strm.data_type & 128 )
+                 && ! ( strm.data_type & 64 )
+                 && ( total_out == 0 || total_out - last > span ) )
+            {
+                Point p;
+                p.out_ = total_out;
+                p.in_ = total_in;
+                p.bits_ = strm.data_type & 7;
+                if ( total_out > 0 )
+                {
+                    // reorder the ring buffer
+                    const std::size_t left = strm.avail_out;
+                    p.window_.reserve( WINDOW_SIZE );
+                    p.window_.append( reinterpret_cast< const char * >( window.data() ) + WINDOW_SIZE - left, left );
+                    p.window_.append( reinterpret_cast< const char * >( window.data() ), WINDOW_SIZE - left );
+                }
+                M_points.push_back( p );
+                last = total_out;
+            }
+        } while ( strm.avail_in != 0 );
+
+    } while ( ret != Z_STREAM_END
+              && ret != Z_MEM_ERROR
+              && ret != Z_DATA_ERROR );
+
+    inflateEnd( &strm );
+    std::fclose( fp );
+
+    if ( ret != Z_STREAM_END )
+    {
+        clear();
+        return false;
+    }
+
+    M_uncompressed_size = total_out;
+    return true;
+#else
+    (void)path;
+    (void)span;
+    (void)consumer;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessIndex::extract( const char * path,
+                        const unsigned long long offset,
+                        const std::size_t len,
+                        std::string & dest ) const
+{
+    GZAccessReader reader;
+    return reader.open( path, *this )
+        && reader.read( offset, len, dest );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessIndex::write( std::ostream & os ) const
+{
+    write_uint( os, M_uncompressed_size, 8 );
+    write_uint( os, M_points.size(), 8 );
+
+    for ( const Point & p : M_points )
+    {
+        write_uint( os, p.out_, 8 );
+        write_uint( os, p.in_, 8 );
+        write_uint( os, static_cast< unsigned long long >( p.bits_ ), 1 );
+
+        // windows are stored compressed if possible.
+        std::string window = p.window_;
+        bool compressed = false;
+#ifdef HAVE_LIBZ
+        if ( ! p.window_.empty() )
+        {
+            uLongf size = compressBound( static_cast< uLong >( p.window_.size() ) );
+            std::vector< Bytef > buf( size );
+            if ( compress2( buf.data(), &size,
+                            reinterpret_cast< const Bytef * >( p.window_.data() ),
+                            static_cast< uLong >( p.window_.size() ),
+                            Z_BEST_SPEED ) == Z_OK
+                 && size < p.window_.size() )
+            {
+                window.assign( reinterpret_cast< const char * >( buf.data() ), size );
+                compressed = true;
+            }
+        }
+#endif
+        write_uint( os, compressed ? 1 : 0, 1 );
+        write_uint( os, p.window_.size(), 4 );
+        write_uint( os, window.size(), 4 );
+        os.write( window.data(), window.size() );
+    }
+
+    return static_cast< bool >( os );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessIndex::read( std::istream & is )
+{
+    clear();
+
+    unsigned long long n = 0;
+    if ( ! read_uint( is, M_uncompressed_size, 8 )
+         || ! read_uint( is, n, 8 ) )
+    {
+        clear();
+        return false;
+    }
+
+    for ( unsigned long long i = 0; i < n; ++i )
+    {
+        Point p;
+        unsigned long long bits = 0, compressed = 0, size = 0, stored_size = 0;
+        if ( ! read_uint( is, p.out_, 8 )
+             || ! read_uint( is, p.in_, 8 )
+             || ! read_uint( is, bits, 1 )
+             || ! read_uint( is, compressed, 1 )
+             || ! read_uint( is, size, 4 )
+             || ! read_uint( is, stored_size, 4 )
+             || size > WINDOW_SIZE
+             || stored_size > WINDOW_SIZE * 2 )
+        {
+            clear();
+            return false;
+        }
+        p.bits_ = static_cast< int >( bits & 7 );
+
+        std::string stored( static_cast< std::size_t >( stored_size ), '\0' );
+        if ( ! is.read( &stored[0], stored.size() ) )
+        {
+            clear();
+            return false;
+        }
+
+        if ( ! compressed )
+        {
+            p.window_.swap( stored );
+        }
+        else
+        {
+#ifdef HAVE_LIBZ
+            p.window_.resize( static_cast< std::size_t >( size ) );
+            uLongf dest_size = static_cast< uLongf >( size );
+            if ( uncompress( reinterpret_cast< Bytef * >( &p.window_[0] ), &dest_size,
+                             reinterpret_cast< const Bytef * >( stored.data() ),
+                             static_cast< uLong >( stored.size() ) ) != Z_OK
+                 || dest_size != size )
+            {
+                clear();
+                return false;
+            }
+#else
+            clear();
+            return false;
+#endif
+        }
+
+        M_points.push_back( p );
+    }
+
+    return true;
+}
+
+
+/*-------------------------------------------------------------------*/
+/*!
+  \struct GZAccessReader::Impl
+  \brief the opened file and the current inflate stream
+ */
+struct GZAccessReader::Impl {
+    const GZAccessIndex * index_; //!< access points
+    std::FILE * fp_; //!< opened file
+#ifdef HAVE_LIBZ
+    z_stream strm_; //!< inflate state
+#endif
+    bool active_; //!< true if strm_ is initialized
+    bool end_; //!< true if the end of stream is reached
+
+    unsigned char input_[CHUNK_SIZE]; //!< compressed data buffer
+    std::vector< unsigned char > output_; //!< the last inflated data
+    unsigned long long out_begin_; //!< uncompressed offset of output_[0]
+    std::size_t out_size_; //!< the number of valid bytes in output_
+
+    Impl()
+        : index_( static_cast< const GZAccessIndex * >( 0 ) ),
+          fp_( static_cast< std::FILE * >( 0 ) ),
+          active_( false ),
+          end_( false ),
+          output_( GZAccessIndex::WINDOW_SIZE ),
+          out_begin_( 0 ),
+          out_size_( 0 )
+      { }
+
+    void endStream();
+    bool restart( const GZAccessIndex::Point & point );
+    bool inflateNext();
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZAccessReader::Impl::endStream()
+{
+#ifdef HAVE_LIBZ
+    if ( active_ )
+    {
+        inflateEnd( &strm_ );
+    }
+#endif
+    active_ = false;
+    end_ = false;
+    out_begin_ = 0;
+    out_size_ = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessReader::Impl::restart( const GZAccessIndex::Point & point )
+{
+    endStream();
+
+#ifdef HAVE_LIBZ
+    if ( ! seek_file( fp_, point.in_ - ( point.bits_ ? 1 : 0 ) ) )
+    {
+        return false;
+    }
+
+    std::memset( &strm_, 0, sizeof( strm_ ) );
+    if ( inflateInit2( &strm_, -15 ) != Z_OK ) // raw inflate
+    {
+        return false;
+    }
+    active_ = true;
+
+    if ( point.bits_ )
+    {
+        const int c = std::getc( fp_ );
+        if ( c == EOF
+             || inflatePrime( &strm_, point.bits_, c >> ( 8 - point.bits_ ) ) != Z_OK )
+        {
+            endStream();
+            return false;
+        }
+    }
+
+    if ( ! point.window_.empty()
+         && inflateSetDictionary( &strm_,
+                                  reinterpret_cast< const Bytef * >( point.window_.data() ),
+                                  static_cast< uInt >( point.window_.size() ) ) != Z_OK )
+    {
+        endStream();
+        return false;
+    }
+
+    out_begin_ = point.out_;
+    out_size_ = 0;
+    return true;
+#else
+    (void)point;
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief inflate the next chunk into output_
+ */
+bool
+GZAccessReader::Impl::inflateNext()
+{
+#ifdef HAVE_LIBZ
+    out_begin_ += out_size_;
+    out_size_ = 0;
+
+    if ( strm_.avail_in == 0 )
+    {
+        strm_.avail_in = static_cast< uInt >( std::fread( input_, 1, CHUNK_SIZE, fp_ ) );
+        if ( std::ferror( fp_ )
+             || strm_.avail_in == 0 )
+        {
+            return false;
+        }
+        strm_.next_in = input_;
+    }
+
+    strm_.avail_out = static_cast< uInt >( output_.size() );
+    strm_.next_out = output_.data();
+
+    const int ret = inflate( &strm_, Z_NO_FLUSH );
+    if ( ret == Z_NEED_DICT
+         || ret == Z_MEM_ERROR
+         || ret == Z_DATA_ERROR )
+    {
+        return false;
+    }
+
+    end_ = ( ret == Z_STREAM_END );
+    out_size_ = output_.size() - strm_.avail_out;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+GZAccessReader::GZAccessReader()
+    : M_impl( new Impl() )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+GZAccessReader::~GZAccessReader()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessReader::open( const char * path,
+                      const GZAccessIndex & index )
+{
+    close();
+
+    M_impl->fp_ = std::fopen( path, "rb" );
+    if ( ! M_impl->fp_ )
+    {
+        return false;
+    }
+
+    M_impl->index_ = &index;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+GZAccessReader::close()
+{
+    M_impl->endStream();
+    if ( M_impl->fp_ )
+    {
+        std::fclose( M_impl->fp_ );
+        M_impl->fp_ = static_cast< std::FILE * >( 0 );
+    }
+    M_impl->index_ = static_cast< const GZAccessIndex * >( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessReader::isOpen() const
+{
+    return M_impl->fp_ != static_cast< std::FILE * >( 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+GZAccessReader::read( const unsigned long long offset,
+                      const std::size_t len,
+                      std::string & dest )
+{
+    if ( ! M_impl->fp_
+         || M_impl->index_->empty() )
+    {
+        return false;
+    }
+
+    if ( len == 0
+         || offset >= M_impl->index_->uncompressedSize() )
+    {
+        return true;
+    }
+
+    // find the last point at or before the offset
+    const std::vector< GZAccessIndex::Point > & points = M_impl->index_->points();
+    std::size_t lo = 0, hi = points.size();
+    while ( hi - lo > 1 )
+    {
+        const std::size_t mid = ( lo + hi ) / 2;
+        if ( points[mid].out_ <= offset ) lo = mid;
+        else hi = mid;
+    }
+    const GZAccessIndex::Point & point = points[lo];
+
+    // continue the current stream if the offset is not behind the last
+    // inflated data and no closer access point exists.
+    const unsigned long long pos = M_impl->out_begin_ + M_impl->out_size_;
+    if ( ! M_impl->active_
+         || offset < M_impl->out_begin_
+         || point.out_ > pos )
+    {
+        if ( ! M_impl->restart( point ) )
+        {
+            M_impl->endStream();
+            return false;
+        }
+    }
+
+    const unsigned long long first = offset;
+    const unsigned long long last = offset + len;
+
+    while ( true )
+    {
+        const unsigned long long chunk_begin = M_impl->out_begin_;
+        const unsigned long long chunk_first = std::max( chunk_begin, first );
+        const unsigned long long chunk_last = std::min( chunk_begin + M_impl->out_size_, last );
+        if ( chunk_first < chunk_last )
+        {
+            dest.append( reinterpret_cast< const char * >( M_impl->output_.data() )
+                         + ( chunk_first - chunk_begin ),
+                         static_cast< std::size_t >( chunk_last - chunk_first ) );
+        }
+
+        if ( chunk_begin + M_impl->out_size_ >= last
+             || M_impl->end_ )
+        {
+            break;
+        }
+
+        if ( ! M_impl->inflateNext() )
+        {
+            M_impl->endStream();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
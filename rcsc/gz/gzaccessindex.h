@@ -0,0 +1,236 @@
+// -*-c++-*-
+
+/*!
+  \file gzaccessindex.h
+  \brief random access index for gzipped files Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_GZ_GZACCESSINDEX_H
+#define RCSC_GZ_GZACCESSINDEX_H
+
+#include <boost/scoped_ptr.hpp>
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class GZAccessIndex
+  \brief access points (zlib checkpoints) for random read access to a gzipped file.
+
+  An access point is recorded at a deflate block boundary about every
+  'span' bytes of the uncompressed data. Each point holds the compressed
+  offset, the bit offset and the last 32K bytes of the uncompressed data,
+  which is used as the inflate dictionary. Reading from an arbitrary
+  uncompressed offset only needs to decompress the data after the nearest
+  preceding access point.
+
+  Only a single gzip member is supported.
+ */
+class GZAccessIndex {
+public:
+
+    //! callback type to receive the uncompressed data while building the index
+    typedef std::function< void( const char *, std::size_t ) > Consumer;
+
+    //! the size of the inflate dictionary
+    static const std::size_t WINDOW_SIZE = 32768;
+
+    /*!
+      \struct Point
+      \brief access point
+     */
+    struct Point {
+        unsigned long long out_; //!< uncompressed offset
+        unsigned long long in_; //!< compressed offset of the first full byte
+        int bits_; //!< the number of bits of the previous byte used by the block, [0,7]
+        std::string window_; //!< the last WINDOW_SIZE bytes of the uncompressed data before this point
+    };
+
+private:
+
+    //! access points in the order of the uncompressed offset
+    std::vector< Point > M_points;
+
+    //! the total size of the uncompressed data
+    unsigned long long M_uncompressed_size;
+
+public:
+
+    /*!
+      \brief create an empty index
+     */
+    GZAccessIndex();
+
+    /*!
+      \brief clear all access points
+     */
+    void clear();
+
+    /*!
+      \brief check if the index has no access point
+      \return true if empty
+     */
+    bool empty() const
+      {
+          return M_points.empty();
+      }
+
+    /*!
+      \brief get the access points
+      \return const reference to the point container
+     */
+    const std::vector< Point > & points() const
+      {
+          return M_points;
+      }
+
+    /*!
+      \brief get the total size of the uncompressed data
+      \return byte size
+     */
+    unsigned long long uncompressedSize() const
+      {
+          return M_uncompressed_size;
+      }
+
+    /*!
+      \brief decompress the whole file and record the access points.
+      \param path gzipped file path
+      \param span the minimum distance between the access points in the uncompressed data
+      \param consumer if not empty, receives all uncompressed data in order
+      \return true if the whole file is successfully decompressed.
+     */
+    bool build( const char * path,
+                const std::size_t span = 1024 * 1024,
+                const Consumer & consumer = Consumer() );
+
+    /*!
+      \brief read the uncompressed data in [offset, offset + len).
+      \param path gzipped file path. must be the file used for build().
+      \param offset the start position in the uncompressed data
+      \param len the number of bytes to be read
+      \param dest the read data is appended to this string
+      \return true if no error. the read size may be less than len at the end of data.
+
+      The file is opened and the data is decompressed from the nearest access
+      point at each call. Use GZAccessReader to read several ranges.
+     */
+    bool extract( const char * path,
+                  const unsigned long long offset,
+                  const std::size_t len,
+                  std::string & dest ) const;
+
+    /*!
+      \brief write the index in the binary format
+      \param os reference to the output stream
+      \return true if successfully written
+     */
+    bool write( std::ostream & os ) const;
+
+    /*!
+      \brief read the index written by write()
+      \param is reference to the input stream
+      \return true if successfully read
+     */
+    bool read( std::istream & is );
+
+};
+
+/*!
+  \class GZAccessReader
+  \brief random reader of a gzipped file that keeps the file and the inflate state.
+
+  Consecutive reads in the increasing offset order continue the current
+  inflate stream. The stream is restarted from the nearest access point only
+  if the requested offset is behind the current position, or if an access
+  point exists between the current position and the requested offset.
+ */
+class GZAccessReader {
+private:
+
+    struct Impl; //!< pimpl idiom
+
+    //! internal implementation object
+    boost::scoped_ptr< Impl > M_impl;
+
+    // noncopyable
+    GZAccessReader( const GZAccessReader & );
+    GZAccessReader & operator=( const GZAccessReader & );
+
+public:
+
+    /*!
+      \brief create a closed reader
+     */
+    GZAccessReader();
+
+    /*!
+      \brief close the file
+     */
+    ~GZAccessReader();
+
+    /*!
+      \brief open the file
+      \param path gzipped file path. must be the file used to build the index.
+      \param index access points of the file. the object must outlive this reader.
+      \return true if the file is opened
+     */
+    bool open( const char * path,
+               const GZAccessIndex & index );
+
+    /*!
+      \brief close the file and release the inflate state
+     */
+    void close();
+
+    /*!
+      \brief check if the file is opened
+      \return true if opened
+     */
+    bool isOpen() const;
+
+    /*!
+      \brief read the uncompressed data in [offset, offset + len).
+      \param offset the start position in the uncompressed data
+      \param len the number of bytes to be read
+      \param dest the read data is appended to this string
+      \return true if no error. the read size may be less than len at the end of data.
+     */
+    bool read( const unsigned long long offset,
+               const std::size_t len,
+               std::string & dest );
+
+};
+
+}
+
+#endif
@@ -35,8 +35,10 @@
 
 #include "udp_socket.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cerrno>
+#include <cstring>
 
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
@@ -171,4 +173,77 @@ UDPSocket::readDatagram( char * buf,
     return n;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+UDPSocket::readDatagrams( char * buf,
+                          const size_t len,
+                          const int count,
+                          int * lengths )
+{
+#ifdef HAVE_RECVMMSG
+    enum { MAX_COUNT = 64 };
+
+    struct mmsghdr msgs[MAX_COUNT];
+    struct iovec iovecs[MAX_COUNT];
+    HostAddress::AddrType from_addrs[MAX_COUNT];
+
+    const int size = std::min( count, static_cast< int >( MAX_COUNT ) );
+
+    std::memset( msgs, 0, sizeof( struct mmsghdr ) * size );
+    for ( int i = 0; i < size; ++i )
+    {
+        iovecs[i].iov_base = buf + i * len;
+        iovecs[i].iov_len = len;
+        msgs[i].msg_hdr.msg_iov = &iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &from_addrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof( HostAddress::AddrType );
+    }
+
+    const int n = ::recvmmsg( fd(), msgs, size, MSG_DONTWAIT,
+                              static_cast< struct timespec * >( 0 ) );
+    if ( n == -1 )
+    {
+        if ( errno == EWOULDBLOCK )
+        {
+            return 0;
+        }
+
+        std::perror( "recvmmsg" );
+        return -1;
+    }
+
+    for ( int i = 0; i < n; ++i )
+    {
+        lengths[i] = static_cast< int >( msgs[i].msg_len );
+    }
+
+    if ( n > 0 )
+    {
+        M_peer_address.setAddress( from_addrs[n - 1] );
+    }
+
+    return n;
+#else
+    int n = 0;
+    while ( n < count )
+    {
+        const int l = readDatagram( buf + n * len, len );
+        if ( l < 0 )
+        {
+            return ( n > 0 ? n : -1 );
+        }
+        if ( l == 0 )
+        {
+            break;
+        }
+        lengths[n++] = l;
+    }
+    return n;
+#endif
+}
+
 } // end namespace
@@ -115,6 +115,23 @@ public:
                       const size_t len,
                       HostAddress * from );
 
+    /*!
+      \brief receive all pending datagram packets by one system call
+      if recvmmsg() is available. Otherwise, readDatagram() is repeated.
+      The source address of the last packet becomes the peer address.
+      \param buf buffer array for count packets. i-th packet is stored at buf + i * len.
+      \param len maximum length of each packet
+      \param count maximum number of packets
+      \param lengths array to receive the length of each packet
+      \retval 0 no packet. errno is EWOULDBLOCK
+      \retval -1 error occured
+      \return the number of received packets.
+     */
+    int readDatagrams( char * buf,
+                       const size_t len,
+                       const int count,
+                       int * lengths );
+
 };
 
 } // end namespace
@@ -47,6 +47,8 @@ private:
 
     Vector2D M_pos; //!< estimated global position
     Vector2D M_vel; //!< estimated velocity
+    int M_pos_count; //!< position accuracy count
+    int M_vel_count; //!< velocity accuracy count
 
     // not used
     BallState( const BallState & );
@@ -81,6 +83,24 @@ public:
           return M_vel;
       }
 
+    /*!
+      \brief get the position accuracy count
+      \return the number of cycles since the position was observed
+    */
+    int posCount() const
+      {
+          return M_pos_count;
+      }
+
+    /*!
+      \brief get the velocity accuracy count
+      \return the number of cycles since the velocity was observed
+    */
+    int velCount() const
+      {
+          return M_vel_count;
+      }
+
     /*!
       \brief estimate the vector of ball movement.
       \param step calculated step
@@ -40,7 +40,9 @@
 #include "player_object.h"
 #include "abstract_player_object.h"
 
+#include <rcsc/time/profiler.h>
 #include <rcsc/time/timer.h>
+#include <rcsc/thread_pool.h>
 #include <rcsc/common/logger.h>
 #include <rcsc/common/server_param.h>
 #include <rcsc/game_time.h>
@@ -48,6 +50,7 @@
 #include <algorithm>
 
 // #define DEBUG_PRINT
+// #define DEBUG_INCREMENTAL_UPDATE
 
 namespace rcsc {
 
@@ -61,10 +64,18 @@ const int MAX_STEP = 50;
 */
 InterceptTable::InterceptTable( const WorldModel & world )
     : M_world( world ),
-      M_update_time( 0, 0 )
+      M_update_time( 0, 0 ),
+      M_incremental( false ),
+      M_ball_shifted( false ),
+      M_reused_count( 0 )
 {
     M_ball_cache.reserve( MAX_STEP );
+    M_last_ball_cache.reserve( MAX_STEP );
     M_self_cache.reserve( ( MAX_STEP + 1 ) * 2 );
+    M_player_steps.reserve( 22 );
+    M_predict_results.reserve( 22 );
+    M_player_records.reserve( 22 );
+    M_last_player_records.reserve( 22 );
 
     clear();
 }
@@ -72,6 +83,49 @@ InterceptTable::InterceptTable( const WorldModel & world )
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+InterceptTable::~InterceptTable()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::setPredictionThreads( const std::size_t n_threads )
+{
+    if ( n_threads == predictionThreads() )
+    {
+        return;
+    }
+
+    if ( n_threads < 2 )
+    {
+        M_thread_pool.reset();
+    }
+    else
+    {
+        M_thread_pool.reset( new ThreadPool( n_threads ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+InterceptTable::predictionThreads() const
+{
+    return ( M_thread_pool
+             ? M_thread_pool->size()
+             : 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 InterceptTable::clear()
@@ -93,7 +147,14 @@ InterceptTable::clear()
 
     M_self_cache.clear();
 
-    M_player_map.clear();
+    M_player_steps.clear();
+    std::fill( M_teammate_step_index, M_teammate_step_index + 12, -1 );
+    std::fill( M_opponent_step_index, M_opponent_step_index + 12, -1 );
+    M_player_map_valid = false;
+
+    M_ball_shifted = false;
+    M_reused_count = 0;
+    M_player_records.clear();
 }
 
 /*-------------------------------------------------------------------*/
@@ -107,8 +168,16 @@ InterceptTable::update()
     {
         return;
     }
+
+    RCSC_PROFILE_ZONE( "InterceptTable::update" );
+
+    const GameTime last_time = M_update_time;
     M_update_time = M_world.time();
 
+    // keep the last results for the incremental update
+    M_last_ball_cache.swap( M_ball_cache );
+    M_last_player_records.swap( M_player_records );
+
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::INTERCEPT,
                   __FILE__" (update)" );
@@ -145,6 +214,9 @@ InterceptTable::update()
 
     createBallCache();
 
+    M_ball_shifted = ( M_incremental
+                       && isBallCacheShifted( last_time ) );
+
 #ifdef DEBUG
     dlog.addText( Logger::INTERCEPT,
                   "==========Intercept Predict Self==========" );
@@ -166,6 +238,16 @@ InterceptTable::update()
 
     predictTeammate();
 
+    if ( M_ball_shifted )
+    {
+        dlog.addText( Logger::INTERCEPT,
+                      "<-----Intercept incremental update. reused players = %d",
+                      M_reused_count );
+#ifdef DEBUG_INCREMENTAL_UPDATE
+        checkIncrementalUpdate();
+#endif
+    }
+
     dlog.addText( Logger::INTERCEPT,
                   "<-----Intercept Self reach step = %d. exhaust reach step = %d ",
                   M_self_reach_step,
@@ -253,7 +335,7 @@ InterceptTable::hearTeammate( const int unum,
         M_fastest_teammate = p;
         M_teammate_reach_step = step;
 
-        M_player_map[ p ] = step;
+        setPlayerStep( p, step );
 
         dlog.addText( Logger::INTERCEPT,
                       "<----- Hear Intercept Teammate  fastest reach step = %d."
@@ -316,7 +398,7 @@ InterceptTable::hearOpponent( const int unum,
         M_fastest_opponent = p;
         M_opponent_reach_step = step;
 
-        M_player_map[ p ] = step;
+        setPlayerStep( p, step );
 
         dlog.addText( Logger::INTERCEPT,
                       "<----- Hear Intercept Opponent  fastest reach step = %d."
@@ -379,6 +461,48 @@ InterceptTable::createBallCache()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+InterceptTable::isBallCacheShifted( const GameTime & last_time ) const
+{
+    //
+    // the last update must be the previous cycle in the playon mode.
+    //
+
+    if ( M_world.gameMode().type() != GameMode::PlayOn
+         || M_world.time().stopped() != 0
+         || last_time.stopped() != 0
+         || M_world.time().cycle() != last_time.cycle() + 1
+         || M_last_ball_cache.size() < 2 )
+    {
+        return false;
+    }
+
+    //
+    // the ball must follow the last prediction exactly.
+    // the ball is not perturbed if it has not been seen nor kicked,
+    // because BallObject::update() uses the same arithmetic as createBallCache().
+    //
+
+    const std::size_t size = std::min( M_ball_cache.size(), M_last_ball_cache.size() - 1 );
+    for ( std::size_t i = 0; i < size; ++i )
+    {
+        if ( M_ball_cache[i] != M_last_ball_cache[i + 1] )
+        {
+#ifdef DEBUG_PRINT
+            dlog.addText( Logger::INTERCEPT,
+                          "(InterceptTable::isBallCacheShifted) ball perturbed" );
+#endif
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 InterceptTable::predictSelf()
@@ -482,14 +606,19 @@ InterceptTable::predictTeammate()
 
     PlayerIntercept predictor( M_world, M_ball_cache );
 
+    const bool parallel = predictParallel( M_world.teammatesFromBall(),
+                                           M_world.kickableTeammate(),
+                                           10 );
+    std::size_t index = 0;
+
     for ( PlayerObject::Cont::const_iterator it = M_world.teammatesFromBall().begin(),
               end = M_world.teammatesFromBall().end();
           it != end;
-          ++it )
+          ++it, ++index )
     {
         if ( *it == M_world.kickableTeammate() )
         {
-            M_player_map[ *it ] = 0;
+            setPlayerStep( *it, 0 );
             continue;
         }
 
@@ -503,11 +632,31 @@ InterceptTable::predictTeammate()
             continue;
         }
 
-        int step = predictor.predict( **it, false );
-        int goalie_step = 1000;
+        PredictResult result;
+        if ( parallel )
+        {
+            result = M_predict_results[index];
+        }
+        else
+        {
+            predictPlayer( predictor, **it, &result );
+        }
+
+        if ( result.reused_ )
+        {
+            ++M_reused_count;
+        }
+
+        if ( M_incremental )
+        {
+            recordResult( **it, result );
+        }
+
+        int step = result.step_;
+        const int goalie_step = result.goalie_step_;
+
         if ( (*it)->goalie() )
         {
-            goalie_step = predictor.predict( **it, true );
             if ( step > goalie_step )
             {
                 step = goalie_step;
@@ -537,7 +686,7 @@ InterceptTable::predictTeammate()
             }
         }
 
-        M_player_map[ *it ] = step;
+        setPlayerStep( *it, step );
     }
 
     if ( M_second_teammate && second_min_step < 1000 )
@@ -577,14 +726,19 @@ InterceptTable::predictOpponent()
 
     PlayerIntercept predictor( M_world, M_ball_cache );
 
+    const bool parallel = predictParallel( M_world.opponentsFromBall(),
+                                           M_world.kickableOpponent(),
+                                           15 );
+    std::size_t index = 0;
+
     for ( PlayerObject::Cont::const_iterator it = M_world.opponentsFromBall().begin(),
               end = M_world.opponentsFromBall().end();
           it != end;
-          ++it )
+          ++it, ++index )
     {
         if ( *it == M_world.kickableOpponent() )
         {
-            M_player_map[ *it ] = 0;
+            setPlayerStep( *it, 0 );
             continue;
         }
 
@@ -598,10 +752,31 @@ InterceptTable::predictOpponent()
             continue;
         }
 
-        int step = predictor.predict( **it, false );
+        PredictResult result;
+        if ( parallel )
+        {
+            result = M_predict_results[index];
+        }
+        else
+        {
+            predictPlayer( predictor, **it, &result );
+        }
+
+        if ( result.reused_ )
+        {
+            ++M_reused_count;
+        }
+
+        if ( M_incremental )
+        {
+            recordResult( **it, result );
+        }
+
+        int step = result.step_;
+        const int goalie_step = result.goalie_step_;
+
         if ( (*it)->goalie() )
         {
-            int goalie_step = predictor.predict( **it, true );
             if ( goalie_step > 0
                  && step > goalie_step )
             {
@@ -627,7 +802,7 @@ InterceptTable::predictOpponent()
             }
         }
 
-        M_player_map[ *it ] = step;
+        setPlayerStep( *it, step );
     }
 
     if ( M_second_opponent && second_min_step < 1000 )
@@ -641,4 +816,333 @@ InterceptTable::predictOpponent()
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+InterceptTable::predictParallel( const PlayerObject::Cont & players,
+                                 const PlayerObject * kickable,
+                                 const int count_thr )
+{
+    if ( ! M_thread_pool
+         || players.size() < 2
+         || dlog.isEnabled( Logger::INTERCEPT ) )
+    {
+        return false;
+    }
+
+    PredictResult invalid;
+    invalid.step_ = 1000;
+    invalid.goalie_step_ = 1000;
+    invalid.reused_ = false;
+    invalid.trace_.n_turn_ = -1;
+    invalid.goalie_trace_.n_turn_ = -1;
+    M_predict_results.assign( players.size(), invalid );
+
+    //
+    // each worker handles the players with the stride of the number of workers.
+    // PlayerIntercept only reads the world model and the ball cache,
+    // and predictPlayer() only reads the last records.
+    //
+
+    const std::size_t n_tasks = std::min( M_thread_pool->size(), players.size() );
+    const PlayerIntercept predictor( M_world, M_ball_cache );
+
+    for ( std::size_t t = 0; t < n_tasks; ++t )
+    {
+        M_thread_pool->submit( [this, &players, &predictor, kickable, count_thr, n_tasks, t]()
+                               {
+                                   for ( std::size_t i = t; i < players.size(); i += n_tasks )
+                                   {
+                                       const PlayerObject * p = players[i];
+                                       if ( p == kickable
+                                            || p->posCount() >= count_thr )
+                                       {
+                                           continue;
+                                       }
+
+                                       predictPlayer( predictor, *p, &M_predict_results[i] );
+                                   }
+                               } );
+    }
+
+    M_thread_pool->wait();
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::predictPlayer( const PlayerIntercept & predictor,
+                               const PlayerObject & player,
+                               PredictResult * result ) const
+{
+    if ( findLastResult( predictor, player, result ) )
+    {
+        return;
+    }
+
+    result->step_ = predictor.predict( player, false, &result->trace_ );
+    result->goalie_trace_.n_turn_ = -1;
+    result->goalie_step_ = ( player.goalie()
+                             ? predictor.predict( player, true, &result->goalie_trace_ )
+                             : 1000 );
+    result->reused_ = false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+bool
+InterceptTable::findLastResult( const PlayerIntercept & predictor,
+                                const PlayerObject & player,
+                                PredictResult * result ) const
+{
+    if ( ! M_ball_shifted )
+    {
+        return false;
+    }
+
+    const std::vector< PlayerRecord >::const_iterator end = M_last_player_records.end();
+    std::vector< PlayerRecord >::const_iterator it = M_last_player_records.begin();
+    while ( it != end
+            && it->player_ != &player )
+    {
+        ++it;
+    }
+
+    if ( it == end
+         || it->goalie_ != player.goalie() )
+    {
+        return false;
+    }
+
+    //
+    // PlayerIntercept::shift() accepts only the results proven to be same
+    // as the full prediction. Any observation of the player changes the
+    // inputs or the bonus step, and the player is predicted again.
+    //
+
+    if ( ! predictor.shift( player, false, it->result_.trace_, &result->trace_ ) )
+    {
+        return false;
+    }
+
+    result->goalie_trace_.n_turn_ = -1;
+    result->goalie_step_ = 1000;
+    if ( player.goalie() )
+    {
+        if ( ! predictor.shift( player, true, it->result_.goalie_trace_, &result->goalie_trace_ ) )
+        {
+            return false;
+        }
+        result->goalie_step_ = result->goalie_trace_.step_;
+    }
+
+    result->step_ = result->trace_.step_;
+    result->reused_ = true;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::recordResult( const PlayerObject & player,
+                              const PredictResult & result )
+{
+    PlayerRecord r;
+    r.player_ = &player;
+    r.goalie_ = player.goalie();
+    r.result_ = result;
+
+    M_player_records.push_back( r );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+InterceptTable::checkIncrementalUpdate() const
+{
+    // the ball cache is always created from scratch.
+    // a new table has no last result, so that all players are predicted again.
+    const InterceptTable full( M_world );
+    const PlayerIntercept predictor( M_world, M_ball_cache );
+
+    int diff_count = 0;
+
+    for ( std::vector< PlayerRecord >::const_iterator it = M_player_records.begin(),
+              end = M_player_records.end();
+          it != end;
+          ++it )
+    {
+        PredictResult result;
+        full.predictPlayer( predictor, *it->player_, &result );
+
+        if ( result.step_ != it->result_.step_
+             || result.goalie_step_ != it->result_.goalie_step_ )
+        {
+            ++diff_count;
+            dlog.addText( Logger::INTERCEPT,
+                          "(checkIncrementalUpdate) %c %d %s step=%d goalie_step=%d."
+                          " full step=%d goalie_step=%d",
+                          side_char( it->player_->side() ), it->player_->unum(),
+                          it->result_.reused_ ? "reused" : "predicted",
+                          it->result_.step_, it->result_.goalie_step_,
+                          result.step_, result.goalie_step_ );
+        }
+    }
+
+    if ( diff_count > 0 )
+    {
+        std::cerr << M_world.self().unum() << ' '
+                  << M_world.time()
+                  << " (InterceptTable) incremental update differs from full recomputation. "
+                  << diff_count << std::endl;
+    }
+
+    return diff_count;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+InterceptTable::findPlayerStep( const AbstractPlayerObject * player ) const
+{
+    const int unum = player->unum();
+    if ( 1 <= unum && unum <= 11 )
+    {
+        const int * index_array = ( player->side() == M_world.ourSide()
+                                    ? M_teammate_step_index
+                                    : player->side() == M_world.theirSide()
+                                    ? M_opponent_step_index
+                                    : static_cast< const int * >( 0 ) );
+        if ( index_array
+             && index_array[unum] >= 0
+             && M_player_steps[index_array[unum]].player_ == player )
+        {
+            return index_array[unum];
+        }
+    }
+
+    // unknown uniform number, or the same uniform number is used by another object.
+    for ( std::size_t i = 0; i < M_player_steps.size(); ++i )
+    {
+        if ( M_player_steps[i].player_ == player )
+        {
+            return static_cast< int >( i );
+        }
+    }
+
+    return -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+InterceptTable::setPlayerStep( const PlayerObject * player,
+                               const int step )
+{
+    M_player_map_valid = false;
+
+    const int index = findPlayerStep( player );
+    if ( index >= 0 )
+    {
+        M_player_steps[index].step_ = step;
+        return;
+    }
+
+    M_player_steps.push_back( PlayerStep( player, step ) );
+
+    const int unum = player->unum();
+    if ( 1 <= unum && unum <= 11 )
+    {
+        int * index_array = ( player->side() == M_world.ourSide()
+                              ? M_teammate_step_index
+                              : player->side() == M_world.theirSide()
+                              ? M_opponent_step_index
+                              : static_cast< int * >( 0 ) );
+        if ( index_array
+             && index_array[unum] < 0 )
+        {
+            index_array[unum] = static_cast< int >( M_player_steps.size() ) - 1;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+InterceptTable::playerReachStep( const AbstractPlayerObject * player ) const
+{
+    if ( ! player )
+    {
+        return -1;
+    }
+
+    const int index = findPlayerStep( player );
+    return ( index >= 0
+             ? M_player_steps[index].step_
+             : -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+InterceptTable::playerReachStep( const SideID side,
+                                 const int unum ) const
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        return -1;
+    }
+
+    const int index = ( side == M_world.ourSide()
+                        ? M_teammate_step_index[unum]
+                        : side == M_world.theirSide()
+                        ? M_opponent_step_index[unum]
+                        : -1 );
+    return ( index >= 0
+             ? M_player_steps[index].step_
+             : -1 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const std::map< const AbstractPlayerObject *, int > &
+InterceptTable::playerMap() const
+{
+    if ( ! M_player_map_valid )
+    {
+        M_player_map.clear();
+        for ( std::vector< PlayerStep >::const_iterator it = M_player_steps.begin(),
+                  end = M_player_steps.end();
+              it != end;
+              ++it )
+        {
+            M_player_map[ it->player_ ] = it->step_;
+        }
+        M_player_map_valid = true;
+    }
+
+    return M_player_map;
+}
+
 }
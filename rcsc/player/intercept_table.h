@@ -32,15 +32,22 @@
 #ifndef RCSC_PLAYER_INTERCEPT_TABLE_H
 #define RCSC_PLAYER_INTERCEPT_TABLE_H
 
+#include <rcsc/player/player_object.h>
+#include <rcsc/player/player_intercept.h>
 #include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_time.h>
+#include <rcsc/types.h>
+
+#include <memory>
 #include <vector>
 #include <map>
+#include <cstddef>
 
 namespace rcsc {
 
 class AbstractPlayerObject;
-class PlayerObject;
+class PlayerType;
+class ThreadPool;
 class WorldModel;
 
 /*-------------------------------------------------------------------*/
@@ -243,6 +250,43 @@ public:
 class InterceptTable {
 private:
 
+    /*!
+      \struct PlayerStep
+      \brief intercept step of a player
+     */
+    struct PlayerStep {
+        const AbstractPlayerObject * player_; //!< player pointer
+        int step_; //!< estimated reach step
+
+        PlayerStep( const AbstractPlayerObject * player,
+                    const int step )
+            : player_( player ),
+              step_( step )
+          { }
+    };
+
+    /*!
+      \struct PredictResult
+      \brief result of PlayerIntercept::predict() for a player
+     */
+    struct PredictResult {
+        int step_; //!< normal mode step
+        int goalie_step_; //!< goalie mode step. 1000 if not goalie.
+        bool reused_; //!< true if the result of the last update is reused
+        PlayerIntercept::Trace trace_; //!< trace of the normal mode prediction
+        PlayerIntercept::Trace goalie_trace_; //!< trace of the goalie mode prediction
+    };
+
+    /*!
+      \struct PlayerRecord
+      \brief predicted result of a player kept for the next cycle
+     */
+    struct PlayerRecord {
+        const PlayerObject * player_; //!< player pointer
+        bool goalie_; //!< goalie flag
+        PredictResult result_; //!< predicted steps
+    };
+
     //! reference to the WorldModel instance
     const WorldModel & M_world;
 
@@ -251,6 +295,8 @@ private:
 
     //! ball inertia movement position cache
     std::vector< Vector2D > M_ball_cache;
+    //! ball cache used in the last update. kept for the incremental update.
+    std::vector< Vector2D > M_last_ball_cache;
 
     //! predicted min reach step for self without stamina exhaust
     int M_self_reach_step;
@@ -279,8 +325,33 @@ private:
     //! interception info cache for smart interception
     std::vector< InterceptInfo > M_self_cache;
 
-    //! all players' intercept step container. key: pointer, value: step value
-    std::map< const AbstractPlayerObject *, int > M_player_map;
+    //! all players' intercept steps in the predicted order
+    std::vector< PlayerStep > M_player_steps;
+    //! index of M_player_steps for each teammate uniform number. -1 means no entry.
+    int M_teammate_step_index[12];
+    //! index of M_player_steps for each opponent uniform number. -1 means no entry.
+    int M_opponent_step_index[12];
+
+    //! map version of M_player_steps. built on demand by playerMap().
+    mutable std::map< const AbstractPlayerObject *, int > M_player_map;
+    //! true if M_player_map is synchronized with M_player_steps
+    mutable bool M_player_map_valid;
+
+    //! worker threads for the player predictions. null means serial prediction.
+    std::unique_ptr< ThreadPool > M_thread_pool;
+    //! results of the parallel prediction. same order as the from-ball container.
+    std::vector< PredictResult > M_predict_results;
+
+    //! if true, the results of the last update are reused when the ball is not perturbed.
+    bool M_incremental;
+    //! true if M_ball_cache is the last cache moved one step forward
+    bool M_ball_shifted;
+    //! the number of players whose results are reused in this cycle
+    int M_reused_count;
+    //! observed states and results of the players predicted in this cycle
+    std::vector< PlayerRecord > M_player_records;
+    //! observed states and results of the players predicted in the last cycle
+    std::vector< PlayerRecord > M_last_player_records;
 
     // not used
     InterceptTable();
@@ -298,8 +369,57 @@ public:
       \brief destructor. nothing to do
     */
     virtual
-    ~InterceptTable()
-      { }
+    ~InterceptTable();
+
+    /*!
+      \brief set the number of threads used by the teammate/opponent predictions.
+      \param n_threads the number of threads. if less than 2, predictions are done serially.
+
+      Parallel prediction is not used while the intercept debug log is enabled,
+      so that the log messages are written in the same order.
+      The results are always same as the serial prediction.
+     */
+    void setPredictionThreads( const std::size_t n_threads );
+
+    /*!
+      \brief get the number of threads used by the predictions
+      \return the number of threads. 1 means serial prediction.
+     */
+    std::size_t predictionThreads() const;
+
+    /*!
+      \brief set the incremental update mode.
+      \param on if true, the results of the last cycle are reused if possible.
+
+      In the incremental mode, if the ball cache of this cycle is exactly
+      the last cache moved one step forward, the last results of a player
+      that has not been observed since then are decremented by one step
+      without the search. The results are reused only when the decremented
+      step is proven to be the same as the full prediction
+      (see PlayerIntercept::shift()). Other players are predicted as usual.
+     */
+    void setIncrementalUpdate( const bool on )
+      {
+          M_incremental = on;
+      }
+
+    /*!
+      \brief check if the incremental update mode is used.
+      \return true if the incremental update mode is used.
+     */
+    bool isIncrementalUpdate() const
+      {
+          return M_incremental;
+      }
+
+    /*!
+      \brief get the number of players whose last results are reused in the current cycle
+      \return the number of reused players
+     */
+    int reusedPlayerCount() const
+      {
+          return M_reused_count;
+      }
 
     /*!
       \brief recreate all interception info
@@ -410,14 +530,29 @@ public:
           return M_self_cache;
       }
 
+    /*!
+      \brief get the estimated reach step of the player
+      \param player player pointer
+      \return estimated step value. -1 if the player is not predicted.
+     */
+    int playerReachStep( const AbstractPlayerObject * player ) const;
+
+    /*!
+      \brief get the estimated reach step of the player specified by side and uniform number
+      \param side player's side
+      \param unum player's uniform number
+      \return estimated step value. -1 if the player is not predicted.
+     */
+    int playerReachStep( const SideID side,
+                         const int unum ) const;
+
     /*!
       \brief get all players' intercept step container.
+      The map is created from the internal flat container at the first call in each cycle.
+      playerReachStep() should be used instead in time critical code.
       \return map container. key: pointer, value: step value
      */
-    const std::map< const AbstractPlayerObject *, int > & playerMap() const
-      {
-          return M_player_map;
-      }
+    const std::map< const AbstractPlayerObject *, int > & playerMap() const;
 
 private:
     /*!
@@ -430,6 +565,13 @@ private:
     */
     void createBallCache();
 
+    /*!
+      \brief check if the ball cache is the last cache moved one step forward
+      \param last_time the last updated time
+      \return true if every position in the cache equals the next position in the last cache
+     */
+    bool isBallCacheShifted( const GameTime & last_time ) const;
+
     /*!
       \brief predict self interception
     */
@@ -444,6 +586,67 @@ private:
       \predict opponent interception
     */
     void predictOpponent();
+
+    /*!
+      \brief predict the reach steps of the players by the worker threads
+      \param players target players sorted by the distance from ball
+      \param kickable kickable player in players. this player is skipped.
+      \param count_thr accuracy threshold. players whose posCount() >= count_thr are skipped.
+      \return true if M_predict_results has been created.
+     */
+    bool predictParallel( const PlayerObject::Cont & players,
+                          const PlayerObject * kickable,
+                          const int count_thr );
+
+    /*!
+      \brief set the reach step of the player
+      \param player player pointer
+      \param step step value
+     */
+    void setPlayerStep( const PlayerObject * player,
+                        const int step );
+
+    /*!
+      \brief find the index of M_player_steps
+      \param player player pointer
+      \return index value. -1 if not found.
+     */
+    int findPlayerStep( const AbstractPlayerObject * player ) const;
+
+    /*!
+      \brief predict the reach steps of the player, or reuse the last result if possible
+      \param predictor predictor instance
+      \param player target player
+      \param result pointer to the variable to store the result
+     */
+    void predictPlayer( const PlayerIntercept & predictor,
+                        const PlayerObject & player,
+                        PredictResult * result ) const;
+
+    /*!
+      \brief find the result of the last update and shift it by one step
+      \param predictor predictor instance
+      \param player target player
+      \param result pointer to the variable to store the result
+      \return true if the shifted result is exact
+     */
+    bool findLastResult( const PlayerIntercept & predictor,
+                         const PlayerObject & player,
+                         PredictResult * result ) const;
+
+    /*!
+      \brief record the predicted result
+      \param player target player
+      \param result predicted result
+     */
+    void recordResult( const PlayerObject & player,
+                       const PredictResult & result );
+
+    /*!
+      \brief compare the current results with the full recomputation and write the difference to the log.
+      \return the number of players whose results are different.
+     */
+    int checkIncrementalUpdate() const;
 };
 
 }
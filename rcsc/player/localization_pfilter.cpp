@@ -44,19 +44,53 @@
 #include <rcsc/math_util.h>
 
 #include <algorithm>
+#include <vector>
 
 using std::min;
 using std::max;
 
-#define DEBUG_PROFILE
+// #define DEBUG_PROFILE
 // #define DEBUG_PROFILE_REMOVE
-#define DEBUG_PRINT
-#define DEBUG_PRINT_SHAPE
+// #define DEBUG_PRINT
+// #define DEBUG_PRINT_SHAPE
 
 // #define DEBUG_PRINT_PARTICLE
 
 namespace {
-static int g_filter_count = 0;
+static thread_local int g_filter_count = 0;
+
+//! the default number of points after resampling
+const std::size_t DEFAULT_RESAMPLE_SIZE = 50;
+
+//! the ratio of the number of particles to the number of points after resampling
+const std::size_t PARTICLE_RESAMPLE_RATE = 2;
+
+//! the minimum capacity of the point and particle arrays
+const std::size_t MIN_ARRAY_CAPACITY = 1024;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the raw random number to the noise in [-0.01, 0.01)
+*/
+inline
+double
+random_noise( const boost::uint32_t r )
+{
+    return -0.01 + 0.02 * ( r * ( 1.0 / 4294967296.0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the raw random number to the index in [0, size)
+*/
+inline
+std::size_t
+random_index( const boost::uint32_t r,
+              const std::size_t size )
+{
+    return static_cast< std::size_t >( ( static_cast< boost::uint64_t >( r ) * size ) >> 32 );
+}
+
 }
 
 namespace rcsc {
@@ -64,6 +98,186 @@ namespace rcsc {
 //! type of maerker map container
 typedef std::map< MarkerID, Vector2D > MarkerMap;
 
+/*!
+  \class PointArray
+  \brief structure of arrays container of the candidate points.
+
+  x and y coordinates are stored in the separated arrays,
+  so that the filtering loops can be vectorized by the compiler.
+*/
+class PointArray {
+private:
+    std::vector< double > M_x; //!< x coordinates
+    std::vector< double > M_y; //!< y coordinates
+
+public:
+
+    void reserve( const std::size_t n )
+      {
+          M_x.reserve( n );
+          M_y.reserve( n );
+      }
+
+    void clear()
+      {
+          M_x.clear();
+          M_y.clear();
+      }
+
+    void resize( const std::size_t n )
+      {
+          M_x.resize( n );
+          M_y.resize( n );
+      }
+
+    std::size_t size() const { return M_x.size(); }
+    bool empty() const { return M_x.empty(); }
+
+    double * x() { return M_x.data(); }
+    double * y() { return M_y.data(); }
+    const double * x() const { return M_x.data(); }
+    const double * y() const { return M_y.data(); }
+
+    Vector2D operator[]( const std::size_t i ) const
+      {
+          return Vector2D( M_x[i], M_y[i] );
+      }
+
+    Vector2D front() const { return ( *this )[0]; }
+    Vector2D back() const { return ( *this )[size() - 1]; }
+
+    void push_back( const Vector2D & p )
+      {
+          M_x.push_back( p.x );
+          M_y.push_back( p.y );
+      }
+
+    /*!
+      \brief move all points
+      \param v move vector
+     */
+    void translate( const Vector2D & v )
+      {
+          const std::size_t n = size();
+          double * px = x();
+          double * py = y();
+          for ( std::size_t i = 0; i < n; ++i )
+          {
+              px[i] += v.x;
+              py[i] += v.y;
+          }
+      }
+
+    /*!
+      \brief remove the points not contained by the sector. the order of points is kept.
+      \param sector candidate area
+     */
+    void filter( const Sector2D & sector );
+
+    /*!
+      \brief calculate the average point and the bounding box
+      \param ave_pos pointer to the variable to store the average point
+      \param min_pos pointer to the variable to store the minimum coordinates
+      \param max_pos pointer to the variable to store the maximum coordinates
+     */
+    void average( Vector2D * ave_pos,
+                  Vector2D * min_pos,
+                  Vector2D * max_pos ) const;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PointArray::filter( const Sector2D & sector )
+{
+    const std::size_t n = size();
+    double * px = x();
+    double * py = y();
+
+    double span = ( sector.angleRightEnd() - sector.angleLeftStart() ).degree();
+    if ( span < 0.0 ) span += 360.0;
+
+    std::size_t w = 0;
+
+    if ( span > 180.0 )
+    {
+        // the fast check below is valid only for the convex sector.
+        for ( std::size_t i = 0; i < n; ++i )
+        {
+            const bool inside = sector.contains( Vector2D( px[i], py[i] ) );
+            px[w] = px[i];
+            py[w] = py[i];
+            w += inside;
+        }
+        resize( w );
+        return;
+    }
+
+    const double cx = sector.center().x;
+    const double cy = sector.center().y;
+    const double min_r2 = sector.radiusMin() * sector.radiusMin();
+    const double max_r2 = sector.radiusMax() * sector.radiusMax();
+
+    // unit vectors of the left and right edges.
+    // the point is within the angle range if it is on the right side of the left edge
+    // and on the left side of the right edge.
+    const double lx = sector.angleLeftStart().cos();
+    const double ly = sector.angleLeftStart().sin();
+    const double rx = sector.angleRightEnd().cos();
+    const double ry = sector.angleRightEnd().sin();
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const double dx = px[i] - cx;
+        const double dy = py[i] - cy;
+        const double d2 = dx * dx + dy * dy;
+        const bool inside = ( ( min_r2 <= d2 )
+                              & ( d2 <= max_r2 )
+                              & ( lx * dy - ly * dx >= 0.0 )
+                              & ( dx * ry - dy * rx >= 0.0 ) );
+        // branch free compaction
+        px[w] = px[i];
+        py[w] = py[i];
+        w += inside;
+    }
+
+    resize( w );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PointArray::average( Vector2D * ave_pos,
+                     Vector2D * min_pos,
+                     Vector2D * max_pos ) const
+{
+    const std::size_t n = size();
+    const double * px = x();
+    const double * py = y();
+
+    double sum_x = 0.0, sum_y = 0.0;
+    double min_x = px[0], max_x = px[0];
+    double min_y = py[0], max_y = py[0];
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        sum_x += px[i];
+        sum_y += py[i];
+        min_x = std::min( min_x, px[i] );
+        max_x = std::max( max_x, px[i] );
+        min_y = std::min( min_y, py[i] );
+        max_y = std::max( max_y, py[i] );
+    }
+
+    ave_pos->assign( sum_x / n, sum_y / n );
+    min_pos->assign( min_x, min_y );
+    max_pos->assign( max_x, max_y );
+}
+
 /*!
   \struct LocalizeImpl
   \brief localization implementation
@@ -76,11 +290,41 @@ private:
     ObjectTable M_object_table;
 
     //! grid point container
-    std::vector< Vector2D > M_points;
+    PointArray M_points;
 
+    //! the number of points after resampling
+    std::size_t M_resample_size;
+
+    //! the number of particles after resampling
+    std::size_t M_particle_resample_size;
 
     GameTime M_particles_generate_time;
-    std::vector< Vector2D > M_particles;
+    PointArray M_particles;
+
+    //! the last self movement used by updateParticles()
+    Vector2D M_particles_last_move;
+    //! the last time of updateParticles()
+    GameTime M_particles_update_time;
+
+    //! random engine for resampling
+    boost::mt19937 M_engine;
+
+    //! raw random numbers used in the current resampling
+    std::vector< boost::uint32_t > M_random_buffer;
+
+    /*!
+      \brief grow the arrays for the current resample sizes,
+      so that the resampling does not reallocate them.
+    */
+    void reserveArrays()
+      {
+          M_points.reserve( std::max( MIN_ARRAY_CAPACITY, M_resample_size ) );
+          M_particles.reserve( std::max( MIN_ARRAY_CAPACITY, M_particle_resample_size ) );
+          // resamplePoints() uses 3 random numbers for each new point
+          M_random_buffer.reserve( std::max( M_resample_size * 3,
+                                             M_particle_resample_size * 2 ) );
+      }
+
 public:
     /*!
       \brief create landmark map and object table
@@ -89,10 +333,36 @@ public:
     explicit
     Impl()
         : M_object_table()
+        , M_resample_size( DEFAULT_RESAMPLE_SIZE )
+        , M_particle_resample_size( DEFAULT_RESAMPLE_SIZE * PARTICLE_RESAMPLE_RATE )
         , M_particles_generate_time( -1, 0 )
+        , M_particles_last_move( 0.0, 0.0 )
+        , M_particles_update_time( -1, 0 )
+        , M_engine( 49827140 )
       {
-          M_points.reserve( 1024 );
-          M_particles.reserve( 1024 );
+          reserveArrays();
+      }
+
+    /*!
+      \brief set the number of points after resampling.
+      the number of particles is also changed by PARTICLE_RESAMPLE_RATE,
+      and all arrays are grown before the next see message.
+      \param size new value. 0 is treated as 1.
+    */
+    void setResampleSize( const std::size_t size )
+      {
+          M_resample_size = std::max( static_cast< std::size_t >( 1 ), size );
+          M_particle_resample_size = M_resample_size * PARTICLE_RESAMPLE_RATE;
+          reserveArrays();
+      }
+
+    /*!
+      \brief get the number of points after resampling
+      \return the number of points
+    */
+    std::size_t resampleSize() const
+      {
+          return M_resample_size;
       }
 
     /*!
@@ -110,13 +380,13 @@ public:
       \return grid points
     */
     const
-    std::vector< Vector2D > & points() const
+    PointArray & points() const
       {
           return M_points;
       }
 
     const
-    std::vector< Vector2D > & particles() const
+    PointArray & particles() const
       {
           return M_particles;
       }
@@ -214,6 +484,13 @@ public:
                           const GameTime & current );
     void resampleParticles();
 
+    /*!
+      \brief generate the raw random numbers at once
+      \param n the number of random numbers
+      \return pointer to the top of the generated numbers
+    */
+    const boost::uint32_t * generateRandom( const std::size_t n );
+
     void averageParticles( Vector2D * ave_pos,
                            Vector2D * ave_err );
 
@@ -594,10 +871,7 @@ LocalizationPFilter::Impl::updatePointsBy( const VisualSensor::MarkerT & marker,
     int initial_size = M_points.size();
 #endif
 
-    M_points.erase( std::remove_if( M_points.begin(),
-                                    M_points.end(),
-                                    std::not1( Vector2D::IsWithin< Sector2D >( sector ) ) ),
-                    M_points.end() );
+    M_points.filter( sector );
 
 #ifdef DEBUG_PROFILE_REMOVE
     dlog.addText( Logger::WORLD,
@@ -644,45 +918,22 @@ LocalizationPFilter::Impl::averagePoints( Vector2D * ave_pos,
                   M_points.size() );
 #endif
 
-    double max_x, min_x, max_y, min_y;
+    Vector2D min_pos, max_pos;
+    M_points.average( ave_pos, &min_pos, &max_pos );
 
-    max_x = min_x = M_points.front().x;
-    max_y = min_y = M_points.front().y;
+    const double min_x = min_pos.x, max_x = max_pos.x;
+    const double min_y = min_pos.y, max_y = max_pos.y;
 
-    int count = 0;
-    const std::vector< Vector2D >::const_iterator end = M_points.end();
-    for ( std::vector< Vector2D >::const_iterator it = M_points.begin();
-          it != end;
-          ++it, ++count )
-    {
-        *ave_pos += *it;
 #ifdef DEBUG_PRINT_SHAPE
-        // display points
+    // display points
+    for ( std::size_t i = 0; i < M_points.size(); ++i )
+    {
         dlog.addCircle( Logger::WORLD,
-                        *it, 0.005,
+                        M_points[i], 0.005,
                         "#ff0000",
                         true ); // fill
-#endif
-        if ( it->x > max_x )
-        {
-            max_x = it->x;
-        }
-        else if ( it->x < min_x )
-        {
-            min_x = it->x;
-        }
-
-        if ( it->y > max_y )
-        {
-            max_y = it->y;
-        }
-        else if ( it->y < min_y )
-        {
-            min_y = it->y;
-        }
     }
-
-    *ave_pos /= static_cast< double >( count );
+#endif
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
@@ -846,12 +1097,9 @@ LocalizationPFilter::Impl::resamplePoints( const VisualSensor::MarkerT & marker,
                                            const double & self_face,
                                            const double & self_face_err )
 {
-    static boost::mt19937 s_engine( 49827140 );
-    static const size_t max_count = 50;
-
     const std::size_t count = M_points.size();
 
-    if ( count >= max_count )
+    if ( count >= M_resample_size )
     {
         return;
     }
@@ -870,51 +1118,56 @@ LocalizationPFilter::Impl::resamplePoints( const VisualSensor::MarkerT & marker,
     // x & y are generated independently.
     // result may not be within current candidate sector
 
-    boost::uniform_real<> xy_dst( -0.01, 0.01 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_real<> > xy_rng( s_engine, xy_dst );
-
-    if ( count == 1 )
-    {
-#ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (resamplePoints) only one point. regenerate randomly" );
-#endif
-
-        for ( size_t i = count; i < max_count; ++i )
-        {
-            M_points.push_back( M_points[0]
-                                + Vector2D( xy_rng(), xy_rng() ) );
-#ifdef DEBUG_PRINT_SHAPE
-            dlog.addCircle( Logger::WORLD,
-                            M_points.back(), 0.01,
-                            "#ff0000" );
-#endif
-        }
-
-        return;
-    }
+    const std::size_t n = M_resample_size - count;
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
                   __FILE__" (resamplePoints) generate %d points",
-                  (int)(max_count - count) );
+                  (int)n );
 #endif
 
-    boost::uniform_smallint<> index_dst( 0, count - 1 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_smallint<> > index_rng( s_engine, index_dst );
+    // all random numbers are generated at first.
+    // [0, n): source index, [n, 2n): x noise, [2n, 3n): y noise
+    const boost::uint32_t * r = generateRandom( n * 3 );
+
+    M_points.resize( M_resample_size );
+    double * px = M_points.x();
+    double * py = M_points.y();
 
-    for ( size_t i = count; i < max_count; ++i )
+    for ( std::size_t i = 0; i < n; ++i )
     {
-        M_points.push_back( M_points[index_rng()]
-                            + Vector2D( xy_rng(), xy_rng() ) );
+        const std::size_t src = random_index( r[i], count );
+        px[count + i] = px[src] + random_noise( r[n + i] );
+        py[count + i] = py[src] + random_noise( r[n * 2 + i] );
 #ifdef DEBUG_PRINT_SHAPE
         dlog.addCircle( Logger::WORLD,
-                        M_points.back(), 0.01,
+                        M_points[count + i], 0.01,
                         "#ff0000" );
 #endif
     }
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const boost::uint32_t *
+LocalizationPFilter::Impl::generateRandom( const std::size_t n )
+{
+    if ( M_random_buffer.size() < n )
+    {
+        M_random_buffer.resize( n );
+    }
+
+    boost::uint32_t * r = M_random_buffer.data();
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        r[i] = static_cast< boost::uint32_t >( M_engine() );
+    }
+
+    return r;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1234,35 +1487,24 @@ void
 LocalizationPFilter::Impl::updateParticles( const Vector2D & last_move,
                                             const GameTime & current )
 {
-    static Vector2D s_last_move( 0.0, 0.0 );
-    static GameTime s_last_update_time( -1, 0 );
-
     if ( ! last_move.isValid() )
     {
         M_particles.clear();
-        s_last_move.assign( 0.0, 0.0 );
+        M_particles_last_move.assign( 0.0, 0.0 );
         return;
     }
 
-    if ( s_last_update_time == current )
+    if ( M_particles_update_time == current )
     {
-        for ( std::vector< Vector2D >::iterator p = M_particles.begin();
-              p != M_particles.end();
-              ++p )
-        {
-            *p -= s_last_move;
-        }
+        M_particles.translate( last_move - M_particles_last_move );
     }
-
-    for ( std::vector< Vector2D >::iterator p = M_particles.begin();
-          p != M_particles.end();
-          ++p )
+    else
     {
-        *p += last_move;
+        M_particles.translate( last_move );
     }
 
-    s_last_move = last_move;
-    s_last_update_time = current;
+    M_particles_last_move = last_move;
+    M_particles_update_time = current;
 }
 
 /*-------------------------------------------------------------------*/
@@ -1415,10 +1657,7 @@ LocalizationPFilter::Impl::filterParticles( const VisualSensor::MarkerT & marker
     dlog.addLine( Logger::WORLD, v3, v1, "#aaaaaa" );
 #endif
 
-    M_particles.erase( std::remove_if( M_particles.begin(),
-                                       M_particles.end(),
-                                       std::not1( Vector2D::IsWithin< Sector2D >( sector ) ) ),
-                       M_particles.end() );
+    M_particles.filter( sector );
 
 #ifdef DEBUG_PRINT_PARTICLE
     dlog.addText( Logger::WORLD,
@@ -1442,29 +1681,36 @@ LocalizationPFilter::Impl::filterParticles( const VisualSensor::MarkerT & marker
 void
 LocalizationPFilter::Impl::resampleParticles()
 {
-    static boost::mt19937 s_gen( 281998167 );
+    const std::size_t count = M_particles.size();
 
-    if ( M_particles.empty()
-         || M_particles.size() >= 100 )
+    if ( count == 0
+         || count >= M_particle_resample_size )
     {
         return;
     }
 
-    boost::uniform_smallint<> dst( 0, M_particles.size() - 1 );
-    boost::variate_generator< boost::mt19937&, boost::uniform_smallint<> > rng( s_gen, dst );
+    const std::size_t n = M_particle_resample_size - count;
+
+    // [0, n): 1st index, [n, 2n): 2nd index
+    const boost::uint32_t * r = generateRandom( n * 2 );
 
-    for ( int i = M_particles.size(); i < 100; ++i )
+    M_particles.resize( M_particle_resample_size );
+    double * px = M_particles.x();
+    double * py = M_particles.y();
+
+    for ( std::size_t i = 0; i < n; ++i )
     {
-        int i0 = rng();
-        int i1 = rng();
+        const std::size_t i0 = random_index( r[i], count );
+        const std::size_t i1 = random_index( r[n + i], count );
 
-        M_particles.push_back( ( M_particles[i0] + M_particles[i1] ) * 0.5 );
+        px[count + i] = ( px[i0] + px[i1] ) * 0.5;
+        py[count + i] = ( py[i0] + py[i1] ) * 0.5;
 
 #ifdef DEBUG_PRINT_PARTICLE
         dlog.addText( Logger::WORLD,
                       __FILE__" (resampleParticles) no resampling %d %d -> (%f %f)",
-                      i0, i1,
-                      M_particles.back().x, M_particles.back().y );
+                      (int)i0, (int)i1,
+                      px[count + i], py[count + i] );
 #endif
     }
 }
@@ -1489,44 +1735,22 @@ LocalizationPFilter::Impl::averageParticles( Vector2D * ave_pos,
         return;
     }
 
-    double max_x, min_x, max_y, min_y;
+    Vector2D min_pos, max_pos;
+    M_particles.average( ave_pos, &min_pos, &max_pos );
 
-    max_x = min_x = M_particles.front().x;
-    max_y = min_y = M_particles.front().y;
+    const double min_x = min_pos.x, max_x = max_pos.x;
+    const double min_y = min_pos.y, max_y = max_pos.y;
 
-    const std::vector< Vector2D >::const_iterator end = M_particles.end();
-    for ( std::vector< Vector2D >::const_iterator it = M_particles.begin();
-          it != end;
-          ++it )
-    {
-        *ave_pos += *it;
 #ifdef DEBUG_PRINT_PARTICLE
-        // display points
+    // display points
+    for ( std::size_t i = 0; i < M_particles.size(); ++i )
+    {
         dlog.addCircle( Logger::WORLD,
-                        *it, 0.01,
+                        M_particles[i], 0.01,
                         "#00ffff",
                         true ); // fill
-#endif
-        if ( it->x > max_x )
-        {
-            max_x = it->x;
-        }
-        else if ( it->x < min_x )
-        {
-            min_x = it->x;
-        }
-
-        if ( it->y > max_y )
-        {
-            max_y = it->y;
-        }
-        else if ( it->y < min_y )
-        {
-            min_y = it->y;
-        }
     }
-
-    *ave_pos /= static_cast< double >( M_particles.size() );
+#endif
 
 #ifdef DEBUG_PRINT_PARTICLE
     dlog.addCircle( Logger::WORLD,
@@ -1568,6 +1792,26 @@ LocalizationPFilter::~LocalizationPFilter()
 
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+LocalizationPFilter::setResampleSize( const std::size_t size )
+{
+    M_impl->setResampleSize( size );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+LocalizationPFilter::resampleSize() const
+{
+    return M_impl->resampleSize();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1596,7 +1840,7 @@ LocalizationPFilter::updateBySenseBody( const BodySensor & )
 bool
 LocalizationPFilter::estimateSelfFace( const VisualSensor & see,
                                        double * self_face,
-                                       double * self_face_err ) const
+                                       double * self_face_err )
 {
     *self_face = M_impl->getFaceDirByLines( see.lines() );
 
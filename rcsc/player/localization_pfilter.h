@@ -36,6 +36,8 @@
 
 #include <boost/scoped_ptr.hpp>
 
+#include <cstddef>
+
 namespace rcsc {
 
 /*!
@@ -69,6 +71,19 @@ public:
     virtual
     ~LocalizationPFilter();
 
+    /*!
+      \brief set the number of candidate points kept after each marker filtering.
+      the number of particles is changed to twice the number of points.
+      \param size the number of points. the default value is 50.
+    */
+    void setResampleSize( const std::size_t size );
+
+    /*!
+      \brief get the number of candidate points kept after each marker filtering.
+      \return the number of points
+    */
+    std::size_t resampleSize() const;
+
 public:
 
    /*!
@@ -89,7 +104,7 @@ public:
     virtual
     bool estimateSelfFace( const VisualSensor & see,
                            double * self_face,
-                           double * self_face_err ) const;
+                           double * self_face_err );
 
     /*!
       \brief localize self position.
@@ -39,6 +39,7 @@
 #include "visual_sensor.h"
 #include "audio_sensor.h"
 #include "fullstate_sensor.h"
+#include "world_state.h"
 
 #include "player_command.h"
 #include "say_message_builder.h"
@@ -61,6 +62,7 @@
 #include <rcsc/game_time.h>
 #include <rcsc/game_mode.h>
 #include <rcsc/timer.h>
+#include <rcsc/time/profiler.h>
 #include <rcsc/version.h>
 
 #include <boost/lexical_cast.hpp>
@@ -99,6 +101,13 @@ struct PlayerAgent::Impl {
     int clang_min_; //!< supported minimal clang version
     int clang_max_; //!< supported maximal clang version
 
+    //! true if server_param message has been received
+    bool server_param_received_;
+    //! true if player_param message has been received
+    bool player_param_received_;
+    //! the number of received player_type messages
+    int player_type_count_;
+
     //! referee info
     GameMode game_mode_;
 
@@ -122,12 +131,21 @@ struct PlayerAgent::Impl {
     //! time when see is received
     TimeStamp see_time_stamp_;
 
+    //! deadline of the decision in the current cycle
+    Deadline deadline_;
+
     //! status of the see messaege arrival timing
     SeeState see_state_;
 
+    //! snapshots of the world model published for other threads
+    WorldStateBuffer world_state_;
+
     //! counter of see message arrival timing
     int see_timings_[11];
 
+    //! the last cycle when the profile is printed
+    long last_profile_cycle_;
+
     //! pointer to reserved action
     boost::shared_ptr< ArmAction > arm_action_;
 
@@ -151,7 +169,11 @@ struct PlayerAgent::Impl {
           last_decision_time_( -1, 0 ),
           current_time_( 0, 0 ),
           clang_min_( 0 ),
-          clang_max_( 0 )
+          clang_max_( 0 ),
+          server_param_received_( false ),
+          player_param_received_( false ),
+          player_type_count_( 0 ),
+          last_profile_cycle_( -1 )
       {
           for ( int i = 0; i < 11; ++i )
           {
@@ -348,6 +370,15 @@ struct PlayerAgent::Impl {
     bool isDecisionTiming( const long & msec_from_sense,
                            const int timeout_count ) const;
 
+    /*!
+      \brief update the deadline of the decision in the current cycle
+     */
+    void updateDeadline();
+
+    /*!
+      \brief print the profile zones to stdout
+     */
+    void printProfile();
 
     /*!
       \brief adjust see message timing.
@@ -631,6 +662,76 @@ PlayerAgent::Impl::isDecisionTiming( const long & msec_from_sense,
     return false;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::updateDeadline()
+{
+    // no real time limit in the offline client mode,
+    // or if the deadline is not enabled.
+    if ( agent_.config().decisionDeadlineMargin() <= 0
+         || ( 1 <= agent_.config().offlineClientNumber()
+              && agent_.config().offlineClientNumber() <= 11 ) )
+    {
+        deadline_.setUnlimited();
+        return;
+    }
+
+    const ServerParam & SP = ServerParam::i();
+    const double cycle_msec = SP.simulatorStep() * SP.slowDownFactor();
+    const double margin_msec = agent_.config().decisionDeadlineMargin() * SP.slowDownFactor();
+
+    TimeStamp start_time;
+    double budget_msec = cycle_msec - margin_msec;
+
+    if ( SP.synchMode() )
+    {
+        // 'think' message has just been received.
+        start_time.setCurrent();
+    }
+    else if ( agent_.world().seeTime() == current_time_
+              && see_state_.isSynch()
+              && see_state_.lastTiming() < SeeState::TIME_SYNC )
+    {
+        // the decision is triggered by see in the see synch mode.
+        // the timing id is the offset of see from the cycle start in 0.1 [ms].
+        start_time = see_time_stamp_;
+        budget_msec -= see_state_.lastTiming() * 0.1 * SP.slowDownFactor();
+    }
+    else if ( agent_.world().senseBodyTime() == current_time_
+              && body_time_stamp_.sec() > 0 )
+    {
+        // the cycle starts at the arrival of sense_body.
+        start_time = body_time_stamp_;
+    }
+    else
+    {
+        start_time.setCurrent();
+    }
+
+    deadline_.set( start_time, budget_msec );
+
+    dlog.addText( Logger::SYSTEM,
+                  __FILE__" (updateDeadline) remaining %.1f [ms]",
+                  deadline_.remaining() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerAgent::Impl::printProfile()
+{
+    std::cout << agent_.config().teamName() << ' '
+              << agent_.world().self().unum() << ": "
+              << current_time_
+              << " profile\n";
+    Profiler::instance().print( std::cout );
+}
+
 ///////////////////////////////////////////////////////////////////////
 
 /*-------------------------------------------------------------------*/
@@ -675,7 +776,12 @@ PlayerAgent::createConsoleClient()
     }
     else
     {
-        ptr = boost::shared_ptr< AbstractClient >( new OnlineClient() );
+        OnlineClient * client = new OnlineClient();
+        if ( config().useEpoll() )
+        {
+            client->setEventLoop( OnlineClient::EPOLL_LOOP );
+        }
+        ptr = boost::shared_ptr< AbstractClient >( client );
     }
 
     return ptr;
@@ -725,6 +831,16 @@ PlayerAgent::fullstateSensor() const
     return M_impl->fullstate_;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+boost::shared_ptr< const WorldState >
+PlayerAgent::worldState() const
+{
+    return M_impl->world_state_.latest();
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -758,6 +874,17 @@ PlayerAgent::seeTimeStamp() const
     return M_impl->see_time_stamp_;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const
+Deadline &
+PlayerAgent::deadline() const
+{
+    return M_impl->deadline_;
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1043,6 +1170,24 @@ PlayerAgent::handleTimeout( const int timeout_count,
     action();
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerAgent::parametersReceived() const
+{
+    if ( config().version() < 7.0 )
+    {
+        // parameter messages are not sent to the old version client.
+        return true;
+    }
+
+    return ( M_impl->server_param_received_
+             && M_impl->player_param_received_
+             && M_impl->player_type_count_ >= PlayerParam::i().playerTypes() );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -1131,6 +1276,10 @@ PlayerAgent::finalize()
     }
     std::printf( "\n" );
 #endif
+    if ( config().profile() )
+    {
+        M_impl->printProfile();
+    }
     std::cout << config().teamName() << ' '
               << world().self().unum() << ": "
               << "finished."
@@ -1237,7 +1386,14 @@ PlayerAgent::Impl::openDebugLog()
     filepath << agent_.config().teamName() << '-' << agent_.world().self().unum()
              << agent_.config().debugLogExt();
 
-    dlog.open( filepath.str() );
+    if ( agent_.config().debugLogBinary() )
+    {
+        dlog.openBinary( filepath.str() );
+    }
+    else
+    {
+        dlog.open( filepath.str() );
+    }
 
     if ( ! dlog.isOpen() )
     {
@@ -1963,6 +2119,7 @@ PlayerAgent::Impl::analyzePlayerType( const char * msg )
                   "===receive player_type" );
     PlayerType player_type( msg, agent_.config().version() );
     PlayerTypeSet::instance().insert( player_type );
+    ++player_type_count_;
 
     agent_.handlePlayerType();
 }
@@ -1977,6 +2134,7 @@ PlayerAgent::Impl::analyzePlayerParam( const char * msg )
     dlog.addText( Logger::SENSOR,
                   "===receive player_param" );
     PlayerParam::instance().parse( msg, agent_.config().version() );
+    player_param_received_ = true;
 
     agent_.handlePlayerParam();
 }
@@ -1992,6 +2150,7 @@ PlayerAgent::Impl::analyzeServerParam( const char * msg )
                   "===receive server_param" );
     //std::cout << msg << std::endl;
     ServerParam::instance().parse( msg, agent_.config().version() );
+    server_param_received_ = true;
     PlayerTypeSet::instance().resetDefaultType();
 
     agent_.M_worldmodel.setServerParam();
@@ -2104,6 +2263,14 @@ PlayerAgent::Impl::analyzeInit( const char * msg )
         return;
     }
 
+    agent_.M_worldmodel.setInterceptThreads( agent_.config().interceptThreads() );
+    agent_.M_worldmodel.setInterceptIncremental( agent_.config().interceptIncremental() );
+
+    if ( agent_.config().profile() )
+    {
+        Profiler::setEnabled( true );
+    }
+
     if ( agent_.config().debugFullstate()
          && ! agent_.M_fullstate_worldmodel.init( agent_.config().teamName(),
                                                   side, unum,
@@ -2303,6 +2470,8 @@ PlayerAgent::action()
     dlog.addText( Logger::SYSTEM,
                   __FILE__" (action) start" );
 
+    M_impl->updateDeadline();
+
     if ( config().offlineLogging()
          && ! ServerParam::i().synchMode() )
     {
@@ -2337,6 +2506,12 @@ PlayerAgent::action()
                                                          M_impl->current_time_ );
     }
 
+    // publish the snapshot for the decision threads
+    if ( config().publishWorldState() )
+    {
+        M_impl->world_state_.publish( M_worldmodel );
+    }
+
     // reset last action effect
     M_effector.reset();
 
@@ -2354,7 +2529,10 @@ PlayerAgent::action()
         M_impl->adjustSeeSynchSynchMode();
     }
 
-    actionImpl(); // this is pure virtual method
+    {
+        RCSC_PROFILE_ZONE( "PlayerAgent::actionImpl" );
+        actionImpl(); // this is pure virtual method
+    }
     M_impl->doArmAction();
     M_impl->doViewAction();
     M_impl->doNeckAction();
@@ -2371,6 +2549,7 @@ PlayerAgent::action()
     // ------------------------------------------------------------------------
     // compose command string, and send it to the rcssserver
     {
+        RCSC_PROFILE_ZONE( "ActionEffector::makeCommand" );
         std::ostringstream ostr;
         M_effector.makeCommand( ostr );
         const std::string str = ostr.str();
@@ -2404,6 +2583,17 @@ PlayerAgent::action()
 
     // delete all command objects and say messages
     M_effector.clearAllCommands();
+
+    // the cycle does not move while the clock is stopped,
+    // so the profile is printed only once for each cycle.
+    if ( config().profile()
+         && config().profileInterval() > 0
+         && M_impl->current_time_.cycle() > M_impl->last_profile_cycle_
+         && M_impl->current_time_.cycle() % config().profileInterval() == 0 )
+    {
+        M_impl->last_profile_cycle_ = M_impl->current_time_.cycle();
+        M_impl->printProfile();
+    }
 }
 
 /*-------------------------------------------------------------------*/
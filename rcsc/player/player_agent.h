@@ -61,6 +61,7 @@ class SoccerIntention;
 class NeckAction;
 class ViewAction;
 class VisualSensor;
+class WorldState;
 
 /*!
   \class PlayerAgent
@@ -155,6 +156,18 @@ public:
           return M_fullstate_worldmodel;
       }
 
+    /*!
+      \brief get the latest snapshot of the world model.
+      \return const pointer to the snapshot. empty if no decision has been made yet
+      or publish_world_state option is not set.
+
+      The snapshot is published just before actionImpl() in each cycle
+      only if PlayerConfig::publishWorldState() is true.
+      This method can be called from any thread, and the returned
+      snapshot is never modified.
+    */
+    boost::shared_ptr< const WorldState > worldState() const;
+
     /*!
       \brief get action effector
       \return reference to action effector
@@ -206,6 +219,15 @@ public:
     */
     const TimeStamp & seeTimeStamp() const;
 
+    /*!
+      \brief get the deadline of the decision in the current cycle
+      \return const reference to the deadline object
+
+      The deadline is updated at the beginning of action(). Actions can
+      check the remaining time and finish their search early.
+    */
+    const Deadline & deadline() const;
+
     /*!
       \brief register kick command
       \param power command argument: kick power
@@ -435,6 +457,13 @@ protected:
     virtual
     void handleExit();
 
+    /*!
+      \brief check if the parameter messages have been received.
+      \return true if server_param, player_param and all player_type messages have been received.
+    */
+    virtual
+    bool parametersReceived() const;
+
     //
     //
     //
@@ -80,12 +80,15 @@ PlayerConfig::setDefaultParam()
 
     M_interval_msec = 10;
     M_server_wait_seconds = 5;
+    M_use_epoll = false;
 
     M_wait_time_thr_synch_view = 79;
     M_wait_time_thr_nosynch_view = 75;
 
     M_normal_view_time_thr = 15;
 
+    M_decision_deadline_margin = 0;
+
     M_rcssserver_host = "localhost";
     M_rcssserver_port = 6000;
 
@@ -116,6 +119,14 @@ PlayerConfig::setDefaultParam()
     M_player_vel_count_thr = 5;
     M_player_face_count_thr = 2;
 
+    M_intercept_threads = 1;
+    M_intercept_incremental = false;
+
+    M_profile = false;
+    M_profile_interval = 0;
+
+    M_publish_world_state = false;
+
     // formation param
     M_player_number = 0;
 
@@ -149,6 +160,7 @@ PlayerConfig::setDefaultParam()
     // debug logging
     //
     M_debug_log_ext = ".log";
+    M_debug_log_binary = false;
 
     M_debug_system = false;
     M_debug_sensor = false;
@@ -191,12 +203,17 @@ PlayerConfig::createParamMap()
 
         ( "interval_msec", "", &M_interval_msec )
         ( "server_wait_seconds", "", &M_server_wait_seconds )
+        ( "use_epoll", "", &M_use_epoll,
+          "use epoll and recvmmsg to receive all pending server messages at once." )
 
         ( "wait_time_thr_synch_view", "", &M_wait_time_thr_synch_view )
         ( "wait_time_thr_nosynch_view","", &M_wait_time_thr_nosynch_view )
 
         ( "normal_view_time_thr", "", &M_normal_view_time_thr )
 
+        ( "decision_deadline_margin", "", &M_decision_deadline_margin,
+          "the safety margin [ms] before the end of cycle for the decision deadline. if 0, the decision is not limited." )
+
         ( "host", "h", &M_rcssserver_host )
         ( "port", "p", &M_rcssserver_port )
 
@@ -223,6 +240,17 @@ PlayerConfig::createParamMap()
         ( "player_vel_count_thr", "", &M_player_vel_count_thr )
         ( "player_face_count_thr", "", &M_player_face_count_thr )
 
+        ( "intercept_threads", "", &M_intercept_threads,
+          "the number of threads used by the intercept prediction. 1 means serial prediction." )
+        ( "intercept_incremental", "", &M_intercept_incremental,
+          "reuse the last intercept results of the unobserved players when they are exact." )
+        ( "profile", "", &M_profile,
+          "record the elapsed time of the profile zones." )
+        ( "profile_interval", "", &M_profile_interval,
+          "print the profile every this cycles. if 0, print only at exit." )
+        ( "publish_world_state", "", &M_publish_world_state,
+          "publish the snapshot of the world model for other threads in each cycle." )
+
         ( "player_number", "n",  &M_player_number, "specifies the player's position number (not a uniform number)." )
 
         ( "config_dir", "", &M_config_dir )
@@ -240,6 +268,8 @@ PlayerConfig::createParamMap()
         ( "offline_client_number", "", &M_offline_client_number )
 
         ( "debug_log_ext", "", &M_debug_log_ext )
+        ( "debug_log_binary", "", BoolSwitch( &M_debug_log_binary ),
+          "record the debug log in the binary format. use rcsclog2txt to convert it." )
 
         ( "debug_system", "", BoolSwitch( &M_debug_system ) )
         ( "debug_sensor", "", BoolSwitch( &M_debug_sensor ) )
@@ -58,6 +58,7 @@ private:
 
     int M_interval_msec; //!< timeout interval
     int M_server_wait_seconds; //!< time to wait server message
+    bool M_use_epoll; //!< if true, the online client loop uses epoll and recvmmsg
 
     //! msec threshold for action decision timing when see sync
     int M_wait_time_thr_synch_view;
@@ -67,6 +68,9 @@ private:
     //! msec threshold for normal view width when manual see sync
     int M_normal_view_time_thr;
 
+    //! msec margin before the end of cycle for the decision deadline. 0 means no deadline.
+    int M_decision_deadline_margin;
+
     std::string M_rcssserver_host; //!< host name that rcssserver is running
     int         M_rcssserver_port; //!< rcssserver connection port number
 
@@ -98,6 +102,14 @@ private:
     int M_player_vel_count_thr; //!< player velocity confidence threshold
     int M_player_face_count_thr; //!< player angle confidence threshold
 
+    int M_intercept_threads; //!< the number of threads used by the intercept table
+    bool M_intercept_incremental; //!< if true, the intercept table reuses the exact last results
+
+    bool M_profile; //!< if true, the profile zones are recorded
+    int M_profile_interval; //!< the profile is printed every this cycles. 0 means only at exit.
+
+    bool M_publish_world_state; //!< if true, the world model snapshot is published in each cycle
+
 
     //! specifies player's number independent of uniform number
     int M_player_number;
@@ -139,6 +151,7 @@ private:
     //
 
     std::string M_debug_log_ext; //!< the extension string of debug log file
+    bool M_debug_log_binary; //!< if true, the debug log is recorded in the binary format
 
     bool M_debug_system; //!< debug level flag
     bool M_debug_sensor; //!< debug level flag
@@ -240,6 +253,12 @@ public:
      */
     int serverWaitSeconds() const { return M_server_wait_seconds; }
 
+    /*!
+      \brief check if the online client loop uses epoll instead of select
+      \return true if epoll is used
+     */
+    bool useEpoll() const { return M_use_epoll; }
+
     /*!
       \brief get the maximum time to wait see message for synch view mode
       \return wait time in milli-seconds
@@ -258,6 +277,12 @@ public:
      */
     int normalViewTimeThr() const { return M_normal_view_time_thr; }
 
+    /*!
+      \brief get the safety margin of the decision deadline
+      \return margin time in milli-seconds. 0 means no deadline.
+     */
+    int decisionDeadlineMargin() const { return M_decision_deadline_margin; }
+
     /*!
       \brief get the server host name string
       \return server host name string
@@ -380,6 +405,36 @@ public:
      */
     int playerFaceCountThr() const { return M_player_face_count_thr; }
 
+    /*!
+      \brief get the number of threads used by the intercept table
+      \return the number of threads. if less than 2, intercept is predicted serially.
+     */
+    int interceptThreads() const { return M_intercept_threads; }
+
+    /*!
+      \brief check if the intercept table uses the incremental update
+      \return true if the last results are reused when the ball is not perturbed.
+     */
+    bool interceptIncremental() const { return M_intercept_incremental; }
+
+    /*!
+      \brief check if the profile zones are recorded
+      \return true if the profiler is enabled
+     */
+    bool profile() const { return M_profile; }
+
+    /*!
+      \brief get the interval of the profile output
+      \return cycle interval. if 0, the profile is printed only at exit.
+     */
+    int profileInterval() const { return M_profile_interval; }
+
+    /*!
+      \brief check if the world model snapshot is published for other threads
+      \return true if PlayerAgent::worldState() is updated in each cycle
+     */
+    bool publishWorldState() const { return M_publish_world_state; }
+
     /*!
       \brief get the player number (not a uniform number)
       \return player number
@@ -475,6 +530,12 @@ public:
      */
     const std::string & debugLogExt() const { return M_debug_log_ext; }
 
+    /*!
+      \brief check if the debug log is recorded in the binary format.
+      \return true if the binary format is used.
+     */
+    bool debugLogBinary() const { return M_debug_log_binary; }
+
     /*!
       \brief get the debug flag
       \return debug flag
@@ -0,0 +1,319 @@
+// -*-c++-*-
+
+/*!
+  \file player_filter.h
+  \brief statically composed player predicates Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_FILTER_H
+#define RCSC_PLAYER_PLAYER_FILTER_H
+
+#include <rcsc/player/abstract_player_object.h>
+#include <rcsc/player/player_object_pool.h>
+
+#include <cstddef>
+
+namespace rcsc {
+
+/*
+  The filters in this file are the compile time version of
+  AndPlayerPredicate, OrPlayerPredicate and NotPlayerPredicate.
+  The children are held by value, so that the whole predicate tree is
+  a single object on the stack and its calls can be inlined.
+
+  Any function object that takes const AbstractPlayerObject & can be a
+  child, including the predicate classes in player_predicate.h and lambda
+  expressions. e.g.
+
+  \code
+  const auto filter = and_player_filter( TeammatePlayerPredicate( wm ),
+                                         CoordinateAccuratePlayerPredicate( 3 ),
+                                         not_player_filter( GoaliePlayerPredicate() ) );
+  PlayerObjectBuffer<> players;
+  wm.getPlayersIf( filter, players );
+  \endcode
+*/
+
+/*!
+  \class AndPlayerFilter
+  \brief logical "and" of two filters
+*/
+template < typename P1, typename P2 >
+class AndPlayerFilter {
+private:
+    P1 M_p1; //!< 1st filter
+    P2 M_p2; //!< 2nd filter
+
+public:
+    /*!
+      \brief construct with 2 filters
+      \param p1 1st filter
+      \param p2 2nd filter
+    */
+    AndPlayerFilter( const P1 & p1,
+                     const P2 & p2 )
+        : M_p1( p1 ),
+          M_p2( p2 )
+      { }
+
+    /*!
+      \brief predicate function
+      \param p const reference to the target player object
+      \return the result of "and" operation. the 2nd filter is not called if the 1st one fails.
+    */
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return M_p1( p ) && M_p2( p );
+      }
+};
+
+/*!
+  \class OrPlayerFilter
+  \brief logical "or" of two filters
+*/
+template < typename P1, typename P2 >
+class OrPlayerFilter {
+private:
+    P1 M_p1; //!< 1st filter
+    P2 M_p2; //!< 2nd filter
+
+public:
+    /*!
+      \brief construct with 2 filters
+      \param p1 1st filter
+      \param p2 2nd filter
+    */
+    OrPlayerFilter( const P1 & p1,
+                    const P2 & p2 )
+        : M_p1( p1 ),
+          M_p2( p2 )
+      { }
+
+    /*!
+      \brief predicate function
+      \param p const reference to the target player object
+      \return the result of "or" operation. the 2nd filter is not called if the 1st one succeeds.
+    */
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return M_p1( p ) || M_p2( p );
+      }
+};
+
+/*!
+  \class NotPlayerFilter
+  \brief logical "not" of a filter
+*/
+template < typename P >
+class NotPlayerFilter {
+private:
+    P M_p; //!< filter
+
+public:
+    /*!
+      \brief construct with the filter
+      \param p filter
+    */
+    explicit
+    NotPlayerFilter( const P & p )
+        : M_p( p )
+      { }
+
+    /*!
+      \brief predicate function
+      \param p const reference to the target player object
+      \return the logical "not" result of the filter
+    */
+    bool operator()( const AbstractPlayerObject & p ) const
+      {
+          return ! M_p( p );
+      }
+};
+
+/*!
+  \brief create the "and" filter of 2 filters
+  \param p1 1st filter
+  \param p2 2nd filter
+  \return filter object
+*/
+template < typename P1, typename P2 >
+inline
+AndPlayerFilter< P1, P2 >
+and_player_filter( const P1 & p1,
+                   const P2 & p2 )
+{
+    return AndPlayerFilter< P1, P2 >( p1, p2 );
+}
+
+/*!
+  \brief create the "and" filter of 3 or more filters. the filters are evaluated from left to right.
+  \param p1 1st filter
+  \param p2 2nd filter
+  \param rest other filters
+  \return filter object
+*/
+template < typename P1, typename P2, typename... Rest >
+inline
+auto
+and_player_filter( const P1 & p1,
+                   const P2 & p2,
+                   const Rest &... rest )
+    -> decltype( and_player_filter( AndPlayerFilter< P1, P2 >( p1, p2 ), rest... ) )
+{
+    return and_player_filter( AndPlayerFilter< P1, P2 >( p1, p2 ), rest... );
+}
+
+/*!
+  \brief create the "or" filter of 2 filters
+  \param p1 1st filter
+  \param p2 2nd filter
+  \return filter object
+*/
+template < typename P1, typename P2 >
+inline
+OrPlayerFilter< P1, P2 >
+or_player_filter( const P1 & p1,
+                  const P2 & p2 )
+{
+    return OrPlayerFilter< P1, P2 >( p1, p2 );
+}
+
+/*!
+  \brief create the "or" filter of 3 or more filters. the filters are evaluated from left to right.
+  \param p1 1st filter
+  \param p2 2nd filter
+  \param rest other filters
+  \return filter object
+*/
+template < typename P1, typename P2, typename... Rest >
+inline
+auto
+or_player_filter( const P1 & p1,
+                  const P2 & p2,
+                  const Rest &... rest )
+    -> decltype( or_player_filter( OrPlayerFilter< P1, P2 >( p1, p2 ), rest... ) )
+{
+    return or_player_filter( OrPlayerFilter< P1, P2 >( p1, p2 ), rest... );
+}
+
+/*!
+  \brief create the "not" filter
+  \param p filter
+  \return filter object
+*/
+template < typename P >
+inline
+NotPlayerFilter< P >
+not_player_filter( const P & p )
+{
+    return NotPlayerFilter< P >( p );
+}
+
+/*!
+  \class PlayerObjectBuffer
+  \brief fixed capacity container of the player pointers.
+
+  The default capacity is enough for all players in WorldModel, i.e. self
+  and every player object in PlayerObjectPool. A player pushed into a full
+  buffer is dropped and truncated() becomes true.
+*/
+template < std::size_t N = PlayerObjectPool::CAPACITY + 1 >
+class PlayerObjectBuffer {
+public:
+    typedef const AbstractPlayerObject * value_type;
+    typedef const value_type * const_iterator;
+
+private:
+    value_type M_players[N]; //!< storage
+    std::size_t M_size; //!< the number of elements
+    bool M_truncated; //!< true if some players have been dropped
+
+public:
+    /*!
+      \brief create an empty buffer
+    */
+    PlayerObjectBuffer()
+        : M_size( 0 )
+        , M_truncated( false )
+      { }
+
+    /*!
+      \brief get the capacity
+      \return the maximal number of elements
+    */
+    static
+    std::size_t capacity()
+      {
+          return N;
+      }
+
+    std::size_t size() const { return M_size; }
+    bool empty() const { return M_size == 0; }
+    bool full() const { return M_size == N; }
+
+    /*!
+      \brief check if some players have been dropped because the buffer was full
+      \return true if push_back() has failed after the last clear()
+    */
+    bool truncated() const { return M_truncated; }
+
+    const_iterator begin() const { return M_players; }
+    const_iterator end() const { return M_players + M_size; }
+
+    value_type operator[]( const std::size_t i ) const { return M_players[i]; }
+    value_type front() const { return M_players[0]; }
+    value_type back() const { return M_players[M_size - 1]; }
+
+    /*!
+      \brief remove all elements
+    */
+    void clear()
+      {
+          M_size = 0;
+          M_truncated = false;
+      }
+
+    /*!
+      \brief append the player
+      \param p player pointer
+      \return false if the buffer is full. the player is dropped.
+    */
+    bool push_back( const AbstractPlayerObject * p )
+      {
+          if ( M_size == N )
+          {
+              M_truncated = true;
+              return false;
+          }
+          M_players[M_size++] = p;
+          return true;
+      }
+};
+
+}
+
+#endif
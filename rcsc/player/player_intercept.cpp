@@ -145,9 +145,29 @@ PlayerIntercept::PlayerIntercept( const WorldModel & world,
 int
 PlayerIntercept::predict( const PlayerObject & player,
                           const bool goalie ) const
+{
+    return predict( player, goalie, static_cast< Trace * >( 0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+int
+PlayerIntercept::predict( const PlayerObject & player,
+                          const bool goalie,
+                          Trace * trace ) const
 {
     const PlayerType * ptype = player.playerTypePtr();
 
+    if ( trace )
+    {
+        trace->step_ = 1000;
+        trace->n_turn_ = -1;
+        trace->inertia_ = false;
+        trace->ptype_ = ptype;
+    }
+
     if ( ! ptype )
     {
         std::cerr << __FILE__ << ' ' << __LINE__
@@ -174,6 +194,17 @@ PlayerIntercept::predict( const PlayerObject & player,
     const int min_step = estimateMinStep( data );
     const int max_step = M_ball_cache.size() - 1;
 
+    if ( trace )
+    {
+        trace->min_step_ = min_step;
+        trace->pos_ = data.pos_;
+        trace->vel_ = data.vel_;
+        trace->player_vel_ = player.vel();
+        trace->body_ = player.body().degree();
+        trace->control_area_ = data.control_area_;
+        trace->bonus_step_ = data.bonus_step_;
+    }
+
 #ifdef DEBUG
     dlog.addText( Logger::INTERCEPT,
                   "Intercept Player %c %d (%.1f %.1f) - min=%d max=%d pos=(%.1f %.1f) bonus=%d penalty=%d",
@@ -227,15 +258,26 @@ PlayerIntercept::predict( const PlayerObject & player,
             continue;
         }
 
+        int n_turn = 0;
+        bool inertia = false;
         if ( canReachAfterTurnDash( data,
                                     ball_pos,
-                                    total_step ) )
+                                    total_step,
+                                    &n_turn,
+                                    &inertia ) )
         {
 #ifdef DEBUG
             dlog.addText( Logger::INTERCEPT,
                           "--->cycle=%d  Sucess! ball(%.2f %.2f)",
                           total_step, ball_pos.x, ball_pos.y );
 #endif
+            if ( trace
+                 && data.penalty_step_ == 0 )
+            {
+                trace->step_ = total_step;
+                trace->n_turn_ = n_turn;
+                trace->inertia_ = inertia;
+            }
             return total_step;
         }
     }
@@ -258,6 +300,81 @@ PlayerIntercept::predict( const PlayerObject & player,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+PlayerIntercept::shift( const PlayerObject & player,
+                        const bool goalie,
+                        const Trace & last,
+                        Trace * trace ) const
+{
+    if ( last.n_turn_ < 0
+         || ! last.ptype_
+         || player.playerTypePtr() != last.ptype_
+         || get_penalty_step( player ) != 0 )
+    {
+        return false;
+    }
+
+    //
+    // all inputs except the bonus step must be unchanged,
+    // and the bonus step must be increased by exactly one.
+    //
+
+    const PlayerData data( player,
+                           *last.ptype_,
+                           get_pos( player ),
+                           get_vel( player ),
+                           get_control_area( player, M_world, goalie ),
+                           get_bonus_step( player, M_world.ourSide() ),
+                           0 );
+
+    if ( data.bonus_step_ != last.bonus_step_ + 1
+         || data.pos_ != last.pos_
+         || data.vel_ != last.vel_
+         || player.vel() != last.player_vel_
+         || player.body().degree() != last.body_
+         || data.control_area_ != last.control_area_ )
+    {
+        return false;
+    }
+
+    //
+    // At ( step - 1, bonus + 1 ), the inertia point and the ball position
+    // are the same as at ( step, bonus ), so are the number of turns and
+    // dashes. The reach condition is unchanged only if the turns do not
+    // consume the bonus step, and the dash or the inertia move is still
+    // possible after one step less. Every step tested before is still a
+    // failure, so the search must not start before the last search.
+    //
+
+    const int step = last.step_ - 1;
+
+    if ( last.n_turn_ > last.bonus_step_
+         || step - last.n_turn_ < 0
+         || ( last.inertia_ && step < 1 )
+         || step >= static_cast< int >( M_ball_cache.size() ) - 1 )
+    {
+        return false;
+    }
+
+    const int min_step = estimateMinStep( data );
+
+    if ( min_step + 1 < last.min_step_
+         || step < min_step )
+    {
+        return false;
+    }
+
+    *trace = last;
+    trace->step_ = step;
+    trace->min_step_ = min_step;
+    trace->bonus_step_ = data.bonus_step_;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 int
 PlayerIntercept::estimateMinStep( const PlayerData & data ) const
@@ -277,7 +394,9 @@ PlayerIntercept::estimateMinStep( const PlayerData & data ) const
 bool
 PlayerIntercept::canReachAfterTurnDash( const PlayerData & data,
                                         const Vector2D & ball_pos,
-                                        const int total_step ) const
+                                        const int total_step,
+                                        int * n_turn_result,
+                                        bool * inertia ) const
 {
     /*
       TODO
@@ -300,10 +419,12 @@ PlayerIntercept::canReachAfterTurnDash( const PlayerData & data,
         return false;
     }
 
+    *n_turn_result = n_turn;
     return canReachAfterDash( data,
                               ball_pos,
                               total_step,
-                              n_turn );
+                              n_turn,
+                              inertia );
 }
 
 /*-------------------------------------------------------------------*/
@@ -363,7 +484,8 @@ bool
 PlayerIntercept::canReachAfterDash( const PlayerData & data,
                                     const Vector2D & ball_pos,
                                     const int total_step,
-                                    const int n_turn ) const
+                                    const int n_turn,
+                                    bool * inertia ) const
 {
     Vector2D inertia_pos = data.inertiaPoint( total_step );
     Vector2D ball_rel = ball_pos - inertia_pos;
@@ -381,9 +503,11 @@ PlayerIntercept::canReachAfterDash( const PlayerData & data,
                       total_step,
                       n_turn );
 #endif
+        *inertia = true;
         return true;
     }
 
+    *inertia = false;
     int n_dash = data.ptype_.cyclesToReachDistance( dash_dist );
     int bonus_step = std::max( 0, data.bonus_step_ - n_turn );
 
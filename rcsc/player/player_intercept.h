@@ -83,6 +83,31 @@ private:
     };
 
 
+public:
+
+    /*!
+      \struct Trace
+      \brief inputs and search state of a prediction.
+
+      A trace is used to shift the result of the last cycle by one step
+      without the search. See shift().
+     */
+    struct Trace {
+        int step_; //!< step found in the search loop
+        int min_step_; //!< the first step of the search
+        int n_turn_; //!< the number of turns at step_. -1 if the result cannot be shifted.
+        bool inertia_; //!< true if the ball is reached without dash at step_
+        const PlayerType * ptype_; //!< player type
+        Vector2D pos_; //!< initial position
+        Vector2D vel_; //!< initial velocity
+        Vector2D player_vel_; //!< velocity used by the turn prediction
+        double body_; //!< body angle
+        double control_area_; //!< kickable or catchable area
+        int bonus_step_; //!< bonus step
+    };
+
+private:
+
     //! const reference to the WorldModel instance
     const WorldModel & M_world;
     //! const reference to the predicted ball position cache instance
@@ -120,6 +145,32 @@ public:
     int predict( const PlayerObject & player,
                  const bool goalie ) const;
 
+    /*!
+      \brief get predicted ball gettable cycle and record the trace
+      \param player const reference to the player object
+      \param goalie goalie mode or not
+      \param trace pointer to the variable to store the trace. may be NULL.
+      \return predicted cycle value
+    */
+    int predict( const PlayerObject & player,
+                 const bool goalie,
+                 Trace * trace ) const;
+
+    /*!
+      \brief shift the prediction of the last cycle by one step without the search.
+      \param player const reference to the player object
+      \param goalie goalie mode or not
+      \param last trace of the last cycle. the last ball cache must be
+      this ball cache moved one step back, i.e. last_cache[i + 1] == cache[i].
+      \param trace pointer to the variable to store the shifted trace
+      \return true if trace->step_ is exactly the value of predict().
+      false if the result cannot be shifted.
+    */
+    bool shift( const PlayerObject & player,
+                const bool goalie,
+                const Trace & last,
+                Trace * trace ) const;
+
 private:
 
     /*!
@@ -139,11 +190,15 @@ private:
       \param total_step total time step
       \param bonus_step bonus time step for the target player
       \param penalty_step penalty time step for the target player
+      \param n_turn pointer to the variable to store the number of turns
+      \param inertia pointer to the variable to store whether the ball is reached without dash
       \return true if player can get the ball
     */
     bool canReachAfterTurnDash( const PlayerData & data,
                                 const Vector2D & ball_pos,
-                                const int total_step ) const;
+                                const int total_step,
+                                int * n_turn,
+                                bool * inertia ) const;
 
     /*!
       \brief predict required cycle to face to the ball position
@@ -166,12 +221,14 @@ private:
       \param player_type player type parameter
       \param control_area player's ball controllable radius
       \param ball_pos ball position 'cycle' cycles later
+      \param inertia pointer to the variable to store whether the ball is reached without dash
       \return true if player can get the ball
     */
     bool canReachAfterDash( const PlayerData & data,
                             const Vector2D & ball_pos,
                             const int total_step,
-                            const int n_turn ) const;
+                            const int n_turn,
+                            bool * inertia ) const;
 
     /*!
       \brief predict player's reachable cycle to the ball final point
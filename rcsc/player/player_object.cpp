@@ -49,7 +49,7 @@ int PlayerObject::S_pos_count_thr = 30;
 int PlayerObject::S_vel_count_thr = 5;
 int PlayerObject::S_face_count_thr = 2;
 
-int PlayerObject::S_player_count = 0;
+std::atomic< int > PlayerObject::S_player_count( 0 );
 
 /*-------------------------------------------------------------------*/
 /*!
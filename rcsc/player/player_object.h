@@ -41,6 +41,7 @@
 #include <rcsc/geom/angle_deg.h>
 #include <rcsc/types.h>
 
+#include <atomic>
 #include <vector>
 #include <list>
 
@@ -70,7 +71,8 @@ private:
     static int S_face_count_thr;
 
     //! the player observation count, used as the id value for each player object.
-    static int S_player_count;
+    //! atomic because several agents may be executed in one process.
+    static std::atomic< int > S_player_count;
 
     int M_ghost_count; //!< count that this object is recognized as a ghost object.
     int M_tackle_count; //!< time count since the last tackle observation
@@ -0,0 +1,196 @@
+// -*-c++-*-
+
+/*!
+  \file player_object_pool.cpp
+  \brief fixed capacity player object storage Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "player_object_pool.h"
+
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+namespace rcsc {
+
+const std::size_t PlayerObjectPool::CAPACITY;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerObjectPool::PlayerObjectPool()
+    : M_free_size( CAPACITY )
+{
+    // the lower slots are used first
+    for ( std::size_t i = 0; i < CAPACITY; ++i )
+    {
+        M_free[i] = static_cast< Index >( CAPACITY - 1 - i );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerObjectPool::create( const PlayerObject & p,
+                          Index * index )
+{
+    if ( M_free_size == 0 )
+    {
+        std::cerr << "(PlayerObjectPool::create) no free slot." << std::endl;
+        return false;
+    }
+
+    *index = M_free[--M_free_size];
+    new ( &M_slots[*index] ) PlayerObject( p );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerObjectPool::release( const Index index )
+{
+    at( index ).~PlayerObject();
+    M_free[M_free_size++] = index;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+PlayerObjectPool::List::push_back( const PlayerObject & p )
+{
+    Index index = 0;
+    if ( ! M_pool->create( p, &index ) )
+    {
+        return false;
+    }
+
+    M_indices[M_size++] = index;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerObjectPool::List::pop_back()
+{
+    M_pool->release( M_indices[--M_size] );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+PlayerObjectPool::List::iterator
+PlayerObjectPool::List::erase( iterator pos )
+{
+    const std::size_t i = pos.pos() - M_indices;
+
+    M_pool->release( M_indices[i] );
+    std::copy( M_indices + i + 1, M_indices + M_size, M_indices + i );
+    --M_size;
+
+    return iterator( M_pool, M_indices + i );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerObjectPool::List::clear()
+{
+    for ( std::size_t i = 0; i < M_size; ++i )
+    {
+        M_pool->release( M_indices[i] );
+    }
+    M_size = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerObjectPool::List::splice( iterator pos,
+                                List & other )
+{
+    if ( &other == this
+         || other.M_size == 0 )
+    {
+        return;
+    }
+
+    const std::size_t i = pos.pos() - M_indices;
+
+    std::copy_backward( M_indices + i, M_indices + M_size, M_indices + M_size + other.M_size );
+    std::copy( other.M_indices, other.M_indices + other.M_size, M_indices + i );
+    M_size += other.M_size;
+    other.M_size = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+PlayerObjectPool::List::splice( iterator pos,
+                                List & other,
+                                iterator it )
+{
+    std::size_t i = pos.pos() - M_indices;
+    const std::size_t j = it.pos() - other.M_indices;
+    const Index index = other.M_indices[j];
+
+    std::copy( other.M_indices + j + 1, other.M_indices + other.M_size, other.M_indices + j );
+    --other.M_size;
+
+    if ( &other == this
+         && j < i )
+    {
+        --i;
+    }
+
+    std::copy_backward( M_indices + i, M_indices + M_size, M_indices + M_size + 1 );
+    M_indices[i] = index;
+    ++M_size;
+}
+
+}
@@ -0,0 +1,347 @@
+// -*-c++-*-
+
+/*!
+  \file player_object_pool.h
+  \brief fixed capacity player object storage Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_PLAYER_PLAYER_OBJECT_POOL_H
+#define RCSC_PLAYER_PLAYER_OBJECT_POOL_H
+
+#include <rcsc/player/player_object.h>
+
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class PlayerObjectPool
+  \brief preallocated contiguous storage of PlayerObject.
+
+  The objects are created in the fixed slots, and a slot is never moved
+  until the object is released. Therefore, the pointer to the object and
+  the slot index are stable while the object is alive.
+  PlayerObjectPool::List refers to the slots by their indices.
+*/
+class PlayerObjectPool {
+public:
+
+    //! the number of slots. enough for all teammates, opponents, unknown players and the players seen in one cycle.
+    static const std::size_t CAPACITY = 64;
+
+    //! slot index type
+    typedef unsigned char Index;
+
+    class List;
+
+private:
+
+    //! raw slot storage
+    typename std::aligned_storage< sizeof( PlayerObject ), alignof( PlayerObject ) >::type M_slots[CAPACITY];
+
+    //! the stack of the free slot indices
+    Index M_free[CAPACITY];
+
+    //! the number of the free slots
+    std::size_t M_free_size;
+
+    // noncopyable
+    PlayerObjectPool( const PlayerObjectPool & );
+    PlayerObjectPool & operator=( const PlayerObjectPool & );
+
+public:
+
+    /*!
+      \brief make all slots free. no object is constructed.
+     */
+    PlayerObjectPool();
+
+    /*!
+      \brief destructor. all lists must be destructed before the pool.
+     */
+    ~PlayerObjectPool()
+      { }
+
+    /*!
+      \brief get the number of the used slots
+      \return the number of the used slots
+     */
+    std::size_t size() const
+      {
+          return CAPACITY - M_free_size;
+      }
+
+    /*!
+      \brief get the object in the slot
+      \param index slot index
+      \return reference to the object
+     */
+    PlayerObject & at( const Index index )
+      {
+          return *reinterpret_cast< PlayerObject * >( &M_slots[index] );
+      }
+
+    /*!
+      \brief get the object in the slot
+      \param index slot index
+      \return const reference to the object
+     */
+    const PlayerObject & at( const Index index ) const
+      {
+          return *reinterpret_cast< const PlayerObject * >( &M_slots[index] );
+      }
+
+    /*!
+      \brief copy the object into a free slot
+      \param p copied object
+      \param index the result slot index
+      \return false if no free slot
+     */
+    bool create( const PlayerObject & p,
+                 Index * index );
+
+    /*!
+      \brief destruct the object and make the slot free
+      \param index slot index
+     */
+    void release( const Index index );
+
+};
+
+/*!
+  \class PlayerObjectPool::List
+  \brief ordered slot index list with the std::list like interface.
+
+  No operation allocates the memory. splice() moves only the index, so
+  the iterators and the pointers to the other elements are not changed
+  in the same way as std::list. However, erase(), remove_if(), splice()
+  and sort() shift the following indices, so the iterators to the
+  following elements in the modified lists are invalidated.
+*/
+class PlayerObjectPool::List {
+public:
+
+    /*!
+      \brief iterator template for the mutable and immutable access
+     */
+    template < typename T >
+    class Iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef T * pointer;
+        typedef T & reference;
+
+    private:
+        typedef typename std::conditional< std::is_const< T >::value,
+                                           const PlayerObjectPool,
+                                           PlayerObjectPool >::type Pool;
+        friend class List;
+
+        Pool * M_pool;
+        const Index * M_pos;
+
+    public:
+        Iterator()
+            : M_pool( static_cast< Pool * >( 0 ) ),
+              M_pos( static_cast< const Index * >( 0 ) )
+          { }
+
+        Iterator( Pool * pool,
+                  const Index * pos )
+            : M_pool( pool ),
+              M_pos( pos )
+          { }
+
+        //! mutable iterator to const iterator
+        template < typename U,
+                   typename = typename std::enable_if< std::is_same< const U, T >::value >::type >
+        Iterator( const Iterator< U > & other )
+            : M_pool( other.pool() ),
+              M_pos( other.pos() )
+          { }
+
+        Pool * pool() const { return M_pool; }
+        const Index * pos() const { return M_pos; }
+
+        reference operator*() const { return M_pool->at( *M_pos ); }
+        pointer operator->() const { return &M_pool->at( *M_pos ); }
+
+        Iterator & operator++() { ++M_pos; return *this; }
+        Iterator operator++( int ) { Iterator tmp( *this ); ++M_pos; return tmp; }
+        Iterator & operator--() { --M_pos; return *this; }
+        Iterator operator--( int ) { Iterator tmp( *this ); --M_pos; return tmp; }
+
+        bool operator==( const Iterator & rhs ) const { return M_pos == rhs.M_pos; }
+        bool operator!=( const Iterator & rhs ) const { return M_pos != rhs.M_pos; }
+    };
+
+    typedef Iterator< PlayerObject > iterator;
+    typedef Iterator< const PlayerObject > const_iterator;
+
+private:
+
+    //! storage
+    PlayerObjectPool * M_pool;
+
+    //! slot indices in the list order
+    Index M_indices[PlayerObjectPool::CAPACITY];
+
+    //! the number of elements
+    std::size_t M_size;
+
+    // noncopyable
+    List( const List & );
+    List & operator=( const List & );
+
+public:
+
+    /*!
+      \brief create an empty list
+      \param pool the storage of the elements
+     */
+    explicit
+    List( PlayerObjectPool & pool )
+        : M_pool( &pool ),
+          M_size( 0 )
+      { }
+
+    /*!
+      \brief release all elements
+     */
+    ~List()
+      {
+          clear();
+      }
+
+    iterator begin() { return iterator( M_pool, M_indices ); }
+    iterator end() { return iterator( M_pool, M_indices + M_size ); }
+    const_iterator begin() const { return const_iterator( M_pool, M_indices ); }
+    const_iterator end() const { return const_iterator( M_pool, M_indices + M_size ); }
+
+    std::size_t size() const { return M_size; }
+    bool empty() const { return M_size == 0; }
+
+    PlayerObject & front() { return M_pool->at( M_indices[0] ); }
+    const PlayerObject & front() const { return M_pool->at( M_indices[0] ); }
+    PlayerObject & back() { return M_pool->at( M_indices[M_size - 1] ); }
+    const PlayerObject & back() const { return M_pool->at( M_indices[M_size - 1] ); }
+
+    /*!
+      \brief copy the object into the pool and append it
+      \param p copied object
+      \return false if the pool is full
+     */
+    bool push_back( const PlayerObject & p );
+
+    /*!
+      \brief release the last element
+     */
+    void pop_back();
+
+    /*!
+      \brief release the element
+      \param pos the element to be released
+      \return iterator to the next element
+     */
+    iterator erase( iterator pos );
+
+    /*!
+      \brief release all elements
+     */
+    void clear();
+
+    /*!
+      \brief release the elements that satisfy the predicate
+      \param pred unary predicate for PlayerObject
+     */
+    template < typename Predicate >
+    void remove_if( Predicate pred )
+      {
+          std::size_t n = 0;
+          for ( std::size_t i = 0; i < M_size; ++i )
+          {
+              if ( pred( M_pool->at( M_indices[i] ) ) )
+              {
+                  M_pool->release( M_indices[i] );
+              }
+              else
+              {
+                  M_indices[n++] = M_indices[i];
+              }
+          }
+          M_size = n;
+      }
+
+    /*!
+      \brief stable sort by the comparator
+      \param comp binary predicate for PlayerObject
+     */
+    template < typename Compare >
+    void sort( Compare comp )
+      {
+          // insertion sort. stable and enough for a few dozen elements.
+          for ( std::size_t i = 1; i < M_size; ++i )
+          {
+              const Index idx = M_indices[i];
+              std::size_t j = i;
+              while ( j > 0
+                      && comp( M_pool->at( idx ), M_pool->at( M_indices[j - 1] ) ) )
+              {
+                  M_indices[j] = M_indices[j - 1];
+                  --j;
+              }
+              M_indices[j] = idx;
+          }
+      }
+
+    /*!
+      \brief move all elements of other list
+      \param pos the position in this list
+      \param other the source list. it must use the same pool.
+     */
+    void splice( iterator pos,
+                 List & other );
+
+    /*!
+      \brief move an element of other list
+      \param pos the position in this list
+      \param other the source list. it must use the same pool.
+      \param it the moved element in other
+     */
+    void splice( iterator pos,
+                 List & other,
+                 iterator it );
+
+};
+
+}
+
+#endif
@@ -40,6 +40,7 @@
 
 namespace rcsc {
 
+class AbstractPlayerObject;
 class PlayerType;
 
 /*-------------------------------------------------------------------*/
@@ -74,6 +75,10 @@ private:
 
     Card M_card; //!< player's card status
 
+    int M_pos_count; //!< position accuracy count
+    int M_vel_count; //!< velocity accuracy count
+    int M_ball_reach_step; //!< estimated ball reach step
+
 public:
 
     /*!
@@ -171,6 +176,41 @@ public:
           return M_card;
       }
 
+    /*!
+      \brief get the position accuracy count
+      \return the number of cycles since the position was observed
+     */
+    int posCount() const
+      {
+          return M_pos_count;
+      }
+
+    /*!
+      \brief get the velocity accuracy count
+      \return the number of cycles since the velocity was observed
+     */
+    int velCount() const
+      {
+          return M_vel_count;
+      }
+
+    /*!
+      \brief get the estimated ball reach step
+      \return ball reach step
+     */
+    int ballReachStep() const
+      {
+          return M_ball_reach_step;
+      }
+
+    //////////////////////////////////////////////////////////////
+
+    /*!
+      \brief copy the current state of the player object
+      \param p player object in the world model
+     */
+    void update( const AbstractPlayerObject & p );
+
     //////////////////////////////////////////////////////////////
 
     /*!
@@ -42,7 +42,7 @@
 
 namespace rcsc {
 
-bool SeeState::S_synch_see_mode = false;
+std::atomic< bool > SeeState::S_synch_see_mode( false );
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -35,6 +35,8 @@
 #include <rcsc/player/view_mode.h>
 #include <rcsc/game_time.h>
 
+#include <atomic>
+
 namespace rcsc {
 
 /*!
@@ -77,7 +79,8 @@ private:
     };
 
     //double M_protocol_version;
-    static bool S_synch_see_mode;
+    //! shared by all agents in the process
+    static std::atomic< bool > S_synch_see_mode;
 
     GameTime M_current_time; //!< update when new cycle detected
     GameTime M_last_see_time; //!< last see arrival game time
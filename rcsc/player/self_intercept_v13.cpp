@@ -120,35 +120,35 @@ SelfInterceptV13::predict( const int max_cycle,
     std::sort( self_cache.begin(), self_cache.end(), InterceptSorter() );
 
 #ifdef DEBUG_PROFILE
-    dlog.addText( Logger::INTERCEPT,
-                  __FILE__" (predict) elapsed %f [ms]",
-                  timer.elapsedReal() );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               __FILE__" (predict) elapsed %f [ms]",
+               timer.elapsedReal() );
 #endif
 
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::INTERCEPT,
-                  "(SelfIntercept) solution size = %d",
-                  self_cache.size() );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "(SelfIntercept) solution size = %d",
+               self_cache.size() );
     const std::vector< InterceptInfo >::iterator end = self_cache.end();
     for ( std::vector< InterceptInfo >::iterator it = self_cache.begin();
           it != end;
           ++it )
     {
         //Vector2D bpos = M_world.ball().inertiaPoint( it->reachCycle() );
-        dlog.addText( Logger::INTERCEPT,
-                      "(SelfIntercept) type=%d cycle=%d (turn=%d dash=%d)"
-                      " power=%.2f angle=%.1f"
-                      " self_pos=(%.2f %.2f) bdist=%.3f stamina=%.1f",
-                      it->mode(),
-                      it->reachCycle(),
-                      it->turnCycle(),
-                      it->dashCycle(),
-                      it->dashPower(),
-                      it->dashAngle().degree(),
-                      it->selfPos().x, it->selfPos().y,
-                      it->ballDist(),
-                      it->stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(SelfIntercept) type=%d cycle=%d (turn=%d dash=%d)"
+                   " power=%.2f angle=%.1f"
+                   " self_pos=(%.2f %.2f) bdist=%.3f stamina=%.1f",
+                   it->mode(),
+                   it->reachCycle(),
+                   it->turnCycle(),
+                   it->dashCycle(),
+                   it->dashPower(),
+                   it->dashAngle().degree(),
+                   it->selfPos().x, it->selfPos().y,
+                   it->ballDist(),
+                   it->stamina() );
     }
 #endif
 }
@@ -178,8 +178,8 @@ SelfInterceptV13::predictOneStep( std::vector< InterceptInfo > & self_cache ) co
              + control_area ) )
     {
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "__1 dash: too far. never reach" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "__1 dash: too far. never reach" );
 #endif
         return;
     }
@@ -225,11 +225,11 @@ SelfInterceptV13::predictNoDash( std::vector< InterceptInfo > & self_cache ) con
     if ( next_ball_dist > control_area - 0.15 - ball_noise )
     {
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "____No dash, out of control area. area=%.3f  ball_dist=%.3f  noise=%.3f",
-                      control_area,
-                      next_ball_dist,
-                      ball_noise );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "____No dash, out of control area. area=%.3f  ball_dist=%.3f  noise=%.3f",
+                   control_area,
+                   next_ball_dist,
+                   ball_noise );
 #endif
         return false;
     }
@@ -252,9 +252,9 @@ SelfInterceptV13::predictNoDash( std::vector< InterceptInfo > & self_cache ) con
                                              next_ball_dist,
                                              stamina_model.stamina() ) );
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "--->Success! No dash goalie mode: nothing to do. next_dist=%f",
-                      next_ball_dist );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "--->Success! No dash goalie mode: nothing to do. next_dist=%f",
+                   next_ball_dist );
 #endif
         return true;
     }
@@ -277,8 +277,8 @@ SelfInterceptV13::predictNoDash( std::vector< InterceptInfo > & self_cache ) con
         {
             // it has possibility that player cannot stop the ball
 #ifdef DEBUG_PRINT_ONE_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "____No dash, kickable, but maybe no control" );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "____No dash, kickable, but maybe no control" );
 #endif
             return false;
         }
@@ -299,9 +299,9 @@ SelfInterceptV13::predictNoDash( std::vector< InterceptInfo > & self_cache ) con
                                          next_ball_dist,
                                          stamina_model.stamina() ) );
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "-->Sucess! No dash, next_dist=%.3f",
-                  next_ball_dist );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "-->Sucess! No dash, next_dist=%.3f",
+               next_ball_dist );
 #endif
     return true;
 }
@@ -313,7 +313,8 @@ SelfInterceptV13::predictNoDash( std::vector< InterceptInfo > & self_cache ) con
 void
 SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) const
 {
-    static std::vector< InterceptInfo > tmp_cache;
+    // the work buffer is not shared by the agents executed in other threads.
+    thread_local std::vector< InterceptInfo > tmp_cache;
 
     const ServerParam & SP = ServerParam::i();
     const BallObject & ball = M_world.ball();
@@ -339,9 +340,9 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
                                     : dash_angle_step * static_cast< int >( 180.0 / dash_angle_step ) - 1.0 );
 
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "(predictOneDash) min_angle=%.1f max_angle=%.1f",
-                  min_dash_angle, max_dash_angle );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "(predictOneDash) min_angle=%.1f max_angle=%.1f",
+               min_dash_angle, max_dash_angle );
 #endif
 
     tmp_cache.clear();
@@ -354,9 +355,9 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
         const double dash_rate = self.dashRate() * SP.dashDirRate( dir );
 
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictOneDash) dir=%.1f angle=%.1f dash_rate=%f",
-                      dir, dash_angle.degree(), dash_rate );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictOneDash) dir=%.1f angle=%.1f dash_rate=%f",
+                   dir, dash_angle.degree(), dash_rate );
 #endif
 
         //
@@ -390,13 +391,13 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
                                        &info ) )
             {
 #ifdef DEBUG_PRINT_ONE_STEP
-                dlog.addText( Logger::INTERCEPT,
-                              "****>Register 1 dash intercept(1) mode=%d power=%.1f dir=%.1f pos=(%.1f %.1f) stamina=%.1f",
-                              info.mode(),
-                              info.dashPower(),
-                              info.dashAngle().degree(),
-                              info.selfPos().x, info.selfPos().y,
-                              info.stamina() );
+                RCSC_DLOG( Logger::INTERCEPT, addText,
+                           "****>Register 1 dash intercept(1) mode=%d power=%.1f dir=%.1f pos=(%.1f %.1f) stamina=%.1f",
+                           info.mode(),
+                           info.dashPower(),
+                           info.dashAngle().degree(),
+                           info.selfPos().x, info.selfPos().y,
+                           info.stamina() );
 #endif
                 tmp_cache.push_back( info );
                 continue;
@@ -431,22 +432,22 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
                                        &info ) )
             {
 #ifdef DEBUG_PRINT_ONE_STEP
-                dlog.addText( Logger::INTERCEPT,
-                              "****>Register 1 dash intercept(2) mode=%d power=%.1f dir=%.1f pos=(%.1f %.1f) stamina=%.1f",
-                              info.mode(),
-                              info.dashPower(),
-                              info.dashAngle().degree(),
-                              info.selfPos().x, info.selfPos().y,
-                              info.stamina() );
+                RCSC_DLOG( Logger::INTERCEPT, addText,
+                           "****>Register 1 dash intercept(2) mode=%d power=%.1f dir=%.1f pos=(%.1f %.1f) stamina=%.1f",
+                           info.mode(),
+                           info.dashPower(),
+                           info.dashAngle().degree(),
+                           info.selfPos().x, info.selfPos().y,
+                           info.stamina() );
 #endif
                 tmp_cache.push_back( info );
                 continue;
             }
         }
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "____(predictOneDash) failed. dash_angle=%.1f",
-                      dash_angle.degree() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "____(predictOneDash) failed. dash_angle=%.1f",
+                   dash_angle.degree() );
 #endif
     }
 
@@ -458,18 +459,18 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
     const double safety_ball_dist = std::max( control_area - 0.2 - ball.vel().r() * SP.ballRand(),
                                               ptype.playerSize() + SP.ballSize() + ptype.kickableMargin() * 0.4 );
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "decide best 1 step interception. size=%d safety_ball_dist=%.3f",
-                  tmp_cache.size(), safety_ball_dist );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "decide best 1 step interception. size=%d safety_ball_dist=%.3f",
+               tmp_cache.size(), safety_ball_dist );
 #endif
 
     const InterceptInfo * best = &(tmp_cache.front());
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
-                      best->turnCycle(), best->dashCycle(),
-                      best->dashPower(), best->dashAngle().degree(),
-                      best->ballDist(), best->stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
+                   best->turnCycle(), best->dashCycle(),
+                   best->dashPower(), best->dashAngle().degree(),
+                   best->ballDist(), best->stamina() );
 #endif
 
     const std::vector< InterceptInfo >::iterator end = tmp_cache.end();
@@ -478,11 +479,11 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
     for ( ; it != end; ++it )
     {
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
-                      it->turnCycle(), it->dashCycle(),
-                      it->dashPower(), it->dashAngle().degree(),
-                      it->ballDist(), it->stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
+                   it->turnCycle(), it->dashCycle(),
+                   it->dashPower(), it->dashAngle().degree(),
+                   it->ballDist(), it->stamina() );
 #endif
         if ( best->ballDist() < safety_ball_dist
              && it->ballDist() < safety_ball_dist )
@@ -491,8 +492,8 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
             {
                 best = &(*it);
 #ifdef DEBUG_PRINT_ONE_STEP
-                dlog.addText( Logger::INTERCEPT,
-                              "--> updated(1)" );
+                RCSC_DLOG( Logger::INTERCEPT, addText,
+                           "--> updated(1)" );
 #endif
             }
         }
@@ -504,20 +505,20 @@ SelfInterceptV13::predictOneDash( std::vector< InterceptInfo > & self_cache ) co
             {
                 best = &(*it);
 #ifdef DEBUG_PRINT_ONE_STEP
-                dlog.addText( Logger::INTERCEPT,
-                              "--> updated(2)" );
+                RCSC_DLOG( Logger::INTERCEPT, addText,
+                           "--> updated(2)" );
 #endif
             }
         }
     }
 
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "<<<<< Register best cycle=%d(t=%d d=%d) my_pos=(%.2f %.2f) ball_dist=%.3f stamina=%.1f",
-                  best->reachCycle(), best->turnCycle(), best->dashCycle(),
-                  best->ballDist(),
-                  best->selfPos().x, best->selfPos().y,
-                  best->stamina() );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "<<<<< Register best cycle=%d(t=%d d=%d) my_pos=(%.2f %.2f) ball_dist=%.3f stamina=%.1f",
+               best->reachCycle(), best->turnCycle(), best->dashCycle(),
+               best->ballDist(),
+               best->selfPos().x, best->selfPos().y,
+               best->stamina() );
 #endif
 
     self_cache.push_back( *best );
@@ -551,31 +552,31 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
     const double dash_rate = self.dashRate() * SP.dashDirRate( dash_dir.degree() );
 
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "(predictOneDashAdjust) dir=%.1f angle=%.1f ball_rel=(%.3f %.3f)",
-                  dash_dir.degree(),
-                  dash_angle.degree(),
-                  ball_rel.x, ball_rel.y );
-    dlog.addText( Logger::INTERCEPT,
-                  "_____ max_forward_accel=(%.3f %.3f) rel=(%.3f %.3f)",
-                  max_forward_accel.x, max_forward_accel.y,
-                  forward_accel_rel.x, forward_accel_rel.y );
-    dlog.addText( Logger::INTERCEPT,
-                  "_____ max_back_accel=(%.3f %.3f) rel=(%.3f %.3f)",
-                  max_back_accel.x, max_back_accel.y,
-                  back_accel_rel.x, back_accel_rel.y );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "(predictOneDashAdjust) dir=%.1f angle=%.1f ball_rel=(%.3f %.3f)",
+               dash_dir.degree(),
+               dash_angle.degree(),
+               ball_rel.x, ball_rel.y );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "_____ max_forward_accel=(%.3f %.3f) rel=(%.3f %.3f)",
+               max_forward_accel.x, max_forward_accel.y,
+               forward_accel_rel.x, forward_accel_rel.y );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "_____ max_back_accel=(%.3f %.3f) rel=(%.3f %.3f)",
+               max_back_accel.x, max_back_accel.y,
+               back_accel_rel.x, back_accel_rel.y );
 #endif
 
     if ( ball_rel.absY() > control_buf
          || Segment2D( forward_accel_rel, back_accel_rel ).dist( ball_rel ) > control_buf )
     {
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "__(predictOneDashAdjust) out of control area=%.3f"
-                      " ball_absY=%.3f forward_dist=%.3f back_dist=%.3f",
-                      control_buf, ball_rel.absY(),
-                      ball_rel.dist( forward_accel_rel ),
-                      ball_rel.dist( back_accel_rel ) );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "__(predictOneDashAdjust) out of control area=%.3f"
+                   " ball_absY=%.3f forward_dist=%.3f back_dist=%.3f",
+                   control_buf, ball_rel.absY(),
+                   ball_rel.dist( forward_accel_rel ),
+                   ball_rel.dist( back_accel_rel ) );
 #endif
         return false;
     }
@@ -594,9 +595,9 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
                                           forward_accel_rel.x,
                                           back_accel_rel.x );
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "__(predictOneDashAdjust) (1). dash power=%.1f",
-                      dash_power );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "__(predictOneDashAdjust) (1). dash power=%.1f",
+                   dash_power );
 #endif
     }
 
@@ -612,9 +613,9 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
             // at least, reach the controllale distance
             dash_power = forward_accel_rel.x / dash_rate;
 #ifdef DEBUG_PRINT_ONE_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "__(predictOneDashAdjust) (2). Not Best. next_ball_dist=%.3f power=%.1f",
-                          enable_ball_dist, dash_power );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "__(predictOneDashAdjust) (2). Not Best. next_ball_dist=%.3f power=%.1f",
+                       enable_ball_dist, dash_power );
 #endif
         }
     }
@@ -630,9 +631,9 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
         {
             dash_power = back_accel_rel.x / dash_rate;
 #ifdef DEBUG_PRINT_ONE_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "__(predictOneDashAdjust) (3). Not Best next_ball_dist=%.3f power=%.1f",
-                          enable_ball_dist, dash_power );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "__(predictOneDashAdjust) (3). Not Best next_ball_dist=%.3f power=%.1f",
+                       enable_ball_dist, dash_power );
 #endif
         }
     }
@@ -646,9 +647,9 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
     {
         dash_power = ball_rel.x / dash_rate;
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "__(predictOneDashAdjust) (4). Not Best. just adjust X. power=%.1f",
-                      dash_power );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "__(predictOneDashAdjust) (4). Not Best. just adjust X. power=%.1f",
+                   dash_power );
 #endif
     }
 
@@ -658,8 +659,8 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
     if ( dash_power < -999.0 )
     {
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "__(predictOneDashAdjust) XXX Failed" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "__(predictOneDashAdjust) XXX Failed" );
 #endif
         return false;
     }
@@ -690,15 +691,15 @@ SelfInterceptV13::predictOneDashAdjust( const AngleDeg & dash_angle,
                            stamina_model.stamina() );
 
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "__*** (predictOneDashAdjust) --->Success! power=%.3f rel_dir=%.1f angle=%.1f"
-                  " my_pos=(%.2f %.2f) ball_dist=%.3f stamina=%.1f",
-                  info->dashPower(),
-                  info->dashAngle().degree(),
-                  dash_angle.degree(),
-                  my_pos.x, my_pos.y,
-                  info->ballDist(),
-                  stamina_model.stamina() );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "__*** (predictOneDashAdjust) --->Success! power=%.3f rel_dir=%.1f angle=%.1f"
+               " my_pos=(%.2f %.2f) ball_dist=%.3f stamina=%.1f",
+               info->dashPower(),
+               info->dashAngle().degree(),
+               dash_angle.degree(),
+               my_pos.x, my_pos.y,
+               info->ballDist(),
+               stamina_model.stamina() );
 #endif
     return true;
 }
@@ -728,11 +729,11 @@ SelfInterceptV13::getOneStepDashPower( const Vector2D & next_ball_rel,
         + ServerParam::i().ballSize();
 
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "_______(getOneStepDashPower) best_ctrl_dist_f=%.3f best_ctrl_dist_b=%.3f next_ball_y=%.3f",
-                  best_ctrl_dist_forward,
-                  best_ctrl_dist_backward,
-                  next_ball_rel.y );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "_______(getOneStepDashPower) best_ctrl_dist_f=%.3f best_ctrl_dist_b=%.3f next_ball_y=%.3f",
+               best_ctrl_dist_forward,
+               best_ctrl_dist_backward,
+               next_ball_rel.y );
 #endif
 
     // Y diff is longer than best distance.
@@ -740,8 +741,8 @@ SelfInterceptV13::getOneStepDashPower( const Vector2D & next_ball_rel,
     if ( next_ball_rel.absY() > best_ctrl_dist_forward )
     {
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "________(getOneStepDashPower) just put the ball on side" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "________(getOneStepDashPower) just put the ball on side" );
 #endif
         return next_ball_rel.x / dash_rate;
     }
@@ -786,11 +787,11 @@ SelfInterceptV13::getOneStepDashPower( const Vector2D & next_ball_rel,
     if ( min_power < 1000.0 )
     {
 #ifdef DEBUG_PRINT_ONE_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "________(getOneStepDashPower) best trap."
-                      " accel_x=%.3f power==%.3f",
-                      best_accel_x,
-                      min_power );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "________(getOneStepDashPower) best trap."
+                   " accel_x=%.3f power==%.3f",
+                   best_accel_x,
+                   min_power );
 #endif
         return min_power;
     }
@@ -825,9 +826,9 @@ SelfInterceptV13::getOneStepDashPower( const Vector2D & next_ball_rel,
     }
 
 #ifdef DEBUG_PRINT_ONE_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "________(getOneStepDashPower) best_ctrl accel_x[0] = %f  accel_x[1] = %f",
-                  required_accel_x[0], required_accel_x[1] );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "________(getOneStepDashPower) best_ctrl accel_x[0] = %f  accel_x[1] = %f",
+               required_accel_x[0], required_accel_x[1] );
 #endif
 
     for ( int i = 0; i < 2; ++i )
@@ -836,10 +837,10 @@ SelfInterceptV13::getOneStepDashPower( const Vector2D & next_ball_rel,
              && max_forward_accel_x > required_accel_x[i] )
         {
 #ifdef DEBUG_PRINT_ONE_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "________(getOneStepDashPower)  best trap."
-                          " forward dash[%d]. x = %f",
-                          i, required_accel_x[i] );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "________(getOneStepDashPower)  best trap."
+                       " forward dash[%d]. x = %f",
+                       i, required_accel_x[i] );
 #endif
             return required_accel_x[i] / dash_rate;
         }
@@ -847,10 +848,10 @@ SelfInterceptV13::getOneStepDashPower( const Vector2D & next_ball_rel,
              && max_back_accel_x < required_accel_x[i] )
         {
 #ifdef DEBUG_PRINT_ONE_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "________(getOneStepDashPower)  best trap."
-                          " back dash[%d]. x = %f",
-                          i, required_accel_x[i] );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "________(getOneStepDashPower)  best trap."
+                       " back dash[%d]. x = %f",
+                       i, required_accel_x[i] );
 #endif
             return required_accel_x[i] / dash_rate;
         }
@@ -859,8 +860,8 @@ SelfInterceptV13::getOneStepDashPower( const Vector2D & next_ball_rel,
 #endif
 
 #ifdef DEBUG_PRINT_ONE_STEPy
-    dlog.addText( Logger::INTERCEPT,
-                  "________(getOneStepDashPower) Failed" );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "________(getOneStepDashPower) Failed" );
 #endif
 
     return -1000.0;
@@ -875,7 +876,7 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
                                     const bool save_recovery,
                                     std::vector< InterceptInfo > & self_cache ) const
 {
-    static std::vector< InterceptInfo > tmp_cache;
+    thread_local std::vector< InterceptInfo > tmp_cache;
 
     const int max_loop = std::min( MAX_SHORT_STEP, max_cycle );
 
@@ -907,13 +908,13 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
         ball_vel *= SP.ballDecay();
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "--------- cycle %d  -----------", cycle );
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictShortStep) cycle %d: bpos(%.3f, %.3f) bvel(%.3f, %.3f)",
-                      cycle,
-                      ball_pos.x, ball_pos.y,
-                      ball_vel.x, ball_vel.y );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "--------- cycle %d  -----------", cycle );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictShortStep) cycle %d: bpos(%.3f, %.3f) bvel(%.3f, %.3f)",
+                   cycle,
+                   ball_pos.x, ball_pos.y,
+                   ball_vel.x, ball_vel.y );
 
 #endif
         const bool goalie_mode
@@ -928,51 +929,51 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
              < self.pos().dist2( ball_pos ) )
         {
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "(predictShortStep) too far." );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "(predictShortStep) too far." );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      ">>>>>>>> turn dash forward, turn_margin_dist=%f",
-                      control_area - 0.4 );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   ">>>>>>>> turn dash forward, turn_margin_dist=%f",
+                   control_area - 0.4 );
 #endif
         predictTurnDashShort( cycle, ball_pos, control_area, save_recovery, false, // forward dash
                               std::max( 0.1, control_area - 0.4 ),
                               tmp_cache );
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      ">>>>>>>> turn dash forward, turn_margin_dist=%f",
-                      std::max( 0.1, control_area - constrol_area_buf ) );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   ">>>>>>>> turn dash forward, turn_margin_dist=%f",
+                   std::max( 0.1, control_area - constrol_area_buf ) );
 #endif
         predictTurnDashShort( cycle, ball_pos, control_area, save_recovery, false, // forward dash
                               std::max( 0.1, control_area - control_area_buf ),
                               tmp_cache );
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      ">>>>>>>> turn dash back, turn_margin_dist=%f",
-                      control_area - 0.4 );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   ">>>>>>>> turn dash back, turn_margin_dist=%f",
+                   control_area - 0.4 );
 #endif
         predictTurnDashShort( cycle, ball_pos, control_area, save_recovery, true, // back dash
                               std::max( 0.1, control_area - 0.4 ),
                               tmp_cache );
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      ">>>>>>>> turn dash back, turn_margin_dist=%f",
-                      std::max( 0.1, control_area - control_area_buf ) );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   ">>>>>>>> turn dash back, turn_margin_dist=%f",
+                   std::max( 0.1, control_area - control_area_buf ) );
 #endif
         predictTurnDashShort( cycle, ball_pos, control_area, save_recovery, true, // back dash
                               control_area - control_area_buf,
                               tmp_cache );
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      ">>>>>>>> omni dash forward" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   ">>>>>>>> omni dash forward" );
 #endif
         if ( cycle <= 2 )
         {
@@ -995,18 +996,18 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
         const double safety_ball_dist = std::max( control_area - 0.2 - ball.pos().dist( ball_pos ) * SP.ballRand(),
                                                   ptype.playerSize() + SP.ballSize() + ptype.kickableMargin() * 0.4 );
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "decide best interception. size=%d safety_ball_dist=%.3f",
-                      tmp_cache.size(), safety_ball_dist );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "decide best interception. size=%d safety_ball_dist=%.3f",
+                   tmp_cache.size(), safety_ball_dist );
 #endif
 
         const InterceptInfo * best = &(tmp_cache.front());
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
-                          best->turnCycle(), best->dashCycle(),
-                          best->dashPower(), best->dashAngle().degree(),
-                          best->ballDist(), best->stamina() );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
+                       best->turnCycle(), best->dashCycle(),
+                       best->dashPower(), best->dashAngle().degree(),
+                       best->ballDist(), best->stamina() );
 #endif
 
         const std::vector< InterceptInfo >::iterator end = tmp_cache.end();
@@ -1015,11 +1016,11 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
         for ( ; it != end; ++it )
         {
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
-                          it->turnCycle(), it->dashCycle(),
-                          it->dashPower(), it->dashAngle().degree(),
-                          it->ballDist(), it->stamina() );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "____ turn=%d dash=%d power=%.1f dir=%.1f ball_dist=%.3f stamina=%.1f",
+                       it->turnCycle(), it->dashCycle(),
+                       it->dashPower(), it->dashAngle().degree(),
+                       it->ballDist(), it->stamina() );
 #endif
             if ( best->ballDist() < safety_ball_dist
                  && it->ballDist() < safety_ball_dist )
@@ -1028,8 +1029,8 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
                 {
                     best = &(*it);
 #ifdef DEBUG_PRINT_SHORT_STEP
-                    dlog.addText( Logger::INTERCEPT,
-                                  "--> updated(1)" );
+                    RCSC_DLOG( Logger::INTERCEPT, addText,
+                               "--> updated(1)" );
 #endif
                 }
                 else if ( best->turnCycle() == it->turnCycle()
@@ -1037,8 +1038,8 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
                 {
                     best = &(*it);
 #ifdef DEBUG_PRINT_SHORT_STEP
-                dlog.addText( Logger::INTERCEPT,
-                              "--> updated(2)" );
+                RCSC_DLOG( Logger::INTERCEPT, addText,
+                           "--> updated(2)" );
 #endif
                 }
             }
@@ -1054,20 +1055,20 @@ SelfInterceptV13::predictShortStep( const int max_cycle,
                 {
                     best = &(*it);
 #ifdef DEBUG_PRINT_SHORT_STEP
-                    dlog.addText( Logger::INTERCEPT,
-                                  "--> updated(3)" );
+                    RCSC_DLOG( Logger::INTERCEPT, addText,
+                               "--> updated(3)" );
 #endif
                 }
             }
         }
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "<<<<< Register best cycle=%d(t=%d d=%d) my_pos=(%.2f %.2f) ball_dist=%.3f stamina=%.1f",
-                      best->reachCycle(), best->turnCycle(), best->dashCycle(),
-                      best->selfPos().x, best->selfPos().y,
-                      best->ballDist(),
-                      best->stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "<<<<< Register best cycle=%d(t=%d d=%d) my_pos=(%.2f %.2f) ball_dist=%.3f stamina=%.1f",
+                   best->reachCycle(), best->turnCycle(), best->dashCycle(),
+                   best->selfPos().x, best->selfPos().y,
+                   best->ballDist(),
+                   best->stamina() );
 #endif
 
         //self_cache.insert( self_cache.end(), tmp_cache.begin(), tmp_cache.end() );
@@ -1095,9 +1096,9 @@ SelfInterceptV13::predictTurnDashShort( const int cycle,
     if ( n_turn > cycle )
     {
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictShortStep_cycle=%d) turn=%d over",
-                      cycle, n_turn );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictShortStep_cycle=%d) turn=%d over",
+                   cycle, n_turn );
 #endif
         return;
     }
@@ -1171,22 +1172,22 @@ SelfInterceptV13::predictTurnCycleShort( const int cycle,
     }
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "%d (predictTurnCycleShort) turn=%d",
-                  cycle, n_turn );
-    dlog.addText( Logger::INTERCEPT,
-                  "%d _______"
-                  " turn_margin=%.1f"
-                  " turn_moment=%.1f"
-                  " first_angle_diff=%.1f"
-                  " final_angle_diff=%.1f"
-                  " dash_angle=%.1f",
-                  cycle,
-                  turn_margin,
-                  ( *result_dash_angle - body_angle ).degree(),
-                  ( target_angle - body_angle ).degree(),
-                  angle_diff,
-                  result_dash_angle->degree() );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d (predictTurnCycleShort) turn=%d",
+               cycle, n_turn );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d _______"
+               " turn_margin=%.1f"
+               " turn_moment=%.1f"
+               " first_angle_diff=%.1f"
+               " final_angle_diff=%.1f"
+               " dash_angle=%.1f",
+               cycle,
+               turn_margin,
+               ( *result_dash_angle - body_angle ).degree(),
+               ( target_angle - body_angle ).degree(),
+               angle_diff,
+               result_dash_angle->degree() );
 #endif
 
     return n_turn;
@@ -1228,17 +1229,17 @@ SelfInterceptV13::predictDashCycleShort( const int cycle,
         StaminaModel tmp_stamina = stamina_model;
         tmp_stamina.simulateWaits( ptype, cycle - n_turn );
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "%d  **OK** (predictDashCycleShort) can reach. turn=%d dash=0.",
-                      cycle, n_turn );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d _____________________"
-                      " bpos(%.1f %.1f) my_inertia=(%.1f %.1f) dist=%.3f stamina=%.1f",
-                      cycle,
-                      ball_pos.x, ball_pos.y,
-                      my_inertia.x, my_inertia.y,
-                      my_final_pos.dist( ball_pos ),
-                      tmp_stamina.stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d  **OK** (predictDashCycleShort) can reach. turn=%d dash=0.",
+                   cycle, n_turn );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d _____________________"
+                   " bpos(%.1f %.1f) my_inertia=(%.1f %.1f) dist=%.3f stamina=%.1f",
+                   cycle,
+                   ball_pos.x, ball_pos.y,
+                   my_inertia.x, my_inertia.y,
+                   my_final_pos.dist( ball_pos ),
+                   tmp_stamina.stamina() );
 #endif
         self_cache.push_back( InterceptInfo( InterceptInfo::NORMAL,
                                              InterceptInfo::TURN_FORWARD_DASH,
@@ -1253,14 +1254,14 @@ SelfInterceptV13::predictDashCycleShort( const int cycle,
     if ( ( target_angle - dash_angle ).abs() > 90.0 )
     {
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "%d XXX (predictDashCycleShort) turn=%d.",
-                      cycle, n_turn );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d ____________________"
-                      " (target_angle(%.1f) - dash_angle(%.1f)) > 90",
-                      cycle,
-                      target_angle.degree(), dash_angle.degree() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d XXX (predictDashCycleShort) turn=%d.",
+                   cycle, n_turn );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d ____________________"
+                   " (target_angle(%.1f) - dash_angle(%.1f)) > 90",
+                   cycle,
+                   target_angle.degree(), dash_angle.degree() );
 #endif
         return;
     }
@@ -1272,8 +1273,8 @@ SelfInterceptV13::predictDashCycleShort( const int cycle,
     for ( int n_dash = 1; n_dash <= max_dash; ++n_dash )
     {
 #if 0
-        dlog.addText( Logger::INTERCEPT,
-                      "__ dash %d: max_dash=%d", n_dash, max_dash );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "__ dash %d: max_dash=%d", n_dash, max_dash );
 #endif
         Vector2D ball_rel = ( ball_pos - my_pos ).rotatedVector( -dash_angle );
         double first_speed = calc_first_term_geom_series( ball_rel.x,
@@ -1314,14 +1315,14 @@ SelfInterceptV13::predictDashCycleShort( const int cycle,
         stamina_model.simulateDash( ptype, dash_power );
 
 #if 0
-        dlog.addText( Logger::INTERCEPT,
-                      "____ pos=(%.2f %.2f) vel=(%.2f %.2f)r=%.3f th=%.1f",
-                      my_pos.x, my_pos.y,
-                      my_vel.x, my_vel.y,
-                      my_vel.r(), my_vel.th().degree() );
-        dlog.addText( Logger::INTERCEPT,
-                      "____ required first_speed=%.3f accel=%.3f dash_power=%.1f",
-                      first_speed, required_accel, dash_power );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "____ pos=(%.2f %.2f) vel=(%.2f %.2f)r=%.3f th=%.1f",
+                   my_pos.x, my_pos.y,
+                   my_vel.x, my_vel.y,
+                   my_vel.r(), my_vel.th().degree() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "____ required first_speed=%.3f accel=%.3f dash_power=%.1f",
+                   first_speed, required_accel, dash_power );
 #endif
     }
 
@@ -1334,23 +1335,23 @@ SelfInterceptV13::predictDashCycleShort( const int cycle,
                                                     ? InterceptInfo::EXHAUST
                                                     : InterceptInfo::NORMAL );
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "%d **OK** (predictDashCycleShort) controllable turn=%d dash=%d",
-                      cycle, n_turn, cycle - n_turn );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d __"
-                      " bpos(%.1f %.1f) my_pos=(%.1f %.1f) ball_dist=%.3f"
-                      " first_dash_power=%.1f stamina=%.1f",
-                      cycle,
-                      ball_pos.x, ball_pos.y,
-                      my_pos.x, my_pos.y,
-                      my_pos.dist( ball_pos ),
-                      first_dash_power, stamina_model.stamina() );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d __"
-                      " first_dash_power=%.1f stamina=%.1f",
-                      cycle,
-                      first_dash_power, stamina_model.stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d **OK** (predictDashCycleShort) controllable turn=%d dash=%d",
+                   cycle, n_turn, cycle - n_turn );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d __"
+                   " bpos(%.1f %.1f) my_pos=(%.1f %.1f) ball_dist=%.3f"
+                   " first_dash_power=%.1f stamina=%.1f",
+                   cycle,
+                   ball_pos.x, ball_pos.y,
+                   my_pos.x, my_pos.y,
+                   my_pos.dist( ball_pos ),
+                   first_dash_power, stamina_model.stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d __"
+                   " first_dash_power=%.1f stamina=%.1f",
+                   cycle,
+                   first_dash_power, stamina_model.stamina() );
 #endif
 
         self_cache.push_back( InterceptInfo( stamina_type,
@@ -1366,26 +1367,26 @@ SelfInterceptV13::predictDashCycleShort( const int cycle,
     }
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "%d XXX (predictDashCycleShort) turn=%d dash=%d.",
-                  cycle, n_turn, max_dash );
-    dlog.addText( Logger::INTERCEPT,
-                  "%d __ bpos(%.2f %.2f) mypos=(%.2f %.2f)",
-                  cycle,
-                  ball_pos.x, ball_pos.y,
-                  my_pos.x, my_pos.y );
-    dlog.addText( Logger::INTERCEPT,
-                  "%d __ ball_dist=%.3f control_area=%.3f(real:%.3f buf=%.3f",
-                  cycle,
-                  my_pos.dist( ball_pos ),
-                  control_area - control_area_buf,
-                  control_area,
-                  control_area_buf );
-    dlog.addText( Logger::INTERCEPT,
-                  "%d __ my_dash_move=%.3f first_ball_dist=%.3f",
-                  cycle,
-                  self.pos().dist( my_pos ),
-                  self.pos().dist( ball_pos ) );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d XXX (predictDashCycleShort) turn=%d dash=%d.",
+               cycle, n_turn, max_dash );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d __ bpos(%.2f %.2f) mypos=(%.2f %.2f)",
+               cycle,
+               ball_pos.x, ball_pos.y,
+               my_pos.x, my_pos.y );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d __ ball_dist=%.3f control_area=%.3f(real:%.3f buf=%.3f",
+               cycle,
+               my_pos.dist( ball_pos ),
+               control_area - control_area_buf,
+               control_area,
+               control_area_buf );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d __ my_dash_move=%.3f first_ball_dist=%.3f",
+               cycle,
+               self.pos().dist( my_pos ),
+               self.pos().dist( ball_pos ) );
 #endif
 }
 
@@ -1414,9 +1415,9 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
     if ( target_line.dist( my_inertia ) < control_area - 0.4 )
     {
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "%d (predictOmniDashShort) already on line. no need to omnidash. target_line_dist=%.3f",
-                      cycle, target_line.dist( my_inertia ) );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d (predictOmniDashShort) already on line. no need to omnidash. target_line_dist=%.3f",
+                   cycle, target_line.dist( my_inertia ) );
 #endif
         return;
     }
@@ -1431,9 +1432,9 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
                                     ? SP.maxDashAngle() + dash_angle_step * 0.5
                                     : dash_angle_step * static_cast< int >( 180.0 / dash_angle_step ) - 1.0 );
 #ifdef DEBUG_PRINT_SHORT_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "%d (predictOmniDashShort) min_angle=%.1f max_angle=%.1f",
-                  cycle, min_dash_angle, max_dash_angle );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d (predictOmniDashShort) min_angle=%.1f max_angle=%.1f",
+               cycle, min_dash_angle, max_dash_angle );
 #endif
 
     const AngleDeg target_angle = ( ball_pos - my_inertia ).th();
@@ -1445,9 +1446,9 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
         if ( std::fabs( dir ) < 1.0 ) continue;
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "%d ===== (predictOmniDashShort) dir=%.1f",
-                      cycle, dir );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d ===== (predictOmniDashShort) dir=%.1f",
+                   cycle, dir );
 #endif
 
         const AngleDeg dash_angle = body_angle + SP.discretizeDashAngle( SP.normalizeDashAngle( dir ) );
@@ -1455,10 +1456,10 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
         if ( ( dash_angle - target_angle ).abs() > 91.0 )
         {
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d XXX angle over. target_angle=%.1f dash_angle=%.1f",
-                          cycle,
-                          target_angle.degree(), dash_angle.degree() );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d XXX angle over. target_angle=%.1f dash_angle=%.1f",
+                       cycle,
+                       target_angle.degree(), dash_angle.degree() );
 #endif
             continue;
         }
@@ -1484,9 +1485,9 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
         if ( n_omni_dash < 0 )
         {
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d XXX no adjustable",
-                          cycle );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d XXX no adjustable",
+                       cycle );
 #endif
             continue;
         }
@@ -1494,9 +1495,9 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
         if ( n_omni_dash == 0 )
         {
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d XXX not need to adjust",
-                          cycle );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d XXX not need to adjust",
+                       cycle );
 #endif
             continue;
         }
@@ -1509,23 +1510,23 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
             Vector2D target_rel = ( ball_pos - inertia_pos ).rotatedVector( -body_angle );
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____after omni dash. inertia_pos=(%.3f %.3f) ball_pos=(%.3f %.3f) body_angle=%.1f target_rel=(%.3f %.3f)",
-                          cycle,
-                          inertia_pos.x, inertia_pos.y,
-                          ball_pos.x, ball_pos.y,
-                          body_angle.degree(),
-                          target_rel.x, target_rel.y );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____after omni dash. inertia_pos=(%.3f %.3f) ball_pos=(%.3f %.3f) body_angle=%.1f target_rel=(%.3f %.3f)",
+                       cycle,
+                       inertia_pos.x, inertia_pos.y,
+                       ball_pos.x, ball_pos.y,
+                       body_angle.degree(),
+                       target_rel.x, target_rel.y );
 #endif
 
             if ( ( back_dash && target_rel.x > 0.0 )
                  || ( ! back_dash && target_rel.x < 0.0 ) )
             {
 #ifdef DEBUG_PRINT_SHORT_STEP
-                dlog.addText( Logger::INTERCEPT,
-                              "%d XXX invalid dash direction. dash=%d target_rel.x=%.3f",
-                              cycle, n_omni_dash,
-                              target_rel.x );
+                RCSC_DLOG( Logger::INTERCEPT, addText,
+                           "%d XXX invalid dash direction. dash=%d target_rel.x=%.3f",
+                           cycle, n_omni_dash,
+                           target_rel.x );
 #endif
                 continue;
             }
@@ -1568,11 +1569,11 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
             my_vel += accel;
             my_pos += my_vel;
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d __ body_dash=%d pos=(%.2f %.2f) vel=(%.2f %.2f)r=%.3f",
-                          cycle, n_dash - n_omni_dash,
-                          my_pos.x, my_pos.y,
-                          my_vel.x, my_vel.y, my_vel.r() );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d __ body_dash=%d pos=(%.2f %.2f) vel=(%.2f %.2f)r=%.3f",
+                       cycle, n_dash - n_omni_dash,
+                       my_pos.x, my_pos.y,
+                       my_vel.x, my_vel.y, my_vel.r() );
 #endif
             my_vel *= ptype.playerDecay();
 
@@ -1592,26 +1593,26 @@ SelfInterceptV13::predictOmniDashShort( const int cycle,
                                                         ? InterceptInfo::EXHAUST
                                                         : InterceptInfo::NORMAL );
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d **OK** can reach, after body dir dash.", cycle );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____ omni_dash=%d body_dash=%d",
-                          cycle,
-                          n_omni_dash, cycle - n_omni_dash );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____ final_pos=(%.1f %.1f) ball_dist=%.3f ctrl_area=%.3f",
-                          cycle,
-                          my_pos.x, my_pos.y,
-                          my_pos.dist( ball_pos ), control_area );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____ my_move_dist=%.3f ball_rel_x=%.3f",
-                          cycle,
-                          my_move.r(),
-                          ( ball_pos - self.pos() ).rotatedVector( - my_move.th() ).x );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____ 1st_dash_power=%.1f stamina=%.1f",
-                          cycle,
-                          first_dash_power, stamina_model.stamina() );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d **OK** can reach, after body dir dash.", cycle );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____ omni_dash=%d body_dash=%d",
+                       cycle,
+                       n_omni_dash, cycle - n_omni_dash );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____ final_pos=(%.1f %.1f) ball_dist=%.3f ctrl_area=%.3f",
+                       cycle,
+                       my_pos.x, my_pos.y,
+                       my_pos.dist( ball_pos ), control_area );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____ my_move_dist=%.3f ball_rel_x=%.3f",
+                       cycle,
+                       my_move.r(),
+                       ( ball_pos - self.pos() ).rotatedVector( - my_move.th() ).x );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____ 1st_dash_power=%.1f stamina=%.1f",
+                       cycle,
+                       first_dash_power, stamina_model.stamina() );
 #endif
             self_cache.push_back( InterceptInfo( stamina_type,
                                                  InterceptInfo::OMNI_DASH,
@@ -1657,9 +1658,9 @@ SelfInterceptV13::predictAdjustOmniDash( const int cycle,
     if ( target_line.dist( my_inertia ) < control_area - 0.4 )
     {
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "%d (predictAdjustOmniDash) no dash required. line_dist=%.3f < control_buf=%.3f(%.3f)",
-                      cycle, target_line.dist( my_inertia ), control_area - 0.4, control_area );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d (predictAdjustOmniDash) no dash required. line_dist=%.3f < control_buf=%.3f(%.3f)",
+                   cycle, target_line.dist( my_inertia ), control_area - 0.4, control_area );
 #endif
         *first_dash_power = 0.0;
         return 0;
@@ -1675,9 +1676,9 @@ SelfInterceptV13::predictAdjustOmniDash( const int cycle,
     // dash simulation
     //
 #ifdef DEBUG_PRINT_SHORT_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "%d (predictAdjustOmniDash) dir=%.1f angle=%.1f",
-                  cycle, dash_rel_dir, dash_angle.degree() );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d (predictAdjustOmniDash) dir=%.1f angle=%.1f",
+               cycle, dash_rel_dir, dash_angle.degree() );
 #endif
 
     for ( int n_omni_dash = 1; n_omni_dash <= max_omni_dash; ++n_omni_dash )
@@ -1691,14 +1692,14 @@ SelfInterceptV13::predictAdjustOmniDash( const int cycle,
         if ( std::fabs( required_accel ) < 0.01 )
         {
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d *** adjustable without dash. omni_dash_loop=%d",
-                          cycle, n_omni_dash );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d __ first_speed=%.3f rel_vel=(%.3f %.3f) required_accel=%.3f",
-                          cycle,
-                          rel_vel.x, rel_vel.y,
-                          first_speed, required_accel );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d *** adjustable without dash. omni_dash_loop=%d",
+                       cycle, n_omni_dash );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d __ first_speed=%.3f rel_vel=(%.3f %.3f) required_accel=%.3f",
+                       cycle,
+                       rel_vel.x, rel_vel.y,
+                       first_speed, required_accel );
 #endif
             return n_omni_dash - 1;
         }
@@ -1739,23 +1740,23 @@ SelfInterceptV13::predictAdjustOmniDash( const int cycle,
         Vector2D inertia_pos = ptype.inertiaPoint( *my_pos, *my_vel, cycle - n_omni_dash );
 
 #ifdef DEBUG_PRINT_SHORT_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "%d ____ omni_dash=%d"
-                      " accel=(%.3f %.3f)r=%.3f inertia_line_dist=%.3f",
-                      cycle, n_omni_dash,
-                      accel.x, accel.y, accel.r(),
-                      target_line.dist( inertia_pos ) );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d ____ omni_dash=%d"
+                   " accel=(%.3f %.3f)r=%.3f inertia_line_dist=%.3f",
+                   cycle, n_omni_dash,
+                   accel.x, accel.y, accel.r(),
+                   target_line.dist( inertia_pos ) );
 #endif
 
         if ( target_line.dist( inertia_pos ) < control_area - control_area_buf )
         {
 #ifdef DEBUG_PRINT_SHORT_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "%d *** adjustable. omni_dash=%d first_dash_power=%.1f line_dist=%.3f ctrl_dist=%.3f",
-                          cycle, n_omni_dash,
-                          *first_dash_power,
-                          target_line.dist( inertia_pos ),
-                          control_area );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d *** adjustable. omni_dash=%d first_dash_power=%.1f line_dist=%.3f ctrl_dist=%.3f",
+                       cycle, n_omni_dash,
+                       *first_dash_power,
+                       target_line.dist( inertia_pos ),
+                       control_area );
 #endif
             return n_omni_dash;
         }
@@ -1773,7 +1774,7 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
                                    const bool save_recovery,
                                    std::vector< InterceptInfo > & self_cache ) const
 {
-    static std::vector< InterceptInfo > tmp_cache;
+    thread_local std::vector< InterceptInfo > tmp_cache;
 
     const ServerParam & SP = ServerParam::i();
     const BallObject & ball = M_world.ball();
@@ -1794,18 +1795,18 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
     }
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictLongStep) start_cycle=%d max_cycle=%d",
-                      start_cycle, max_cycle );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictLongStep) start_cycle=%d max_cycle=%d",
+                   start_cycle, max_cycle );
 #endif
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
     if ( max_cycle <= start_cycle )
     {
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictLongStep) Too big Y difference = %f."
-                      "  start_cycle = %d.  max_cycle = %d",
-                      ball_to_self.y, start_cycle, max_cycle );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictLongStep) Too big Y difference = %f."
+                   "  start_cycle = %d.  max_cycle = %d",
+                   ball_to_self.y, start_cycle, max_cycle );
     }
 #endif
 
@@ -1822,12 +1823,12 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
         ball_vel *= SP.ballDecay();
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-        dlog.addText( Logger::INTERCEPT,
-                      "---------- cycle %d ----------", cycle );
-        dlog.addText( Logger::INTERCEPT,
-                      "bpos(%.3f, %.3f) bvel(%.3f, %.3f)",
-                      ball_pos.x, ball_pos.y,
-                      ball_vel.x, ball_vel.y );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "---------- cycle %d ----------", cycle );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "bpos(%.3f, %.3f) bvel(%.3f, %.3f)",
+                   ball_pos.x, ball_pos.y,
+                   ball_vel.x, ball_vel.y );
 
 #endif
         //         // ball is stopped
@@ -1845,8 +1846,8 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
              )
         {
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____ball is out of pitch", cycle );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____ball is out of pitch", cycle );
 #endif
             break;
         }
@@ -1867,8 +1868,8 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
              < self.pos().dist( ball_pos ) )
         {
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____ball is too far. never reach", cycle );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____ball is too far. never reach", cycle );
 #endif
             continue;
         }
@@ -1885,11 +1886,11 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
                                     self_cache ) )
         {
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-            dlog.addText( Logger::INTERCEPT,
-                          "%d --> can reach. cycle=%d, turn=%d, %s recovery=%f",
-                          cycle, cycle, n_turn,
-                          ( back_dash ? "back" : "forward" ),
-                          result_recovery );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d --> can reach. cycle=%d, turn=%d, %s recovery=%f",
+                       cycle, cycle, n_turn,
+                       ( back_dash ? "back" : "forward" ),
+                       result_recovery );
 #endif
             if ( ! found )
             {
@@ -1901,14 +1902,14 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
 #if 0
 
 #ifdef DEBUG_PRINT_LONG_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      ">>>>>>>> turn dash long forward <<<<<<<<<<" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   ">>>>>>>> turn dash long forward <<<<<<<<<<" );
 #endif
         predictTurnDashLong( cycle, ball_pos, control_area, save_recovery, false, // forward dash
                              tmp_cache );
 #ifdef DEBUG_PRINT_LONG_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      ">>>>>>>> turn dash long back <<<<<<<<<<" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   ">>>>>>>> turn dash long back <<<<<<<<<<" );
 #endif
         predictTurnDashLong( cycle, ball_pos, control_area, save_recovery, true, // back dash
                              tmp_cache );
@@ -1920,8 +1921,8 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
          && save_recovery )
     {
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-        dlog.addText( Logger::INTERCEPT,
-                      __FILE__": SelfInterceptV13. failed to predict? register ball final point" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   __FILE__": SelfInterceptV13. failed to predict? register ball final point" );
 #endif
         predictFinal( max_cycle, self_cache );
     }
@@ -1929,8 +1930,8 @@ SelfInterceptV13::predictLongStep( const int max_cycle,
     if ( self_cache.empty() )
     {
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-        dlog.addText( Logger::INTERCEPT,
-                      __FILE__": SelfInterceptV13. not found. retry predictFinal()" );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   __FILE__": SelfInterceptV13. not found. retry predictFinal()" );
 #endif
         predictFinal( max_cycle, self_cache );
     }
@@ -1971,19 +1972,19 @@ SelfInterceptV13::predictFinal( const int max_cycle,
     int n_dash = ptype.cyclesToReachDistance( dash_dist );
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-    dlog.addText( Logger::INTERCEPT,
-                  "(predictFinal) register ball final point. max_cycle=%d, turn=%d, dash=%d",
-                  max_cycle,
-                  n_turn, n_dash );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "(predictFinal) register ball final point. max_cycle=%d, turn=%d, dash=%d",
+               max_cycle,
+               n_turn, n_dash );
 #endif
     if ( max_cycle > n_turn + n_dash )
     {
         n_dash = max_cycle - n_turn;
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-        dlog.addText( Logger::INTERCEPT,
-                      "__Final(2) dash step is changed by max_cycle. max=%d turn=%d dash=%d",
-                      max_cycle,
-                      n_turn, n_dash );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "__Final(2) dash step is changed by max_cycle. max=%d turn=%d dash=%d",
+                   max_cycle,
+                   n_turn, n_dash );
 #endif
     }
 
@@ -2105,9 +2106,9 @@ SelfInterceptV13::predictTurnCycle( const int cycle,
     }
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-    dlog.addText( Logger::INTERCEPT,
-                  "%d ______control_buf=%.2f turn_margin=%.1f angle_diff=%.1f",
-                  cycle, control_buf, turn_margin, angle_diff );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d ______control_buf=%.2f turn_margin=%.1f angle_diff=%.1f",
+               cycle, control_buf, turn_margin, angle_diff );
 #endif
 
     ///////////////////////////////////////////////////
@@ -2193,17 +2194,17 @@ SelfInterceptV13::canBackDashChase( const int cycle,
     if ( result_stamina < ServerParam::i().recoverDecThrValue() + 205.0 )
     {
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-        dlog.addText( Logger::INTERCEPT,
-                      "%d ______ goalie no stamina. no back. stamina=%f",
-                      cycle, result_stamina );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d ______ goalie no stamina. no back. stamina=%f",
+                   cycle, result_stamina );
 #endif
         return false;
     }
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-    dlog.addText( Logger::INTERCEPT,
-                  "%d ______try back dash. result stamina=%.1f",
-                  cycle, result_stamina );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d ______try back dash. result stamina=%.1f",
+               cycle, result_stamina );
 #endif
 
     return true;
@@ -2271,12 +2272,12 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
     double dash_accel_x = dash_power_abs * ptype.dashRate( stamina_model.effort() );
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-    dlog.addText( Logger::INTERCEPT,
-                  "%d ______Try %d turn: %d dash:"
-                  " angle=%.1f first_accel=%.2f first_vel=(%.2f %.2f)",
-                  n_turn + n_dash,
-                  n_turn, n_dash,
-                  dash_angle.degree(), dash_accel_x, tmp_vel.x, tmp_vel.y );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d ______Try %d turn: %d dash:"
+               " angle=%.1f first_accel=%.2f first_vel=(%.2f %.2f)",
+               n_turn + n_dash,
+               n_turn, n_dash,
+               dash_angle.degree(), dash_accel_x, tmp_vel.x, tmp_vel.y );
 #endif
 
     //////////////////////////////////////////////////////////////
@@ -2304,22 +2305,22 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
 
             must_update_power = true;
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_3
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ________dash %d/%d: no enough? stamina=%.1f extra=%.1f"
-                          " cur_pow=%.1f  available_pow=%.1f",
-                          n_turn + n_dash,
-                          i, n_dash,
-                          stamina_model.stamina(), ptype.extraStamina(),
-                          dash_power_abs, available_power );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ________dash %d/%d: effort decayed? %f -> %f",
-                          n_turn + n_dash,
-                          i, n_dash, prev_effort, stamina_model.effort() );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ________dash %d/%d: reset max power?. curr_pow=%.1f"
-                          "  available=%.1f",
-                          n_turn + n_dash,
-                          i, n_dash, dash_power_abs, available_power );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ________dash %d/%d: no enough? stamina=%.1f extra=%.1f"
+                       " cur_pow=%.1f  available_pow=%.1f",
+                       n_turn + n_dash,
+                       i, n_dash,
+                       stamina_model.stamina(), ptype.extraStamina(),
+                       dash_power_abs, available_power );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ________dash %d/%d: effort decayed? %f -> %f",
+                       n_turn + n_dash,
+                       i, n_dash, prev_effort, stamina_model.effort() );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ________dash %d/%d: reset max power?. curr_pow=%.1f"
+                       "  available=%.1f",
+                       n_turn + n_dash,
+                       i, n_dash, dash_power_abs, available_power );
 #endif
         }
 
@@ -2334,10 +2335,10 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
                 first_dash_power = dash_power_abs * ( back_dash ? -1.0 : 1.0 );
             }
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_3
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ________dash %d/%d: update dash_power_abs=%.1f accel_x=%f",
-                          n_turn + n_dash,
-                          i, n_dash, dash_power_abs, dash_accel_x );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ________dash %d/%d: update dash_power_abs=%.1f accel_x=%f",
+                       n_turn + n_dash,
+                       i, n_dash, dash_power_abs, dash_accel_x );
 #endif
         }
 
@@ -2361,10 +2362,10 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
             can_over_speed_max = ptype.canOverSpeedMax( dash_power_abs,
                                                         stamina_model.effort() );
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_3
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ________dash %d/%d: power conserve. power=%.1f accel_x=%f",
-                          n_turn + n_dash,
-                          i, n_dash, dash_power_abs, dash_accel_x );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ________dash %d/%d: power conserve. power=%.1f accel_x=%f",
+                       n_turn + n_dash,
+                       i, n_dash, dash_power_abs, dash_accel_x );
 #endif
         }
 
@@ -2384,10 +2385,10 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
             n_safety_dash = std::max( 0, n_safety_dash - 1 ); // -1 is very important
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_3
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ________dash %d/%d: reach real speed max. safety dash=%d",
-                          n_turn + n_dash,
-                          i, n_dash, n_safety_dash );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ________dash %d/%d: reach real speed max. safety dash=%d",
+                       n_turn + n_dash,
+                       i, n_dash, n_safety_dash );
 #endif
             tmp_pos.x += tmp_vel.x * n_safety_dash;
             double one_cycle_consume = ( real_power > 0.0
@@ -2416,16 +2417,16 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
         if ( tmp_pos.x * PLAYER_NOISE_RATE + 0.1 > noised_ball_x )
         {
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____dash %d/%d: can run over. rel_move_pos=(%.2f, %.2f)"
-                          " ball_x=%.3f over=%.3f y_diff=%.3f",
-                          n_turn + n_dash,
-                          i, n_dash,
-                          tmp_pos.x, tmp_pos.y,
-                          noised_ball_x,
-                          //tmp_pos.x * PLAYER_NOISE_RATE - noised_ball_x,
-                          tmp_pos.x * PLAYER_NOISE_RATE - 0.1 - noised_ball_x,
-                          std::fabs( tmp_pos.y - ball_rel.y ) );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____dash %d/%d: can run over. rel_move_pos=(%.2f, %.2f)"
+                       " ball_x=%.3f over=%.3f y_diff=%.3f",
+                       n_turn + n_dash,
+                       i, n_dash,
+                       tmp_pos.x, tmp_pos.y,
+                       noised_ball_x,
+                       //tmp_pos.x * PLAYER_NOISE_RATE - noised_ball_x,
+                       tmp_pos.x * PLAYER_NOISE_RATE - 0.1 - noised_ball_x,
+                       std::fabs( tmp_pos.y - ball_rel.y ) );
 #endif
             *result_recovery = stamina_model.recovery();
 
@@ -2458,15 +2459,15 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
     }
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-    dlog.addText( Logger::INTERCEPT,
-                  "%d ______dash %d: no run over. pmove=(%.2f(noised=%.2f), %.2f) ball_x=%.3f"
-                  " x_diff=%.3f y_diff=%.3f",
-                  n_turn + n_dash,
-                  n_dash,
-                  tmp_pos.x, tmp_pos.x * PLAYER_NOISE_RATE, tmp_pos.y,
-                  noised_ball_x,
-                  tmp_pos.x * PLAYER_NOISE_RATE - noised_ball_x,
-                  std::fabs( tmp_pos.y - ball_rel.y ) );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d ______dash %d: no run over. pmove=(%.2f(noised=%.2f), %.2f) ball_x=%.3f"
+               " x_diff=%.3f y_diff=%.3f",
+               n_turn + n_dash,
+               n_dash,
+               tmp_pos.x, tmp_pos.x * PLAYER_NOISE_RATE, tmp_pos.y,
+               noised_ball_x,
+               tmp_pos.x * PLAYER_NOISE_RATE - noised_ball_x,
+               std::fabs( tmp_pos.y - ball_rel.y ) );
 #endif
 
     //////////////////////////////////////////////////////////
@@ -2492,17 +2493,17 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
         {
             Vector2D my_final_pos = M_world.self().pos() + tmp_pos.rotate( dash_angle );
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_1
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____dash %d: can reach.last ball dist=%.3f. noised_ctrl_area=%.3f/%.3f",
-                          n_turn + n_dash,
-                          n_dash,
-                          last_ball_dist,
-                          std::max( control_area - 0.225, control_area - buf ),
-                          control_area );
-            dlog.addText( Logger::INTERCEPT,
-                          "%d ____ player_noise=%f ball_noise=%f buf=%f",
-                          n_turn + n_dash,
-                          player_noise, ball_noise, buf );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____dash %d: can reach.last ball dist=%.3f. noised_ctrl_area=%.3f/%.3f",
+                       n_turn + n_dash,
+                       n_dash,
+                       last_ball_dist,
+                       std::max( control_area - 0.225, control_area - buf ),
+                       control_area );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "%d ____ player_noise=%f ball_noise=%f buf=%f",
+                       n_turn + n_dash,
+                       player_noise, ball_noise, buf );
 #endif
             *result_recovery = stamina_model.recovery();
             InterceptInfo::StaminaType stamina_type = ( stamina_model.recovery() < M_world.self().recovery()
@@ -2522,38 +2523,38 @@ SelfInterceptV13::canReachAfterDash( const int n_turn,
         }
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-        dlog.addText( Logger::INTERCEPT,
-                      "%d ______dash %d: failed. last_ball_dist=%.3f noised_ctrl_area=%.3f/%.3f",
-                      n_turn + n_dash,
-                      n_dash,
-                      last_ball_dist,
-                      std::max( control_area - 0.225, control_area - buf ),
-                      control_area );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d ______player_rel=(%.3f %.3f) ball_rel=(%.3f %.3f)  p_noise=%.3f b_noise=%.3f",
-                      n_turn + n_dash,
-                      tmp_pos.x, tmp_pos.y,
-                      ball_rel.x, ball_rel.y,
-                      player_noise,
-                      ball_noise );
-        dlog.addText( Logger::INTERCEPT,
-                      "%d ______noised_ball_x=%.3f  bnoise=%.3f  pnoise=%.3f",
-                      n_turn + n_dash,
-                      noised_ball_x,
-                      ball_noise, player_noise );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d ______dash %d: failed. last_ball_dist=%.3f noised_ctrl_area=%.3f/%.3f",
+                   n_turn + n_dash,
+                   n_dash,
+                   last_ball_dist,
+                   std::max( control_area - 0.225, control_area - buf ),
+                   control_area );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d ______player_rel=(%.3f %.3f) ball_rel=(%.3f %.3f)  p_noise=%.3f b_noise=%.3f",
+                   n_turn + n_dash,
+                   tmp_pos.x, tmp_pos.y,
+                   ball_rel.x, ball_rel.y,
+                   player_noise,
+                   ball_noise );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "%d ______noised_ball_x=%.3f  bnoise=%.3f  pnoise=%.3f",
+                   n_turn + n_dash,
+                   noised_ball_x,
+                   ball_noise, player_noise );
 #endif
         return false;
     }
 
 #ifdef DEBUG_PRINT_LONG_STEP_LEVEL_2
-    dlog.addText( Logger::INTERCEPT,
-                  "%d ____dash %d: cannot reach. player_rel=(%f %f)  ball_rel=(%f %f)"
-                  "  noise_ball_x=%f",
-                  n_turn + n_dash,
-                  n_dash,
-                  tmp_pos.x, tmp_pos.y,
-                  ball_rel.x, ball_rel.y,
-                  noised_ball_x );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "%d ____dash %d: cannot reach. player_rel=(%f %f)  ball_rel=(%f %f)"
+               "  noise_ball_x=%f",
+               n_turn + n_dash,
+               n_dash,
+               tmp_pos.x, tmp_pos.y,
+               ball_rel.x, ball_rel.y,
+               noised_ball_x );
 #endif
     return false;
 }
@@ -2575,9 +2576,9 @@ SelfInterceptV13::predictTurnDashLong( const int cycle,
     if ( n_turn > cycle )
     {
 #ifdef DEBUG_PRINT_LONG_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictShortStep_cycle=%d) turn=%d over",
-                      cycle, n_turn );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictShortStep_cycle=%d) turn=%d over",
+                   cycle, n_turn );
 #endif
         return;
     }
@@ -2646,19 +2647,19 @@ SelfInterceptV13::predictTurnCycleLong( const int cycle,
     }
 
 #ifdef DEBUG_PRINT_LONG_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "(predictTurnCycleLong) cycle=%d turn=%d"
-                  " turn_margin=%.1f"
-                  " turn_moment=%.1f"
-                  " first_angle_diff=%.1f"
-                  " final_angle_diff=%.1f"
-                  " dash_angle=%.1f",
-                  cycle, n_turn,
-                  turn_margin,
-                  ( *result_dash_angle - body_angle ).degree(),
-                  ( target_angle - body_angle ).degree(),
-                  angle_diff,
-                  result_dash_angle->degree() );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "(predictTurnCycleLong) cycle=%d turn=%d"
+               " turn_margin=%.1f"
+               " turn_moment=%.1f"
+               " first_angle_diff=%.1f"
+               " final_angle_diff=%.1f"
+               " dash_angle=%.1f",
+               cycle, n_turn,
+               turn_margin,
+               ( *result_dash_angle - body_angle ).degree(),
+               ( target_angle - body_angle ).degree(),
+               angle_diff,
+               result_dash_angle->degree() );
 #endif
 
     return n_turn;
@@ -2704,14 +2705,14 @@ SelfInterceptV13::predictDashCycleLong( const int cycle,
         StaminaModel tmp_stamina = stamina_model;
         tmp_stamina.simulateWaits( ptype, cycle - n_turn );
 #ifdef DEBUG_PRINT_LONG_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictDashCycleLong) **OK** can reach. cycle=%d turn=%d dash=0."
-                      " bpos(%.1f %.1f) my_inertia=(%.1f %.1f) dist=%.3f stamina=%.1f",
-                      cycle, n_turn,
-                      ball_pos.x, ball_pos.y,
-                      my_inertia.x, my_inertia.y,
-                      my_final_pos.dist( ball_pos ),
-                      tmp_stamina.stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictDashCycleLong) **OK** can reach. cycle=%d turn=%d dash=0."
+                   " bpos(%.1f %.1f) my_inertia=(%.1f %.1f) dist=%.3f stamina=%.1f",
+                   cycle, n_turn,
+                   ball_pos.x, ball_pos.y,
+                   my_inertia.x, my_inertia.y,
+                   my_final_pos.dist( ball_pos ),
+                   tmp_stamina.stamina() );
 #endif
         self_cache.push_back( InterceptInfo( InterceptInfo::NORMAL,
                                              ( back_dash
@@ -2728,10 +2729,10 @@ SelfInterceptV13::predictDashCycleLong( const int cycle,
     if ( ( target_angle - dash_angle ).abs() > 90.0 )
     {
 #ifdef DEBUG_PRINT_LONG_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictDashCycleLong) XXX cycle=%d turn=%d."
-                      " (target_angle(%.1f) - dash_angle(%.1f)) > 90",
-                      target_angle.degree(), dash_angle.degree() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictDashCycleLong) XXX cycle=%d turn=%d."
+                   " (target_angle(%.1f) - dash_angle(%.1f)) > 90",
+                   target_angle.degree(), dash_angle.degree() );
 #endif
         return;
     }
@@ -2785,20 +2786,20 @@ SelfInterceptV13::predictDashCycleLong( const int cycle,
             }
             stamina_model.simulateWaits( ptype, cycle - n_turn - n_dash );
 #ifdef DEBUG_PRINT_LONG_STEP
-            dlog.addText( Logger::INTERCEPT,
-                          "(predictDashCycleLong) **OK** can run over."
-                          " cycle=%d turn=%d dash=%d"
-                          " bpos(%.1f %.1f) inertia_pos=(%.1f %.1f) final_pos=(%.1f %.1f)"
-                          " target_rel.x=%.3f my_move=%.3f"
-                          " ball_dist=%.3f"
-                          " first_dash_power=%.1f stamina=%.1f",
-                          cycle, n_turn, n_dash,
-                          ball_pos.x, ball_pos.y,
-                          inertia_pos.x, inertia_pos.y,
-                          my_final_pos.x, my_final_pos.y,
-                          target_rel.x, ( inertia_pos - self.pos() ).r(),
-                          my_final_pos.dist( ball_pos ),
-                          first_dash_power, stamina_model.stamina() );
+            RCSC_DLOG( Logger::INTERCEPT, addText,
+                       "(predictDashCycleLong) **OK** can run over."
+                       " cycle=%d turn=%d dash=%d"
+                       " bpos(%.1f %.1f) inertia_pos=(%.1f %.1f) final_pos=(%.1f %.1f)"
+                       " target_rel.x=%.3f my_move=%.3f"
+                       " ball_dist=%.3f"
+                       " first_dash_power=%.1f stamina=%.1f",
+                       cycle, n_turn, n_dash,
+                       ball_pos.x, ball_pos.y,
+                       inertia_pos.x, inertia_pos.y,
+                       my_final_pos.x, my_final_pos.y,
+                       target_rel.x, ( inertia_pos - self.pos() ).r(),
+                       my_final_pos.dist( ball_pos ),
+                       first_dash_power, stamina_model.stamina() );
 #endif
             self_cache.push_back( InterceptInfo( stamina_type,
                                                  ( back_dash
@@ -2820,15 +2821,15 @@ SelfInterceptV13::predictDashCycleLong( const int cycle,
                                                     ? InterceptInfo::EXHAUST
                                                     : InterceptInfo::NORMAL );
 #ifdef DEBUG_PRINT_LONG_STEP
-        dlog.addText( Logger::INTERCEPT,
-                      "(predictDashCycleLong) **OK** controllable cycle=%d turn=%d dash=%d."
-                      " bpos(%.1f %.1f) my_pos=(%.1f %.1f) ball_dist=%.3f"
-                      " first_dash_power=%.1f stamina=%.1f",
-                      cycle, n_turn, cycle - n_turn,
-                      ball_pos.x, ball_pos.y,
-                      my_pos.x, my_pos.y,
-                      my_pos.dist( ball_pos ),
-                      first_dash_power, stamina_model.stamina() );
+        RCSC_DLOG( Logger::INTERCEPT, addText,
+                   "(predictDashCycleLong) **OK** controllable cycle=%d turn=%d dash=%d."
+                   " bpos(%.1f %.1f) my_pos=(%.1f %.1f) ball_dist=%.3f"
+                   " first_dash_power=%.1f stamina=%.1f",
+                   cycle, n_turn, cycle - n_turn,
+                   ball_pos.x, ball_pos.y,
+                   my_pos.x, my_pos.y,
+                   my_pos.dist( ball_pos ),
+                   first_dash_power, stamina_model.stamina() );
 #endif
         self_cache.push_back( InterceptInfo( stamina_type,
                                              ( back_dash
@@ -2843,14 +2844,14 @@ SelfInterceptV13::predictDashCycleLong( const int cycle,
     }
 
 #ifdef DEBUG_PRINT_LONG_STEP
-    dlog.addText( Logger::INTERCEPT,
-                  "(predictDashCycleLong) XXX cycle=%d turn=%d dash=%d."
-                  " bpos(%.1f %.1f) mypos=(%.1f %.1f) ball_dist=%.3f my_dash_move=%.3f",
-                  cycle, n_turn, max_dash,
-                  ball_pos.x, ball_pos.y,
-                  my_pos.x, my_pos.y,
-                  my_pos.dist( ball_pos ),
-                  my_inertia.dist( my_pos ) );
+    RCSC_DLOG( Logger::INTERCEPT, addText,
+               "(predictDashCycleLong) XXX cycle=%d turn=%d dash=%d."
+               " bpos(%.1f %.1f) mypos=(%.1f %.1f) ball_dist=%.3f my_dash_move=%.3f",
+               cycle, n_turn, max_dash,
+               ball_pos.x, ball_pos.y,
+               my_pos.x, my_pos.y,
+               my_pos.dist( ball_pos ),
+               my_inertia.dist( my_pos ) );
 #endif
 }
 
@@ -37,6 +37,6 @@
 
 namespace rcsc {
 
-long AbstractAction::S_action_object_counter = 0;
+std::atomic< long > AbstractAction::S_action_object_counter( 0 );
 
 }
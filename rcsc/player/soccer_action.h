@@ -34,6 +34,8 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <atomic>
+
 namespace rcsc {
 
 class PlayerAgent;
@@ -44,8 +46,8 @@ class PlayerAgent;
 */
 class AbstractAction {
 private:
-    //! number of instances have been created
-    static long S_action_object_counter;
+    //! number of instances have been created. atomic for the agents executed in other threads.
+    static std::atomic< long > S_action_object_counter;
 
     //! object ID of this action
     long M_action_object_id;
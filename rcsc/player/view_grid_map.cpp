@@ -162,6 +162,9 @@ struct ViewGridMap::Impl {
     int ** grid_map_;
 #endif
 
+    //! the last update time
+    GameTime update_time_;
+
     Impl()
         :
 #ifdef USE_VECTOR
@@ -266,13 +269,11 @@ void
 ViewGridMap::update( const GameTime & time,
                      const ViewArea & view_area )
 {
-    static GameTime s_update_time( 0, 0 );
-
-    if ( s_update_time == time )
+    if ( M_impl->update_time_ == time )
     {
         return;
     }
-    s_update_time = time;
+    M_impl->update_time_ = time;
 
 #ifdef DEBUG_PRINT
     dlog.addText( Logger::WORLD,
@@ -40,30 +40,316 @@
 #include <iterator>
 #include <algorithm>
 #include <limits> // std::numeric_limits
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <cmath> // HUGE_VAL
 
 namespace rcsc {
 
+namespace {
+
+/*!
+  \struct MarkerName
+  \brief marker flag name in the see message
+*/
+struct MarkerName {
+    const char * name_; //!< flag name used by protocol version 6 or later
+    MarkerID id_; //!< marker Id
+};
+
+/*!
+  \brief all marker flag names. the names for the older protocol are
+  converted to these names, e.g. "flag c t" -> "f c t".
+*/
+constexpr MarkerName MARKER_NAMES[] = {
+    { "g l", Goal_L }, { "g r", Goal_R },
+
+    { "f c", Flag_C }, { "f c t", Flag_CT }, { "f c b", Flag_CB },
+    { "f l t", Flag_LT }, { "f l b", Flag_LB },
+    { "f r t", Flag_RT }, { "f r b", Flag_RB },
+
+    { "f p l t", Flag_PLT }, { "f p l c", Flag_PLC }, { "f p l b", Flag_PLB },
+    { "f p r t", Flag_PRT }, { "f p r c", Flag_PRC }, { "f p r b", Flag_PRB },
+
+    { "f g l t", Flag_GLT }, { "f g l b", Flag_GLB },
+    { "f g r t", Flag_GRT }, { "f g r b", Flag_GRB },
+
+    { "f t l 50", Flag_TL50 }, { "f t l 40", Flag_TL40 }, { "f t l 30", Flag_TL30 },
+    { "f t l 20", Flag_TL20 }, { "f t l 10", Flag_TL10 },
+    { "f t 0", Flag_T0 },
+    { "f t r 10", Flag_TR10 }, { "f t r 20", Flag_TR20 }, { "f t r 30", Flag_TR30 },
+    { "f t r 40", Flag_TR40 }, { "f t r 50", Flag_TR50 },
+
+    { "f b l 50", Flag_BL50 }, { "f b l 40", Flag_BL40 }, { "f b l 30", Flag_BL30 },
+    { "f b l 20", Flag_BL20 }, { "f b l 10", Flag_BL10 },
+    { "f b 0", Flag_B0 },
+    { "f b r 10", Flag_BR10 }, { "f b r 20", Flag_BR20 }, { "f b r 30", Flag_BR30 },
+    { "f b r 40", Flag_BR40 }, { "f b r 50", Flag_BR50 },
+
+    { "f l t 30", Flag_LT30 }, { "f l t 20", Flag_LT20 }, { "f l t 10", Flag_LT10 },
+    { "f l 0", Flag_L0 },
+    { "f l b 10", Flag_LB10 }, { "f l b 20", Flag_LB20 }, { "f l b 30", Flag_LB30 },
+
+    { "f r t 30", Flag_RT30 }, { "f r t 20", Flag_RT20 }, { "f r t 10", Flag_RT10 },
+    { "f r 0", Flag_R0 },
+    { "f r b 10", Flag_RB10 }, { "f r b 20", Flag_RB20 }, { "f r b 30", Flag_RB30 },
+};
+
+constexpr int MARKER_NAME_SIZE = sizeof( MARKER_NAMES ) / sizeof( MARKER_NAMES[0] );
+
+constexpr int MARKER_HASH_BITS = 8;
+constexpr int MARKER_HASH_SIZE = 1 << MARKER_HASH_BITS;
+
 /*-------------------------------------------------------------------*/
+/*!
+  \brief get the length of the string at compile time
+*/
+constexpr
+std::size_t
+name_length( const char * name )
+{
+    std::size_t len = 0;
+    while ( name[len] != '\0' ) ++len;
+    return len;
+}
 
+/*-------------------------------------------------------------------*/
 /*!
-  \struct SeenDistCmp
-  \brief functor to compare seen distance of observed object
+  \brief hash value of the marker name.
+  The multiplier is chosen so that all names in MARKER_NAMES have the
+  different values. It is confirmed by static_assert below.
 */
-struct SeenDistCmp {
-    /*!
-      \brief operation function
-      \param lhs left hand side variable
-      \param rhs right hand side variable
-      \return compared result
-     */
-    bool operator()( const VisualSensor::PolarT & lhs,
-                     const VisualSensor::PolarT & rhs ) const
-      {
-          return lhs.dist_ < rhs.dist_;
-      }
+constexpr
+std::uint32_t
+marker_hash( const char * name,
+             const std::size_t len )
+{
+    std::uint32_t key = 0;
+    for ( std::size_t i = 0; i < len; ++i )
+    {
+        key = key * 31u + static_cast< unsigned char >( name[i] );
+    }
+    return ( key * 0x000eeaadu ) >> ( 32 - MARKER_HASH_BITS );
+}
+
+/*!
+  \struct MarkerHashTable
+  \brief perfect hash table from the marker name to the index of MARKER_NAMES
+*/
+struct MarkerHashTable {
+    signed char index_[MARKER_HASH_SIZE]; //!< index of MARKER_NAMES, or -1
+    bool collision_; //!< true if the hash function is not perfect
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief build the hash table at compile time
+*/
+constexpr
+MarkerHashTable
+create_marker_hash_table()
+{
+    MarkerHashTable table = {};
+    for ( int i = 0; i < MARKER_HASH_SIZE; ++i )
+    {
+        table.index_[i] = -1;
+    }
+
+    for ( int i = 0; i < MARKER_NAME_SIZE; ++i )
+    {
+        const std::uint32_t h = marker_hash( MARKER_NAMES[i].name_,
+                                             name_length( MARKER_NAMES[i].name_ ) );
+        if ( table.index_[h] >= 0 )
+        {
+            table.collision_ = true;
+        }
+        table.index_[h] = static_cast< signed char >( i );
+    }
+
+    return table;
+}
+
+constexpr MarkerHashTable MARKER_HASH_TABLE = create_marker_hash_table();
+
+static_assert( ! MARKER_HASH_TABLE.collision_,
+               "marker_hash() must be a perfect hash function of MARKER_NAMES" );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the marker Id of the name
+  \param name top of the marker name, e.g. "f c t"
+  \param len length of the name
+  \return marker Id, or Marker_Unknown
+*/
+inline
+MarkerID
+find_marker_id( const char * name,
+                const std::size_t len )
+{
+    const int index = MARKER_HASH_TABLE.index_[marker_hash( name, len )];
+    if ( index < 0 )
+    {
+        return Marker_Unknown;
+    }
+
+    const MarkerName & m = MARKER_NAMES[index];
+    if ( std::strncmp( m.name_, name, len ) != 0
+         || m.name_[len] != '\0' )
+    {
+        return Marker_Unknown;
+    }
+
+    return m.id_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the marker Id of the old style name, e.g. "flag c t"
+  \param name top of the marker name
+  \param len length of the name
+  \return marker Id, or Marker_Unknown
+*/
+inline
+MarkerID
+find_marker_id_old( const char * name,
+                    const std::size_t len )
+{
+    // "flag ..." -> "f ...", "goal ..." -> "g ..."
+    char buf[16];
+    if ( len <= 5
+         || len - 3 >= sizeof( buf )
+         || ( std::strncmp( name, "flag ", 5 ) != 0
+              && std::strncmp( name, "goal ", 5 ) != 0 ) )
+    {
+        return Marker_Unknown;
+    }
+
+    buf[0] = name[0];
+    std::memcpy( buf + 1, name + 4, len - 4 );
+    return find_marker_id( buf, len - 3 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the error value of std::strtod
+*/
+inline
+bool
+is_range_error( const double value )
+{
+    return ( value == HUGE_VAL || value == -HUGE_VAL );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the real number.
+  \param tok top of the number
+  \param value pointer to the variable to store the result
+  \return pointer to the next of the number
+
+  The plain decimal numbers used by rcssserver are converted by integer
+  arithmetic. Since both the mantissa and the divisor are exactly
+  representable, the result is identical to std::strtod. Other formats
+  are passed to std::strtod.
+*/
+inline
+const char *
+read_real( const char * tok,
+           double * value )
+{
+    static const double POW10[] = { 1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7,
+                                    1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15 };
+
+    const char * p = tok;
+    const bool negative = ( *p == '-' );
+    if ( *p == '-' || *p == '+' ) ++p;
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    while ( '0' <= *p && *p <= '9' )
+    {
+        mantissa = mantissa * 10 + ( *p - '0' );
+        ++digits;
+        ++p;
+    }
+
+    if ( *p == '.' )
+    {
+        ++p;
+        while ( '0' <= *p && *p <= '9' )
+        {
+            mantissa = mantissa * 10 + ( *p - '0' );
+            ++digits;
+            ++decimals;
+            ++p;
+        }
+    }
+
+    if ( digits == 0
+         || digits > 15
+         || *p == 'e'
+         || *p == 'E' )
+    {
+        char * next;
+        *value = std::strtod( tok, &next );
+        return next;
+    }
+
+    *value = static_cast< double >( mantissa ) / POW10[decimals];
+    if ( negative ) *value = -*value;
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief sort the seen objects by the seen distance.
+  The insertion sort is used, because it is stable, allocates no memory
+  and is fast enough for the small number of objects.
+*/
+template < typename Cont >
+void
+sort_by_dist( Cont & cont )
+{
+    const std::size_t size = cont.size();
+    for ( std::size_t i = 1; i < size; ++i )
+    {
+        if ( ! ( cont[i].dist_ < cont[i - 1].dist_ ) )
+        {
+            continue;
+        }
+
+        const typename Cont::value_type v = cont[i];
+        std::size_t j = i;
+        while ( j > 0 && v.dist_ < cont[j - 1].dist_ )
+        {
+            cont[j] = cont[j - 1];
+            --j;
+        }
+        cont[j] = v;
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+
+/*!
+  \struct VisualSensor::ObjectToken
+  \brief scanned object info, e.g. ((p "TEAM" 1) 10.5 -20 0.1 0.2 30 0 k)
+*/
+struct VisualSensor::ObjectToken {
+    enum {
+        MAX_VALUES = 8, //!< the maximal number of values
+    };
+
+    const char * name_; //!< top of the object name
+    std::size_t name_length_; //!< length of the object name
+    double values_[MAX_VALUES]; //!< numerical values in order
+    int value_size_; //!< the number of numerical values
+    int token_size_; //!< the number of all tokens after the object name
+    char flag_; //!< the first character of the non numerical token ('k' or 't'). '\0' if none.
 };
 
 
@@ -169,138 +455,16 @@ VisualSensor::VisualSensor()
     : M_time( -1, 0 ),
       M_their_team_name( "" )
 {
-    using namespace rcsc;
-    typedef std::pair< std::string, MarkerID > MarkerPair;
-
-    M_marker_map.insert( MarkerPair( "g l", Goal_L ) );
-    M_marker_map.insert( MarkerPair( "g r", Goal_R ) );
-
-    M_marker_map.insert( MarkerPair( "f c", Flag_C ) );
-    M_marker_map.insert( MarkerPair( "f c t", Flag_CT ) );
-    M_marker_map.insert( MarkerPair( "f c b", Flag_CB ) );
-    M_marker_map.insert( MarkerPair( "f l t", Flag_LT ) );
-    M_marker_map.insert( MarkerPair( "f l b", Flag_LB ) );
-    M_marker_map.insert( MarkerPair( "f r t", Flag_RT ) );
-    M_marker_map.insert( MarkerPair( "f r b", Flag_RB ) );
-
-    M_marker_map.insert( MarkerPair( "f p l t", Flag_PLT ) );
-    M_marker_map.insert( MarkerPair( "f p l c", Flag_PLC ) );
-    M_marker_map.insert( MarkerPair( "f p l b", Flag_PLB ) );
-    M_marker_map.insert( MarkerPair( "f p r t", Flag_PRT ) );
-    M_marker_map.insert( MarkerPair( "f p r c", Flag_PRC ) );
-    M_marker_map.insert( MarkerPair( "f p r b", Flag_PRB ) );
-
-    M_marker_map.insert( MarkerPair( "f g l t", Flag_GLT ) );
-    M_marker_map.insert( MarkerPair( "f g l b", Flag_GLB ) );
-    M_marker_map.insert( MarkerPair( "f g r t", Flag_GRT ) );
-    M_marker_map.insert( MarkerPair( "f g r b", Flag_GRB ) );
-
-    M_marker_map.insert( MarkerPair( "f t l 50", Flag_TL50 ) );
-    M_marker_map.insert( MarkerPair( "f t l 40", Flag_TL40 ) );
-    M_marker_map.insert( MarkerPair( "f t l 30", Flag_TL30 ) );
-    M_marker_map.insert( MarkerPair( "f t l 20", Flag_TL20 ) );
-    M_marker_map.insert( MarkerPair( "f t l 10", Flag_TL10 ) );
-    M_marker_map.insert( MarkerPair( "f t 0", Flag_T0 ) );
-    M_marker_map.insert( MarkerPair( "f t r 10", Flag_TR10 ) );
-    M_marker_map.insert( MarkerPair( "f t r 20", Flag_TR20 ) );
-    M_marker_map.insert( MarkerPair( "f t r 30", Flag_TR30 ) );
-    M_marker_map.insert( MarkerPair( "f t r 40", Flag_TR40 ) );
-    M_marker_map.insert( MarkerPair( "f t r 50", Flag_TR50 ) );
-
-    M_marker_map.insert( MarkerPair( "f b l 50", Flag_BL50 ) );
-    M_marker_map.insert( MarkerPair( "f b l 40", Flag_BL40 ) );
-    M_marker_map.insert( MarkerPair( "f b l 30", Flag_BL30 ) );
-    M_marker_map.insert( MarkerPair( "f b l 20", Flag_BL20 ) );
-    M_marker_map.insert( MarkerPair( "f b l 10", Flag_BL10 ) );
-    M_marker_map.insert( MarkerPair( "f b 0", Flag_B0 ) );
-    M_marker_map.insert( MarkerPair( "f b r 10", Flag_BR10 ) );
-    M_marker_map.insert( MarkerPair( "f b r 20", Flag_BR20 ) );
-    M_marker_map.insert( MarkerPair( "f b r 30", Flag_BR30 ) );
-    M_marker_map.insert( MarkerPair( "f b r 40", Flag_BR40 ) );
-    M_marker_map.insert( MarkerPair( "f b r 50", Flag_BR50 ) );
-
-    M_marker_map.insert( MarkerPair( "f l t 30", Flag_LT30 ) );
-    M_marker_map.insert( MarkerPair( "f l t 20", Flag_LT20 ) );
-    M_marker_map.insert( MarkerPair( "f l t 10", Flag_LT10 ) );
-    M_marker_map.insert( MarkerPair( "f l 0", Flag_L0 ) );
-    M_marker_map.insert( MarkerPair( "f l b 10", Flag_LB10 ) );
-    M_marker_map.insert( MarkerPair( "f l b 20", Flag_LB20 ) );
-    M_marker_map.insert( MarkerPair( "f l b 30", Flag_LB30 ) );
-
-    M_marker_map.insert( MarkerPair( "f r t 30", Flag_RT30 ) );
-    M_marker_map.insert( MarkerPair( "f r t 20", Flag_RT20 ) );
-    M_marker_map.insert( MarkerPair( "f r t 10", Flag_RT10 ) );
-    M_marker_map.insert( MarkerPair( "f r 0", Flag_R0 ) );
-    M_marker_map.insert( MarkerPair( "f r b 10", Flag_RB10 ) );
-    M_marker_map.insert( MarkerPair( "f r b 20", Flag_RB20 ) );
-    M_marker_map.insert( MarkerPair( "f r b 30", Flag_RB30 ) );
-
-    ///////////////////////////////////////////////////////////////////////
-    ///////////////////////////////////////////////////////////////////////
-    ///////////////////////////////////////////////////////////////////////
-
-    M_marker_map_old.insert( MarkerPair( "goal l", Goal_L ) );
-    M_marker_map_old.insert( MarkerPair( "goal r", Goal_R ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag c", Flag_C ) );
-    M_marker_map_old.insert( MarkerPair( "flag c t", Flag_CT ) );
-    M_marker_map_old.insert( MarkerPair( "flag c b", Flag_CB ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t", Flag_LT ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b", Flag_LB ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t", Flag_RT ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b", Flag_RB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag p l t", Flag_PLT ) );
-    M_marker_map_old.insert( MarkerPair( "flag p l c", Flag_PLC ) );
-    M_marker_map_old.insert( MarkerPair( "flag p l b", Flag_PLB ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r t", Flag_PRT ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r c", Flag_PRC ) );
-    M_marker_map_old.insert( MarkerPair( "flag p r b", Flag_PRB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag g l t", Flag_GLT ) );
-    M_marker_map_old.insert( MarkerPair( "flag g l b", Flag_GLB ) );
-    M_marker_map_old.insert( MarkerPair( "flag g r t", Flag_GRT ) );
-    M_marker_map_old.insert( MarkerPair( "flag g r b", Flag_GRB ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag t l 50", Flag_TL50 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 40", Flag_TL40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 30", Flag_TL30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 20", Flag_TL20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t l 10", Flag_TL10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t 0", Flag_T0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 10", Flag_TR10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 20", Flag_TR20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 30", Flag_TR30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 40", Flag_TR40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag t r 50", Flag_TR50 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag b l 50", Flag_BL50 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 40", Flag_BL40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 30", Flag_BL30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 20", Flag_BL20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b l 10", Flag_BL10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b 0", Flag_B0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 10", Flag_BR10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 20", Flag_BR20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 30", Flag_BR30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 40", Flag_BR40 ) );
-    M_marker_map_old.insert( MarkerPair( "flag b r 50", Flag_BR50 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag l t 30", Flag_LT30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t 20", Flag_LT20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l t 10", Flag_LT10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l 0", Flag_L0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 10", Flag_LB10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 20", Flag_LB20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag l b 30", Flag_LB30 ) );
-
-    M_marker_map_old.insert( MarkerPair( "flag r t 30", Flag_RT30 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t 20", Flag_RT20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r t 10", Flag_RT10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r 0", Flag_R0 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 10", Flag_RB10 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 20", Flag_RB20 ) );
-    M_marker_map_old.insert( MarkerPair( "flag r b 30", Flag_RB30 ) );
+    M_balls.reserve( 2 );
+    M_markers.reserve( MARKER_NAME_SIZE );
+    M_behind_markers.reserve( MARKER_NAME_SIZE );
+    M_lines.reserve( 4 );
+
+    M_teammates.reserve( 22 );
+    M_unknown_teammates.reserve( 22 );
+    M_opponents.reserve( 22 );
+    M_unknown_opponents.reserve( 22 );
+    M_unknown_players.reserve( 22 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -323,18 +487,13 @@ VisualSensor::parse( const char * msg,
     // clear old data
     clearAll();
 
-    ObjectType object_type;
+    ObjectToken token;
 
     MarkerT seen_marker;
     LineT seen_line;
     BallT seen_ball;
     PlayerT seen_player;
 
-    seen_marker.reset();
-    seen_line.reset();
-    seen_ball.reset();
-    seen_player.reset();
-
     // skip "(see "
     while ( *msg != ' ' ) ++msg;
 
@@ -351,9 +510,17 @@ VisualSensor::parse( const char * msg,
             break;
         }
 
+        const char * end = scanObject( msg, &token );
+        if ( ! end )
+        {
+            std::cerr << "VisualSensor::parse. broken object ["
+                      << msg << "]" << std::endl;
+            break;
+        }
+
         ////////////////////////////////////////
         // identify object type
-        object_type = getObjectTypeOf( *( msg + 2 ) );
+        const ObjectType object_type = getObjectTypeOf( *token.name_ );
 
         ////////////////////////////////////////
         // get object info
@@ -362,7 +529,7 @@ VisualSensor::parse( const char * msg,
              || object_type == Obj_Goal )
         {
             seen_marker.object_type_ = object_type;
-            if ( parseMarker( msg, version, &seen_marker ) )
+            if ( parseMarker( token, version, &seen_marker ) )
             {
                 M_markers.push_back( seen_marker );
             }
@@ -373,7 +540,7 @@ VisualSensor::parse( const char * msg,
                   || object_type == Obj_Goal_Behind )
         {
             seen_marker.object_type_ = object_type;
-            if ( parseMarker( msg, version, &seen_marker ) )
+            if ( parseMarker( token, version, &seen_marker ) )
             {
                 M_behind_markers.push_back( seen_marker );
             }
@@ -382,7 +549,7 @@ VisualSensor::parse( const char * msg,
         // player
         else if ( object_type == Obj_Player )
         {
-            switch ( parsePlayer( msg, team_name, &seen_player ) ) {
+            switch ( parsePlayer( token, team_name, &seen_player ) ) {
             case Player_Teammate:
                 M_teammates.push_back( seen_player );
                 break;
@@ -410,7 +577,7 @@ VisualSensor::parse( const char * msg,
         // line
         else if ( object_type == Obj_Line )
         {
-            if ( parseLine( msg, version, &seen_line ) )
+            if ( parseLine( token, version, &seen_line ) )
             {
                 M_lines.push_back( seen_line );
             }
@@ -419,7 +586,7 @@ VisualSensor::parse( const char * msg,
         // ball
         else if ( object_type == Obj_Ball )
         {
-            if ( parseBall( msg, &seen_ball ) )
+            if ( parseBall( token, &seen_ball ) )
             {
                 M_balls.push_back( seen_ball );
             }
@@ -427,49 +594,93 @@ VisualSensor::parse( const char * msg,
         }
         else // if ( object_type == Obj_Unknown )
         {
-            std::cerr << "Unknown Object Type [" << *( msg + 2 ) << "]"
+            std::cerr << "Unknown Object Type [" << *token.name_ << "]"
                       << std::endl;
         }
 
-        // skip object info token
-        while ( *msg != '\0' && *msg != ')' ) ++msg; // skip object info
-        while ( *msg != '\0' && *msg != '(' ) ++msg; // skip to next object token
+        // skip to next object token
+        msg = end;
+        while ( *msg != '\0' && *msg != '(' ) ++msg;
     } // main loop
 
 
     // sort by distance
-    M_teammates.sort( SeenDistCmp() );
-    M_unknown_teammates.sort( SeenDistCmp() );
-    M_opponents.sort( SeenDistCmp() );
-    M_unknown_opponents.sort( SeenDistCmp() );
-    M_unknown_players.sort( SeenDistCmp() );
+    sort_by_dist( M_teammates );
+    sort_by_dist( M_unknown_teammates );
+    sort_by_dist( M_opponents );
+    sort_by_dist( M_unknown_opponents );
+    sort_by_dist( M_unknown_players );
 
-    M_markers.sort( SeenDistCmp() );
-    M_behind_markers.sort( SeenDistCmp() );
+    sort_by_dist( M_markers );
+    sort_by_dist( M_behind_markers );
 
     // line sort is very important !!
-    M_lines.sort( SeenDistCmp() );
-
-#if 0
-    dlog.addText( Logger::SENSOR,
-                  __FILE__" (parse) t=%d ut=%d o=%d uo=%d uk=%d"
-                  "  seen markers=%d.  behind_markers=%d. lines=%d"
-                  " ball=%d",
-                  M_teammates.size(), M_unknown_teammates.size(),
-                  M_opponents.size(), M_unknown_opponents.size(),
-                  M_unknown_players.size()
-                  M_markers.size(), M_behind_markers.size(),
-                  M_lines.size(), M_balls.size() );
-#endif
-#if 0
-    if ( M_markers.size() > 10 )
+    sort_by_dist( M_lines );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const char *
+VisualSensor::scanObject( const char * msg,
+                          ObjectToken * token )
+{
+    // ((NAME) VALUE VALUE ... [k|t])
+
+    // skip to first of object name
+    while ( *msg == '(' ) ++msg;
+
+    token->name_ = msg;
+    while ( *msg != ')' )
     {
-        dlog.addText( Logger::SENSOR,
-                      __FILE__" (parse) marker resize to 10 from %d",
-                      M_markers.size() );
-        M_markers.resize( 10 );
+        if ( *msg == '\0' ) return static_cast< const char * >( 0 );
+        ++msg;
     }
-#endif
+    token->name_length_ = static_cast< std::size_t >( msg - token->name_ );
+    ++msg; // skip paren
+
+    token->value_size_ = 0;
+    token->token_size_ = 0;
+    token->flag_ = '\0';
+
+    while ( true )
+    {
+        while ( *msg == ' ' ) ++msg;
+
+        if ( *msg == ')' ) break;
+        if ( *msg == '\0' ) return static_cast< const char * >( 0 );
+
+        ++token->token_size_;
+
+        if ( ( '0' <= *msg && *msg <= '9' )
+             || *msg == '-'
+             || *msg == '+'
+             || *msg == '.' )
+        {
+            double value = 0.0;
+            const char * next = read_real( msg, &value );
+            if ( token->value_size_ < ObjectToken::MAX_VALUES )
+            {
+                token->values_[token->value_size_++] = value;
+            }
+
+            if ( next != msg )
+            {
+                msg = next;
+                continue;
+            }
+        }
+        else if ( token->flag_ == '\0' )
+        {
+            token->flag_ = *msg;
+        }
+
+        // skip the rest of the token
+        while ( *msg != ' ' && *msg != ')' && *msg != '\0' ) ++msg;
+    }
+
+    return msg;
 }
 
 /*-------------------------------------------------------------------*/
@@ -477,7 +688,7 @@ VisualSensor::parse( const char * msg,
 
 */
 bool
-VisualSensor::parseMarker( const char * tok,
+VisualSensor::parseMarker( const ObjectToken & token,
                            const double & version,
                            MarkerT * info )
 {
@@ -489,80 +700,34 @@ VisualSensor::parseMarker( const char * tok,
     }
     else
     {
-        // skip to first of object name
-        while ( *tok == '(' ) ++tok; // skip to first identifier
-
-        // get marker name
-        int i = 0;
-        std::string marker_name;
-        while ( *( tok + i ) != ')' )
-        {
-            marker_name += *( tok + i );
-            ++i;
-        }
-
-        // search marker id
-        info->id_ = Marker_Unknown;
-        if ( version >= 6.0 )
-        {
-            std::map< std::string, MarkerID >::iterator
-                it = M_marker_map.find( marker_name );
-            if ( it != M_marker_map.end() )
-            {
-                info->id_ = it->second;
-            }
-        }
-        else
-        {
-            std::map< std::string, MarkerID >::iterator
-                it = M_marker_map_old.find( marker_name );
-            if ( it != M_marker_map_old.end() )
-            {
-                info->id_ = it->second;
-            }
-        }
+        info->id_ = ( version >= 6.0
+                      ? find_marker_id( token.name_, token.name_length_ )
+                      : find_marker_id_old( token.name_, token.name_length_ ) );
 
         if ( info->id_ == Marker_Unknown )
         {
-            std::cerr << "VisualSensor::parseMarker. unknown marker "
-                      << std::string( tok, 16 ) << "]"
+            std::cerr << "VisualSensor::parseMarker. unknown marker ["
+                      << std::string( token.name_, token.name_length_ ) << "]"
                       << std::endl;
             return false;
         }
     }
 
-    // skip object name
-    while ( *tok != ')' ) ++tok; // skip all object name
-    tok += 2; // skip paren & space
-
-    char *next;
-
-    // read dist
-    info->dist_ = std::strtod( tok, &next );
-    if ( info->dist_ == -HUGE_VAL
-         || info->dist_ == HUGE_VAL )
-    {
-        std::cerr << "VisualSensor::parseMarker. distance read error.["
-                  << std::string( tok, 16 ) << "]"
-                  << std::endl;
-        return false;
-    }
-    tok = next;
-
     // check view quality
-    if ( *tok == ')' )
+    if ( token.value_size_ < 2 )
     {
         //std::cerr << "VisualSensor:: parseMarker: view quality is LOW ??\n";
         return false;
     }
 
-    // read dir
-    info->dir_ = std::strtod( tok, NULL );
-    if ( info->dir_ == -HUGE_VAL
-         || info->dir_ == HUGE_VAL )
+    info->dist_ = token.values_[0];
+    info->dir_ = token.values_[1];
+
+    if ( is_range_error( info->dist_ )
+         || is_range_error( info->dir_ ) )
     {
-        std::cerr << "VisualSensor::parseMarker: dir read error.["
-                  << std::string( tok, 16 ) << "]"
+        std::cerr << "VisualSensor::parseMarker. polar value error. ["
+                  << std::string( token.name_, token.name_length_ ) << "]"
                   << std::endl;
         return false;
     }
@@ -576,72 +741,17 @@ VisualSensor::parseMarker( const char * tok,
 
 */
 bool
-VisualSensor::parseLine( const char * tok,
+VisualSensor::parseLine( const ObjectToken & token,
                          const double & version,
                          LineT * info )
 {
-#if 0
     // ((l <side>) <dist> <dir>))
-    // ((L <side>) <dist> <dir>))
     // ((line <side>) <dist> <dir>))
-    // ((Line <side>) <dist> <dir>))
-
-    char id[8];
-    char side;
-    int n_read = 0;
-    if ( std::sscanf( tok, " ( ( %[^ ] %c ) %lf %lf ) %n",
-                      id, &side,
-                      &(info->dist_),
-                      &(info->dir_),
-                      &n_read  ) == 4 )
-    {
-        // high quality line
-    }
-    else if ( std::sscanf( tok, " ( ( %[^ ] %c) %lf ) %n",
-                           id, &side,
-                           &(info->dir_),
-                           &n_read ) == 3 )
-    {
-        // low quality line
-    }
-    else
-    {
-        std::cerr << "Unsupported line message "
-                  << std::string( tok, 16 ) << std::endl;
-        info->id_ = Line_Unknown;
-        return false;
-    }
-
-    switch ( side ) {
-    case 'l':
-        info->id_ = Line_Left;
-        break;
-    case 'r':
-        info->id_ = Line_Right;
-        break;
-    case 't':
-        info->id_ = Line_Top;
-        break;
-    case 'b':
-        info->id_ = Line_Bottom;
-        break;
-    default:
-        std::cerr << "Unknown line type [" << *( tok + 2 ) << "]"
-                  << std::endl;
-        info->id_ = Line_Unknown;
-        return false;
-    }
-
-    return true;
-
-#else
-    // skip to first of object name
-    while ( *tok == '(' ) ++tok;
 
     // check line name
-    int i = ( version >= 6.0 ? 2 : 5 );
+    const std::size_t i = ( version >= 6.0 ? 2 : 5 );
 
-    switch ( *(tok + i) ) {
+    switch ( i < token.name_length_ ? token.name_[i] : '\0' ) {
     case 'l':
         info->id_ = Line_Left;
         break;
@@ -655,50 +765,33 @@ VisualSensor::parseLine( const char * tok,
         info->id_ = Line_Bottom;
         break;
     default:
-        std::cerr << "Unknown line type [" << *( tok + 2 ) << "]"
+        std::cerr << "Unknown line type ["
+                  << std::string( token.name_, token.name_length_ ) << "]"
                   << std::endl;
         info->id_ = Line_Unknown;
         return false;
     }
 
-    // skip object name
-    while ( *tok != ')' ) ++tok; // skip all object name
-    tok += 2; // skip paren & space
-
-    char *next;
-
-    // read dist
-    info->dist_ = std::strtod( tok, &next );
-    if ( info->dist_ == -HUGE_VAL
-         || info->dist_ == HUGE_VAL )
-    {
-        std::cerr << "VisualSensor:: parseLine: distance read error.["
-                  << std::string( tok, 16 ) << "]"
-                  << std::endl;
-        return false;
-    }
-    tok = next;
-
     // check view quality
-    if ( *tok == ')' )
+    if ( token.value_size_ < 2 )
     {
         //std::cerr << "VisualSensor:: parseLine: view quality is LOW ??\n";
         return false;
     }
 
-    // read dir
-    info->dir_ = std::strtod( tok, NULL );
-    if ( info->dir_ == -HUGE_VAL
-         || info->dir_== HUGE_VAL )
+    info->dist_ = token.values_[0];
+    info->dir_ = token.values_[1];
+
+    if ( is_range_error( info->dist_ )
+         || is_range_error( info->dir_ ) )
     {
-        std::cerr << "VisualSensor::parseLine: dirread error.["
-                  << std::string( tok, 16 ) << "]"
-                  << std::endl;;
+        std::cerr << "VisualSensor::parseLine. polar value error. ["
+                  << std::string( token.name_, token.name_length_ ) << "]"
+                  << std::endl;
         return false;
     }
 
     return true;
-#endif
 }
 
 /*-------------------------------------------------------------------*/
@@ -706,60 +799,38 @@ VisualSensor::parseLine( const char * tok,
 
 */
 bool
-VisualSensor::parseBall( const char * tok,
+VisualSensor::parseBall( const ObjectToken & token,
                          BallT * info )
 {
-    // skip all object name
-    while ( *tok != ')' ) ++tok;
-    tok += 2; // skip space & paren
-
-    char *next;
-
-    // read dist
-    info->dist_ = std::strtod( tok, &next );
-    if ( info->dist_ == -HUGE_VAL
-         || info->dist_ == HUGE_VAL )
-    {
-        std::cerr << "VisualSensor::parseBall: distance read error.["
-                  << std::string( tok, 16 ) << "]"
-                  << std::endl;
-        return false;
-    }
-    tok = next;
-
     // check view quality
-    if ( *tok == ')' )
+    if ( token.value_size_ < 2 )
     {
         //std::cerr << "VisualSensor:: parseBall: view quality is LOW ??\n";
         return false;
     }
 
-    // read dir
-    info->dir_ = std::strtod( tok, &next );
-    if ( info->dir_ == -HUGE_VAL
-         || info->dir_ == HUGE_VAL )
+    info->dist_ = token.values_[0];
+    info->dir_ = token.values_[1];
+
+    if ( is_range_error( info->dist_ )
+         || is_range_error( info->dir_ ) )
     {
-        std::cerr << "VisualSensor::parseBall: dir read error. ["
-                  << std::string( tok, 16 ) << "]"
+        std::cerr << "VisualSensor::parseBall. polar value error."
+                  << " dist=" << info->dist_ << " dir=" << info->dir_
                   << std::endl;
         return false;
     }
-    tok = next;
 
     // read velocity info. order is dist_chg -> dir_chg
-    if ( *tok != ')' )
+    if ( token.value_size_ >= 3 )
     {
-        info->dist_chng_ = std::strtod( tok, &next );
-        tok = next;
-        info->dir_chng_ = std::strtod( tok, NULL );
+        info->dist_chng_ = token.values_[2];
+        info->dir_chng_ = ( token.value_size_ >= 4 ? token.values_[3] : 0.0 );
         info->has_vel_ = true;
-        if ( info->dist_chng_ == -HUGE_VAL
-             || info->dist_chng_ == HUGE_VAL
-             || info->dir_chng_ == -HUGE_VAL
-             || info->dir_chng_ == HUGE_VAL )
+        if ( is_range_error( info->dist_chng_ )
+             || is_range_error( info->dir_chng_ ) )
         {
-            std::cerr << "VisualSensor:: parseBall. chng read error.["
-                      << std::string( tok, 16 ) << "]"
+            std::cerr << "VisualSensor:: parseBall. chng read error."
                       << std::endl;
             info->dist_chng_ = 0.0;
             info->dir_chng_ = 0.0;
@@ -776,36 +847,31 @@ VisualSensor::parseBall( const char * tok,
 
 */
 VisualSensor::PlayerInfoType
-VisualSensor::parsePlayer( const char * tok,
+VisualSensor::parsePlayer( const ObjectToken & token,
                            const std::string & team_name,
                            PlayerT * info )
 {
     PlayerInfoType result_type = Player_Illegal;
 
-    // skip to first of object name
-    while ( *tok == '(' ) ++tok;
-
-    // count the space in object name for player identify
-    // (p), (p "TEAMNAME"), (p "TEAMNAME" UNUM), (p "TEAMNAME" UNUM goalie)
-    int n_space = 0;
-    for ( int i = 1; *(tok + i) != ')' && *(tok + i) != '\0'; ++i )
-    {
-        if ( *(tok + i) == ' ' ) ++n_space;
-    }
-
     // check player name
-    // ((p "TEAMNAME" UNUM [goalie]) ...)
+    // (p), (p "TEAMNAME"), (p "TEAMNAME" UNUM), (p "TEAMNAME" UNUM goalie)
+    const char * tok = token.name_;
+    const char * const name_end = token.name_ + token.name_length_;
 
     // check teamname
-    if ( n_space > 0 ) // exist team name
-    {
-        while ( *tok != '\"' ) ++tok; // " skip to team name
-        ++tok; // skip '"'
+    const char * team_begin = static_cast< const char * >( std::memchr( tok, '\"', token.name_length_ ) );
+    const char * team_end = ( team_begin
+                              ? static_cast< const char * >( std::memchr( team_begin + 1, '\"',
+                                                                          name_end - team_begin - 1 ) )
+                              : static_cast< const char * >( 0 ) );
 
-        const size_t len = team_name.length();
+    if ( team_begin && team_end ) // exist team name
+    {
+        ++team_begin; // skip '"'
+        const std::size_t len = static_cast< std::size_t >( team_end - team_begin );
 
-        if ( *( tok + len ) == '\"' // "
-             && team_name.compare( 0, len, tok, len ) == 0 )
+        if ( len == team_name.length()
+             && team_name.compare( 0, len, team_begin, len ) == 0 )
         {
             result_type = Player_Unknown_Teammate;
         }
@@ -814,11 +880,11 @@ VisualSensor::parsePlayer( const char * tok,
             result_type = Player_Unknown_Opponent;
             if ( M_their_team_name.empty() )
             {
-                while ( *tok != '\"' ) M_their_team_name += *tok++; // "
-                // std::cerr << "copy opponent team name : "
-                // << M_opponent_team_name << std::endl;
+                M_their_team_name.assign( team_begin, len );
             }
         }
+
+        tok = team_end + 1;
     }
     else
     {
@@ -826,177 +892,153 @@ VisualSensor::parsePlayer( const char * tok,
     }
 
     // check unum
-    if ( n_space > 1 )
-    {
-        while ( *tok != ' ' ) ++tok;
-        info->unum_ = std::atoi( tok );
-        // we can get all player identifier
-        result_type = ( result_type == Player_Unknown_Teammate
-                        ? Player_Teammate
-                        : Player_Opponent );
-    }
-    else
+    info->unum_ = Unum_Unknown;
+    if ( result_type != Player_Unknown )
     {
-        info->unum_ = Unum_Unknown;
+        while ( tok < name_end && *tok == ' ' ) ++tok;
+        if ( tok < name_end )
+        {
+            int unum = 0;
+            while ( tok < name_end && '0' <= *tok && *tok <= '9' )
+            {
+                unum = unum * 10 + ( *tok - '0' );
+                ++tok;
+            }
+            info->unum_ = unum;
+            // we can get all player identifier
+            result_type = ( result_type == Player_Unknown_Teammate
+                            ? Player_Teammate
+                            : Player_Opponent );
+
+            // check goalie flag
+            while ( tok < name_end && *tok == ' ' ) ++tok;
+            if ( tok < name_end )
+            {
+                info->goalie_ = true;
+            }
+        }
     }
 
-    // check goalie flag
-    if ( n_space > 2 )
+    // check positional info pattern
+    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> <TACKLE|KICK> : token = 8
+    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> : token = 7
+    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <TACKLE|KICK> : token = 7
+    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> : token = 6
+    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> : token = 5  only sserver-4
+    // <DIST> <DIR> <DISTCH> <DIRCH> : token = 4
+    // <DIST> <DIR> <POINTDIR> <TACKLE|KICK> : token = 4
+    // <DIST> <DIR> <POINTDIR> : token = 3
+    // <DIST> <DIR> <TACKLE|KICK> : token = 3
+    // <DIST> <DIR> : token = 2
+    // <DIR> : token = 1
+
+    const double * v = token.values_;
+    const int n_token = token.token_size_;
+    const int n_value = std::min( n_token, static_cast< int >( ObjectToken::MAX_VALUES ) );
+    const bool kicking = ( token.flag_ == 'k' );
+    const bool tackle = ( token.flag_ == 't' );
+    const bool has_flag = ( token.flag_ != '\0' );
+
+    if ( n_token < 2
+         || n_token > ObjectToken::MAX_VALUES )
     {
-        info->goalie_ = true;
+        //std::cerr << "ViewQuality is Low ?? Unexpected player see info pattern\n";
+        return Player_Low_Mode;
     }
 
-    // skip all player name
-    while ( *tok != ')' ) ++tok;
-    ++tok;
-
-    // "tok" must point object name next space
-
-    // check positional info pattern
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> <TACKLE|KICK>)" : space = 8
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR>)" : space = 7
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <TACKLE|KICK>)" : space = 7
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD>)" : space = 6
-    // " <DIST> <DIR> <DISTCH> <DIRCH> <BODY>)" : space = 5  only sserver-4
-    // " <DIST> <DIR> <DISTCH> <DIRCH>)" : space = 4
-    // " <DIST> <DIR> <POINTDIR> <TACKLE|KICK>)" : space = 4
-    // " <DIST> <DIR> <POINTDIR>)" : space = 3
-    // " <DIST> <DIR> <TACKLE|KICK>)" : space = 3
-    // " <DIST> <DIR>)" : space = 2
-    // " <DIR>)" : space = 1
-
-    // count space in positional info
-    n_space = 0;
-    for ( int i = 0; *(tok + i) != ')' && *(tok + i) != '\0'; ++i )
+    if ( token.value_size_ < n_value - ( has_flag ? 1 : 0 ) )
     {
-        if ( *( tok + i ) == ' ' ) ++n_space;
+        std::cerr << "VisualSensor::parsePlayer. unexpected pattern."
+                  << std::endl;
+        return Player_Illegal;
     }
 
-    char *next;
-
-    // read each value on each pattern
-
-    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> <TACKLE>
-    if ( n_space == 8 )
-    {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, &next ); tok = next;
-        info->face_ = std::strtod( tok, &next ); tok = next;
-        info->arm_ = std::strtod( tok, &next ); tok = next;
+    info->dist_ = v[0];
+    info->dir_ = v[1];
+
+    switch ( n_token ) {
+    case 8:
+        // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR> <TACKLE|KICK>
+        info->dist_chng_ = v[2];
+        info->dir_chng_ = v[3];
+        info->body_ = v[4];
+        info->face_ = v[5];
+        info->arm_ = v[6];
         info->has_vel_ = true;
-        if ( *(tok + 1) == 'k' ) info->kicking_ = true;
-        if ( *(tok + 1) == 't' ) info->tackle_ = true;
-    }
-    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR>
-    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <TACKLE>
-    else if ( n_space == 7 )
-    {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, &next ); tok = next;
-        info->face_ = std::strtod( tok, &next ); tok = next;
+        info->kicking_ = kicking;
+        info->tackle_ = tackle;
+        break;
+    case 7:
+        // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <POINTDIR>
+        // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD> <TACKLE|KICK>
+        info->dist_chng_ = v[2];
+        info->dir_chng_ = v[3];
+        info->body_ = v[4];
+        info->face_ = v[5];
         info->has_vel_ = true;
-        if ( *(tok + 1) == 'k' )
-        {
-            info->kicking_ = true;
-        }
-        else if ( *(tok + 1) == 't' )
+        if ( has_flag )
         {
-            info->tackle_ = true;
+            info->kicking_ = kicking;
+            info->tackle_ = tackle;
         }
         else
         {
-            info->arm_ = std::strtod( tok, NULL );
+            info->arm_ = v[6];
         }
-    }
-    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD>
-    else if ( n_space == 6 )
-    {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, &next ); tok = next;
-        info->face_ = std::strtod( tok, NULL );
+        break;
+    case 6:
+        // <DIST> <DIR> <DISTCH> <DIRCH> <BODY> <HEAD>
+        info->dist_chng_ = v[2];
+        info->dir_chng_ = v[3];
+        info->body_ = v[4];
+        info->face_ = v[5];
         info->has_vel_ = true;
-    }
-    // <DIST> <DIR> <DISTCH> <DIRCH> <BODY>
-    else if ( n_space == 5 )
-    {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        info->dist_chng_ = std::strtod( tok, &next ); tok = next;
-        info->dir_chng_  = std::strtod( tok, &next ); tok = next;
-        info->body_ = std::strtod( tok, NULL );
+        break;
+    case 5:
+        // <DIST> <DIR> <DISTCH> <DIRCH> <BODY>
+        info->dist_chng_ = v[2];
+        info->dir_chng_ = v[3];
+        info->body_ = v[4];
         info->face_ = 0.0;
         info->has_vel_ = true;
-    }
-    // <DIST> <DIR> <DISTCH> <DIRCH>
-    // <DIST> <DIR> <POINTDIR> <TACKLE>
-    else if ( n_space == 4 )
-    {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        double tmp = std::strtod( tok, &next ); tok = next;
-        if ( *(tok + 1) == 'k' )
-        {
-            info->arm_ = tmp;
-            info->kicking_ = true;
-        }
-        else if ( *(tok + 1) == 't' )
+        break;
+    case 4:
+        // <DIST> <DIR> <DISTCH> <DIRCH>
+        // <DIST> <DIR> <POINTDIR> <TACKLE|KICK>
+        if ( has_flag )
         {
-            info->arm_ = tmp;
-            info->tackle_ = true;
+            info->arm_ = v[2];
+            info->kicking_ = kicking;
+            info->tackle_ = tackle;
         }
         else
         {
-            info->dist_chng_ = tmp;
-            info->dir_chng_ = std::strtod( tok, NULL );
+            info->dist_chng_ = v[2];
+            info->dir_chng_ = v[3];
         }
-    }
-    // <DIST> <DIR> <POINTDIR>
-    // <DIST> <DIR> <TACKLE>
-    else if ( n_space == 3 )
-    {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, &next ); tok = next;
-        if ( *(tok + 1) == 'k' )
-        {
-            info->kicking_ = true;
-        }
-        else if ( *(tok + 1) == 't' )
+        break;
+    case 3:
+        // <DIST> <DIR> <POINTDIR>
+        // <DIST> <DIR> <TACKLE|KICK>
+        if ( has_flag )
         {
-            info->tackle_ = true;
+            info->kicking_ = kicking;
+            info->tackle_ = tackle;
         }
         else
         {
-            info->arm_ = std::strtod( tok, NULL );
+            info->arm_ = v[2];
         }
-    }
-    // <DIST> <DIR>
-    else if ( n_space == 2 )
-    {
-        info->dist_ = std::strtod( tok, &next ); tok = next;
-        info->dir_  = std::strtod( tok, NULL );
-    }
-    else
-    {
-        //std::cerr << "ViewQuality is Low ?? Unexpected player see info pattern\n   ["
-        //          << tok << "]" << std::endl;
-        return Player_Low_Mode;
+        break;
+    default:
+        // <DIST> <DIR>
+        break;
     }
 
     // check error
     if ( info->dist_ < 0.0
-         || info->dist_ == -HUGE_VAL
-         || info->dist_ == HUGE_VAL
-         || info->dir_ == -HUGE_VAL
-         || info->dir_ == HUGE_VAL )
+         || is_range_error( info->dist_ )
+         || is_range_error( info->dir_ ) )
     {
         std::cerr << "VisualSensor::parsePlayer. polar value error."
                   << " dist=" << info->dist_ << " dir=" << info->dir_
@@ -1005,11 +1047,8 @@ VisualSensor::parsePlayer( const char * tok,
     }
 
     if ( info->has_vel_
-         && ( info->dist_chng_ == -HUGE_VAL
-              || info->dist_chng_ == HUGE_VAL
-              || info->dir_chng_ == -HUGE_VAL
-              || info->dir_chng_ == HUGE_VAL )
-         )
+         && ( is_range_error( info->dist_chng_ )
+              || is_range_error( info->dir_chng_ ) ) )
     {
         std::cerr << "VisualSensor::parsePlayer. chng value error"
                   << std::endl;
@@ -1019,24 +1058,21 @@ VisualSensor::parsePlayer( const char * tok,
         info->has_vel_ = false;
     }
 
-    if ( info->body_ == -HUGE_VAL
-         || info->body_ == HUGE_VAL )
+    if ( is_range_error( info->body_ ) )
     {
         std::cerr << "VisualSensor::parsePlayer. body value error"
                   << std::endl;
         info->body_ = DIR_ERR;
     }
 
-    if ( info->face_ == -HUGE_VAL
-         || info->face_ == HUGE_VAL )
+    if ( is_range_error( info->face_ ) )
     {
         std::cerr << "VisualSensor::parsePlayer. neck value error"
                   << std::endl;
         info->face_ = DIR_ERR;
     }
 
-    if ( info->arm_ == -HUGE_VAL
-         || info->arm_ == HUGE_VAL )
+    if ( is_range_error( info->arm_ ) )
     {
         std::cerr << "VisualSensor::parsePlayer. point value error"
                   << std::endl;
@@ -35,8 +35,6 @@
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
 
-#include <map>
-#include <list>
 #include <vector>
 #include <string>
 #include <iostream>
@@ -251,22 +249,24 @@ public:
           }
     };
 
+    /*
+      The containers are cleared at every parse, but their memory is
+      kept. Since enough capacity is reserved in the constructor, no
+      memory is allocated while parsing the see message.
+    */
     typedef std::vector< BallT > BallCont; //!< observed ball container
-    typedef std::list< MarkerT > MarkerCont; //!< observed marker container
-    typedef std::list< LineT > LineCont; //!< observed line container
-    typedef std::list< PlayerT > PlayerCont; //!< observed player container
+    typedef std::vector< MarkerT > MarkerCont; //!< observed marker container
+    typedef std::vector< LineT > LineCont; //!< observed line container
+    typedef std::vector< PlayerT > PlayerCont; //!< observed player container
 
 private:
 
+    struct ObjectToken;
+
     GameTime M_time; //!< last updated time
 
     std::string M_their_team_name; //!< seen opponent team name
 
-    //! marker ID map
-    std::map< std::string, MarkerID > M_marker_map;
-    //! marker ID map, old name
-    std::map< std::string, MarkerID > M_marker_map_old;
-
     BallCont M_balls; //!< seen ball
     MarkerCont M_markers; //!< seen markers
     MarkerCont M_behind_markers; //!< seen behind markers
@@ -281,7 +281,7 @@ private:
 public:
 
     /*!
-      \brief create marker map
+      \brief reserve the capacity of the containers
     */
     VisualSensor();
 
@@ -419,49 +419,53 @@ private:
           }
       }
 
+    /*!
+      \brief read the name and the values of the next object
+      \param msg pointer to the top of object info, i.e. "((name) ..."
+      \param token pointer to the variable to store the result
+      \return pointer to the last paren of the object. NULL if broken.
+
+      The message is scanned only once, and no memory is allocated.
+    */
+    static
+    const char * scanObject( const char * msg,
+                             ObjectToken * token );
+
     /*!
       \brief parse marker flag info
-      \param tok pointer to the top of object info
+      \param token scanned object info
       \param version rcssserver protocol version
       \param info pointer to the varialbe to store the data.
-
-      get positional data from object info token
     */
-    bool parseMarker( const char * tok,
+    bool parseMarker( const ObjectToken & token,
                       const double & version,
                       MarkerT * info );
 
     /*!
       \brief parse line info
-      \param tok pointer to the top of object info
+      \param token scanned object info
       \param version rcssserver protocol version
       \param info pointer to the varialbe to store the data.
-
-      get positional data from object info token
     */
-    bool parseLine( const char * tok,
+    bool parseLine( const ObjectToken & token,
                     const double & version,
                     LineT * info );
 
     /*!
-      \brief parse line info
-      \param tok pointer to the top of object info
+      \brief parse ball info
+      \param token scanned object info
       \param info pointer to the varialbe to store the data.
-
-      get positional data from object info token
     */
-    bool parseBall( const char * tok,
+    bool parseBall( const ObjectToken & token,
                     BallT * info );
 
     /*!
       \brief parse player info
-      \param tok pointer to the top of object info
+      \param token scanned object info
       \param team_name our team name
       \param info pointer to the varialbe to store the data.
-
-      get positional data from object info token
     */
-    PlayerInfoType parsePlayer( const char * tok,
+    PlayerInfoType parsePlayer( const ObjectToken & token,
                                 const std::string & team_name,
                                 PlayerT * info );
 
@@ -50,6 +50,7 @@
 #include <rcsc/common/logger.h>
 #include <rcsc/common/player_param.h>
 #include <rcsc/common/server_param.h>
+#include <rcsc/time/profiler.h>
 #include <rcsc/time/timer.h>
 #include <rcsc/soccer_math.h>
 #include <rcsc/math_util.h>
@@ -91,14 +92,14 @@ namespace  {
 */
 inline
 void
-create_player_set( PlayerObject::List & players,
+create_player_set( PlayerObjectPool::List & players,
                    PlayerObject::Cont & players_from_self,
                    PlayerObject::Cont & players_from_ball,
                    const Vector2D & self_pos,
                    const Vector2D & ball_pos )
 
 {
-    for ( PlayerObject::List::iterator it = players.begin(),
+    for ( PlayerObjectPool::List::iterator it = players.begin(),
               end = players.end();
           it != end;
           ++it )
@@ -140,11 +141,11 @@ get_kickable_player( PlayerObject::Cont::iterator first,
                                                    (*first)->distFromSelf()
                                                    * dist_error_rate ) ) ) )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (check_player_kickable) exist %d-%d (%.1f %.1f)",
-                          (*first)->side(),
-                          (*first)->unum(),
-                          (*first)->pos().x, (*first)->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (check_player_kickable) exist %d-%d (%.1f %.1f)",
+                       (*first)->side(),
+                       (*first)->unum(),
+                       (*first)->pos().x, (*first)->pos().y );
             return *first;
         }
 
@@ -201,14 +202,14 @@ get_self_face_angle( const WorldModel & wm,
     {
         if ( pen_state.isKickTaker( wm.ourSide(), wm.self().unum() ) )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=LEFT && kicker -> reverse" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (get_self_face_angle) pen_onfield=LEFT && kicker -> reverse" );
             return AngleDeg::normalize_angle( seen_face_angle + 180.0 );
         }
         else if ( wm.self().goalie() )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=LEFT && goalie -> no reverse" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (get_self_face_angle) pen_onfield=LEFT && goalie -> no reverse" );
             return seen_face_angle;
         }
     }
@@ -216,20 +217,20 @@ get_self_face_angle( const WorldModel & wm,
     {
         if ( pen_state.isKickTaker( wm.ourSide(), wm.self().unum() ) )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=RIGHT && kicker -> no reverse" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (get_self_face_angle) pen_onfield=RIGHT && kicker -> no reverse" );
             return seen_face_angle;
         }
         else if ( wm.self().goalie() )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (get_self_face_angle) pen_onfield=RIGHT && goalie -> reverse" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (get_self_face_angle) pen_onfield=RIGHT && goalie -> reverse" );
             return AngleDeg::normalize_angle( seen_face_angle + 180.0 );
         }
     }
 
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (get_self_face_angle) normal " );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (get_self_face_angle) normal " );
 
     return ( wm.ourSide() == LEFT
              ? seen_face_angle
@@ -381,6 +382,10 @@ WorldModel::WorldModel()
       M_valid( true ),
       M_self(),
       M_ball(),
+      M_player_pool(),
+      M_teammates( M_player_pool ),
+      M_opponents( M_player_pool ),
+      M_unknown_players( M_player_pool ),
       M_our_goalie_unum( Unum_Unknown ),
       M_their_goalie_unum( Unum_Unknown ),
       M_offside_line_x( 0.0 ),
@@ -427,6 +432,15 @@ WorldModel::WorldModel()
         M_our_player_array[i] = static_cast< AbstractPlayerObject * >( 0 );
         M_their_player_array[i] = static_cast< AbstractPlayerObject * >( 0 );
     }
+
+    // the reference containers are rebuilt every cycle without reallocation
+    M_teammates_from_self.reserve( PlayerObjectPool::CAPACITY );
+    M_opponents_from_self.reserve( PlayerObjectPool::CAPACITY );
+    M_teammates_from_ball.reserve( PlayerObjectPool::CAPACITY );
+    M_opponents_from_ball.reserve( PlayerObjectPool::CAPACITY );
+    M_all_players.reserve( PlayerObjectPool::CAPACITY + 1 );
+    M_our_players.reserve( PlayerObjectPool::CAPACITY + 1 );
+    M_their_players.reserve( PlayerObjectPool::CAPACITY );
 }
 
 /*-------------------------------------------------------------------*/
@@ -534,6 +548,26 @@ WorldModel::interceptTable() const
     return M_intercept_table;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::setInterceptThreads( const int n_threads )
+{
+    M_intercept_table->setPredictionThreads( static_cast< std::size_t >( std::max( 1, n_threads ) ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+WorldModel::setInterceptIncremental( const bool on )
+{
+    M_intercept_table->setIncrementalUpdate( on );
+}
+
 /*-------------------------------------------------------------------*/
 /*!
 
@@ -614,9 +648,9 @@ WorldModel::setOurPlayerType( const int unum,
         return;
     }
 
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (setTeammatePlayerType) teammate %d to player_type %d",
-                  unum, id );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (setTeammatePlayerType) teammate %d to player_type %d",
+               unum, id );
 
     M_our_recovery[unum - 1] = 1.0;
     M_our_stamina_capacity[unum - 1] = ServerParam::i().staminaCapacity();
@@ -656,9 +690,9 @@ WorldModel::setTheirPlayerType( const int unum,
         return;
     }
 
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (setOpponentPlayerType) opponent %d to player_type %d",
-                  unum, id );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (setOpponentPlayerType) opponent %d to player_type %d",
+               unum, id );
 
     if ( M_their_player_type[unum - 1] != Hetero_Unknown
          && M_their_player_type[unum - 1] != id )
@@ -695,7 +729,7 @@ WorldModel::setCard( const SideID side,
         }
         M_our_card[unum - 1] = card;
 
-        for ( PlayerObject::List::iterator p = M_teammates.begin(), end = M_teammates.end();
+        for ( PlayerObjectPool::List::iterator p = M_teammates.begin(), end = M_teammates.end();
               p != end;
               ++p )
         {
@@ -705,15 +739,15 @@ WorldModel::setCard( const SideID side,
             }
         }
 
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (setCard) teammate %d, card %d",
-                      unum, card );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (setCard) teammate %d, card %d",
+                   unum, card );
     }
     else if ( side == theirSide() )
     {
         M_their_card[unum - 1] = card;
 
-        for ( PlayerObject::List::iterator p = M_opponents.begin(), end = M_opponents.end();
+        for ( PlayerObjectPool::List::iterator p = M_opponents.begin(), end = M_opponents.end();
               p != end;
               ++p )
         {
@@ -723,9 +757,9 @@ WorldModel::setCard( const SideID side,
             }
         }
 
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (setCard) opponent %d, card %d",
-                      unum, card );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (setCard) opponent %d, card %d",
+                   unum, card );
     }
     else
     {
@@ -833,20 +867,20 @@ WorldModel::update( const ActionEffector & act,
 #ifdef DEBUG_PRINT
     if ( M_ball.rposValid() )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
-                      " brpos=(%.2f, %.2f) bvel=(%.2f, %.2f)",
-                      M_ball.pos().x, M_ball.pos().y,
-                      M_ball.rpos().x, M_ball.rpos().y,
-                      M_ball.vel().x, M_ball.vel().y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
+                   " brpos=(%.2f, %.2f) bvel=(%.2f, %.2f)",
+                   M_ball.pos().x, M_ball.pos().y,
+                   M_ball.rpos().x, M_ball.rpos().y,
+                   M_ball.vel().x, M_ball.vel().y );
     }
     else
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
-                      " bvel=(%.2f, %.2f), invalid rpos",
-                      M_ball.pos().x, M_ball.pos().y,
-                      M_ball.vel().x, M_ball.vel().y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (update) internal update. bpos=(%.2f, %.2f)"
+                   " bvel=(%.2f, %.2f), invalid rpos",
+                   M_ball.pos().x, M_ball.pos().y,
+                   M_ball.vel().x, M_ball.vel().y );
     }
 #endif
 
@@ -949,21 +983,21 @@ WorldModel::updateAfterSenseBody( const BodySensor & sense_body,
                   << current
                   << " world.updateAfterSense: called twice"
                   << std::endl;
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSense) called twide" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterSense) called twide" );
         return;
     }
 
     M_sense_body_time = sense_body.time();
 
-    dlog.addText( Logger::WORLD,
-                  "*************** updateAfterSense ***************" );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "*************** updateAfterSense ***************" );
 
     if ( sense_body.time() == current )
     {
 #ifdef DEBUG_PRINT_SELF_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSense) update self" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterSense) update self" );
 #endif
         M_self.updateAfterSenseBody( sense_body, act, current );
         M_localize->updateBySenseBody( sense_body );
@@ -976,8 +1010,8 @@ WorldModel::updateAfterSenseBody( const BodySensor & sense_body,
 
     if ( time() != current )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSense) call internal update" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterSense) call internal update" );
         // internal update
         update( act, current );
     }
@@ -1011,15 +1045,15 @@ WorldModel::updateBallCollision()
     if ( self().hasSensedCollision() )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateBallCollision) agent has sensed collision info" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateBallCollision) agent has sensed collision info" );
 #endif
         collided_with_ball = self().collidesWithBall();
         if ( collided_with_ball )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) detected by sense_body" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateBallCollision) detected by sense_body" );
 #endif
         }
     }
@@ -1044,9 +1078,9 @@ WorldModel::updateBallCollision()
              )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) detected. ball_dist= %.3f",
-                          self_ball_dist );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateBallCollision) detected. ball_dist= %.3f",
+                       self_ball_dist );
 #endif
             collided_with_ball = true;
         }
@@ -1075,12 +1109,12 @@ WorldModel::updateBallCollision()
                                       new_ball_rpos, ball().rposCount() + 1,
                                       new_ball_vel, ball().velCount() + 1 );
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) new bpos(%.2f %.2f) rpos(%.2f %.2f)"
-                          " vel(%.2f %.2f)",
-                          new_ball_pos.x, new_ball_pos.y,
-                          new_ball_rpos.x, new_ball_rpos.y,
-                          new_ball_vel.x, new_ball_vel.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateBallCollision) new bpos(%.2f %.2f) rpos(%.2f %.2f)"
+                       " vel(%.2f %.2f)",
+                       new_ball_pos.x, new_ball_pos.y,
+                       new_ball_rpos.x, new_ball_rpos.y,
+                       new_ball_vel.x, new_ball_vel.y );
 #endif
             if ( self().posCount() > 0 )
             {
@@ -1093,10 +1127,10 @@ WorldModel::updateBallCollision()
                 M_self.updateByCollision( new_my_pos, new_my_pos_error );
 
 #ifdef DEBUG_PRINT_SELF_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateBallCollision) new mypos(%.2f %.2f) error(%.2f %.2f)",
-                              new_my_pos.x, new_my_pos.y,
-                              new_my_pos_error.x, new_my_pos_error.y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updateBallCollision) new mypos(%.2f %.2f) error(%.2f %.2f)",
+                           new_my_pos.x, new_my_pos.y,
+                           new_my_pos_error.x, new_my_pos_error.y );
 #endif
             }
         }
@@ -1110,9 +1144,9 @@ WorldModel::updateBallCollision()
                                       ball().rpos(), ball().rposCount(),
                                       ball().vel() * -0.1, vel_count );
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallCollision) seen ball. new_vel=(%.2f %.2f)",
-                          ball().vel().x, ball().vel().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateBallCollision) seen ball. new_vel=(%.2f %.2f)",
+                       ball().vel().x, ball().vel().y );
 #endif
         }
     }
@@ -1135,7 +1169,7 @@ WorldModel::updatePlayersCollision()
     // dlog.addText( Logger::WORLD,
     //               __FILE__"(updatePlayersCollision) detect collision" );
 
-    for ( PlayerObject::List::iterator p = M_teammates.begin(), end = M_teammates.end();
+    for ( PlayerObjectPool::List::iterator p = M_teammates.begin(), end = M_teammates.end();
           p != end;
           ++p )
     {
@@ -1152,7 +1186,7 @@ WorldModel::updatePlayersCollision()
         }
     }
 
-    for ( PlayerObject::List::iterator p = M_opponents.begin(), end = M_opponents.end();
+    for ( PlayerObjectPool::List::iterator p = M_opponents.begin(), end = M_opponents.end();
           p != end;
           ++p )
     {
@@ -1169,7 +1203,7 @@ WorldModel::updatePlayersCollision()
         }
     }
 
-    for ( PlayerObject::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
+    for ( PlayerObjectPool::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
           p != end;
           ++p )
     {
@@ -1197,6 +1231,8 @@ WorldModel::updateAfterSee( const VisualSensor & see,
                             const ActionEffector & act,
                             const GameTime & current )
 {
+    RCSC_PROFILE_ZONE( "WorldModel::updateAfterSee" );
+
     //////////////////////////////////////////////////////////////////
     // check internal update time
     if ( time() != current )
@@ -1222,8 +1258,8 @@ WorldModel::updateAfterSee( const VisualSensor & see,
     // time update
     M_see_time = current;
 
-    dlog.addText( Logger::WORLD,
-                  "*************** updateAfterSee *****************" );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "*************** updateAfterSee *****************" );
 
     //////////////////////////////////////////////////////////////////
     // set opponent teamname
@@ -1239,8 +1275,8 @@ WorldModel::updateAfterSee( const VisualSensor & see,
     if ( M_fullstate_time == current )
     {
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSee) already updated by fullstate" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterSee) already updated by fullstate" );
 #endif
         // stored info
         ViewArea varea( self().viewWidth().width(),
@@ -1284,12 +1320,12 @@ WorldModel::updateAfterSee( const VisualSensor & see,
                         self().face(),
                         current );
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterSee) view_area, origin=(%.2f, %.2f) angle=%.1f, width=%.1f vwidth=%d,%.2f",
-                      varea.origin().x, varea.origin().y,
-                      varea.angle().degree(), varea.viewWidth(),
-                      self().viewWidth().type(),
-                      self().viewWidth().width() );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterSee) view_area, origin=(%.2f, %.2f) angle=%.1f, width=%.1f vwidth=%d,%.2f",
+                   varea.origin().x, varea.origin().y,
+                   varea.angle().degree(), varea.viewWidth(),
+                   self().viewWidth().type(),
+                   self().viewWidth().width() );
 #endif
         // add to view area history
         M_view_area_cont.front() = varea;
@@ -1307,28 +1343,28 @@ WorldModel::updateAfterSee( const VisualSensor & see,
     //////////////////////////////////////////////////////////////////
     // debug output
 #ifdef DEBUG_PROFILE
-    dlog.addText( Logger::WORLD,
-                  __FILE__":(updaterAfterSee) elapsed %f [ms]",
-                  timer.elapsedReal() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__":(updaterAfterSee) elapsed %f [ms]",
+               timer.elapsedReal() );
 #endif
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  "<--- mypos=(%.2f, %.2f) err=(%.3f, %.3f) vel=(%.2f, %.2f)",
-                  self().pos().x, self().pos().y,
-                  self().posError().x, self().posError().y,
-                  self().vel().x, self().vel().y );
-    dlog.addText( Logger::WORLD,
-                  "<--- seen players t=%d: ut=%d: o=%d: uo=%d: u=%d",
-                  see.teammates().size(),
-                  see.unknownTeammates().size(),
-                  see.opponents().size(),
-                  see.unknownOpponents().size(),
-                  see.unknownPlayers().size() );
-    dlog.addText( Logger::WORLD,
-                  "<--- internal players t=%d: o=%d: u=%d",
-                  M_teammates.size(),
-                  M_opponents.size(),
-                  M_unknown_players.size() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "<--- mypos=(%.2f, %.2f) err=(%.3f, %.3f) vel=(%.2f, %.2f)",
+               self().pos().x, self().pos().y,
+               self().posError().x, self().posError().y,
+               self().vel().x, self().vel().y );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "<--- seen players t=%d: ut=%d: o=%d: uo=%d: u=%d",
+               see.teammates().size(),
+               see.unknownTeammates().size(),
+               see.opponents().size(),
+               see.unknownOpponents().size(),
+               see.unknownPlayers().size() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "<--- internal players t=%d: o=%d: u=%d",
+               M_teammates.size(),
+               M_opponents.size(),
+               M_unknown_players.size() );
 #endif
 }
 
@@ -1357,8 +1393,8 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
 
     M_fullstate_time = current;
 
-    dlog.addText( Logger::WORLD,
-                  "*************** updateAfterFullstate ***************" );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "*************** updateAfterFullstate ***************" );
 
     PlayerObject::reset_player_count();
     M_unknown_players.clear(); // clear unkown players
@@ -1371,19 +1407,19 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
     {
         if ( fp->unum_ < 1 || 11 < fp->unum_ )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateAfterFullstate) illegal teammate unum %d",
-                          fp->unum_ );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateAfterFullstate) illegal teammate unum %d",
+                       fp->unum_ );
             std::cerr << " (updateAfterFullstate) illegal teammate unum. " << fp->unum_
                       << std::endl;
             continue;
         }
 
         // #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
-                      fp->unum_, fp->type_,
-                      fp->card_ == YELLOW ? "yellow" : fp->card_ == RED ? "red" : "no" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
+                   fp->unum_, fp->type_,
+                   fp->card_ == YELLOW ? "yellow" : fp->card_ == RED ? "red" : "no" );
         // #endif
 
         M_our_player_type[fp->unum_ - 1] = fp->type_;
@@ -1393,8 +1429,8 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
         if ( fp->unum_ == self().unum() )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateAfterFullstate) update self" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateAfterFullstate) update self" );
 #endif
             M_self.updateAfterFullstate( *fp, act, current );
             continue;
@@ -1402,7 +1438,7 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
 
         // update teammate
         PlayerObject * player = static_cast< PlayerObject * >( 0 );
-        for ( PlayerObject::List::iterator p = M_teammates.begin(), t_end = M_teammates.end();
+        for ( PlayerObjectPool::List::iterator p = M_teammates.begin(), t_end = M_teammates.end();
               p != t_end;
               ++p )
         {
@@ -1416,13 +1452,16 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
         if ( ! player )
         {
             // create new player object
-            M_teammates.push_back( PlayerObject() );
+            if ( ! M_teammates.push_back( PlayerObject() ) )
+            {
+                continue;
+            }
             player = &(M_teammates.back());
         }
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) updated teammate %d",
-                      fp->unum_ );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterFullstate) updated teammate %d",
+                   fp->unum_ );
 #endif
         player->updateByFullstate( *fp, self().pos(), fullstate.ball().pos_ );
     }
@@ -1435,26 +1474,26 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
     {
         if ( fp->unum_ < 1 || 11 < fp->unum_ )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateAfterFullstate) illegal opponent unum %d",
-                          fp->unum_ );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateAfterFullstate) illegal opponent unum %d",
+                       fp->unum_ );
             std::cerr << " (updateAfterFullstate) illegal opponent unum. " << fp->unum_
                       << std::endl;
             continue;
         }
 
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
-                      fp->unum_, fp->type_,
-                      fp->card_ == YELLOW ? "yellow" : fp->card_ == RED ? "red" : "no" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterFullstate) teammate %d type=%d card=%s",
+                   fp->unum_, fp->type_,
+                   fp->card_ == YELLOW ? "yellow" : fp->card_ == RED ? "red" : "no" );
 #endif
 
         M_their_player_type[fp->unum_ - 1] = fp->type_;
         M_their_card[fp->unum_ - 1] = fp->card_;
 
         PlayerObject * player = static_cast< PlayerObject * >( 0 );
-        for ( PlayerObject::List::iterator p = M_opponents.begin(), o_end = M_opponents.end();
+        for ( PlayerObjectPool::List::iterator p = M_opponents.begin(), o_end = M_opponents.end();
               p != o_end;
               ++p )
         {
@@ -1467,14 +1506,17 @@ WorldModel::updateAfterFullstate( const FullstateSensor & fullstate,
 
         if ( ! player )
         {
-            M_opponents.push_back( PlayerObject() );
+            if ( ! M_opponents.push_back( PlayerObject() ) )
+            {
+                continue;
+            }
             player = &(M_opponents.back());
         }
 
 #ifdef DEBUG_PRINT
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateAfterFullstate) updated opponent %d",
-                      fp->unum_ );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateAfterFullstate) updated opponent %d",
+                   fp->unum_ );
 #endif
         player->updateByFullstate( *fp, self().pos(), fullstate.ball().pos_ );
     }
@@ -1602,7 +1644,7 @@ WorldModel::updateBallByHear( const ActionEffector & act )
           ++b )
     {
         const PlayerObject * sender = static_cast< const PlayerObject * >( 0 );
-        for ( PlayerObject::List::const_iterator t = M_teammates.begin();
+        for ( PlayerObjectPool::List::const_iterator t = M_teammates.begin();
               t != M_teammates.end();
               ++t )
         {
@@ -1616,9 +1658,9 @@ WorldModel::updateBallByHear( const ActionEffector & act )
         if ( sender )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallByHear) sender=%d exists in memory",
-                          b->sender_ );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateBallByHear) sender=%d exists in memory",
+                       b->sender_ );
 #endif
             double d2 = sender->pos().dist2( ball().pos() );
             if ( d2 < min_dist2 )
@@ -1634,9 +1676,9 @@ WorldModel::updateBallByHear( const ActionEffector & act )
         else if ( min_dist2 > 100000.0 )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateBallByHear) sender=%d, unknown",
-                          b->sender_ );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateBallByHear) sender=%d, unknown",
+                       b->sender_ );
 #endif
             min_dist2 = 100000.0;
             heard_pos = b->pos_;
@@ -1685,7 +1727,7 @@ WorldModel::updateGoalieByHear()
 
     PlayerObject * goalie = static_cast< PlayerObject * >( 0 );
 
-    for( PlayerObject::List::iterator it = M_opponents.begin(),
+    for( PlayerObjectPool::List::iterator it = M_opponents.begin(),
              end = M_opponents.end();
          it != end;
          ++it )
@@ -1703,8 +1745,8 @@ WorldModel::updateGoalieByHear()
     {
         // goalie is seen at the current time.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateGoalieByHear) but already seen" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateGoalieByHear) but already seen" );
 #endif
         return;
     }
@@ -1726,10 +1768,10 @@ WorldModel::updateGoalieByHear()
     heard_body /= static_cast< double >( M_audio_memory->goalie().size() );
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateGoalieByHear) pos=(%.1f %.1f) body=%.1f",
-                  heard_pos.x, heard_pos.y,
-                  heard_body );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateGoalieByHear) pos=(%.1f %.1f) body=%.1f",
+               heard_pos.x, heard_pos.y,
+               heard_body );
 #endif
 
     if ( goalie )
@@ -1750,7 +1792,7 @@ WorldModel::updateGoalieByHear()
 
     double min_dist = 1000.0;
 
-    for( PlayerObject::List::iterator it = M_opponents.begin(), end = M_opponents.end();
+    for( PlayerObjectPool::List::iterator it = M_opponents.begin(), end = M_opponents.end();
          it != end;
          ++it )
     {
@@ -1772,7 +1814,7 @@ WorldModel::updateGoalieByHear()
         }
     }
 
-    for ( PlayerObject::List::iterator it = M_unknown_players.begin(),
+    for ( PlayerObjectPool::List::iterator it = M_unknown_players.begin(),
               u_end = M_unknown_players.begin();
           it != u_end;
           ++it )
@@ -1798,10 +1840,10 @@ WorldModel::updateGoalieByHear()
     {
         // found a candidate unknown player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateGoalieByHear) found."
-                      " heard_pos=(%.1f %.1f)",
-                      heard_pos.x, heard_pos.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateGoalieByHear) found."
+                   " heard_pos=(%.1f %.1f)",
+                   heard_pos.x, heard_pos.y );
 #endif
         goalie->updateByHear( theirSide(),
                               theirGoalieUnum(),
@@ -1813,12 +1855,15 @@ WorldModel::updateGoalieByHear()
     {
         // register new object
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateGoalieByHear) not found."
-                      " add new goalie. heard_pos=(%.1f %.1f)",
-                      heard_pos.x, heard_pos.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateGoalieByHear) not found."
+                   " add new goalie. heard_pos=(%.1f %.1f)",
+                   heard_pos.x, heard_pos.y );
 #endif
-        M_opponents.push_back( PlayerObject() );
+        if ( ! M_opponents.push_back( PlayerObject() ) )
+        {
+            return;
+        }
         goalie = &(M_opponents.back());
         goalie->updateByHear( theirSide(),
                               theirGoalieUnum(),
@@ -1873,10 +1918,10 @@ WorldModel::updatePlayerByHear()
                       << " heard_unum=" << heard_player->unum_
                       << " pos=" << heard_player->pos_
                       << std::endl;
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear). Illegal unum %d"
-                          " pos=(%.1f %.1f)",
-                          unum, heard_player->pos_.x, heard_player->pos_.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updatePlayerByHear). Illegal unum %d"
+                       " pos=(%.1f %.1f)",
+                       unum, heard_player->pos_.x, heard_player->pos_.y );
             continue;
         }
 
@@ -1884,18 +1929,18 @@ WorldModel::updatePlayerByHear()
              && unum == self().unum() )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear) heard myself. skip" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updatePlayerByHear) heard myself. skip" );
 #endif
             continue;
         }
 
         PlayerObject * player = static_cast< PlayerObject * >( 0 );
 
-        PlayerObject::List & players = ( side == ourSide()
-                                         ? M_teammates
-                                         : M_opponents );
-        for ( PlayerObject::List::iterator p = players.begin(), end = players.end();
+        PlayerObjectPool::List & players = ( side == ourSide()
+                                             ? M_teammates
+                                             : M_opponents );
+        for ( PlayerObjectPool::List::iterator p = players.begin(), end = players.end();
               p != end;
               ++p )
         {
@@ -1903,21 +1948,21 @@ WorldModel::updatePlayerByHear()
             {
                 player = &(*p);
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updatePlayerByHear) found."
-                              " side %s, unum %d",
-                              side_str( side ), unum );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updatePlayerByHear) found."
+                           " side %s, unum %d",
+                           side_str( side ), unum );
 #endif
                 break;
             }
         }
 
-        PlayerObject::List::iterator unknown = M_unknown_players.end();
+        PlayerObjectPool::List::iterator unknown = M_unknown_players.end();
         double min_dist = 0.0;
         if ( ! player )
         {
             min_dist = 1000.0;
-            for  ( PlayerObject::List::iterator p = players.begin(), end = players.end();
+            for  ( PlayerObjectPool::List::iterator p = players.begin(), end = players.end();
                    p != end;
                    ++p )
             {
@@ -1936,7 +1981,7 @@ WorldModel::updatePlayerByHear()
                 }
             }
 
-            for ( PlayerObject::List::iterator p = M_unknown_players.begin(),
+            for ( PlayerObjectPool::List::iterator p = M_unknown_players.begin(),
                       u_end = M_unknown_players.end();
                   p != u_end;
                   ++p )
@@ -1955,16 +2000,16 @@ WorldModel::updatePlayerByHear()
         if ( player )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear) exist candidate."
-                          " heard_pos(%.1f %.1f) body=%.1f stamina=%.1f,  memory pos(%.1f %.1f) count %d  dist=%.2f",
-                          heard_player->pos_.x,
-                          heard_player->pos_.y,
-                          heard_player->body_,
-                          heard_player->stamina_,
-                          player->pos().x, player->pos().y,
-                          player->posCount(),
-                          min_dist );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updatePlayerByHear) exist candidate."
+                       " heard_pos(%.1f %.1f) body=%.1f stamina=%.1f,  memory pos(%.1f %.1f) count %d  dist=%.2f",
+                       heard_player->pos_.x,
+                       heard_player->pos_.y,
+                       heard_player->body_,
+                       heard_player->stamina_,
+                       player->pos().x, player->pos().y,
+                       player->posCount(),
+                       min_dist );
 #endif
             player->updateByHear( side,
                                   unum,
@@ -1975,8 +2020,8 @@ WorldModel::updatePlayerByHear()
             if ( unknown != M_unknown_players.end() )
             {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updatePlayerByHear) splice unknown player to known player list" );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updatePlayerByHear) splice unknown player to known player list" );
 #endif
                 players.splice( players.end(),
                                 M_unknown_players,
@@ -1986,24 +2031,19 @@ WorldModel::updatePlayerByHear()
         else
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updatePlayerByHear) not found."
-                          " add new player heard_pos(%.1f %.1f) body=%.1f stamina=%.1f",
-                          heard_player->pos_.x,
-                          heard_player->pos_.y,
-                          heard_player->body_,
-                          heard_player->stamina_ );
-#endif
-            if ( side == ourSide() )
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updatePlayerByHear) not found."
+                       " add new player heard_pos(%.1f %.1f) body=%.1f stamina=%.1f",
+                       heard_player->pos_.x,
+                       heard_player->pos_.y,
+                       heard_player->body_,
+                       heard_player->stamina_ );
+#endif
+            if ( ! players.push_back( PlayerObject() ) )
             {
-                M_teammates.push_back( PlayerObject() );
-                player = &( M_teammates.back() );
-            }
-            else
-            {
-                M_opponents.push_back( PlayerObject() );
-                player = &( M_opponents.back() );
+                continue;
             }
+            player = &( players.back() );
 
             player->updateByHear( side,
                                   unum,
@@ -2060,9 +2100,9 @@ WorldModel::updatePlayerStaminaByHear()
             if ( 1 <= it->sender_ && it->sender_ <= 11 )
             {
                 M_our_recovery[it->sender_ - 1] = it->rate_;
-                dlog.addText( Logger::WORLD,
-                              "(updatePlayerStaminaByHear) unum=%d recovery=%.3f",
-                              it->sender_, it->rate_ );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           "(updatePlayerStaminaByHear) unum=%d recovery=%.3f",
+                           it->sender_, it->rate_ );
             }
         }
     }
@@ -2077,9 +2117,9 @@ WorldModel::updatePlayerStaminaByHear()
             if ( 1 <= it->sender_ && it->sender_ <= 11 )
             {
                 M_our_stamina_capacity[it->sender_ - 1] = it->rate_ * ServerParam::i().staminaCapacity();
-                dlog.addText( Logger::WORLD,
-                              "(updatePlayerStaminaByHear) unum=%d capacity=%.2f (rate=%.3f)",
-                              it->sender_, M_our_stamina_capacity[it->sender_ - 1], it->rate_ );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           "(updatePlayerStaminaByHear) unum=%d capacity=%.2f (rate=%.3f)",
+                           it->sender_, M_our_stamina_capacity[it->sender_ - 1], it->rate_ );
             }
         }
     }
@@ -2087,9 +2127,9 @@ WorldModel::updatePlayerStaminaByHear()
 #if 0
     for ( int i = 0; i < 11; ++i )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__": teammate[%d] stamina capacity=%.2f",
-                      i+1, M_our_stamina_capacity[i] );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__": teammate[%d] stamina capacity=%.2f",
+                   i+1, M_our_stamina_capacity[i] );
     }
 #endif
 }
@@ -2136,8 +2176,8 @@ WorldModel::updateJustBeforeDecision( const ActionEffector & act,
          )
          && ! self().isKickable() )
     {
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateJustBeforeDecision) : exist kickable opponent. ball vel is set to 0." );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateJustBeforeDecision) : exist kickable opponent. ball vel is set to 0." );
 
         M_ball.setPlayerKickable();
     }
@@ -2220,7 +2260,7 @@ WorldModel::updatePlayer( const PlayerObject * player,
 {
     if ( side == ourSide() )
     {
-        for ( PlayerObject::List::iterator p = M_teammates.begin(), end = M_teammates.end();
+        for ( PlayerObjectPool::List::iterator p = M_teammates.begin(), end = M_teammates.end();
               p != end;
               ++p )
         {
@@ -2233,7 +2273,7 @@ WorldModel::updatePlayer( const PlayerObject * player,
     }
     else if ( side != NEUTRAL )
     {
-        for ( PlayerObject::List::iterator p = M_opponents.begin(), end = M_opponents.end();
+        for ( PlayerObjectPool::List::iterator p = M_opponents.begin(), end = M_opponents.end();
               p != end;
               ++p )
         {
@@ -2244,7 +2284,7 @@ WorldModel::updatePlayer( const PlayerObject * player,
             }
         }
 
-        for ( PlayerObject::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
+        for ( PlayerObjectPool::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
               p != end;
               ++p )
         {
@@ -2267,6 +2307,8 @@ WorldModel::localizeSelf( const VisualSensor & see,
                           const BodySensor & sense_body,
                           const GameTime & current )
 {
+    RCSC_PROFILE_ZONE( "WorldModel::localizeSelf" );
+
     const bool reverse_side = is_reverse_side( *this, *M_penalty_kick_state );
 
     double angle_face = -360.0;
@@ -2311,12 +2353,12 @@ WorldModel::localizeSelf( const VisualSensor & see,
     }
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (localizeSelf) reverse=%s face:(seen==%.1f use=%.1f) pos=(%f %f)",
-                  ( reverse_side ? "on" : "off" ),
-                  angle_face,
-                  team_angle_face,
-                  my_pos.x, my_pos.y );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (localizeSelf) reverse=%s face:(seen==%.1f use=%.1f) pos=(%f %f)",
+               ( reverse_side ? "on" : "off" ),
+               angle_face,
+               team_angle_face,
+               my_pos.x, my_pos.y );
 #endif
 #if 0
     Vector2D my_pos_new = Vector2D::INVALIDATED;
@@ -2332,10 +2374,10 @@ WorldModel::localizeSelf( const VisualSensor & see,
     if ( my_pos.isValid() )
     {
 #ifdef DEBUG_PRINT_SELF_UPDATE
-        dlog.addRect( Logger::WORLD,
-                      my_pos.x - my_pos_error.x, my_pos.y - my_pos_error.y,
-                      my_pos_error.x * 2.0, my_pos_error.y * 2.0,
-                      "#ff0000" );
+        RCSC_DLOG( Logger::WORLD, addRect,
+                   my_pos.x - my_pos_error.x, my_pos.y - my_pos_error.y,
+                   my_pos_error.x * 2.0, my_pos_error.y * 2.0,
+                   "#ff0000" );
 #endif
         M_self.updatePosBySee( my_pos, my_pos_error,
                                team_angle_face, std::min( angle_face_error, 180.0 ),
@@ -2375,8 +2417,8 @@ WorldModel::localizeBall( const VisualSensor & see,
                                              &rvel, &vel_error )  )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) localization failed" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizeBall) localization failed" );
 #endif
         return;
     }
@@ -2384,8 +2426,8 @@ WorldModel::localizeBall( const VisualSensor & see,
     if ( ! rpos.isValid() )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) invalid rpos. cannot calc current seen pos" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizeBall) invalid rpos. cannot calc current seen pos" );
 #endif
         return;
     }
@@ -2408,9 +2450,9 @@ WorldModel::localizeBall( const VisualSensor & see,
             M_ball.updateOnlyVel( tvel, tvel_err, 1 );
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) only vel (%.3f %.3f)",
-                          tvel.x, tvel.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (localizeBall) only vel (%.3f %.3f)",
+                       tvel.x, tvel.y );
 #endif
         }
 
@@ -2418,9 +2460,9 @@ WorldModel::localizeBall( const VisualSensor & see,
         M_ball.updateOnlyRelativePos( rpos, rpos_error );
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) only relative pos (%.3f %.3f)",
-                      rpos.x, rpos.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizeBall) only relative pos (%.3f %.3f)",
+                   rpos.x, rpos.y );
 #endif
         return;
     }
@@ -2435,10 +2477,10 @@ WorldModel::localizeBall( const VisualSensor & see,
 
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-    dlog.addRect( Logger::WORLD,
-                  pos.x - rpos_error.x, pos.y - rpos_error.y,
-                  rpos_error.x * 2.0, rpos_error.y * 2.0,
-                  "#ff0000" );
+    RCSC_DLOG( Logger::WORLD, addRect,
+               pos.x - rpos_error.x, pos.y - rpos_error.y,
+               rpos_error.x * 2.0, rpos_error.y * 2.0,
+               "#ff0000" );
 #endif
 
     if ( rvel.isValid()
@@ -2469,9 +2511,9 @@ WorldModel::localizeBall( const VisualSensor & see,
             vel_error += pos_error + prevBall().posError() + prevBall().velError();
             vel_count = 2;
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) estimate velocity by position diff(1) vel(%.3f %.3f)",
-                          gvel.x, gvel.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (localizeBall) estimate velocity by position diff(1) vel(%.3f %.3f)",
+                       gvel.x, gvel.y );
 #endif
         }
 #if 1
@@ -2498,12 +2540,12 @@ WorldModel::localizeBall( const VisualSensor & see,
             vel_count = move_step;
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) estimate vel by pos diff(2) prev=(%.2f %.2f) move=(%.2f %.2f) dist=%.3f",
-                          prev_pos.x, prev_pos.y, ball_move.x, ball_move.y, ball_move.r() );
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizeBall) estimate vel by pos diff(2) vel=(%.3f %.3f) count=%d",
-                          gvel.x, gvel.y, vel_count );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (localizeBall) estimate vel by pos diff(2) prev=(%.2f %.2f) move=(%.2f %.2f) dist=%.3f",
+                       prev_pos.x, prev_pos.y, ball_move.x, ball_move.y, ball_move.r() );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (localizeBall) estimate vel by pos diff(2) vel=(%.3f %.3f) count=%d",
+                       gvel.x, gvel.y, vel_count );
 #endif
         }
 #endif
@@ -2516,9 +2558,9 @@ WorldModel::localizeBall( const VisualSensor & see,
     if ( gvel.isValid() )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) updateAll. p(%.3f %.3f) rel(%.3f %.3f) v(%.3f %.3f)",
-                      pos.x, pos.y, rpos.x, rpos.y, gvel.x, gvel.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizeBall) updateAll. p(%.3f %.3f) rel(%.3f %.3f) v(%.3f %.3f)",
+                   pos.x, pos.y, rpos.x, rpos.y, gvel.x, gvel.y );
 #endif
         M_ball.updateAll( pos, pos_error, self().posCount(),
                           rpos, rpos_error,
@@ -2527,22 +2569,22 @@ WorldModel::localizeBall( const VisualSensor & see,
     else
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizeBall) updatePos. p(%.3f %.3f) rel(%.3f %.3f)",
-                      pos.x, pos.y, rpos.x, rpos.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizeBall) updatePos. p(%.3f %.3f) rel(%.3f %.3f)",
+                   pos.x, pos.y, rpos.x, rpos.y );
 #endif
         M_ball.updatePos( pos, pos_error, self().posCount(),
                           rpos, rpos_error );
     }
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-    dlog.addText( Logger::WORLD,
-                  "<--- ball pos=(%.2f, %.2f) err=(%.3f, %.3f)"
-                  " rpos=(%.2f, %.2f) rpos_err=(%.3f, %.3f)",
-                  ball().pos().x, ball().pos().y,
-                  ball().posError().x, ball().posError().y,
-                  ball().rpos().x, ball().rpos().y,
-                  ball().rposError().x, ball().rposError().y );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "<--- ball pos=(%.2f, %.2f) err=(%.3f, %.3f)"
+               " rpos=(%.2f, %.2f) rpos_err=(%.3f, %.3f)",
+               ball().pos().x, ball().pos().y,
+               ball().posError().x, ball().posError().y,
+               ball().rpos().x, ball().rpos().y,
+               ball().rposError().x, ball().rposError().y );
 #endif
 }
 
@@ -2568,8 +2610,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
              || self().collidesWithPost() )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff) canceled by collision.." );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (estimateBallVelByPosDiff) canceled by collision.." );
 #endif
             return;
         }
@@ -2578,8 +2620,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
     if ( ball().rposCount() == 1 ) // player saw the ball at prev cycle, too.
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (estimateBallVelByPosDiff) update by rpos diff(1)." );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (estimateBallVelByPosDiff) update by rpos diff(1)." );
 #endif
 
         if ( see.balls().front().dist_ < 3.15 // ServerParam::i().visibleDistance()
@@ -2594,24 +2636,24 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
             tmp_vel_error *= ServerParam::i().ballDecay();
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "________ rpos(%.3f %.3f) prev_rpos(%.3f %.3f)",
-                          rpos.x, rpos.y,
-                          prevBall().rpos().x, prevBall().rpos().y );
-            dlog.addText( Logger::WORLD,
-                          "________ diff(%.3f %.3f) my_move(%.3f %.3f) -> vel(%.2f, %2f)",
-                          rpos_diff.x, rpos_diff.y,
-                          self().lastMove().x, self().lastMove().y,
-                          tmp_vel.x, tmp_vel.y );
-
-            dlog.addText( Logger::WORLD,
-                          "________ internal ball_vel(%.3f %.3f) polar(%.5f %.2f) ",
-                          ball().vel().x, ball().vel().y,
-                          ball().vel().r(), ball().vel().th().degree() );
-            dlog.addText( Logger::WORLD,
-                          "________ estimated ball_vel(%.3f %.3f) vel_error(%.5f %.2f) ",
-                          tmp_vel.x, tmp_vel.y,
-                          tmp_vel_error.x, tmp_vel_error.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "________ rpos(%.3f %.3f) prev_rpos(%.3f %.3f)",
+                       rpos.x, rpos.y,
+                       prevBall().rpos().x, prevBall().rpos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "________ diff(%.3f %.3f) my_move(%.3f %.3f) -> vel(%.2f, %2f)",
+                       rpos_diff.x, rpos_diff.y,
+                       self().lastMove().x, self().lastMove().y,
+                       tmp_vel.x, tmp_vel.y );
+
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "________ internal ball_vel(%.3f %.3f) polar(%.5f %.2f) ",
+                       ball().vel().x, ball().vel().y,
+                       ball().vel().r(), ball().vel().th().degree() );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "________ estimated ball_vel(%.3f %.3f) vel_error(%.5f %.2f) ",
+                       tmp_vel.x, tmp_vel.y,
+                       tmp_vel_error.x, tmp_vel_error.y );
 
 #endif
             if ( ball().seenVelCount() <= 2
@@ -2625,15 +2667,15 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
                  )
             {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff) cancel" );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (estimateBallVelByPosDiff) cancel" );
 #endif
                 return;
             }
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff) update" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (estimateBallVelByPosDiff) update" );
 #endif
             vel = tmp_vel;
             vel_error = tmp_vel_error;
@@ -2643,8 +2685,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
     else if ( ball().rposCount() == 2 )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (estimateBallVelByPosDiff) update by rpos diff(2)." );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (estimateBallVelByPosDiff) update by rpos diff(2)." );
 #endif
 
         if ( see.balls().front().dist_ < 3.15
@@ -2665,11 +2707,11 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
             double estimate_speed = ball().vel().r();
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff)"
-                          " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
-                          vel.x, vel.y, vel_r,
-                          ball().vel().x, ball().vel().y, estimate_speed );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (estimateBallVelByPosDiff)"
+                       " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
+                       vel.x, vel.y, vel_r,
+                       ball().vel().x, ball().vel().y, estimate_speed );
 #endif
 
             if ( vel_r > estimate_speed + 0.1
@@ -2677,9 +2719,9 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
                  || ( vel - ball().vel() ).r() > estimate_speed * ServerParam::i().ballRand() * 2.0 + 0.1 )
             {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff)"
-                              " failed to update ball vel using pos diff(2) " );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (estimateBallVelByPosDiff)"
+                           " failed to update ball vel using pos diff(2) " );
 #endif
                 vel.invalidate();
             }
@@ -2690,19 +2732,19 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
                 vel_count = 2;
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff)"
-                              " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)",
-                              rpos.x, rpos.y,
-                              ball().seenRPos().x, ball().seenRPos().y );
-                dlog.addText( Logger::WORLD,
-                              "____ ball_move(%.2f %.2f) my_move0(%.2f %.2f) my_move1(%.2f %.2f)",
-                              ball_move.x, ball_move.y,
-                              self().lastMove( 0 ).x, self().lastMove( 0 ).y,
-                              self().lastMove( 1 ).x, self().lastMove( 1 ).y );
-                dlog.addText( Logger::WORLD,
-                              "---> vel(%.2f, %2f)",
-                              vel.x, vel.y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (estimateBallVelByPosDiff)"
+                           " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)",
+                           rpos.x, rpos.y,
+                           ball().seenRPos().x, ball().seenRPos().y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           "____ ball_move(%.2f %.2f) my_move0(%.2f %.2f) my_move1(%.2f %.2f)",
+                           ball_move.x, ball_move.y,
+                           self().lastMove( 0 ).x, self().lastMove( 0 ).y,
+                           self().lastMove( 1 ).x, self().lastMove( 1 ).y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           "---> vel(%.2f, %2f)",
+                           vel.x, vel.y );
 #endif
             }
 
@@ -2711,8 +2753,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
     else if ( ball().rposCount() == 3 )
     {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (estimateBallVelByPosDiff) vel update by rpos diff(3) " );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (estimateBallVelByPosDiff) vel update by rpos diff(3) " );
 #endif
         if ( see.balls().front().dist_ < 3.15
              && act.lastBodyCommandType( 0 ) != PlayerCommand::KICK
@@ -2736,19 +2778,19 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
             double estimate_speed = ball().vel().r();
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateBallVelByPosDiff)"
-                          " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
-                          vel.x, vel.y, vel_r,
-                          ball().vel().x, ball().vel().y, estimate_speed );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (estimateBallVelByPosDiff)"
+                       " diff_vel=(%.2f %.2f)%.3f   estimate_vel=(%.2f %.2f)%.3f",
+                       vel.x, vel.y, vel_r,
+                       ball().vel().x, ball().vel().y, estimate_speed );
 #endif
 
             if ( vel_r > estimate_speed + 0.1
                  || vel_r < estimate_speed * ( 1.0 - ServerParam::i().ballRand() * 3.0 ) - 0.1
                  || ( vel - ball().vel() ).r() > estimate_speed * ServerParam::i().ballRand() * 3.0 + 0.1 )
             {
-                dlog.addText( Logger::WORLD,
-                              "world.localizeBall: .failed to update ball vel using pos diff(2) " );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           "world.localizeBall: .failed to update ball vel using pos diff(2) " );
                 vel.invalidate();
             }
             else
@@ -2758,19 +2800,19 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
                 vel_count = 3;
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (estimateBallVelByPosDiff)"
-                              " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)"
-                              " ball_move(%.2f %.2f)"
-                              " my_move0(%.2f %.2f) my_move1(%.2f %.2f) my_move2(%.2f %.2f)"
-                              " -> vel(%.2f, %2f)",
-                              rpos.x, rpos.y,
-                              ball().seenRPos().x, ball().seenRPos().y,
-                              ball_move.x, ball_move.y,
-                              self().lastMove( 0 ).x, self().lastMove( 0 ).y,
-                              self().lastMove( 1 ).x, self().lastMove( 1 ).y,
-                              self().lastMove( 2 ).x, self().lastMove( 2 ).y,
-                              vel.x, vel.y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (estimateBallVelByPosDiff)"
+                           " cur_rpos(%.2f %.2f) prev_rpos(%.2f %.2f)"
+                           " ball_move(%.2f %.2f)"
+                           " my_move0(%.2f %.2f) my_move1(%.2f %.2f) my_move2(%.2f %.2f)"
+                           " -> vel(%.2f, %2f)",
+                           rpos.x, rpos.y,
+                           ball().seenRPos().x, ball().seenRPos().y,
+                           ball_move.x, ball_move.y,
+                           self().lastMove( 0 ).x, self().lastMove( 0 ).y,
+                           self().lastMove( 1 ).x, self().lastMove( 1 ).y,
+                           self().lastMove( 2 ).x, self().lastMove( 2 ).y,
+                           vel.x, vel.y );
 #endif
             }
         }
@@ -2784,6 +2826,8 @@ WorldModel::estimateBallVelByPosDiff( const VisualSensor & see,
 void
 WorldModel::localizePlayers( const VisualSensor & see )
 {
+    RCSC_PROFILE_ZONE( "WorldModel::localizePlayers" );
+
 #if 0
     PlayerObjectUpdater updater;
     if ( ! updater.localizePlayers( M_self, see, M_localize,
@@ -2808,9 +2852,9 @@ WorldModel::localizePlayers( const VisualSensor & see )
     //   after loop, copy from temporary to memory again
 
     // temporary data list
-    PlayerObject::List new_teammates;
-    PlayerObject::List new_opponents;
-    PlayerObject::List new_unknown_players;
+    PlayerObjectPool::List new_teammates( M_player_pool );
+    PlayerObjectPool::List new_opponents( M_player_pool );
+    PlayerObjectPool::List new_unknown_players( M_player_pool );
 
     const Vector2D MYPOS = self().pos();
     const Vector2D MYVEL = self().vel();
@@ -2832,34 +2876,34 @@ WorldModel::localizePlayers( const VisualSensor & see )
     // localize, matching and splice from memory list to temporary list
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__" ========== (localizePlayers) ==========" );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" ========== (localizePlayers) ==========" );
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-    dlog.addText( Logger::WORLD,
-                  "<<<<< old players start" );
-    for ( PlayerObject::List::const_iterator p = M_teammates.begin();
+    RCSC_DLOG( Logger::WORLD, addText,
+               "<<<<< old players start" );
+    for ( PlayerObjectPool::List::const_iterator p = M_teammates.begin();
           p != M_teammates.end();
           ++p )
     {
-        dlog.addText( Logger::WORLD,
-                      "teammate %d (%.2f %.2f)", p->unum(), p->pos().x, p->pos().y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "teammate %d (%.2f %.2f)", p->unum(), p->pos().x, p->pos().y );
     }
-    for ( PlayerObject::List::const_iterator p = M_opponents.begin();
+    for ( PlayerObjectPool::List::const_iterator p = M_opponents.begin();
           p != M_opponents.end();
           ++p )
     {
-        dlog.addText( Logger::WORLD,
-                      "opponent %d (%.2f %.2f)", p->unum(), p->pos().x, p->pos().y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "opponent %d (%.2f %.2f)", p->unum(), p->pos().x, p->pos().y );
     }
-    for ( PlayerObject::List::const_iterator p = M_unknown_players.begin();
+    for ( PlayerObjectPool::List::const_iterator p = M_unknown_players.begin();
           p != M_unknown_players.end();
           ++p )
     {
-        dlog.addText( Logger::WORLD,
-                      "unknown %d (%.2f %.2f)", p->unum(), p->pos().x, p->pos().y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "unknown %d (%.2f %.2f)", p->unum(), p->pos().x, p->pos().y );
     }
-    dlog.addText( Logger::WORLD,
-                  "<<<<< old players end" );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "<<<<< old players end" );
 #endif
 #endif
 
@@ -2877,20 +2921,20 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "(localizePlayers) failed opponent %d",
-                          player.unum_ );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(localizePlayers) failed opponent %d",
+                       player.unum_ );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " opponent %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      player.vel_.x, player.vel_.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(localizePlayers)"
+                   " opponent %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
+                   player.unum_,
+                   player.pos_.x, player.pos_.y,
+                   player.vel_.x, player.vel_.y );
 #endif
         // matching, splice or create
         checkTeamPlayer( theirSide(),
@@ -2914,17 +2958,17 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "(localizePlayers) failed unknown opponent" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(localizePlayers) failed unknown opponent" );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " unknown opponent pos=(%.2f, %.2f)",
-                      player.pos_.x, player.pos_.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(localizePlayers)"
+                   " unknown opponent pos=(%.2f, %.2f)",
+                   player.pos_.x, player.pos_.y );
 #endif
         // matching, splice or create
         checkTeamPlayer( theirSide(),
@@ -2948,20 +2992,20 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizePlayers) failed teammate %d",
-                          player.unum_ );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (localizePlayers) failed teammate %d",
+                       player.unum_ );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " teammate %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      player.vel_.x, player.vel_.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(localizePlayers)"
+                   " teammate %d pos=(%.2f, %.2f) vel=(%.2f, %.2f)",
+                   player.unum_,
+                   player.pos_.x, player.pos_.y,
+                   player.vel_.x, player.vel_.y );
 #endif
         // matching, splice or create
         checkTeamPlayer( ourSide(),
@@ -2985,17 +3029,17 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          "(localizePlayers) failed uunknown teammate" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(localizePlayers) failed uunknown teammate" );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " unknown teammate pos=(%.2f, %.2f)",
-                      player.pos_.x, player.pos_.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(localizePlayers)"
+                   " unknown teammate pos=(%.2f, %.2f)",
+                   player.pos_.x, player.pos_.y );
 #endif
         // matching, splice or create
         checkTeamPlayer( ourSide(),
@@ -3020,17 +3064,17 @@ WorldModel::localizePlayers( const VisualSensor & see )
                                            &player ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (localizePlayers) failed unknown player" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (localizePlayers) failed unknown player" );
 #endif
             continue;
         }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      "(localizePlayers)"
-                      " unknown player: pos=(%.2f, %.2f)",
-                      player.pos_.x, player.pos_.y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(localizePlayers)"
+                   " unknown player: pos=(%.2f, %.2f)",
+                   player.pos_.x, player.pos_.y );
 #endif
         // matching, splice or create
         checkUnknownPlayer( player,
@@ -3056,33 +3100,34 @@ WorldModel::localizePlayers( const VisualSensor & see )
     //////////////////////////////////////////////////////////////////
     // create team member pointer vector for sort
 
-    std::vector< PlayerObject * > all_teammates_ptr;
-    std::vector< PlayerObject * > all_opponents_ptr;
+    // the pointer arrays on the stack. no allocation.
+    PlayerObject * all_teammates_ptr[PlayerObjectPool::CAPACITY];
+    PlayerObject * all_opponents_ptr[PlayerObjectPool::CAPACITY];
 
-    all_teammates_ptr.reserve( M_teammates.size() );
-    for ( PlayerObject::List::iterator it = M_teammates.begin(), end = M_teammates.end();
+    int teammate_count = 0;
+    for ( PlayerObjectPool::List::iterator it = M_teammates.begin(), end = M_teammates.end();
           it != end;
           ++it )
     {
-        all_teammates_ptr.push_back( &( *it ) );
+        all_teammates_ptr[teammate_count++] = &( *it );
     }
 
-    all_opponents_ptr.reserve( M_opponents.size() );
-    for ( PlayerObject::List::iterator it = M_opponents.begin(), end = M_opponents.end();
+    int opponent_count = 0;
+    for ( PlayerObjectPool::List::iterator it = M_opponents.begin(), end = M_opponents.end();
           it != end;
           ++it )
     {
-        all_opponents_ptr.push_back( &( *it ) );
+        all_opponents_ptr[opponent_count++] = &( *it );
     }
 
 
     /////////////////////////////////////////////////////////////////
     // sort by accuracy count
-    std::sort( all_teammates_ptr.begin(),
-               all_teammates_ptr.end(),
+    std::sort( all_teammates_ptr,
+               all_teammates_ptr + teammate_count,
                PlayerPtrAccuracySorter() );
-    std::sort( all_opponents_ptr.begin(),
-               all_opponents_ptr.end(),
+    std::sort( all_opponents_ptr,
+               all_opponents_ptr + opponent_count,
                PlayerPtrAccuracySorter() );
     M_unknown_players.sort( PlayerCountSorter() );
 
@@ -3091,38 +3136,34 @@ WorldModel::localizePlayers( const VisualSensor & see )
     // if overflow is detected, player is removed based on confidence value
 
     // remove from teammates
-    int teammate_count = all_teammates_ptr.size();
     while ( teammate_count > 11 - 1 )
     {
         // reset least confidence value player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizePlayers)"
-                      " erase overflow teammate, %d pos=(%.2f, %.2f)",
-                      all_teammates_ptr.back()->unum(),
-                      all_teammates_ptr.back()->pos().x,
-                      all_teammates_ptr.back()->pos().y );
-#endif
-        all_teammates_ptr.back()->forget();
-        all_teammates_ptr.pop_back();
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizePlayers)"
+                   " erase overflow teammate, %d pos=(%.2f, %.2f)",
+                   all_teammates_ptr[teammate_count - 1]->unum(),
+                   all_teammates_ptr[teammate_count - 1]->pos().x,
+                   all_teammates_ptr[teammate_count - 1]->pos().y );
+#endif
+        all_teammates_ptr[teammate_count - 1]->forget();
         --teammate_count;
     }
 
     // remove from not-teammates
-    int opponent_count = all_opponents_ptr.size();
     while ( opponent_count > 11 )
     {
         // reset least confidence value player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizePlayers)"
-                      " erase overflow opponent, %d pos=(%.2f, %.2f)",
-                      all_opponents_ptr.back()->unum(),
-                      all_opponents_ptr.back()->pos().x,
-                      all_opponents_ptr.back()->pos().y );
-#endif
-        all_opponents_ptr.back()->forget();
-        all_opponents_ptr.pop_back();
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizePlayers)"
+                   " erase overflow opponent, %d pos=(%.2f, %.2f)",
+                   all_opponents_ptr[opponent_count - 1]->unum(),
+                   all_opponents_ptr[opponent_count - 1]->pos().x,
+                   all_opponents_ptr[opponent_count - 1]->pos().y );
+#endif
+        all_opponents_ptr[opponent_count - 1]->forget();
         --opponent_count;
     }
 
@@ -3133,11 +3174,11 @@ WorldModel::localizePlayers( const VisualSensor & see )
             && total_count > 25 ) //11 * 2 - 1 )
     {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (localizePlayers)"
-                      " erase over flow unknown player, pos=(%.2f, %.2f)",
-                      M_unknown_players.back().pos().x,
-                      M_unknown_players.back().pos().y );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (localizePlayers)"
+                   " erase over flow unknown player, pos=(%.2f, %.2f)",
+                   M_unknown_players.back().pos().x,
+                   M_unknown_players.back().pos().y );
 #endif
         if ( M_unknown_players.back().posCount() == 0 )
         {
@@ -3176,9 +3217,9 @@ WorldModel::localizePlayers( const VisualSensor & see )
 void
 WorldModel::checkTeamPlayer( const SideID side,
                              const Localization::PlayerT & player,
-                             PlayerObject::List & old_known_players,
-                             PlayerObject::List & old_unknown_players,
-                             PlayerObject::List & new_known_players )
+                             PlayerObjectPool::List & old_known_players,
+                             PlayerObjectPool::List & old_unknown_players,
+                             PlayerObjectPool::List & new_known_players )
 {
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! //
     //  if matched player is found, that player is removed from old list
@@ -3191,7 +3232,7 @@ WorldModel::checkTeamPlayer( const SideID side,
     if ( player.unum_ != Unum_Unknown )
     {
         // search from old unum known players
-        for ( PlayerObject::List::iterator it = old_known_players.begin(),
+        for ( PlayerObjectPool::List::iterator it = old_known_players.begin(),
                   end = old_known_players.end();
               it != end;
               ++it )
@@ -3199,11 +3240,11 @@ WorldModel::checkTeamPlayer( const SideID side,
             if ( it->unum() == player.unum_ )
             {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              "(checkTeamPlayer)"
-                              " >>> matched!"
-                              " unum = %d pos =(%.1f %.1f)",
-                              player.unum_, player.pos_.x, player.pos_.y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           "(checkTeamPlayer)"
+                           " >>> matched!"
+                           " unum = %d pos =(%.1f %.1f)",
+                           player.unum_, player.pos_.x, player.pos_.y );
 #endif
                 it->updateBySee( side, player );
                 new_known_players.splice( new_known_players.end(),
@@ -3223,12 +3264,12 @@ WorldModel::checkTeamPlayer( const SideID side,
     double min_team_dist = 10.0 * 10.0;
     double min_unknown_dist = 10.0 * 10.0;
 
-    PlayerObject::List::iterator candidate_team = old_known_players.end();
-    PlayerObject::List::iterator candidate_unknown = old_unknown_players.end();
+    PlayerObjectPool::List::iterator candidate_team = old_known_players.end();
+    PlayerObjectPool::List::iterator candidate_unknown = old_unknown_players.end();
 
     //////////////////////////////////////////////////////////////////
     // search from old same team players
-    for ( PlayerObject::List::iterator it = old_known_players.begin(),
+    for ( PlayerObjectPool::List::iterator it = old_known_players.begin(),
               end = old_known_players.end();
           it != end;
           ++it )
@@ -3240,11 +3281,11 @@ WorldModel::checkTeamPlayer( const SideID side,
             // unum is seen
             // and it does not match with old player's unum.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (checkTeamPlayer)"
-                          "___ known player: unum is not match."
-                          " seen unum = %d, old_unum = %d",
-                          player.unum_, it->unum() );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (checkTeamPlayer)"
+                       "___ known player: unum is not match."
+                       " seen unum = %d, old_unum = %d",
+                       player.unum_, it->unum() );
 #endif
             continue;
         }
@@ -3268,18 +3309,18 @@ WorldModel::checkTeamPlayer( const SideID side,
         {
             // TODO: inertia movement should be considered.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "___ known player: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          it->pos().x, it->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkTeamPlayer)"
+                       "___ known player: dist over."
+                       " dist=%.2f > buf=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                       + heard_error
+                       + self_error
+                       + player.dist_error_ * 2.0,
+                       player.pos_.x, player.pos_.y,
+                       it->pos().x, it->pos().y );
 #endif
             continue;
         }
@@ -3287,15 +3328,15 @@ WorldModel::checkTeamPlayer( const SideID side,
         if ( d < min_team_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "___ known player: update."
-                          " dist=%.2f < min_team_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_team_dist,
-                          player.pos_.x, player.pos_.y,
-                          it->pos().x, it->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkTeamPlayer)"
+                       "___ known player: update."
+                       " dist=%.2f < min_team_dist=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       min_team_dist,
+                       player.pos_.x, player.pos_.y,
+                       it->pos().x, it->pos().y );
 #endif
             min_team_dist = d;
             candidate_team = it;
@@ -3304,7 +3345,7 @@ WorldModel::checkTeamPlayer( const SideID side,
 
     //////////////////////////////////////////////////////////////////
     // search from unknown players
-    for ( PlayerObject::List::iterator it = old_unknown_players.begin(),
+    for ( PlayerObjectPool::List::iterator it = old_unknown_players.begin(),
               end = old_unknown_players.end();
           it != end;
           ++it )
@@ -3328,18 +3369,18 @@ WorldModel::checkTeamPlayer( const SideID side,
         {
             // TODO: inertia movement should be considered.
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "__ unknown player: dist over. "
-                          "dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkTeamPlayer)"
+                       "__ unknown player: dist over. "
+                       "dist=%.2f > buf=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                       + heard_error
+                       + self_error
+                       + player.dist_error_ * 2.0,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3347,23 +3388,23 @@ WorldModel::checkTeamPlayer( const SideID side,
         if ( d < min_unknown_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkTeamPlayer)"
-                          "__ unknown player: update. "
-                          " dist=%.2f < min_unknown_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_unknown_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkTeamPlayer)"
+                       "__ unknown player: update. "
+                       " dist=%.2f < min_unknown_dist=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       min_unknown_dist,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             min_unknown_dist = d;
             candidate_unknown = it;
         }
     }
 
-    PlayerObject::List::iterator candidate = old_unknown_players.end();
-    PlayerObject::List * target_list = static_cast< PlayerObject::List * >( 0 );
+    PlayerObjectPool::List::iterator candidate = old_unknown_players.end();
+    PlayerObjectPool::List * target_list = static_cast< PlayerObjectPool::List * >( 0 );
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
     double min_dist = 1000.0;
 #endif
@@ -3376,17 +3417,17 @@ WorldModel::checkTeamPlayer( const SideID side,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_team_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkTeamPlayer)"
-                      ">>> %d (%.1f %.1f)"
-                      " -> %s player %d %s (%.2f, %.2f) dist=%.2f",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      side_str( candidate->side() ),
-                      candidate->unum(),
-                      ( candidate->goalie() ? "goalie" : "field" ),
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(checkTeamPlayer)"
+                   ">>> %d (%.1f %.1f)"
+                   " -> %s player %d %s (%.2f, %.2f) dist=%.2f",
+                   player.unum_,
+                   player.pos_.x, player.pos_.y,
+                   side_str( candidate->side() ),
+                   candidate->unum(),
+                   ( candidate->goalie() ? "goalie" : "field" ),
+                   candidate->pos().x, candidate->pos().y,
+                   min_dist );
 #endif
     }
 
@@ -3398,14 +3439,14 @@ WorldModel::checkTeamPlayer( const SideID side,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_unknown_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkTeamPlayer)"
-                      ">>> %d (%.1f %.1f)"
-                      " -> unknown player (%.2f, %.2f) dist=%.2f",
-                      player.unum_,
-                      player.pos_.x, player.pos_.y,
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(checkTeamPlayer)"
+                   ">>> %d (%.1f %.1f)"
+                   " -> unknown player (%.2f, %.2f) dist=%.2f",
+                   player.unum_,
+                   player.pos_.x, player.pos_.y,
+                   candidate->pos().x, candidate->pos().y,
+                   min_dist );
 #endif
     }
 
@@ -3426,15 +3467,21 @@ WorldModel::checkTeamPlayer( const SideID side,
     //
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  "(checkTeamPlayer)"
-                  " XXX unmatch. min_dist= %.2f"
-                  " generate new known player pos=(%.2f, %.2f)",
-                  min_dist,
-                  player.pos_.x, player.pos_.y );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "(checkTeamPlayer)"
+               " XXX unmatch. min_dist= %.2f"
+               " generate new known player pos=(%.2f, %.2f)",
+               min_dist,
+               player.pos_.x, player.pos_.y );
 #endif
 
-    new_known_players.push_back( PlayerObject( side, player ) );
+    if ( ! new_known_players.push_back( PlayerObject( side, player ) ) )
+    {
+        // the pool is full. the observation is dropped in this cycle.
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(checkTeamPlayer) no free slot. dropped the seen player (%.2f, %.2f)",
+                   player.pos_.x, player.pos_.y );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -3443,12 +3490,12 @@ WorldModel::checkTeamPlayer( const SideID side,
  */
 void
 WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
-                                PlayerObject::List & old_teammates,
-                                PlayerObject::List & old_opponents,
-                                PlayerObject::List & old_unknown_players,
-                                PlayerObject::List & new_teammates,
-                                PlayerObject::List & new_opponents,
-                                PlayerObject::List & new_unknown_players )
+                                PlayerObjectPool::List & old_teammates,
+                                PlayerObjectPool::List & old_opponents,
+                                PlayerObjectPool::List & old_unknown_players,
+                                PlayerObjectPool::List & new_teammates,
+                                PlayerObjectPool::List & new_opponents,
+                                PlayerObjectPool::List & new_unknown_players )
 {
     // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! //
     //  if matched player is found, that player is removed from old list
@@ -3462,16 +3509,16 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
     double min_teammate_dist = 100.0;
     double min_unknown_dist = 100.0;
 
-    PlayerObject::List::iterator candidate_opponent = old_opponents.end();
-    PlayerObject::List::iterator candidate_teammate = old_teammates.end();
-    PlayerObject::List::iterator candidate_unknown = old_unknown_players.end();
+    PlayerObjectPool::List::iterator candidate_opponent = old_opponents.end();
+    PlayerObjectPool::List::iterator candidate_teammate = old_teammates.end();
+    PlayerObjectPool::List::iterator candidate_unknown = old_unknown_players.end();
 
     const double dash_noise = 1.0 + ServerParam::i().playerRand();
     const double self_error = 0.5 * 2.0;
 
     //////////////////////////////////////////////////////////////////
     // search from old opponents
-    for ( PlayerObject::List::iterator it = old_opponents.begin(),
+    for ( PlayerObjectPool::List::iterator it = old_opponents.begin(),
               end = old_opponents.end();
           it != end;
           ++it )
@@ -3494,19 +3541,19 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
                    + player.dist_error_ * 2.0 ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ opp %d: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          it->unum(),
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkUnknownPlayer)"
+                       "__ opp %d: dist over."
+                       " dist=%.2f > buf=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       it->unum(),
+                       d,
+                       it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                       + heard_error
+                       + self_error
+                       + player.dist_error_ * 2.0,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3514,15 +3561,15 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
         if ( d < min_opponent_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ opp player: update."
-                          " dist=%.2f < min_opp_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_opponent_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkUnknownPlayer)"
+                       "__ opp player: update."
+                       " dist=%.2f < min_opp_dist=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       min_opponent_dist,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             min_opponent_dist = d;
             candidate_opponent = it;
@@ -3531,7 +3578,7 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
     //////////////////////////////////////////////////////////////////
     // search from old teammates
-    for ( PlayerObject::List::iterator it = old_teammates.begin(),
+    for ( PlayerObjectPool::List::iterator it = old_teammates.begin(),
               end = old_teammates.end();
           it != end;
           ++it )
@@ -3554,19 +3601,19 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
                    + player.dist_error_ * 2.0 ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ our %d: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          it->unum(),
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkUnknownPlayer)"
+                       "__ our %d: dist over."
+                       " dist=%.2f > buf=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       it->unum(),
+                       d,
+                       it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                       + heard_error
+                       + self_error
+                       + player.dist_error_ * 2.0,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3574,15 +3621,15 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
         if ( d < min_teammate_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ our player: update."
-                          " dist=%.2f < min_our_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_teammate_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkUnknownPlayer)"
+                       "__ our player: update."
+                       " dist=%.2f < min_our_dist=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       min_teammate_dist,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             min_teammate_dist = d;
             candidate_teammate = it;
@@ -3591,7 +3638,7 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
     //////////////////////////////////////////////////////////////////
     // search from old unknown players
-    for ( PlayerObject::List::iterator it = old_unknown_players.begin(),
+    for ( PlayerObjectPool::List::iterator it = old_unknown_players.begin(),
               end = old_unknown_players.end();
           it != end;
           ++it )
@@ -3614,18 +3661,18 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
                    + player.dist_error_ * 2.0 ) )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ unknown player: dist over."
-                          " dist=%.2f > buf=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          it->playerTypePtr()->realSpeedMax() * dash_noise * count
-                          + heard_error
-                          + self_error
-                          + player.dist_error_ * 2.0,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkUnknownPlayer)"
+                       "__ unknown player: dist over."
+                       " dist=%.2f > buf=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       it->playerTypePtr()->realSpeedMax() * dash_noise * count
+                       + heard_error
+                       + self_error
+                       + player.dist_error_ * 2.0,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             continue;
         }
@@ -3633,24 +3680,24 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
         if ( d < min_unknown_dist )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-            dlog.addText( Logger::WORLD,
-                          "(checkUnknownPlayer)"
-                          "__ unknown player: update."
-                          " dist=%.2f < min_unknown_dist=%.2f"
-                          " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
-                          d,
-                          min_unknown_dist,
-                          player.pos_.x, player.pos_.y,
-                          old_pos.x, old_pos.y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       "(checkUnknownPlayer)"
+                       "__ unknown player: update."
+                       " dist=%.2f < min_unknown_dist=%.2f"
+                       " seen_pos(%.1f %.1f) old_pos(%.1f %.1f)",
+                       d,
+                       min_unknown_dist,
+                       player.pos_.x, player.pos_.y,
+                       old_pos.x, old_pos.y );
 #endif
             min_unknown_dist = d;
             candidate_unknown = it;
         }
     }
 
-    PlayerObject::List::iterator candidate = old_unknown_players.end();;
-    PlayerObject::List * new_list = static_cast< PlayerObject::List * >( 0 );
-    PlayerObject::List * old_list = static_cast< PlayerObject::List * >( 0 );
+    PlayerObjectPool::List::iterator candidate = old_unknown_players.end();;
+    PlayerObjectPool::List * new_list = static_cast< PlayerObjectPool::List * >( 0 );
+    PlayerObjectPool::List * old_list = static_cast< PlayerObjectPool::List * >( 0 );
     SideID side = NEUTRAL;
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
     double min_dist = 1000.0;
@@ -3667,13 +3714,13 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_teammate_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkUnknownPlayer)"
-                      ">>> (%.1f %.1f) -> teammate %d (%.1f %.1f) dist=%.2f",
-                      player.pos_.x, player.pos_.y,
-                      candidate->unum(),
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(checkUnknownPlayer)"
+                   ">>> (%.1f %.1f) -> teammate %d (%.1f %.1f) dist=%.2f",
+                   player.pos_.x, player.pos_.y,
+                   candidate->unum(),
+                   candidate->pos().x, candidate->pos().y,
+                   min_dist );
 #endif
     }
 
@@ -3689,13 +3736,13 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
         min_dist = min_opponent_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkUnknownPlayer)"
-                      ">>> (%.1f %.1f) -> opponent %d (%.1f %.1f) dist=%.2f",
-                      player.pos_.x, player.pos_.y,
-                      candidate->unum(),
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(checkUnknownPlayer)"
+                   ">>> (%.1f %.1f) -> opponent %d (%.1f %.1f) dist=%.2f",
+                   player.pos_.x, player.pos_.y,
+                   candidate->unum(),
+                   candidate->pos().x, candidate->pos().y,
+                   min_dist );
 #endif
     }
 
@@ -3711,12 +3758,12 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
         min_dist = min_unknown_dist;
-        dlog.addText( Logger::WORLD,
-                      "(checkUnknownPlayer)"
-                      ">>> (%.1f %.1f) -> unknown (%.1f %.1f) dist=%.2f",
-                      player.pos_.x, player.pos_.y,
-                      candidate->pos().x, candidate->pos().y,
-                      min_dist );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(checkUnknownPlayer)"
+                   ">>> (%.1f %.1f) -> unknown (%.1f %.1f) dist=%.2f",
+                   player.pos_.x, player.pos_.y,
+                   candidate->pos().x, candidate->pos().y,
+                   min_dist );
 #endif
     }
 
@@ -3738,15 +3785,21 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
     //////////////////////////////////////////////////////////////////
     // generate new player
 #ifdef DEBUG_PRINT_PLAYER_UPDATE_DETAIL
-    dlog.addText( Logger::WORLD,
-                  "(checkUnknownPlayer)"
-                  " XXX unmatch. dist_error=%f"
-                  " generate new unknown player. pos=(%.2f, %.2f)",
-                  player.dist_error_,
-                  player.pos_.x, player.pos_.y );
+    RCSC_DLOG( Logger::WORLD, addText,
+               "(checkUnknownPlayer)"
+               " XXX unmatch. dist_error=%f"
+               " generate new unknown player. pos=(%.2f, %.2f)",
+               player.dist_error_,
+               player.pos_.x, player.pos_.y );
 #endif
 
-    new_unknown_players.push_back( PlayerObject( NEUTRAL, player ) );
+    if ( ! new_unknown_players.push_back( PlayerObject( NEUTRAL, player ) ) )
+    {
+        // the pool is full. the observation is dropped in this cycle.
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "(checkUnknownPlayer) no free slot. dropped the seen player (%.2f, %.2f)",
+                   player.pos_.x, player.pos_.y );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -3756,7 +3809,7 @@ WorldModel::checkUnknownPlayer( const Localization::PlayerT & player,
 void
 WorldModel::updatePlayerType()
 {
-    for ( PlayerObject::List::iterator it = M_teammates.begin(),
+    for ( PlayerObjectPool::List::iterator it = M_teammates.begin(),
               end = M_teammates.end();
           it != end;
           ++it )
@@ -3772,7 +3825,7 @@ WorldModel::updatePlayerType()
         }
     }
 
-    for ( PlayerObject::List::iterator it = M_opponents.begin(),
+    for ( PlayerObjectPool::List::iterator it = M_opponents.begin(),
               end = M_opponents.end();
           it != end;
           ++it )
@@ -3788,7 +3841,7 @@ WorldModel::updatePlayerType()
         }
     }
 
-    for ( PlayerObject::List::iterator it = M_unknown_players.begin(),
+    for ( PlayerObjectPool::List::iterator it = M_unknown_players.begin(),
               end = M_unknown_players.end();
           it != end;
           ++it )
@@ -3804,7 +3857,7 @@ WorldModel::updatePlayerType()
 void
 WorldModel::updatePlayerCard()
 {
-    for ( PlayerObject::List::iterator it = M_teammates.begin(),
+    for ( PlayerObjectPool::List::iterator it = M_teammates.begin(),
               end = M_teammates.end();
           it != end;
           ++it )
@@ -3816,7 +3869,7 @@ WorldModel::updatePlayerCard()
         }
     }
 
-    for ( PlayerObject::List::iterator it = M_opponents.begin(),
+    for ( PlayerObjectPool::List::iterator it = M_opponents.begin(),
               end = M_opponents.end();
           it != end;
           ++it )
@@ -3848,7 +3901,7 @@ WorldModel::estimateUnknownPlayerUnum()
         unum_set.erase( self().unum() );
 
         PlayerObject * unknown_teammate = static_cast< PlayerObject * >( 0 );
-        for ( PlayerObject::List::iterator t = M_teammates.begin(),
+        for ( PlayerObjectPool::List::iterator t = M_teammates.begin(),
                   end = M_teammates.end();
               t != end;
               ++t )
@@ -3867,11 +3920,11 @@ WorldModel::estimateUnknownPlayerUnum()
              && unknown_teammate )
         {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (estimateUnknownPlayerUnum)"
-                          " set teammate unum %d (%.1f %.1f)",
-                          *unum_set.begin(),
-                          unknown_teammate->pos().x, unknown_teammate->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (estimateUnknownPlayerUnum)"
+                       " set teammate unum %d (%.1f %.1f)",
+                       *unum_set.begin(),
+                       unknown_teammate->pos().x, unknown_teammate->pos().y );
 #endif
             int unum = *unum_set.begin();
             unknown_teammate->setTeam( ourSide(),
@@ -3890,7 +3943,7 @@ WorldModel::estimateUnknownPlayerUnum()
         }
 
         PlayerObject * unknown_opponent = static_cast< PlayerObject * >( 0 );
-        for ( PlayerObject::List::iterator o = M_opponents.begin(), end = M_opponents.end();
+        for ( PlayerObjectPool::List::iterator o = M_opponents.begin(), end = M_opponents.end();
               o != end;
               ++o )
         {
@@ -3909,11 +3962,11 @@ WorldModel::estimateUnknownPlayerUnum()
             if ( unknown_opponent )
             {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__":(estimateUnknownPlayerUnum)"
-                              " set opponent unum %d (%.1f %.1f)",
-                              *unum_set.begin(),
-                              unknown_opponent->pos().x, unknown_opponent->pos().y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__":(estimateUnknownPlayerUnum)"
+                           " set opponent unum %d (%.1f %.1f)",
+                           *unum_set.begin(),
+                           unknown_opponent->pos().x, unknown_opponent->pos().y );
 #endif
                 int unum = *unum_set.begin();
                 unknown_opponent->setTeam( theirSide(),
@@ -3995,7 +4048,7 @@ WorldModel::updatePlayerStateCache()
         M_our_players.push_back( &M_self );
         M_our_player_array[self().unum()] = &M_self;
 
-        for ( PlayerObject::List::iterator t = M_teammates.begin(), end = M_teammates.end();
+        for ( PlayerObjectPool::List::iterator t = M_teammates.begin(), end = M_teammates.end();
               t != end;
               ++t )
         {
@@ -4008,7 +4061,7 @@ WorldModel::updatePlayerStateCache()
             }
         }
 
-        for ( PlayerObject::List::iterator o = M_opponents.begin(), end = M_opponents.end();
+        for ( PlayerObjectPool::List::iterator o = M_opponents.begin(), end = M_opponents.end();
               o != end;
               ++o )
         {
@@ -4029,46 +4082,46 @@ WorldModel::updatePlayerStateCache()
     updateKickablePlayers();
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updatePlayerStateCache) player set." );
-    dlog.addText( Logger::WORLD,
-                  " teammatesFromSelf %zd", M_teammates_from_self.size() );
-    dlog.addText( Logger::WORLD,
-                  " teammatesFromBall %zd", M_teammates_from_ball.size() );
-    dlog.addText( Logger::WORLD,
-                  " opponentsFromSelf %zd", M_opponents_from_self.size() );
-    dlog.addText( Logger::WORLD,
-                  " opponentsFromBall %zd", M_opponents_from_ball.size() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updatePlayerStateCache) player set." );
+    RCSC_DLOG( Logger::WORLD, addText,
+               " teammatesFromSelf %zd", M_teammates_from_self.size() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               " teammatesFromBall %zd", M_teammates_from_ball.size() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               " opponentsFromSelf %zd", M_opponents_from_self.size() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               " opponentsFromBall %zd", M_opponents_from_ball.size() );
 
     M_teammates.sort( PlayerUnumSorter() );
-    for ( PlayerObject::List::const_iterator p = M_teammates.begin(), end = M_teammates.end();
+    for ( PlayerObjectPool::List::const_iterator p = M_teammates.begin(), end = M_teammates.end();
           p != end;
           ++p )
     {
-        dlog.addText( Logger::WORLD,
-                      "teammate id=%d unum=%d (%.1f %.1f) count=%d %s",
-                      p->id(), p->unum(), p->pos().x, p->pos().y, p->posCount(),
-                      ( p->goalie() ? "goalie" : "" ) );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "teammate id=%d unum=%d (%.1f %.1f) count=%d %s",
+                   p->id(), p->unum(), p->pos().x, p->pos().y, p->posCount(),
+                   ( p->goalie() ? "goalie" : "" ) );
     }
     M_opponents.sort( PlayerUnumSorter() );
-    for ( PlayerObject::List::const_iterator p = M_opponents.begin(), end = M_opponents.end();
+    for ( PlayerObjectPool::List::const_iterator p = M_opponents.begin(), end = M_opponents.end();
           p != end;
           ++p )
     {
-        dlog.addText( Logger::WORLD,
-                      "opponent id=%d unum=%d (%.1f %.1f) count=%d %s ",
-                      p->id(), p->unum(), p->pos().x, p->pos().y, p->posCount(),
-                      ( p->goalie() ? "goalie" : "" ) );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "opponent id=%d unum=%d (%.1f %.1f) count=%d %s ",
+                   p->id(), p->unum(), p->pos().x, p->pos().y, p->posCount(),
+                   ( p->goalie() ? "goalie" : "" ) );
     }
     //M_unknown_players.sort( PlayerCountSorter() );
-    for ( PlayerObject::List::const_iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
+    for ( PlayerObjectPool::List::const_iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
           p != end;
           ++p )
     {
-        dlog.addText( Logger::WORLD,
-                      "unknown id=%d unum=%d (%.1f %.1f) count=%d %s",
-                      p->id(), p->unum(), p->pos().x, p->pos().y, p->posCount(),
-                      ( p->goalie() ? "goalie" : "" ) );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   "unknown id=%d unum=%d (%.1f %.1f) count=%d %s",
+                   p->id(), p->unum(), p->pos().x, p->pos().y, p->posCount(),
+                   ( p->goalie() ? "goalie" : "" ) );
     }
 #endif
 }
@@ -4083,9 +4136,9 @@ WorldModel::estimateGoalie()
     const AbstractPlayerObject * our_goalie = get_our_goalie_loop( *this );
     const AbstractPlayerObject * their_goalie = get_their_goalie_loop( *this );
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-    dlog.addText( Logger::WORLD,
-                  __FILE__": (estimateGoalie) our_goalie=%d their_goalie=%d",
-                  M_our_goalie_unum, M_their_goalie_unum );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__": (estimateGoalie) our_goalie=%d their_goalie=%d",
+               M_our_goalie_unum, M_their_goalie_unum );
 #endif
     //
     // update teammate goalie's unum
@@ -4095,9 +4148,9 @@ WorldModel::estimateGoalie()
     {
         M_our_goalie_unum = our_goalie->unum();
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__": (estimateGoalie) update our_goalie=%d",
-                      M_our_goalie_unum );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__": (estimateGoalie) update our_goalie=%d",
+                   M_our_goalie_unum );
 #endif
     }
 
@@ -4109,9 +4162,9 @@ WorldModel::estimateGoalie()
     {
         M_their_goalie_unum = their_goalie->unum();
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-        dlog.addText( Logger::WORLD,
-                      __FILE__": (estimateGoalie) update their_goalie=%d",
-                      M_their_goalie_unum );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__": (estimateGoalie) update their_goalie=%d",
+                   M_their_goalie_unum );
 #endif
     }
 
@@ -4140,10 +4193,10 @@ WorldModel::estimateOurGoalie()
     if ( ! our_goalie
          && M_teammates.size() >= 9 )
     {
-        PlayerObject::List::iterator candidate = M_unknown_players.end();
+        PlayerObjectPool::List::iterator candidate = M_unknown_players.end();
         double min_x = 0.0;
         double second_min_x = 0.0;
-        for ( PlayerObject::List::iterator p = M_teammates.begin(), end = M_teammates.end();
+        for ( PlayerObjectPool::List::iterator p = M_teammates.begin(), end = M_teammates.end();
               p != end;
               ++p )
         {
@@ -4159,7 +4212,7 @@ WorldModel::estimateOurGoalie()
         }
 
         bool from_unknown = false;
-        for ( PlayerObject::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
+        for ( PlayerObjectPool::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
               p != end;
               ++p )
         {
@@ -4179,10 +4232,10 @@ WorldModel::estimateOurGoalie()
              && second_min_x > min_x + 10.0 )
         {
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__": (estimateOurGoalie) decide our goalie. %d (%.1f %.1f)",
-                          M_our_goalie_unum,
-                          candidate->pos().x, candidate->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__": (estimateOurGoalie) decide our goalie. %d (%.1f %.1f)",
+                       M_our_goalie_unum,
+                       candidate->pos().x, candidate->pos().y );
 #endif
             candidate->setTeam( ourSide(),
                                 M_our_goalie_unum,
@@ -4208,11 +4261,11 @@ WorldModel::estimateTheirGoalie()
          && M_teammates.size() >= 10
          && M_opponents_from_self.size() >= 11 )
     {
-        PlayerObject::List::iterator candidate = M_unknown_players.end();
+        PlayerObjectPool::List::iterator candidate = M_unknown_players.end();
         double max_x = 0.0;
         double second_max_x = 0.0;
 
-        for ( PlayerObject::List::iterator p = M_opponents.begin(), end = M_opponents.end();
+        for ( PlayerObjectPool::List::iterator p = M_opponents.begin(), end = M_opponents.end();
               p != end;
               ++p )
         {
@@ -4228,7 +4281,7 @@ WorldModel::estimateTheirGoalie()
         }
 
         bool from_unknown = false;
-        for ( PlayerObject::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
+        for ( PlayerObjectPool::List::iterator p = M_unknown_players.begin(), end = M_unknown_players.end();
               p != end;
               ++p )
         {
@@ -4248,10 +4301,10 @@ WorldModel::estimateTheirGoalie()
              && second_max_x < max_x - 10.0 )
         {
 #ifdef DEBUG_PRINT_GOALIE_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__": (estimateTheirGoalie) decide their goalie. %d (%.1f %.1f)",
-                          M_their_goalie_unum,
-                          candidate->pos().x, candidate->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__": (estimateTheirGoalie) decide their goalie. %d (%.1f %.1f)",
+                       M_their_goalie_unum,
+                       candidate->pos().x, candidate->pos().y );
 #endif
             candidate->setTeam( theirSide(),
                                 M_their_goalie_unum,
@@ -4286,9 +4339,9 @@ WorldModel::updateKickablePlayers()
         if ( (*p)->isKickable( 0.0 ) )
         {
             M_kickable_teammate = *p;
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateKickablePlayers) found teammate %d (%.1f %.1f)",
-                          (*p)->unum(), (*p)->pos().x, (*p)->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateKickablePlayers) found teammate %d (%.1f %.1f)",
+                       (*p)->unum(), (*p)->pos().x, (*p)->pos().y );
             break;
         }
     }
@@ -4320,9 +4373,9 @@ WorldModel::updateKickablePlayers()
             if ( (*p)->isKickable( -buf ) )
             {
                 M_maybe_kickable_opponent = *p;
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateKickablePlayers) maybe opponent %d (%.1f %.1f)",
-                              (*p)->unum(), (*p)->pos().x, (*p)->pos().y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updateKickablePlayers) maybe opponent %d (%.1f %.1f)",
+                           (*p)->unum(), (*p)->pos().x, (*p)->pos().y );
             }
         }
 
@@ -4332,9 +4385,9 @@ WorldModel::updateKickablePlayers()
         if ( (*p)->isKickable( -buf ) )
         {
             M_kickable_opponent = *p;
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateKickablePlayers) found opponent %d (%.1f %.1f)",
-                          (*p)->unum(), (*p)->pos().x, (*p)->pos().y );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateKickablePlayers) found opponent %d (%.1f %.1f)",
+                       (*p)->unum(), (*p)->pos().x, (*p)->pos().y );
             break;
         }
     }
@@ -4407,9 +4460,9 @@ WorldModel::updateOffsideLine()
         if ( new_line < heard_x - 1.0 )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateOffsideLine) by heard info. %.1f -> %.1f",
-                          new_line, heard_x );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateOffsideLine) by heard info. %.1f -> %.1f",
+                       new_line, heard_x );
 #endif
 
             new_line = heard_x;
@@ -4422,9 +4475,9 @@ WorldModel::updateOffsideLine()
     M_offside_line_count = count;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateOffsideLine) prev=%.2f x=%.2f count=%d",
-                  M_prev_offside_line_x, new_line, count );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateOffsideLine) prev=%.2f x=%.2f count=%d",
+               M_prev_offside_line_x, new_line, count );
 #endif
 }
 
@@ -4471,9 +4524,9 @@ WorldModel::updateOurOffenseLine()
     M_our_offense_line_x = new_line;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateOurOffenseLine) x=%.2f",
-                  new_line );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateOurOffenseLine) x=%.2f",
+               new_line );
 #endif
 }
 
@@ -4504,9 +4557,9 @@ WorldModel::updateOurDefenseLine()
     double new_line = second;
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateDefenseLine) base line=%.1f",
-                  new_line );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateDefenseLine) base line=%.1f",
+               new_line );
 #endif
 
 #if 0
@@ -4516,10 +4569,10 @@ WorldModel::updateOurDefenseLine()
         if ( first > ServerParam::i().ourPenaltyAreaLineX() )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateDefenseLine) goalie not found,"
-                          " assume goalie is back of defense line. %.1f -> %.1f",
-                          new_line, first );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateDefenseLine) goalie not found,"
+                       " assume goalie is back of defense line. %.1f -> %.1f",
+                       new_line, first );
 #endif
             new_line = first;
         }
@@ -4563,9 +4616,9 @@ WorldModel::updateOurDefenseLine()
         if ( heard_x + 1.0 < new_line )
         {
 #ifdef DEBUG_PRINT
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateDefenseLine) heard defense line is used. %.1f -> %.1f",
-                          new_line, heard_x );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateDefenseLine) heard defense line is used. %.1f -> %.1f",
+                       new_line, heard_x );
 #endif
 
             new_line = heard_x;
@@ -4575,9 +4628,9 @@ WorldModel::updateOurDefenseLine()
     M_our_defense_line_x = new_line;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateOurDefenseLine) %.2f",
-                  new_line );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateOurDefenseLine) %.2f",
+               new_line );
 #endif
 }
 
@@ -4620,9 +4673,9 @@ WorldModel::updateTheirOffenseLine()
     M_their_offense_line_x = new_line;
 
 #ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateTheirOffenseLine) x=%.2f",
-                  new_line );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateTheirOffenseLine) x=%.2f",
+               new_line );
 #endif
 }
 
@@ -4738,9 +4791,9 @@ WorldModel::updateTheirDefenseLine()
     M_their_defense_line_count = count;
 
     //#ifdef DEBUG_PRINT_LINES
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateTheirDefenseLine) x=%.2f count=%d",
-                  new_line, count );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateTheirDefenseLine) x=%.2f count=%d",
+               new_line, count );
     //#endif
 }
 
@@ -4792,10 +4845,10 @@ WorldModel::updatePlayerLines()
             }
         }
 #ifdef DEBUG_PRINT_LINES
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updatePlayerLines) our_offensex=%.2f our_defense=%.2f",
-                      M_our_offense_player_line_x,
-                      M_our_defense_player_line_x );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updatePlayerLines) our_offensex=%.2f our_defense=%.2f",
+                   M_our_offense_player_line_x,
+                   M_our_defense_player_line_x );
 #endif
     }
 
@@ -4838,10 +4891,10 @@ WorldModel::updatePlayerLines()
             }
         }
 #ifdef DEBUG_PRINT_LINES
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updatePlayerLines) their_offensex=%.2f their_defense=%.2f",
-                      M_their_offense_player_line_x,
-                      M_their_defense_player_line_x );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updatePlayerLines) their_offensex=%.2f their_defense=%.2f",
+                   M_their_offense_player_line_x,
+                   M_their_defense_player_line_x );
 #endif
     }
 }
@@ -4888,8 +4941,8 @@ WorldModel::updateLastKicker()
         M_last_kicker_side = ourSide();
         M_last_kicker_unum = self().unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) self kicked" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateLastKicker) self kicked" );
 #endif
         return;
     }
@@ -4897,8 +4950,8 @@ WorldModel::updateLastKicker()
     if ( ! prevBall().vel().isValid() )
     {
 #ifdef DEBUG_PRINT_LAST_KICKER
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) no previous ball data" );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateLastKicker) no previous ball data" );
 #endif
         return;
     }
@@ -4926,10 +4979,10 @@ WorldModel::updateLastKicker()
             {
                 kickers.push_back( *p );
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) see kicking side=%c unum=%d",
-                              ( (*p)->side() == LEFT ? 'L' : (*p)->side() == RIGHT ? 'R' : 'N' ),
-                              (*p)->unum() );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updateLastKicker) see kicking side=%c unum=%d",
+                           ( (*p)->side() == LEFT ? 'L' : (*p)->side() == RIGHT ? 'R' : 'N' ),
+                           (*p)->unum() );
 #endif
             }
             else if ( (*p)->tackleCount() == 0
@@ -4937,10 +4990,10 @@ WorldModel::updateLastKicker()
             {
                 kickers.push_back( *p );
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) see tackling side=%c unum=%d",
-                              ( (*p)->side() == LEFT ? 'L' : (*p)->side() == RIGHT ? 'R' : 'N' ),
-                              (*p)->unum() );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updateLastKicker) see tackling side=%c unum=%d",
+                           ( (*p)->side() == LEFT ? 'L' : (*p)->side() == RIGHT ? 'R' : 'N' ),
+                           (*p)->unum() );
 #endif
             }
         }
@@ -4962,11 +5015,11 @@ WorldModel::updateLastKicker()
     {
         ball_vel_changed = true;
 #ifdef DEBUG_PRINT_LAST_KICKER
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) ball vel changed." );
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateLastKicker) speed=%.3f prev_seed=%.3f angle_diff=%.1f",
-                      cur_speed, prev_speed, angle_diff );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateLastKicker) ball vel changed." );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateLastKicker) speed=%.3f prev_seed=%.3f angle_diff=%.1f",
+                   cur_speed, prev_speed, angle_diff );
 #endif
     }
 
@@ -4987,10 +5040,10 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = ourSide();
                     M_last_kicker_unum = kicker->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> teammate",
-                                  ( kicker->side() == LEFT ? 'L' : kicker->side() == RIGHT ? 'R' : 'N' ),
-                                  kicker->unum() );
+                    RCSC_DLOG( Logger::WORLD, addText,
+                               __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> teammate",
+                               ( kicker->side() == LEFT ? 'L' : kicker->side() == RIGHT ? 'R' : 'N' ),
+                               kicker->unum() );
 #endif
                 }
                 else
@@ -4998,10 +5051,10 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = theirSide();
                     M_last_kicker_unum = kicker->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> opponent",
-                                  kicker->side(),
-                                  kicker->unum() );
+                    RCSC_DLOG( Logger::WORLD, addText,
+                               __FILE__" (updateLastKicker) set by 1 seen kicker. side=%d unum=%d -> opponent",
+                               kicker->side(),
+                               kicker->unum() );
 #endif
                 }
                 return;
@@ -5041,9 +5094,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = NEUTRAL;
             M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen kicker(s). NEUTRAL"
-                          " kicked by teammate and opponent" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by seen kicker(s). NEUTRAL"
+                       " kicked by teammate and opponent" );
 #endif
         }
         else if ( ! exist_opponent_kicker )
@@ -5051,9 +5104,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = ourSide();
             M_last_kicker_unum = teammate_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen kicker(s). TEAMMATE"
-                          " kicked by teammate or unknown" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by seen kicker(s). TEAMMATE"
+                       " kicked by teammate or unknown" );
 #endif
         }
         else if ( ! exist_teammate_kicker )
@@ -5061,9 +5114,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = theirSide();
             M_last_kicker_unum = opponent_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen kicker(s). OPPONENT"
-                          " kicked by opponent" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by seen kicker(s). OPPONENT"
+                       " kicked by opponent" );
 #endif
         }
 
@@ -5078,9 +5131,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = ourSide();
             M_last_kicker_unum = M_previous_kickable_teammate_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by prev teammate kicker %d",
-                          M_previous_kickable_teammate_unum );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by prev teammate kicker %d",
+                       M_previous_kickable_teammate_unum );
 #endif
             return;
         }
@@ -5090,9 +5143,9 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = theirSide();
             M_last_kicker_unum = M_previous_kickable_opponent_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by prev opponent kicker %d",
-                          M_previous_kickable_opponent_unum );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by prev opponent kicker %d",
+                       M_previous_kickable_opponent_unum );
 #endif
             return;
         }
@@ -5102,8 +5155,8 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = NEUTRAL;
             M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) both side kickable in previous cycle. NEUTRAL" );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) both side kickable in previous cycle. NEUTRAL" );
 #endif
             return;
         }
@@ -5181,13 +5234,13 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = ourSide();
                     M_last_kicker_unum = nearest->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by nearest teammate or unknown."
-                                  " side=%c unum=%d",
-                                  ( nearest->side() == LEFT ? 'L'
-                                    : nearest->side() == RIGHT ? 'R'
-                                    : 'N' ),
-                                  nearest->unum() );
+                    RCSC_DLOG( Logger::WORLD, addText,
+                               __FILE__" (updateLastKicker) set by nearest teammate or unknown."
+                               " side=%c unum=%d",
+                               ( nearest->side() == LEFT ? 'L'
+                                 : nearest->side() == RIGHT ? 'R'
+                                 : 'N' ),
+                               nearest->unum() );
 #endif
                 }
                 else
@@ -5195,13 +5248,13 @@ WorldModel::updateLastKicker()
                     M_last_kicker_side = theirSide();
                     M_last_kicker_unum = nearest->unum();
 #ifdef DEBUG_PRINT_LAST_KICKER
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (updateLastKicker) set by nearest opponent."
-                                  " side=%c unum=%d",
-                                  ( nearest->side() == LEFT ? 'L'
-                                    : nearest->side() == RIGHT ? 'R'
-                                    : 'N' ),
-                                  nearest->unum() );
+                    RCSC_DLOG( Logger::WORLD, addText,
+                               __FILE__" (updateLastKicker) set by nearest opponent."
+                               " side=%c unum=%d",
+                               ( nearest->side() == LEFT ? 'L'
+                                 : nearest->side() == RIGHT ? 'R'
+                                 : 'N' ),
+                               nearest->unum() );
 #endif
                 }
 
@@ -5216,9 +5269,9 @@ WorldModel::updateLastKicker()
                  && M_last_kicker_unum != Unum_Unknown )
             {
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) keep last kicker. teammate %d",
-                              M_last_kicker_unum );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updateLastKicker) keep last kicker. teammate %d",
+                           M_last_kicker_unum );
 #endif
             }
             else
@@ -5226,8 +5279,8 @@ WorldModel::updateLastKicker()
                 M_last_kicker_side = NEUTRAL;
                 M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (updateLastKicker) set NEUTRAL." );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (updateLastKicker) set NEUTRAL." );
 #endif
             }
             return;
@@ -5263,8 +5316,8 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = NEUTRAL;
             M_last_kicker_unum = Unum_Unknown;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen both side kickers." );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by seen both side kickers." );
 #endif
             return;
         }
@@ -5273,8 +5326,8 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = ourSide();
             M_last_kicker_unum = teammate_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen teammate kicker." );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by seen teammate kicker." );
 #endif
             return;
         }
@@ -5283,19 +5336,19 @@ WorldModel::updateLastKicker()
             M_last_kicker_side = theirSide();
             M_last_kicker_unum = opponent_kicker_unum;
 #ifdef DEBUG_PRINT_LAST_KICKER
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateLastKicker) set by seen opponent kicker." );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateLastKicker) set by seen opponent kicker." );
 #endif
             return;
         }
 
     }
 #ifdef DEBUG_PRINT_LAST_KICKER
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateLastKicker) no updated. last_kicker_side=%c",
-                  ( M_last_kicker_side == LEFT  ? 'L'
-                    : M_last_kicker_side == RIGHT ? 'R'
-                    : 'N' ) );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateLastKicker) no updated. last_kicker_side=%c",
+               ( M_last_kicker_side == LEFT  ? 'L'
+                 : M_last_kicker_side == RIGHT ? 'R'
+                 : 'N' ) );
 #endif
 }
 
@@ -5339,27 +5392,25 @@ WorldModel::updateInterceptTable()
     M_self.setBallReachStep( std::min( M_intercept_table->selfReachCycle(),
                                        M_intercept_table->selfReachCycle() ) );
 
-    const std::map< const AbstractPlayerObject *, int > & m = M_intercept_table->playerMap();
-
-    for ( PlayerObject::List::iterator p = M_teammates.begin(), end = M_teammates.end();
+    for ( PlayerObjectPool::List::iterator p = M_teammates.begin(), end = M_teammates.end();
           p != end;
           ++p )
     {
-        const std::map< const AbstractPlayerObject *, int >::const_iterator it = m.find( &(*p) );
-        if ( it != m.end() )
+        const int step = M_intercept_table->playerReachStep( &(*p) );
+        if ( step >= 0 )
         {
-            p->setBallReachStep( it->second );
+            p->setBallReachStep( step );
         }
     }
 
-    for ( PlayerObject::List::iterator p = M_opponents.begin(), end = M_opponents.end();
+    for ( PlayerObjectPool::List::iterator p = M_opponents.begin(), end = M_opponents.end();
           p != end;
           ++p )
     {
-        const std::map< const AbstractPlayerObject *, int >::const_iterator it = m.find( &(*p) );
-        if ( it != m.end() )
+        const int step = M_intercept_table->playerReachStep( &(*p) );
+        if ( step >= 0 )
         {
-            p->setBallReachStep( it->second );
+            p->setBallReachStep( step );
         }
     }
 }
@@ -5379,9 +5430,9 @@ WorldModel::checkGhost( const ViewArea & varea )
     //////////////////////////////////////////////////////////////////
     // ball
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (checkGhost) ball_count=%d, rpos_count=%d",
-                  ball().posCount(), ball().rposCount() );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (checkGhost) ball_count=%d, rpos_count=%d",
+               ball().posCount(), ball().rposCount() );
 #endif
 
     if ( ball().rposCount() > 0
@@ -5396,17 +5447,17 @@ WorldModel::checkGhost( const ViewArea & varea )
 
 #ifdef DEBUG_PRINT_BALL_UPDATE
         Vector2D ballrel = ball().pos() - varea.origin();
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (checkGhost) check ball. global_dist=%.2f."
-                      "  visdist=%.2f.  ",
-                      ballrel.r(), std::sqrt( BALL_VIS_DIST2 ) );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (checkGhost) check ball. global_dist=%.2f."
+                   "  visdist=%.2f.  ",
+                   ballrel.r(), std::sqrt( BALL_VIS_DIST2 ) );
 #endif
 
         if ( varea.contains( ball().pos(), angle_buf, BALL_VIS_DIST2 ) )
         {
 #ifdef DEBUG_PRINT_BALL_UPDATE
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (checkGhost) forget ball." );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (checkGhost) forget ball." );
 #endif
             M_ball.setGhost();
         }
@@ -5420,7 +5471,7 @@ WorldModel::checkGhost( const ViewArea & varea )
     // players
 
     {
-        std::list< PlayerObject >::iterator it = M_teammates.begin();
+        PlayerObjectPool::List::iterator it = M_teammates.begin();
         while ( it != M_teammates.end() )
         {
             if ( it->posCount() > 0
@@ -5431,18 +5482,18 @@ WorldModel::checkGhost( const ViewArea & varea )
                      && it->ghostCount() >= 2 )
                 {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (checkGhost) erase teammate (%.1f %.1f)",
-                                  it->pos().x, it->pos().y );
+                    RCSC_DLOG( Logger::WORLD, addText,
+                               __FILE__" (checkGhost) erase teammate (%.1f %.1f)",
+                               it->pos().x, it->pos().y );
 #endif
                     it = M_teammates.erase( it );
                     continue;
                 }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (checkGhost) setGhost to teammate %d (%.1f %.1f).",
-                              it->unum(), it->pos().x, it->pos().y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (checkGhost) setGhost to teammate %d (%.1f %.1f).",
+                           it->unum(), it->pos().x, it->pos().y );
 #endif
                 it->setGhost();
             }
@@ -5452,7 +5503,7 @@ WorldModel::checkGhost( const ViewArea & varea )
     }
 
     {
-        std::list< PlayerObject >::iterator it = M_opponents.begin();
+        PlayerObjectPool::List::iterator it = M_opponents.begin();
         while ( it != M_opponents.end() )
         {
             if ( it->posCount() > 0
@@ -5463,17 +5514,17 @@ WorldModel::checkGhost( const ViewArea & varea )
                      && it->ghostCount() >= 2 )
                 {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (checkGhost) erase opponent (%.1f %.1f)",
-                                  it->pos().x, it->pos().y );
+                    RCSC_DLOG( Logger::WORLD, addText,
+                               __FILE__" (checkGhost) erase opponent (%.1f %.1f)",
+                               it->pos().x, it->pos().y );
 #endif
                     it = M_opponents.erase( it );
                     continue;
                 }
 
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (checkGhost) setGhost to opponent %d (%.1f %.1f).",
-                              it->unum(), it->pos().x, it->pos().y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (checkGhost) setGhost to opponent %d (%.1f %.1f).",
+                           it->unum(), it->pos().x, it->pos().y );
                 it->setGhost();
             }
 
@@ -5482,7 +5533,7 @@ WorldModel::checkGhost( const ViewArea & varea )
     }
 
     {
-        std::list< PlayerObject >::iterator it = M_unknown_players.begin();
+        PlayerObjectPool::List::iterator it = M_unknown_players.begin();
         while ( it != M_unknown_players.end() )
         {
             if ( it->posCount() > 0
@@ -5492,18 +5543,18 @@ WorldModel::checkGhost( const ViewArea & varea )
                      || it->isGhost() ) // detect twice
                 {
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                    dlog.addText( Logger::WORLD,
-                                  __FILE__" (checkGhost) erase unknown player (%.1f %.1f)",
-                                  it->pos().x, it->pos().y );
+                    RCSC_DLOG( Logger::WORLD, addText,
+                               __FILE__" (checkGhost) erase unknown player (%.1f %.1f)",
+                               it->pos().x, it->pos().y );
 #endif
                     it = M_unknown_players.erase( it );
                     continue;
                 }
 
 #ifdef DEBUG_PRINT_PLAYER_UPDATE
-                dlog.addText( Logger::WORLD,
-                              __FILE__" (checkGhost) setGhost to unknown player (%.1f %.1f)",
-                              it->pos().x, it->pos().y );
+                RCSC_DLOG( Logger::WORLD, addText,
+                           __FILE__" (checkGhost) setGhost to unknown player (%.1f %.1f)",
+                           it->pos().x, it->pos().y );
 #endif
                 it->setGhost();
             }
@@ -5543,10 +5594,10 @@ WorldModel::updateDirCount( const ViewArea & varea )
     }
 
 #ifdef DEBUG_PRINT
-    dlog.addText( Logger::WORLD,
-                  __FILE__" (updateDirCount) left=%.1f right=%.1f dir buf=%.3f start_dir=%.1f start_idx=%d",
-                  left_limit.degree(), right_limit.degree(),
-                  dir_buf, dir.degree(), idx );
+    RCSC_DLOG( Logger::WORLD, addText,
+               __FILE__" (updateDirCount) left=%.1f right=%.1f dir buf=%.3f start_dir=%.1f start_idx=%d",
+               left_limit.degree(), right_limit.degree(),
+               dir_buf, dir.degree(), idx );
 #endif
 
     while ( dir.isLeftOf( right_limit ) )
@@ -5566,9 +5617,9 @@ WorldModel::updateDirCount( const ViewArea & varea )
         }
         //#ifdef DEBUG
 #if 0
-        dlog.addText( Logger::WORLD,
-                      __FILE__" (updateDirCount) update dir. index=%d : angle=%.0f",
-                      idx, dir.degree() );
+        RCSC_DLOG( Logger::WORLD, addText,
+                   __FILE__" (updateDirCount) update dir. index=%d : angle=%.0f",
+                   idx, dir.degree() );
 #endif
         M_dir_count[idx] = 0;
         dir += DIR_STEP;
@@ -5581,9 +5632,9 @@ WorldModel::updateDirCount( const ViewArea & varea )
         double d = -180.0;
         for ( int i = 0; i < DIR_CONF_DIVS; ++i, d += DIR_STEP )
         {
-            dlog.addText( Logger::WORLD,
-                          __FILE__" (updateDirCount) __ dir count: %.0f - %d",
-                          d, M_dir_count[i] );
+            RCSC_DLOG( Logger::WORLD, addText,
+                       __FILE__" (updateDirCount) __ dir count: %.0f - %d",
+                       d, M_dir_count[i] );
         }
     }
 #endif
@@ -5842,7 +5893,7 @@ WorldModel::getOurGoalie() const
         return ourPlayer( M_our_goalie_unum );
     }
 
-    for ( std::list< PlayerObject >::const_iterator it = M_teammates.begin(),
+    for ( PlayerObjectPool::List::const_iterator it = M_teammates.begin(),
               end = M_teammates.end();
           it != end;
           ++it )
@@ -5869,7 +5920,7 @@ WorldModel::getTheirGoalie() const
         return theirPlayer( M_their_goalie_unum );
     }
 
-    for ( std::list< PlayerObject >::const_iterator it = M_opponents.begin(),
+    for ( PlayerObjectPool::List::const_iterator it = M_opponents.begin(),
               end = M_opponents.end();
           it != end;
           ++it )
@@ -5923,4 +5974,89 @@ WorldModel::getPlayerNearestTo( const Vector2D & point,
     return p;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+  The candidates are kept in a sorted buffer on the stack, so that the
+  query does not allocate except for the result container.
+ */
+size_t
+WorldModel::getPlayersNearestTo( const Vector2D & point,
+                                 const PlayerObject::Cont & players,
+                                 const size_t k,
+                                 const int count_thr,
+                                 PlayerObject::Cont & result )
+{
+    const size_t max_size = std::min( k, PlayerObjectPool::CAPACITY );
+    if ( max_size == 0 )
+    {
+        return 0;
+    }
+
+    const PlayerObject * buf[PlayerObjectPool::CAPACITY];
+    double dist2[PlayerObjectPool::CAPACITY];
+    size_t n = 0;
+
+    for ( PlayerObject::Cont::const_iterator it = players.begin(),
+              end = players.end();
+          it != end;
+          ++it )
+    {
+        if ( (*it)->posCount() > count_thr )
+        {
+            continue;
+        }
+
+        const double d2 = (*it)->pos().dist2( point );
+        if ( d2 >= 40000.0
+             || ( n == max_size && d2 >= dist2[n - 1] ) )
+        {
+            continue;
+        }
+
+        // the earlier player is placed first in case of the same distance
+        size_t i = ( n < max_size ? n++ : n - 1 );
+        while ( i > 0 && d2 < dist2[i - 1] )
+        {
+            buf[i] = buf[i - 1];
+            dist2[i] = dist2[i - 1];
+            --i;
+        }
+        buf[i] = *it;
+        dist2[i] = d2;
+    }
+
+    result.insert( result.end(), buf, buf + n );
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+size_t
+WorldModel::getPlayersWithin( const Vector2D & point,
+                              const PlayerObject::Cont & players,
+                              const double radius,
+                              const int count_thr,
+                              PlayerObject::Cont & result )
+{
+    const double r2 = radius * radius;
+    size_t n = 0;
+
+    for ( PlayerObject::Cont::const_iterator it = players.begin(),
+              end = players.end();
+          it != end;
+          ++it )
+    {
+        if ( (*it)->posCount() <= count_thr
+             && (*it)->pos().dist2( point ) <= r2 )
+        {
+            result.push_back( *it );
+            ++n;
+        }
+    }
+
+    return n;
+}
+
 }
@@ -35,6 +35,8 @@
 #include <rcsc/player/self_object.h>
 #include <rcsc/player/ball_object.h>
 #include <rcsc/player/player_object.h>
+#include <rcsc/player/player_object_pool.h>
+#include <rcsc/player/player_filter.h>
 #include <rcsc/player/view_area.h>
 #include <rcsc/player/view_grid_map.h>
 
@@ -111,9 +113,10 @@ private:
     SelfObject M_self; //!< self object
     BallObject M_ball; //!< current ball object
     BallObject M_prev_ball; //!< ball object in the previous cycle
-    PlayerObject::List M_teammates; //!< teammmates instance. at least, the side information is observed
-    PlayerObject::List M_opponents; //!< opponents instance. at least, the side information is observed
-    PlayerObject::List M_unknown_players; //!< unknown players instance
+    PlayerObjectPool M_player_pool; //!< storage of all player objects
+    PlayerObjectPool::List M_teammates; //!< teammmates instance. at least, the side information is observed
+    PlayerObjectPool::List M_opponents; //!< opponents instance. at least, the side information is observed
+    PlayerObjectPool::List M_unknown_players; //!< unknown players instance
 
     //////////////////////////////////////////////////
     // object reference (pointers to each object)
@@ -241,6 +244,18 @@ public:
     */
     const InterceptTable * interceptTable() const;
 
+    /*!
+      \brief set the number of threads used by the intercept table
+      \param n_threads the number of threads. if less than 2, intercept is predicted serially.
+    */
+    void setInterceptThreads( const int n_threads );
+
+    /*!
+      \brief set the incremental update mode of the intercept table
+      \param on if true, the exact last results of the unobserved players are reused.
+    */
+    void setInterceptIncremental( const bool on );
+
     /*!
       \brief get penalty kick state
       \return const pointer to the penalty kick state instance
@@ -478,9 +493,9 @@ private:
     */
     void checkTeamPlayer( const SideID side,
                           const Localization::PlayerT & player,
-                          PlayerObject::List & old_known_players,
-                          PlayerObject::List & old_unknown_players,
-                          PlayerObject::List & new_known_players );
+                          PlayerObjectPool::List & old_known_players,
+                          PlayerObjectPool::List & old_unknown_players,
+                          PlayerObjectPool::List & new_known_players );
 
     /*!
       \brief check player that has no identifier. matching to unknown players
@@ -493,12 +508,12 @@ private:
       \param new_unknown_players current seen unknown players
     */
     void checkUnknownPlayer( const Localization::PlayerT & player,
-                             PlayerObject::List & old_teammates,
-                             PlayerObject::List & old_opponent,
-                             PlayerObject::List & old_unknown_players,
-                             PlayerObject::List & new_teammates,
-                             PlayerObject::List & new_opponents,
-                             PlayerObject::List & new_unknown_players );
+                             PlayerObjectPool::List & old_teammates,
+                             PlayerObjectPool::List & old_opponent,
+                             PlayerObjectPool::List & old_unknown_players,
+                             PlayerObjectPool::List & new_teammates,
+                             PlayerObjectPool::List & new_opponents,
+                             PlayerObjectPool::List & new_unknown_players );
 
     /*!
       \brief set collision effect with ball
@@ -1266,6 +1281,79 @@ public:
      */
     size_t countPlayer( boost::shared_ptr< const PlayerPredicate > predicate ) const;
 
+    /*!
+      \brief call the visitor for each player that satisfies the predicate.
+      no heap memory is allocated, and the predicate call can be inlined.
+      \param predicate function object that takes const AbstractPlayerObject &. e.g. and_player_filter().
+      \param visitor function object that takes const AbstractPlayerObject &.
+     */
+    template < typename Predicate, typename Visitor >
+    void forEachPlayerIf( const Predicate & predicate,
+                          Visitor visitor ) const
+      {
+          for ( AbstractPlayerObject::Cont::const_iterator it = M_all_players.begin(),
+                    end = M_all_players.end();
+                it != end;
+                ++it )
+          {
+              if ( predicate( **it ) )
+              {
+                  visitor( **it );
+              }
+          }
+      }
+
+    /*!
+      \brief get the players that satisfy the predicate into the fixed capacity buffer.
+      \param predicate function object that takes const AbstractPlayerObject &. e.g. and_player_filter().
+      \param result reference to the result variable. the players are appended until it becomes full,
+      and result.truncated() becomes true if some players do not fit.
+      \return the number of the appended players
+     */
+    template < typename Predicate, std::size_t N >
+    size_t getPlayersIf( const Predicate & predicate,
+                         PlayerObjectBuffer< N > & result ) const
+      {
+          size_t n = 0;
+          for ( AbstractPlayerObject::Cont::const_iterator it = M_all_players.begin(),
+                    end = M_all_players.end();
+                it != end;
+                ++it )
+          {
+              if ( predicate( **it ) )
+              {
+                  if ( ! result.push_back( *it ) )
+                  {
+                      break;
+                  }
+                  ++n;
+              }
+          }
+          return n;
+      }
+
+    /*!
+      \brief get the number of players that satisfy the predicate.
+      \param predicate function object that takes const AbstractPlayerObject &. e.g. and_player_filter().
+      \return number of players.
+     */
+    template < typename Predicate >
+    size_t countPlayerIf( const Predicate & predicate ) const
+      {
+          size_t n = 0;
+          for ( AbstractPlayerObject::Cont::const_iterator it = M_all_players.begin(),
+                    end = M_all_players.end();
+                it != end;
+                ++it )
+          {
+              if ( predicate( **it ) )
+              {
+                  ++n;
+              }
+          }
+          return n;
+      }
+
     /*!
       \brief get a goalie teammate (include self)
       \return if found pointer to goalie object, otherwise NULL
@@ -1402,6 +1490,102 @@ public:
           return getOpponentNearestTo( p->pos(), count_thr, dist_to_point );
       }
 
+    /*!
+      \brief get the players nearest to point
+      \param point considered point
+      \param players target players
+      \param k the maximal number of the players
+      \param count_thr accuracy count threshold
+      \param result reference to the result variable. players are appended in the order of the distance.
+      \return the number of the appended players
+     */
+    static
+    size_t getPlayersNearestTo( const Vector2D & point,
+                                const PlayerObject::Cont & players,
+                                const size_t k,
+                                const int count_thr,
+                                PlayerObject::Cont & result );
+
+    /*!
+      \brief get the players within the radius from point
+      \param point the center point
+      \param players target players
+      \param radius the search radius
+      \param count_thr accuracy count threshold
+      \param result reference to the result variable. players are appended in the order of the input container.
+      \return the number of the appended players
+     */
+    static
+    size_t getPlayersWithin( const Vector2D & point,
+                             const PlayerObject::Cont & players,
+                             const double radius,
+                             const int count_thr,
+                             PlayerObject::Cont & result );
+
+    /*!
+      \brief get the teammates nearest to point
+      \param point considered point
+      \param k the maximal number of the players
+      \param count_thr accuracy count threshold
+      \param result reference to the result variable. players are appended in the order of the distance.
+      \return the number of the appended players
+     */
+    size_t getTeammatesNearestTo( const Vector2D & point,
+                                  const size_t k,
+                                  const int count_thr,
+                                  PlayerObject::Cont & result ) const
+      {
+          return getPlayersNearestTo( point, teammatesFromSelf(), k, count_thr, result );
+      }
+
+    /*!
+      \brief get the opponents (include unknown players) nearest to point
+      \param point considered point
+      \param k the maximal number of the players
+      \param count_thr accuracy count threshold
+      \param result reference to the result variable. players are appended in the order of the distance.
+      \return the number of the appended players
+     */
+    size_t getOpponentsNearestTo( const Vector2D & point,
+                                  const size_t k,
+                                  const int count_thr,
+                                  PlayerObject::Cont & result ) const
+      {
+          return getPlayersNearestTo( point, opponentsFromSelf(), k, count_thr, result );
+      }
+
+    /*!
+      \brief get the teammates within the radius from point
+      \param point the center point
+      \param radius the search radius
+      \param count_thr accuracy count threshold
+      \param result reference to the result variable. players are appended in the order of teammatesFromSelf().
+      \return the number of the appended players
+     */
+    size_t getTeammatesWithin( const Vector2D & point,
+                               const double radius,
+                               const int count_thr,
+                               PlayerObject::Cont & result ) const
+      {
+          return getPlayersWithin( point, teammatesFromSelf(), radius, count_thr, result );
+      }
+
+    /*!
+      \brief get the opponents (include unknown players) within the radius from point
+      \param point the center point
+      \param radius the search radius
+      \param count_thr accuracy count threshold
+      \param result reference to the result variable. players are appended in the order of opponentsFromSelf().
+      \return the number of the appended players
+     */
+    size_t getOpponentsWithin( const Vector2D & point,
+                               const double radius,
+                               const int count_thr,
+                               PlayerObject::Cont & result ) const
+      {
+          return getPlayersWithin( point, opponentsFromSelf(), radius, count_thr, result );
+      }
+
 private:
 
     /*!
@@ -36,10 +36,9 @@
 #include "world_state.h"
 
 #include "world_model.h"
+#include "intercept_table.h"
 
-#include <rcsc/common/logger.h>
-#include <rcsc/common/player_param.h>
-#include <rcsc/common/server_param.h>
+#include <algorithm>
 
 namespace rcsc {
 
@@ -50,9 +49,28 @@ namespace rcsc {
 WorldState::WorldState()
     : M_time( -1, 0 ),
       M_game_mode(),
-      M_ball()
+      M_our_side( NEUTRAL ),
+      M_self(),
+      M_self_stamina( 0.0 ),
+      M_self_kickable( false ),
+      M_ball(),
+      M_exist_kickable_teammate( false ),
+      M_exist_kickable_opponent( false ),
+      M_self_reach_step( 1000 ),
+      M_teammate_reach_step( 1000 ),
+      M_opponent_reach_step( 1000 ),
+      M_offside_line_x( 0.0 ),
+      M_offside_line_count( 1000 ),
+      M_our_defense_line_x( 0.0 ),
+      M_their_defense_line_x( 0.0 ),
+      M_our_offense_line_x( 0.0 ),
+      M_their_offense_line_x( 0.0 )
 {
+    M_teammates.reserve( 11 );
+    M_opponents.reserve( 11 );
 
+    std::fill( M_teammate_index, M_teammate_index + 12, -1 );
+    std::fill( M_opponent_index, M_opponent_index + 12, -1 );
 }
 
 /*-------------------------------------------------------------------*/
@@ -67,13 +85,165 @@ WorldState::~WorldState()
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+const PlayerState *
+WorldState::ourPlayer( const int unum ) const
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        return static_cast< const PlayerState * >( 0 );
+    }
+
+    if ( unum == M_self.unum() )
+    {
+        return &M_self;
+    }
+
+    return ( M_teammate_index[unum] >= 0
+             ? &M_teammates[M_teammate_index[unum]]
+             : static_cast< const PlayerState * >( 0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+const PlayerState *
+WorldState::theirPlayer( const int unum ) const
+{
+    if ( unum < 1 || 11 < unum )
+    {
+        return static_cast< const PlayerState * >( 0 );
+    }
+
+    return ( M_opponent_index[unum] >= 0
+             ? &M_opponents[M_opponent_index[unum]]
+             : static_cast< const PlayerState * >( 0 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
-WorldState::update( const WorldModel & wm );
+WorldState::update( const WorldModel & wm )
 {
     M_time = wm.time();
     M_game_mode = wm.gameMode();
+    M_our_side = wm.ourSide();
+
+    M_self.update( wm.self() );
+    M_self_stamina = wm.self().stamina();
+    M_self_kickable = wm.self().isKickable();
 
     M_ball.update( wm.ball() );
+
+    //
+    // players
+    //
+
+    std::fill( M_teammate_index, M_teammate_index + 12, -1 );
+    std::fill( M_opponent_index, M_opponent_index + 12, -1 );
+
+    // the containers never allocate memory after the first update,
+    // because the capacity is kept by resize().
+    M_teammates.resize( wm.teammatesFromSelf().size() );
+    for ( std::size_t i = 0; i < M_teammates.size(); ++i )
+    {
+        const AbstractPlayerObject * p = wm.teammatesFromSelf()[i];
+        M_teammates[i].update( *p );
+        if ( 1 <= p->unum() && p->unum() <= 11
+             && M_teammate_index[p->unum()] < 0 )
+        {
+            M_teammate_index[p->unum()] = static_cast< int >( i );
+        }
+    }
+
+    M_opponents.resize( wm.opponentsFromSelf().size() );
+    for ( std::size_t i = 0; i < M_opponents.size(); ++i )
+    {
+        const AbstractPlayerObject * p = wm.opponentsFromSelf()[i];
+        M_opponents[i].update( *p );
+        if ( 1 <= p->unum() && p->unum() <= 11
+             && M_opponent_index[p->unum()] < 0 )
+        {
+            M_opponent_index[p->unum()] = static_cast< int >( i );
+        }
+    }
+
+    M_exist_kickable_teammate = ( wm.kickableTeammate() != static_cast< const PlayerObject * >( 0 ) );
+    M_exist_kickable_opponent = ( wm.kickableOpponent() != static_cast< const PlayerObject * >( 0 ) );
+
+    //
+    // derived values
+    //
+
+    M_self_reach_step = wm.interceptTable()->selfReachStep();
+    M_teammate_reach_step = wm.interceptTable()->teammateReachStep();
+    M_opponent_reach_step = wm.interceptTable()->opponentReachStep();
+
+    M_offside_line_x = wm.offsideLineX();
+    M_offside_line_count = wm.offsideLineCount();
+    M_our_defense_line_x = wm.ourDefenseLineX();
+    M_their_defense_line_x = wm.theirDefenseLineX();
+    M_our_offense_line_x = wm.ourOffenseLineX();
+    M_their_offense_line_x = wm.theirOffenseLineX();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorldStateBuffer::WorldStateBuffer()
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+void
+WorldStateBuffer::publish( const WorldModel & wm )
+{
+    WorldState::Ptr state;
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+
+        // M_back is not reachable from latest().
+        // if no reader holds it, nobody can get it until the next swap.
+        if ( M_back
+             && M_back.unique() )
+        {
+            state.swap( M_back );
+        }
+        M_back.reset();
+    }
+
+    if ( ! state )
+    {
+        state.reset( new WorldState() );
+    }
+
+    state->update( wm );
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_back.swap( M_front );
+        M_front.swap( state );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+WorldState::ConstPtr
+WorldStateBuffer::latest() const
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+    return M_front;
+}
+
 }
-b
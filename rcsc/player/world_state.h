@@ -30,38 +30,71 @@
 /////////////////////////////////////////////////////////////////////
 
 #ifndef RCSC_PLAYER_WORLD_STATE_H
-#define RCSC_PLAYER_WORLD_MODEL_H
+#define RCSC_PLAYER_WORLD_STATE_H
 
-//#include <rcsc/player/self_object.h>
-#include <rcsc/player/ball_object.h>
-//#include <rcsc/player/player_object.h>
-//#include <rcsc/player/view_area.h>
+#include <rcsc/player/ball_state.h>
+#include <rcsc/player/player_state.h>
 
-#include <rcsc/geom/vector_2d.h>
 #include <rcsc/game_mode.h>
 #include <rcsc/game_time.h>
 #include <rcsc/types.h>
 
 #include <boost/shared_ptr.hpp>
 
-#include <string>
+#include <mutex>
+#include <vector>
 
 namespace rcsc {
 
+class WorldModel;
+
 /*!
   \class WorldState
   \brief a snapshot of the player's mental model.
+
+  WorldState holds the copy of the values in WorldModel that are
+  mainly used by the decision making. The instance is never modified
+  after it is published by WorldStateBuffer, so it can be read by
+  other threads while WorldModel is updated by the next sensory
+  messages.
 */
 class WorldState {
 public:
 
-    typedef boost::shared_ptr< WorldStae > Ptr; //!< smart pointer type
-    typedef boost::shared_ptr< const WorldStae > ConstPtr; //!< const smart pointer type
+    typedef boost::shared_ptr< WorldState > Ptr; //!< smart pointer type
+    typedef boost::shared_ptr< const WorldState > ConstPtr; //!< const smart pointer type
+
+private:
 
     GameTime M_time; //!< game time of this state
     GameMode M_game_mode; //!< playmode data
+    SideID M_our_side; //!< our side
+
+    PlayerState M_self; //!< self state
+    double M_self_stamina; //!< self stamina value
+    bool M_self_kickable; //!< true if self can kick the ball
+
+    BallState M_ball; //!< ball state
+
+    std::vector< PlayerState > M_teammates; //!< teammates sorted by the distance from self
+    std::vector< PlayerState > M_opponents; //!< opponents sorted by the distance from self
+
+    int M_teammate_index[12]; //!< index of M_teammates for each uniform number. -1 means no player.
+    int M_opponent_index[12]; //!< index of M_opponents for each uniform number. -1 means no player.
 
-    BallState M_ball; //!< ball instance
+    bool M_exist_kickable_teammate; //!< true if any teammate can kick the ball
+    bool M_exist_kickable_opponent; //!< true if any opponent can kick the ball
+
+    int M_self_reach_step; //!< estimated ball reach step of self
+    int M_teammate_reach_step; //!< estimated ball reach step of the fastest teammate
+    int M_opponent_reach_step; //!< estimated ball reach step of the fastest opponent
+
+    double M_offside_line_x; //!< offside line x
+    int M_offside_line_count; //!< accuracy count of the offside line
+    double M_our_defense_line_x; //!< our defense line x
+    double M_their_defense_line_x; //!< their defense line x
+    double M_our_offense_line_x; //!< our offense line x
+    double M_their_offense_line_x; //!< their offense line x
 
     // not used
     WorldState( const WorldState & );
@@ -78,9 +111,9 @@ public:
     */
     ~WorldState();
 
-
     /*!
       \brief get the game time of this state
+      \return const reference to the game time
      */
     const GameTime & time() const
       {
@@ -96,9 +129,45 @@ public:
           return M_game_mode;
       }
 
+    /*!
+      \brief get our side
+      \return side id
+     */
+    SideID ourSide() const
+      {
+          return M_our_side;
+      }
+
+    /*!
+      \brief get self data
+      \return const reference to the self state
+     */
+    const PlayerState & self() const
+      {
+          return M_self;
+      }
+
+    /*!
+      \brief get self stamina value
+      \return stamina value
+     */
+    double selfStamina() const
+      {
+          return M_self_stamina;
+      }
+
+    /*!
+      \brief check if self can kick the ball
+      \return true if self can kick the ball
+     */
+    bool selfKickable() const
+      {
+          return M_self_kickable;
+      }
+
     /*!
       \brief get ball data.
-      \return const reference to the ball object instance.
+      \return const reference to the ball state instance.
      */
     const BallState & ball() const
       {
@@ -106,13 +175,175 @@ public:
       }
 
     /*!
-      \brief this method estimates new state data using the agent's internal world model.
+      \brief get teammates sorted by the distance from self
+      \return const reference to the player state container
+     */
+    const std::vector< PlayerState > & teammates() const
+      {
+          return M_teammates;
+      }
+
+    /*!
+      \brief get opponents sorted by the distance from self
+      \return const reference to the player state container
+     */
+    const std::vector< PlayerState > & opponents() const
+      {
+          return M_opponents;
+      }
+
+    /*!
+      \brief get the teammate specified by the uniform number
+      \param unum uniform number
+      \return const pointer to the player state. NULL if not found.
+     */
+    const PlayerState * ourPlayer( const int unum ) const;
+
+    /*!
+      \brief get the opponent specified by the uniform number
+      \param unum uniform number
+      \return const pointer to the player state. NULL if not found.
+     */
+    const PlayerState * theirPlayer( const int unum ) const;
+
+    /*!
+      \brief check if any teammate can kick the ball
+      \return true if kickable teammate exists
+     */
+    bool existKickableTeammate() const
+      {
+          return M_exist_kickable_teammate;
+      }
+
+    /*!
+      \brief check if any opponent can kick the ball
+      \return true if kickable opponent exists
+     */
+    bool existKickableOpponent() const
+      {
+          return M_exist_kickable_opponent;
+      }
+
+    /*!
+      \brief get the estimated ball reach step of self
+      \return step value
+     */
+    int selfReachStep() const
+      {
+          return M_self_reach_step;
+      }
+
+    /*!
+      \brief get the estimated ball reach step of the fastest teammate
+      \return step value
+     */
+    int teammateReachStep() const
+      {
+          return M_teammate_reach_step;
+      }
+
+    /*!
+      \brief get the estimated ball reach step of the fastest opponent
+      \return step value
+     */
+    int opponentReachStep() const
+      {
+          return M_opponent_reach_step;
+      }
+
+    /*!
+      \brief get the offside line x
+      \return x coordinate value
+     */
+    double offsideLineX() const { return M_offside_line_x; }
+
+    /*!
+      \brief get the accuracy count of the offside line
+      \return count value
+     */
+    int offsideLineCount() const { return M_offside_line_count; }
+
+    /*!
+      \brief get our defense line x
+      \return x coordinate value
+     */
+    double ourDefenseLineX() const { return M_our_defense_line_x; }
+
+    /*!
+      \brief get their defense line x
+      \return x coordinate value
+     */
+    double theirDefenseLineX() const { return M_their_defense_line_x; }
+
+    /*!
+      \brief get our offense line x
+      \return x coordinate value
+     */
+    double ourOffenseLineX() const { return M_our_offense_line_x; }
+
+    /*!
+      \brief get their offense line x
+      \return x coordinate value
+     */
+    double theirOffenseLineX() const { return M_their_offense_line_x; }
+
+    /*!
+      \brief copy the current values of the world model.
       \param wm world model instance
+
+      This method must not be called for the published instance.
     */
     void update( const WorldModel & wm );
 
 };
 
+/*!
+  \class WorldStateBuffer
+  \brief double buffer to publish WorldState to other threads.
+
+  publish() copies WorldModel into the back buffer and swaps it with
+  the front buffer. The back buffer is reused only when no reader
+  holds it. Otherwise, a new instance is created, so that the published
+  instance is never modified (copy on write).
+  latest() can be called from any thread.
+*/
+class WorldStateBuffer {
+private:
+    //! guard for the buffers
+    mutable std::mutex M_mutex;
+
+    //! the latest published state
+    WorldState::Ptr M_front;
+
+    //! the previously published state. reused if no reader holds it.
+    WorldState::Ptr M_back;
+
+    // noncopyable
+    WorldStateBuffer( const WorldStateBuffer & );
+    WorldStateBuffer & operator=( const WorldStateBuffer & );
+
+public:
+    /*!
+      \brief create empty buffers
+     */
+    WorldStateBuffer();
+
+    /*!
+      \brief create the snapshot of the world model and publish it.
+      \param wm world model instance
+
+      This method must be called by one thread.
+     */
+    void publish( const WorldModel & wm );
+
+    /*!
+      \brief get the latest published state
+      \return const pointer to the state. empty if nothing is published yet.
+     */
+    WorldState::ConstPtr latest() const;
+
+};
+
 }
 
 #endif
@@ -0,0 +1,737 @@
+// -*-c++-*-
+
+/*!
+  \file cycle_index.cpp
+  \brief cycle index for random access to rcg files Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "cycle_index.h"
+
+#include "parser_mmap.h"
+#include "handler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/stat.h>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! sidecar file magic string
+const char INDEX_MAGIC[] = "RCGIDX";
+
+//! sidecar file format version
+const int INDEX_FORMAT_VERSION = 1;
+
+//! the number of bytes kept to classify the line
+const std::size_t LINE_HEAD_SIZE = 32;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the unsigned integer in little endian
+ */
+void
+write_uint( std::ostream & os,
+            unsigned long long value,
+            const int bytes )
+{
+    char buf[8];
+    for ( int i = 0; i < bytes; ++i )
+    {
+        buf[i] = static_cast< char >( value & 0xff );
+        value >>= 8;
+    }
+    os.write( buf, bytes );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the unsigned integer written by write_uint()
+ */
+bool
+read_uint( std::istream & is,
+           unsigned long long & value,
+           const int bytes )
+{
+    unsigned char buf[8];
+    if ( ! is.read( reinterpret_cast< char * >( buf ), bytes ) )
+    {
+        return false;
+    }
+
+    value = 0;
+    for ( int i = bytes - 1; i >= 0; --i )
+    {
+        value = ( value << 8 ) | buf[i];
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the size and the modification time of the file
+ */
+bool
+file_status( const std::string & path,
+             unsigned long long & size,
+             long long & mtime )
+{
+    struct stat st;
+    if ( ::stat( path.c_str(), &st ) != 0 )
+    {
+        return false;
+    }
+
+    size = static_cast< unsigned long long >( st.st_size );
+    mtime = static_cast< long long >( st.st_mtime );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check the gzip magic number
+ */
+bool
+is_gzip_file( const std::string & path )
+{
+    std::ifstream fin( path.c_str(), std::ios_base::in | std::ios_base::binary );
+    unsigned char magic[2] = { 0, 0 };
+    fin.read( reinterpret_cast< char * >( magic ), 2 );
+    return fin.gcount() == 2
+        && magic[0] == 0x1f
+        && magic[1] == 0x8b;
+}
+
+/*!
+  \class LineScanner
+  \brief receives the data in arbitrary chunks and records the indexed lines.
+ */
+class LineScanner {
+private:
+    std::vector< CycleIndex::Entry > & M_entries;
+
+    //! byte offset of the next input
+    unsigned long long M_offset;
+
+    //! byte offset of the head of the current line
+    unsigned long long M_line_offset;
+
+    //! the first bytes of the current line
+    char M_head[LINE_HEAD_SIZE + 1];
+    std::size_t M_head_size;
+
+    //! the number of finished lines
+    long M_n_line;
+
+public:
+
+    int version_; //!< detected log version
+    unsigned long long header_begin_; //!< the head of the second line
+    unsigned long long header_end_; //!< the head of the first indexed line
+
+    explicit
+    LineScanner( std::vector< CycleIndex::Entry > & entries )
+        : M_entries( entries ),
+          M_offset( 0 ),
+          M_line_offset( 0 ),
+          M_head_size( 0 ),
+          M_n_line( 0 ),
+          version_( 0 ),
+          header_begin_( 0 ),
+          header_end_( 0 )
+      { }
+
+    void feed( const char * data,
+               const std::size_t size )
+      {
+          const char * p = data;
+          const char * end = data + size;
+          while ( p < end )
+          {
+              const char * nl = static_cast< const char * >( std::memchr( p, '\n', end - p ) );
+              const char * line_end = ( nl ? nl : end );
+
+              if ( M_head_size < LINE_HEAD_SIZE )
+              {
+                  const std::size_t n = std::min( LINE_HEAD_SIZE - M_head_size,
+                                                  static_cast< std::size_t >( line_end - p ) );
+                  std::memcpy( M_head + M_head_size, p, n );
+                  M_head_size += n;
+              }
+
+              M_offset += line_end - p;
+              if ( ! nl )
+              {
+                  break;
+              }
+
+              M_offset += 1; // newline
+              finishLine();
+              p = nl + 1;
+          }
+      }
+
+    void finish()
+      {
+          if ( M_head_size > 0 )
+          {
+              finishLine();
+          }
+      }
+
+private:
+
+    void finishLine()
+      {
+          M_head[M_head_size] = '\0';
+
+          if ( M_n_line == 0 )
+          {
+              if ( ! std::strncmp( M_head, "ULG4", 4 ) ) version_ = 4;
+              else if ( ! std::strncmp( M_head, "ULG5", 4 ) ) version_ = 5;
+              header_begin_ = M_offset;
+              header_end_ = M_offset;
+          }
+          else
+          {
+              const char * p = M_head;
+              while ( *p == ' ' || *p == '\t' ) ++p;
+
+              int kind = -1;
+              if ( ! std::strncmp( p, "(show ", 6 ) )
+              {
+                  kind = CycleIndex::SHOW;
+                  p += 6;
+              }
+              else if ( ! std::strncmp( p, "(playmode ", 10 ) )
+              {
+                  kind = CycleIndex::PLAYMODE;
+                  p += 10;
+              }
+              else if ( ! std::strncmp( p, "(team ", 6 ) )
+              {
+                  kind = CycleIndex::TEAM;
+                  p += 6;
+              }
+
+              if ( kind >= 0 )
+              {
+                  CycleIndex::Entry e;
+                  e.time_ = static_cast< int >( std::strtol( p, NULL, 10 ) );
+                  e.kind_ = kind;
+                  e.offset_ = M_line_offset;
+
+                  if ( M_entries.empty() )
+                  {
+                      header_end_ = M_line_offset;
+                  }
+                  M_entries.push_back( e );
+              }
+          }
+
+          ++M_n_line;
+          M_line_offset = M_offset;
+          M_head_size = 0;
+      }
+};
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+CycleIndex::CycleIndex()
+    : M_version( 0 ),
+      M_compressed( false ),
+      M_file_size( 0 ),
+      M_file_mtime( 0 ),
+      M_data_size( 0 ),
+      M_header_begin( 0 ),
+      M_header_end( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+CycleIndex::clear()
+{
+    M_log_path.clear();
+    M_version = 0;
+    M_compressed = false;
+    M_file_size = 0;
+    M_file_mtime = 0;
+    M_data_size = 0;
+    M_header_begin = 0;
+    M_header_end = 0;
+    M_entries.clear();
+    M_gz_reader.close();
+    M_gz_index.clear();
+    if ( M_fin.is_open() )
+    {
+        M_fin.close();
+    }
+    M_fin.clear();
+    M_header_data.clear();
+    M_line_cache.clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::string
+CycleIndex::sidecar_path( const std::string & log_path )
+{
+    return log_path + ".idx";
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CycleIndex::build( const std::string & log_path,
+                   const std::size_t span )
+{
+    clear();
+
+    if ( ! file_status( log_path, M_file_size, M_file_mtime ) )
+    {
+        std::cerr << "(CycleIndex::build) could not open the file [" << log_path << ']'
+                  << std::endl;
+        return false;
+    }
+
+    M_log_path = log_path;
+    M_compressed = is_gzip_file( log_path );
+
+    LineScanner scanner( M_entries );
+
+    if ( M_compressed )
+    {
+        if ( ! M_gz_index.build( log_path.c_str(), span,
+                                 [&scanner]( const char * data, std::size_t size )
+                                 {
+                                     scanner.feed( data, size );
+                                 } ) )
+        {
+            std::cerr << "(CycleIndex::build) could not decompress the file [" << log_path << ']'
+                      << std::endl;
+            clear();
+            return false;
+        }
+    }
+    else
+    {
+        std::ifstream fin( log_path.c_str(), std::ios_base::in | std::ios_base::binary );
+        std::vector< char > buf( 1024 * 1024 );
+        while ( fin )
+        {
+            fin.read( buf.data(), buf.size() );
+            if ( fin.gcount() > 0 )
+            {
+                scanner.feed( buf.data(), static_cast< std::size_t >( fin.gcount() ) );
+            }
+        }
+
+        if ( fin.bad() )
+        {
+            std::cerr << "(CycleIndex::build) could not read the file [" << log_path << ']'
+                      << std::endl;
+            clear();
+            return false;
+        }
+    }
+
+    scanner.finish();
+
+    if ( scanner.version_ != 4
+         && scanner.version_ != 5 )
+    {
+        std::cerr << "(CycleIndex::build) unsupported log version [" << log_path << ']'
+                  << std::endl;
+        clear();
+        return false;
+    }
+
+    M_version = scanner.version_;
+    M_header_begin = scanner.header_begin_;
+    M_header_end = ( M_entries.empty() ? scanner.header_begin_ : scanner.header_end_ );
+    M_data_size = ( M_compressed ? M_gz_index.uncompressedSize() : M_file_size );
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CycleIndex::save( const std::string & index_path ) const
+{
+    if ( M_version == 0 )
+    {
+        return false;
+    }
+
+    std::ofstream fout( index_path.c_str(),
+                        std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+    if ( ! fout.is_open() )
+    {
+        return false;
+    }
+
+    fout.write( INDEX_MAGIC, 6 );
+    write_uint( fout, INDEX_FORMAT_VERSION, 1 );
+    write_uint( fout, M_version, 1 );
+    write_uint( fout, M_compressed ? 1 : 0, 1 );
+    write_uint( fout, M_file_size, 8 );
+    write_uint( fout, static_cast< unsigned long long >( M_file_mtime ), 8 );
+    write_uint( fout, M_data_size, 8 );
+    write_uint( fout, M_header_begin, 8 );
+    write_uint( fout, M_header_end, 8 );
+    write_uint( fout, M_entries.size(), 8 );
+
+    for ( const Entry & e : M_entries )
+    {
+        write_uint( fout, static_cast< unsigned int >( e.time_ ), 4 );
+        write_uint( fout, e.kind_, 1 );
+        write_uint( fout, e.offset_, 8 );
+    }
+
+    if ( M_compressed )
+    {
+        M_gz_index.write( fout );
+    }
+
+    fout.close();
+    return ! fout.fail();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CycleIndex::load( const std::string & log_path,
+                  const std::string & index_path )
+{
+    clear();
+
+    unsigned long long file_size = 0;
+    long long file_mtime = 0;
+    if ( ! file_status( log_path, file_size, file_mtime ) )
+    {
+        return false;
+    }
+
+    std::ifstream fin( index_path.c_str(), std::ios_base::in | std::ios_base::binary );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    char magic[6];
+    unsigned long long format = 0, version = 0, compressed = 0;
+    unsigned long long size = 0, mtime = 0, n = 0;
+    if ( ! fin.read( magic, 6 )
+         || std::memcmp( magic, INDEX_MAGIC, 6 ) != 0
+         || ! read_uint( fin, format, 1 )
+         || format != INDEX_FORMAT_VERSION
+         || ! read_uint( fin, version, 1 )
+         || ! read_uint( fin, compressed, 1 )
+         || ! read_uint( fin, size, 8 )
+         || ! read_uint( fin, mtime, 8 )
+         || size != file_size
+         || static_cast< long long >( mtime ) != file_mtime
+         || ! read_uint( fin, M_data_size, 8 )
+         || ! read_uint( fin, M_header_begin, 8 )
+         || ! read_uint( fin, M_header_end, 8 )
+         || ! read_uint( fin, n, 8 ) )
+    {
+        clear();
+        return false;
+    }
+
+    M_entries.reserve( static_cast< std::size_t >( n ) );
+    for ( unsigned long long i = 0; i < n; ++i )
+    {
+        unsigned long long time = 0, kind = 0;
+        Entry e;
+        if ( ! read_uint( fin, time, 4 )
+             || ! read_uint( fin, kind, 1 )
+             || ! read_uint( fin, e.offset_, 8 ) )
+        {
+            clear();
+            return false;
+        }
+        e.time_ = static_cast< int >( static_cast< unsigned int >( time ) );
+        e.kind_ = static_cast< int >( kind );
+        M_entries.push_back( e );
+    }
+
+    if ( compressed
+         && ! M_gz_index.read( fin ) )
+    {
+        clear();
+        return false;
+    }
+
+    M_log_path = log_path;
+    M_version = static_cast< int >( version );
+    M_compressed = ( compressed != 0 );
+    M_file_size = file_size;
+    M_file_mtime = file_mtime;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CycleIndex::open( const std::string & log_path )
+{
+    const std::string index_path = sidecar_path( log_path );
+
+    if ( load( log_path, index_path ) )
+    {
+        return true;
+    }
+
+    if ( ! build( log_path ) )
+    {
+        return false;
+    }
+
+    if ( ! save( index_path ) )
+    {
+        // the index is still usable without the sidecar file.
+        std::cerr << "(CycleIndex::open) could not write the index file [" << index_path << ']'
+                  << std::endl;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+CycleIndex::firstCycle() const
+{
+    return ( M_entries.empty() ? -1 : M_entries.front().time_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+CycleIndex::lastCycle() const
+{
+    return ( M_entries.empty() ? -1 : M_entries.back().time_ );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CycleIndex::readData( const unsigned long long offset,
+                      const std::size_t len,
+                      std::string & dest )
+{
+    if ( M_compressed )
+    {
+        if ( ! M_gz_reader.isOpen()
+             && ! M_gz_reader.open( M_log_path.c_str(), M_gz_index ) )
+        {
+            return false;
+        }
+        return M_gz_reader.read( offset, len, dest );
+    }
+
+    if ( ! M_fin.is_open() )
+    {
+        M_fin.open( M_log_path.c_str(), std::ios_base::in | std::ios_base::binary );
+        if ( ! M_fin.is_open() )
+        {
+            return false;
+        }
+    }
+
+    M_fin.clear();
+    M_fin.seekg( static_cast< std::streamoff >( offset ) );
+    const std::size_t old_size = dest.size();
+    dest.resize( old_size + len );
+    M_fin.read( &dest[old_size], len );
+    dest.resize( old_size + static_cast< std::size_t >( M_fin.gcount() ) );
+    return ! M_fin.bad();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CycleIndex::readLine( const std::size_t entry_index,
+                      std::string & dest )
+{
+    std::map< std::size_t, std::string >::const_iterator it = M_line_cache.find( entry_index );
+    if ( it != M_line_cache.end() )
+    {
+        dest += it->second;
+        return true;
+    }
+
+    const unsigned long long first = M_entries[entry_index].offset_;
+    const unsigned long long last = ( entry_index + 1 < M_entries.size()
+                                      ? M_entries[entry_index + 1].offset_
+                                      : M_data_size );
+
+    std::string buf;
+    if ( ! readData( first, static_cast< std::size_t >( last - first ), buf ) )
+    {
+        return false;
+    }
+
+    // other lines (e.g. msg) may follow the indexed line.
+    const std::string::size_type eol = buf.find( '\n' );
+    if ( eol != std::string::npos )
+    {
+        buf.erase( eol + 1 );
+    }
+
+    dest += buf;
+    M_line_cache[entry_index].swap( buf );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+CycleIndex::read( const int first_cycle,
+                  const int last_cycle,
+                  Handler & handler )
+{
+    if ( M_version == 0 )
+    {
+        return false;
+    }
+
+    // the cycles are not decreasing in the file order.
+    std::vector< Entry >::const_iterator first
+        = std::lower_bound( M_entries.cbegin(), M_entries.cend(), first_cycle,
+                            []( const Entry & e, const int cycle ) { return e.time_ < cycle; } );
+    std::vector< Entry >::const_iterator last
+        = std::upper_bound( first, M_entries.cend(), last_cycle,
+                            []( const int cycle, const Entry & e ) { return cycle < e.time_; } );
+
+    const std::size_t first_index = first - M_entries.cbegin();
+
+    // parameter lines
+    if ( M_header_data.empty()
+         && M_header_end > M_header_begin
+         && ! readData( M_header_begin,
+                        static_cast< std::size_t >( M_header_end - M_header_begin ),
+                        M_header_data ) )
+    {
+        M_header_data.clear();
+        return false;
+    }
+
+    std::string buf = M_header_data;
+
+    // the last playmode and team before the range
+    int last_playmode = -1;
+    int last_team = -1;
+    for ( std::size_t i = first_index; i > 0 && ( last_playmode < 0 || last_team < 0 ); --i )
+    {
+        const Entry & e = M_entries[i - 1];
+        if ( e.kind_ == PLAYMODE && last_playmode < 0 ) last_playmode = static_cast< int >( i - 1 );
+        if ( e.kind_ == TEAM && last_team < 0 ) last_team = static_cast< int >( i - 1 );
+    }
+
+    if ( last_playmode >= 0
+         && ! readLine( last_playmode, buf ) )
+    {
+        return false;
+    }
+
+    if ( last_team >= 0
+         && ! readLine( last_team, buf ) )
+    {
+        return false;
+    }
+
+    // lines in the range
+    if ( first != last )
+    {
+        const unsigned long long begin = first->offset_;
+        const unsigned long long end = ( last != M_entries.cend() ? last->offset_ : M_data_size );
+        if ( ! readData( begin, static_cast< std::size_t >( end - begin ), buf ) )
+        {
+            return false;
+        }
+    }
+
+    if ( ! handler.handleLogVersion( M_version ) )
+    {
+        return false;
+    }
+
+    const ParserMMap parser;
+    if ( ! parser.parseLines( buf.data(), buf.data() + buf.size(), handler ) )
+    {
+        return false;
+    }
+
+    return handler.handleEOF();
+}
+
+}
+}
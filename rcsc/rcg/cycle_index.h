@@ -0,0 +1,266 @@
+// -*-c++-*-
+
+/*!
+  \file cycle_index.h
+  \brief cycle index for random access to rcg files Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_CYCLE_INDEX_H
+#define RCSC_RCG_CYCLE_INDEX_H
+
+#include <rcsc/gz/gzaccessindex.h>
+
+#include <fstream>
+#include <map>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace rcsc {
+namespace rcg {
+
+class Handler;
+
+/*!
+  \class CycleIndex
+  \brief byte offsets of the show/playmode/team lines of a rcg v4/v5 file.
+
+  The index is built by scanning the log once, and it can be saved as
+  a sidecar file (<log path>.idx). read() seeks directly to the requested
+  cycle range and replays only the lines in the range through a Handler.
+
+  Gzipped logs are also supported. The offsets are the positions in the
+  uncompressed data, and zlib access points (GZAccessIndex) are stored
+  together so that only a small part of the file is decompressed.
+ */
+class CycleIndex {
+public:
+
+    /*!
+      \brief indexed line kind
+     */
+    enum LineKind {
+        SHOW = 0,
+        PLAYMODE = 1,
+        TEAM = 2,
+    };
+
+    /*!
+      \struct Entry
+      \brief the position of the indexed line
+     */
+    struct Entry {
+        int time_; //!< game cycle written in the line
+        int kind_; //!< LineKind
+        unsigned long long offset_; //!< byte offset of the head of the line in the (uncompressed) data
+    };
+
+private:
+
+    //! indexed log file path
+    std::string M_log_path;
+
+    //! log version (4 or 5)
+    int M_version;
+
+    //! true if the log is gzipped
+    bool M_compressed;
+
+    //! file size of the log, used to detect the stale sidecar file
+    unsigned long long M_file_size;
+
+    //! modification time of the log, used to detect the stale sidecar file
+    long long M_file_mtime;
+
+    //! the size of the (uncompressed) data
+    unsigned long long M_data_size;
+
+    //! the head of the parameter lines (the next of the ULG header line)
+    unsigned long long M_header_begin;
+
+    //! the end of the parameter lines (the head of the first indexed line)
+    unsigned long long M_header_end;
+
+    //! indexed lines in the file order
+    std::vector< Entry > M_entries;
+
+    //! zlib access points. used only for the gzipped log.
+    GZAccessIndex M_gz_index;
+
+    //! the opened log file, kept across read() calls. used only for the plain log.
+    std::ifstream M_fin;
+
+    //! the opened log file and its inflate state. used only for the gzipped log.
+    GZAccessReader M_gz_reader;
+
+    //! parameter lines read by the first read() call
+    std::string M_header_data;
+
+    //! entry index -> playmode or team line read before the requested range
+    std::map< std::size_t, std::string > M_line_cache;
+
+    // noncopyable
+    CycleIndex( const CycleIndex & );
+    CycleIndex & operator=( const CycleIndex & );
+
+public:
+
+    /*!
+      \brief create an empty index
+     */
+    CycleIndex();
+
+    /*!
+      \brief clear all data
+     */
+    void clear();
+
+    /*!
+      \brief get the sidecar file path of the log
+      \param log_path log file path
+      \return log_path + ".idx"
+     */
+    static
+    std::string sidecar_path( const std::string & log_path );
+
+    /*!
+      \brief scan the whole log and create the index.
+      \param log_path log file path (.rcg or .rcg.gz)
+      \param span the minimum distance between the zlib access points for the gzipped log
+      \return true if the log is successfully scanned.
+     */
+    bool build( const std::string & log_path,
+                const std::size_t span = 1024 * 1024 );
+
+    /*!
+      \brief save the index
+      \param index_path output file path
+      \return true if successfully written
+     */
+    bool save( const std::string & index_path ) const;
+
+    /*!
+      \brief load the index saved by save()
+      \param log_path log file path
+      \param index_path index file path
+      \return true if the index is read and it matches the current log file.
+     */
+    bool load( const std::string & log_path,
+               const std::string & index_path );
+
+    /*!
+      \brief load the sidecar file, or build the index and save the sidecar file
+      if it does not exist or it is older than the log.
+      \param log_path log file path
+      \return true if the index is ready.
+     */
+    bool open( const std::string & log_path );
+
+    /*!
+      \brief get the indexed log file path
+      \return file path string
+     */
+    const std::string & logPath() const
+      {
+          return M_log_path;
+      }
+
+    /*!
+      \brief get the log version
+      \return log version. 0 if not ready.
+     */
+    int version() const
+      {
+          return M_version;
+      }
+
+    /*!
+      \brief check if the log is gzipped
+      \return true if gzipped
+     */
+    bool isCompressed() const
+      {
+          return M_compressed;
+      }
+
+    /*!
+      \brief get the indexed lines
+      \return const reference to the entry container
+     */
+    const std::vector< Entry > & entries() const
+      {
+          return M_entries;
+      }
+
+    /*!
+      \brief get the first cycle in the log
+      \return cycle value. -1 if empty.
+     */
+    int firstCycle() const;
+
+    /*!
+      \brief get the last cycle in the log
+      \return cycle value. -1 if empty.
+     */
+    int lastCycle() const;
+
+    /*!
+      \brief replay the lines of the cycles in [first_cycle, last_cycle].
+
+      The handler receives handleLogVersion(), the parameter lines,
+      the last playmode and team lines before the range, all lines
+      in the range, and then handleEOF().
+
+      The log file is kept open after the call, and the parameter lines and
+      the playmode and team lines before the range are cached. Reading the
+      ranges in the increasing cycle order continues the current inflate
+      stream of the gzipped log instead of decompressing from the access
+      point again.
+      \param first_cycle the first cycle of the range
+      \param last_cycle the last cycle of the range
+      \param handler reference to the rcg data handler
+      \return true if successfully parsed.
+     */
+    bool read( const int first_cycle,
+               const int last_cycle,
+               Handler & handler );
+
+private:
+
+    bool readData( const unsigned long long offset,
+                   const std::size_t len,
+                   std::string & dest );
+
+    bool readLine( const std::size_t entry_index,
+                   std::string & dest );
+
+};
+
+}
+}
+
+#endif
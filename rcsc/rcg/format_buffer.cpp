@@ -0,0 +1,484 @@
+// -*-c++-*-
+
+/*!
+  \file format_buffer.cpp
+  \brief fast number to text formatter for rcg writers Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "format_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+//! exact powers of 10 in double
+const double POW10[] = {
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+};
+
+//! powers of 10 in integer
+const unsigned long long IPOW10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+};
+
+//! the max precision handled without snprintf
+const int MAX_FAST_PRECISION = 9;
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief round the scaled value to the nearest integer.
+  \param scaled the positive value multiplied by a power of 10.
+  \param result rounded value
+  \return false if the value is too close to the half way point to be
+  rounded without the exact decimal expansion.
+*/
+inline
+bool
+round_scaled( const double scaled,
+              unsigned long long * result )
+{
+    // the product by an exact power of 10 has at most 1/2 ulp error
+    const double integral = std::floor( scaled );
+    const double frac = scaled - integral;
+    const double tolerance = scaled * 2.5e-16;
+
+    if ( std::fabs( frac - 0.5 ) <= tolerance )
+    {
+        return false;
+    }
+
+    *result = static_cast< unsigned long long >( integral ) + ( frac > 0.5 ? 1 : 0 );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief write the decimal digits of the value
+  \param dest destination
+  \param val value
+  \param min_digits the min number of digits. padded with '0'.
+  \return the number of written characters
+*/
+inline
+std::size_t
+write_digits( char * dest,
+              unsigned long long val,
+              const int min_digits )
+{
+    char tmp[24];
+    int n = 0;
+    do
+    {
+        tmp[n++] = static_cast< char >( '0' + val % 10 );
+        val /= 10;
+    }
+    while ( val != 0 );
+
+    while ( n < min_digits )
+    {
+        tmp[n++] = '0';
+    }
+
+    for ( int i = 0; i < n; ++i )
+    {
+        dest[i] = tmp[n - 1 - i];
+    }
+
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+inline
+std::size_t
+fallback_format( char * dest,
+                 const char * format,
+                 const double val,
+                 const int precision )
+{
+    const int n = std::snprintf( dest, rcsc::rcg::FormatBuffer::MAX_NUMBER_LENGTH,
+                                 format, precision, val );
+    if ( n < 0 )
+    {
+        return 0;
+    }
+
+    return std::min( static_cast< std::size_t >( n ),
+                     rcsc::rcg::FormatBuffer::MAX_NUMBER_LENGTH - 1 );
+}
+
+}
+
+namespace rcsc {
+namespace rcg {
+
+const std::size_t FormatBuffer::MAX_NUMBER_LENGTH;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer::FormatBuffer( const std::size_t capacity )
+    : M_buf( capacity ),
+      M_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::ostream &
+FormatBuffer::flush( std::ostream & os )
+{
+    if ( M_size > 0 )
+    {
+        os.write( M_buf.data(), M_size );
+        M_size = 0;
+    }
+    return os;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer &
+FormatBuffer::appendInt( const long long val )
+{
+    char * p = reserve( MAX_NUMBER_LENGTH );
+    std::size_t n = 0;
+    unsigned long long u = static_cast< unsigned long long >( val );
+    if ( val < 0 )
+    {
+        p[n++] = '-';
+        u = 0ULL - u;
+    }
+
+    n += write_digits( p + n, u, 1 );
+    M_size += n;
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer &
+FormatBuffer::appendUInt( const unsigned long long val )
+{
+    M_size += write_digits( reserve( MAX_NUMBER_LENGTH ), val, 1 );
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer &
+FormatBuffer::appendHex( const unsigned long long val,
+                         const bool showbase )
+{
+    static const char digits[] = "0123456789abcdef";
+
+    char * p = reserve( MAX_NUMBER_LENGTH );
+    std::size_t n = 0;
+    if ( showbase && val != 0 )
+    {
+        p[n++] = '0';
+        p[n++] = 'x';
+    }
+
+    char tmp[24];
+    int len = 0;
+    unsigned long long u = val;
+    do
+    {
+        tmp[len++] = digits[u & 0xf];
+        u >>= 4;
+    }
+    while ( u != 0 );
+
+    while ( len > 0 )
+    {
+        p[n++] = tmp[--len];
+    }
+
+    M_size += n;
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer &
+FormatBuffer::appendGeneral( const double val,
+                             const int precision )
+{
+    M_size += format_general( reserve( MAX_NUMBER_LENGTH ), val, precision );
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer &
+FormatBuffer::appendFixed( const double val,
+                           const int precision )
+{
+    M_size += format_fixed( reserve( MAX_NUMBER_LENGTH ), val, precision );
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer &
+FormatBuffer::appendShortest( const float val )
+{
+    char * p = reserve( MAX_NUMBER_LENGTH );
+    std::size_t n = 0;
+    for ( int precision = 1; precision <= 9; ++precision )
+    {
+        n = format_general( p, val, precision );
+        p[n] = '\0';
+        if ( ! std::isfinite( val )
+             || std::strtof( p, nullptr ) == val )
+        {
+            break;
+        }
+    }
+
+    M_size += n;
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+FormatBuffer &
+FormatBuffer::appendShortest( const double val )
+{
+    char * p = reserve( MAX_NUMBER_LENGTH );
+    std::size_t n = 0;
+    for ( int precision = 1; precision <= 17; ++precision )
+    {
+        n = format_general( p, val, precision );
+        p[n] = '\0';
+        if ( ! std::isfinite( val )
+             || std::strtod( p, nullptr ) == val )
+        {
+            break;
+        }
+    }
+
+    M_size += n;
+    return *this;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+FormatBuffer::format_general( char * dest,
+                              const double val,
+                              const int prec )
+{
+    const int precision = ( prec <= 0 ? 1 : prec );
+
+    if ( precision > MAX_FAST_PRECISION
+         || ! std::isfinite( val ) )
+    {
+        return fallback_format( dest, "%.*g", val, precision );
+    }
+
+    std::size_t n = 0;
+    if ( std::signbit( val ) )
+    {
+        dest[n++] = '-';
+    }
+
+    const double abs_val = std::fabs( val );
+    if ( abs_val == 0.0 )
+    {
+        dest[n++] = '0';
+        return n;
+    }
+
+    // the scientific notation is left to snprintf
+    if ( abs_val < 1.0e-4
+         || abs_val >= POW10[precision] )
+    {
+        return fallback_format( dest, "%.*g", val, precision );
+    }
+
+    // estimate the decimal exponent
+    int exponent = precision - 1;
+    while ( exponent >= 0 && abs_val < POW10[exponent] )
+    {
+        --exponent;
+    }
+    while ( exponent < 0 && abs_val * POW10[-exponent] < 1.0 )
+    {
+        --exponent;
+    }
+
+    unsigned long long digits = 0;
+    if ( ! round_scaled( abs_val * POW10[precision - 1 - exponent], &digits ) )
+    {
+        return fallback_format( dest, "%.*g", val, precision );
+    }
+
+    if ( digits == IPOW10[precision] )
+    {
+        // carried over to the next digit
+        digits = IPOW10[precision - 1];
+        ++exponent;
+    }
+
+    if ( digits < IPOW10[precision - 1]
+         || IPOW10[precision] <= digits
+         || exponent >= precision
+         || exponent < -4 )
+    {
+        return fallback_format( dest, "%.*g", val, precision );
+    }
+
+    char d[16];
+    write_digits( d, digits, precision );
+
+    // trailing zeros are removed in "%g"
+    int last = precision;
+    while ( last > 1 && d[last - 1] == '0' )
+    {
+        --last;
+    }
+
+    if ( exponent >= 0 )
+    {
+        for ( int i = 0; i <= exponent; ++i )
+        {
+            dest[n++] = d[i];
+        }
+
+        if ( last > exponent + 1 )
+        {
+            dest[n++] = '.';
+            for ( int i = exponent + 1; i < last; ++i )
+            {
+                dest[n++] = d[i];
+            }
+        }
+    }
+    else
+    {
+        dest[n++] = '0';
+        dest[n++] = '.';
+        for ( int i = exponent + 1; i < 0; ++i )
+        {
+            dest[n++] = '0';
+        }
+        for ( int i = 0; i < last; ++i )
+        {
+            dest[n++] = d[i];
+        }
+    }
+
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+std::size_t
+FormatBuffer::format_fixed( char * dest,
+                            const double val,
+                            const int prec )
+{
+    const int precision = ( prec < 0 ? 6 : prec );
+
+    if ( precision > MAX_FAST_PRECISION
+         || ! std::isfinite( val ) )
+    {
+        return fallback_format( dest, "%.*f", val, precision );
+    }
+
+    const double scaled = std::fabs( val ) * POW10[precision];
+    unsigned long long digits = 0;
+    if ( scaled >= 1.0e15
+         || ! round_scaled( scaled, &digits ) )
+    {
+        return fallback_format( dest, "%.*f", val, precision );
+    }
+
+    std::size_t n = 0;
+    if ( std::signbit( val ) )
+    {
+        dest[n++] = '-';
+    }
+
+    char d[24];
+    const int len = static_cast< int >( write_digits( d, digits, precision + 1 ) );
+    const int int_len = len - precision;
+
+    for ( int i = 0; i < int_len; ++i )
+    {
+        dest[n++] = d[i];
+    }
+
+    if ( precision > 0 )
+    {
+        dest[n++] = '.';
+        for ( int i = int_len; i < len; ++i )
+        {
+            dest[n++] = d[i];
+        }
+    }
+
+    return n;
+}
+
+}
+}
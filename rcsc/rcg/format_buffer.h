@@ -0,0 +1,308 @@
+// -*-c++-*-
+
+/*!
+  \file format_buffer.h
+  \brief fast number to text formatter for rcg writers Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_FORMAT_BUFFER_H
+#define RCSC_RCG_FORMAT_BUFFER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class FormatBuffer
+  \brief reusable character buffer with locale independent number formatting.
+
+  operator<< produces the same text as std::ostream with the default
+  format flags (i.e. "%.6g" for floating point values), without the
+  stream and locale overhead. The buffer keeps its capacity after
+  clear() or flush(), so a writer can reuse one instance for all lines.
+ */
+class FormatBuffer {
+public:
+
+    //! the max length of one formatted number
+    static const std::size_t MAX_NUMBER_LENGTH = 32;
+
+private:
+
+    //! formatted characters
+    std::vector< char > M_buf;
+
+    //! the length of the formatted text
+    std::size_t M_size;
+
+public:
+
+    /*!
+      \brief create an empty buffer
+      \param capacity initial capacity
+     */
+    explicit
+    FormatBuffer( const std::size_t capacity = 4096 );
+
+    /*!
+      \brief get the formatted text
+      \return pointer to the head of the text. not null terminated.
+     */
+    const char * data() const
+      {
+          return M_buf.data();
+      }
+
+    /*!
+      \brief get the length of the formatted text
+      \return the number of characters
+     */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief check if the buffer is empty
+      \return true if no character is formatted
+     */
+    bool empty() const
+      {
+          return M_size == 0;
+      }
+
+    /*!
+      \brief get the formatted text as a string
+      \return copied string
+     */
+    std::string str() const
+      {
+          return std::string( M_buf.data(), M_size );
+      }
+
+    /*!
+      \brief discard the formatted text. the capacity is kept.
+     */
+    void clear()
+      {
+          M_size = 0;
+      }
+
+    /*!
+      \brief write the formatted text to the stream, and clear the buffer.
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & flush( std::ostream & os );
+
+    /*!
+      \brief append characters
+      \param str pointer to the characters
+      \param len the number of characters
+      \return reference to itself
+     */
+    FormatBuffer & append( const char * str,
+                           const std::size_t len )
+      {
+          char * p = reserve( len );
+          std::memcpy( p, str, len );
+          M_size += len;
+          return *this;
+      }
+
+    /*!
+      \brief append a signed integer
+      \param val value
+      \return reference to itself
+     */
+    FormatBuffer & appendInt( const long long val );
+
+    /*!
+      \brief append an unsigned integer
+      \param val value
+      \return reference to itself
+     */
+    FormatBuffer & appendUInt( const unsigned long long val );
+
+    /*!
+      \brief append an unsigned integer in hexadecimal notation
+      \param val value
+      \param showbase if true, "0x" is prepended to the non zero value
+      (same as std::hex with std::showbase)
+      \return reference to itself
+     */
+    FormatBuffer & appendHex( const unsigned long long val,
+                              const bool showbase = true );
+
+    /*!
+      \brief append a floating point value with the significant digits. same as "%.*g".
+      \param val value
+      \param precision the number of significant digits
+      \return reference to itself
+     */
+    FormatBuffer & appendGeneral( const double val,
+                                  const int precision = 6 );
+
+    /*!
+      \brief append a floating point value with the fixed decimal digits. same as "%.*f".
+      \param val value
+      \param precision the number of digits after the decimal point
+      \return reference to itself
+     */
+    FormatBuffer & appendFixed( const double val,
+                                const int precision );
+
+    /*!
+      \brief append the shortest text that is read back as the same float value
+      \param val value
+      \return reference to itself
+     */
+    FormatBuffer & appendShortest( const float val );
+
+    /*!
+      \brief append the shortest text that is read back as the same double value
+      \param val value
+      \return reference to itself
+     */
+    FormatBuffer & appendShortest( const double val );
+
+    //
+    // stream like interface
+    //
+
+    FormatBuffer & operator<<( const char ch )
+      {
+          *reserve( 1 ) = ch;
+          ++M_size;
+          return *this;
+      }
+
+    FormatBuffer & operator<<( const char * str )
+      {
+          return append( str, std::strlen( str ) );
+      }
+
+    FormatBuffer & operator<<( const std::string & str )
+      {
+          return append( str.data(), str.length() );
+      }
+
+    FormatBuffer & operator<<( const bool val )
+      {
+          return *this << ( val ? '1' : '0' );
+      }
+
+    FormatBuffer & operator<<( const int val )
+      {
+          return appendInt( val );
+      }
+
+    FormatBuffer & operator<<( const long val )
+      {
+          return appendInt( val );
+      }
+
+    FormatBuffer & operator<<( const long long val )
+      {
+          return appendInt( val );
+      }
+
+    FormatBuffer & operator<<( const unsigned int val )
+      {
+          return appendUInt( val );
+      }
+
+    FormatBuffer & operator<<( const unsigned long val )
+      {
+          return appendUInt( val );
+      }
+
+    FormatBuffer & operator<<( const unsigned long long val )
+      {
+          return appendUInt( val );
+      }
+
+    FormatBuffer & operator<<( const double val )
+      {
+          return appendGeneral( val, 6 );
+      }
+
+    //
+    // raw formatters
+    //
+
+    /*!
+      \brief format a floating point value in the same way as snprintf( "%.*g" )
+      \param dest destination buffer. at least MAX_NUMBER_LENGTH characters.
+      \param val value
+      \param precision the number of significant digits
+      \return the number of written characters
+     */
+    static
+    std::size_t format_general( char * dest,
+                                const double val,
+                                const int precision );
+
+    /*!
+      \brief format a floating point value in the same way as snprintf( "%.*f" )
+      \param dest destination buffer. at least MAX_NUMBER_LENGTH characters.
+      \param val value
+      \param precision the number of digits after the decimal point
+      \return the number of written characters
+     */
+    static
+    std::size_t format_fixed( char * dest,
+                              const double val,
+                              const int precision );
+
+private:
+
+    /*!
+      \brief make enough space at the tail of the text
+      \param len the required length
+      \return pointer to the tail of the text
+     */
+    char * reserve( const std::size_t len )
+      {
+          if ( M_size + len > M_buf.size() )
+          {
+              M_buf.resize( ( M_size + len ) * 2 );
+          }
+          return M_buf.data() + M_size;
+      }
+
+};
+
+}
+}
+
+#endif
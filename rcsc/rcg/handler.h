@@ -32,6 +32,7 @@
 #ifndef RCSC_RCG_HANDLER_H
 #define RCSC_RCG_HANDLER_H
 
+#include <rcsc/rcg/projection.h>
 #include <rcsc/rcg/types.h>
 
 #include <string>
@@ -96,6 +97,20 @@ public:
           return M_log_version;
       }
 
+    /*!
+      \brief get the data required by this handler.
+      \return projection object. all data are required by default.
+
+      The parsers may skip the lines and the show fields that are not
+      included in the projection. This method is called once per parse.
+      You can override this.
+    */
+    virtual
+    Projection projection() const
+      {
+          return Projection();
+      }
+
     //
     // old version handers
     // all data are automatically converted to the intermediate format.
@@ -0,0 +1,460 @@
+// -*-c++-*-
+
+/*!
+  \file match_stats.cpp
+  \brief streaming match statistics handler Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "match_stats.h"
+
+#include <iostream>
+#include <cmath>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the increment of the command counter
+  \param prev the counter in the previous show
+  \param cur the counter in the current show
+  \return the increment. 0 if the counter is not available.
+ */
+inline
+int
+count_diff( const UInt16 prev,
+            const UInt16 cur )
+{
+    if ( prev == 0xFFFF
+         || cur == 0xFFFF
+         || cur < prev )
+    {
+        return 0;
+    }
+
+    return cur - prev;
+}
+
+}
+
+const double MatchStats::TELEPORT_DIST = 3.0;
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MatchStats::PlayerStats::add( const PlayerStats & other )
+{
+    games_ += other.games_;
+    cycles_ += other.cycles_;
+    distance_ += other.distance_;
+    kicks_ += other.kicks_;
+    dashes_ += other.dashes_;
+    tackles_ += other.tackles_;
+    catches_ += other.catches_;
+    passes_ += other.passes_;
+    lost_ += other.lost_;
+
+    if ( stamina_sum_.size() < other.stamina_sum_.size() )
+    {
+        stamina_sum_.resize( other.stamina_sum_.size(), 0.0 );
+        stamina_count_.resize( other.stamina_count_.size(), 0 );
+    }
+
+    for ( std::size_t i = 0; i < other.stamina_sum_.size(); ++i )
+    {
+        stamina_sum_[i] += other.stamina_sum_[i];
+        stamina_count_[i] += other.stamina_count_[i];
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MatchStats::TeamStats::add( const TeamStats & other )
+{
+    games_ += other.games_;
+    goals_ += other.goals_;
+    goals_against_ += other.goals_against_;
+    possession_ += other.possession_;
+    contested_ += other.contested_;
+
+    for ( int i = 0; i < MAX_PLAYER; ++i )
+    {
+        players_[i].add( other.players_[i] );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+MatchStats::MatchStats( const int stamina_interval )
+    : M_stamina_interval( stamina_interval < 1 ? 1 : stamina_interval ),
+      M_games( 0 )
+{
+    clearMatch();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MatchStats::clearMatch()
+{
+    M_playmode = PM_BeforeKickOff;
+    M_team_info[0] = M_team_info[1] = TeamT();
+    M_current[0] = M_current[1] = TeamStats();
+    M_has_prev = false;
+    M_last_kicker = -1;
+    M_owner = -1;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::merge( const MatchStats & other )
+{
+    if ( other.M_stamina_interval != M_stamina_interval )
+    {
+        std::cerr << "(MatchStats::merge) stamina interval mismatch "
+                  << M_stamina_interval << " != " << other.M_stamina_interval
+                  << std::endl;
+        return false;
+    }
+
+    M_games += other.M_games;
+
+    for ( TeamMap::const_iterator it = other.M_teams.begin(), end = other.M_teams.end();
+          it != end;
+          ++it )
+    {
+        M_teams[it->first].add( it->second );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Projection
+MatchStats::projection() const
+{
+    return Projection( Projection::SHOW_LINE
+                       | Projection::PLAYMODE_LINE
+                       | Projection::TEAM_LINE,
+                       Projection::PLAYER_STATE
+                       | Projection::PLAYER_POS
+                       | Projection::PLAYER_STAMINA
+                       | Projection::PLAYER_COUNT );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handleShow( const ShowInfoT & show )
+{
+    const bool new_cycle = ( ! M_has_prev || show.time_ != M_prev.time_ );
+    const bool play_on = ( M_playmode == PM_PlayOn );
+    const std::size_t curve_index = show.time_ / M_stamina_interval;
+
+    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+    {
+        const PlayerT & p = show.player_[i];
+        if ( ! p.isAlive() )
+        {
+            continue;
+        }
+
+        PlayerStats & s = M_current[i / MAX_PLAYER].players_[i % MAX_PLAYER];
+        s.games_ = 1;
+
+        if ( new_cycle )
+        {
+            if ( play_on )
+            {
+                ++s.cycles_;
+            }
+
+            if ( p.hasStamina() )
+            {
+                if ( s.stamina_sum_.size() <= curve_index )
+                {
+                    s.stamina_sum_.resize( curve_index + 1, 0.0 );
+                    s.stamina_count_.resize( curve_index + 1, 0 );
+                }
+                s.stamina_sum_[curve_index] += p.stamina_;
+                s.stamina_count_[curve_index] += 1;
+            }
+        }
+
+        if ( ! M_has_prev )
+        {
+            continue;
+        }
+
+        const PlayerT & o = M_prev.player_[i];
+        if ( ! o.isAlive() )
+        {
+            continue;
+        }
+
+        s.kicks_ += count_diff( o.kick_count_, p.kick_count_ );
+        s.dashes_ += count_diff( o.dash_count_, p.dash_count_ );
+        s.tackles_ += count_diff( o.tackle_count_, p.tackle_count_ );
+        s.catches_ += count_diff( o.catch_count_, p.catch_count_ );
+
+        if ( count_diff( o.move_count_, p.move_count_ ) == 0 )
+        {
+            const double dist = std::sqrt( std::pow( p.x_ - o.x_, 2 )
+                                           + std::pow( p.y_ - o.y_, 2 ) );
+            if ( dist < TELEPORT_DIST )
+            {
+                s.distance_ += dist;
+            }
+        }
+    }
+
+    if ( M_has_prev )
+    {
+        updateBall( show );
+    }
+
+    if ( new_cycle
+         && play_on
+         && M_owner >= 0 )
+    {
+        ++M_current[M_owner].possession_;
+        ++M_current[0].contested_;
+        ++M_current[1].contested_;
+    }
+
+    M_prev = show;
+    M_has_prev = true;
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+MatchStats::updateBall( const ShowInfoT & show )
+{
+    int kicker = -1;
+    int sides = 0;
+
+    for ( int i = 0; i < MAX_PLAYER * 2; ++i )
+    {
+        const PlayerT & p = show.player_[i];
+        const PlayerT & o = M_prev.player_[i];
+        if ( ! p.isAlive()
+             || ! o.isAlive() )
+        {
+            continue;
+        }
+
+        if ( count_diff( o.kick_count_, p.kick_count_ ) > 0
+             || count_diff( o.catch_count_, p.catch_count_ ) > 0 )
+        {
+            sides |= ( 1 << ( i / MAX_PLAYER ) );
+            if ( kicker < 0 )
+            {
+                kicker = i;
+            }
+        }
+    }
+
+    if ( sides == 0 )
+    {
+        return;
+    }
+
+    if ( sides == 3 )
+    {
+        // both teams kicked the ball in the same cycle
+        M_last_kicker = -1;
+        M_owner = -1;
+        return;
+    }
+
+    if ( M_playmode == PM_PlayOn
+         && M_last_kicker >= 0
+         && M_last_kicker != kicker )
+    {
+        PlayerStats & last = M_current[M_last_kicker / MAX_PLAYER].players_[M_last_kicker % MAX_PLAYER];
+        if ( M_last_kicker / MAX_PLAYER == kicker / MAX_PLAYER )
+        {
+            ++last.passes_;
+        }
+        else
+        {
+            ++last.lost_;
+        }
+    }
+
+    M_last_kicker = kicker;
+    M_owner = kicker / MAX_PLAYER;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handleMsg( const int,
+                       const int,
+                       const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handleDraw( const int,
+                        const drawinfo_t & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handlePlayMode( const int,
+                            const PlayMode pm )
+{
+    if ( pm != PM_PlayOn )
+    {
+        // the restart kick does not continue the previous pass
+        M_last_kicker = -1;
+        M_owner = -1;
+    }
+
+    M_playmode = pm;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handleTeam( const int,
+                        const TeamT & team_l,
+                        const TeamT & team_r )
+{
+    M_team_info[0] = team_l;
+    M_team_info[1] = team_r;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handleServerParam( const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handlePlayerParam( const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handlePlayerType( const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+MatchStats::handleEOF()
+{
+    if ( M_has_prev )
+    {
+        for ( int side = 0; side < 2; ++side )
+        {
+            TeamStats & t = M_current[side];
+            t.games_ = 1;
+            t.goals_ = M_team_info[side].score_;
+            t.goals_against_ = M_team_info[1 - side].score_;
+
+            std::string name = M_team_info[side].name_;
+            if ( name.empty() )
+            {
+                name = ( side == 0 ? "(left)" : "(right)" );
+            }
+
+            M_teams[TeamKey( name, ( side == 0 ? LEFT : RIGHT ) )].add( t );
+        }
+
+        ++M_games;
+    }
+
+    clearMatch();
+    return true;
+}
+
+}
+}
@@ -0,0 +1,304 @@
+// -*-c++-*-
+
+/*!
+  \file match_stats.h
+  \brief streaming match statistics handler Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_MATCH_STATS_H
+#define RCSC_RCG_MATCH_STATS_H
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/types.h>
+
+#include <map>
+#include <vector>
+#include <string>
+#include <utility>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class MatchStats
+  \brief rcg handler that aggregates the per team and per player statistics.
+
+  The statistics are computed in a single pass over the show data. The
+  command counts are taken from the counters in PlayerT, so that the
+  events are not re-derived from the positions. Logs without the
+  counters (older than v4) have no kick, dash, tackle and pass counts.
+
+  - distance: the sum of the position changes between the shows. The
+    changes caused by the move command or by the referee (a change larger
+    than TELEPORT_DIST) are not counted.
+  - possession: the number of play_on cycles after the last kick (or
+    catch) by the team. The cycles in which both teams kick the ball
+    are not owned by any team.
+  - pass: a kick followed by the next kick of a teammate in play_on.
+  - stamina curve: the mean stamina of each player for every stamina
+    interval cycles.
+
+  The statistics of a match are added to the team entries when the end
+  of the log is handled, so that the same instance can handle several
+  logs in sequence. The teams are identified by their name and their
+  side, so the both sides of a self-play log are not merged into one
+  entry. The results of the instances created for other logs can be
+  added by merge().
+ */
+class MatchStats
+    : public Handler {
+public:
+
+    //! the position change regarded as a teleport
+    static const double TELEPORT_DIST;
+
+    /*!
+      \struct PlayerStats
+      \brief the aggregated statistics of a player
+     */
+    struct PlayerStats {
+        int games_; //!< the number of the matches in which the player appeared
+        int cycles_; //!< the number of play_on cycles
+        double distance_; //!< covered distance
+        int kicks_; //!< the number of the kick commands
+        int dashes_; //!< the number of the dash commands
+        int tackles_; //!< the number of the tackle commands
+        int catches_; //!< the number of the catch commands
+        int passes_; //!< the number of the completed passes
+        int lost_; //!< the number of the kicks followed by an opponent kick
+        std::vector< double > stamina_sum_; //!< stamina sum for each interval
+        std::vector< int > stamina_count_; //!< sample count for each interval
+
+        /*!
+          \brief initialize all variables by 0
+         */
+        PlayerStats()
+            : games_( 0 ),
+              cycles_( 0 ),
+              distance_( 0.0 ),
+              kicks_( 0 ),
+              dashes_( 0 ),
+              tackles_( 0 ),
+              catches_( 0 ),
+              passes_( 0 ),
+              lost_( 0 )
+          { }
+
+        /*!
+          \brief add other statistics
+          \param other added statistics
+         */
+        void add( const PlayerStats & other );
+    };
+
+    /*!
+      \struct TeamStats
+      \brief the aggregated statistics of a team
+     */
+    struct TeamStats {
+        int games_; //!< the number of the matches
+        int goals_; //!< the total score
+        int goals_against_; //!< the total score of the opponents
+        int possession_; //!< the number of the owned play_on cycles
+        int contested_; //!< the number of the play_on cycles owned by either team
+        PlayerStats players_[MAX_PLAYER]; //!< player statistics by uniform number
+
+        /*!
+          \brief initialize all variables by 0
+         */
+        TeamStats()
+            : games_( 0 ),
+              goals_( 0 ),
+              goals_against_( 0 ),
+              possession_( 0 ),
+              contested_( 0 )
+          { }
+
+        /*!
+          \brief add other statistics
+          \param other added statistics
+         */
+        void add( const TeamStats & other );
+
+        /*!
+          \brief get the possession share
+          \return the rate of the owned cycles in [0, 1]. 0 if unknown.
+         */
+        double possessionShare() const
+          {
+              return ( contested_ > 0
+                       ? static_cast< double >( possession_ ) / contested_
+                       : 0.0 );
+          }
+    };
+
+    //! team name and side
+    typedef std::pair< std::string, SideID > TeamKey;
+
+    //! team name and side to team statistics
+    typedef std::map< TeamKey, TeamStats > TeamMap;
+
+private:
+
+    //! the number of cycles for each stamina curve point
+    int M_stamina_interval;
+
+    //! the number of the handled matches
+    int M_games;
+
+    //! aggregated statistics
+    TeamMap M_teams;
+
+    //
+    // the state of the current match
+    //
+
+    //! current playmode
+    PlayMode M_playmode;
+
+    //! last team info
+    TeamT M_team_info[2];
+
+    //! the statistics of the current match. 0: left, 1: right
+    TeamStats M_current[2];
+
+    //! true if M_prev is available
+    bool M_has_prev;
+
+    //! the last show
+    ShowInfoT M_prev;
+
+    //! the player index of the last kicker. -1 if unknown.
+    int M_last_kicker;
+
+    //! the side index of the ball owner. -1 if unknown.
+    int M_owner;
+
+    // noncopyable
+    MatchStats( const MatchStats & );
+    MatchStats & operator=( const MatchStats & );
+
+public:
+
+    /*!
+      \brief initialize member variables
+      \param stamina_interval the number of cycles for each stamina curve point
+     */
+    explicit
+    MatchStats( const int stamina_interval = 300 );
+
+    /*!
+      \brief get the number of cycles for each stamina curve point
+      \return the number of cycles
+     */
+    int staminaInterval() const
+      {
+          return M_stamina_interval;
+      }
+
+    /*!
+      \brief get the number of the handled matches
+      \return the number of matches
+     */
+    int games() const
+      {
+          return M_games;
+      }
+
+    /*!
+      \brief get the aggregated statistics
+      \return const reference to the team map
+     */
+    const TeamMap & teams() const
+      {
+          return M_teams;
+      }
+
+    /*!
+      \brief add the statistics aggregated by other instance.
+      \param other other instance. the stamina interval must be same.
+      \return true if merged
+     */
+    bool merge( const MatchStats & other );
+
+    /*!
+      \brief get the required data
+      \return the show, playmode and team lines with the player fields
+      used for the statistics
+     */
+    virtual
+    Projection projection() const override;
+
+    virtual
+    bool handleShow( const ShowInfoT & show ) override;
+
+    virtual
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg ) override;
+
+    virtual
+    bool handleDraw( const int time,
+                     const drawinfo_t & draw ) override;
+
+    virtual
+    bool handlePlayMode( const int time,
+                         const PlayMode pm ) override;
+
+    virtual
+    bool handleTeam( const int time,
+                     const TeamT & team_l,
+                     const TeamT & team_r ) override;
+
+    virtual
+    bool handleServerParam( const std::string & msg ) override;
+
+    virtual
+    bool handlePlayerParam( const std::string & msg ) override;
+
+    virtual
+    bool handlePlayerType( const std::string & msg ) override;
+
+    /*!
+      \brief add the statistics of the current match to the team entries
+      \return always true
+     */
+    virtual
+    bool handleEOF() override;
+
+private:
+
+    void clearMatch();
+
+    void updateBall( const ShowInfoT & show );
+
+};
+
+}
+}
+
+#endif
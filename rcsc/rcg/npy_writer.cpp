@@ -0,0 +1,614 @@
+// -*-c++-*-
+
+/*!
+  \file npy_writer.cpp
+  \brief columnar NumPy .npy writer for the show data Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "npy_writer.h"
+
+#include <rcsc/types.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! the number of players in ShowInfoT
+const std::size_t PLAYER_WIDTH = MAX_PLAYER * 2;
+
+//! the size of the .npy header including the magic string. multiple of 64.
+const std::size_t NPY_HEADER_SIZE = 128;
+
+//! the size of the output buffer of each column
+const std::size_t BUFFER_SIZE = 64 * 1024;
+
+/*!
+  \brief column definition
+ */
+struct ColumnDef {
+    const char * name_; //!< file name without the extension
+    char kind_; //!< numpy type kind. 'i', 'u' or 'f'
+    std::size_t item_size_; //!< byte size of a value
+    std::size_t width_; //!< the number of values in a row
+};
+
+//! column definitions in the order of NpyWriter::ColumnID
+const ColumnDef COLUMN_DEFS[] = {
+    { "cycle", 'i', 4, 1 },
+    { "stopped", 'i', 4, 1 },
+    { "playmode", 'i', 1, 1 },
+    { "l_score", 'u', 2, 1 },
+    { "l_pen_score", 'u', 2, 1 },
+    { "r_score", 'u', 2, 1 },
+    { "r_pen_score", 'u', 2, 1 },
+    { "ball_x", 'f', 4, 1 },
+    { "ball_y", 'f', 4, 1 },
+    { "ball_vx", 'f', 4, 1 },
+    { "ball_vy", 'f', 4, 1 },
+    { "player_unum", 'i', 2, PLAYER_WIDTH },
+    { "player_type", 'i', 2, PLAYER_WIDTH },
+    { "player_state", 'i', 4, PLAYER_WIDTH },
+    { "player_x", 'f', 4, PLAYER_WIDTH },
+    { "player_y", 'f', 4, PLAYER_WIDTH },
+    { "player_vx", 'f', 4, PLAYER_WIDTH },
+    { "player_vy", 'f', 4, PLAYER_WIDTH },
+    { "player_body", 'f', 4, PLAYER_WIDTH },
+    { "player_neck", 'f', 4, PLAYER_WIDTH },
+    { "player_point_x", 'f', 4, PLAYER_WIDTH },
+    { "player_point_y", 'f', 4, PLAYER_WIDTH },
+    { "player_view_quality", 'i', 1, PLAYER_WIDTH },
+    { "player_view_width", 'f', 4, PLAYER_WIDTH },
+    { "player_stamina", 'f', 4, PLAYER_WIDTH },
+    { "player_effort", 'f', 4, PLAYER_WIDTH },
+    { "player_recovery", 'f', 4, PLAYER_WIDTH },
+    { "player_stamina_capacity", 'f', 4, PLAYER_WIDTH },
+    { "player_focus_side", 'i', 1, PLAYER_WIDTH },
+    { "player_focus_unum", 'i', 2, PLAYER_WIDTH },
+    { "player_kick_count", 'u', 2, PLAYER_WIDTH },
+    { "player_dash_count", 'u', 2, PLAYER_WIDTH },
+    { "player_turn_count", 'u', 2, PLAYER_WIDTH },
+    { "player_catch_count", 'u', 2, PLAYER_WIDTH },
+    { "player_move_count", 'u', 2, PLAYER_WIDTH },
+    { "player_turn_neck_count", 'u', 2, PLAYER_WIDTH },
+    { "player_change_view_count", 'u', 2, PLAYER_WIDTH },
+    { "player_say_count", 'u', 2, PLAYER_WIDTH },
+    { "player_tackle_count", 'u', 2, PLAYER_WIDTH },
+    { "player_pointto_count", 'u', 2, PLAYER_WIDTH },
+    { "player_attentionto_count", 'u', 2, PLAYER_WIDTH },
+};
+
+static_assert( sizeof( COLUMN_DEFS ) / sizeof( COLUMN_DEFS[0] ) == NpyWriter::MAX_COLUMN,
+               "COLUMN_DEFS does not match NpyWriter::ColumnID" );
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the numpy type descriptor of the column, e.g. "<f4".
+ */
+std::string
+type_descr( const ColumnDef & def )
+{
+    const unsigned short one = 1;
+    const bool little_endian = ( *reinterpret_cast< const unsigned char * >( &one ) == 1 );
+
+    std::string descr;
+    descr += ( def.item_size_ == 1 ? '|' : little_endian ? '<' : '>' );
+    descr += def.kind_;
+    descr += static_cast< char >( '0' + def.item_size_ );
+    return descr;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the shape string of the column, e.g. "(6000, 22)".
+ */
+std::string
+shape_string( const ColumnDef & def,
+              const std::size_t rows )
+{
+    std::ostringstream os;
+    os << '(' << rows << ',';
+    if ( def.width_ > 1 )
+    {
+        os << ' ' << def.width_;
+    }
+    os << ')';
+    return os.str();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the .npy format version 1.0 header with the fixed size.
+ */
+std::string
+npy_header( const ColumnDef & def,
+            const std::size_t rows )
+{
+    std::string dict = "{'descr': '";
+    dict += type_descr( def );
+    dict += "', 'fortran_order': False, 'shape': ";
+    dict += shape_string( def, rows );
+    dict += ", }";
+
+    const std::size_t prefix_size = 10; // magic(6) + version(2) + header_len(2)
+    const std::size_t header_len = NPY_HEADER_SIZE - prefix_size;
+
+    std::string header( "\x93NUMPY\x01\x00", 8 );
+    header += static_cast< char >( header_len & 0xff );
+    header += static_cast< char >( ( header_len >> 8 ) & 0xff );
+    header += dict;
+    header.resize( NPY_HEADER_SIZE - 1, ' ' );
+    header += '\n';
+    return header;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief escape the string for JSON. control characters are printed as \\u00XX.
+ */
+std::string
+json_string( const std::string & str )
+{
+    std::string result = "\"";
+    for ( char c : str )
+    {
+        if ( c == '"' || c == '\\' )
+        {
+            result += '\\';
+        }
+        else if ( static_cast< unsigned char >( c ) < 0x20 )
+        {
+            char buf[8];
+            std::snprintf( buf, sizeof( buf ), "\\u%04x", static_cast< unsigned char >( c ) );
+            result += buf;
+            continue;
+        }
+        result += c;
+    }
+    result += '"';
+    return result;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \class NpyWriter::Column
+  \brief output file of one column with the write buffer.
+ */
+class NpyWriter::Column {
+private:
+    const ColumnDef & M_def;
+    std::ofstream M_fout;
+    std::vector< char > M_buffer;
+
+public:
+
+    explicit
+    Column( const ColumnDef & def )
+        : M_def( def )
+      {
+          M_buffer.reserve( BUFFER_SIZE );
+      }
+
+    bool open( const std::string & path )
+      {
+          M_fout.open( path.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc );
+          if ( ! M_fout.is_open() )
+          {
+              return false;
+          }
+
+          const std::string header = npy_header( M_def, 0 );
+          M_fout.write( header.data(), header.size() );
+          return M_fout.good();
+      }
+
+    template < typename T >
+    void put( const T value )
+      {
+          static_assert( sizeof( T ) == 1 || sizeof( T ) == 2 || sizeof( T ) == 4,
+                         "unsupported value size" );
+
+          const char * p = reinterpret_cast< const char * >( &value );
+          M_buffer.insert( M_buffer.end(), p, p + sizeof( T ) );
+      }
+
+    void endRow()
+      {
+          if ( M_buffer.size() >= BUFFER_SIZE - 256 )
+          {
+              flush();
+          }
+      }
+
+    void flush()
+      {
+          if ( ! M_buffer.empty() )
+          {
+              M_fout.write( M_buffer.data(), M_buffer.size() );
+              M_buffer.clear();
+          }
+      }
+
+    bool close( const std::size_t rows )
+      {
+          flush();
+
+          const std::string header = npy_header( M_def, rows );
+          M_fout.seekp( 0 );
+          M_fout.write( header.data(), header.size() );
+          M_fout.close();
+          return ! M_fout.fail();
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+NpyWriter::NpyWriter()
+    : M_rows( 0 ),
+      M_cycle( -1 ),
+      M_stopped( 0 ),
+      M_playmode( PM_Null )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+NpyWriter::~NpyWriter()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+const char *
+NpyWriter::column_name( const ColumnID id )
+{
+    if ( id < 0 || MAX_COLUMN <= id )
+    {
+        return "";
+    }
+
+    return COLUMN_DEFS[id].name_;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::open( const std::string & dirpath )
+{
+    close();
+
+    if ( ::mkdir( dirpath.c_str(), 0755 ) != 0
+         && errno != EEXIST )
+    {
+        std::cerr << "(NpyWriter::open) could not create the directory ["
+                  << dirpath << "] " << std::strerror( errno ) << std::endl;
+        return false;
+    }
+
+    M_dirpath = dirpath;
+    if ( ! M_dirpath.empty()
+         && *M_dirpath.rbegin() != '/' )
+    {
+        M_dirpath += '/';
+    }
+
+    M_rows = 0;
+    M_cycle = -1;
+    M_stopped = 0;
+    M_playmode = PM_Null;
+    M_teams[0] = TeamT();
+    M_teams[1] = TeamT();
+
+    for ( const ColumnDef & def : COLUMN_DEFS )
+    {
+        std::unique_ptr< Column > col( new Column( def ) );
+        const std::string path = M_dirpath + def.name_ + ".npy";
+        if ( ! col->open( path ) )
+        {
+            std::cerr << "(NpyWriter::open) could not open the file ["
+                      << path << ']' << std::endl;
+            M_columns.clear();
+            return false;
+        }
+        M_columns.push_back( std::move( col ) );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::close()
+{
+    if ( M_columns.empty() )
+    {
+        return true;
+    }
+
+    bool result = true;
+    for ( std::unique_ptr< Column > & col : M_columns )
+    {
+        result = col->close( M_rows ) && result;
+    }
+    M_columns.clear();
+
+    if ( ! writeSchema() )
+    {
+        result = false;
+    }
+
+    if ( ! result )
+    {
+        std::cerr << "(NpyWriter::close) failed to write the files in ["
+                  << M_dirpath << ']' << std::endl;
+    }
+
+    return result;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::writeSchema() const
+{
+    const std::string path = M_dirpath + "schema.json";
+    std::ofstream fout( path.c_str() );
+    if ( ! fout.is_open() )
+    {
+        return false;
+    }
+
+    fout << "{\n"
+         << "  \"format\": \"npy\",\n"
+         << "  \"rows\": " << M_rows << ",\n"
+         << "  \"l_name\": " << json_string( M_teams[0].name_ ) << ",\n"
+         << "  \"r_name\": " << json_string( M_teams[1].name_ ) << ",\n"
+         << "  \"columns\": [\n";
+
+    const std::size_t n = sizeof( COLUMN_DEFS ) / sizeof( COLUMN_DEFS[0] );
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        const ColumnDef & def = COLUMN_DEFS[i];
+        fout << "    { \"name\": \"" << def.name_ << "\""
+             << ", \"file\": \"" << def.name_ << ".npy\""
+             << ", \"dtype\": \"" << type_descr( def ) << "\""
+             << ", \"shape\": [" << M_rows;
+        if ( def.width_ > 1 )
+        {
+            fout << ", " << def.width_;
+        }
+        fout << "] }" << ( i + 1 < n ? ",\n" : "\n" );
+    }
+
+    fout << "  ]\n"
+         << "}\n";
+
+    fout.close();
+    return ! fout.fail();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handleShow( const ShowInfoT & show )
+{
+    if ( M_columns.empty() )
+    {
+        return false;
+    }
+
+    if ( M_cycle == static_cast< int >( show.time_ ) )
+    {
+        ++M_stopped;
+    }
+    else
+    {
+        M_cycle = show.time_;
+        M_stopped = 0;
+    }
+
+    const std::vector< std::unique_ptr< Column > > & c = M_columns;
+
+    c[CYCLE]->put( static_cast< Int32 >( M_cycle ) );
+    c[STOPPED]->put( static_cast< Int32 >( M_stopped ) );
+    c[PLAYMODE]->put( static_cast< char >( M_playmode ) );
+    c[L_SCORE]->put( M_teams[0].score_ );
+    c[L_PEN_SCORE]->put( M_teams[0].pen_score_ );
+    c[R_SCORE]->put( M_teams[1].score_ );
+    c[R_PEN_SCORE]->put( M_teams[1].pen_score_ );
+    c[BALL_X]->put( show.ball_.x_ );
+    c[BALL_Y]->put( show.ball_.y_ );
+    c[BALL_VX]->put( show.ball_.vx_ );
+    c[BALL_VY]->put( show.ball_.vy_ );
+
+    for ( const PlayerT & p : show.player_ )
+    {
+        c[PLAYER_UNUM]->put( p.unum_ );
+        c[PLAYER_TYPE]->put( p.type_ );
+        c[PLAYER_STATE]->put( p.state_ );
+        c[PLAYER_X]->put( p.x_ );
+        c[PLAYER_Y]->put( p.y_ );
+        c[PLAYER_VX]->put( p.vx_ );
+        c[PLAYER_VY]->put( p.vy_ );
+        c[PLAYER_BODY]->put( p.body_ );
+        c[PLAYER_NECK]->put( p.neck_ );
+        c[PLAYER_POINT_X]->put( p.point_x_ );
+        c[PLAYER_POINT_Y]->put( p.point_y_ );
+        c[PLAYER_VIEW_QUALITY]->put( p.view_quality_ );
+        c[PLAYER_VIEW_WIDTH]->put( p.view_width_ );
+        c[PLAYER_STAMINA]->put( p.stamina_ );
+        c[PLAYER_EFFORT]->put( p.effort_ );
+        c[PLAYER_RECOVERY]->put( p.recovery_ );
+        c[PLAYER_STAMINA_CAPACITY]->put( p.stamina_capacity_ );
+        c[PLAYER_FOCUS_SIDE]->put( p.focus_side_ );
+        c[PLAYER_FOCUS_UNUM]->put( p.focus_unum_ );
+        c[PLAYER_KICK_COUNT]->put( p.kick_count_ );
+        c[PLAYER_DASH_COUNT]->put( p.dash_count_ );
+        c[PLAYER_TURN_COUNT]->put( p.turn_count_ );
+        c[PLAYER_CATCH_COUNT]->put( p.catch_count_ );
+        c[PLAYER_MOVE_COUNT]->put( p.move_count_ );
+        c[PLAYER_TURN_NECK_COUNT]->put( p.turn_neck_count_ );
+        c[PLAYER_CHANGE_VIEW_COUNT]->put( p.change_view_count_ );
+        c[PLAYER_SAY_COUNT]->put( p.say_count_ );
+        c[PLAYER_TACKLE_COUNT]->put( p.tackle_count_ );
+        c[PLAYER_POINTTO_COUNT]->put( p.pointto_count_ );
+        c[PLAYER_ATTENTIONTO_COUNT]->put( p.attentionto_count_ );
+    }
+
+    for ( std::unique_ptr< Column > & col : M_columns )
+    {
+        col->endRow();
+    }
+
+    ++M_rows;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handleMsg( const int,
+                      const int,
+                      const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handleDraw( const int,
+                       const drawinfo_t & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handlePlayMode( const int,
+                           const PlayMode pm )
+{
+    M_playmode = pm;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handleTeam( const int,
+                       const TeamT & team_l,
+                       const TeamT & team_r )
+{
+    M_teams[0] = team_l;
+    M_teams[1] = team_r;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handleServerParam( const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handlePlayerParam( const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handlePlayerType( const std::string & )
+{
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+NpyWriter::handleEOF()
+{
+    return close();
+}
+
+}
+}
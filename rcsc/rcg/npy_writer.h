@@ -0,0 +1,242 @@
+// -*-c++-*-
+
+/*!
+  \file npy_writer.h
+  \brief columnar NumPy .npy writer for the show data Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_NPY_WRITER_H
+#define RCSC_RCG_NPY_WRITER_H
+
+#include <rcsc/rcg/handler.h>
+#include <rcsc/rcg/types.h>
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class NpyWriter
+  \brief rcg handler that writes the show data in a columnar binary layout.
+
+  Every field is written into its own NumPy .npy (format version 1.0) file
+  in the output directory, one row per show. Ball and game state fields
+  are 1-D arrays (e.g. ball_x.npy), and player fields are 2-D arrays with
+  the shape (rows, 22) (e.g. player_x.npy), where the column index is
+  the player index of ShowInfoT::player_ (0-10: left, 11-21: right).
+
+  The values are stored as they are in ShowInfoT. Disconnected or
+  discarded players are not masked, use player_state / player_unum.
+  The row count in each file header is fixed when the writer is closed.
+  In addition, schema.json describes the row count, the team names and
+  the dtype and shape of all columns.
+
+  The files can be loaded without parsing by numpy.load( path, mmap_mode='r' ).
+ */
+class NpyWriter
+    : public Handler {
+public:
+
+    /*!
+      \brief column identifiers. the order is same as the schema.
+     */
+    enum ColumnID {
+        CYCLE,
+        STOPPED,
+        PLAYMODE,
+        L_SCORE,
+        L_PEN_SCORE,
+        R_SCORE,
+        R_PEN_SCORE,
+        BALL_X,
+        BALL_Y,
+        BALL_VX,
+        BALL_VY,
+        PLAYER_UNUM,
+        PLAYER_TYPE,
+        PLAYER_STATE,
+        PLAYER_X,
+        PLAYER_Y,
+        PLAYER_VX,
+        PLAYER_VY,
+        PLAYER_BODY,
+        PLAYER_NECK,
+        PLAYER_POINT_X,
+        PLAYER_POINT_Y,
+        PLAYER_VIEW_QUALITY,
+        PLAYER_VIEW_WIDTH,
+        PLAYER_STAMINA,
+        PLAYER_EFFORT,
+        PLAYER_RECOVERY,
+        PLAYER_STAMINA_CAPACITY,
+        PLAYER_FOCUS_SIDE,
+        PLAYER_FOCUS_UNUM,
+        PLAYER_KICK_COUNT,
+        PLAYER_DASH_COUNT,
+        PLAYER_TURN_COUNT,
+        PLAYER_CATCH_COUNT,
+        PLAYER_MOVE_COUNT,
+        PLAYER_TURN_NECK_COUNT,
+        PLAYER_CHANGE_VIEW_COUNT,
+        PLAYER_SAY_COUNT,
+        PLAYER_TACKLE_COUNT,
+        PLAYER_POINTTO_COUNT,
+        PLAYER_ATTENTIONTO_COUNT,
+        MAX_COLUMN
+    };
+
+private:
+
+    class Column;
+
+    //! output directory path
+    std::string M_dirpath;
+
+    //! column files. empty if not opened.
+    std::vector< std::unique_ptr< Column > > M_columns;
+
+    //! the number of written rows
+    std::size_t M_rows;
+
+    //! the last cycle
+    int M_cycle;
+
+    //! the number of shows in the same cycle
+    int M_stopped;
+
+    //! the last playmode
+    PlayMode M_playmode;
+
+    //! the last team info
+    TeamT M_teams[2];
+
+    // noncopyable
+    NpyWriter( const NpyWriter & );
+    NpyWriter & operator=( const NpyWriter & );
+
+public:
+
+    /*!
+      \brief initialize member variables. no file is opened.
+     */
+    NpyWriter();
+
+    /*!
+      \brief close the files if opened
+     */
+    ~NpyWriter();
+
+    /*!
+      \brief create the output directory if needed and open all column files.
+      \param dirpath output directory path
+      \return true if all files are opened.
+     */
+    bool open( const std::string & dirpath );
+
+    /*!
+      \brief write the final row count to the file headers and close the files.
+      \return true if all files are written successfully.
+     */
+    bool close();
+
+    /*!
+      \brief check if the files are opened.
+      \return true if opened.
+     */
+    bool isOpen() const
+      {
+          return ! M_columns.empty();
+      }
+
+    /*!
+      \brief get the number of written rows.
+      \return the number of rows
+     */
+    std::size_t rows() const
+      {
+          return M_rows;
+      }
+
+    /*!
+      \brief get the file name without the extension of the column.
+      \param id column id
+      \return column name string
+     */
+    static
+    const char * column_name( const ColumnID id );
+
+    virtual
+    bool handleShow( const ShowInfoT & show ) override;
+
+    virtual
+    bool handleMsg( const int time,
+                    const int board,
+                    const std::string & msg ) override;
+
+    virtual
+    bool handleDraw( const int time,
+                     const drawinfo_t & draw ) override;
+
+    virtual
+    bool handlePlayMode( const int time,
+                         const PlayMode pm ) override;
+
+    virtual
+    bool handleTeam( const int time,
+                     const TeamT & team_l,
+                     const TeamT & team_r ) override;
+
+    virtual
+    bool handleServerParam( const std::string & msg ) override;
+
+    virtual
+    bool handlePlayerParam( const std::string & msg ) override;
+
+    virtual
+    bool handlePlayerType( const std::string & msg ) override;
+
+    /*!
+      \brief close the files.
+      \return result of close()
+     */
+    virtual
+    bool handleEOF() override;
+
+private:
+
+    bool writeSchema() const;
+
+};
+
+}
+}
+
+#endif
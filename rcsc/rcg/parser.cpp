@@ -42,6 +42,7 @@
 #include "parser_v3.h"
 #include "parser_v4.h"
 #include "parser_v5.h"
+#include "parser_v6.h"
 
 namespace rcsc {
 namespace rcg {
@@ -89,6 +90,7 @@ Parser::create( std::istream & is )
     {
         ptr = creator();
     }
+    else if ( version == static_cast< int >( '0' ) + REC_VERSION_6 ) ptr = Parser::Ptr( new ParserV6() );
     else if ( version == static_cast< int >( '0' ) + REC_VERSION_5 ) ptr = Parser::Ptr( new ParserV5() );
     else if ( version == static_cast< int >( '0' ) + REC_VERSION_4 ) ptr = Parser::Ptr( new ParserV4() );
     else if ( version == REC_VERSION_3 ) ptr = Parser::Ptr( new ParserV3() );
@@ -0,0 +1,994 @@
+// -*-c++-*-
+
+/*!
+  \file parser_mmap.cpp
+  \brief memory mapped rcg v4/v5 parser Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "parser_mmap.h"
+
+#include "parser_v4.h"
+#include "handler.h"
+#include "projection.h"
+#include "types.h"
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+//! powers of ten exactly representable by float
+const float POW10F[] = {
+    1.0e0f, 1.0e1f, 1.0e2f, 1.0e3f, 1.0e4f, 1.0e5f,
+    1.0e6f, 1.0e7f, 1.0e8f, 1.0e9f, 1.0e10f,
+};
+
+//! the max mantissa exactly representable by float
+const unsigned long MAX_FLOAT_MANTISSA = 1ul << 24;
+
+inline
+bool
+is_space( const char c )
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline
+bool
+is_digit( const char c )
+{
+    return '0' <= c && c <= '9';
+}
+
+inline
+const char *
+skip_space( const char * p,
+            const char * last )
+{
+    while ( p < last && is_space( *p ) ) ++p;
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip spaces and the expected character
+ */
+inline
+bool
+expect( const char * & p,
+        const char * last,
+        const char c )
+{
+    p = skip_space( p, last );
+    if ( p < last && *p == c )
+    {
+        ++p;
+        return true;
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip the current parenthesized group including nested groups
+ */
+const char *
+skip_group( const char * p,
+            const char * last )
+{
+    int depth = 0;
+    while ( p < last )
+    {
+        if ( *p == '(' ) ++depth;
+        else if ( *p == ')' )
+        {
+            --depth;
+            if ( depth <= 0 ) return p + 1;
+        }
+        ++p;
+    }
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief skip a number token without converting it
+ */
+bool
+skip_number( const char * & first,
+             const char * last )
+{
+    const char * p = skip_space( first, last );
+    const char * start = p;
+    while ( p < last
+            && ! is_space( *p )
+            && *p != '(' && *p != ')' )
+    {
+        ++p;
+    }
+
+    if ( p == start )
+    {
+        return false;
+    }
+
+    first = p;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scan a hexadecimal integer with or without "0x" prefix
+ */
+bool
+scan_hex( const char * & first,
+          const char * last,
+          long & value )
+{
+    const char * p = skip_space( first, last );
+
+    if ( last - p >= 2
+         && p[0] == '0'
+         && ( p[1] == 'x' || p[1] == 'X' ) )
+    {
+        p += 2;
+    }
+
+    const char * start = p;
+    unsigned long v = 0;
+    while ( p < last )
+    {
+        const char c = *p;
+        if ( is_digit( c ) ) v = ( v << 4 ) | static_cast< unsigned long >( c - '0' );
+        else if ( 'a' <= c && c <= 'f' ) v = ( v << 4 ) | static_cast< unsigned long >( c - 'a' + 10 );
+        else if ( 'A' <= c && c <= 'F' ) v = ( v << 4 ) | static_cast< unsigned long >( c - 'A' + 10 );
+        else break;
+        ++p;
+    }
+
+    if ( p == start )
+    {
+        return false;
+    }
+
+    value = static_cast< long >( v );
+    first = p;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief std::strtof() wrapper for the non-terminated buffer
+ */
+bool
+scan_float_slow( const char * & first,
+                 const char * last,
+                 float & value )
+{
+    char buf[64];
+    std::size_t len = 0;
+
+    const char * p = skip_space( first, last );
+    while ( p < last
+            && len < sizeof( buf ) - 1
+            && ! is_space( *p )
+            && *p != '(' && *p != ')' && *p != '\n' )
+    {
+        buf[len++] = *p++;
+    }
+    buf[len] = '\0';
+
+    char * next;
+    value = std::strtof( buf, &next );
+    if ( next == buf )
+    {
+        return false;
+    }
+
+    first = skip_space( first, last ) + ( next - buf );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief copy one token into the fixed size buffer
+ */
+void
+scan_name( const char * & p,
+           const char * last,
+           char * name,
+           const std::size_t size )
+{
+    std::size_t len = 0;
+    p = skip_space( p, last );
+    while ( p < last
+            && ! is_space( *p )
+            && *p != ')' )
+    {
+        if ( len < size - 1 ) name[len++] = *p;
+        ++p;
+    }
+    name[len] = '\0';
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief report the error with the line content
+ */
+void
+print_error( const int n_line,
+             const char * message,
+             const char * first,
+             const char * last )
+{
+    std::cerr << n_line << ": error: "
+              << message
+              << " \"" << std::string( first, last ) << "\""
+              << std::endl;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief scan a floating point number, or skip it if not required
+ */
+inline
+bool
+read_float( const char * & first,
+            const char * last,
+            float & value,
+            const bool convert )
+{
+    return ( convert
+             ? rcsc::rcg::ParserMMap::scanFloat( first, last, value )
+             : skip_number( first, last ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief get the show field of the player sub group
+ */
+inline
+int
+sub_group_field( const char tag )
+{
+    switch ( tag ) {
+    case 'v': return rcsc::rcg::Projection::PLAYER_VIEW;
+    case 's': return rcsc::rcg::Projection::PLAYER_STAMINA;
+    case 'f': return rcsc::rcg::Projection::PLAYER_FOCUS;
+    case 'c': return rcsc::rcg::Projection::PLAYER_COUNT;
+    default: break;
+    }
+    // unknown groups are skipped
+    return 0;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ParserMMap::ParserMMap()
+    : M_filepath(),
+      M_data( static_cast< const char * >( 0 ) ),
+      M_size( 0 ),
+      M_buffer(),
+      M_version( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ParserMMap::~ParserMMap()
+{
+    close();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserMMap::open( const std::string & filepath )
+{
+    close();
+
+    M_filepath = filepath;
+
+#ifdef HAVE_SYS_MMAN_H
+    int fd = ::open( filepath.c_str(), O_RDONLY );
+    if ( fd < 0 )
+    {
+        std::cerr << "(ParserMMap::open) could not open the file [" << filepath << ']'
+                  << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if ( ::fstat( fd, &st ) != 0
+         || st.st_size <= 0 )
+    {
+        std::cerr << "(ParserMMap::open) empty or illegal file [" << filepath << ']'
+                  << std::endl;
+        ::close( fd );
+        return false;
+    }
+
+    void * addr = ::mmap( 0, static_cast< std::size_t >( st.st_size ),
+                          PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd ); // the mapping is still alive after close()
+
+    if ( addr == MAP_FAILED )
+    {
+        std::cerr << "(ParserMMap::open) mmap failed [" << filepath << ']'
+                  << std::endl;
+        return false;
+    }
+
+    ::madvise( addr, static_cast< std::size_t >( st.st_size ), MADV_SEQUENTIAL );
+
+    M_data = static_cast< const char * >( addr );
+    M_size = static_cast< std::size_t >( st.st_size );
+#else
+    std::ifstream fin( filepath.c_str(), std::ios_base::in | std::ios_base::binary );
+    if ( ! fin )
+    {
+        std::cerr << "(ParserMMap::open) could not open the file [" << filepath << ']'
+                  << std::endl;
+        return false;
+    }
+
+    fin.seekg( 0, std::ios_base::end );
+    const std::streamoff len = fin.tellg();
+    fin.seekg( 0, std::ios_base::beg );
+    if ( len <= 0 )
+    {
+        std::cerr << "(ParserMMap::open) empty or illegal file [" << filepath << ']'
+                  << std::endl;
+        return false;
+    }
+
+    M_buffer.resize( static_cast< std::size_t >( len ) );
+    fin.read( &M_buffer[0], len );
+    M_data = &M_buffer[0];
+    M_size = M_buffer.size();
+#endif
+
+    if ( M_size >= 2
+         && static_cast< unsigned char >( M_data[0] ) == 0x1f
+         && static_cast< unsigned char >( M_data[1] ) == 0x8b )
+    {
+        std::cerr << "(ParserMMap::open) gzipped file is not supported [" << filepath << ']'
+                  << std::endl;
+        close();
+        return false;
+    }
+
+    if ( M_size < 4
+         || M_data[0] != 'U'
+         || M_data[1] != 'L'
+         || M_data[2] != 'G'
+         || ( M_data[3] != '0' + REC_VERSION_4
+              && M_data[3] != '0' + REC_VERSION_5 )
+         || ( M_size > 4 && M_data[4] != '\n' && M_data[4] != '\r' ) )
+    {
+        std::cerr << "(ParserMMap::open) unsupported log version [" << filepath << ']'
+                  << std::endl;
+        close();
+        return false;
+    }
+
+    M_version = M_data[3] - '0';
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ParserMMap::close()
+{
+#ifdef HAVE_SYS_MMAN_H
+    if ( M_data )
+    {
+        ::munmap( const_cast< char * >( M_data ), M_size );
+    }
+#endif
+
+    std::vector< char >().swap( M_buffer );
+    M_data = static_cast< const char * >( 0 );
+    M_size = 0;
+    M_version = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserMMap::parse( Handler & handler ) const
+{
+    if ( ! isOpen() )
+    {
+        return false;
+    }
+
+    if ( ! handler.handleLogVersion( M_version ) )
+    {
+        return false;
+    }
+
+    const char * last = M_data + M_size;
+    const char * eol = static_cast< const char * >( std::memchr( M_data, '\n', M_size ) );
+
+    if ( eol
+         && ! parseLines( eol + 1, last, handler, 2 ) )
+    {
+        return false;
+    }
+
+    return handler.handleEOF();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserMMap::parseLines( const char * first,
+                        const char * last,
+                        Handler & handler,
+                        const int n_line ) const
+{
+    // other than show lines are delegated to the stream parser.
+    // the line buffer is reused for all lines.
+    const ParserV4 line_parser;
+    const Projection projection = handler.projection();
+    std::string line;
+    line.reserve( 8192 );
+
+    int n = n_line;
+    const char * p = first;
+    while ( p < last )
+    {
+        const char * eol = static_cast< const char * >( std::memchr( p, '\n', last - p ) );
+        if ( ! eol ) eol = last;
+
+        const char * line_last = eol;
+        if ( line_last > p && *( line_last - 1 ) == '\r' ) --line_last;
+
+        const char * s = skip_space( p, line_last );
+        const int kind = ( projection.isAll()
+                           ? 0
+                           : Projection::line_kind( s, line_last ) );
+        if ( kind != 0
+             && kind != Projection::SHOW_LINE
+             && ! projection.hasLine( kind ) )
+        {
+            // not required
+        }
+        else if ( line_last - s > 6
+                  && ! std::strncmp( s, "(show ", 6 ) )
+        {
+            // same as ParserV4, errors in show lines are not fatal.
+            if ( projection.hasLine( Projection::SHOW_LINE
+                                     | Projection::PLAYMODE_LINE
+                                     | Projection::TEAM_LINE ) )
+            {
+                parseShow( n, s, line_last, handler, projection );
+            }
+        }
+        else
+        {
+            line.assign( p, line_last );
+            if ( ! line_parser.parseLine( n, line, handler ) )
+            {
+                return false;
+            }
+        }
+
+        ++n;
+        p = eol + 1;
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserMMap::parseShow( const int n_line,
+                       const char * first,
+                       const char * last,
+                       Handler & handler )
+{
+    return parseShow( n_line, first, last, handler, handler.projection() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserMMap::parseShow( const int n_line,
+                       const char * first,
+                       const char * last,
+                       Handler & handler,
+                       const Projection & projection )
+{
+    /*
+      (show <Time> [(pm <pm>)] [(tm ...)] <Ball> <Players>)
+    */
+
+    ShowInfoT show;
+
+    const char * buf = skip_space( first, last );
+
+    if ( last - buf < 5
+         || std::strncmp( buf, "(show", 5 ) )
+    {
+        print_error( n_line, "Illegal show line.", first, last );
+        return false;
+    }
+    buf += 5;
+
+    long time = 0;
+    if ( ! scanInt( buf, last, time ) )
+    {
+        print_error( n_line, "Illegal show info time.", first, last );
+        return false;
+    }
+
+    show.time_ = static_cast< UInt32 >( time );
+
+    const bool need_show = projection.hasLine( Projection::SHOW_LINE );
+    const bool ball_pos = projection.hasShowField( Projection::BALL_POS );
+    const bool ball_vel = projection.hasShowField( Projection::BALL_VEL );
+    const bool player_state = projection.hasShowField( Projection::PLAYER_STATE );
+    const bool player_pos = projection.hasShowField( Projection::PLAYER_POS );
+    const bool player_vel = projection.hasShowField( Projection::PLAYER_VEL );
+    const bool player_body = projection.hasShowField( Projection::PLAYER_BODY );
+    const bool player_arm = projection.hasShowField( Projection::PLAYER_ARM );
+
+    while ( true )
+    {
+        buf = skip_space( buf, last );
+        if ( buf >= last || *buf == ')' )
+        {
+            break;
+        }
+
+        if ( *buf != '('
+             || last - buf < 3 )
+        {
+            print_error( n_line, "Illegal show info.", first, last );
+            return false;
+        }
+
+        if ( buf[1] == '(' )
+        {
+            if ( ! need_show )
+            {
+                // the playmode and the team info are always placed before the objects.
+                return true;
+            }
+
+            if ( buf[2] == 'b' )
+            {
+                //
+                // ((b) x y vx vy)
+                //
+                buf += 3;
+                BallT & ball = show.ball_;
+                if ( ! expect( buf, last, ')' )
+                     || ! read_float( buf, last, ball.x_, ball_pos )
+                     || ! read_float( buf, last, ball.y_, ball_pos ) )
+                {
+                    print_error( n_line, "Illegal ball info.", first, last );
+                    return false;
+                }
+
+                if ( read_float( buf, last, ball.vx_, ball_vel ) )
+                {
+                    read_float( buf, last, ball.vy_, ball_vel );
+                }
+
+                if ( ! expect( buf, last, ')' ) )
+                {
+                    print_error( n_line, "Illegal ball info.", first, last );
+                    return false;
+                }
+                continue;
+            }
+
+            //
+            // ((side unum) type state x y vx vy body neck [pointx pointy]
+            //  (v h 90) (s 4000 1 1 [127000]) [(f side unum)] (c 1 1 1 1 1 1 1 1 1 1 1))
+            //
+            buf += 2;
+            const char side = *buf;
+            ++buf;
+            long unum = 0;
+            if ( ( side != 'l' && side != 'r' )
+                 || ! scanInt( buf, last, unum )
+                 || unum < 1 || MAX_PLAYER < unum
+                 || ! expect( buf, last, ')' ) )
+            {
+                print_error( n_line, "Illegal player id.", first, last );
+                return false;
+            }
+
+            const int idx = ( side == 'l' ? unum - 1 : unum - 1 + MAX_PLAYER );
+
+            PlayerT & p = show.player_[idx];
+            p.side_ = side;
+            p.unum_ = static_cast< Int16 >( unum );
+
+            long type = 0, state = 0;
+            if ( ! ( player_state
+                     ? ( scanInt( buf, last, type ) && scan_hex( buf, last, state ) )
+                     : ( skip_number( buf, last ) && skip_number( buf, last ) ) )
+                 || ! read_float( buf, last, p.x_, player_pos )
+                 || ! read_float( buf, last, p.y_, player_pos )
+                 || ! read_float( buf, last, p.vx_, player_vel )
+                 || ! read_float( buf, last, p.vy_, player_vel )
+                 || ! read_float( buf, last, p.body_, player_body )
+                 || ! read_float( buf, last, p.neck_, player_body ) )
+            {
+                print_error( n_line, "Illegal player pos.", first, last );
+                return false;
+            }
+
+            if ( player_state )
+            {
+                p.type_ = static_cast< Int16 >( type );
+                p.state_ = static_cast< Int32 >( state );
+            }
+
+            buf = skip_space( buf, last );
+            if ( buf < last && *buf != '(' && *buf != ')' )
+            {
+                if ( ! read_float( buf, last, p.point_x_, player_arm )
+                     || ! read_float( buf, last, p.point_y_, player_arm ) )
+                {
+                    print_error( n_line, "Illegal player arm.", first, last );
+                    return false;
+                }
+            }
+
+            // sub groups
+            while ( true )
+            {
+                buf = skip_space( buf, last );
+                if ( buf >= last )
+                {
+                    print_error( n_line, "Illegal player info.", first, last );
+                    return false;
+                }
+
+                if ( *buf == ')' )
+                {
+                    ++buf;
+                    break;
+                }
+
+                if ( *buf != '('
+                     || last - buf < 2 )
+                {
+                    print_error( n_line, "Illegal player info.", first, last );
+                    return false;
+                }
+
+                const char tag = buf[1];
+                if ( ! projection.hasShowField( sub_group_field( tag ) ) )
+                {
+                    buf = skip_group( buf, last );
+                    continue;
+                }
+
+                bool result = true;
+                switch ( tag ) {
+                case 'v':
+                    buf = skip_space( buf + 2, last );
+                    if ( buf >= last )
+                    {
+                        result = false;
+                        break;
+                    }
+                    p.view_quality_ = *buf;
+                    ++buf;
+                    result = scanFloat( buf, last, p.view_width_ );
+                    break;
+                case 's':
+                    buf += 2;
+                    result = ( scanFloat( buf, last, p.stamina_ )
+                               && scanFloat( buf, last, p.effort_ )
+                               && scanFloat( buf, last, p.recovery_ ) );
+                    buf = skip_space( buf, last );
+                    if ( result
+                         && buf < last
+                         && *buf != ')' )
+                    {
+                        result = scanFloat( buf, last, p.stamina_capacity_ );
+                    }
+                    break;
+                case 'f':
+                    {
+                        buf = skip_space( buf + 2, last );
+                        if ( buf >= last )
+                        {
+                            result = false;
+                            break;
+                        }
+                        p.focus_side_ = *buf;
+                        ++buf;
+                        long focus_unum = 0;
+                        result = scanInt( buf, last, focus_unum );
+                        p.focus_unum_ = static_cast< Int16 >( focus_unum );
+                    }
+                    break;
+                case 'c':
+                    {
+                        buf += 2;
+                        UInt16 * const counts[] = {
+                            &p.kick_count_,
+                            &p.dash_count_,
+                            &p.turn_count_,
+                            &p.catch_count_,
+                            &p.move_count_,
+                            &p.turn_neck_count_,
+                            &p.change_view_count_,
+                            &p.say_count_,
+                            &p.tackle_count_,
+                            &p.pointto_count_,
+                            &p.attentionto_count_,
+                        };
+                        for ( UInt16 * c : counts )
+                        {
+                            long value = 0;
+                            if ( ! scanInt( buf, last, value ) )
+                            {
+                                break;
+                            }
+                            *c = static_cast< UInt16 >( value );
+                        }
+                    }
+                    break;
+                default:
+                    // unknown group
+                    buf = skip_group( buf, last );
+                    continue;
+                }
+
+                if ( ! result
+                     || ! expect( buf, last, ')' ) )
+                {
+                    print_error( n_line, "Illegal player info.", first, last );
+                    return false;
+                }
+            }
+        }
+        else if ( buf[1] == 'p' && buf[2] == 'm' )
+        {
+            //
+            // (pm <playmode>)
+            //
+            buf += 3;
+            long pm = 0;
+            if ( scanInt( buf, last, pm )
+                 && expect( buf, last, ')' ) )
+            {
+                handler.handlePlayMode( time, static_cast< PlayMode >( pm ) );
+            }
+            else
+            {
+                buf = skip_group( buf, last );
+            }
+        }
+        else if ( buf[1] == 't' && buf[2] == 'm' )
+        {
+            //
+            // (tm <name_l> <name_r> <score_l> <score_r> [<pen_score_l> <pen_miss_l> <pen_score_r> <pen_miss_r>])
+            //
+            buf += 3;
+            char name_l[32], name_r[32];
+            long values[6] = { 0, 0, 0, 0, 0, 0 };
+
+            scan_name( buf, last, name_l, sizeof( name_l ) );
+            scan_name( buf, last, name_r, sizeof( name_r ) );
+
+            int n = 0;
+            while ( n < 6
+                    && scanInt( buf, last, values[n] ) )
+            {
+                ++n;
+            }
+
+            if ( ( n != 2 && n != 6 )
+                 || ! expect( buf, last, ')' ) )
+            {
+                print_error( n_line, "Illegal team info.", first, last );
+                return false;
+            }
+
+            if ( ! std::strcmp( name_l, "null" ) ) name_l[0] = '\0';
+            if ( ! std::strcmp( name_r, "null" ) ) name_r[0] = '\0';
+
+            TeamT team_l( name_l,
+                          static_cast< UInt16 >( values[0] ),
+                          static_cast< UInt16 >( values[2] ),
+                          static_cast< UInt16 >( values[3] ) );
+            TeamT team_r( name_r,
+                          static_cast< UInt16 >( values[1] ),
+                          static_cast< UInt16 >( values[4] ),
+                          static_cast< UInt16 >( values[5] ) );
+
+            handler.handleTeam( time, team_l, team_r );
+        }
+        else
+        {
+            buf = skip_group( buf, last );
+        }
+    }
+
+    handler.handleShow( show );
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserMMap::scanFloat( const char * & first,
+                       const char * last,
+                       float & value )
+{
+    const char * p = skip_space( first, last );
+
+    bool negative = false;
+    if ( p < last
+         && ( *p == '-' || *p == '+' ) )
+    {
+        negative = ( *p == '-' );
+        ++p;
+    }
+
+    unsigned long mantissa = 0;
+    int n_digits = 0;
+    int n_frac = 0;
+
+    while ( p < last && is_digit( *p ) )
+    {
+        mantissa = mantissa * 10 + static_cast< unsigned long >( *p - '0' );
+        ++n_digits;
+        ++p;
+        if ( mantissa > MAX_FLOAT_MANTISSA )
+        {
+            return scan_float_slow( first, last, value );
+        }
+    }
+
+    if ( p < last && *p == '.' )
+    {
+        ++p;
+        while ( p < last && is_digit( *p ) )
+        {
+            mantissa = mantissa * 10 + static_cast< unsigned long >( *p - '0' );
+            ++n_digits;
+            ++n_frac;
+            ++p;
+            if ( mantissa > MAX_FLOAT_MANTISSA
+                 || n_frac > 10 )
+            {
+                return scan_float_slow( first, last, value );
+            }
+        }
+    }
+
+    if ( n_digits == 0
+         || ( p < last && ( *p == 'e' || *p == 'E' ) ) )
+    {
+        // nan, inf or exponent notation
+        return scan_float_slow( first, last, value );
+    }
+
+    // both operands are exact, so the IEEE division gives the correctly rounded result.
+    float v = static_cast< float >( mantissa );
+    if ( n_frac > 0 )
+    {
+        v /= POW10F[n_frac];
+    }
+
+    value = ( negative ? -v : v );
+    first = p;
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserMMap::scanInt( const char * & first,
+                     const char * last,
+                     long & value )
+{
+    const char * p = skip_space( first, last );
+
+    bool negative = false;
+    if ( p < last
+         && ( *p == '-' || *p == '+' ) )
+    {
+        negative = ( *p == '-' );
+        ++p;
+    }
+
+    const char * start = p;
+    long v = 0;
+    while ( p < last && is_digit( *p ) )
+    {
+        v = v * 10 + ( *p - '0' );
+        ++p;
+    }
+
+    if ( p == start )
+    {
+        return false;
+    }
+
+    value = ( negative ? -v : v );
+    first = p;
+    return true;
+}
+
+} // end of namespace
+} // end of namespace
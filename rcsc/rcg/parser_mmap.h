@@ -0,0 +1,236 @@
+// -*-c++-*-
+
+/*!
+  \file parser_mmap.h
+  \brief memory mapped rcg v4/v5 parser Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_PARSER_MMAP_H
+#define RCSC_RCG_PARSER_MMAP_H
+
+#include <rcsc/rcg/types.h>
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace rcsc {
+namespace rcg {
+
+class Handler;
+class Projection;
+
+/*!
+  \class ParserMMap
+  \brief memory mapped parser for the uncompressed rcg v4/v5 files.
+
+  The whole file is mapped into memory and every line is parsed in place.
+  (show ...) lines are tokenized by the hand written number scanners
+  without any heap allocation.
+  Other kinds of lines are rare, and they are delegated to ParserV4::parseLine().
+
+  Gzipped files are not supported. Use ParserV4/ParserV5 with gzifstream for them.
+ */
+class ParserMMap {
+private:
+
+    //! opened file path
+    std::string M_filepath;
+
+    //! the start point of the file image
+    const char * M_data;
+
+    //! the byte size of the file image
+    std::size_t M_size;
+
+    //! fallback buffer used when mmap is not available
+    std::vector< char > M_buffer;
+
+    //! detected log version
+    int M_version;
+
+    // noncopyable
+    ParserMMap( const ParserMMap & );
+    ParserMMap & operator=( const ParserMMap & );
+
+public:
+
+    /*!
+      \brief create an empty parser.
+     */
+    ParserMMap();
+
+    /*!
+      \brief unmap the file if opened.
+     */
+    ~ParserMMap();
+
+    /*!
+      \brief map the file and detect its log version.
+      \param filepath file path string
+      \return true if the file is successfully mapped and it is rcg v4 or v5.
+     */
+    bool open( const std::string & filepath );
+
+    /*!
+      \brief unmap the current file.
+     */
+    void close();
+
+    /*!
+      \brief check if a file is opened.
+      \return checked result.
+     */
+    bool isOpen() const
+      {
+          return M_data != static_cast< const char * >( 0 );
+      }
+
+    /*!
+      \brief get the opened file path
+      \return file path string
+     */
+    const std::string & filepath() const
+      {
+          return M_filepath;
+      }
+
+    /*!
+      \brief get the detected log version
+      \return log version number. 0 if not opened.
+     */
+    int version() const
+      {
+          return M_version;
+      }
+
+    /*!
+      \brief get the start point of the file image
+      \return const pointer to the first byte.
+     */
+    const char * data() const
+      {
+          return M_data;
+      }
+
+    /*!
+      \brief get the byte size of the file image
+      \return byte size
+     */
+    std::size_t size() const
+      {
+          return M_size;
+      }
+
+    /*!
+      \brief analyze the whole file
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+     */
+    bool parse( Handler & handler ) const;
+
+    /*!
+      \brief analyze the lines in [first, last) without calling handleLogVersion() and handleEOF()
+      \param first the first byte of the range. must be the head of a line.
+      \param last the end of the range.
+      \param handler reference to the rcg data handler.
+      \param n_line the line number of the first line (used for error messages).
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+     */
+    bool parseLines( const char * first,
+                     const char * last,
+                     Handler & handler,
+                     const int n_line = 1 ) const;
+
+    /*!
+      \brief parse one (show ...) line in place.
+      \param n_line the line number (used for error messages).
+      \param first the first byte of the line
+      \param last the end of the line (excluding the newline)
+      \param handler reference to the rcg data handler.
+      \retval true if successfully parsed.
+      \retval false if failed to parse.
+     */
+    static
+    bool parseShow( const int n_line,
+                    const char * first,
+                    const char * last,
+                    Handler & handler );
+
+    /*!
+      \brief parse one (show ...) line in place. only the projected fields are converted.
+      \param n_line the line number (used for error messages).
+      \param first the first byte of the line
+      \param last the end of the line (excluding the newline)
+      \param handler reference to the rcg data handler.
+      \param projection the required data. if the show line is not required,
+      only the playmode and the team info in the line are handled.
+      \retval true if successfully parsed.
+      \retval false if failed to parse.
+     */
+    static
+    bool parseShow( const int n_line,
+                    const char * first,
+                    const char * last,
+                    Handler & handler,
+                    const Projection & projection );
+
+    /*!
+      \brief scan a floating point number in [first, last).
+      \param first reference to the scan position. moved to the next of the number.
+      \param last the end of the buffer
+      \param value reference to the variable to store the result.
+      \return true if a number is read.
+
+      The result is identical to std::strtof().
+      Numbers that cannot be handled by the fast path are passed to std::strtof().
+     */
+    static
+    bool scanFloat( const char * & first,
+                    const char * last,
+                    float & value );
+
+    /*!
+      \brief scan a decimal integer in [first, last).
+      \param first reference to the scan position. moved to the next of the number.
+      \param last the end of the buffer
+      \param value reference to the variable to store the result.
+      \return true if a number is read.
+     */
+    static
+    bool scanInt( const char * & first,
+                  const char * last,
+                  long & value );
+
+};
+
+} // end of namespace
+} // end of namespace
+
+#endif
@@ -79,10 +79,27 @@ ParserV5::parse( std::istream & is,
         return false;
     }
 
+    // show lines may contain the playmode and the team info
+    const Projection projection = handler.projection();
+    const bool skip_show = ! projection.hasLine( Projection::SHOW_LINE
+                                                 | Projection::PLAYMODE_LINE
+                                                 | Projection::TEAM_LINE );
+
     int n_line = 1;
     while ( std::getline( is, line ) )
     {
         ++n_line;
+
+        if ( ! projection.isAll() )
+        {
+            const int kind = Projection::line_kind( line.data(), line.data() + line.length() );
+            if ( kind == Projection::SHOW_LINE
+                 ? skip_show
+                 : ( kind != 0 && ! projection.hasLine( kind ) ) )
+            {
+                continue;
+            }
+        }
         if ( ! parseLine( n_line, line, handler ) )
         {
             return false;
@@ -0,0 +1,509 @@
+// -*-c++-*-
+
+/*!
+  \file parser_v6.cpp
+  \brief rcg v6 parser Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "parser_v6.h"
+
+#include "handler.h"
+#include "projection.h"
+#include "util.h"
+
+#include <iostream>
+#include <cstring>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+/*!
+  \struct Reader
+  \brief bounds checked reader of the record payload
+ */
+struct Reader {
+    const char * p_;
+    const char * end_;
+
+    explicit
+    Reader( const std::string & payload )
+        : p_( payload.data() ),
+          end_( payload.data() + payload.length() )
+      { }
+
+    bool getByte( int * val )
+      {
+          if ( p_ >= end_ ) return false;
+          *val = static_cast< unsigned char >( *p_++ );
+          return true;
+      }
+
+    bool getVarint( unsigned long long * val )
+      {
+          unsigned long long result = 0;
+          for ( int shift = 0; shift < 64; shift += 7 )
+          {
+              if ( p_ >= end_ ) return false;
+              const unsigned char b = static_cast< unsigned char >( *p_++ );
+              result |= static_cast< unsigned long long >( b & 0x7f ) << shift;
+              if ( ! ( b & 0x80 ) )
+              {
+                  *val = result;
+                  return true;
+              }
+          }
+          return false;
+      }
+
+    bool getSigned( long long * val )
+      {
+          unsigned long long u = 0;
+          if ( ! getVarint( &u ) ) return false;
+          *val = static_cast< long long >( u >> 1 ) ^ -static_cast< long long >( u & 1 );
+          return true;
+      }
+
+    bool getString( std::string * str )
+      {
+          unsigned long long len = 0;
+          if ( ! getVarint( &len )
+               || static_cast< unsigned long long >( end_ - p_ ) < len )
+          {
+              return false;
+          }
+          str->assign( p_, static_cast< std::size_t >( len ) );
+          p_ += len;
+          return true;
+      }
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the varint from the stream
+*/
+bool
+read_varint( std::istream & is,
+             unsigned long long * val )
+{
+    unsigned long long result = 0;
+    for ( int shift = 0; shift < 64; shift += 7 )
+    {
+        const int c = is.get();
+        if ( c == std::char_traits< char >::eof() )
+        {
+            return false;
+        }
+        result |= static_cast< unsigned long long >( c & 0x7f ) << shift;
+        if ( ! ( c & 0x80 ) )
+        {
+            *val = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the recorded integer value to the float value
+*/
+inline
+float
+to_float( const long long val,
+          const bool raw )
+{
+    if ( raw )
+    {
+        const UInt32 bits = static_cast< UInt32 >( static_cast< unsigned int >( val ) );
+        float f;
+        std::memcpy( &f, &bits, sizeof( float ) );
+        return f;
+    }
+
+    return static_cast< float >( static_cast< double >( val ) / REC6_FIXED_SCALE );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the recorded values to the show data.
+  the order of the player values must be same as SerializerV6.
+*/
+void
+from_values( const long long * values,
+             const bool raw,
+             ShowInfoT * show )
+{
+    show->ball_.x_ = to_float( values[0], raw );
+    show->ball_.y_ = to_float( values[1], raw );
+    show->ball_.vx_ = to_float( values[2], raw );
+    show->ball_.vy_ = to_float( values[3], raw );
+
+    const long long * v = values + REC6_BALL_VALUES;
+    for ( PlayerT & p : show->player_ )
+    {
+        p.x_ = to_float( v[0], raw );
+        p.y_ = to_float( v[1], raw );
+        p.vx_ = to_float( v[2], raw );
+        p.vy_ = to_float( v[3], raw );
+        p.body_ = to_float( v[4], raw );
+        p.neck_ = to_float( v[5], raw );
+        p.stamina_ = to_float( v[6], raw );
+        p.dash_count_ = static_cast< UInt16 >( v[7] );
+        p.turn_count_ = static_cast< UInt16 >( v[8] );
+        p.turn_neck_count_ = static_cast< UInt16 >( v[9] );
+        p.state_ = static_cast< Int32 >( v[10] );
+        p.kick_count_ = static_cast< UInt16 >( v[11] );
+        p.effort_ = to_float( v[12], raw );
+        p.recovery_ = to_float( v[13], raw );
+        p.change_view_count_ = static_cast< UInt16 >( v[14] );
+        p.say_count_ = static_cast< UInt16 >( v[15] );
+        p.catch_count_ = static_cast< UInt16 >( v[16] );
+        p.move_count_ = static_cast< UInt16 >( v[17] );
+        p.tackle_count_ = static_cast< UInt16 >( v[18] );
+        p.pointto_count_ = static_cast< UInt16 >( v[19] );
+        p.attentionto_count_ = static_cast< UInt16 >( v[20] );
+        p.point_x_ = to_float( v[21], raw );
+        p.point_y_ = to_float( v[22], raw );
+        p.view_quality_ = static_cast< char >( v[23] );
+        p.view_width_ = to_float( v[24], raw );
+        p.focus_side_ = static_cast< char >( v[25] );
+        p.focus_unum_ = static_cast< Int16 >( v[26] );
+        p.stamina_capacity_ = to_float( v[27], raw );
+        p.side_ = static_cast< char >( v[28] );
+        p.unum_ = static_cast< Int16 >( v[29] );
+        p.type_ = static_cast< Int16 >( v[30] );
+
+        v += REC6_PLAYER_VALUES;
+    }
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV6::parse( std::istream & is,
+                 Handler & handler ) const
+{
+    // streampos must be the first point!!!
+    is.seekg( 0 );
+
+    if ( ! is.good() )
+    {
+        return false;
+    }
+
+    char header[4];
+    if ( ! is.read( header, 4 )
+         || std::strncmp( header, "ULG6", 4 ) != 0 )
+    {
+        return false;
+    }
+
+    if ( ! handler.handleLogVersion( REC_VERSION_6 ) )
+    {
+        return false;
+    }
+
+    const Projection projection = handler.projection();
+
+    bool has_prev = false;
+    Int32 prev_time = 0;
+    long long prev[REC6_SHOW_VALUES];
+    long long prev2[REC6_SHOW_VALUES];
+
+    std::string payload;
+    payload.reserve( 8192 );
+
+    ShowInfoT show;
+
+    int n_record = 0;
+    while ( true )
+    {
+        const int tag = is.get();
+        if ( tag == std::char_traits< char >::eof() )
+        {
+            break;
+        }
+        ++n_record;
+
+        unsigned long long len = 0;
+        if ( ! read_varint( is, &len )
+             || len > 0x7fffffff )
+        {
+            std::cerr << n_record << ": error: "
+                      << "Illegal record size." << std::endl;
+            return false;
+        }
+
+        payload.resize( static_cast< std::size_t >( len ) );
+        if ( len > 0
+             && ! is.read( &payload[0], static_cast< std::streamsize >( len ) ) )
+        {
+            std::cerr << n_record << ": error: "
+                      << "Truncated record." << std::endl;
+            return false;
+        }
+
+        Reader reader( payload );
+        long long time = 0;
+
+        switch ( tag ) {
+        case REC6_KEYFRAME:
+        case REC6_DELTA:
+            if ( ! projection.hasLine( Projection::SHOW_LINE ) )
+            {
+                break;
+            }
+            if ( ! decodeShow( tag, payload, &has_prev, &prev_time, prev, prev2, &show ) )
+            {
+                std::cerr << n_record << ": error: "
+                          << "Illegal show record." << std::endl;
+                return false;
+            }
+            handler.handleShow( show );
+            break;
+
+        case REC6_PLAYMODE:
+            if ( projection.hasLine( Projection::PLAYMODE_LINE ) )
+            {
+                int pm = 0;
+                if ( ! reader.getSigned( &time )
+                     || ! reader.getByte( &pm ) )
+                {
+                    std::cerr << n_record << ": error: "
+                              << "Illegal playmode record." << std::endl;
+                    return false;
+                }
+                handler.handlePlayMode( static_cast< int >( time ),
+                                        static_cast< PlayMode >( static_cast< char >( pm ) ) );
+            }
+            break;
+
+        case REC6_TEAM:
+            if ( projection.hasLine( Projection::TEAM_LINE ) )
+            {
+                TeamT teams[2];
+                bool ok = reader.getSigned( &time );
+                for ( TeamT & t : teams )
+                {
+                    unsigned long long score = 0, pen_score = 0, pen_miss = 0;
+                    ok = ok
+                        && reader.getString( &t.name_ )
+                        && reader.getVarint( &score )
+                        && reader.getVarint( &pen_score )
+                        && reader.getVarint( &pen_miss );
+                    t.score_ = static_cast< UInt16 >( score );
+                    t.pen_score_ = static_cast< UInt16 >( pen_score );
+                    t.pen_miss_ = static_cast< UInt16 >( pen_miss );
+                }
+                if ( ! ok )
+                {
+                    std::cerr << n_record << ": error: "
+                              << "Illegal team record." << std::endl;
+                    return false;
+                }
+                handler.handleTeam( static_cast< int >( time ), teams[0], teams[1] );
+            }
+            break;
+
+        case REC6_MSG:
+            if ( projection.hasLine( Projection::MSG_LINE ) )
+            {
+                long long board = 0;
+                std::string msg;
+                if ( ! reader.getSigned( &time )
+                     || ! reader.getSigned( &board )
+                     || ! reader.getString( &msg ) )
+                {
+                    std::cerr << n_record << ": error: "
+                              << "Illegal msg record." << std::endl;
+                    return false;
+                }
+                handler.handleMsg( static_cast< int >( time ), static_cast< int >( board ), msg );
+            }
+            break;
+
+        case REC6_PARAM:
+            {
+                const int kind = Projection::line_kind( payload.data(), payload.data() + payload.length() );
+                if ( ! projection.hasLine( kind ) )
+                {
+                    break;
+                }
+
+                if ( kind == Projection::SERVER_PARAM_LINE )
+                {
+                    if ( ! handler.handleServerParam( payload ) ) return false;
+                }
+                else if ( kind == Projection::PLAYER_PARAM_LINE )
+                {
+                    if ( ! handler.handlePlayerParam( payload ) ) return false;
+                }
+                else if ( kind == Projection::PLAYER_TYPE_LINE )
+                {
+                    if ( ! handler.handlePlayerType( payload ) ) return false;
+                }
+            }
+            break;
+
+        default:
+            // unknown records are skipped
+            break;
+        }
+    }
+
+    if ( is.eof() )
+    {
+        return handler.handleEOF();
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ParserV6::decodeShow( const int tag,
+                      const std::string & payload,
+                      bool * has_prev,
+                      Int32 * prev_time,
+                      long long * prev,
+                      long long * prev2,
+                      ShowInfoT * show ) const
+{
+    Reader reader( payload );
+
+    long long time = 0;
+    if ( ! reader.getSigned( &time ) )
+    {
+        return false;
+    }
+
+    if ( tag == REC6_KEYFRAME )
+    {
+        int encoding = 0;
+        if ( ! reader.getByte( &encoding )
+             || ( encoding != 0 && encoding != 1 ) )
+        {
+            return false;
+        }
+
+        for ( int i = 0; i < REC6_SHOW_VALUES; ++i )
+        {
+            if ( ! reader.getSigned( &prev[i] ) )
+            {
+                return false;
+            }
+        }
+
+        std::memcpy( prev2, prev, sizeof( long long ) * REC6_SHOW_VALUES );
+        *has_prev = ( encoding == 0 );
+        *prev_time = static_cast< Int32 >( time );
+
+        show->time_ = static_cast< UInt32 >( time );
+        from_values( prev, encoding == 1, show );
+        return true;
+    }
+
+    //
+    // delta record
+    //
+    if ( ! *has_prev )
+    {
+        return false;
+    }
+
+    long long values[REC6_SHOW_VALUES];
+    int begin = 0;
+    int size = REC6_BALL_VALUES;
+    while ( begin < REC6_SHOW_VALUES )
+    {
+        unsigned long long mask = 0;
+        if ( ! reader.getVarint( &mask ) )
+        {
+            return false;
+        }
+
+        for ( int j = 0; j < size; ++j )
+        {
+            const int i = begin + j;
+            long long diff = 0;
+            if ( ( mask & ( 1ULL << j ) )
+                 && ! reader.getSigned( &diff ) )
+            {
+                return false;
+            }
+
+            values[i] = ( rec6_is_linear( i )
+                          ? 2 * prev[i] - prev2[i]
+                          : prev[i] ) + diff;
+        }
+
+        begin += size;
+        size = REC6_PLAYER_VALUES;
+    }
+
+    std::memcpy( prev2, prev, sizeof( long long ) * REC6_SHOW_VALUES );
+    std::memcpy( prev, values, sizeof( long long ) * REC6_SHOW_VALUES );
+    *prev_time = static_cast< Int32 >( *prev_time + time );
+
+    show->time_ = static_cast< UInt32 >( *prev_time );
+    from_values( values, false, show );
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+namespace {
+
+Parser::Ptr
+create_v6()
+{
+    Parser::Ptr ptr( new ParserV6() );
+    return ptr;
+}
+
+const int version = static_cast< int >( '0' ) + REC_VERSION_6;
+rcss::RegHolder v6 = Parser::creators().autoReg( &create_v6, version );
+
+}
+
+} // end of namespace
+} // end of namespace
@@ -0,0 +1,102 @@
+// -*-c++-*-
+
+/*!
+  \file parser_v6.h
+  \brief rcg v6 parser Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_PARSER_V6_H
+#define RCSC_RCG_PARSER_V6_H
+
+#include <rcsc/rcg/parser.h>
+#include <rcsc/rcg/types.h>
+
+#include <string>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class ParserV6
+  \brief rcg v6 (binary, delta-encoded) parser class
+
+  The format is described in SerializerV6. The records of the line kinds
+  that are not required by Handler::projection() are skipped without
+  decoding.
+ */
+class ParserV6
+    : public Parser {
+public:
+
+    /*!
+      \brief get supported rcg version
+      \return version number
+     */
+    int version() const
+      {
+          return REC_VERSION_6;
+      }
+
+    /*!
+      \brief parse input stream
+      \param is reference to the imput stream (usually ifstream/gzifstream).
+      \param handler reference to the rcg data handler.
+      \retval true, if successfuly parsed.
+      \retval false, if incorrect format is detected.
+    */
+    virtual
+    bool parse( std::istream & is,
+                Handler & handler ) const;
+
+private:
+
+    /*!
+      \brief decode the show record.
+      \param tag REC6_KEYFRAME or REC6_DELTA
+      \param payload record data
+      \param has_prev true if prev values are available
+      \param prev_time the time of the last show. updated by the decoded show.
+      \param prev the values of the last show. updated by the decoded show.
+      \param prev2 the values of the show before the last show. updated by the decoded show.
+      \param show decoded show data
+      \retval true if successfully decoded.
+      \retval false if failed to decode.
+     */
+    bool decodeShow( const int tag,
+                     const std::string & payload,
+                     bool * has_prev,
+                     Int32 * prev_time,
+                     long long * prev,
+                     long long * prev2,
+                     ShowInfoT * show ) const;
+
+};
+
+} // end of namespace
+} // end of namespace
+
+#endif
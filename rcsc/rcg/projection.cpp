@@ -0,0 +1,155 @@
+// -*-c++-*-
+
+/*!
+  \file projection.cpp
+  \brief required rcg data description Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "projection.h"
+
+#include <cstring>
+
+namespace rcsc {
+namespace rcg {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+Projection::line_kind( const char * first,
+                       const char * last )
+{
+    static const struct {
+        const char * name_;
+        std::size_t len_;
+        int kind_;
+    } s_kinds[] = {
+        { "show", 4, SHOW_LINE },
+        { "playmode", 8, PLAYMODE_LINE },
+        { "team", 4, TEAM_LINE },
+        { "msg", 3, MSG_LINE },
+        { "draw", 4, DRAW_LINE },
+        { "server_param", 12, SERVER_PARAM_LINE },
+        { "player_param", 12, PLAYER_PARAM_LINE },
+        { "player_type", 11, PLAYER_TYPE_LINE },
+    };
+
+    const char * p = first;
+    while ( p < last && ( *p == ' ' || *p == '\t' ) ) ++p;
+
+    if ( p >= last || *p != '(' )
+    {
+        return 0;
+    }
+    ++p;
+
+    for ( const auto & k : s_kinds )
+    {
+        if ( static_cast< std::size_t >( last - p ) > k.len_
+             && ! std::strncmp( p, k.name_, k.len_ )
+             && ( p[k.len_] == ' ' || p[k.len_] == '(' || p[k.len_] == ')' ) )
+        {
+            return k.kind_;
+        }
+    }
+
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+Projection::parse_show_fields( const std::string & names )
+{
+    static const struct {
+        const char * name_;
+        int fields_;
+    } s_fields[] = {
+        { "all", ALL_SHOW_FIELDS },
+        { "ball", BALL_FIELDS },
+        { "ball_pos", BALL_POS },
+        { "ball_vel", BALL_VEL },
+        { "player", PLAYER_FIELDS },
+        { "player_state", PLAYER_STATE },
+        { "player_pos", PLAYER_POS },
+        { "player_vel", PLAYER_VEL },
+        { "player_body", PLAYER_BODY },
+        { "player_arm", PLAYER_ARM },
+        { "player_view", PLAYER_VIEW },
+        { "player_stamina", PLAYER_STAMINA },
+        { "player_focus", PLAYER_FOCUS },
+        { "player_count", PLAYER_COUNT },
+    };
+
+    int result = 0;
+
+    std::string::size_type begin = 0;
+    while ( begin <= names.length() )
+    {
+        std::string::size_type end = names.find( ',', begin );
+        if ( end == std::string::npos ) end = names.length();
+
+        std::string name = names.substr( begin, end - begin );
+        const std::string::size_type b = name.find_first_not_of( ' ' );
+        const std::string::size_type e = name.find_last_not_of( ' ' );
+        name = ( b == std::string::npos ? std::string() : name.substr( b, e - b + 1 ) );
+
+        if ( ! name.empty() )
+        {
+            int fields = -1;
+            for ( const auto & f : s_fields )
+            {
+                if ( name == f.name_ )
+                {
+                    fields = f.fields_;
+                    break;
+                }
+            }
+
+            if ( fields < 0 )
+            {
+                return -1;
+            }
+
+            result |= fields;
+        }
+
+        begin = end + 1;
+    }
+
+    return result;
+}
+
+}
+}
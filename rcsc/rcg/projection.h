@@ -0,0 +1,202 @@
+// -*-c++-*-
+
+/*!
+  \file projection.h
+  \brief required rcg data description Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_PROJECTION_H
+#define RCSC_RCG_PROJECTION_H
+
+#include <string>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class Projection
+  \brief the set of the line kinds and show fields that a handler requires.
+
+  A handler returns its projection by Handler::projection().
+  The text parsers of rcg v4/v5 skip the lines that are not included.
+  ParserMMap also skips the conversion of the show fields that are not
+  included. Such fields keep the default values of PlayerT/BallT.
+ */
+class Projection {
+public:
+
+    /*!
+      \brief line kinds in rcg v4/v5
+     */
+    enum LineKind {
+        SHOW_LINE = 0x01,
+        MSG_LINE = 0x02,
+        DRAW_LINE = 0x04,
+        PLAYMODE_LINE = 0x08,
+        TEAM_LINE = 0x10,
+        SERVER_PARAM_LINE = 0x20,
+        PLAYER_PARAM_LINE = 0x40,
+        PLAYER_TYPE_LINE = 0x80,
+        ALL_LINES = 0xff,
+    };
+
+    /*!
+      \brief field groups in a show line
+     */
+    enum ShowField {
+        BALL_POS = 0x0001, //!< ball x, y
+        BALL_VEL = 0x0002, //!< ball vx, vy
+        PLAYER_STATE = 0x0004, //!< player type, state flags
+        PLAYER_POS = 0x0008, //!< player x, y
+        PLAYER_VEL = 0x0010, //!< player vx, vy
+        PLAYER_BODY = 0x0020, //!< player body, neck
+        PLAYER_ARM = 0x0040, //!< player pointing position
+        PLAYER_VIEW = 0x0080, //!< player view quality, width
+        PLAYER_STAMINA = 0x0100, //!< player stamina, effort, recovery, capacity
+        PLAYER_FOCUS = 0x0200, //!< player focus target
+        PLAYER_COUNT = 0x0400, //!< player command counts
+        BALL_FIELDS = 0x0003,
+        PLAYER_FIELDS = 0x07fc,
+        ALL_SHOW_FIELDS = 0x07ff,
+    };
+
+private:
+
+    //! LineKind bits
+    int M_lines;
+
+    //! ShowField bits
+    int M_show_fields;
+
+public:
+
+    /*!
+      \brief create a projection that requires all data
+     */
+    Projection()
+        : M_lines( ALL_LINES ),
+          M_show_fields( ALL_SHOW_FIELDS )
+      { }
+
+    /*!
+      \brief create a projection with the given bits
+      \param lines LineKind bits
+      \param show_fields ShowField bits
+     */
+    Projection( const int lines,
+                const int show_fields )
+        : M_lines( lines ),
+          M_show_fields( show_fields )
+      { }
+
+    /*!
+      \brief get the required line kinds
+      \return LineKind bits
+     */
+    int lines() const
+      {
+          return M_lines;
+      }
+
+    /*!
+      \brief get the required show fields
+      \return ShowField bits
+     */
+    int showFields() const
+      {
+          return M_show_fields;
+      }
+
+    /*!
+      \brief check if any of the line kinds is required
+      \param kinds LineKind bits
+      \return checked result
+     */
+    bool hasLine( const int kinds ) const
+      {
+          return ( M_lines & kinds ) != 0;
+      }
+
+    /*!
+      \brief check if any of the show fields is required
+      \param fields ShowField bits
+      \return checked result
+     */
+    bool hasShowField( const int fields ) const
+      {
+          return ( M_show_fields & fields ) != 0;
+      }
+
+    /*!
+      \brief check if all data are required
+      \return checked result
+     */
+    bool isAll() const
+      {
+          return M_lines == ALL_LINES
+              && M_show_fields == ALL_SHOW_FIELDS;
+      }
+
+    /*!
+      \brief add the data required by other projection
+      \param other other projection
+      \return reference to itself
+     */
+    Projection & add( const Projection & other )
+      {
+          M_lines |= other.M_lines;
+          M_show_fields |= other.M_show_fields;
+          return *this;
+      }
+
+    /*!
+      \brief detect the kind of the rcg v4/v5 line
+      \param first the first byte of the line
+      \param last the end of the line
+      \return LineKind value. 0 if unknown.
+     */
+    static
+    int line_kind( const char * first,
+                   const char * last );
+
+    /*!
+      \brief convert the comma separated field group names to ShowField bits.
+      Available names are "ball", "ball_pos", "ball_vel", "player", "player_state",
+      "player_pos", "player_vel", "player_body", "player_arm", "player_view",
+      "player_stamina", "player_focus", "player_count" and "all".
+      \param names comma separated names
+      \return ShowField bits. -1 if an unknown name is included.
+     */
+    static
+    int parse_show_fields( const std::string & names );
+
+};
+
+}
+}
+
+#endif
@@ -49,6 +49,7 @@
 #include "serializer_v3.h"
 #include "serializer_v4.h"
 #include "serializer_v5.h"
+#include "serializer_v6.h"
 
 
 #include <algorithm>
@@ -86,6 +87,7 @@ Serializer::create( const int version )
     {
         ptr = creator();
     }
+    else if ( version == REC_VERSION_6 ) ptr = Serializer::Ptr( new SerializerV6() );
     else if ( version == REC_VERSION_5 ) ptr = Serializer::Ptr( new SerializerV5() );
     else if ( version == REC_VERSION_4 ) ptr = Serializer::Ptr( new SerializerV4() );
     else if ( version == REC_VERSION_3 ) ptr = Serializer::Ptr( new SerializerV3() );
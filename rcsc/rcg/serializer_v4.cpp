@@ -515,21 +515,23 @@ SerializerV4::serialize( std::ostream & os,
 {
     M_time = show.time_;
 
-    os << "(show " << show.time_;
+    M_buf.clear();
+
+    M_buf << "(show " << show.time_;
 
     // ball
 
-    os << " ((b)"
-       << ' ' << show.ball_.x_ << ' ' << show.ball_.y_;
+    M_buf << " ((b)"
+          << ' ' << show.ball_.x_ << ' ' << show.ball_.y_;
     if ( show.ball_.hasVelocity() )
     {
-        os << ' ' << show.ball_.vx_ << ' ' << show.ball_.vy_;
+        M_buf << ' ' << show.ball_.vx_ << ' ' << show.ball_.vy_;
     }
     else
     {
-        os << " 0 0";
+        M_buf << " 0 0";
     }
-    os << ')';
+    M_buf << ')';
 
     // players
 
@@ -537,74 +539,73 @@ SerializerV4::serialize( std::ostream & os,
     {
         const PlayerT & p = show.player_[i];
 
-        os << " ((" << p.side_ << ' ' << p.unum_ << ')';
-        os << ' ' << p.type_;
-        os << ' ' << std::hex << std::showbase
-           << p.state_
-           << std::dec << std::noshowbase;
+        M_buf << " ((" << p.side_ << ' ' << p.unum_ << ')';
+        M_buf << ' ' << p.type_;
+        M_buf << ' ';
+        M_buf.appendHex( static_cast< unsigned int >( p.state_ ) );
 
-        os << ' ' << p.x_ << ' ' << p.y_;
+        M_buf << ' ' << p.x_ << ' ' << p.y_;
         if ( p.hasVelocity() )
         {
-            os << ' ' << p.vx_ << ' ' << p.vy_;
+            M_buf << ' ' << p.vx_ << ' ' << p.vy_;
         }
         else
         {
-            os << " 0 0";
+            M_buf << " 0 0";
         }
-        os << ' ' << p.body_
-           << ' ' << ( p.hasNeck() ? p.neck_ : 0.0f );
+        M_buf << ' ' << p.body_
+              << ' ' << ( p.hasNeck() ? p.neck_ : 0.0f );
 
         if ( p.isPointing() )
         {
-            os << ' ' << p.point_x_ << ' ' << p.point_y_;
+            M_buf << ' ' << p.point_x_ << ' ' << p.point_y_;
         }
 
         if ( p.hasView() )
         {
-            os << " (v " << p.view_quality_ << ' ' << p.view_width_ << ')';
+            M_buf << " (v " << p.view_quality_ << ' ' << p.view_width_ << ')';
         }
         else
         {
-            os << " (v h 90)";
+            M_buf << " (v h 90)";
         }
 
         if ( p.hasStamina() )
         {
-            os << " (s " << p.stamina_
-               << ' ' << p.effort_
-               << ' ' << p.recovery_
-               << ')';
+            M_buf << " (s " << p.stamina_
+                  << ' ' << p.effort_
+                  << ' ' << p.recovery_
+                  << ')';
         }
         else
         {
-            os << " (s 4000 1 1)";
+            M_buf << " (s 4000 1 1)";
         }
 
         if ( p.focus_side_ != 'n' )
         {
-            os << " (f" << p.focus_side_ << ' ' << p.focus_unum_ << ')';
+            M_buf << " (f" << p.focus_side_ << ' ' << p.focus_unum_ << ')';
         }
 
-        os << " (c"
-           << ' ' << p.kick_count_
-           << ' ' << p.dash_count_
-           << ' ' << p.turn_count_
-           << ' ' << p.catch_count_
-           << ' ' << p.move_count_
-           << ' ' << p.turn_neck_count_
-           << ' ' << p.change_view_count_
-           << ' ' << p.say_count_
-           << ' ' << p.tackle_count_
-           << ' ' << p.pointto_count_
-           << ' ' << p.attentionto_count_
-           << ')';
-        os << ')';
+        M_buf << " (c"
+              << ' ' << p.kick_count_
+              << ' ' << p.dash_count_
+              << ' ' << p.turn_count_
+              << ' ' << p.catch_count_
+              << ' ' << p.move_count_
+              << ' ' << p.turn_neck_count_
+              << ' ' << p.change_view_count_
+              << ' ' << p.say_count_
+              << ' ' << p.tackle_count_
+              << ' ' << p.pointto_count_
+              << ' ' << p.attentionto_count_
+              << ')';
+        M_buf << ')';
     }
 
-    os << ")\n";
+    M_buf << ")\n";
 
-    return os;
+    return M_buf.flush( os );
 }
 
 /*-------------------------------------------------------------------*/
@@ -33,6 +33,7 @@
 #define RCSC_RCG_SERIALIZER_V4_H
 
 #include <rcsc/rcg/serializer.h>
+#include <rcsc/rcg/format_buffer.h>
 
 namespace rcsc {
 namespace rcg {
@@ -47,6 +48,8 @@ protected:
 
     Int32 M_time; //!< temporal time holder
 
+    FormatBuffer M_buf; //!< reusable buffer for the show lines
+
 public:
 
     /*!
@@ -0,0 +1,471 @@
+// -*-c++-*-
+
+/*!
+  \file serializer_v6.cpp
+  \brief v6 format rcg serializer class Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "serializer_v6.h"
+
+#include "util.h"
+
+#include <sstream>
+#include <cstring>
+#include <cmath>
+
+namespace rcsc {
+namespace rcg {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the unsigned LEB128 value
+*/
+inline
+void
+put_varint( std::string & buf,
+            unsigned long long val )
+{
+    while ( val >= 0x80 )
+    {
+        buf += static_cast< char >( ( val & 0x7f ) | 0x80 );
+        val >>= 7;
+    }
+    buf += static_cast< char >( val );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the zigzag encoded signed value
+*/
+inline
+void
+put_signed( std::string & buf,
+            const long long val )
+{
+    put_varint( buf,
+                ( static_cast< unsigned long long >( val ) << 1 )
+                ^ static_cast< unsigned long long >( val >> 63 ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief append the length prefixed string
+*/
+inline
+void
+put_string( std::string & buf,
+            const std::string & str )
+{
+    put_varint( buf, str.length() );
+    buf += str;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the float value to the recorded integer value
+  \param val float value
+  \param raw if true, the bit pattern is returned.
+  \param exact set to false if the fixed point value is not equal to val.
+*/
+inline
+long long
+float_value( const float val,
+             const bool raw,
+             bool * exact )
+{
+    if ( ! raw )
+    {
+        const double scaled = std::nearbyint( static_cast< double >( val ) * REC6_FIXED_SCALE );
+        if ( std::fabs( scaled ) < 1.0e15 )
+        {
+            const long long q = static_cast< long long >( scaled );
+            const float restored = static_cast< float >( static_cast< double >( q ) / REC6_FIXED_SCALE );
+            if ( std::memcmp( &restored, &val, sizeof( float ) ) == 0 )
+            {
+                return q;
+            }
+        }
+        *exact = false;
+        return 0;
+    }
+
+    UInt32 bits = 0;
+    std::memcpy( &bits, &val, sizeof( float ) );
+    return static_cast< long long >( static_cast< unsigned int >( bits ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief convert the show data to the recorded values.
+  the order of the player values must be same as ParserV6.
+  \return false if the show cannot be represented by the fixed point values.
+*/
+bool
+to_values( const ShowInfoT & show,
+           const bool raw,
+           long long * values )
+{
+    bool exact = true;
+
+    values[0] = float_value( show.ball_.x_, raw, &exact );
+    values[1] = float_value( show.ball_.y_, raw, &exact );
+    values[2] = float_value( show.ball_.vx_, raw, &exact );
+    values[3] = float_value( show.ball_.vy_, raw, &exact );
+
+    long long * v = values + REC6_BALL_VALUES;
+    for ( const PlayerT & p : show.player_ )
+    {
+        // the frequently changed values come first to shorten the change mask
+        v[0] = float_value( p.x_, raw, &exact );
+        v[1] = float_value( p.y_, raw, &exact );
+        v[2] = float_value( p.vx_, raw, &exact );
+        v[3] = float_value( p.vy_, raw, &exact );
+        v[4] = float_value( p.body_, raw, &exact );
+        v[5] = float_value( p.neck_, raw, &exact );
+        v[6] = float_value( p.stamina_, raw, &exact );
+        v[7] = p.dash_count_;
+        v[8] = p.turn_count_;
+        v[9] = p.turn_neck_count_;
+        v[10] = p.state_;
+        v[11] = p.kick_count_;
+        v[12] = float_value( p.effort_, raw, &exact );
+        v[13] = float_value( p.recovery_, raw, &exact );
+        v[14] = p.change_view_count_;
+        v[15] = p.say_count_;
+        v[16] = p.catch_count_;
+        v[17] = p.move_count_;
+        v[18] = p.tackle_count_;
+        v[19] = p.pointto_count_;
+        v[20] = p.attentionto_count_;
+        v[21] = float_value( p.point_x_, raw, &exact );
+        v[22] = float_value( p.point_y_, raw, &exact );
+        v[23] = p.view_quality_;
+        v[24] = float_value( p.view_width_, raw, &exact );
+        v[25] = p.focus_side_;
+        v[26] = p.focus_unum_;
+        v[27] = float_value( p.stamina_capacity_, raw, &exact );
+        v[28] = p.side_;
+        v[29] = p.unum_;
+        v[30] = p.type_;
+
+        v += REC6_PLAYER_VALUES;
+    }
+
+    return exact;
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+SerializerV6::SerializerV6()
+    : SerializerV5(),
+      M_keyframe_interval( 100 ),
+      M_delta_count( 0 ),
+      M_has_prev( false ),
+      M_prev_time( 0 )
+{
+    std::memset( M_prev, 0, sizeof( M_prev ) );
+    std::memset( M_prev2, 0, sizeof( M_prev2 ) );
+    M_payload.reserve( 8192 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serializeHeader( std::ostream & os )
+{
+    return os.write( "ULG6", 4 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serializeParam( std::ostream & os,
+                              const std::string & msg )
+{
+    M_payload.assign( msg );
+    while ( ! M_payload.empty()
+            && ( *M_payload.rbegin() == '\n' || *M_payload.rbegin() == '\r' ) )
+    {
+        M_payload.erase( M_payload.length() - 1 );
+    }
+
+    return writeRecord( os, REC6_PARAM );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const server_params_t & param )
+{
+    std::ostringstream buf;
+    SerializerV4::serialize( buf, param );
+    return serializeParam( os, buf.str() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const player_params_t & pparam )
+{
+    std::ostringstream buf;
+    SerializerV4::serialize( buf, pparam );
+    return serializeParam( os, buf.str() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const player_type_t & type )
+{
+    std::ostringstream buf;
+    SerializerV4::serialize( buf, type );
+    return serializeParam( os, buf.str() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const msginfo_t & msg )
+{
+    return serialize( os, msg.board, std::string( msg.message ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const Int16 board,
+                         const std::string & msg )
+{
+    M_payload.clear();
+    put_signed( M_payload, M_time );
+    put_signed( M_payload, board );
+    put_string( M_payload, msg );
+
+    return writeRecord( os, REC6_MSG );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const char playmode )
+{
+    M_playmode = playmode;
+
+    PlayMode pm = static_cast< PlayMode >( playmode );
+    if ( pm < PM_Null || PM_MAX <= pm )
+    {
+        return os;
+    }
+
+    M_payload.clear();
+    put_signed( M_payload, M_time );
+    M_payload += playmode;
+
+    return writeRecord( os, REC6_PLAYMODE );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const TeamT & team_l,
+                         const TeamT & team_r )
+{
+    M_teams[0] = team_l;
+    M_teams[1] = team_r;
+
+    M_payload.clear();
+    put_signed( M_payload, M_time );
+    for ( const TeamT & t : M_teams )
+    {
+        put_string( M_payload, t.name_ );
+        put_varint( M_payload, t.score_ );
+        put_varint( M_payload, t.pen_score_ );
+        put_varint( M_payload, t.pen_miss_ );
+    }
+
+    return writeRecord( os, REC6_TEAM );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::serialize( std::ostream & os,
+                         const ShowInfoT & show )
+{
+    M_time = show.time_;
+
+    long long values[REC6_SHOW_VALUES];
+    const bool fixed = to_values( show, false, values );
+
+    M_payload.clear();
+
+    if ( fixed
+         && M_has_prev
+         && M_delta_count < M_keyframe_interval - 1 )
+    {
+        //
+        // delta record
+        //
+        put_signed( M_payload, static_cast< long long >( show.time_ ) - M_prev_time );
+
+        long long diffs[REC6_PLAYER_VALUES];
+        int begin = 0;
+        int size = REC6_BALL_VALUES;
+        while ( begin < REC6_SHOW_VALUES )
+        {
+            unsigned long long mask = 0;
+            for ( int j = 0; j < size; ++j )
+            {
+                const int i = begin + j;
+                const long long predicted = ( rec6_is_linear( i )
+                                              ? 2 * M_prev[i] - M_prev2[i]
+                                              : M_prev[i] );
+                diffs[j] = values[i] - predicted;
+                if ( diffs[j] != 0 )
+                {
+                    mask |= ( 1ULL << j );
+                }
+            }
+
+            put_varint( M_payload, mask );
+            for ( int j = 0; j < size; ++j )
+            {
+                if ( diffs[j] != 0 )
+                {
+                    put_signed( M_payload, diffs[j] );
+                }
+            }
+
+            begin += size;
+            size = REC6_PLAYER_VALUES;
+        }
+
+        std::memcpy( M_prev2, M_prev, sizeof( M_prev ) );
+        std::memcpy( M_prev, values, sizeof( M_prev ) );
+        M_prev_time = show.time_;
+        ++M_delta_count;
+
+        return writeRecord( os, REC6_DELTA );
+    }
+
+    //
+    // keyframe record
+    //
+    if ( ! fixed )
+    {
+        to_values( show, true, values );
+    }
+
+    put_signed( M_payload, show.time_ );
+    M_payload += static_cast< char >( fixed ? 0 : 1 );
+    for ( int i = 0; i < REC6_SHOW_VALUES; ++i )
+    {
+        put_signed( M_payload, values[i] );
+    }
+
+    // the raw values cannot be used for the prediction
+    M_has_prev = fixed;
+    std::memcpy( M_prev, values, sizeof( M_prev ) );
+    std::memcpy( M_prev2, values, sizeof( M_prev2 ) );
+    M_prev_time = show.time_;
+    M_delta_count = 0;
+
+    return writeRecord( os, REC6_KEYFRAME );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+SerializerV6::writeRecord( std::ostream & os,
+                           const RecordTagV6 tag )
+{
+    std::string header;
+    header += static_cast< char >( tag );
+    put_varint( header, M_payload.length() );
+
+    os.write( header.data(), header.length() );
+    return os.write( M_payload.data(), M_payload.length() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+namespace {
+
+Serializer::Ptr
+create_v6()
+{
+    Serializer::Ptr ptr( new SerializerV6() );
+    return ptr;
+}
+
+rcss::RegHolder v6 = Serializer::creators().autoReg( &create_v6, REC_VERSION_6 );
+
+}
+
+} // end of namespace
+} // end of namespace
@@ -0,0 +1,228 @@
+// -*-c++-*-
+
+/*!
+  \file serializer_v6.h
+  \brief v6 format rcg serializer class Header File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_RCG_SERIALIZER_V6_H
+#define RCSC_RCG_SERIALIZER_V6_H
+
+#include <rcsc/rcg/serializer_v5.h>
+
+#include <string>
+
+namespace rcsc {
+namespace rcg {
+
+/*!
+  \class SerializerV6
+  \brief v6 format (binary, delta-encoded) rcg serializer class
+
+  The file starts with "ULG6" and continues with the records defined by
+  RecordTagV6. Integers are written as LEB128 varints, and signed values
+  are zigzag encoded.
+
+  A show data is converted to REC6_SHOW_VALUES integer values: the ball
+  and then the players. Float values are converted to fixed point values
+  scaled by REC6_FIXED_SCALE. A keyframe record contains the time, the
+  encoding byte (0: fixed point, 1: raw float bits) and all values.
+  A delta record contains the time difference, and the change mask and
+  the changed value differences of the ball and each player. The
+  positions are predicted from the last two shows.
+
+  A keyframe is written at every keyframe interval, so that a reader can
+  start decoding at any keyframe. A show that cannot be represented by
+  the fixed point values without loss is written as a raw keyframe, and
+  the next show is also written as a keyframe.
+*/
+class SerializerV6
+    : public SerializerV5 {
+private:
+
+    //! the number of shows between keyframes
+    int M_keyframe_interval;
+
+    //! the number of shows written after the last keyframe
+    int M_delta_count;
+
+    //! true if M_prev values can be used for the next delta record
+    bool M_has_prev;
+
+    //! the time of the last show
+    Int32 M_prev_time;
+
+    //! the values of the last show
+    long long M_prev[REC6_SHOW_VALUES];
+
+    //! the values of the show before the last show
+    long long M_prev2[REC6_SHOW_VALUES];
+
+    //! reusable payload buffer
+    std::string M_payload;
+
+public:
+
+    /*!
+      \brief constructor
+    */
+    SerializerV6();
+
+    /*!
+      \brief destructor
+    */
+    ~SerializerV6()
+      { }
+
+    /*!
+      \brief set the keyframe interval
+      \param interval the number of shows between keyframes. at least 1.
+    */
+    void setKeyframeInterval( const int interval )
+      {
+          M_keyframe_interval = ( interval < 1 ? 1 : interval );
+      }
+
+    /*!
+      \brief write header
+      \param os reference to the output stream
+      \return serialization result
+    */
+    virtual
+    std::ostream & serializeHeader( std::ostream & os );
+
+    /*!
+      \brief write parameter message
+      \param os reference to the output stream
+      \param msg server parameter message
+      \return reference to the output stream
+    */
+    virtual
+    std::ostream & serializeParam( std::ostream & os,
+                                   const std::string & msg );
+
+    /*!
+      \brief write server param
+      \param os reference to the output stream
+      \param param network byte order data
+      \return serialization result
+    */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const server_params_t & param );
+
+    /*!
+      \brief write player param
+      \param os reference to the output stream
+      \param pparam network byte order data
+      \return serialization result
+    */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const player_params_t & pparam );
+
+    /*!
+      \brief write player type param
+      \param os reference to the output stream
+      \param type network byte order data
+      \return serialization result
+    */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const player_type_t & type );
+
+    /*!
+      \brief write message info
+      \param os reference to the output stream
+      \param msg network byte order data
+      \return serialization result
+    */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const msginfo_t & msg );
+
+    /*!
+      \brief write message info
+      \param os reference to the output stream
+      \param board message board type
+      \param msg message string
+      \return reference to the output stream
+    */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const Int16 board,
+                              const std::string & msg );
+
+    /*!
+      \brief write playmode
+      \param os reference to the output stream
+      \param playmode play mode variable
+      \return reference to the output stream
+    */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const char playmode );
+
+    /*!
+      \brief write team info
+      \param os reference to the output stream
+      \param team_l left team variable
+      \param team_r right team variable
+      \return reference to the output stream
+    */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const TeamT & team_l,
+                              const TeamT & team_r );
+
+    /*!
+      \brief write ShowInfoT as a keyframe or a delta record
+      \param os reference to the output stream
+      \param show data to be written
+      \return reference to the output stream
+     */
+    virtual
+    std::ostream & serialize( std::ostream & os,
+                              const ShowInfoT & show );
+
+private:
+
+    /*!
+      \brief write the record with M_payload
+      \param os reference to the output stream
+      \param tag record tag
+      \return reference to the output stream
+     */
+    std::ostream & writeRecord( std::ostream & os,
+                                const RecordTagV6 tag );
+
+};
+
+} // end of namespace rcg
+} // end of namespace rcsc
+
+#endif
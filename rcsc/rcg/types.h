@@ -1131,6 +1131,36 @@ const int REC_VERSION_4 = 4;
 //! recorded value of rcg v5
 const int REC_VERSION_5 = 5;
 
+/*-------------------------------------------------------------------*/
+// game log format version 6 (binary, delta-encoded)
+
+//! recorded value of rcg v6
+const int REC_VERSION_6 = 6;
+
+/*!
+  \brief record tags of rcg v6.
+
+  Each record consists of the tag byte, the payload size as a varint and
+  the payload. The payload of the show records is described in SerializerV6.
+ */
+enum RecordTagV6 {
+    REC6_PARAM = 'P', //!< server_param, player_param or player_type message string
+    REC6_PLAYMODE = 'M', //!< time, playmode id
+    REC6_TEAM = 'T', //!< time, left team, right team
+    REC6_MSG = 'G', //!< time, board, message string
+    REC6_KEYFRAME = 'K', //!< show data written by absolute values
+    REC6_DELTA = 'D', //!< show data written by the difference from the previous show
+};
+
+//! scaling factor of the fixed point values in rcg v6
+const double REC6_FIXED_SCALE = 10000.0;
+//! the number of values of the ball in rcg v6 show data
+const int REC6_BALL_VALUES = 4;
+//! the number of values of a player in rcg v6 show data
+const int REC6_PLAYER_VALUES = 31;
+//! the number of values in rcg v6 show data
+const int REC6_SHOW_VALUES = REC6_BALL_VALUES + REC6_PLAYER_VALUES * MAX_PLAYER * 2;
+
 //! default rcg version
 const int DEFAULT_LOG_VERSION = REC_VERSION_5;
 
@@ -453,6 +453,28 @@ to_string( const server_params_t & from );
 std::string
 to_string( const player_params_t & from );
 
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the rcg v6 show value is predicted by the change in the
+  last two shows. the positions and the stamina are predicted. other values
+  are predicted by the last value. SerializerV6 and ParserV6 must use the
+  same prediction.
+  \param i index of the value in the show data
+  \return true if the value is linearly predicted
+*/
+inline
+bool
+rec6_is_linear( const int i )
+{
+    if ( i < REC6_BALL_VALUES )
+    {
+        return i < 2;
+    }
+
+    const int j = ( i - REC6_BALL_VALUES ) % REC6_PLAYER_VALUES;
+    return j < 2 || j == 6;
+}
+
 } // end namespace
 } // end namespace
 
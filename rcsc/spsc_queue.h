@@ -0,0 +1,256 @@
+// -*-c++-*-
+
+/*!
+  \file spsc_queue.h
+  \brief bounded lock-free single producer single consumer queue Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_SPSC_QUEUE_H
+#define RCSC_SPSC_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class SPSCQueue
+  \brief bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+
+  push() and pop() spin for a short time while the queue is full or empty,
+  and then block on the condition variable until the other side makes
+  progress. tryPush() and tryPop() never block, and they wake the
+  blocked side only if it is waiting.
+  T must be default constructible and movable.
+*/
+template < typename T >
+class SPSCQueue {
+private:
+
+    //! the size of the ring buffer. one slot is always empty.
+    const std::size_t M_size;
+
+    //! ring buffer
+    std::vector< T > M_buffer;
+
+    //! the next slot to be popped. written only by the consumer.
+    alignas( 64 ) std::atomic< std::size_t > M_head;
+
+    //! the next slot to be pushed. written only by the producer.
+    alignas( 64 ) std::atomic< std::size_t > M_tail;
+
+    //! true while the producer is blocked in push()
+    alignas( 64 ) std::atomic< bool > M_producer_waiting;
+
+    //! true while the consumer is blocked in pop()
+    std::atomic< bool > M_consumer_waiting;
+
+    //! guard for the blocking wait
+    std::mutex M_mutex;
+
+    //! signaled when a blocked side may continue
+    std::condition_variable M_cond;
+
+    //! the number of the retries before blocking
+    enum {
+        SPIN_COUNT = 64,
+    };
+
+    // noncopyable
+    SPSCQueue( const SPSCQueue & );
+    SPSCQueue & operator=( const SPSCQueue & );
+
+public:
+
+    /*!
+      \brief allocate the ring buffer
+      \param capacity the max number of queued elements
+     */
+    explicit
+    SPSCQueue( const std::size_t capacity )
+        : M_size( capacity + 1 ),
+          M_buffer( capacity + 1 ),
+          M_head( 0 ),
+          M_tail( 0 ),
+          M_producer_waiting( false ),
+          M_consumer_waiting( false )
+      { }
+
+    /*!
+      \brief try to push the value. called only by the producer.
+      \param value moved into the queue if succeeded
+      \return false if the queue is full
+     */
+    bool tryPush( T & value )
+      {
+          if ( ! enqueue( value ) )
+          {
+              return false;
+          }
+
+          wakeUp( M_consumer_waiting );
+          return true;
+      }
+
+    /*!
+      \brief try to pop the oldest value. called only by the consumer.
+      \param value the popped value is moved into this variable
+      \return false if the queue is empty
+     */
+    bool tryPop( T & value )
+      {
+          if ( ! dequeue( value ) )
+          {
+              return false;
+          }
+
+          wakeUp( M_producer_waiting );
+          return true;
+      }
+
+    /*!
+      \brief push the value. wait while the queue is full.
+      \param value pushed value
+     */
+    void push( T value )
+      {
+          for ( int i = 0; i < SPIN_COUNT; ++i )
+          {
+              if ( tryPush( value ) ) return;
+              std::this_thread::yield();
+          }
+
+          std::unique_lock< std::mutex > lock( M_mutex );
+          M_producer_waiting.store( true, std::memory_order_relaxed );
+          std::atomic_thread_fence( std::memory_order_seq_cst );
+          while ( ! enqueue( value ) )
+          {
+              M_cond.wait( lock );
+          }
+          M_producer_waiting.store( false, std::memory_order_relaxed );
+          notifyLocked( M_consumer_waiting );
+      }
+
+    /*!
+      \brief pop the oldest value. wait while the queue is empty.
+      \return the popped value
+     */
+    T pop()
+      {
+          T value;
+          for ( int i = 0; i < SPIN_COUNT; ++i )
+          {
+              if ( tryPop( value ) ) return value;
+              std::this_thread::yield();
+          }
+
+          std::unique_lock< std::mutex > lock( M_mutex );
+          M_consumer_waiting.store( true, std::memory_order_relaxed );
+          std::atomic_thread_fence( std::memory_order_seq_cst );
+          while ( ! dequeue( value ) )
+          {
+              M_cond.wait( lock );
+          }
+          M_consumer_waiting.store( false, std::memory_order_relaxed );
+          notifyLocked( M_producer_waiting );
+          return value;
+      }
+
+private:
+
+    /*!
+      \brief move the value into the ring buffer without the notification
+      \return false if the queue is full
+     */
+    bool enqueue( T & value )
+      {
+          const std::size_t tail = M_tail.load( std::memory_order_relaxed );
+          const std::size_t next = ( tail + 1 == M_size ? 0 : tail + 1 );
+          if ( next == M_head.load( std::memory_order_acquire ) )
+          {
+              return false;
+          }
+
+          M_buffer[tail] = std::move( value );
+          M_tail.store( next, std::memory_order_release );
+          return true;
+      }
+
+    /*!
+      \brief move the oldest value out of the ring buffer without the notification
+      \return false if the queue is empty
+     */
+    bool dequeue( T & value )
+      {
+          const std::size_t head = M_head.load( std::memory_order_relaxed );
+          if ( head == M_tail.load( std::memory_order_acquire ) )
+          {
+              return false;
+          }
+
+          value = std::move( M_buffer[head] );
+          M_head.store( ( head + 1 == M_size ? 0 : head + 1 ), std::memory_order_release );
+          return true;
+      }
+
+    /*!
+      \brief notify the blocked side after the index is updated
+      \param waiting the waiting flag of the other side
+     */
+    void wakeUp( const std::atomic< bool > & waiting )
+      {
+          // pairs with the fence in push() and pop(). either this thread
+          // sees the flag, or the waiting thread sees the updated index.
+          std::atomic_thread_fence( std::memory_order_seq_cst );
+          if ( waiting.load( std::memory_order_relaxed ) )
+          {
+              std::lock_guard< std::mutex > lock( M_mutex );
+              M_cond.notify_all();
+          }
+      }
+
+    /*!
+      \brief notify the blocked side. called while M_mutex is locked.
+      \param waiting the waiting flag of the other side
+     */
+    void notifyLocked( const std::atomic< bool > & waiting )
+      {
+          std::atomic_thread_fence( std::memory_order_seq_cst );
+          if ( waiting.load( std::memory_order_relaxed ) )
+          {
+              M_cond.notify_all();
+          }
+      }
+};
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+// -*-c++-*-
+
+/*!
+  \file thread_pool.h
+  \brief work stealing thread pool Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_THREAD_POOL_H
+#define RCSC_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+namespace rcsc {
+
+/*!
+  \class ThreadPool
+  \brief fixed size thread pool with per-worker task queues.
+
+  Submitted tasks are distributed to the worker queues in round-robin order.
+  Each worker pops tasks from the front of its own queue,
+  so tasks are started in roughly the submitted order.
+  An idle worker steals tasks from the back of the other queues.
+*/
+class ThreadPool {
+public:
+
+    //! task type
+    typedef std::function< void() > Task;
+
+private:
+
+    /*!
+      \struct Queue
+      \brief per-worker task queue
+     */
+    struct Queue {
+        std::mutex mutex_; //!< guard for tasks_
+        std::deque< Task > tasks_; //!< queued tasks
+    };
+
+    //! task queues. the size is same as M_threads.
+    std::vector< std::unique_ptr< Queue > > M_queues;
+
+    //! worker threads
+    std::vector< std::thread > M_threads;
+
+    //! guard for the sleeping workers and the waiting callers
+    std::mutex M_mutex;
+
+    //! notified when a task is queued or the pool is stopped
+    std::condition_variable M_task_cond;
+
+    //! notified when all tasks are finished
+    std::condition_variable M_done_cond;
+
+    //! the number of tasks in the queues
+    std::size_t M_queued;
+
+    //! the number of tasks not finished yet
+    std::size_t M_pending;
+
+    //! round-robin index for submit()
+    std::atomic< std::size_t > M_next_queue;
+
+    //! stop flag
+    bool M_stop;
+
+    // noncopyable
+    ThreadPool( const ThreadPool & );
+    ThreadPool & operator=( const ThreadPool & );
+
+public:
+
+    /*!
+      \brief create worker threads
+      \param n_threads the number of workers. if 0, the number of hardware threads is used.
+     */
+    explicit
+    ThreadPool( const std::size_t n_threads = 0 );
+
+    /*!
+      \brief wait all tasks and join the workers
+     */
+    ~ThreadPool();
+
+    /*!
+      \brief get the number of workers
+      \return the number of workers
+     */
+    std::size_t size() const
+      {
+          return M_threads.size();
+      }
+
+    /*!
+      \brief queue the task
+      \param task function object executed by a worker
+     */
+    void submit( const Task & task );
+
+    /*!
+      \brief block until all submitted tasks are finished
+     */
+    void wait();
+
+    /*!
+      \brief get the default number of workers
+      \return the number of hardware threads, at least 1.
+     */
+    static
+    std::size_t default_size();
+
+private:
+
+    void run( const std::size_t index );
+
+    bool pop( const std::size_t index,
+              Task & task );
+};
+
+}
+
+#endif
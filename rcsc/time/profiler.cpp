@@ -0,0 +1,327 @@
+// -*-c++-*-
+
+/*!
+  \file profiler.cpp
+  \brief scoped zone profiler Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <limits>
+#include <cstdio>
+
+namespace rcsc {
+
+namespace {
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief floor( log2( v ) ) for v > 0
+*/
+inline
+int
+floor_log2( std::uint64_t v )
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll( static_cast< unsigned long long >( v ) );
+#else
+    int n = 0;
+    while ( v >>= 1 ) ++n;
+    return n;
+#endif
+}
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ProfileHistogram::ProfileHistogram()
+{
+    clear();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ProfileHistogram::clear()
+{
+    for ( int i = 0; i < BUCKET_SIZE; ++i )
+    {
+        M_counts[i].store( 0, std::memory_order_relaxed );
+    }
+    M_total_count.store( 0, std::memory_order_relaxed );
+    M_sum.store( 0, std::memory_order_relaxed );
+    M_min.store( std::numeric_limits< std::uint64_t >::max(), std::memory_order_relaxed );
+    M_max.store( 0, std::memory_order_relaxed );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ProfileHistogram::record( const std::uint64_t usec )
+{
+    M_counts[bucket_index( usec )].fetch_add( 1, std::memory_order_relaxed );
+    M_total_count.fetch_add( 1, std::memory_order_relaxed );
+    M_sum.fetch_add( usec, std::memory_order_relaxed );
+
+    std::uint64_t cur = M_min.load( std::memory_order_relaxed );
+    while ( usec < cur
+            && ! M_min.compare_exchange_weak( cur, usec, std::memory_order_relaxed ) )
+    {
+    }
+
+    cur = M_max.load( std::memory_order_relaxed );
+    while ( usec > cur
+            && ! M_max.compare_exchange_weak( cur, usec, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+ProfileHistogram::min() const
+{
+    return ( count() == 0
+             ? 0
+             : M_min.load( std::memory_order_relaxed ) );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+double
+ProfileHistogram::mean() const
+{
+    const std::uint64_t n = count();
+    if ( n == 0 )
+    {
+        return 0.0;
+    }
+
+    return static_cast< double >( M_sum.load( std::memory_order_relaxed ) )
+        / static_cast< double >( n );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+ProfileHistogram::valueAtPercentile( const double percentile ) const
+{
+    const std::uint64_t n = count();
+    if ( n == 0 )
+    {
+        return 0;
+    }
+
+    const double rate = std::min( 100.0, std::max( 0.0, percentile ) ) / 100.0;
+    const std::uint64_t target = std::max( static_cast< std::uint64_t >( 1 ),
+                                           static_cast< std::uint64_t >( rate * n + 0.5 ) );
+
+    std::uint64_t total = 0;
+    for ( int i = 0; i < BUCKET_SIZE; ++i )
+    {
+        total += M_counts[i].load( std::memory_order_relaxed );
+        if ( total >= target )
+        {
+            return std::min( bucket_highest_value( i ), max() );
+        }
+    }
+
+    return max();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+ProfileHistogram::bucket_index( const std::uint64_t usec )
+{
+    if ( usec < static_cast< std::uint64_t >( SUB_BUCKET_HALF * 2 ) )
+    {
+        return static_cast< int >( usec );
+    }
+
+    const int magnitude = floor_log2( usec ) - SUB_BUCKET_BITS;
+    if ( magnitude > MAX_MAGNITUDE )
+    {
+        return BUCKET_SIZE - 1;
+    }
+
+    return magnitude * SUB_BUCKET_HALF + static_cast< int >( usec >> magnitude );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::uint64_t
+ProfileHistogram::bucket_highest_value( const int index )
+{
+    if ( index < SUB_BUCKET_HALF * 2 )
+    {
+        return static_cast< std::uint64_t >( index );
+    }
+
+    const int magnitude = index / SUB_BUCKET_HALF - 1;
+    const std::uint64_t sub = static_cast< std::uint64_t >( index - magnitude * SUB_BUCKET_HALF );
+
+    return ( ( sub + 1 ) << magnitude ) - 1;
+}
+
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+
+std::atomic< bool > Profiler::S_enabled( false );
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Profiler::Profiler()
+    : M_zone_size( 0 )
+{
+
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+Profiler &
+Profiler::instance()
+{
+    static Profiler s_instance;
+    return s_instance;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+int
+Profiler::registerZone( const char * name )
+{
+    std::lock_guard< std::mutex > lock( M_mutex );
+
+    const int size = M_zone_size.load( std::memory_order_relaxed );
+    for ( int i = 0; i < size; ++i )
+    {
+        if ( M_names[i] == name )
+        {
+            return i;
+        }
+    }
+
+    if ( size >= MAX_ZONES )
+    {
+        std::cerr << "(Profiler::registerZone) too many zones. "
+                  << name << " is ignored." << std::endl;
+        return -1;
+    }
+
+    M_names[size] = name;
+    M_histograms[size].reset( new ProfileHistogram() );
+    M_zone_size.store( size + 1, std::memory_order_release );
+
+    return size;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+Profiler::clear()
+{
+    const int size = zoneSize();
+    for ( int i = 0; i < size; ++i )
+    {
+        M_histograms[i]->clear();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::ostream &
+Profiler::print( std::ostream & os ) const
+{
+    char buf[256];
+
+    std::snprintf( buf, sizeof( buf ),
+                   "%-32s %8s %9s %9s %9s %9s %9s %9s %9s [ms]\n",
+                   "zone", "count", "mean", "min",
+                   "p50", "p90", "p99", "p99.9", "max" );
+    os << buf;
+
+    const int size = zoneSize();
+    for ( int i = 0; i < size; ++i )
+    {
+        const ProfileHistogram & h = *M_histograms[i];
+        if ( h.count() == 0 )
+        {
+            continue;
+        }
+
+        std::snprintf( buf, sizeof( buf ),
+                       "%-32s %8llu %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+                       M_names[i].c_str(),
+                       static_cast< unsigned long long >( h.count() ),
+                       h.mean() * 0.001,
+                       h.min() * 0.001,
+                       h.valueAtPercentile( 50.0 ) * 0.001,
+                       h.valueAtPercentile( 90.0 ) * 0.001,
+                       h.valueAtPercentile( 99.0 ) * 0.001,
+                       h.valueAtPercentile( 99.9 ) * 0.001,
+                       h.max() * 0.001 );
+        os << buf;
+    }
+
+    return os << std::flush;
+}
+
+}
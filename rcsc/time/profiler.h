@@ -0,0 +1,341 @@
+// -*-c++-*-
+
+/*!
+  \file profiler.h
+  \brief scoped zone profiler Header File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifndef RCSC_TIME_PROFILER_H
+#define RCSC_TIME_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <iostream>
+#include <cstdint>
+
+namespace rcsc {
+
+/*!
+  \class ProfileHistogram
+  \brief log-linear latency histogram in micro seconds.
+
+  Values are grouped by their power of two magnitude, and each magnitude is
+  divided into SUB_BUCKET_HALF linear sub buckets. The relative error of the
+  reported values is less than 1/SUB_BUCKET_HALF. All counters are atomic
+  so that several threads can record values without any lock.
+*/
+class ProfileHistogram {
+public:
+    enum {
+        SUB_BUCKET_BITS = 5, //!< log2 of SUB_BUCKET_HALF
+        SUB_BUCKET_HALF = 1 << SUB_BUCKET_BITS, //!< the number of sub buckets in each magnitude
+        MAX_MAGNITUDE = 26, //!< values over 2^(MAX_MAGNITUDE + SUB_BUCKET_BITS + 1) usec are clamped
+        BUCKET_SIZE = ( MAX_MAGNITUDE + 2 ) * SUB_BUCKET_HALF, //!< the number of counters
+    };
+
+private:
+    std::atomic< std::uint64_t > M_counts[BUCKET_SIZE]; //!< counter for each bucket
+    std::atomic< std::uint64_t > M_total_count; //!< the number of recorded values
+    std::atomic< std::uint64_t > M_sum; //!< sum of recorded values
+    std::atomic< std::uint64_t > M_min; //!< minimal recorded value
+    std::atomic< std::uint64_t > M_max; //!< maximal recorded value
+
+    // noncopyable
+    ProfileHistogram( const ProfileHistogram & );
+    ProfileHistogram & operator=( const ProfileHistogram & );
+
+public:
+    /*!
+      \brief create an empty histogram
+     */
+    ProfileHistogram();
+
+    /*!
+      \brief reset all counters
+     */
+    void clear();
+
+    /*!
+      \brief add the value
+      \param usec measured value [micro sec]
+     */
+    void record( const std::uint64_t usec );
+
+    /*!
+      \brief get the number of recorded values
+      \return the number of recorded values
+     */
+    std::uint64_t count() const
+      {
+          return M_total_count.load( std::memory_order_relaxed );
+      }
+
+    /*!
+      \brief get the minimal recorded value
+      \return minimal value [micro sec]. 0 if empty.
+     */
+    std::uint64_t min() const;
+
+    /*!
+      \brief get the maximal recorded value
+      \return maximal value [micro sec]
+     */
+    std::uint64_t max() const
+      {
+          return M_max.load( std::memory_order_relaxed );
+      }
+
+    /*!
+      \brief get the average of recorded values
+      \return average value [micro sec]
+     */
+    double mean() const;
+
+    /*!
+      \brief get the value at the given percentile
+      \param percentile percentile in [0, 100]
+      \return the highest value equivalent to the bucket that contains the percentile [micro sec]
+     */
+    std::uint64_t valueAtPercentile( const double percentile ) const;
+
+    /*!
+      \brief get the bucket index of the value
+      \param usec value
+      \return bucket index
+     */
+    static
+    int bucket_index( const std::uint64_t usec );
+
+    /*!
+      \brief get the highest value contained by the bucket
+      \param index bucket index
+      \return highest value in the bucket
+     */
+    static
+    std::uint64_t bucket_highest_value( const int index );
+};
+
+/*!
+  \class Profiler
+  \brief process wide registry of the profile zones.
+
+  The zones are usually defined by RCSC_PROFILE_ZONE(), and the profiler is
+  disabled by default. When disabled, a zone costs only one relaxed atomic
+  load. When RCSC_DISABLE_PROFILER is defined, RCSC_PROFILE_ZONE() is
+  expanded to nothing.
+*/
+class Profiler {
+public:
+    enum {
+        MAX_ZONES = 64, //!< the maximal number of zones
+    };
+
+private:
+    //! profiler switch
+    static std::atomic< bool > S_enabled;
+
+    //! lock for zone registration
+    mutable std::mutex M_mutex;
+
+    //! zone names
+    std::string M_names[MAX_ZONES];
+
+    //! zone histograms
+    std::unique_ptr< ProfileHistogram > M_histograms[MAX_ZONES];
+
+    //! the number of registered zones
+    std::atomic< int > M_zone_size;
+
+    /*!
+      \brief private for singleton
+     */
+    Profiler();
+
+    // noncopyable
+    Profiler( const Profiler & );
+    Profiler & operator=( const Profiler & );
+
+public:
+
+    /*!
+      \brief singleton interface
+      \return reference to the singleton instance
+     */
+    static
+    Profiler & instance();
+
+    /*!
+      \brief set the profiler switch
+      \param on if true, the zones start to record the elapsed time
+     */
+    static
+    void setEnabled( const bool on )
+      {
+          S_enabled.store( on, std::memory_order_relaxed );
+      }
+
+    /*!
+      \brief get the profiler switch
+      \return true if the zones are recorded
+     */
+    static
+    bool isEnabled()
+      {
+          return S_enabled.load( std::memory_order_relaxed );
+      }
+
+    /*!
+      \brief register the zone. the same id is returned for the same name.
+      \param name zone name
+      \return zone id. -1 if no more zone can be registered.
+     */
+    int registerZone( const char * name );
+
+    /*!
+      \brief add the elapsed time of the zone
+      \param zone zone id
+      \param usec elapsed time [micro sec]
+     */
+    void record( const int zone,
+                 const std::uint64_t usec )
+      {
+          if ( 0 <= zone && zone < M_zone_size.load( std::memory_order_acquire ) )
+          {
+              M_histograms[zone]->record( usec );
+          }
+      }
+
+    /*!
+      \brief get the number of registered zones
+      \return the number of registered zones
+     */
+    int zoneSize() const
+      {
+          return M_zone_size.load( std::memory_order_acquire );
+      }
+
+    /*!
+      \brief get the zone name
+      \param zone zone id
+      \return const reference to the name string
+     */
+    const std::string & zoneName( const int zone ) const
+      {
+          return M_names[zone];
+      }
+
+    /*!
+      \brief get the zone histogram
+      \param zone zone id
+      \return const reference to the histogram
+     */
+    const ProfileHistogram & histogram( const int zone ) const
+      {
+          return *M_histograms[zone];
+      }
+
+    /*!
+      \brief reset all histograms. registered zones are kept.
+     */
+    void clear();
+
+    /*!
+      \brief put the summary of the zones that have any value
+      \param os reference to the output stream
+      \return reference to the output stream
+     */
+    std::ostream & print( std::ostream & os ) const;
+};
+
+/*!
+  \class ProfileScope
+  \brief records the elapsed time between its construction and destruction
+*/
+class ProfileScope {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    const int M_zone; //!< zone id. negative if not recorded.
+    Clock::time_point M_start; //!< construction time
+
+    // noncopyable
+    ProfileScope( const ProfileScope & );
+    ProfileScope & operator=( const ProfileScope & );
+
+public:
+    /*!
+      \brief start the measurement if the profiler is enabled
+      \param zone zone id returned by Profiler::registerZone()
+     */
+    explicit
+    ProfileScope( const int zone )
+        : M_zone( Profiler::isEnabled() ? zone : -1 )
+      {
+          if ( M_zone >= 0 )
+          {
+              M_start = Clock::now();
+          }
+      }
+
+    /*!
+      \brief record the elapsed time
+     */
+    ~ProfileScope()
+      {
+          if ( M_zone >= 0 )
+          {
+              const Clock::duration elapsed = Clock::now() - M_start;
+              Profiler::instance().record( M_zone,
+                                           static_cast< std::uint64_t >
+                                           ( std::chrono::duration_cast< std::chrono::microseconds >( elapsed ).count() ) );
+          }
+      }
+};
+
+}
+
+#define RCSC_PROFILE_CONCAT_IMPL( a, b ) a ## b
+#define RCSC_PROFILE_CONCAT( a, b ) RCSC_PROFILE_CONCAT_IMPL( a, b )
+
+#ifndef RCSC_DISABLE_PROFILER
+/*!
+  \def RCSC_PROFILE_ZONE( name )
+  \brief measure the rest of the current block as the named zone
+ */
+#define RCSC_PROFILE_ZONE( name )                                       \
+    static const int RCSC_PROFILE_CONCAT( rcsc_profile_zone_, __LINE__ ) \
+        = rcsc::Profiler::instance().registerZone( name );              \
+    rcsc::ProfileScope RCSC_PROFILE_CONCAT( rcsc_profile_scope_, __LINE__ ) \
+        ( RCSC_PROFILE_CONCAT( rcsc_profile_zone_, __LINE__ ) )
+#else
+#define RCSC_PROFILE_ZONE( name )
+#endif
+
+#endif
@@ -36,6 +36,7 @@
 #include <rcsc/timer.h>
 
 #include <iostream>
+#include <limits>
 #include <cstdio> // perror
 #include <sys/time.h> // struct timeval, gettimeofday()
 
@@ -263,4 +264,24 @@ Timer::elapsed( long * hour,
     return total_msec;
 }
 
+/////////////////////////////////////////////////////////////////////
+
+/*-------------------------------------------------------------------*/
+/*!
+
+*/
+double
+Deadline::remaining() const
+{
+    if ( ! isLimited() )
+    {
+        return std::numeric_limits< double >::max();
+    }
+
+    TimeStamp current;
+    current.setCurrent();
+
+    return M_budget_msec - current.getRealMSecDiffFrom( M_start_time );
+}
+
 }
@@ -214,6 +214,108 @@ public:
                   long * mseconds ) const;
 };
 
+/////////////////////////////////////////////////////////////////////
+
+/*!
+  \class Deadline
+  \brief time limit of a computation.
+
+  The default instance has no limit. Anytime algorithms check
+  isExpired() periodically and return the best result so far if the
+  deadline has been reached.
+ */
+class Deadline {
+private:
+    //! reference time
+    TimeStamp M_start_time;
+    //! available milli seconds from M_start_time. negative value means no limit.
+    double M_budget_msec;
+
+public:
+    /*!
+      \brief create an unlimited deadline
+     */
+    Deadline()
+        : M_budget_msec( -1.0 )
+      { }
+
+    /*!
+      \brief create a deadline
+      \param start_time reference time
+      \param budget_msec available milli seconds from start_time
+     */
+    Deadline( const TimeStamp & start_time,
+              const double budget_msec )
+        : M_start_time( start_time ),
+          M_budget_msec( budget_msec )
+      { }
+
+    /*!
+      \brief remove the limit
+     */
+    void setUnlimited()
+      {
+          M_budget_msec = -1.0;
+      }
+
+    /*!
+      \brief set the deadline
+      \param start_time reference time
+      \param budget_msec available milli seconds from start_time. negative value is treated as 0.
+     */
+    void set( const TimeStamp & start_time,
+              const double budget_msec )
+      {
+          M_start_time = start_time;
+          M_budget_msec = ( budget_msec < 0.0 ? 0.0 : budget_msec );
+      }
+
+    /*!
+      \brief check if this deadline has a limit
+      \return true if this deadline has a limit
+     */
+    bool isLimited() const
+      {
+          return M_budget_msec >= 0.0;
+      }
+
+    /*!
+      \brief get the reference time
+      \return const reference to the time stamp
+     */
+    const TimeStamp & startTime() const
+      {
+          return M_start_time;
+      }
+
+    /*!
+      \brief get the available milli seconds from the reference time
+      \return milli seconds. negative value if no limit.
+     */
+    double budget() const
+      {
+          return M_budget_msec;
+      }
+
+    /*!
+      \brief get the remaining milli seconds
+      \return remaining milli seconds. negative if already expired.
+      std::numeric_limits< double >::max() if no limit.
+     */
+    double remaining() const;
+
+    /*!
+      \brief check if the deadline has been reached
+      \param margin_msec safety margin in milli seconds
+      \return true if the remaining time is not greater than the margin
+     */
+    bool isExpired( const double margin_msec = 0.0 ) const
+      {
+          return isLimited()
+              && remaining() <= margin_msec;
+      }
+};
+
 }
 
 #endif
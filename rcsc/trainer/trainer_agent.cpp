@@ -84,6 +84,13 @@ struct TrainerAgent::Impl {
     //! referee info
     GameMode game_mode_;
 
+    //! true if server_param message has been received
+    bool server_param_received_;
+    //! true if player_param message has been received
+    bool player_param_received_;
+    //! the number of received player_type messages
+    int player_type_count_;
+
     //! visual sensor data
     CoachVisualSensor visual_;
 
@@ -95,7 +102,10 @@ struct TrainerAgent::Impl {
           think_received_( false ),
           server_cycle_stopped_( true ),
           last_decision_time_( -1, 0 ),
-          current_time_( 0, 0 )
+          current_time_( 0, 0 ),
+          server_param_received_( false ),
+          player_param_received_( false ),
+          player_type_count_( 0 )
       { }
 
     /*!
@@ -630,6 +640,24 @@ TrainerAgent::handleTimeout( const int /*timeout_count*/,
 /*-------------------------------------------------------------------*/
 /*!
 
+*/
+bool
+TrainerAgent::parametersReceived() const
+{
+    if ( config().version() < 7.0 )
+    {
+        // parameter messages are not sent to the old version client.
+        return true;
+    }
+
+    return ( M_impl->server_param_received_
+             && M_impl->player_param_received_
+             && M_impl->player_type_count_ >= PlayerParam::i().playerTypes() );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
 */
 void
 TrainerAgent::handleExit()
@@ -994,6 +1022,7 @@ TrainerAgent::Impl::analyzePlayerType( const char * msg )
 {
     PlayerType player_type( msg, agent_.config().version() );
     PlayerTypeSet::instance().insert( player_type );
+    ++player_type_count_;
 
     agent_.handlePlayerType();
 }
@@ -1006,6 +1035,7 @@ void
 TrainerAgent::Impl::analyzePlayerParam( const char * msg )
 {
     PlayerParam::instance().parse( msg, agent_.config().version() );
+    player_param_received_ = true;
 
     agent_.handlePlayerParam();
 }
@@ -1018,6 +1048,7 @@ void
 TrainerAgent::Impl::analyzeServerParam( const char * msg )
 {
     ServerParam::instance().parse( msg, agent_.config().version() );
+    server_param_received_ = true;
     PlayerTypeSet::instance().resetDefaultType();
 
     // update alarm interval
@@ -0,0 +1,219 @@
+// -*-c++-*-
+
+/*!
+  \file thread_pool.cpp
+  \brief work stealing thread pool Source File
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "../thread_pool.h"
+
+#include <iostream>
+#include <exception>
+
+namespace rcsc {
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+std::size_t
+ThreadPool::default_size()
+{
+    const unsigned int n = std::thread::hardware_concurrency();
+    return ( n == 0 ? 1 : n );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThreadPool::ThreadPool( const std::size_t n_threads )
+    : M_queued( 0 ),
+      M_pending( 0 ),
+      M_next_queue( 0 ),
+      M_stop( false )
+{
+    const std::size_t n = ( n_threads == 0 ? default_size() : n_threads );
+
+    M_queues.reserve( n );
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        M_queues.push_back( std::unique_ptr< Queue >( new Queue() ) );
+    }
+
+    M_threads.reserve( n );
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        M_threads.push_back( std::thread( &ThreadPool::run, this, i ) );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+ThreadPool::~ThreadPool()
+{
+    wait();
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        M_stop = true;
+    }
+    M_task_cond.notify_all();
+
+    for ( std::thread & t : M_threads )
+    {
+        t.join();
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::submit( const Task & task )
+{
+    const std::size_t index = M_next_queue.fetch_add( 1 ) % M_queues.size();
+
+    {
+        std::lock_guard< std::mutex > lock( M_mutex );
+        ++M_pending;
+        ++M_queued;
+    }
+
+    {
+        std::lock_guard< std::mutex > lock( M_queues[index]->mutex_ );
+        M_queues[index]->tasks_.push_back( task );
+    }
+
+    M_task_cond.notify_one();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::wait()
+{
+    std::unique_lock< std::mutex > lock( M_mutex );
+    M_done_cond.wait( lock, [this]() { return M_pending == 0; } );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+bool
+ThreadPool::pop( const std::size_t index,
+                 Task & task )
+{
+    // own queue, the oldest task first
+    {
+        Queue & q = *M_queues[index];
+        std::lock_guard< std::mutex > lock( q.mutex_ );
+        if ( ! q.tasks_.empty() )
+        {
+            task = std::move( q.tasks_.front() );
+            q.tasks_.pop_front();
+            return true;
+        }
+    }
+
+    // steal the newest task from the other queues
+    const std::size_t n = M_queues.size();
+    for ( std::size_t i = 1; i < n; ++i )
+    {
+        Queue & q = *M_queues[( index + i ) % n];
+        std::lock_guard< std::mutex > lock( q.mutex_ );
+        if ( ! q.tasks_.empty() )
+        {
+            task = std::move( q.tasks_.back() );
+            q.tasks_.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+void
+ThreadPool::run( const std::size_t index )
+{
+    while ( true )
+    {
+        Task task;
+
+        {
+            std::unique_lock< std::mutex > lock( M_mutex );
+            M_task_cond.wait( lock, [this]() { return M_stop || M_queued > 0; } );
+            if ( M_queued == 0 )
+            {
+                // stopped
+                return;
+            }
+            --M_queued;
+        }
+
+        // a task is reserved for this worker by decrementing M_queued.
+        // it may be still on the way to the queue in submit().
+        while ( ! pop( index, task ) )
+        {
+            std::this_thread::yield();
+        }
+
+        try
+        {
+            task();
+        }
+        catch ( std::exception & e )
+        {
+            std::cerr << "(ThreadPool) uncaught exception: " << e.what() << std::endl;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( M_mutex );
+            --M_pending;
+            if ( M_pending == 0 )
+            {
+                M_done_cond.notify_all();
+            }
+        }
+    }
+}
+
+}
@@ -5,11 +5,23 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstring>
+#include <condition_variable>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
 
 #include <rcsc/param/param_map.h>
 #include <rcsc/param/cmd_line_parser.h>
@@ -21,6 +33,12 @@
 #include <rcsc/types.h>
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
+#include <rcsc/rcg/format_buffer.h>
+#include <rcsc/rcg/npy_writer.h>
+#include <rcsc/rcg/parser_mmap.h>
+#include <rcsc/rcg/projection.h>
+#include <rcsc/spsc_queue.h>
+#include <rcsc/thread_pool.h>
 
 class CSVPrinter
     : public rcsc::rcg::Handler {
@@ -72,6 +90,9 @@ private:
 
     std::ostream & M_os;
 
+    //! formatting buffer for the match table rows
+    mutable rcsc::rcg::FormatBuffer M_buf;
+
     int M_show_count;
 
     rcsc::rcg::UInt32 M_cycle;
@@ -84,6 +105,16 @@ private:
 
     int playerTypesCount;
 
+    bool M_print_header; //!< if false, table headers are not printed
+    int M_game_id; //!< if positive, printed as the first column of the match table
+    int M_show_fields; //!< rcsc::rcg::Projection::ShowField bits of the printed match table columns
+    int M_row_id; //!< if positive, used as the primary key of the parameter tables and the player type set id
+
+    bool M_show_header_printed;
+    bool M_server_param_handled;
+    bool M_player_param_handled;
+    bool M_player_types_header_printed;
+
     // not used
     CSVPrinter();
 public:
@@ -91,9 +122,51 @@ public:
     explicit
     CSVPrinter( std::ostream & os );
 
+    /*!
+      \brief set the header switch. headers are printed by default.
+      \param on if false, table headers are never printed.
+    */
+    void setPrintHeader( const bool on )
+      {
+          M_print_header = on;
+      }
+
+    /*!
+      \brief set the game id printed as the first column of the match table.
+      \param id game id. if not positive, the game column is not printed.
+    */
+    void setGameId( const int id )
+      {
+          M_game_id = id;
+      }
+
+    /*!
+      \brief set the primary key of the parameter tables.
+      \param id row id. if not positive, the default row number is used.
+      For the player type table, the id is printed as the first column "set".
+    */
+    void setRowId( const int id )
+      {
+          M_row_id = id;
+      }
+
+    /*!
+      \brief set the column groups of the ball and players printed in the match table.
+      \param fields rcsc::rcg::Projection::ShowField bits. all columns are printed by default.
+    */
+    void setShowFields( const int fields )
+      {
+          M_show_fields = fields;
+      }
+
+    std::ostream & printShowHeader() const;
+
     virtual
     bool handleLogVersion( const int ver );
 
+    virtual
+    rcsc::rcg::Projection projection() const;
+
     virtual
     bool handleEOF();
 
@@ -130,17 +203,22 @@ private:
     std::ostream & printPlayerType(const rcsc::PlayerType& type) const;
 
 
-    std::ostream & printShowHeader() const;
     std::ostream & printShowData( const rcsc::rcg::ShowInfoT & show ) const;
 
     // print values
-    std::ostream & printShowCount() const;
-    std::ostream & printTime() const;
-    std::ostream & printPlayMode() const;
-    std::ostream & printTeams() const;
-    std::ostream & printBall( const rcsc::rcg::BallT & ball ) const;
-    std::ostream & printPlayers( const rcsc::rcg::ShowInfoT & show ) const;
-    std::ostream & printPlayer( const rcsc::rcg::PlayerT & player ) const;
+    rcsc::rcg::FormatBuffer & printShowCount() const;
+    rcsc::rcg::FormatBuffer & printTime() const;
+    rcsc::rcg::FormatBuffer & printPlayMode() const;
+    rcsc::rcg::FormatBuffer & printTeams() const;
+    rcsc::rcg::FormatBuffer & printBall( const rcsc::rcg::BallT & ball ) const;
+    rcsc::rcg::FormatBuffer & printPlayers( const rcsc::rcg::ShowInfoT & show ) const;
+    rcsc::rcg::FormatBuffer & printPlayer( const rcsc::rcg::PlayerT & player ) const;
+    rcsc::rcg::FormatBuffer & printEmptyColumns( const int n ) const;
+
+    bool hasShowField( const int fields ) const
+      {
+          return ( M_show_fields & fields ) != 0;
+      }
 
 };
 
@@ -155,7 +233,15 @@ CSVPrinter::CSVPrinter( std::ostream & os )
       M_cycle( 0 ),
       M_stopped( 0 ),
       M_playmode( rcsc::PM_Null ),
-      playerTypesCount( 0 )
+      playerTypesCount( 0 ),
+      M_print_header( true ),
+      M_game_id( 0 ),
+      M_show_fields( rcsc::rcg::Projection::ALL_SHOW_FIELDS ),
+      M_row_id( 0 ),
+      M_show_header_printed( false ),
+      M_server_param_handled( false ),
+      M_player_param_handled( false ),
+      M_player_types_header_printed( false )
 {
 
 }
@@ -178,6 +264,25 @@ CSVPrinter::handleLogVersion( const int ver )
     return true;
 }
 
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+rcsc::rcg::Projection
+CSVPrinter::projection() const
+{
+    using rcsc::rcg::Projection;
+
+    // the state flags are always needed to detect the disconnected or discarded players
+    int fields = M_show_fields;
+    if ( fields & Projection::PLAYER_FIELDS )
+    {
+        fields |= Projection::PLAYER_STATE;
+    }
+
+    return Projection( Projection::ALL_LINES & ~( Projection::MSG_LINE | Projection::DRAW_LINE ),
+                       fields );
+}
 
 /*-------------------------------------------------------------------*/
 /*!
@@ -196,11 +301,13 @@ CSVPrinter::handleEOF()
 bool
 CSVPrinter::handleShow( const rcsc::rcg::ShowInfoT & show )
 {
-    static bool s_first = true;
-    if ( s_first )
+    if ( ! M_show_header_printed )
     {
-        printShowHeader();
-        s_first = false;
+        if ( M_print_header )
+        {
+            printShowHeader();
+        }
+        M_show_header_printed = true;
     }
 
     // update show count
@@ -280,9 +387,8 @@ CSVPrinter::handleTeam( const int,
 bool
 CSVPrinter::handleServerParam( const std::string & msg )
 {
-    static bool firstCall = true;
-    if (firstCall) {
-        firstCall = false;
+    if (!M_server_param_handled) {
+        M_server_param_handled = true;
         if ( ! rcsc::ServerParam::instance().parse( msg.c_str(), 8 ) ) {
             std::cerr << "ERROR: Failed to extract ServerParam object from server_param message." << std::endl;
             return false;
@@ -301,9 +407,8 @@ CSVPrinter::handleServerParam( const std::string & msg )
 bool
 CSVPrinter::handlePlayerParam( const std::string & msg )
 {
-    static bool firstCall = true;
-    if (firstCall) {
-        firstCall = false;
+    if (!M_player_param_handled) {
+        M_player_param_handled = true;
         if ( ! rcsc::PlayerParam::instance().parse( msg.c_str(), 8 ) ) {
             std::cerr << "ERROR: Failed to extract PlayerParam object from player_param message." << std::endl;
             return false;
@@ -322,10 +427,11 @@ CSVPrinter::handlePlayerParam( const std::string & msg )
 bool
 CSVPrinter::handlePlayerType( const std::string & msg )
 {
-    static bool firstCall = true;
-    if (firstCall) {
-        firstCall = false;
-        printPlayerTypesHeader();
+    if (!M_player_types_header_printed) {
+        M_player_types_header_printed = true;
+        if (M_print_header) {
+            printPlayerTypesHeader();
+        }
     }
     playerTypesCount++;
     printPlayerType(rcsc::PlayerType(msg.c_str(), 16.0)); // For game log version 5+ this should be at least 13.0
@@ -359,272 +465,275 @@ std::ostream &
 CSVPrinter::printServerParam() const
 {
     const rcsc::ServerParam& sp = rcsc::ServerParam::i();
-    //
-    // Header
-    //
-    M_os    << "#" // Primary key
-            << ",goal_width"
-            << ",inertia_moment"
-
-            << ",player_size"
-            << ",player_decay"
-            << ",player_rand"
-            << ",player_weight"
-            << ",player_speed_max"
-            << ",player_accel_max"
-
-            << ",stamina_max"
-            << ",stamina_inc_max"
-
-            << ",recover_init"
-            << ",recover_dec_thr"
-            << ",recover_min"
-            << ",recover_dec"
-
-            << ",effort_init"
-            << ",effort_dec_thr"
-            << ",effort_min"
-            << ",effort_dec"
-            << ",effort_inc_thr"
-            << ",effort_inc"
-
-            << ",kick_rand"
-            << ",team_actuator_noise"
-            << ",prand_factor_l"
-            << ",prand_factor_r"
-            << ",kick_rand_factor_l"
-            << ",kick_rand_factor_r"
-
-            << ",ball_size"
-            << ",ball_decay"
-            << ",ball_rand"
-            << ",ball_weight"
-            << ",ball_speed_max"
-            << ",ball_accel_max"
-
-            << ",dash_power_rate"
-            << ",kick_power_rate"
-            << ",kickable_margin"
-            << ",control_radius"
-
-            << ",maxpower"
-            << ",minpower"
-            << ",maxmoment"
-            << ",minmoment"
-            << ",maxneckmoment"
-            << ",minneckmoment"
-            << ",maxneckang"
-            << ",minneckang"
-
-            << ",visible_angle"
-            << ",visible_distance"
-
-            << ",wind_dir"
-            << ",wind_force"
-            << ",wind_ang"
-            << ",wind_rand"
-
-            << ",catchable_area_l"
-            << ",catchable_area_w"
-            << ",catch_probability"
-            << ",goalie_max_moves"
-
-            << ",ckick_margin"
-            << ",offside_active_area_size"
-
-            << ",wind_none"
-            << ",wind_random"
-
-            << ",say_coach_cnt_max"
-            << ",say_coach_msg_size"
-
-            << ",clang_win_size"
-            << ",clang_define_win"
-            << ",clang_meta_win"
-            << ",clang_advice_win"
-            << ",clang_info_win"
-            << ",clang_mess_delay"
-            << ",clang_mess_per_cycle"
-
-            << ",half_time"
-            << ",simulator_step"
-            << ",send_step"
-            << ",recv_step"
-            << ",sense_body_step"
-
-            << ",say_msg_size"
-            << ",hear_max"
-            << ",hear_inc"
-            << ",hear_decay"
-
-            << ",catch_ban_cycle"
-
-            << ",slow_down_factor"
-
-            << ",use_offside"
-            << ",forbid_kick_off_offside"
-            << ",offside_kick_margin"
-
-            << ",audio_cut_dist"
-
-            << ",quantize_step"
-            << ",quantize_step_l"
-
-
-            << ",coach"
-            << ",coach_w_referee"
-            << ",old_coach_hear"
-
-            << ",slowness_on_top_for_left_team"
-            << ",slowness_on_top_for_right_team"
-
-            << ",start_goal_l"
-            << ",start_goal_r"
-
-            << ",fullstate_l"
-            << ",fullstate_r"
-
-            << ",drop_ball_time"
-
-            << ",synch_mode"
-            << ",synch_offset"
-            << ",synch_micro_sleep"
-
-            << ",point_to_ban"
-            << ",point_to_duration"
-
-            // not defined in server_params_t
-            << ",port"
-            << ",coach_port"
-            << ",olcoach_port"
-
-            << ",verbose"
-
-            << ",send_vi_step"
-
-            << ",landmark_file"
-
-            << ",send_comms"
-
-            // logging params are not used in normal client
-            << ",text_logging"
-            << ",game_logging"
-            << ",game_log_version"
-            << ",text_log_dir"
-            << ",game_log_dir"
-            << ",text_log_fixed_name"
-            << ",game_log_fixed_name"
-            << ",text_log_fixed"
-            << ",game_log_fixed"
-            << ",text_log_dated"
-            << ",game_log_dated"
-            << ",log_date_format"
-            << ",log_times"
-            << ",record_messages"
-            << ",text_log_compression"
-            << ",game_log_compression"
-            << ",profile"
-
-
-            << ",tackle_dist"
-            << ",tackle_back_dist"
-            << ",tackle_width"
-            << ",tackle_exponent"
-            << ",tackle_cycles"
-            << ",tackle_power_rate"
-
-            << ",freeform_wait_period"
-            << ",freeform_send_period"
-
-            << ",free_kick_faults"
-            << ",back_passes"
-
-            << ",proper_goal_kicks"
-            << ",stopped_ball_vel"
-            << ",max_goal_kicks"
-
-            << ",clang_del_win"
-            << ",clang_rule_win"
-
-            << ",auto_mode"
-            << ",kick_off_wait"
-            << ",connect_wait"
-            << ",game_over_wait"
-            << ",team_l_start"
-            << ",team_r_start"
-
-            << ",keepaway"
-            << ",keepaway_length"
-            << ",keepaway_width"
-
-            // logging params are not used in normal client
-            << ",keepaway_logging"
-            << ",keepaway_log_dir"
-            << ",keepaway_log_fixed_name"
-            << ",keepaway_log_fixed"
-            << ",keepaway_log_dated"
-
-            << ",keepaway_start"
-
-            << ",nr_normal_halfs"
-            << ",nr_extra_halfs"
-            << ",penalty_shoot_outs"
-
-            << ",pen_before_setup_wait"
-            << ",pen_setup_wait"
-            << ",pen_ready_wait"
-            << ",pen_taken_wait"
-            << ",pen_nr_kicks"
-            << ",pen_max_extra_kicks"
-            << ",pen_dist_x"
-            << ",pen_random_winner"
-            << ",pen_max_goalie_dist_x"
-            << ",pen_allow_mult_kicks"
-            << ",pen_coach_moves_players"
-
-
-            << ",ball_stuck_area"
-            << ",coach_msg_file"
-            // 12
-            << ",max_tackle_power"
-            << ",max_back_tackle_power"
-            << ",player_speed_max_min"
-            << ",extra_stamina"
-            << ",synch_see_offset"
-            << ",max_monitors"
-            // 12.1.3
-            << ",extra_half_time"
-            // 13.0.0
-            << ",stamina_capacity"
-            << ",max_dash_angle"
-            << ",min_dash_angle"
-            << ",dash_angle_step"
-            << ",side_dash_rate"
-            << ",back_dash_rate"
-            << ",max_dash_power"
-            << ",min_dash_power"
-            // 14.0.0
-            << ",tackle_rand_factor"
-            << ",foul_detect_probability"
-            << ",foul_exponent"
-            << ",foul_cycles"
-            << ",golden_goal"
-            // 15.0.0
-            << ",red_card_probability"
-            // 16.0.0
-            << ",illegal_defense_duration"
-            << ",illegal_defense_number"
-            << ",illegal_defense_dist_x"
-            << ",illegal_defense_width"
-            << ",fixed_teamname_l"
-            << ",fixed_teamname_r"
-            ;
-    // Line break
-    M_os << std::endl;
+    if ( M_print_header )
+    {
+        //
+        // Header
+        //
+        M_os    << "#" // Primary key
+                << ",goal_width"
+                << ",inertia_moment"
+
+                << ",player_size"
+                << ",player_decay"
+                << ",player_rand"
+                << ",player_weight"
+                << ",player_speed_max"
+                << ",player_accel_max"
+
+                << ",stamina_max"
+                << ",stamina_inc_max"
+
+                << ",recover_init"
+                << ",recover_dec_thr"
+                << ",recover_min"
+                << ",recover_dec"
+
+                << ",effort_init"
+                << ",effort_dec_thr"
+                << ",effort_min"
+                << ",effort_dec"
+                << ",effort_inc_thr"
+                << ",effort_inc"
+
+                << ",kick_rand"
+                << ",team_actuator_noise"
+                << ",prand_factor_l"
+                << ",prand_factor_r"
+                << ",kick_rand_factor_l"
+                << ",kick_rand_factor_r"
+
+                << ",ball_size"
+                << ",ball_decay"
+                << ",ball_rand"
+                << ",ball_weight"
+                << ",ball_speed_max"
+                << ",ball_accel_max"
+
+                << ",dash_power_rate"
+                << ",kick_power_rate"
+                << ",kickable_margin"
+                << ",control_radius"
+
+                << ",maxpower"
+                << ",minpower"
+                << ",maxmoment"
+                << ",minmoment"
+                << ",maxneckmoment"
+                << ",minneckmoment"
+                << ",maxneckang"
+                << ",minneckang"
+
+                << ",visible_angle"
+                << ",visible_distance"
+
+                << ",wind_dir"
+                << ",wind_force"
+                << ",wind_ang"
+                << ",wind_rand"
+
+                << ",catchable_area_l"
+                << ",catchable_area_w"
+                << ",catch_probability"
+                << ",goalie_max_moves"
+
+                << ",ckick_margin"
+                << ",offside_active_area_size"
+
+                << ",wind_none"
+                << ",wind_random"
+
+                << ",say_coach_cnt_max"
+                << ",say_coach_msg_size"
+
+                << ",clang_win_size"
+                << ",clang_define_win"
+                << ",clang_meta_win"
+                << ",clang_advice_win"
+                << ",clang_info_win"
+                << ",clang_mess_delay"
+                << ",clang_mess_per_cycle"
+
+                << ",half_time"
+                << ",simulator_step"
+                << ",send_step"
+                << ",recv_step"
+                << ",sense_body_step"
+
+                << ",say_msg_size"
+                << ",hear_max"
+                << ",hear_inc"
+                << ",hear_decay"
+
+                << ",catch_ban_cycle"
+
+                << ",slow_down_factor"
+
+                << ",use_offside"
+                << ",forbid_kick_off_offside"
+                << ",offside_kick_margin"
+
+                << ",audio_cut_dist"
+
+                << ",quantize_step"
+                << ",quantize_step_l"
+
+
+                << ",coach"
+                << ",coach_w_referee"
+                << ",old_coach_hear"
+
+                << ",slowness_on_top_for_left_team"
+                << ",slowness_on_top_for_right_team"
+
+                << ",start_goal_l"
+                << ",start_goal_r"
+
+                << ",fullstate_l"
+                << ",fullstate_r"
+
+                << ",drop_ball_time"
+
+                << ",synch_mode"
+                << ",synch_offset"
+                << ",synch_micro_sleep"
+
+                << ",point_to_ban"
+                << ",point_to_duration"
+
+                // not defined in server_params_t
+                << ",port"
+                << ",coach_port"
+                << ",olcoach_port"
+
+                << ",verbose"
+
+                << ",send_vi_step"
+
+                << ",landmark_file"
+
+                << ",send_comms"
+
+                // logging params are not used in normal client
+                << ",text_logging"
+                << ",game_logging"
+                << ",game_log_version"
+                << ",text_log_dir"
+                << ",game_log_dir"
+                << ",text_log_fixed_name"
+                << ",game_log_fixed_name"
+                << ",text_log_fixed"
+                << ",game_log_fixed"
+                << ",text_log_dated"
+                << ",game_log_dated"
+                << ",log_date_format"
+                << ",log_times"
+                << ",record_messages"
+                << ",text_log_compression"
+                << ",game_log_compression"
+                << ",profile"
+
+
+                << ",tackle_dist"
+                << ",tackle_back_dist"
+                << ",tackle_width"
+                << ",tackle_exponent"
+                << ",tackle_cycles"
+                << ",tackle_power_rate"
+
+                << ",freeform_wait_period"
+                << ",freeform_send_period"
+
+                << ",free_kick_faults"
+                << ",back_passes"
+
+                << ",proper_goal_kicks"
+                << ",stopped_ball_vel"
+                << ",max_goal_kicks"
+
+                << ",clang_del_win"
+                << ",clang_rule_win"
+
+                << ",auto_mode"
+                << ",kick_off_wait"
+                << ",connect_wait"
+                << ",game_over_wait"
+                << ",team_l_start"
+                << ",team_r_start"
+
+                << ",keepaway"
+                << ",keepaway_length"
+                << ",keepaway_width"
+
+                // logging params are not used in normal client
+                << ",keepaway_logging"
+                << ",keepaway_log_dir"
+                << ",keepaway_log_fixed_name"
+                << ",keepaway_log_fixed"
+                << ",keepaway_log_dated"
+
+                << ",keepaway_start"
+
+                << ",nr_normal_halfs"
+                << ",nr_extra_halfs"
+                << ",penalty_shoot_outs"
+
+                << ",pen_before_setup_wait"
+                << ",pen_setup_wait"
+                << ",pen_ready_wait"
+                << ",pen_taken_wait"
+                << ",pen_nr_kicks"
+                << ",pen_max_extra_kicks"
+                << ",pen_dist_x"
+                << ",pen_random_winner"
+                << ",pen_max_goalie_dist_x"
+                << ",pen_allow_mult_kicks"
+                << ",pen_coach_moves_players"
+
+
+                << ",ball_stuck_area"
+                << ",coach_msg_file"
+                // 12
+                << ",max_tackle_power"
+                << ",max_back_tackle_power"
+                << ",player_speed_max_min"
+                << ",extra_stamina"
+                << ",synch_see_offset"
+                << ",max_monitors"
+                // 12.1.3
+                << ",extra_half_time"
+                // 13.0.0
+                << ",stamina_capacity"
+                << ",max_dash_angle"
+                << ",min_dash_angle"
+                << ",dash_angle_step"
+                << ",side_dash_rate"
+                << ",back_dash_rate"
+                << ",max_dash_power"
+                << ",min_dash_power"
+                // 14.0.0
+                << ",tackle_rand_factor"
+                << ",foul_detect_probability"
+                << ",foul_exponent"
+                << ",foul_cycles"
+                << ",golden_goal"
+                // 15.0.0
+                << ",red_card_probability"
+                // 16.0.0
+                << ",illegal_defense_duration"
+                << ",illegal_defense_number"
+                << ",illegal_defense_dist_x"
+                << ",illegal_defense_width"
+                << ",fixed_teamname_l"
+                << ",fixed_teamname_r"
+                ;
+        // Line break
+        M_os << std::endl;
+    }
     //
     // Parameters values
     //
-    M_os    << "1" // Row number
+    M_os    << ( M_row_id > 0 ? M_row_id : 1 ) // Row number
             << "," << sp.goalWidth()
             << "," << sp.defaultInertiaMoment()
 
@@ -892,45 +1001,48 @@ std::ostream &
 CSVPrinter::printPlayerParam() const
 {
     const rcsc::PlayerParam& pp = rcsc::PlayerParam::i();
-    //
-    // Header
-    //
-    M_os    << "#" // Row index
-            << ",player_types"
-            << ",subs_max"
-            << ",pt_max"
-            << ",allow_mult_default_type"
-            << ",player_speed_max_delta_min"
-            << ",player_speed_max_delta_max"
-            << ",stamina_inc_max_delta_factor"
-            << ",player_decay_delta_min"
-            << ",player_decay_delta_max"
-            << ",inertia_moment_delta_factor"
-            << ",dash_power_rate_delta_min"
-            << ",dash_power_rate_delta_max"
-            << ",player_size_delta_factor"
-            << ",kickable_margin_delta_min"
-            << ",kickable_margin_delta_max"
-            << ",kick_rand_delta_factor"
-            << ",extra_stamina_delta_min"
-            << ",extra_stamina_delta_max"
-            << ",effort_max_delta_factor"
-            << ",effort_min_delta_factor"
-            << ",random_seed"
-            << ",new_dash_power_rate_delta_min"
-            << ",new_dash_power_rate_delta_max"
-            << ",new_stamina_inc_max_delta_factor"
-            << ",kick_power_rate_delta_min"
-            << ",kick_power_rate_delta_max"
-            << ",foul_detect_probability_delta_factor"
-            << ",catchable_area_l_stretch_min"
-            << ",catchable_area_l_stretch_max"
-            ;
-    M_os << std::endl;
+    if ( M_print_header )
+    {
+        //
+        // Header
+        //
+        M_os    << "#" // Row index
+                << ",player_types"
+                << ",subs_max"
+                << ",pt_max"
+                << ",allow_mult_default_type"
+                << ",player_speed_max_delta_min"
+                << ",player_speed_max_delta_max"
+                << ",stamina_inc_max_delta_factor"
+                << ",player_decay_delta_min"
+                << ",player_decay_delta_max"
+                << ",inertia_moment_delta_factor"
+                << ",dash_power_rate_delta_min"
+                << ",dash_power_rate_delta_max"
+                << ",player_size_delta_factor"
+                << ",kickable_margin_delta_min"
+                << ",kickable_margin_delta_max"
+                << ",kick_rand_delta_factor"
+                << ",extra_stamina_delta_min"
+                << ",extra_stamina_delta_max"
+                << ",effort_max_delta_factor"
+                << ",effort_min_delta_factor"
+                << ",random_seed"
+                << ",new_dash_power_rate_delta_min"
+                << ",new_dash_power_rate_delta_max"
+                << ",new_stamina_inc_max_delta_factor"
+                << ",kick_power_rate_delta_min"
+                << ",kick_power_rate_delta_max"
+                << ",foul_detect_probability_delta_factor"
+                << ",catchable_area_l_stretch_min"
+                << ",catchable_area_l_stretch_max"
+                ;
+        M_os << std::endl;
+    }
     //
     // Values
     //
-    M_os    << "1"
+    M_os    << ( M_row_id > 0 ? M_row_id : 1 )
             << "," << pp.playerTypes()
             << "," << pp.subsMax()
             << "," << pp.ptMax()
@@ -972,6 +1084,11 @@ CSVPrinter::printPlayerParam() const
 std::ostream &
 CSVPrinter::printPlayerTypesHeader() const
 {
+    if ( M_row_id > 0 )
+    {
+        M_os << "set,";
+    }
+
     M_os    << "#"  // Row number
             << ",id"
             << ",player_speed_max"
@@ -1000,6 +1117,11 @@ CSVPrinter::printPlayerTypesHeader() const
 std::ostream &
 CSVPrinter::printPlayerType(const rcsc::PlayerType& type) const
 {
+    if ( M_row_id > 0 )
+    {
+        M_os << M_row_id << ',';
+    }
+
     M_os    << playerTypesCount
             << "," << type.id()
             << "," << type.playerSpeedMax()
@@ -1028,63 +1150,103 @@ CSVPrinter::printPlayerType(const rcsc::PlayerType& type) const
 std::ostream &
 CSVPrinter::printShowHeader() const
 {
+    if ( M_game_id > 0 )
+    {
+        M_os << "game, ";
+    }
+
     M_os << "#"
          << ", cycle, stopped"
          << ", playmode"
          << ", l_name, l_score, l_pen_score"
-         << ", r_name, r_score, r_pen_score"
-         << ", b_x, b_y, b_vx, b_vy";
+         << ", r_name, r_score, r_pen_score";
+
+    if ( hasShowField( rcsc::rcg::Projection::BALL_POS ) )
+    {
+        M_os << ", b_x, b_y";
+    }
+    if ( hasShowField( rcsc::rcg::Projection::BALL_VEL ) )
+    {
+        M_os << ", b_vx, b_vy";
+    }
 
     char side = 'l';
     for ( int s = 0; s < 2; ++s )
     {
         for ( int i = 1; i <= rcsc::MAX_PLAYER; ++i )
         {
-            M_os << ", " << side << i << "_t"
-                 << ", " << side << i << "_kick_tried"
-                 << ", " << side << i << "_kick_failed"
-                 << ", " << side << i << "_goalie"
-                 << ", " << side << i << "_catch_tried"
-                 << ", " << side << i << "_catch_failed"
-                 << ", " << side << i << "_discarded"
-                 << ", " << side << i << "_collided_with_ball"
-                 << ", " << side << i << "_collided_with_player"
-                 << ", " << side << i << "_tackle_tried"
-                 << ", " << side << i << "_tackle_failed"
-                 << ", " << side << i << "_backpassed"
-                 << ", " << side << i << "_freekicked_wrong"
-                 << ", " << side << i << "_collided_with_post"
-                 << ", " << side << i << "_foul_frozen"
-                 << ", " << side << i << "_yellow_card"
-                 << ", " << side << i << "_red_card"
-                 << ", " << side << i << "_defended_illegaly"
-                 << ", " << side << i << "_x"
-                 << ", " << side << i << "_y"
-                 << ", " << side << i << "_vx"
-                 << ", " << side << i << "_vy"
-                 << ", " << side << i << "_body"
-                 << ", " << side << i << "_neck"
-                 << ", " << side << i << "_arm_point_x"
-                 << ", " << side << i << "_arm_point_y"
-                 << ", " << side << i << "_view_q"
-                 << ", " << side << i << "_view_w"
-                 << ", " << side << i << "_stamina"
-                 << ", " << side << i << "_effort"
-                 << ", " << side << i << "_stamina_rec"
-                 << ", " << side << i << "_stamina_cap"
-                 << ", " << side << i << "_focus_side"
-                 << ", " << side << i << "_focus_unum"
-                 << ", " << side << i << "_kick_count"
-                 << ", " << side << i << "_dash_count"
-                 << ", " << side << i << "_turn_count"
-                 << ", " << side << i << "_catch_count"
-                 << ", " << side << i << "_move_count"
-                 << ", " << side << i << "_turnneck_count"
-                 << ", " << side << i << "_changeview_count"
-                 << ", " << side << i << "_say_count"
-                 << ", " << side << i << "_tackle_count"
-                 << ", " << side << i << "_arm_count"
-                 << ", " << side << i << "_focus_count";
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_STATE ) )
+            {
+                M_os << ", " << side << i << "_t"
+                     << ", " << side << i << "_kick_tried"
+                     << ", " << side << i << "_kick_failed"
+                     << ", " << side << i << "_goalie"
+                     << ", " << side << i << "_catch_tried"
+                     << ", " << side << i << "_catch_failed"
+                     << ", " << side << i << "_discarded"
+                     << ", " << side << i << "_collided_with_ball"
+                     << ", " << side << i << "_collided_with_player"
+                     << ", " << side << i << "_tackle_tried"
+                     << ", " << side << i << "_tackle_failed"
+                     << ", " << side << i << "_backpassed"
+                     << ", " << side << i << "_freekicked_wrong"
+                     << ", " << side << i << "_collided_with_post"
+                     << ", " << side << i << "_foul_frozen"
+                     << ", " << side << i << "_yellow_card"
+                     << ", " << side << i << "_red_card"
+                     << ", " << side << i << "_defended_illegaly";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_POS ) )
+            {
+                M_os << ", " << side << i << "_x"
+                     << ", " << side << i << "_y";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_VEL ) )
+            {
+                M_os << ", " << side << i << "_vx"
+                     << ", " << side << i << "_vy";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_BODY ) )
+            {
+                M_os << ", " << side << i << "_body"
+                     << ", " << side << i << "_neck";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_ARM ) )
+            {
+                M_os << ", " << side << i << "_arm_point_x"
+                     << ", " << side << i << "_arm_point_y";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_VIEW ) )
+            {
+                M_os << ", " << side << i << "_view_q"
+                     << ", " << side << i << "_view_w";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_STAMINA ) )
+            {
+                M_os << ", " << side << i << "_stamina"
+                     << ", " << side << i << "_effort"
+                     << ", " << side << i << "_stamina_rec"
+                     << ", " << side << i << "_stamina_cap";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_FOCUS ) )
+            {
+                M_os << ", " << side << i << "_focus_side"
+                     << ", " << side << i << "_focus_unum";
+            }
+            if ( hasShowField( rcsc::rcg::Projection::PLAYER_COUNT ) )
+            {
+                M_os << ", " << side << i << "_kick_count"
+                     << ", " << side << i << "_dash_count"
+                     << ", " << side << i << "_turn_count"
+                     << ", " << side << i << "_catch_count"
+                     << ", " << side << i << "_move_count"
+                     << ", " << side << i << "_turnneck_count"
+                     << ", " << side << i << "_changeview_count"
+                     << ", " << side << i << "_say_count"
+                     << ", " << side << i << "_tackle_count"
+                     << ", " << side << i << "_arm_count"
+                     << ", " << side << i << "_focus_count";
+            }
         }
         side = 'r';
     }
@@ -1107,79 +1269,90 @@ CSVPrinter::printShowData( const rcsc::rcg::ShowInfoT & show ) const
     printBall( show.ball_ );
     printPlayers( show );
 
-    M_os << '\n';
-    return M_os;
+    M_buf << '\n';
+    return M_buf.flush( M_os );
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-std::ostream &
+rcsc::rcg::FormatBuffer &
 CSVPrinter::printShowCount() const
 {
-    M_os << M_show_count;
-    return M_os;
+    if ( M_game_id > 0 )
+    {
+        M_buf << M_game_id << ',';
+    }
+
+    M_buf << M_show_count;
+    return M_buf;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-std::ostream &
+rcsc::rcg::FormatBuffer &
 CSVPrinter::printTime() const
 {
-    M_os << ',' << M_cycle << ',' << M_stopped;
-    return M_os;
+    M_buf << ',' << M_cycle << ',' << M_stopped;
+    return M_buf;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-std::ostream &
+rcsc::rcg::FormatBuffer &
 CSVPrinter::printPlayMode() const
 {
-    M_os << ',' << getPlayModeString( M_playmode );
-    return M_os;
+    M_buf << ',' << getPlayModeString( M_playmode );
+    return M_buf;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-std::ostream &
+rcsc::rcg::FormatBuffer &
 CSVPrinter::printTeams() const
 {
     for ( const auto & t : M_teams )
     {
-        M_os << ',' << t.name_
-             << ',' << t.score_
-             << ',' << t.pen_score_;
+        M_buf << ',' << t.name_
+              << ',' << t.score_
+              << ',' << t.pen_score_;
     }
 
-    return M_os;
+    return M_buf;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-std::ostream &
+rcsc::rcg::FormatBuffer &
 CSVPrinter::printBall( const rcsc::rcg::BallT & ball ) const
 {
-    M_os << ',' << ball.x_
-         << ',' << ball.y_
-         << ',' << ball.vx_
-         << ',' << ball.vy_;
-    return M_os;
+    if ( hasShowField( rcsc::rcg::Projection::BALL_POS ) )
+    {
+        M_buf << ',' << ball.x_
+              << ',' << ball.y_;
+    }
+    if ( hasShowField( rcsc::rcg::Projection::BALL_VEL ) )
+    {
+        M_buf << ',' << ball.vx_
+              << ',' << ball.vy_;
+    }
+    return M_buf;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-std::ostream &
+rcsc::rcg::FormatBuffer &
 CSVPrinter::printPlayers( const rcsc::rcg::ShowInfoT & show ) const
 {
     for ( const auto & p : show.player_ )
@@ -1187,188 +1360,187 @@ CSVPrinter::printPlayers( const rcsc::rcg::ShowInfoT & show ) const
         printPlayer( p );
     }
 
-    return M_os;
+    return M_buf;
 }
 
 /*-------------------------------------------------------------------*/
 /*!
 
  */
-std::ostream &
+rcsc::rcg::FormatBuffer &
 CSVPrinter::printPlayer( const rcsc::rcg::PlayerT & player ) const
 {
-    if (!player.isAlive())
+    // Player is disconnected, or was either discarded by monitor or received a red card
+    const bool discarded = ( player.isAlive() && ( player.state_ & rcsc::rcg::DISCARD ) );
+    const bool valid = ( player.isAlive() && ! discarded );
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_STATE ) )
     {
-        // Player is disconnected
-        M_os << "," //<< player.type_
-             << "," //<< ((player.state_ & rcsc::rcg::KICK) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::KICK_FAULT) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::GOALIE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::CATCH) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::CATCH_FAULT) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::DISCARD) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::BALL_COLLIDE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::PLAYER_COLLIDE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::TACKLE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::TACKLE_FAULT) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::BACK_PASS) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::FREE_KICK_FAULT) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::POST_COLLIDE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::FOUL_CHARGED) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::YELLOW_CARD) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::RED_CARD) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::ILLEGAL_DEFENSE) != 0)
-             << ',' //<< player.x_
-             << ',' //<< player.y_
-             << ',' //<< player.vx_
-             << ',' //<< player.vy_
-             << ',' //<< player.body_
-             << ',' //<< player.neck_
-             << "," //<< player.point_x_ 
-             << "," //<< player.point_y_
-             << "," //<< player.view_quality_
-             << "," //<< player.view_width_
-             << "," //<< player.stamina_
-             << "," //<< player.effort_
-             << "," //<< player.recovery_
-             << "," //<< player.stamina_capacity_
-             << "," //<< player.focus_side_
-             << "," //<< player.focus_unum_
-             << "," //<< player.kick_count_
-             << "," //<< player.dash_count_
-             << "," //<< player.turn_count_
-             << "," //<< player.catch_count_
-             << "," //<< player.move_count_
-             << "," //<< player.turn_neck_count_
-             << "," //<< player.change_view_count_
-             << "," //<< player.say_count_
-             << "," //<< player.tackle_count_
-             << "," //<< player.pointto_count_
-             << "," //<< player.attentionto_count_
-            ;
-    } 
-    else if (player.state_ & rcsc::rcg::DISCARD)
+        if ( valid )
+        {
+            M_buf << "," << player.type_
+                  << "," << ((player.state_ & rcsc::rcg::KICK) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::KICK_FAULT) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::GOALIE) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::CATCH) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::CATCH_FAULT) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::DISCARD) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::BALL_COLLIDE) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::PLAYER_COLLIDE) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::TACKLE) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::TACKLE_FAULT) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::BACK_PASS) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::FREE_KICK_FAULT) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::POST_COLLIDE) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::FOUL_CHARGED) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::YELLOW_CARD) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::RED_CARD) != 0)
+                  << "," << ((player.state_ & rcsc::rcg::ILLEGAL_DEFENSE) != 0)
+                 ;
+        }
+        else if ( discarded )
+        {
+            // only the discarded and red card flags are printed
+            printEmptyColumns( 6 );
+            M_buf << "," << ((player.state_ & rcsc::rcg::DISCARD) != 0);
+            printEmptyColumns( 9 );
+            M_buf << "," << ((player.state_ & rcsc::rcg::RED_CARD) != 0);
+            printEmptyColumns( 1 );
+        }
+        else
+        {
+            printEmptyColumns( 18 );
+        }
+    }
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_POS ) )
     {
-        // Player was either discarded by monitor or received a red card
-        M_os << "," //<< player.type_
-             << "," //<< ((player.state_ & rcsc::rcg::KICK) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::KICK_FAULT) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::GOALIE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::CATCH) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::CATCH_FAULT) != 0)
-             << "," << ((player.state_ & rcsc::rcg::DISCARD) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::BALL_COLLIDE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::PLAYER_COLLIDE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::TACKLE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::TACKLE_FAULT) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::BACK_PASS) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::FREE_KICK_FAULT) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::POST_COLLIDE) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::FOUL_CHARGED) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::YELLOW_CARD) != 0)
-             << "," << ((player.state_ & rcsc::rcg::RED_CARD) != 0)
-             << "," //<< ((player.state_ & rcsc::rcg::ILLEGAL_DEFENSE) != 0)
-             << ',' //<< player.x_
-             << ',' //<< player.y_
-             << ',' //<< player.vx_
-             << ',' //<< player.vy_
-             << ',' //<< player.body_
-             << ',' //<< player.neck_
-             << "," //<< player.point_x_ 
-             << "," //<< player.point_y_
-             << "," //<< player.view_quality_
-             << "," //<< player.view_width_
-             << "," //<< player.stamina_
-             << "," //<< player.effort_
-             << "," //<< player.recovery_
-             << "," //<< player.stamina_capacity_
-             << "," //<< player.focus_side_
-             << "," //<< player.focus_unum_
-             << "," //<< player.kick_count_
-             << "," //<< player.dash_count_
-             << "," //<< player.turn_count_
-             << "," //<< player.catch_count_
-             << "," //<< player.move_count_
-             << "," //<< player.turn_neck_count_
-             << "," //<< player.change_view_count_
-             << "," //<< player.say_count_
-             << "," //<< player.tackle_count_
-             << "," //<< player.pointto_count_
-             << "," //<< player.attentionto_count_
-            ;
+        if ( valid )
+        {
+            M_buf << ',' << player.x_
+                  << ',' << player.y_;
+        }
+        else
+        {
+            printEmptyColumns( 2 );
+        }
     }
-    else
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_VEL ) )
     {
-        M_os << "," << player.type_
-             << "," << ((player.state_ & rcsc::rcg::KICK) != 0)
-             << "," << ((player.state_ & rcsc::rcg::KICK_FAULT) != 0)
-             << "," << ((player.state_ & rcsc::rcg::GOALIE) != 0)
-             << "," << ((player.state_ & rcsc::rcg::CATCH) != 0)
-             << "," << ((player.state_ & rcsc::rcg::CATCH_FAULT) != 0)
-             << "," << ((player.state_ & rcsc::rcg::DISCARD) != 0)
-             << "," << ((player.state_ & rcsc::rcg::BALL_COLLIDE) != 0)
-             << "," << ((player.state_ & rcsc::rcg::PLAYER_COLLIDE) != 0)
-             << "," << ((player.state_ & rcsc::rcg::TACKLE) != 0)
-             << "," << ((player.state_ & rcsc::rcg::TACKLE_FAULT) != 0)
-             << "," << ((player.state_ & rcsc::rcg::BACK_PASS) != 0)
-             << "," << ((player.state_ & rcsc::rcg::FREE_KICK_FAULT) != 0)
-             << "," << ((player.state_ & rcsc::rcg::POST_COLLIDE) != 0)
-             << "," << ((player.state_ & rcsc::rcg::FOUL_CHARGED) != 0)
-             << "," << ((player.state_ & rcsc::rcg::YELLOW_CARD) != 0)
-             << "," << ((player.state_ & rcsc::rcg::RED_CARD) != 0)
-             << "," << ((player.state_ & rcsc::rcg::ILLEGAL_DEFENSE) != 0)
-             << ',' << player.x_
-             << ',' << player.y_
-             << ',' << player.vx_
-             << ',' << player.vy_
-             << ',' << player.body_
-             << ',' << player.neck_
-            ;
-        if (player.isPointing())
+        if ( valid )
         {
-            M_os << "," << player.point_x_ 
-                 << "," << player.point_y_
-                ;
+            M_buf << ',' << player.vx_
+                  << ',' << player.vy_;
         }
         else
         {
-            M_os << "," //<< player.point_x_ 
-                 << "," //<< player.point_y_
-                ;
+            printEmptyColumns( 2 );
         }
-        M_os << "," << player.view_quality_
-             << "," << player.view_width_
-             << "," << player.stamina_
-             << "," << player.effort_
-             << "," << player.recovery_
-             << "," << player.stamina_capacity_
-            ;
-        if (player.isFocusing())
+    }
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_BODY ) )
+    {
+        if ( valid )
         {
-            M_os << "," << player.focus_side_
-                 << "," << player.focus_unum_
-                ;
+            M_buf << ',' << player.body_
+                  << ',' << player.neck_;
         }
         else
         {
-            M_os << "," //<< player.focus_side_
-                 << "," //<< player.focus_unum_
-                ;
+            printEmptyColumns( 2 );
         }
-        M_os << "," << player.kick_count_
-             << "," << player.dash_count_
-             << "," << player.turn_count_
-             << "," << player.catch_count_
-             << "," << player.move_count_
-             << "," << player.turn_neck_count_
-             << "," << player.change_view_count_
-             << "," << player.say_count_
-             << "," << player.tackle_count_
-             << "," << player.pointto_count_
-             << "," << player.attentionto_count_
-            ;
     }
-    return M_os;
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_ARM ) )
+    {
+        if ( valid && player.isPointing() )
+        {
+            M_buf << "," << player.point_x_
+                  << "," << player.point_y_;
+        }
+        else
+        {
+            printEmptyColumns( 2 );
+        }
+    }
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_VIEW ) )
+    {
+        if ( valid )
+        {
+            M_buf << "," << player.view_quality_
+                  << "," << player.view_width_;
+        }
+        else
+        {
+            printEmptyColumns( 2 );
+        }
+    }
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_STAMINA ) )
+    {
+        if ( valid )
+        {
+            M_buf << "," << player.stamina_
+                  << "," << player.effort_
+                  << "," << player.recovery_
+                  << "," << player.stamina_capacity_;
+        }
+        else
+        {
+            printEmptyColumns( 4 );
+        }
+    }
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_FOCUS ) )
+    {
+        if ( valid && player.isFocusing() )
+        {
+            M_buf << "," << player.focus_side_
+                  << "," << player.focus_unum_;
+        }
+        else
+        {
+            printEmptyColumns( 2 );
+        }
+    }
+
+    if ( hasShowField( rcsc::rcg::Projection::PLAYER_COUNT ) )
+    {
+        if ( valid )
+        {
+            M_buf << "," << player.kick_count_
+                  << "," << player.dash_count_
+                  << "," << player.turn_count_
+                  << "," << player.catch_count_
+                  << "," << player.move_count_
+                  << "," << player.turn_neck_count_
+                  << "," << player.change_view_count_
+                  << "," << player.say_count_
+                  << "," << player.tackle_count_
+                  << "," << player.pointto_count_
+                  << "," << player.attentionto_count_;
+        }
+        else
+        {
+            printEmptyColumns( 11 );
+        }
+    }
+
+    return M_buf;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+
+ */
+rcsc::rcg::FormatBuffer &
+CSVPrinter::printEmptyColumns( const int n ) const
+{
+    static const char s_commas[] = ",,,,,,,,,,,,,,,,,,,,";
+    M_buf.append( s_commas, static_cast< std::size_t >( n ) );
+    return M_buf;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -1385,48 +1557,48 @@ public:
 
     virtual
     bool handleShow( const rcsc::rcg::ShowInfoT & show ) noexcept override {
-        return matchPrinter ? matchPrinter->handleShow(show) : true;
+        return matchPrinter ? checked(matchPrinter->handleShow(show)) : true;
     }
 
     virtual
     bool handleMsg( const int time,
                     const int board,
                     const std::string & msg ) noexcept override {
-        return matchPrinter ? matchPrinter->handleMsg(time, board, msg) : true;
+        return matchPrinter ? checked(matchPrinter->handleMsg(time, board, msg)) : true;
     }
 
     virtual
     bool handleDraw( const int time,
                      const rcsc::rcg::drawinfo_t & draw ) noexcept override {
-        return matchPrinter ? matchPrinter->handleDraw(time, draw) : true;
+        return matchPrinter ? checked(matchPrinter->handleDraw(time, draw)) : true;
     }
 
     virtual
     bool handlePlayMode( const int time,
                          const rcsc::PlayMode pm ) noexcept override {
-        return matchPrinter ? matchPrinter->handlePlayMode(time, pm) : true;
+        return matchPrinter ? checked(matchPrinter->handlePlayMode(time, pm)) : true;
     }
 
     virtual
     bool handleTeam( const int time,
                      const rcsc::rcg::TeamT & team_l,
                      const rcsc::rcg::TeamT & team_r ) noexcept override {
-        return matchPrinter ? matchPrinter->handleTeam(time, team_l, team_r) : true;
+        return matchPrinter ? checked(matchPrinter->handleTeam(time, team_l, team_r)) : true;
     }
 
     virtual
     bool handleServerParam( const std::string & msg ) noexcept override {
-        return serverParamsPrinter ? serverParamsPrinter->handleServerParam(msg) : true;
+        return serverParamsPrinter ? checked(serverParamsPrinter->handleServerParam(msg)) : true;
     }
 
     virtual
     bool handlePlayerParam( const std::string & msg ) noexcept override {
-        return playerParamsPrinter ? playerParamsPrinter->handlePlayerParam(msg) : true;
+        return playerParamsPrinter ? checked(playerParamsPrinter->handlePlayerParam(msg)) : true;
     }
 
     virtual
     bool handlePlayerType( const std::string & msg ) noexcept override {
-        return playerTypesPrinter ? playerTypesPrinter->handlePlayerType(msg) : true;
+        return playerTypesPrinter ? checked(playerTypesPrinter->handlePlayerType(msg)) : true;
     }
 
     virtual
@@ -1434,11 +1606,27 @@ public:
         return matchPrinter ? matchPrinter->handleEOF() : true;
     }
 
+    /*!
+      \brief Gets the rcg data required by the enabled tables.
+      \return The lines and show fields used by the enabled printers.
+    */
+    virtual
+    rcsc::rcg::Projection projection() const override;
+
     /*!
       \brief Enables printing the Match CSV Table and sets its output destination.
       \param sink The output destination. If null, the printer prints to std::cout.
+      \param showFields The rcsc::rcg::Projection::ShowField bits of the printed ball and player columns.
+    */
+    void enableMatchPrinter(std::unique_ptr<std::ostream>&& sink=nullptr,
+                            const int showFields=rcsc::rcg::Projection::ALL_SHOW_FIELDS) noexcept;
+
+    /*!
+      \brief Enables writing the Match table as columnar .npy files instead of CSV.
+      \param dirPath The output directory. It is created if it does not exist.
+      \return true if the column files were opened.
     */
-    void enableMatchPrinter(std::unique_ptr<std::ostream>&& sink=nullptr) noexcept;
+    bool enableMatchNpyWriter(const std::string& dirPath) noexcept;
 
     /*!
       \brief Enables printing the ServerParams CSV Table and sets its output destination.
@@ -1458,9 +1646,48 @@ public:
     */
     void enablePlayerTypesPrinter(std::unique_ptr<std::ostream>&& sink=nullptr) noexcept;
 
+    /*!
+      \brief Parses a rcg v4/v5 file in pipelined stages instead of Parser::parse().
+
+      A decode thread reads (and inflates) the file into chunks of whole lines,
+      a parse thread converts the chunks into batches of handled data, and
+      the enabled tables are formatted and written by their own threads:
+      one for the Match table, and one for the ServerParams, PlayerParams and
+      PlayerTypes tables, which share the global ServerParam/PlayerParam.
+      The stages are connected by bounded lock-free queues.
+      The output is identical to the serial mode.
+      \param path The RCG file path.
+      \return false if the file could not be read or parsed, or if a table
+      printer rejected the data, e.g. the parameter message could not be parsed.
+    */
+    bool parsePipelined(const std::string& path);
+
+    /*!
+      \brief Checks if a table printer rejected the data.
+
+      Parser::parse() reports such lines and continues, so the result of
+      parse() does not include these errors.
+      \return true if any handler of the enabled printers returned false.
+    */
+    bool hasHandlerError() const noexcept {
+        return handlerFailed.load();
+    }
+
 private:
 
-    std::unique_ptr<CSVPrinter> matchPrinter; //<! Prints the CSV table with data from the course of the match
+    /*!
+      \brief Records the failure of a table printer.
+      \param ok The result of the printer's handler.
+      \return The same value as ok.
+    */
+    bool checked(const bool ok) noexcept {
+        if (!ok) {
+            handlerFailed = true;
+        }
+        return ok;
+    }
+
+    std::unique_ptr<rcsc::rcg::Handler> matchPrinter; //<! Prints the CSV table (or writes the .npy columns) with data from the course of the match
     std::unique_ptr<std::ostream> matchPrinterSink; //<! The output sink for the match table
     std::unique_ptr<CSVPrinter> serverParamsPrinter; //<! Prints the CSV table with rcssserver used server parameters
     std::unique_ptr<std::ostream> serverParamsSink; //<! The output sink for the server params table
@@ -1468,6 +1695,7 @@ private:
     std::unique_ptr<std::ostream> playerParamsSink; //<! The output sink for the player params table
     std::unique_ptr<CSVPrinter> playerTypesPrinter; //<! Prints the CSV table with the player types available in the match
     std::unique_ptr<std::ostream> playerTypesSink; //<! The output sink for the player types table
+    std::atomic<bool> handlerFailed; //<! Set when a table printer rejected the data. Written by the pipeline stages.
 };
 
 MultiSinkCSVPrinter::MultiSinkCSVPrinter()
@@ -1479,6 +1707,7 @@ MultiSinkCSVPrinter::MultiSinkCSVPrinter()
 ,   playerParamsSink(nullptr)
 ,   playerTypesPrinter(nullptr)
 ,   playerTypesSink(nullptr)
+,   handlerFailed(false)
 {}
 
 MultiSinkCSVPrinter::~MultiSinkCSVPrinter() {
@@ -1500,13 +1729,48 @@ MultiSinkCSVPrinter::~MultiSinkCSVPrinter() {
     }
 }
 
-void 
-MultiSinkCSVPrinter::enableMatchPrinter(std::unique_ptr<std::ostream>&& sink) noexcept {
-    matchPrinterSink = std::forward<std::unique_ptr<std::ostream>>(sink);
-    matchPrinter.reset( new CSVPrinter( matchPrinterSink ? *matchPrinterSink : std::cout) );
-}
-
-void 
+rcsc::rcg::Projection
+MultiSinkCSVPrinter::projection() const {
+    using rcsc::rcg::Projection;
+    Projection required(0, 0);
+    if (matchPrinter) {
+        const Projection match = matchPrinter->projection();
+        required.add(Projection(match.lines() & (Projection::SHOW_LINE | Projection::PLAYMODE_LINE | Projection::TEAM_LINE
+                                                 | Projection::MSG_LINE | Projection::DRAW_LINE),
+                                match.showFields()));
+    }
+    if (serverParamsPrinter) {
+        required.add(Projection(Projection::SERVER_PARAM_LINE, 0));
+    }
+    if (playerParamsPrinter) {
+        required.add(Projection(Projection::PLAYER_PARAM_LINE, 0));
+    }
+    if (playerTypesPrinter) {
+        required.add(Projection(Projection::PLAYER_TYPE_LINE, 0));
+    }
+    return required;
+}
+
+void 
+MultiSinkCSVPrinter::enableMatchPrinter(std::unique_ptr<std::ostream>&& sink, const int showFields) noexcept {
+    matchPrinterSink = std::forward<std::unique_ptr<std::ostream>>(sink);
+    CSVPrinter* printer = new CSVPrinter( matchPrinterSink ? *matchPrinterSink : std::cout);
+    printer->setShowFields(showFields);
+    matchPrinter.reset(printer);
+}
+
+bool
+MultiSinkCSVPrinter::enableMatchNpyWriter(const std::string& dirPath) noexcept {
+    std::unique_ptr<rcsc::rcg::NpyWriter> writer(new rcsc::rcg::NpyWriter());
+    if (!writer->open(dirPath)) {
+        return false;
+    }
+    matchPrinterSink.reset();
+    matchPrinter = std::move(writer);
+    return true;
+}
+
+void 
 MultiSinkCSVPrinter::enableServerParamsPrinter(std::unique_ptr<std::ostream>&& sink) noexcept {
     serverParamsSink = std::forward<std::unique_ptr<std::ostream>>(sink);
     serverParamsPrinter.reset( new CSVPrinter( serverParamsSink ? *serverParamsSink : std::cout) );
@@ -1524,6 +1788,294 @@ MultiSinkCSVPrinter::enablePlayerTypesPrinter(std::unique_ptr<std::ostream>&& si
     playerTypesPrinter.reset( new CSVPrinter( playerTypesSink ? *playerTypesSink : std::cout) );
 }
 
+/*!
+  \brief The data handled by the parse thread, handed to the table writer threads.
+*/
+struct PipelineBatch {
+    enum EventKind {
+        SHOW,
+        PLAYMODE,
+        TEAM,
+        SERVER_PARAM,
+        PLAYER_PARAM,
+        PLAYER_TYPE,
+    };
+
+    struct Event {
+        EventKind kind;
+        int time;
+        std::size_t index; //<! Index in the container of the kind
+    };
+
+    std::vector<Event> events; //<! Handled data in the logged order
+    std::vector<rcsc::rcg::ShowInfoT> shows;
+    std::vector<rcsc::PlayMode> playmodes;
+    std::vector<std::pair<rcsc::rcg::TeamT, rcsc::rcg::TeamT>> teams;
+    std::vector<std::string> messages; //<! Raw parameter messages
+};
+
+/*!
+  \brief Records the parsed data into a PipelineBatch.
+*/
+class PipelineRecorder
+    : public rcsc::rcg::Handler {
+public:
+    std::shared_ptr<PipelineBatch> batch;
+    rcsc::rcg::Projection required; //<! The data required by the table writers
+
+    virtual
+    rcsc::rcg::Projection projection() const override {
+        return required;
+    }
+
+    virtual
+    bool handleEOF() override {
+        return true;
+    }
+
+    virtual
+    bool handleShow( const rcsc::rcg::ShowInfoT & show ) override {
+        add(PipelineBatch::SHOW, show.time_, batch->shows.size());
+        batch->shows.push_back(show);
+        return true;
+    }
+
+    virtual
+    bool handleMsg( const int,
+                    const int,
+                    const std::string & ) override {
+        return true;
+    }
+
+    virtual
+    bool handleDraw( const int,
+                     const rcsc::rcg::drawinfo_t & ) override {
+        return true;
+    }
+
+    virtual
+    bool handlePlayMode( const int time,
+                         const rcsc::PlayMode pm ) override {
+        add(PipelineBatch::PLAYMODE, time, batch->playmodes.size());
+        batch->playmodes.push_back(pm);
+        return true;
+    }
+
+    virtual
+    bool handleTeam( const int time,
+                     const rcsc::rcg::TeamT & team_l,
+                     const rcsc::rcg::TeamT & team_r ) override {
+        add(PipelineBatch::TEAM, time, batch->teams.size());
+        batch->teams.push_back(std::make_pair(team_l, team_r));
+        return true;
+    }
+
+    virtual
+    bool handleServerParam( const std::string & msg ) override {
+        return addMessage(PipelineBatch::SERVER_PARAM, msg);
+    }
+
+    virtual
+    bool handlePlayerParam( const std::string & msg ) override {
+        return addMessage(PipelineBatch::PLAYER_PARAM, msg);
+    }
+
+    virtual
+    bool handlePlayerType( const std::string & msg ) override {
+        return addMessage(PipelineBatch::PLAYER_TYPE, msg);
+    }
+
+private:
+    void add(const PipelineBatch::EventKind kind, const int time, const std::size_t index) {
+        PipelineBatch::Event e;
+        e.kind = kind;
+        e.time = time;
+        e.index = index;
+        batch->events.push_back(e);
+    }
+
+    bool addMessage(const PipelineBatch::EventKind kind, const std::string& msg) {
+        add(kind, 0, batch->messages.size());
+        batch->messages.push_back(msg);
+        return true;
+    }
+};
+
+bool
+MultiSinkCSVPrinter::parsePipelined(const std::string& path) {
+    // chunks of whole lines. the decoded data is cut at the last newline.
+    const std::size_t chunkSize = 1024 * 1024;
+    typedef std::unique_ptr<std::string> Chunk;
+    typedef std::shared_ptr<const PipelineBatch> Batch;
+
+    rcsc::gzifstream fin(path.c_str());
+    if (!fin.is_open()) {
+        std::cerr << "ERROR: Failed to open file : " << path << std::endl;
+        return false;
+    }
+
+    rcsc::SPSCQueue<Chunk> chunkQueue(8);
+    rcsc::SPSCQueue<Batch> matchQueue(8);
+    rcsc::SPSCQueue<Batch> paramsQueue(8);
+    const bool matchEnabled = static_cast<bool>(matchPrinter);
+    const bool paramsEnabled = serverParamsPrinter || playerParamsPrinter || playerTypesPrinter;
+
+    // set by a fatal error of the decode or parse stage. the other stages drain their queues.
+    std::atomic<bool> failed(false);
+
+    // decode stage
+    bool decodeResult = true;
+    std::thread decodeThread([&]() {
+            std::string carry;
+            while (!failed.load(std::memory_order_relaxed)) {
+                Chunk chunk(new std::string());
+                chunk->swap(carry);
+                const std::size_t old = chunk->size();
+                chunk->resize(old + chunkSize);
+                fin.read(&(*chunk)[old], chunkSize);
+                chunk->resize(old + static_cast<std::size_t>(fin.gcount()));
+                if (fin.gcount() <= 0) {
+                    if (fin.bad()) {
+                        std::cerr << "ERROR: Failed to read file : " << path << std::endl;
+                        decodeResult = false;
+                        failed = true;
+                    } else if (!chunk->empty()) {
+                        chunkQueue.push(std::move(chunk));
+                    }
+                    break;
+                }
+                const std::string::size_type eol = chunk->rfind('\n');
+                if (eol != std::string::npos) {
+                    carry.assign(*chunk, eol + 1, std::string::npos);
+                    chunk->resize(eol + 1);
+                    chunkQueue.push(std::move(chunk));
+                } else {
+                    carry.swap(*chunk);
+                }
+            }
+            chunkQueue.push(Chunk());
+        });
+
+    // format and write stages
+    // as in Parser::parse(), the rejected data is reported and the stages continue.
+    bool eofResult = true;
+    std::thread matchThread;
+    if (matchEnabled) {
+        matchThread = std::thread([&]() {
+                while (Batch batch = matchQueue.pop()) {
+                    for (const PipelineBatch::Event& e : batch->events) {
+                        switch (e.kind) {
+                        case PipelineBatch::SHOW:
+                            handleShow(batch->shows[e.index]);
+                            break;
+                        case PipelineBatch::PLAYMODE:
+                            handlePlayMode(e.time, batch->playmodes[e.index]);
+                            break;
+                        case PipelineBatch::TEAM:
+                            handleTeam(e.time, batch->teams[e.index].first, batch->teams[e.index].second);
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                }
+                // Parser::parse() does not reach handleEOF() after a fatal error.
+                if (!failed.load()) {
+                    eofResult = handleEOF();
+                }
+            });
+    }
+
+    std::thread paramsThread;
+    if (paramsEnabled) {
+        paramsThread = std::thread([&]() {
+                while (Batch batch = paramsQueue.pop()) {
+                    for (const PipelineBatch::Event& e : batch->events) {
+                        switch (e.kind) {
+                        case PipelineBatch::SERVER_PARAM:
+                            if (!handleServerParam(batch->messages[e.index])) {
+                                std::cerr << "error: Illegal server_param line. \"" << batch->messages[e.index] << "\"" << std::endl;
+                            }
+                            break;
+                        case PipelineBatch::PLAYER_PARAM:
+                            if (!handlePlayerParam(batch->messages[e.index])) {
+                                std::cerr << "error: Illegal player_param line. \"" << batch->messages[e.index] << "\"" << std::endl;
+                            }
+                            break;
+                        case PipelineBatch::PLAYER_TYPE:
+                            if (!handlePlayerType(batch->messages[e.index])) {
+                                std::cerr << "error: Illegal player_type line. \"" << batch->messages[e.index] << "\"" << std::endl;
+                            }
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                }
+            });
+    }
+
+    // parse stage (this thread)
+    bool result = true;
+    bool headerRead = false;
+    int nLine = 1;
+    const rcsc::rcg::ParserMMap parser;
+    PipelineRecorder recorder;
+    recorder.required = projection();
+    while (Chunk chunk = chunkQueue.pop()) {
+        if (!result || failed.load(std::memory_order_relaxed)) {
+            // drain the decoder
+            continue;
+        }
+
+        const char* first = chunk->data();
+        const char* last = first + chunk->size();
+        if (!headerRead) {
+            headerRead = true;
+            if (chunk->compare(0, 4, "ULG4") != 0
+                && chunk->compare(0, 4, "ULG5") != 0) {
+                std::cerr << "ERROR: The pipelined mode supports only rcg v4/v5 : " << path << std::endl;
+                result = false;
+                failed = true;
+                continue;
+            }
+            const char* eol = static_cast<const char*>(std::memchr(first, '\n', last - first));
+            first = (eol ? eol + 1 : last);
+            nLine = 2;
+            // the writer threads see the version through the queue
+            if (!handleLogVersion((*chunk)[3] == '4' ? rcsc::rcg::REC_VERSION_4 : rcsc::rcg::REC_VERSION_5)) {
+                result = false;
+                failed = true;
+                continue;
+            }
+        }
+
+        recorder.batch = std::make_shared<PipelineBatch>();
+        if (!parser.parseLines(first, last, recorder, nLine)) {
+            result = false;
+            failed = true;
+        }
+        nLine += static_cast<int>(std::count(first, last, '\n'));
+
+        // the events parsed before the error are written as in the serial mode
+        Batch batch = recorder.batch;
+        recorder.batch.reset();
+        if (!batch->events.empty()) {
+            if (matchEnabled) matchQueue.push(batch);
+            if (paramsEnabled) paramsQueue.push(batch);
+        }
+    }
+
+    if (matchEnabled) matchQueue.push(Batch());
+    if (paramsEnabled) paramsQueue.push(Batch());
+
+    decodeThread.join();
+    if (matchThread.joinable()) matchThread.join();
+    if (paramsThread.joinable()) paramsThread.join();
+
+    return result && decodeResult && eofResult && !hasHandlerError();
+}
+
 ////////////////////////////////////////////////////////////////////////
 
 class RCG2CSVOptions {
@@ -1560,6 +2112,43 @@ public:
     const std::string& getRCGSourcePath() const noexcept {
         return rcgSourcePath;
     }
+    const std::vector<std::string>& getRCGSourcePaths() const noexcept {
+        return rcgSourcePaths;
+    }
+    const std::string& getListPath() const noexcept {
+        return listPath;
+    }
+    const std::string& getOutputDir() const noexcept {
+        return outputDir;
+    }
+    const std::string& getGamesTableOutputPath() const noexcept {
+        return gamesTableOutputPath;
+    }
+    int getJobs() const noexcept {
+        return jobs;
+    }
+    bool pipelineEnabled() const noexcept {
+        return pipelineSwitch;
+    }
+    /*!
+      \brief Gets the ball and player column groups printed in the Match table.
+      \return rcsc::rcg::Projection::ShowField bits.
+    */
+    int getShowFields() const noexcept {
+        return showFields;
+    }
+    /*!
+      \brief Checks if the Match table is written as columnar .npy files.
+      \return true if the output format is "npy".
+    */
+    bool npyFormatEnabled() const noexcept {
+        return format == "npy";
+    }
+    /*!
+      \brief Checks if multiple logs are converted in a single run.
+      \return true if more than one source, a directory, a list file, an output directory or the games table is given.
+    */
+    bool batchModeEnabled() const;
 
     //<! Below is just a commodity so we don't add lots of setters.
     friend void fillFromCmdLine(int, const char* const*, RCG2CSVOptions&);
@@ -1573,13 +2162,40 @@ private:
     bool playerTypesTableSwitch = false;
     std::string playerTypesTableOutputPath;
     std::string rcgSourcePath;
+    std::vector<std::string> rcgSourcePaths;
+    std::string listPath;
+    std::string outputDir;
+    std::string gamesTableOutputPath;
+    int jobs = 0;
+    std::string format = "csv";
+    bool pipelineSwitch = false;
+    std::string columns = "all";
+    int showFields = rcsc::rcg::Projection::ALL_SHOW_FIELDS;
 };
 
+bool
+isDirectory(const std::string& path)
+{
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool
+RCG2CSVOptions::batchModeEnabled() const
+{
+    return rcgSourcePaths.size() > 1
+        || !listPath.empty()
+        || !outputDir.empty()
+        || !gamesTableOutputPath.empty()
+        || (rcgSourcePaths.size() == 1 && isDirectory(rcgSourcePaths.front()));
+}
+
 ////////////////////////////////////////////////////////////////////////
 
 void usage()
 {
-    std::cerr << "Usage: rcg2csv [options] <RCGFile>[.gz]" << std::endl;
+    std::cerr << "Usage: rcg2csv [options] <RCGFile>[.gz]\n"
+              << "       rcg2csv [options] <RCGFile|Directory>... [--list <ListFile>]" << std::endl;
 }
 
 void fillFromCmdLine(int argc, const char* const* argv, RCG2CSVOptions& options)
@@ -1597,6 +2213,13 @@ void fillFromCmdLine(int argc, const char* const* argv, RCG2CSVOptions& options)
         ("playerparams-out", "ppo", &options.playerParamsTableOutputPath, "Output path for the PlayerParams table. Leave empty to use the standard output.")
         ("playertypes", "pt", rcsc::BoolSwitch(&options.playerTypesTableSwitch), "Print CSV table with player types available in the match.")
         ("playertypes-out", "pto", &options.playerTypesTableOutputPath, "Output path for the PlayerTypes table. Leave empty to use the standard output.")
+        ("format", "f", &options.format, "Output format of the Match table, \"csv\" or \"npy\". The npy format writes one NumPy file per column into the directory given by --match-out (or per game under --out-dir). The other tables are always CSV.")
+        ("pipeline", "", rcsc::BoolSwitch(&options.pipelineSwitch), "Decode, parse and write the tables in separate threads. Only for a single rcg v4/v5 file.")
+        ("columns", "c", &options.columns, "Comma separated column groups of the CSV Match table: ball, ball_pos, ball_vel, player, player_state, player_pos, player_vel, player_body, player_arm, player_view, player_stamina, player_focus, player_count or all. The fields of the other groups are not converted while parsing an uncompressed rcg v4/v5 file.")
+        ("list", "l", &options.listPath, "Batch mode: file listing the RCG files to be converted, one path per line.")
+        ("jobs", "j", &options.jobs, "Batch mode: the number of parser threads. 0 means the number of hardware threads.")
+        ("out-dir", "od", &options.outputDir, "Batch mode: write one Match table per game into this directory instead of a merged table.")
+        ("games-out", "go", &options.gamesTableOutputPath, "Batch mode: output path for the Games table that maps each game to its parameter table rows.")
         ;
     // The capture variables default values are the ones stored before parsing.
     // If we don't generate the help message before parsing, we lose them and will display a wrong help message.
@@ -1617,18 +2240,57 @@ void fillFromCmdLine(int argc, const char* const* argv, RCG2CSVOptions& options)
         exit(1);
     }
 
-    // Collect RCG source path
-    if (cmdLineParser.positionalOptions().size() != 1) {
-        std::cerr << "ERROR: Expected 1 positional argument." << std::endl;
+    // Collect RCG source paths
+    options.rcgSourcePaths.assign(cmdLineParser.positionalOptions().begin(),
+                                  cmdLineParser.positionalOptions().end());
+    if (options.rcgSourcePaths.empty() && options.listPath.empty()) {
+        std::cerr << "ERROR: Expected at least 1 positional argument." << std::endl;
+        usage();
+        std::cerr << helpMessage.str();
+        exit(1);
+    }
+    if (!options.rcgSourcePaths.empty()) {
+        options.rcgSourcePath = options.rcgSourcePaths.front();
+    }
+    if (options.format != "csv" && options.format != "npy") {
+        std::cerr << "ERROR: Unknown output format \"" << options.format << "\"." << std::endl;
+        usage();
+        std::cerr << helpMessage.str();
+        exit(1);
+    }
+    options.showFields = rcsc::rcg::Projection::parse_show_fields(options.columns);
+    if (options.showFields < 0) {
+        std::cerr << "ERROR: Unknown column group in \"" << options.columns << "\"." << std::endl;
+        usage();
+        std::cerr << helpMessage.str();
+        exit(1);
+    }
+    if (options.npyFormatEnabled()
+        && options.showFields != rcsc::rcg::Projection::ALL_SHOW_FIELDS) {
+        std::cerr << "ERROR: The column groups can be selected only for the csv format." << std::endl;
+        usage();
+        std::cerr << helpMessage.str();
+        exit(1);
+    }
+    if (options.npyFormatEnabled()
+        && options.matchTableSwitch
+        && options.matchTableOutputPath.empty()
+        && options.outputDir.empty()) {
+        std::cerr << "ERROR: The npy format requires an output directory given by --match-out or --out-dir." << std::endl;
+        usage();
+        std::cerr << helpMessage.str();
+        exit(1);
+    }
+    if (options.jobs < 0) {
+        std::cerr << "ERROR: The number of jobs must not be negative." << std::endl;
         usage();
         std::cerr << helpMessage.str();
         exit(1);
     }
-    options.rcgSourcePath = cmdLineParser.positionalOptions().front();
 
     // Exit with error if multiple tables will print at standard output
     std::vector<bool> enabled{
-        options.matchTableSwitch, 
+        options.matchTableSwitch && options.outputDir.empty() && !options.npyFormatEnabled(),
         options.serverParamsTableSwitch,
         options.playerParamsTableSwitch,
         options.playerTypesTableSwitch
@@ -1654,6 +2316,531 @@ void fillFromCmdLine(int argc, const char* const* argv, RCG2CSVOptions& options)
 }
 
 
+////////////////////////////////////////////////////////////////////////
+
+/*!
+  \brief Collects the data of one game in batch mode.
+
+  Show, playmode and team data are printed to the match table by the worker thread.
+  Parameter messages are only stored here. They are parsed into the global
+  ServerParam/PlayerParam instances by the writer thread, after deduplication.
+*/
+class BatchGameHandler
+    : public rcsc::rcg::Handler {
+public:
+    explicit
+    BatchGameHandler(rcsc::rcg::Handler* matchPrinter)
+    :   matchPrinter(matchPrinter)
+    {}
+
+    virtual
+    rcsc::rcg::Projection projection() const override {
+        using rcsc::rcg::Projection;
+        // the parameter messages are always collected for the deduplicated tables
+        Projection required(Projection::SERVER_PARAM_LINE | Projection::PLAYER_PARAM_LINE | Projection::PLAYER_TYPE_LINE, 0);
+        if (matchPrinter) {
+            const Projection match = matchPrinter->projection();
+            required.add(Projection(match.lines() & (Projection::SHOW_LINE | Projection::PLAYMODE_LINE | Projection::TEAM_LINE),
+                                    match.showFields()));
+        }
+        return required;
+    }
+
+    virtual
+    bool handleLogVersion( const int ver ) override {
+        rcsc::rcg::Handler::handleLogVersion(ver);
+        if (matchPrinter) {
+            return matchPrinter->handleLogVersion(ver);
+        }
+        if (ver < 4) {
+            std::cerr << "Unsupported RCG version " << ver << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    virtual
+    bool handleShow( const rcsc::rcg::ShowInfoT & show ) override {
+        return matchPrinter ? matchPrinter->handleShow(show) : true;
+    }
+
+    virtual
+    bool handleMsg( const int,
+                    const int,
+                    const std::string & ) override {
+        return true;
+    }
+
+    virtual
+    bool handleDraw( const int,
+                     const rcsc::rcg::drawinfo_t & ) override {
+        return true;
+    }
+
+    virtual
+    bool handlePlayMode( const int time,
+                         const rcsc::PlayMode pm ) override {
+        return matchPrinter ? matchPrinter->handlePlayMode(time, pm) : true;
+    }
+
+    virtual
+    bool handleTeam( const int time,
+                     const rcsc::rcg::TeamT & team_l,
+                     const rcsc::rcg::TeamT & team_r ) override {
+        return matchPrinter ? matchPrinter->handleTeam(time, team_l, team_r) : true;
+    }
+
+    virtual
+    bool handleServerParam( const std::string & msg ) override {
+        serverParam = msg;
+        return true;
+    }
+
+    virtual
+    bool handlePlayerParam( const std::string & msg ) override {
+        playerParam = msg;
+        return true;
+    }
+
+    virtual
+    bool handlePlayerType( const std::string & msg ) override {
+        playerTypes.push_back(msg);
+        return true;
+    }
+
+    virtual
+    bool handleEOF() override {
+        return matchPrinter ? matchPrinter->handleEOF() : true;
+    }
+
+    std::string serverParam; //<! The raw server_param message
+    std::string playerParam; //<! The raw player_param message
+    std::vector<std::string> playerTypes; //<! The raw player_type messages in the logged order
+
+private:
+    rcsc::rcg::Handler* matchPrinter; //<! Prints the match table of this game. May be null.
+};
+
+/*!
+  \brief The number of games per parser thread that may be in flight in batch mode.
+*/
+const size_t BATCH_WINDOW_PER_THREAD = 4;
+
+/*!
+  \brief The result of one game in batch mode, handed from a worker to the writer.
+*/
+struct BatchGameResult {
+    bool done = false; //<! Set by the worker when the game is finished
+    bool ok = false; //<! True if the game was parsed without errors
+    std::string matchTable; //<! Match table rows, if the tables are merged
+    std::string serverParam;
+    std::string playerParam;
+    std::vector<std::string> playerTypes;
+};
+
+/*!
+  \brief Assigns the same id to identical parameter messages.
+
+  Ids start at 1 and follow the order in which the contents are first seen.
+*/
+class ParamTableDeduplicator {
+public:
+    /*!
+      \brief Gets the id of the content.
+      \param content The raw message. An empty content is given the id 0.
+      \param isNew Set to true if the content was not seen before.
+      \return The id of the content.
+    */
+    int lookup(const std::string& content, bool& isNew) {
+        isNew = false;
+        if (content.empty()) {
+            return 0;
+        }
+        auto result = ids.insert(std::make_pair(content, static_cast<int>(ids.size()) + 1));
+        isNew = result.second;
+        return result.first->second;
+    }
+
+private:
+    std::map<std::string, int> ids;
+};
+
+bool
+hasRCGExtension(const std::string& path)
+{
+    static const std::string rcg = ".rcg";
+    static const std::string rcgGz = ".rcg.gz";
+    return (path.size() > rcg.size() && path.compare(path.size() - rcg.size(), rcg.size(), rcg) == 0)
+        || (path.size() > rcgGz.size() && path.compare(path.size() - rcgGz.size(), rcgGz.size(), rcgGz) == 0);
+}
+
+/*!
+  \brief Returns the file name without directories and the .rcg[.gz] extension.
+*/
+std::string
+gameStem(const std::string& path)
+{
+    std::string::size_type slash = path.find_last_of('/');
+    std::string name = (slash == std::string::npos ? path : path.substr(slash + 1));
+    std::string::size_type dot = name.rfind(".rcg");
+    if (dot != std::string::npos && dot > 0) {
+        name.erase(dot);
+    }
+    return name;
+}
+
+/*!
+  \brief Collects the .rcg/.rcg.gz files under the directory recursively.
+  \param dir The directory path.
+  \param paths The collected paths are appended to this vector.
+  \return false if the directory could not be read.
+*/
+bool
+collectRCGFiles(const std::string& dir, std::vector<std::string>& paths)
+{
+    DIR* d = ::opendir(dir.c_str());
+    if (!d) {
+        std::cerr << "ERROR: Failed to open directory : " << dir << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> subdirs;
+    while (const struct dirent* entry = ::readdir(d)) {
+        const std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        const std::string path = (!dir.empty() && dir.back() == '/') ? dir + name : dir + '/' + name;
+        if (isDirectory(path)) {
+            subdirs.push_back(path);
+        } else if (hasRCGExtension(name)) {
+            paths.push_back(path);
+        }
+    }
+    ::closedir(d);
+
+    bool ok = true;
+    for (const std::string& subdir : subdirs) {
+        ok = collectRCGFiles(subdir, paths) && ok;
+    }
+    return ok;
+}
+
+/*!
+  \brief Builds the ordered list of games from the positional arguments and the list file.
+
+  Directories are expanded to their sorted .rcg/.rcg.gz files.
+  Explicitly given files keep the given order.
+*/
+bool
+collectGamePaths(const RCG2CSVOptions& options, std::vector<std::string>& paths)
+{
+    std::vector<std::string> sources = options.getRCGSourcePaths();
+    if (!options.getListPath().empty()) {
+        std::ifstream fin(options.getListPath());
+        if (!fin) {
+            std::cerr << "ERROR: Failed to open list file : " << options.getListPath() << std::endl;
+            return false;
+        }
+        std::string line;
+        while (std::getline(fin, line)) {
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (!line.empty() && line[0] != '#') {
+                sources.push_back(line);
+            }
+        }
+    }
+
+    for (const std::string& source : sources) {
+        if (isDirectory(source)) {
+            std::vector<std::string> found;
+            if (!collectRCGFiles(source, found)) {
+                return false;
+            }
+            std::sort(found.begin(), found.end());
+            paths.insert(paths.end(), found.begin(), found.end());
+        } else {
+            paths.push_back(source);
+        }
+    }
+    return true;
+}
+
+/*!
+  \brief Parses one game. Executed by a worker thread.
+  \param path The RCG file path.
+  \param gameId The 1-based game index printed in the merged match table.
+  \param options The command line options.
+  \param result The parsed data.
+*/
+void
+parseGame(const std::string& path,
+          const int gameId,
+          const RCG2CSVOptions& options,
+          BatchGameResult& result)
+{
+    std::ostringstream matchBuffer;
+    std::ofstream matchFile;
+    std::unique_ptr<rcsc::rcg::Handler> matchPrinter;
+    if (options.matchTableEnabled()) {
+        if (options.npyFormatEnabled()) {
+            const std::string outDir = options.getOutputDir() + '/' + gameStem(path);
+            std::unique_ptr<rcsc::rcg::NpyWriter> writer(new rcsc::rcg::NpyWriter());
+            if (!writer->open(outDir)) {
+                std::cerr << "ERROR: Could not open match table output directory \"" << outDir << "\"" << std::endl;
+                return;
+            }
+            matchPrinter = std::move(writer);
+        } else if (options.getOutputDir().empty()) {
+            CSVPrinter* printer = new CSVPrinter(matchBuffer);
+            printer->setGameId(gameId);
+            printer->setPrintHeader(false);
+            printer->setShowFields(options.getShowFields());
+            matchPrinter.reset(printer);
+        } else {
+            const std::string outPath = options.getOutputDir() + '/' + gameStem(path) + ".csv";
+            matchFile.open(outPath);
+            if (!matchFile) {
+                std::cerr << "ERROR: Could not open match table output file \"" << outPath << "\"" << std::endl;
+                return;
+            }
+            CSVPrinter* printer = new CSVPrinter(matchFile);
+            printer->setShowFields(options.getShowFields());
+            matchPrinter.reset(printer);
+        }
+    }
+
+    BatchGameHandler handler(matchPrinter.get());
+
+    rcsc::rcg::ParserMMap mmapParser;
+    const bool compressed = path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+    if (!compressed && mmapParser.open(path)) {
+        result.ok = mmapParser.parse(handler);
+    } else {
+        rcsc::gzifstream fin(path.c_str());
+        if (!fin.is_open()) {
+            std::cerr << "ERROR: Failed to open file : " << path << std::endl;
+            return;
+        }
+        rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create(fin);
+        if (!parser) {
+            std::cerr << "ERROR: Failed to create rcg parser : " << path << std::endl;
+            return;
+        }
+        result.ok = parser->parse(fin, handler);
+    }
+
+    if (!result.ok) {
+        std::cerr << "ERROR: Failed to parse file : " << path << std::endl;
+    }
+
+    result.matchTable = matchBuffer.str();
+    result.serverParam.swap(handler.serverParam);
+    result.playerParam.swap(handler.playerParam);
+    result.playerTypes.swap(handler.playerTypes);
+}
+
+/*!
+  \brief Opens the output sink of a merged table.
+  \return The opened file, or null to use the standard output.
+*/
+bool
+openTableSink(const std::string& path,
+              const char* tableName,
+              std::unique_ptr<std::ofstream>& sink)
+{
+    if (path.empty()) {
+        return true;
+    }
+    sink.reset(new std::ofstream(path));
+    if (sink->fail()) {
+        std::cerr << "ERROR: Could not open " << tableName << " table output file \"" << path << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*!
+  \brief Converts multiple games.
+
+  The games are parsed on a work stealing thread pool. The results are written
+  by the calling thread in the order of the game list, so the output does not
+  depend on the number of threads. The parameter tables contain one row per
+  distinct content, and the games table refers to those rows.
+*/
+int
+runBatch(const RCG2CSVOptions& options)
+{
+    std::vector<std::string> paths;
+    if (!collectGamePaths(options, paths)) {
+        return 1;
+    }
+    if (paths.empty()) {
+        std::cerr << "WARNING: No RCG files found." << std::endl;
+        return 0;
+    }
+
+    if (options.npyFormatEnabled() && options.matchTableEnabled() && options.getOutputDir().empty()) {
+        std::cerr << "ERROR: The npy format cannot merge multiple games. Use --out-dir." << std::endl;
+        return 1;
+    }
+
+    if (!options.getOutputDir().empty() && options.matchTableEnabled()) {
+        if (!isDirectory(options.getOutputDir())
+            && ::mkdir(options.getOutputDir().c_str(), 0755) != 0) {
+            std::cerr << "ERROR: Could not create output directory \"" << options.getOutputDir() << "\"" << std::endl;
+            return 1;
+        }
+
+        std::set<std::string> stems;
+        for (const std::string& path : paths) {
+            if (!stems.insert(gameStem(path)).second) {
+                std::cerr << "ERROR: Multiple games would be written to \""
+                          << options.getOutputDir() << '/' << gameStem(path)
+                          << (options.npyFormatEnabled() ? "/" : ".csv") << "\"" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // Merged table sinks
+    std::unique_ptr<std::ofstream> matchSink, serverParamsSink, playerParamsSink, playerTypesSink, gamesSink;
+    if ((options.matchTableEnabled() && options.getOutputDir().empty()
+         && !openTableSink(options.getMatchTableOutputPath(), "match", matchSink))
+        || (options.serverParamsTableEnabled()
+            && !openTableSink(options.getServerParamsTableOutputPath(), "server params", serverParamsSink))
+        || (options.playerParamsTableEnabled()
+            && !openTableSink(options.getPlayerParamsTableOutputPath(), "player params", playerParamsSink))
+        || (options.playerTypesTableEnabled()
+            && !openTableSink(options.getPlayerTypesTableOutputPath(), "player types", playerTypesSink))
+        || !openTableSink(options.getGamesTableOutputPath(), "games", gamesSink)) {
+        return 1;
+    }
+    std::ostream& matchOut = matchSink ? *matchSink : std::cout;
+    std::ostream& serverParamsOut = serverParamsSink ? *serverParamsSink : std::cout;
+    std::ostream& playerParamsOut = playerParamsSink ? *playerParamsSink : std::cout;
+    std::ostream& playerTypesOut = playerTypesSink ? *playerTypesSink : std::cout;
+
+    if (options.matchTableEnabled() && options.getOutputDir().empty()) {
+        CSVPrinter headerPrinter(matchOut);
+        headerPrinter.setGameId(1);
+        headerPrinter.setShowFields(options.getShowFields());
+        headerPrinter.printShowHeader();
+    }
+    if (gamesSink) {
+        *gamesSink << "game,path,server_param,player_param,player_types" << std::endl;
+    }
+
+    rcsc::ThreadPool pool(static_cast<std::size_t>(options.getJobs()));
+
+    // At most `window` games are parsed or waiting to be written at the same
+    // time, so the memory usage does not depend on the number of files.
+    const size_t window = std::min(paths.size(), pool.size() * BATCH_WINDOW_PER_THREAD);
+    std::vector<BatchGameResult> results(window);
+    std::mutex resultMutex;
+    std::condition_variable resultCond;
+
+    auto submitGame = [&](const size_t i) {
+        pool.submit([&, i]() {
+                BatchGameResult result;
+                parseGame(paths[i], static_cast<int>(i) + 1, options, result);
+                std::lock_guard<std::mutex> lock(resultMutex);
+                results[i % window] = std::move(result);
+                results[i % window].done = true;
+                resultCond.notify_all();
+            });
+    };
+    for (size_t i = 0; i < window; i++) {
+        submitGame(i);
+    }
+
+    // Write the results in the game order while the workers continue.
+    ParamTableDeduplicator serverParamIds, playerParamIds, playerTypesIds;
+    std::string currentServerParam, currentPlayerParam;
+    int failed = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        BatchGameResult result;
+        {
+            std::unique_lock<std::mutex> lock(resultMutex);
+            resultCond.wait(lock, [&]() { return results[i % window].done; });
+            result = std::move(results[i % window]);
+            results[i % window] = BatchGameResult();
+        }
+
+        // The slot is free. Start the next game.
+        if (i + window < paths.size()) {
+            submitGame(i + window);
+        }
+
+        if (!result.ok) {
+            failed++;
+            continue;
+        }
+
+        if (options.matchTableEnabled() && options.getOutputDir().empty()) {
+            matchOut << result.matchTable;
+        }
+
+        // ServerParam/PlayerParam are global, and PlayerType depends on ServerParam.
+        // They are updated only in this thread.
+        if (!result.serverParam.empty() && result.serverParam != currentServerParam) {
+            rcsc::ServerParam::instance().parse(result.serverParam.c_str(), 8);
+            currentServerParam = result.serverParam;
+        }
+        if (!result.playerParam.empty() && result.playerParam != currentPlayerParam) {
+            rcsc::PlayerParam::instance().parse(result.playerParam.c_str(), 8);
+            currentPlayerParam = result.playerParam;
+        }
+
+        bool isNew = false;
+        const int serverParamId = serverParamIds.lookup(result.serverParam, isNew);
+        if (isNew && options.serverParamsTableEnabled()) {
+            CSVPrinter printer(serverParamsOut);
+            printer.setRowId(serverParamId);
+            printer.setPrintHeader(serverParamId == 1);
+            printer.handleServerParam(result.serverParam);
+        }
+
+        const int playerParamId = playerParamIds.lookup(result.playerParam, isNew);
+        if (isNew && options.playerParamsTableEnabled()) {
+            CSVPrinter printer(playerParamsOut);
+            printer.setRowId(playerParamId);
+            printer.setPrintHeader(playerParamId == 1);
+            printer.handlePlayerParam(result.playerParam);
+        }
+
+        std::string playerTypesKey;
+        for (const std::string& msg : result.playerTypes) {
+            playerTypesKey += msg;
+            playerTypesKey += '\n';
+        }
+        const int playerTypesId = playerTypesIds.lookup(playerTypesKey, isNew);
+        if (isNew && options.playerTypesTableEnabled()) {
+            CSVPrinter printer(playerTypesOut);
+            printer.setRowId(playerTypesId);
+            printer.setPrintHeader(playerTypesId == 1);
+            for (const std::string& msg : result.playerTypes) {
+                printer.handlePlayerType(msg);
+            }
+        }
+
+        if (gamesSink) {
+            *gamesSink << i + 1
+                       << ',' << paths[i]
+                       << ',' << serverParamId
+                       << ',' << playerParamId
+                       << ',' << playerTypesId
+                       << '\n';
+        }
+    }
+
+    if (failed > 0) {
+        std::cerr << "ERROR: Failed to convert " << failed << " of " << paths.size() << " files." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int
 main( int argc, char** argv )
 {
@@ -1669,6 +2856,10 @@ main( int argc, char** argv )
         std::cerr << "WARNING: No work to be done." << std::endl;
     }
 
+    if (options.batchModeEnabled()) {
+        return runBatch(options);
+    }
+
 
     rcsc::gzifstream fin( options.getRCGSourcePath().c_str() );
 
@@ -1691,15 +2882,20 @@ main( int argc, char** argv )
     // Initialize MultiSink Printer
     // Match
     if (options.matchTableEnabled()) {
-        if (options.getMatchTableOutputPath().empty()) {
-            printer.enableMatchPrinter();
+        if (options.npyFormatEnabled()) {
+            if (!printer.enableMatchNpyWriter(options.getMatchTableOutputPath())) {
+                std::cerr << "ERROR: Could not open match table output directory \"" << options.getMatchTableOutputPath() << "\"" << std::endl;
+                return 1;
+            }
+        } else if (options.getMatchTableOutputPath().empty()) {
+            printer.enableMatchPrinter(nullptr, options.getShowFields());
         } else {
             std::unique_ptr<std::ostream> matchTableSink(new std::ofstream(options.getMatchTableOutputPath()));
             if (matchTableSink->fail()) {
                 std::cerr << "ERROR: Could not open match table output file \"" << options.getMatchTableOutputPath() << "\"" << std::endl;
                 return 1;
             }
-            printer.enableMatchPrinter(std::move(matchTableSink));
+            printer.enableMatchPrinter(std::move(matchTableSink), options.getShowFields());
         }
     }
     // Server Parameters
@@ -1742,7 +2938,30 @@ main( int argc, char** argv )
         }
     }
 
-    parser->parse( fin, printer );
+    if (options.pipelineEnabled()
+        && (parser->version() == rcsc::rcg::REC_VERSION_4
+            || parser->version() == rcsc::rcg::REC_VERSION_5)) {
+        fin.close();
+        return printer.parsePipelined(options.getRCGSourcePath()) ? 0 : 1;
+    }
+
+    // the mapped parser skips the conversion of the unused show fields
+    const std::string& path = options.getRCGSourcePath();
+    const bool compressed = path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+    if (!compressed
+        && (parser->version() == rcsc::rcg::REC_VERSION_4
+            || parser->version() == rcsc::rcg::REC_VERSION_5)) {
+        rcsc::rcg::ParserMMap mmapParser;
+        if (mmapParser.open(path)) {
+            fin.close();
+            return (mmapParser.parse(printer) && !printer.hasHandlerError()) ? 0 : 1;
+        }
+    }
+
+    if ( ! parser->parse( fin, printer )
+         || printer.hasHandlerError() ) {
+        return 1;
+    }
 
     return 0;
 }
@@ -16,6 +16,7 @@
 
 #include <rcsc/gz.h>
 #include <rcsc/rcg.h>
+#include <rcsc/rcg/format_buffer.h>
 
 /*
 
@@ -103,6 +104,9 @@ private:
 
     std::ostream & M_os;
 
+    //! formatting buffer for the info lines
+    rcsc::rcg::FormatBuffer M_buf;
+
     bool M_init_written;
     rcsc::PlayMode M_playmode;
     std::string M_left_team_name;
@@ -150,25 +154,25 @@ private:
     std::string & getPlayModeString( const rcsc::PlayMode playmode ) const;
 
 
-    std::ostream & printState( std::ostream & os,
-                               const long & cycle ) const;
-
-    std::ostream & printBall( std::ostream & os,
-                              const rcsc::rcg::pos_t & ball ) const;
-    std::ostream & printBall( std::ostream & os,
-                              const rcsc::rcg::ball_t & ball ) const;
-
-    std::ostream & printPlayer( std::ostream & os,
-                                //const std::string & teamname,
-                                const rcsc::SideID side,
-                                const int unum,
-                                const rcsc::rcg::pos_t & player ) const;
-    std::ostream & printPlayer( std::ostream & os,
-                                //const std::string & teamname,
-                                const rcsc::SideID side,
-                                const int unum,
-                                const CommandCount & count,
-                                const rcsc::rcg::player_t & player ) const;
+    rcsc::rcg::FormatBuffer & printState( rcsc::rcg::FormatBuffer & os,
+                                          const long & cycle ) const;
+
+    rcsc::rcg::FormatBuffer & printBall( rcsc::rcg::FormatBuffer & os,
+                                         const rcsc::rcg::pos_t & ball ) const;
+    rcsc::rcg::FormatBuffer & printBall( rcsc::rcg::FormatBuffer & os,
+                                         const rcsc::rcg::ball_t & ball ) const;
+
+    rcsc::rcg::FormatBuffer & printPlayer( rcsc::rcg::FormatBuffer & os,
+                                           //const std::string & teamname,
+                                           const rcsc::SideID side,
+                                           const int unum,
+                                           const rcsc::rcg::pos_t & player ) const;
+    rcsc::rcg::FormatBuffer & printPlayer( rcsc::rcg::FormatBuffer & os,
+                                           //const std::string & teamname,
+                                           const rcsc::SideID side,
+                                           const int unum,
+                                           const CommandCount & count,
+                                           const rcsc::rcg::player_t & player ) const;
 };
 
 
@@ -217,13 +221,13 @@ TextPrinter::handleShow( const rcsc::rcg::ShowInfoT & show )
         M_os << "(Init)" << "\n";
     }
 
-    M_os << "(Info ";
-    printState( M_os, show.time_ );
+    M_buf << "(Info ";
+    printState( M_buf, show.time_ );
 
     // ball
-    M_os << " (ball "
-         << show.ball_.x_ << ' ' << show.ball_.y_ << ' '
-         << show.ball_.vx_ << ' ' << show.ball_.vy_ << ')';
+    M_buf << " (ball "
+          << show.ball_.x_ << ' ' << show.ball_.y_ << ' '
+          << show.ball_.vx_ << ' ' << show.ball_.vy_ << ')';
 
     // players
     for ( int i = 0; i < rcsc::MAX_PLAYER*2; ++i )
@@ -231,7 +235,7 @@ TextPrinter::handleShow( const rcsc::rcg::ShowInfoT & show )
         rcsc::rcg::player_t p;
         rcsc::rcg::convert( show.player_[i], p );
 
-        printPlayer( M_os,
+        printPlayer( M_buf,
                      show.player_[i].side(),
                      show.player_[i].unum_,
                      M_command_count[i],
@@ -239,7 +243,8 @@ TextPrinter::handleShow( const rcsc::rcg::ShowInfoT & show )
         M_command_count[i].update( show.player_[i] );
     }
 
-    M_os << ")\n";
+    M_buf << ")\n";
+    M_buf.flush( M_os );
     return true;
 }
 
@@ -416,8 +421,8 @@ TextPrinter::getPlayModeString( const rcsc::PlayMode playmode ) const
 /*!
 
  */
-std::ostream &
-TextPrinter::printState( std::ostream & os,
+rcsc::rcg::FormatBuffer &
+TextPrinter::printState( rcsc::rcg::FormatBuffer & os,
                          const long & cycle ) const
 {
     os << "(state "
@@ -432,8 +437,8 @@ TextPrinter::printState( std::ostream & os,
 /*!
   old log format
 */
-std::ostream &
-TextPrinter::printBall( std::ostream & os,
+rcsc::rcg::FormatBuffer &
+TextPrinter::printBall( rcsc::rcg::FormatBuffer & os,
                         const rcsc::rcg::pos_t & ball ) const
 {
     os << "(ball "
@@ -447,8 +452,8 @@ TextPrinter::printBall( std::ostream & os,
 /*!
 
  */
-std::ostream &
-TextPrinter::printBall( std::ostream & os,
+rcsc::rcg::FormatBuffer &
+TextPrinter::printBall( rcsc::rcg::FormatBuffer & os,
                         const rcsc::rcg::ball_t & ball ) const
 {
     os << "(ball "
@@ -465,8 +470,8 @@ TextPrinter::printBall( std::ostream & os,
 /*!
   old log format
 */
-std::ostream &
-TextPrinter::printPlayer( std::ostream & os,
+rcsc::rcg::FormatBuffer &
+TextPrinter::printPlayer( rcsc::rcg::FormatBuffer & os,
                           //const std::string & teamname,
                           const rcsc::SideID side,
                           const int unum,
@@ -524,8 +529,8 @@ TextPrinter::printPlayer( std::ostream & os,
 /*!
 
  */
-std::ostream &
-TextPrinter::printPlayer( std::ostream & os,
+rcsc::rcg::FormatBuffer &
+TextPrinter::printPlayer( rcsc::rcg::FormatBuffer & os,
                           //const std::string & teamname,
                           const rcsc::SideID side,
                           const int unum,
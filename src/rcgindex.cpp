@@ -0,0 +1,117 @@
+// -*-c++-*-
+
+/*!
+  \file rcgindex.cpp
+  \brief rcg cycle index builder source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/rcg/cycle_index.h>
+
+#include <iostream>
+#include <string>
+#include <cstring>
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog <<  " [-f] <RcgFile>[.gz] ...\n"
+              << "  Create the cycle index file (<RcgFile>.idx) for each rcg v4/v5 file.\n"
+              << "  -f  rebuild the index even if the existing index file is up to date."
+              << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    if ( argc < 2 )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    bool force = false;
+    int result = 0;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "-f" ) )
+        {
+            force = true;
+            continue;
+        }
+
+        if ( argv[i][0] == '-' )
+        {
+            usage( argv[0] );
+            return 1;
+        }
+
+        const std::string log_path = argv[i];
+        const std::string index_path = rcsc::rcg::CycleIndex::sidecar_path( log_path );
+
+        rcsc::rcg::CycleIndex index;
+        bool ok = false;
+        if ( force )
+        {
+            ok = index.build( log_path )
+                && index.save( index_path );
+        }
+        else
+        {
+            ok = index.open( log_path );
+        }
+
+        if ( ! ok )
+        {
+            std::cerr << "Failed to create the index : " << log_path
+                      << std::endl;
+            result = 1;
+            continue;
+        }
+
+        std::cout << "file=" << log_path
+                  << ", version=" << index.version()
+                  << ", cycles=" << index.firstCycle() << '-' << index.lastCycle()
+                  << ", lines=" << index.entries().size()
+                  << ", index=" << index_path
+                  << std::endl;
+    }
+
+    return result;
+}
@@ -0,0 +1,322 @@
+// -*-c++-*-
+
+/*!
+  \file rcgstats.cpp
+  \brief rcg match statistics aggregator source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa Akiyama
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <rcsc/rcg/match_stats.h>
+#include <rcsc/rcg/parser.h>
+#include <rcsc/rcg/parser_mmap.h>
+#include <rcsc/gz.h>
+#include <rcsc/thread_pool.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog <<  " [options] <RcgFile>[.gz] ...\n"
+              << "  Print the aggregated match statistics of all games as CSV.\n"
+              << "  -t team|player|stamina  the printed table. (default: team)\n"
+              << "  -s <cycles>  the interval of the stamina curve points. (default: 300)\n"
+              << "  -j <jobs>  the number of parser threads. 0 means the number of hardware threads. (default: 0)"
+              << std::endl;
+}
+
+/*---------------------------------------------------------------*/
+/*!
+  \brief parse one game into stats
+  \return parse result
+*/
+static
+bool
+parse_game( const std::string & path,
+            rcsc::rcg::MatchStats & stats )
+{
+    rcsc::gzifstream fin( path.c_str() );
+    if ( ! fin.is_open() )
+    {
+        std::cerr << "Failed to open file : " << path << std::endl;
+        return false;
+    }
+
+    rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( fin );
+    if ( ! parser )
+    {
+        std::cerr << "Failed to create rcg parser : " << path << std::endl;
+        return false;
+    }
+
+    bool ok = false;
+
+    // the mapped parser skips the conversion of the unused show fields
+    const bool compressed = ( path.size() > 3
+                              && path.compare( path.size() - 3, 3, ".gz" ) == 0 );
+    rcsc::rcg::ParserMMap mmap_parser;
+    if ( ! compressed
+         && ( parser->version() == rcsc::rcg::REC_VERSION_4
+              || parser->version() == rcsc::rcg::REC_VERSION_5 )
+         && mmap_parser.open( path ) )
+    {
+        ok = mmap_parser.parse( stats );
+    }
+    else
+    {
+        ok = parser->parse( fin, stats );
+    }
+
+    if ( ! ok )
+    {
+        std::cerr << "Failed to parse file : " << path << std::endl;
+    }
+
+    return ok;
+}
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+print_team_table( const rcsc::rcg::MatchStats & stats )
+{
+    std::cout << "team,side,games,goals,goals_against,possession,passes,lost,kicks,tackles,distance\n";
+
+    for ( rcsc::rcg::MatchStats::TeamMap::const_iterator it = stats.teams().begin(), end = stats.teams().end();
+          it != end;
+          ++it )
+    {
+        const rcsc::rcg::MatchStats::TeamStats & t = it->second;
+
+        int passes = 0, lost = 0, kicks = 0, tackles = 0;
+        double distance = 0.0;
+        for ( int i = 0; i < rcsc::MAX_PLAYER; ++i )
+        {
+            passes += t.players_[i].passes_;
+            lost += t.players_[i].lost_;
+            kicks += t.players_[i].kicks_;
+            tackles += t.players_[i].tackles_;
+            distance += t.players_[i].distance_;
+        }
+
+        std::cout << it->first.first << ',' << rcsc::side_char( it->first.second )
+                  << ',' << t.games_
+                  << ',' << t.goals_
+                  << ',' << t.goals_against_
+                  << ',' << t.possessionShare()
+                  << ',' << passes
+                  << ',' << lost
+                  << ',' << kicks
+                  << ',' << tackles
+                  << ',' << distance
+                  << '\n';
+    }
+}
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+print_player_table( const rcsc::rcg::MatchStats & stats )
+{
+    std::cout << "team,side,unum,games,cycles,distance,kicks,dashes,tackles,catches,passes,lost\n";
+
+    for ( rcsc::rcg::MatchStats::TeamMap::const_iterator it = stats.teams().begin(), end = stats.teams().end();
+          it != end;
+          ++it )
+    {
+        for ( int i = 0; i < rcsc::MAX_PLAYER; ++i )
+        {
+            const rcsc::rcg::MatchStats::PlayerStats & p = it->second.players_[i];
+            if ( p.games_ == 0 ) continue;
+
+            std::cout << it->first.first << ',' << rcsc::side_char( it->first.second )
+                      << ',' << i + 1
+                      << ',' << p.games_
+                      << ',' << p.cycles_
+                      << ',' << p.distance_
+                      << ',' << p.kicks_
+                      << ',' << p.dashes_
+                      << ',' << p.tackles_
+                      << ',' << p.catches_
+                      << ',' << p.passes_
+                      << ',' << p.lost_
+                      << '\n';
+        }
+    }
+}
+
+/*---------------------------------------------------------------*/
+/*
+
+*/
+static
+void
+print_stamina_table( const rcsc::rcg::MatchStats & stats )
+{
+    std::cout << "team,side,unum,cycle,stamina\n";
+
+    for ( rcsc::rcg::MatchStats::TeamMap::const_iterator it = stats.teams().begin(), end = stats.teams().end();
+          it != end;
+          ++it )
+    {
+        for ( int i = 0; i < rcsc::MAX_PLAYER; ++i )
+        {
+            const rcsc::rcg::MatchStats::PlayerStats & p = it->second.players_[i];
+            for ( std::size_t c = 0; c < p.stamina_sum_.size(); ++c )
+            {
+                if ( p.stamina_count_[c] == 0 ) continue;
+
+                std::cout << it->first.first << ',' << rcsc::side_char( it->first.second )
+                          << ',' << i + 1
+                          << ',' << c * stats.staminaInterval()
+                          << ',' << p.stamina_sum_[c] / p.stamina_count_[c]
+                          << '\n';
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    std::string table = "team";
+    int interval = 300;
+    int jobs = 0;
+    std::vector< std::string > paths;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( i + 1 < argc
+             && ( ! std::strcmp( argv[i], "-t" )
+                  || ! std::strcmp( argv[i], "-s" )
+                  || ! std::strcmp( argv[i], "-j" ) ) )
+        {
+            const char opt = argv[i][1];
+            const char * value = argv[++i];
+            if ( opt == 't' ) table = value;
+            else if ( opt == 's' ) interval = std::atoi( value );
+            else jobs = std::atoi( value );
+            continue;
+        }
+
+        if ( argv[i][0] == '-' )
+        {
+            usage( argv[0] );
+            return 1;
+        }
+
+        paths.push_back( argv[i] );
+    }
+
+    if ( paths.empty()
+         || interval < 1
+         || jobs < 0
+         || ( table != "team" && table != "player" && table != "stamina" ) )
+    {
+        usage( argv[0] );
+        return 1;
+    }
+
+    //
+    // each game is parsed by its own handler on the thread pool.
+    // the partial results are merged in the order of the arguments,
+    // so the output does not depend on the number of threads.
+    //
+
+    std::vector< std::unique_ptr< rcsc::rcg::MatchStats > > partials( paths.size() );
+    std::vector< char > results( paths.size(), 0 );
+    {
+        rcsc::ThreadPool pool( static_cast< std::size_t >( jobs ) );
+        for ( std::size_t i = 0; i < paths.size(); ++i )
+        {
+            pool.submit( [&, i]()
+                         {
+                             partials[i].reset( new rcsc::rcg::MatchStats( interval ) );
+                             results[i] = parse_game( paths[i], *partials[i] );
+                         } );
+        }
+        pool.wait();
+    }
+
+    rcsc::rcg::MatchStats stats( interval );
+    int failed = 0;
+    for ( std::size_t i = 0; i < paths.size(); ++i )
+    {
+        if ( ! results[i] )
+        {
+            ++failed;
+            continue;
+        }
+        stats.merge( *partials[i] );
+        partials[i].reset();
+    }
+
+    if ( table == "player" )
+    {
+        print_player_table( stats );
+    }
+    else if ( table == "stamina" )
+    {
+        print_stamina_table( stats );
+    }
+    else
+    {
+        print_team_table( stats );
+    }
+
+    std::cout << std::flush;
+
+    if ( failed > 0 )
+    {
+        std::cerr << "Failed to parse " << failed << " of " << paths.size()
+                  << " files." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -284,7 +284,7 @@ usage( const char * prog )
               << "    --help [ -h ]\n"
               << "        print this message.\n"
               << "    --version [ -v ] <Value> : (DefaultValue=4)\n"
-              << "        specify the new rcg version.\n"
+              << "        specify the new rcg version (1-6).\n"
               << "    --output [ -o ] <Value>\n"
               << "        specify the output file name.\n"
               << std::endl;
@@ -0,0 +1,133 @@
+// -*-c++-*-
+
+/*!
+  \file rcsclog2txt.cpp
+  \brief binary debug log to text converter source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rcsc/common/binary_log_reader.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+
+///////////////////////////////////////////////////////////
+
+/*---------------------------------------------------------------*/
+/*
+  Usage:
+  $ rcsclog2txt <BinaryLogFile> [-o <OutputFile>]
+*/
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog <<  " [Options] <BinaryLogFile>\n"
+              << "Converts the binary debug log to the text format.\n"
+              << "Available options:\n"
+              << "    --help [ -h ]\n"
+              << "        print this message.\n"
+              << "    --output [ -o ] <Value>\n"
+              << "        specify the output file name. if empty, the standard output is used.\n"
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    std::string input_file;
+    std::string output_file;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--help" )
+             || ! std::strcmp( argv[i], "-h" ) )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+        else if ( ! std::strcmp( argv[i], "--output" )
+                  || ! std::strcmp( argv[i], "-o" ) )
+        {
+            ++i;
+            if ( i >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+            output_file = argv[i];
+        }
+        else
+        {
+            input_file = argv[i];
+        }
+    }
+
+    if ( input_file.empty() )
+    {
+        std::cerr << "No input file" << std::endl;
+        usage( argv[0] );
+        return 1;
+    }
+
+    std::ifstream fin( input_file.c_str(), std::ios_base::binary );
+    if ( ! fin.is_open() )
+    {
+        std::cerr << "Failed to open file : " << input_file << std::endl;
+        return 1;
+    }
+
+    std::ofstream fout;
+    if ( ! output_file.empty() )
+    {
+        fout.open( output_file.c_str() );
+        if ( ! fout.is_open() )
+        {
+            std::cerr << "Failed to open file : " << output_file << std::endl;
+            return 1;
+        }
+    }
+
+    rcsc::BinaryLogReader reader;
+    const bool result = reader.convert( fin, ( fout.is_open()
+                                               ? static_cast< std::ostream & >( fout )
+                                               : std::cout ) );
+
+    if ( reader.droppedCount() > 0 )
+    {
+        std::cerr << input_file << ": " << reader.droppedCount()
+                  << " records were dropped by the logger." << std::endl;
+    }
+
+    return ( result ? 0 : 1 );
+}
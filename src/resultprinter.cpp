@@ -35,12 +35,16 @@
 
 #include <rcsc/gz/gzfstream.h>
 #include <rcsc/rcg.h>
+#include <rcsc/rcg/projection.h>
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <cstdio>
 #include <cmath>
 #include <cstring>
 #include <ctime>
@@ -165,7 +169,8 @@ ResultPrinter::ResultPrinter( const std::string & input_file )
                               ? input_file
                               : input_file.substr( pos + 1 ) );
 
-    tm t;
+    tm t = tm();
+    t.tm_isdst = -1;
     if ( strptime( base_name.c_str(), "%Y%m%d%H%M", &t ) )
     {
         t.tm_sec = 0;
@@ -337,7 +342,8 @@ ResultPrinter::handleMsg( const int,
 {
     if ( ! msg.compare( 0, 8, "(result " ) )
     {
-        tm t;
+        tm t = tm();
+        t.tm_isdst = -1;
         if ( strptime( msg.c_str(), "(result %Y%m%d%H%M%S ", &t ) )
         {
             M_game_date = std::mktime( &t );
@@ -532,10 +538,370 @@ ResultPrinter::handlePlayerType( const std::string & )
 
 ////////////////////////////////////////////////////////////////////////
 
+/*!
+  \struct TailLines
+  \brief the lines that determine the result of the game.
+
+  Only these lines are parsed in the tail-seek mode. The result is same
+  as the full parse unless the game has penalty kicks, because the penalty
+  counts are accumulated from the playmode history.
+*/
+struct TailLines {
+    std::string header_; //!< "ULG4" or "ULG5"
+    std::string server_param_; //!< server_param line
+    std::string show_; //!< the last show line
+    std::string playmode_; //!< the last playmode line
+    std::string team_; //!< the last team line
+    std::string result_; //!< the last "(result ...)" msg line after the last playmode line
+    bool penalty_; //!< true if a penalty playmode or penalty counts are found
+
+    TailLines()
+        : penalty_( false )
+      { }
+
+    bool isComplete() const
+      {
+          return ! show_.empty()
+              && ! playmode_.empty()
+              && ! team_.empty();
+      }
+
+    bool isAmbiguous() const
+      {
+          return ! isComplete() || penalty_;
+      }
+
+    void addHead( const char * first,
+                  const char * last );
+    bool addBackward( const char * first,
+                      const char * last );
+    void addForward( const char * first,
+                     const char * last );
+
+    std::string toLog() const;
+};
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the team line contains the penalty counts
+*/
+bool
+has_penalty_counts( const std::string & line )
+{
+    int time = 0;
+    char name_l[32], name_r[32];
+    int score_l = 0, score_r = 0;
+    int pen_score_l = 0, pen_miss_l = 0, pen_score_r = 0, pen_miss_r = 0;
+
+    return std::sscanf( line.c_str(),
+                        " ( team %d %31s %31s %d %d %d %d %d %d ",
+                        &time, name_l, name_r, &score_l, &score_r,
+                        &pen_score_l, &pen_miss_l, &pen_score_r, &pen_miss_r ) == 9
+        && ( pen_score_l != 0 || pen_miss_l != 0
+             || pen_score_r != 0 || pen_miss_r != 0 );
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief check if the line contains the string
+*/
+bool
+contains( const char * first,
+          const char * last,
+          const char * str )
+{
+    const std::size_t len = std::strlen( str );
+    for ( const char * p = first; p + len <= last; ++p )
+    {
+        if ( ! std::memcmp( p, str, len ) ) return true;
+    }
+    return false;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief add the line at the head of the log
+*/
+void
+TailLines::addHead( const char * first,
+                    const char * last )
+{
+    if ( header_.empty() )
+    {
+        header_.assign( first, last );
+        return;
+    }
+
+    if ( server_param_.empty()
+         && rcsc::rcg::Projection::line_kind( first, last ) == rcsc::rcg::Projection::SERVER_PARAM_LINE )
+    {
+        server_param_.assign( first, last );
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief add the line read from the end of the log
+  \return true if all lines are found
+*/
+bool
+TailLines::addBackward( const char * first,
+                        const char * last )
+{
+    switch ( rcsc::rcg::Projection::line_kind( first, last ) ) {
+    case rcsc::rcg::Projection::SHOW_LINE:
+        if ( show_.empty() ) show_.assign( first, last );
+        break;
+    case rcsc::rcg::Projection::PLAYMODE_LINE:
+        if ( contains( first, last, "penalty" ) ) penalty_ = true;
+        if ( playmode_.empty() ) playmode_.assign( first, last );
+        break;
+    case rcsc::rcg::Projection::TEAM_LINE:
+        if ( team_.empty() )
+        {
+            team_.assign( first, last );
+            if ( has_penalty_counts( team_ ) ) penalty_ = true;
+        }
+        break;
+    case rcsc::rcg::Projection::MSG_LINE:
+        if ( playmode_.empty()
+             && result_.empty()
+             && contains( first, last, "\"(result " ) )
+        {
+            result_.assign( first, last );
+        }
+        break;
+    default:
+        break;
+    }
+
+    return isComplete();
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief add the line read from the head of the log
+*/
+void
+TailLines::addForward( const char * first,
+                       const char * last )
+{
+    switch ( rcsc::rcg::Projection::line_kind( first, last ) ) {
+    case rcsc::rcg::Projection::SHOW_LINE:
+        show_.assign( first, last );
+        break;
+    case rcsc::rcg::Projection::PLAYMODE_LINE:
+        if ( contains( first, last, "penalty" ) ) penalty_ = true;
+        playmode_.assign( first, last );
+        result_.clear();
+        break;
+    case rcsc::rcg::Projection::TEAM_LINE:
+        team_.assign( first, last );
+        penalty_ = penalty_ || has_penalty_counts( team_ );
+        break;
+    case rcsc::rcg::Projection::MSG_LINE:
+        if ( contains( first, last, "\"(result " ) ) result_.assign( first, last );
+        break;
+    case rcsc::rcg::Projection::SERVER_PARAM_LINE:
+        if ( server_param_.empty() ) server_param_.assign( first, last );
+        break;
+    default:
+        if ( header_.empty() ) header_.assign( first, last );
+        break;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief create the log that contains only the collected lines
+*/
+std::string
+TailLines::toLog() const
+{
+    std::string log;
+    log += header_; log += '\n';
+    if ( ! server_param_.empty() ) { log += server_param_; log += '\n'; }
+    log += playmode_; log += '\n';
+    log += team_; log += '\n';
+    if ( ! result_.empty() ) { log += result_; log += '\n'; }
+    log += show_; log += '\n';
+    return log;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief read the lines of the plain log backward from the end of file.
+  Only the line heads are checked until all lines are found.
+*/
+bool
+read_tail_plain( const std::string & path,
+                 TailLines & lines )
+{
+    const std::size_t BLOCK_SIZE = 64 * 1024;
+
+    std::ifstream fin( path.c_str(), std::ios_base::in | std::ios_base::binary );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    // header and parameter lines
+    {
+        std::string head( BLOCK_SIZE, '\0' );
+        fin.read( &head[0], head.size() );
+        head.resize( static_cast< std::size_t >( fin.gcount() ) );
+
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        while ( ( end = head.find( '\n', begin ) ) != std::string::npos )
+        {
+            lines.addHead( head.data() + begin, head.data() + end );
+            begin = end + 1;
+        }
+        fin.clear();
+    }
+
+    if ( lines.header_ != "ULG4"
+         && lines.header_ != "ULG5" )
+    {
+        return false;
+    }
+
+    fin.seekg( 0, std::ios_base::end );
+    std::size_t pos = static_cast< std::size_t >( fin.tellg() );
+
+    std::string data; // unprocessed bytes at [pos, pos + data.size())
+    std::string block;
+    while ( pos > 0 )
+    {
+        const std::size_t n = std::min( BLOCK_SIZE, pos );
+        pos -= n;
+
+        block.resize( n );
+        fin.seekg( static_cast< std::streamoff >( pos ) );
+        if ( ! fin.read( &block[0], n ) )
+        {
+            return false;
+        }
+        data.insert( 0, block );
+
+        std::size_t end = data.size();
+        while ( end > 0 )
+        {
+            const std::size_t nl = data.rfind( '\n', end - 1 );
+            if ( nl == std::string::npos && pos > 0 )
+            {
+                // the head of the line is in the previous block
+                break;
+            }
+
+            const std::size_t begin = ( nl == std::string::npos ? 0 : nl + 1 );
+            if ( begin < end
+                 && lines.addBackward( data.data() + begin, data.data() + end ) )
+            {
+                return true;
+            }
+
+            end = ( nl == std::string::npos ? 0 : nl );
+        }
+        data.resize( end );
+    }
+
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief decompress the whole log without parsing the show data,
+  and keep the last lines.
+*/
+bool
+read_tail_gzip( const std::string & path,
+                TailLines & lines )
+{
+    const std::size_t BLOCK_SIZE = 1024 * 1024;
+
+    rcsc::gzifstream fin( path.c_str() );
+    if ( ! fin.is_open() )
+    {
+        return false;
+    }
+
+    std::string data;
+    std::size_t size = 0;
+    while ( fin )
+    {
+        data.resize( size + BLOCK_SIZE );
+        fin.read( &data[size], BLOCK_SIZE );
+        size += static_cast< std::size_t >( fin.gcount() );
+
+        std::size_t begin = 0;
+        const char * nl = 0;
+        while ( ( nl = static_cast< const char * >( std::memchr( data.data() + begin, '\n', size - begin ) ) ) )
+        {
+            const std::size_t end = nl - data.data();
+            lines.addForward( data.data() + begin, data.data() + end );
+            begin = end + 1;
+
+            if ( lines.header_.compare( 0, 3, "ULG" ) != 0 )
+            {
+                return false;
+            }
+        }
+
+        data.erase( 0, begin );
+        size -= begin;
+    }
+
+    if ( size > 0 )
+    {
+        lines.addForward( data.data(), data.data() + size );
+    }
+
+    return lines.header_ == "ULG4"
+        || lines.header_ == "ULG5";
+}
+
+/*-------------------------------------------------------------------*/
+/*!
+  \brief print the result by reading only the end of the log.
+  \return false if the result cannot be determined by the tail.
+*/
+bool
+print_result_from_tail( const std::string & path )
+{
+    TailLines lines;
+
+    const bool compressed = ( path.size() > 3
+                              && path.compare( path.size() - 3, 3, ".gz" ) == 0 );
+    if ( ! ( compressed
+             ? read_tail_gzip( path, lines )
+             : read_tail_plain( path, lines ) )
+         || lines.isAmbiguous() )
+    {
+        return false;
+    }
+
+    std::istringstream is( lines.toLog() );
+    rcsc::rcg::Parser::Ptr parser = rcsc::rcg::Parser::create( is );
+    if ( ! parser )
+    {
+        return false;
+    }
+
+    ResultPrinter printer( path );
+    return parser->parse( is, printer );
+}
+
+////////////////////////////////////////////////////////////////////////
+
 void
 usage( const char * prog )
 {
-    std::cerr << "Usage: " << prog << " <RcgFile>[.gz]"
+    std::cerr << "Usage: " << prog << " [-f] <RcgFile>[.gz] ...\n"
+              << "  Print the game results. The result is read from the end of the v4/v5 log,\n"
+              << "  and the whole log is parsed only if the end of the log is not enough.\n"
+              << "  -f  always parse the whole log."
               << std::endl;
 }
 
@@ -551,8 +917,16 @@ main( int argc, char** argv )
         return 1;
     }
 
+    bool full_parse = false;
+
     for ( int i = 1; i < argc; ++i )
     {
+        if ( ! std::strcmp( argv[i], "-f" ) )
+        {
+            full_parse = true;
+            continue;
+        }
+
         if ( argv[i][0] == '-' )
         {
             continue;
@@ -560,6 +934,12 @@ main( int argc, char** argv )
 
         const std::string file = argv[i];
 
+        if ( ! full_parse
+             && print_result_from_tail( file ) )
+        {
+            continue;
+        }
+
         rcsc::gzifstream fin( file.c_str() );
 
         if ( ! fin.is_open() )
@@ -0,0 +1,773 @@
+// -*-c++-*-
+
+/*!
+  \file standin_server.cpp
+  \brief local stand-in of rcssserver that replays the offline client logs Source File.
+*/
+
+/*
+ *Copyright:
+
+ Copyright (C) Hidehisa AKIYAMA
+
+ This code is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this library; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+ *EndCopyright:
+ */
+
+/////////////////////////////////////////////////////////////////////
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <rcsc/net/udp_socket.h>
+#include <rcsc/net/host_address.h>
+#include <rcsc/time/profiler.h>
+
+#include <chrono>
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <poll.h>
+
+///////////////////////////////////////////////////////////
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const std::size_t MAX_MESG = 8192;
+
+/*!
+  \brief get the elapsed micro seconds
+ */
+inline
+long
+elapsed_usec( const Clock::time_point & from,
+              const Clock::time_point & to )
+{
+    return static_cast< long >( std::chrono::duration_cast< std::chrono::microseconds >
+                                ( to - from ).count() );
+}
+
+/*!
+  \struct Step
+  \brief server messages sent in one simulation step
+ */
+struct Step {
+    std::vector< std::string > messages_; //!< messages in the received order
+    bool think_; //!< true if the recorded agent made a decision in this step
+
+    Step()
+        : think_( false )
+      { }
+};
+
+/*!
+  \class ReplayLog
+  \brief server message stream recorded by OnlineClient::openOfflineLog().
+
+  The log contains one server message per line, and "(think)" lines written
+  by OnlineClient::printOfflineThink() when the agent made a decision. The
+  messages before the first sense_body (player) or see_global (coach) are
+  the replies to the init command. After that, each sense_body or
+  see_global starts a new simulation step.
+ */
+class ReplayLog {
+private:
+    std::string M_path;
+    std::vector< std::string > M_handshake;
+    std::vector< Step > M_steps;
+
+public:
+
+    bool read( const std::string & path );
+
+    const std::string & path() const
+      {
+          return M_path;
+      }
+
+    const std::vector< std::string > & handshake() const
+      {
+          return M_handshake;
+      }
+
+    const std::vector< Step > & steps() const
+      {
+          return M_steps;
+      }
+};
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+bool
+ReplayLog::read( const std::string & path )
+{
+    std::ifstream fin( path.c_str() );
+    if ( ! fin.is_open() )
+    {
+        std::cerr << "Failed to open file : " << path << std::endl;
+        return false;
+    }
+
+    M_path = path;
+    M_handshake.clear();
+    M_steps.clear();
+
+    std::string step_tag;
+    bool think = false;
+
+    std::string line;
+    while ( std::getline( fin, line ) )
+    {
+        if ( line.empty() )
+        {
+            continue;
+        }
+
+        if ( line == "(think)" )
+        {
+            if ( ! M_steps.empty() )
+            {
+                M_steps.back().think_ = true;
+                think = true;
+            }
+            continue;
+        }
+
+        if ( step_tag.empty() )
+        {
+            if ( ! line.compare( 0, 12, "(sense_body " ) )
+            {
+                step_tag = "(sense_body ";
+            }
+            else if ( ! line.compare( 0, 12, "(see_global " ) )
+            {
+                step_tag = "(see_global ";
+            }
+        }
+
+        if ( step_tag.empty() )
+        {
+            M_handshake.push_back( line );
+            continue;
+        }
+
+        if ( ! line.compare( 0, step_tag.length(), step_tag ) )
+        {
+            M_steps.push_back( Step() );
+        }
+
+        M_steps.back().messages_.push_back( line );
+    }
+
+    if ( M_handshake.empty()
+         || M_handshake.front().compare( 0, 6, "(init " ) != 0 )
+    {
+        std::cerr << path << ": the log does not start with the init reply." << std::endl;
+        return false;
+    }
+
+    // no "(think)" is recorded in the synchronous mode.
+    // the agent makes a decision every step.
+    if ( ! think )
+    {
+        for ( Step & s : M_steps )
+        {
+            s.think_ = true;
+        }
+    }
+
+    return true;
+}
+
+/*!
+  \struct Client
+  \brief connection to an agent and its statistics
+ */
+struct Client {
+    ReplayLog log_; //!< replayed messages
+    std::unique_ptr< rcsc::UDPSocket > socket_; //!< the socket dedicated to this client
+    rcsc::HostAddress addr_; //!< address of the agent
+    bool connected_; //!< true after the init command is received
+
+    std::size_t next_step_; //!< index of the step sent next
+    bool waiting_; //!< true while the reply to the last decision step is not received
+    Clock::time_point sent_time_; //!< the time when the last step was sent
+
+    long decisions_; //!< the number of steps in which the agent made a decision
+    long replies_; //!< the number of decision steps replied
+    long missed_; //!< the number of decision steps not replied before the next step
+    long datagrams_; //!< the number of received datagrams
+    std::map< std::string, long > commands_; //!< the number of received commands
+    rcsc::ProfileHistogram response_; //!< the response time of decision steps [usec]
+
+    Client()
+        : connected_( false ),
+          next_step_( 0 ),
+          waiting_( false ),
+          decisions_( 0 ),
+          replies_( 0 ),
+          missed_( 0 ),
+          datagrams_( 0 )
+      { }
+
+    bool finished() const
+      {
+          return next_step_ >= log_.steps().size();
+      }
+
+    void countCommands( const char * msg );
+};
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+void
+Client::countCommands( const char * msg )
+{
+    int depth = 0;
+    for ( const char * p = msg; *p != '\0'; ++p )
+    {
+        if ( *p == '"' )
+        {
+            // skip the quoted string, e.g. say message
+            while ( *(p + 1) != '\0' && *(p + 1) != '"' ) ++p;
+            if ( *(p + 1) == '"' ) ++p;
+        }
+        else if ( *p == '(' )
+        {
+            if ( depth++ == 0 )
+            {
+                const char * end = p + 1;
+                while ( *end != '\0'
+                        && *end != ' '
+                        && *end != '('
+                        && *end != ')' )
+                {
+                    ++end;
+                }
+                ++commands_[std::string( p + 1, end )];
+            }
+        }
+        else if ( *p == ')' )
+        {
+            depth = std::max( 0, depth - 1 );
+        }
+    }
+}
+
+/*!
+  \class StandInServer
+  \brief UDP server that replays the recorded server messages to the agents.
+
+  Each client is assigned to the next unused log when its init command is
+  received, and a dedicated socket replies to the client as rcssserver
+  does. After all clients are connected, the steps are sent every
+  simulator step, or as soon as all clients replied to the previous step.
+ */
+class StandInServer {
+private:
+    rcsc::UDPSocket M_socket;
+    std::vector< std::unique_ptr< Client > > M_clients;
+
+    int M_step_msec; //!< interval of the steps. if 0, the next step is sent when all clients replied.
+    int M_timeout_msec; //!< max wait time of the reply when M_step_msec is 0.
+    int M_startup_msec; //!< wait time between the last connection and the first step
+
+    long M_steps; //!< the number of sent steps
+    long M_sent_messages; //!< the number of sent messages
+    double M_elapsed_sec; //!< elapsed time of the replay
+
+public:
+
+    StandInServer( const int port,
+                   const int step_msec,
+                   const int timeout_msec,
+                   const int startup_msec )
+        : M_socket( port ),
+          M_step_msec( step_msec ),
+          M_timeout_msec( timeout_msec ),
+          M_startup_msec( startup_msec ),
+          M_steps( 0 ),
+          M_sent_messages( 0 ),
+          M_elapsed_sec( 0.0 )
+      { }
+
+    bool isOpen() const
+      {
+          return M_socket.fd() != -1;
+      }
+
+    bool addLog( const std::string & path );
+
+    bool run();
+
+    void print( std::ostream & os ) const;
+
+private:
+
+    void acceptClient();
+    void receiveCommands( Client & client,
+                          const Clock::time_point & now );
+    bool sendNextStep();
+    bool allReplied() const;
+};
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+bool
+StandInServer::addLog( const std::string & path )
+{
+    std::unique_ptr< Client > client( new Client() );
+    if ( ! client->log_.read( path ) )
+    {
+        return false;
+    }
+
+    M_clients.push_back( std::move( client ) );
+    return true;
+}
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+void
+StandInServer::acceptClient()
+{
+    char buf[MAX_MESG];
+    rcsc::HostAddress from;
+
+    int n = 0;
+    while ( ( n = M_socket.readDatagram( buf, sizeof( buf ) - 1, &from ) ) > 0 )
+    {
+        buf[n] = '\0';
+        if ( std::strncmp( buf, "(init ", 6 ) != 0 )
+        {
+            continue;
+        }
+
+        std::vector< std::unique_ptr< Client > >::iterator it
+            = std::find_if( M_clients.begin(), M_clients.end(),
+                            []( const std::unique_ptr< Client > & c ) { return ! c->connected_; } );
+        if ( it == M_clients.end() )
+        {
+            const char msg[] = "(error no_more_team_or_player_or_goalie)";
+            M_socket.writeDatagram( msg, sizeof( msg ), from );
+            continue;
+        }
+
+        Client & c = **it;
+        c.socket_.reset( new rcsc::UDPSocket( 0 ) );
+        if ( c.socket_->fd() == -1 )
+        {
+            std::cerr << "Failed to open the client socket." << std::endl;
+            c.socket_.reset();
+            continue;
+        }
+
+        c.addr_ = from;
+        c.connected_ = true;
+        c.countCommands( buf );
+        ++c.datagrams_;
+
+        for ( const std::string & msg : c.log_.handshake() )
+        {
+            c.socket_->writeDatagram( msg.c_str(), msg.length() + 1, c.addr_ );
+            ++M_sent_messages;
+        }
+
+        std::cout << "connected: " << c.log_.path() << std::endl;
+    }
+}
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+void
+StandInServer::receiveCommands( Client & client,
+                                const Clock::time_point & now )
+{
+    char buf[MAX_MESG];
+
+    int n = 0;
+    while ( ( n = client.socket_->readDatagram( buf, sizeof( buf ) - 1 ) ) > 0 )
+    {
+        buf[n] = '\0';
+        ++client.datagrams_;
+        client.countCommands( buf );
+
+        if ( client.waiting_ )
+        {
+            client.waiting_ = false;
+            ++client.replies_;
+            client.response_.record( static_cast< std::uint64_t >
+                                     ( std::max( 0L, elapsed_usec( client.sent_time_, now ) ) ) );
+        }
+    }
+}
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+bool
+StandInServer::allReplied() const
+{
+    for ( const std::unique_ptr< Client > & c : M_clients )
+    {
+        if ( c->waiting_ )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+bool
+StandInServer::sendNextStep()
+{
+    bool sent = false;
+
+    for ( std::unique_ptr< Client > & c : M_clients )
+    {
+        if ( c->waiting_ )
+        {
+            c->waiting_ = false;
+            ++c->missed_;
+        }
+
+        if ( c->finished() )
+        {
+            continue;
+        }
+
+        const Step & step = c->log_.steps()[c->next_step_++];
+        for ( const std::string & msg : step.messages_ )
+        {
+            c->socket_->writeDatagram( msg.c_str(), msg.length() + 1, c->addr_ );
+            ++M_sent_messages;
+        }
+
+        c->sent_time_ = Clock::now();
+        if ( step.think_ )
+        {
+            c->waiting_ = true;
+            ++c->decisions_;
+        }
+
+        sent = true;
+    }
+
+    if ( sent )
+    {
+        ++M_steps;
+    }
+
+    return sent;
+}
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+bool
+StandInServer::run()
+{
+    if ( M_clients.empty() )
+    {
+        return false;
+    }
+
+    std::vector< struct pollfd > fds;
+    std::vector< Client * > polled;
+
+    bool started = false;
+    Clock::time_point start_time;
+    Clock::time_point next_time;
+
+    while ( true )
+    {
+        fds.clear();
+        polled.clear();
+
+        struct pollfd pfd;
+        pfd.fd = M_socket.fd();
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        fds.push_back( pfd );
+
+        bool all_connected = true;
+        for ( std::unique_ptr< Client > & c : M_clients )
+        {
+            if ( ! c->connected_ )
+            {
+                all_connected = false;
+                continue;
+            }
+
+            pfd.fd = c->socket_->fd();
+            fds.push_back( pfd );
+            polled.push_back( c.get() );
+        }
+
+        int wait_msec = -1;
+        if ( started || all_connected )
+        {
+            wait_msec = std::max( 0L, ( elapsed_usec( Clock::now(), next_time ) + 999 ) / 1000 );
+        }
+
+        if ( ::poll( &fds[0], fds.size(), wait_msec ) < 0 )
+        {
+            if ( errno == EINTR )
+            {
+                continue;
+            }
+            std::perror( "poll" );
+            return false;
+        }
+
+        Clock::time_point now = Clock::now();
+
+        for ( std::size_t i = 0; i < polled.size(); ++i )
+        {
+            if ( fds[i + 1].revents & POLLIN )
+            {
+                receiveCommands( *polled[i], now );
+            }
+        }
+
+        if ( fds[0].revents & POLLIN )
+        {
+            acceptClient();
+
+            if ( ! started
+                 && std::find_if( M_clients.begin(), M_clients.end(),
+                                  []( const std::unique_ptr< Client > & c ) { return ! c->connected_; } )
+                 == M_clients.end() )
+            {
+                next_time = now + std::chrono::milliseconds( M_startup_msec );
+            }
+        }
+
+        if ( ! started )
+        {
+            if ( ! all_connected
+                 || now < next_time )
+            {
+                continue;
+            }
+
+            started = true;
+            start_time = now;
+            next_time = now;
+        }
+
+        if ( now < next_time
+             && ( M_step_msec > 0
+                  || ! allReplied() ) )
+        {
+            continue;
+        }
+
+        if ( ! sendNextStep() )
+        {
+            break;
+        }
+
+        next_time = ( M_step_msec > 0
+                      ? next_time + std::chrono::milliseconds( M_step_msec )
+                      : Clock::now() + std::chrono::milliseconds( M_timeout_msec ) );
+    }
+
+    M_elapsed_sec = std::chrono::duration< double >( Clock::now() - start_time ).count();
+    return true;
+}
+
+/*---------------------------------------------------------------*/
+/*!
+
+*/
+void
+StandInServer::print( std::ostream & os ) const
+{
+    os << "steps: " << M_steps
+       << ", messages: " << M_sent_messages
+       << ", elapsed: " << M_elapsed_sec << " sec";
+    if ( M_elapsed_sec > 0.0 )
+    {
+        os << " (" << M_steps / M_elapsed_sec << " steps/sec)";
+    }
+    os << '\n';
+
+    for ( const std::unique_ptr< Client > & c : M_clients )
+    {
+        os << c->log_.path() << '\n'
+           << "  decisions: " << c->decisions_
+           << ", replies: " << c->replies_
+           << ", missed: " << c->missed_
+           << ", datagrams: " << c->datagrams_ << '\n';
+
+        if ( c->response_.count() > 0 )
+        {
+            os << "  response [usec]: mean " << c->response_.mean()
+               << ", 50% " << c->response_.valueAtPercentile( 50.0 )
+               << ", 90% " << c->response_.valueAtPercentile( 90.0 )
+               << ", 99% " << c->response_.valueAtPercentile( 99.0 )
+               << ", max " << c->response_.max() << '\n';
+        }
+
+        os << "  commands:";
+        for ( const std::map< std::string, long >::value_type & v : c->commands_ )
+        {
+            os << ' ' << v.first << '=' << v.second;
+        }
+        os << '\n';
+    }
+
+    os << std::flush;
+}
+
+}
+
+///////////////////////////////////////////////////////////
+
+/*---------------------------------------------------------------*/
+/*
+  Usage:
+  $ rcssstandin [Options] <OfflineLogFile>...
+*/
+void
+usage( const char * prog )
+{
+    std::cerr << "Usage: " << prog <<  " [Options] <OfflineLogFile>...\n"
+              << "Replays the server messages recorded by the offline client logging.\n"
+              << "The agents are assigned to the log files in the connected order.\n"
+              << "Available options:\n"
+              << "    --help [ -h ]\n"
+              << "        print this message.\n"
+              << "    --port [ -p ] <Value> : (DefaultValue=6000)\n"
+              << "        specify the port number to receive the init commands.\n"
+              << "    --step <Value> : (DefaultValue=100)\n"
+              << "        specify the interval of steps [ms]. if 0, the next step is sent\n"
+              << "        as soon as all agents replied to the previous step.\n"
+              << "    --timeout <Value> : (DefaultValue=1000)\n"
+              << "        specify the max wait time of the reply [ms] when the step is 0.\n"
+              << "    --startup <Value> : (DefaultValue=1000)\n"
+              << "        specify the wait time before the first step [ms].\n"
+              << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char ** argv )
+{
+    int port = 6000;
+    int step_msec = 100;
+    int timeout_msec = 1000;
+    int startup_msec = 1000;
+    std::vector< std::string > input_files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( ! std::strcmp( argv[i], "--help" )
+             || ! std::strcmp( argv[i], "-h" ) )
+        {
+            usage( argv[0] );
+            return 0;
+        }
+        else if ( ! std::strcmp( argv[i], "--port" )
+                  || ! std::strcmp( argv[i], "-p" )
+                  || ! std::strcmp( argv[i], "--step" )
+                  || ! std::strcmp( argv[i], "--timeout" )
+                  || ! std::strcmp( argv[i], "--startup" ) )
+        {
+            if ( i + 1 >= argc )
+            {
+                usage( argv[0] );
+                return 1;
+            }
+
+            const int value = std::atoi( argv[i + 1] );
+            if ( ! std::strcmp( argv[i], "--step" ) ) step_msec = std::max( 0, value );
+            else if ( ! std::strcmp( argv[i], "--timeout" ) ) timeout_msec = std::max( 1, value );
+            else if ( ! std::strcmp( argv[i], "--startup" ) ) startup_msec = std::max( 0, value );
+            else port = value;
+            ++i;
+        }
+        else if ( argv[i][0] == '-' )
+        {
+            usage( argv[0] );
+            return 1;
+        }
+        else
+        {
+            input_files.push_back( argv[i] );
+        }
+    }
+
+    if ( input_files.empty() )
+    {
+        std::cerr << "No input file" << std::endl;
+        usage( argv[0] );
+        return 1;
+    }
+
+    StandInServer server( port, step_msec, timeout_msec, startup_msec );
+    if ( ! server.isOpen() )
+    {
+        std::cerr << "Failed to open the port " << port << std::endl;
+        return 1;
+    }
+
+    for ( const std::string & path : input_files )
+    {
+        if ( ! server.addLog( path ) )
+        {
+            return 1;
+        }
+    }
+
+    if ( ! server.run() )
+    {
+        return 1;
+    }
+
+    server.print( std::cout );
+    return 0;
+}